@@ -0,0 +1,33 @@
+#ifndef VIZFX_H
+#define VIZFX_H
+
+// ============================================================================
+// vizfx — effect engine shared by vizpow, vizbot and vizpow_8266
+// ============================================================================
+// One copy of the canvas, palettes, emoji sprites and ambient/motion effects
+// for every sketch. Include the sketch's config.h first; vizfx_config.h lists
+// the per-target feature switches (hi-res, motion, ESP8266 memory limits).
+//
+// Header-only, like the sketches: everything lands in the sketch's one
+// translation unit and reads its globals (leds[], currentPalette, gfx) by
+// extern. With VIZFX_HIRES the sketch's display header, which completes
+// GfxDevice, must come before this one.
+//
+//   vizfx_canvas.h    Canvas geometry and XY()
+//   vizfx_palettes.h  Gradient palettes
+//   vizfx_sprites.h   8x8 palette-indexed icons
+//   vizfx_registry.h  VizFxEffect table rows
+//   vizfx_ambient.h   Ambient effects (+ hi-res LCD variants)
+//   vizfx_motion.h    IMU-driven effects
+// ============================================================================
+
+#include "vizfx_config.h"
+#include "vizfx_canvas.h"
+#include "vizfx_palettes.h"
+#include "vizfx_sprites.h"
+#include "vizfx_ambient.h"
+#if defined(VIZFX_MOTION)
+  #include "vizfx_motion.h"
+#endif
+
+#endif // VIZFX_H
@@ -1,16 +1,17 @@
-#ifndef EFFECTS_AMBIENT_H
-#define EFFECTS_AMBIENT_H
+#ifndef VIZFX_AMBIENT_H
+#define VIZFX_AMBIENT_H
 
 #include <FastLED.h>
-#include "config.h"
-#include "layout.h"
+#include "vizfx_canvas.h"
+#include "vizfx_registry.h"
 
 // External references to globals defined in main sketch
 extern CRGB leds[];
 extern CRGBPalette16 currentPalette;
 
-// Hi-res mode support for LCD display
-#if defined(HIRES_ENABLED)
+// Hi-res mode support for LCD display. The sketch supplies GfxDevice (a
+// complete type by the time this is included), LCD_WIDTH and LCD_HEIGHT.
+#if defined(VIZFX_HIRES)
 extern GfxDevice *gfx;
 extern bool hiResMode;
 extern bool hiResRenderedThisFrame;
@@ -281,7 +282,7 @@ void ambientHeartHiRes() {
     for (int r = 0; r < scale * 16; r++) {
       int fx = centerX + (hx * scale * r) / (scale * 16);
       int fy = centerY + (hy * scale * r) / (scale * 16);
-      if (fx >= 0 && fx < LCD_WIDTH && fy >= 0 && fy < LCD_HEIGHT) {
+      if (fx >= 0 && fx <= LCD_WIDTH - 4 && fy >= 0 && fy <= LCD_HEIGHT - 4) {
         gfx->fillRect(fx, fy, 4, 4, hc);
       }
     }
@@ -307,17 +308,18 @@ void ambientDonutHiRes() {
   }
 }
 
-#endif // HIRES_ENABLED
+#endif // VIZFX_HIRES
 
-// ============ Standard 8x8 LED Effects ============
+// ============ Standard LED Effects (any canvas size) ============
 
 void ambientPlasma() {
   static uint16_t t = 0;
   t += 2;
 
-  for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-    for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-      uint8_t value = sin8(x * 32 + t) + sin8(y * 32 + t) + sin8((x + y) * 16 + t);
+  for (uint8_t x = 0; x < canvas.width; x++) {
+    for (uint8_t y = 0; y < canvas.height; y++) {
+      uint8_t value = sin8(canvasStep(x, 32) + t) + sin8(canvasStep(y, 32) + t) +
+                      sin8(canvasStep(x + y, 16) + t);
       leds[XY(x, y)] = ColorFromPalette(currentPalette, value);
     }
   }
@@ -327,34 +329,40 @@ void ambientRainbow() {
   static uint8_t hue = 0;
   hue++;
 
-  for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-    for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-      leds[XY(x, y)] = ColorFromPalette(currentPalette, hue + (x * 8) + (y * 8));
+  for (uint8_t x = 0; x < canvas.width; x++) {
+    for (uint8_t y = 0; y < canvas.height; y++) {
+      leds[XY(x, y)] = ColorFromPalette(currentPalette, hue + canvasStep(x, 8) + canvasStep(y, 8));
     }
   }
 }
 
 void ambientFire() {
-  static uint8_t heat[64];
+  static uint8_t heat[CANVAS_MAX_LEDS];  // Row-major, bottom row is the fuel
+  const uint8_t w = canvas.width, h = canvas.height;
+  const uint8_t cooling = max(2, 160 / h);  // Taller canvases cool less per row
 
-  for (int i = 0; i < NUM_LEDS; i++) {
-    heat[i] = qsub8(heat[i], random8(0, 20));
+  for (uint16_t i = 0; i < canvas.size; i++) {
+    heat[i] = qsub8(heat[i], random8(0, cooling));
   }
 
-  for (int x = 0; x < MATRIX_WIDTH; x++) {
+  uint8_t* fuel = heat + (h - 1) * w;
+  for (uint8_t x = 0; x < w; x++) {
     if (random8() < 180) {
-      heat[XY(x, MATRIX_HEIGHT - 1)] = qadd8(heat[XY(x, MATRIX_HEIGHT - 1)], random8(150, 255));
+      fuel[x] = qadd8(fuel[x], random8(150, 255));
     }
   }
 
-  for (int y = 0; y < MATRIX_HEIGHT - 1; y++) {
-    for (int x = 0; x < MATRIX_WIDTH; x++) {
-      heat[XY(x, y)] = (heat[XY(x, y)] + heat[XY(x, y + 1)] + heat[XY(x, y + 1)]) / 3;
+  for (uint8_t y = 0; y < h - 1; y++) {
+    uint8_t* row = heat + y * w;
+    for (uint8_t x = 0; x < w; x++) {
+      row[x] = (row[x] + row[x + w] + row[x + w]) / 3;
     }
   }
 
-  for (int i = 0; i < NUM_LEDS; i++) {
-    leds[i] = ColorFromPalette(currentPalette, heat[i]);
+  for (uint8_t y = 0; y < h; y++) {
+    for (uint8_t x = 0; x < w; x++) {
+      leds[XY(x, y)] = ColorFromPalette(currentPalette, heat[y * w + x]);
+    }
   }
 }
 
@@ -362,31 +370,31 @@ void ambientOcean() {
   static uint16_t t = 0;
   t += 3;
 
-  for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-    for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-      uint8_t n = inoise8(x * 50, y * 50, t);
+  for (uint8_t x = 0; x < canvas.width; x++) {
+    for (uint8_t y = 0; y < canvas.height; y++) {
+      uint8_t n = inoise8(canvasStep(x, 50), canvasStep(y, 50), t);
       leds[XY(x, y)] = ColorFromPalette(currentPalette, n);
     }
   }
 }
 
 void ambientMatrix() {
-  static uint8_t drops[MATRIX_WIDTH];
-  static bool init = false;
+  static uint8_t drops[CANVAS_MAX_WIDTH];
+  static uint8_t initWidth = 0;
 
-  if (!init) {
-    for (int i = 0; i < MATRIX_WIDTH; i++) drops[i] = random8(MATRIX_HEIGHT);
-    init = true;
+  if (initWidth != canvas.width) {
+    for (int i = 0; i < canvas.width; i++) drops[i] = random8(canvas.height);
+    initWidth = canvas.width;
   }
 
-  fadeToBlackBy(leds, NUM_LEDS, 40);
+  fadeToBlackBy(leds, canvas.size, 40);
 
-  for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-    drops[x] = (drops[x] + 1) % (MATRIX_HEIGHT + random8(3));
-    if (drops[x] < MATRIX_HEIGHT) {
-      leds[XY(x, drops[x])] = ColorFromPalette(currentPalette, x * 32, 255);
+  for (uint8_t x = 0; x < canvas.width; x++) {
+    drops[x] = (drops[x] + 1) % (canvas.height + random8(3));
+    if (drops[x] < canvas.height) {
+      leds[XY(x, drops[x])] = ColorFromPalette(currentPalette, canvasStep(x, 32), 255);
       if (drops[x] > 0) {
-        leds[XY(x, drops[x] - 1)] = ColorFromPalette(currentPalette, x * 32, 150);
+        leds[XY(x, drops[x] - 1)] = ColorFromPalette(currentPalette, canvasStep(x, 32), 150);
       }
     }
   }
@@ -396,9 +404,9 @@ void ambientLava() {
   static uint16_t t = 0;
   t += 3;
 
-  for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-    for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-      uint8_t n = inoise8(x * 60, y * 60, t);
+  for (uint8_t x = 0; x < canvas.width; x++) {
+    for (uint8_t y = 0; y < canvas.height; y++) {
+      uint8_t n = inoise8(canvasStep(x, 60), canvasStep(y, 60), t);
       leds[XY(x, y)] = ColorFromPalette(currentPalette, n);
     }
   }
@@ -408,28 +416,32 @@ void ambientAurora() {
   static uint16_t t = 0;
   t += 2;
 
-  for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-    for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-      uint8_t n = inoise8(x * 40, y * 30 + t, t / 2);
+  for (uint8_t x = 0; x < canvas.width; x++) {
+    for (uint8_t y = 0; y < canvas.height; y++) {
+      uint8_t n = inoise8(canvasStep(x, 40), canvasStep(y, 30) + t, t / 2);
       leds[XY(x, y)] = ColorFromPalette(currentPalette, n);
     }
   }
 }
 
 void ambientConfetti() {
-  fadeToBlackBy(leds, NUM_LEDS, 10);
-  int pos = random16(NUM_LEDS);
-  leds[pos] += ColorFromPalette(currentPalette, random8(64) + millis() / 50, 255);
+  fadeToBlackBy(leds, canvas.size, 10);
+  // Same density as one pixel per frame on an 8x8
+  for (uint16_t n = max(1, canvas.size / 64); n > 0; n--) {
+    int pos = random16(canvas.size);
+    leds[pos] += ColorFromPalette(currentPalette, random8(64) + millis() / 50, 255);
+  }
 }
 
 void ambientGalaxy() {
   static uint16_t t = 0;
   t++;
 
-  for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-    for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-      float dx = x - 3.5;
-      float dy = y - 3.5;
+  const float cx = canvasCenterX(), cy = canvasCenterY(), unit = canvasUnit();
+  for (uint8_t x = 0; x < canvas.width; x++) {
+    for (uint8_t y = 0; y < canvas.height; y++) {
+      float dx = (x - cx) * unit;
+      float dy = (y - cy) * unit;
       float angle = atan2(dy, dx);
       float dist = sqrt(dx * dx + dy * dy);
       uint8_t hue = (angle * 40) + (dist * 20) + t;
@@ -460,10 +472,11 @@ void ambientHeart() {
     bright = 255;
   }
 
-  FastLED.clear();
-  for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-    for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-      if (heart[y] & (1 << (7 - x))) {
+  fill_solid(leds, canvas.size, CRGB::Black);
+  for (uint8_t y = 0; y < canvas.height; y++) {
+    for (uint8_t x = 0; x < canvas.width; x++) {
+      uint8_t sx, sy;
+      if (canvasSpriteCell(x, y, sx, sy) && (heart[sy] & (1 << (7 - sx)))) {
         leds[XY(x, y)] = ColorFromPalette(currentPalette, t, bright);
       }
     }
@@ -489,9 +502,10 @@ void ambientDonut() {
   CRGB bgColor = phase ? CRGB::Blue : CRGB::Red;
   CRGB donutColor = phase ? CRGB::Red : CRGB::Blue;
 
-  for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-    for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-      if (donut[y] & (1 << (7 - x))) {
+  for (uint8_t y = 0; y < canvas.height; y++) {
+    for (uint8_t x = 0; x < canvas.width; x++) {
+      uint8_t sx, sy;
+      if (canvasSpriteCell(x, y, sx, sy) && (donut[sy] & (1 << (7 - sx)))) {
         leds[XY(x, y)] = donutColor;
       } else {
         leds[XY(x, y)] = bgColor;
@@ -500,34 +514,42 @@ void ambientDonut() {
   }
 }
 
-// Function pointer tables for ambient effects
-typedef void (*AmbientFunc)();
+#if defined(VIZFX_HIRES)
+  #define VIZFX_HIRES_FUNC(f) f
+#else
+  #define VIZFX_HIRES_FUNC(f) nullptr
+#endif
 
-const AmbientFunc ambientLedFuncs[NUM_AMBIENT_EFFECTS] = {
-  ambientPlasma, ambientRainbow, ambientFire, ambientOcean,
-  ambientMatrix, ambientLava, ambientAurora, ambientConfetti,
-  ambientGalaxy, ambientHeart, ambientDonut
+const VizFxEffect ambientEffects[] = {
+  { "Plasma",   ambientPlasma,   VIZFX_HIRES_FUNC(ambientPlasmaHiRes) },
+  { "Rainbow",  ambientRainbow,  VIZFX_HIRES_FUNC(ambientRainbowHiRes) },
+  { "Fire",     ambientFire,     VIZFX_HIRES_FUNC(ambientFireHiRes) },
+  { "Ocean",    ambientOcean,    VIZFX_HIRES_FUNC(ambientOceanHiRes) },
+  { "Matrix",   ambientMatrix,   VIZFX_HIRES_FUNC(ambientMatrixHiRes) },
+  { "Lava",     ambientLava,     VIZFX_HIRES_FUNC(ambientLavaHiRes) },
+  { "Aurora",   ambientAurora,   VIZFX_HIRES_FUNC(ambientAuroraHiRes) },
+  { "Confetti", ambientConfetti, VIZFX_HIRES_FUNC(ambientConfettiHiRes) },
+  { "Galaxy",   ambientGalaxy,   VIZFX_HIRES_FUNC(ambientGalaxyHiRes) },
+  { "Heart",    ambientHeart,    VIZFX_HIRES_FUNC(ambientHeartHiRes) },
+  { "Donut",    ambientDonut,    VIZFX_HIRES_FUNC(ambientDonutHiRes) }
 };
 
-#if defined(HIRES_ENABLED)
-const AmbientFunc ambientHiResFuncs[NUM_AMBIENT_EFFECTS] = {
-  ambientPlasmaHiRes, ambientRainbowHiRes, ambientFireHiRes, ambientOceanHiRes,
-  ambientMatrixHiRes, ambientLavaHiRes, ambientAuroraHiRes,
-  ambientConfettiHiRes, ambientGalaxyHiRes, ambientHeartHiRes,
-  ambientDonutHiRes
-};
-#endif
+#undef VIZFX_HIRES_FUNC
+
+static_assert(VIZFX_COUNT(ambientEffects) == NUM_AMBIENT_EFFECTS,
+              "ambientEffects[] and NUM_AMBIENT_EFFECTS disagree");
 
 // Run ambient effect by index
 void runAmbientEffect(uint8_t index) {
   if (index >= NUM_AMBIENT_EFFECTS) return;
-  #if defined(HIRES_ENABLED)
-  if (hiResMode && !menuVisible && gfx != nullptr) {
-    ambientHiResFuncs[index]();
+  const VizFxEffect& fx = ambientEffects[index];
+  #if defined(VIZFX_HIRES)
+  if (hiResMode && !menuVisible && gfx != nullptr && fx.renderHiRes) {
+    fx.renderHiRes();
     return;
   }
   #endif
-  ambientLedFuncs[index]();
+  fx.render();
 }
 
-#endif
+#endif // VIZFX_AMBIENT_H
@@ -0,0 +1,103 @@
+#ifndef VIZFX_CANVAS_H
+#define VIZFX_CANVAS_H
+
+#include <FastLED.h>
+#include "vizfx_config.h"
+
+// ============================================================================
+// Canvas — the geometry effects render against
+// ============================================================================
+// Effects never assume 8x8: they loop over canvas.width x canvas.height, write
+// leds[XY(x, y)] and size their patterns from canvas.span. XY() goes through
+// a row-major → physical index table, so the same effect code drives a single
+// 8x8, a 32x8 strip wall or a 64x64 panel array.
+//
+// Until something is attached the canvas is the sketch's MATRIX_WIDTH x
+// MATRIX_HEIGHT in plain row-major order (vizbot's LCD grid, a single 8x8).
+// vizpow attaches its panel table (led_output.h); a host build can attach any
+// size up to CANVAS_MAX_* with a table of its own, or nullptr for row-major.
+//
+// VIZFX_LOW_MEMORY (ESP8266) pins the canvas at compile time instead: no
+// table, no attach, and every canvas.* read folds to a constant.
+// ============================================================================
+
+// Largest canvas the effect state buffers are sized for
+#ifndef CANVAS_MAX_WIDTH
+  #define CANVAS_MAX_WIDTH MATRIX_WIDTH
+#endif
+#ifndef CANVAS_MAX_LEDS
+  #define CANVAS_MAX_LEDS NUM_LEDS
+#endif
+
+struct Canvas {
+  uint8_t  width;
+  uint8_t  height;
+  uint16_t size;           // width * height
+  uint8_t  span;           // Shorter side — patterns are scaled so span == 8 looks like the 8x8
+  const uint16_t* xyMap;   // y * width + x → leds[] index, nullptr = row-major
+};
+
+#if defined(VIZFX_LOW_MEMORY)
+
+static constexpr Canvas canvas = {
+  MATRIX_WIDTH, MATRIX_HEIGHT, MATRIX_WIDTH * MATRIX_HEIGHT,
+  MATRIX_WIDTH < MATRIX_HEIGHT ? MATRIX_WIDTH : MATRIX_HEIGHT, nullptr
+};
+
+inline uint16_t XY(uint8_t x, uint8_t y) {
+  return y * MATRIX_WIDTH + x;
+}
+
+#else
+
+Canvas canvas = {
+  MATRIX_WIDTH, MATRIX_HEIGHT, MATRIX_WIDTH * MATRIX_HEIGHT,
+  MATRIX_WIDTH < MATRIX_HEIGHT ? MATRIX_WIDTH : MATRIX_HEIGHT, nullptr
+};
+
+// Point effects at a width x height canvas. Returns false if it is larger
+// than the state buffers allow (the previous canvas stays attached).
+bool canvasAttach(uint8_t width, uint8_t height, const uint16_t* xyMap) {
+  if (width == 0 || height == 0 || width > CANVAS_MAX_WIDTH ||
+      (uint32_t)width * height > CANVAS_MAX_LEDS) {
+    return false;
+  }
+  canvas.width = width;
+  canvas.height = height;
+  canvas.size = width * height;
+  canvas.span = min(width, height);
+  canvas.xyMap = xyMap;
+  return true;
+}
+
+// Canvas coordinates → leds[] index
+inline uint16_t XY(uint8_t x, uint8_t y) {
+  uint16_t i = y * canvas.width + x;
+  return canvas.xyMap ? canvas.xyMap[i] : i;
+}
+
+#endif // VIZFX_LOW_MEMORY
+
+// Scale an 8x8-tuned coordinate step to the canvas: canvasStep(x, 32) is x * 32
+// on an 8x8 and the same overall sweep on larger canvases
+inline uint16_t canvasStep(uint16_t v, uint16_t per8) {
+  return (uint32_t)v * per8 * 8 / canvas.span;
+}
+
+// Centre of the canvas and the 8x8-units distance scale for radial effects
+inline float canvasCenterX() { return (canvas.width - 1) * 0.5f; }
+inline float canvasCenterY() { return (canvas.height - 1) * 0.5f; }
+inline float canvasUnit()    { return 8.0f / canvas.span; }
+
+// 8x8 sprite cell under canvas pixel (x, y). Sprites scale to the shorter
+// side and sit centred on the longer one; returns false outside the sprite.
+inline bool canvasSpriteCell(uint8_t x, uint8_t y, uint8_t& sx, uint8_t& sy) {
+  int16_t u = x - (canvas.width - canvas.span) / 2;
+  int16_t v = y - (canvas.height - canvas.span) / 2;
+  if (u < 0 || v < 0 || u >= canvas.span || v >= canvas.span) return false;
+  sx = u * 8 / canvas.span;
+  sy = v * 8 / canvas.span;
+  return true;
+}
+
+#endif // VIZFX_CANVAS_H
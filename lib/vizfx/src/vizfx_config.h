@@ -0,0 +1,35 @@
+#ifndef VIZFX_CONFIG_H
+#define VIZFX_CONFIG_H
+
+// ============================================================================
+// vizfx feature selection
+// ============================================================================
+// The library has no config of its own: it reads the sketch's config.h, which
+// must be included first. Features follow the sketch's existing switches and
+// can be forced either way by defining them before the first vizfx include.
+//
+//   VIZFX_HIRES       Full-resolution LCD variants of the ambient effects.
+//                     On with HIRES_ENABLED. Needs GfxDevice, gfx, LCD_WIDTH
+//                     and LCD_HEIGHT from the sketch.
+//   VIZFX_MOTION      IMU effects (vizfx_motion.h). On when the sketch
+//                     defines NUM_MOTION_EFFECTS. Needs accelX..gyroZ.
+//   VIZFX_LOW_MEMORY  Compile-time canvas, no XY table. On for ESP8266.
+// ============================================================================
+
+#if !defined(MATRIX_WIDTH) || !defined(MATRIX_HEIGHT) || !defined(NUM_LEDS)
+  #error "vizfx: include the sketch's config.h before any vizfx header"
+#endif
+
+#if defined(HIRES_ENABLED) && !defined(VIZFX_NO_HIRES) && !defined(VIZFX_HIRES)
+  #define VIZFX_HIRES
+#endif
+
+#if defined(NUM_MOTION_EFFECTS) && !defined(VIZFX_NO_MOTION) && !defined(VIZFX_MOTION)
+  #define VIZFX_MOTION
+#endif
+
+#if defined(ARDUINO_ARCH_ESP8266) && !defined(VIZFX_LOW_MEMORY)
+  #define VIZFX_LOW_MEMORY
+#endif
+
+#endif // VIZFX_CONFIG_H
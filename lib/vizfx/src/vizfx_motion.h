@@ -1,8 +1,9 @@
-#ifndef EFFECTS_MOTION_H
-#define EFFECTS_MOTION_H
+#ifndef VIZFX_MOTION_H
+#define VIZFX_MOTION_H
 
 #include <FastLED.h>
-#include "config.h"
+#include "vizfx_canvas.h"
+#include "vizfx_registry.h"
 
 // External references to globals defined in main sketch
 extern CRGB leds[];
@@ -18,29 +19,31 @@ extern float gyroX, gyroY, gyroZ;
 
 void tiltBall() {
   static float ballX = 3.5, ballY = 3.5;
+  const float unit = canvasUnit();
 
   // More responsive: larger range and faster interpolation
   // Swapped X/Y axes to match device orientation
-  float targetX = 3.5 + accelY * 5.0 * ACCEL_SENSITIVITY;
-  float targetY = 3.5 + accelX * 5.0 * ACCEL_SENSITIVITY;
+  float targetX = canvasCenterX() + accelY * 5.0 * ACCEL_SENSITIVITY / unit;
+  float targetY = canvasCenterY() + accelX * 5.0 * ACCEL_SENSITIVITY / unit;
 
   ballX += (targetX - ballX) * 0.5;  // Faster response (was 0.3)
   ballY += (targetY - ballY) * 0.5;
   
-  ballX = constrain(ballX, 0, 7);
-  ballY = constrain(ballY, 0, 7);
+  ballX = constrain(ballX, 0, canvas.width - 1);
+  ballY = constrain(ballY, 0, canvas.height - 1);
   
-  fadeToBlackBy(leds, NUM_LEDS, 100);
+  fadeToBlackBy(leds, canvas.size, 100);
   
   int ix = (int)ballX;
   int iy = (int)ballY;
+  int r = max(1, canvas.span / 8);  // Ball keeps its size relative to the canvas
   
-  for (int dx = -1; dx <= 1; dx++) {
-    for (int dy = -1; dy <= 1; dy++) {
+  for (int dx = -r; dx <= r; dx++) {
+    for (int dy = -r; dy <= r; dy++) {
       int nx = ix + dx;
       int ny = iy + dy;
-      if (nx >= 0 && nx < MATRIX_WIDTH && ny >= 0 && ny < MATRIX_HEIGHT) {
-        float dist = sqrt((ballX - nx) * (ballX - nx) + (ballY - ny) * (ballY - ny));
+      if (nx >= 0 && nx < canvas.width && ny >= 0 && ny < canvas.height) {
+        float dist = sqrt((ballX - nx) * (ballX - nx) + (ballY - ny) * (ballY - ny)) * unit;
         uint8_t bright = 255 - constrain(dist * 150, 0, 255);
         leds[XY(nx, ny)] = ColorFromPalette(currentPalette, millis() / 20, bright);
       }
@@ -53,9 +56,10 @@ void motionPlasma() {
   float motion = sqrt(gyroX * gyroX + gyroY * gyroY + gyroZ * gyroZ);
   t += 1 + (motion / 15 * GYRO_SENSITIVITY);  // Much faster response (was /50)
   
-  for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-    for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-      uint8_t value = sin8(x * 32 + t) + sin8(y * 32 + t) + sin8((x + y) * 16 + t);
+  for (uint8_t x = 0; x < canvas.width; x++) {
+    for (uint8_t y = 0; y < canvas.height; y++) {
+      uint8_t value = sin8(canvasStep(x, 32) + t) + sin8(canvasStep(y, 32) + t) +
+                      sin8(canvasStep(x + y, 16) + t);
       leds[XY(x, y)] = ColorFromPalette(currentPalette, value);
     }
   }
@@ -63,13 +67,14 @@ void motionPlasma() {
 
 void shakeSparkle() {
   float shake = sqrt(accelX * accelX + accelY * accelY + accelZ * accelZ);
-  fadeToBlackBy(leds, NUM_LEDS, 15);  // Slower fade for longer trails
+  fadeToBlackBy(leds, canvas.size, 15);  // Slower fade for longer trails
 
   if (shake > SHAKE_THRESHOLD_LOW) {
-    // More sparks from less movement
+    // More sparks from less movement (counts are per 64 LEDs)
     int numSparks = constrain((shake - 1) * 25 * ACCEL_SENSITIVITY, 1, 40);
+    numSparks = max(1, numSparks * canvas.size / 64);
     for (int i = 0; i < numSparks; i++) {
-      int pos = random16(NUM_LEDS);
+      int pos = random16(canvas.size);
       leds[pos] = ColorFromPalette(currentPalette, random8(), 255);
     }
   }
@@ -80,11 +85,11 @@ void tiltWave() {
   t++;
   
   float angle = atan2(accelY, accelX);
+  const float ux = cos(angle) * canvasUnit(), uy = sin(angle) * canvasUnit();
   
-  FastLED.clear();
-  for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-    for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-      float projected = x * cos(angle) + y * sin(angle);
+  for (uint8_t x = 0; x < canvas.width; x++) {
+    for (uint8_t y = 0; y < canvas.height; y++) {
+      float projected = x * ux + y * uy;
       uint8_t bright = sin8(projected * 40 + t * 3);
       leds[XY(x, y)] = ColorFromPalette(currentPalette, projected * 20 + t, bright);
     }
@@ -95,14 +100,15 @@ void tiltRipple() {
   static uint8_t t = 0;
   t++;
 
-  // Larger center movement from tilt (was 2)
-  float cx = 3.5 + accelX * 4.0 * ACCEL_SENSITIVITY;
-  float cy = 3.5 - accelY * 4.0 * ACCEL_SENSITIVITY;
+  // Larger center movement from tilt (was 2); distances in 8x8 units
+  const float unit = canvasUnit();
+  float cx = canvasCenterX() * unit + accelX * 4.0 * ACCEL_SENSITIVITY;
+  float cy = canvasCenterY() * unit - accelY * 4.0 * ACCEL_SENSITIVITY;
   
-  for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-    for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-      float dx = x - cx;
-      float dy = y - cy;
+  for (uint8_t x = 0; x < canvas.width; x++) {
+    for (uint8_t y = 0; y < canvas.height; y++) {
+      float dx = x * unit - cx;
+      float dy = y * unit - cy;
       float dist = sqrt(dx * dx + dy * dy);
       uint8_t bright = sin8((dist * 50) - t * 4);
       leds[XY(x, y)] = ColorFromPalette(currentPalette, dist * 30 + t, bright);
@@ -114,10 +120,11 @@ void gyroSwirl() {
   static uint16_t t = 0;
   t += 2 + abs(gyroZ) / 30 * GYRO_SENSITIVITY;  // Much faster swirl (was /100)
   
-  for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-    for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-      float dx = x - 3.5;
-      float dy = y - 3.5;
+  const float cx = canvasCenterX(), cy = canvasCenterY(), unit = canvasUnit();
+  for (uint8_t x = 0; x < canvas.width; x++) {
+    for (uint8_t y = 0; y < canvas.height; y++) {
+      float dx = (x - cx) * unit;
+      float dy = (y - cy) * unit;
       float angle = atan2(dy, dx);
       float dist = sqrt(dx * dx + dy * dy);
       uint8_t hue = (angle * 40) + (dist * 20) + t;
@@ -140,12 +147,13 @@ void shakeExplode() {
   
   if (explodeFrame < 50) {
     float radius = explodeFrame / 5.0;
-    FastLED.clear();
+    fill_solid(leds, canvas.size, CRGB::Black);
     
-    for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-      for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-        float dx = x - 3.5;
-        float dy = y - 3.5;
+    const float cx = canvasCenterX(), cy = canvasCenterY(), unit = canvasUnit();
+    for (uint8_t x = 0; x < canvas.width; x++) {
+      for (uint8_t y = 0; y < canvas.height; y++) {
+        float dx = (x - cx) * unit;
+        float dy = (y - cy) * unit;
         float dist = sqrt(dx * dx + dy * dy);
         if (abs(dist - radius) < 1.5) {
           uint8_t bright = 255 - abs(dist - radius) * 170;
@@ -155,21 +163,27 @@ void shakeExplode() {
     }
     explodeFrame++;
   } else {
-    fadeToBlackBy(leds, NUM_LEDS, 30);
+    fadeToBlackBy(leds, canvas.size, 30);
   }
 }
 
+const VizFxEffect motionEffects[] = {
+  { "Tilt Ball",     tiltBall,      nullptr },
+  { "Motion Plasma", motionPlasma,  nullptr },
+  { "Shake Sparkle", shakeSparkle,  nullptr },
+  { "Tilt Wave",     tiltWave,      nullptr },
+  { "Tilt Ripple",   tiltRipple,    nullptr },
+  { "Gyro Swirl",    gyroSwirl,     nullptr },
+  { "Shake Explode", shakeExplode,  nullptr }
+};
+
+static_assert(VIZFX_COUNT(motionEffects) == NUM_MOTION_EFFECTS,
+              "motionEffects[] and NUM_MOTION_EFFECTS disagree");
+
 // Run motion effect by index
 void runMotionEffect(uint8_t index) {
-  switch (index) {
-    case 0: tiltBall(); break;
-    case 1: motionPlasma(); break;
-    case 2: shakeSparkle(); break;
-    case 3: tiltWave(); break;
-    case 4: tiltRipple(); break;
-    case 5: gyroSwirl(); break;
-    case 6: shakeExplode(); break;
-  }
+  if (index >= NUM_MOTION_EFFECTS) return;
+  motionEffects[index].render();
 }
 
-#endif
+#endif // VIZFX_MOTION_H
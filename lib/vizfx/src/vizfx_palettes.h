@@ -1,5 +1,5 @@
-#ifndef PALETTES_H
-#define PALETTES_H
+#ifndef VIZFX_PALETTES_H
+#define VIZFX_PALETTES_H
 
 #include <FastLED.h>
 
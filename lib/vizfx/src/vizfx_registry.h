@@ -0,0 +1,29 @@
+#ifndef VIZFX_REGISTRY_H
+#define VIZFX_REGISTRY_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Effect registry — one row per effect, shared by every target
+// ============================================================================
+// Each effect family (ambient, motion) is a table of these, indexed by the
+// same number the web UI and settings store. renderHiRes is the LCD
+// full-resolution variant, or nullptr where a target has none (motion
+// effects, and every effect in builds without VIZFX_HIRES).
+//
+// The tables are const and live in flash; a runner is a bounds check and one
+// indirect call. The host suite walks the same tables, so an effect added
+// here is benchmarked on every profile without further wiring.
+// ============================================================================
+
+typedef void (*VizFxRenderFunc)();
+
+struct VizFxEffect {
+  const char*     name;          // As shown in the web UI
+  VizFxRenderFunc render;        // Draws one frame into leds[] via XY()
+  VizFxRenderFunc renderHiRes;   // Draws one frame straight to gfx, or nullptr
+};
+
+#define VIZFX_COUNT(table) (sizeof(table) / sizeof((table)[0]))
+
+#endif // VIZFX_REGISTRY_H
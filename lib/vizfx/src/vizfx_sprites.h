@@ -1,20 +1,20 @@
 /**
- * 8x8 Multicolor Icons for vizPow — Palette-Indexed Format
- * For use with FastLED / ESP32-S3-Matrix
+ * 8x8 Multicolor Icons — Palette-Indexed Format
+ * Shared by vizpow, vizbot and vizpow_8266 (FastLED, ESP32 / ESP8266)
  *
  * Each icon is 64 uint8_t palette indices (8x8 grid, row-major order)
  * Use decodeIcon() to expand to CRGB[64] at runtime.
  *
  * Usage:
- *   #include "emoji_sprites.h"
+ *   #include <vizfx.h>
  *
  *   CRGB pixels[64];
  *   decodeIcon(ALL_ICONS[index], pixels);
  *   // pixels now contains 64 CRGB values
  */
 
-#ifndef ICONS_8X8_H
-#define ICONS_8X8_H
+#ifndef VIZFX_SPRITES_H
+#define VIZFX_SPRITES_H
 
 #include <FastLED.h>
 
@@ -488,6 +488,165 @@ const uint8_t ICON_POPSICLE[64] PROGMEM = {
   ___, ___, ___, PST, PST, ___, ___, ___
 };
 
+// ==================== EXTRAS ====================
+// Icons first drawn for the 8266 build, now shared by every target
+
+// Smiley face
+const uint8_t ICON_SMILEY[64] PROGMEM = {
+  ___, ___, YEL, YEL, YEL, YEL, ___, ___,
+  ___, YEL, YEL, YEL, YEL, YEL, YEL, ___,
+  YEL, YEL, ___, YEL, YEL, ___, YEL, YEL,
+  YEL, YEL, YEL, YEL, YEL, YEL, YEL, YEL,
+  YEL, YEL, YEL, YEL, YEL, YEL, YEL, YEL,
+  YEL, ___, YEL, YEL, YEL, YEL, ___, YEL,
+  ___, YEL, ___, ___, ___, ___, YEL, ___,
+  ___, ___, YEL, YEL, YEL, YEL, ___, ___
+};
+
+// Question mark (blue)
+const uint8_t ICON_QUESTION[64] PROGMEM = {
+  ___, ___, BLU, BLU, BLU, BLU, ___, ___,
+  ___, BLU, BLU, ___, ___, BLU, BLU, ___,
+  ___, ___, ___, ___, ___, BLU, BLU, ___,
+  ___, ___, ___, ___, BLU, BLU, ___, ___,
+  ___, ___, ___, BLU, BLU, ___, ___, ___,
+  ___, ___, ___, BLU, BLU, ___, ___, ___,
+  ___, ___, ___, ___, ___, ___, ___, ___,
+  ___, ___, ___, BLU, BLU, ___, ___, ___
+};
+
+// Exclamation mark (orange)
+const uint8_t ICON_EXCLAIM[64] PROGMEM = {
+  ___, ___, ___, ORG, ORG, ___, ___, ___,
+  ___, ___, ___, ORG, ORG, ___, ___, ___,
+  ___, ___, ___, ORG, ORG, ___, ___, ___,
+  ___, ___, ___, ORG, ORG, ___, ___, ___,
+  ___, ___, ___, ORG, ORG, ___, ___, ___,
+  ___, ___, ___, ___, ___, ___, ___, ___,
+  ___, ___, ___, ORG, ORG, ___, ___, ___,
+  ___, ___, ___, ORG, ORG, ___, ___, ___
+};
+
+// Sun
+const uint8_t ICON_SUN[64] PROGMEM = {
+  ___, ___, ___, YEL, YEL, ___, ___, ___,
+  ___, YEL, ___, ___, ___, ___, YEL, ___,
+  ___, ___, YEL, YEL, YEL, YEL, ___, ___,
+  YEL, ___, YEL, YEL, YEL, YEL, ___, YEL,
+  YEL, ___, YEL, YEL, YEL, YEL, ___, YEL,
+  ___, ___, YEL, YEL, YEL, YEL, ___, ___,
+  ___, YEL, ___, ___, ___, ___, YEL, ___,
+  ___, ___, ___, YEL, YEL, ___, ___, ___
+};
+
+// Moon (crescent)
+const uint8_t ICON_MOON[64] PROGMEM = {
+  ___, ___, ___, WHT, WHT, WHT, ___, ___,
+  ___, ___, WHT, WHT, WHT, ___, ___, ___,
+  ___, WHT, WHT, WHT, ___, ___, ___, ___,
+  ___, WHT, WHT, WHT, ___, ___, ___, ___,
+  ___, WHT, WHT, WHT, ___, ___, ___, ___,
+  ___, WHT, WHT, WHT, ___, ___, ___, ___,
+  ___, ___, WHT, WHT, WHT, ___, ___, ___,
+  ___, ___, ___, WHT, WHT, WHT, ___, ___
+};
+
+// Cloud
+const uint8_t ICON_CLOUD[64] PROGMEM = {
+  ___, ___, ___, ___, ___, ___, ___, ___,
+  ___, ___, WHT, WHT, WHT, ___, ___, ___,
+  ___, WHT, WHT, WHT, WHT, WHT, ___, ___,
+  WHT, WHT, WHT, WHT, WHT, WHT, WHT, ___,
+  WHT, WHT, WHT, WHT, WHT, WHT, WHT, WHT,
+  WHT, WHT, WHT, WHT, WHT, WHT, WHT, WHT,
+  ___, ___, ___, ___, ___, ___, ___, ___,
+  ___, ___, ___, ___, ___, ___, ___, ___
+};
+
+// Rain cloud
+const uint8_t ICON_RAIN[64] PROGMEM = {
+  ___, ___, GRY, GRY, GRY, ___, ___, ___,
+  ___, GRY, GRY, GRY, GRY, GRY, ___, ___,
+  GRY, GRY, GRY, GRY, GRY, GRY, GRY, ___,
+  GRY, GRY, GRY, GRY, GRY, GRY, GRY, GRY,
+  ___, ___, ___, ___, ___, ___, ___, ___,
+  ___, BLU, ___, BLU, ___, BLU, ___, ___,
+  BLU, ___, BLU, ___, BLU, ___, BLU, ___,
+  ___, BLU, ___, BLU, ___, BLU, ___, ___
+};
+
+// Lightning bolt
+const uint8_t ICON_LIGHTNING[64] PROGMEM = {
+  ___, ___, ___, ___, YEL, YEL, ___, ___,
+  ___, ___, ___, YEL, YEL, ___, ___, ___,
+  ___, ___, YEL, YEL, ___, ___, ___, ___,
+  ___, YEL, YEL, YEL, YEL, YEL, ___, ___,
+  ___, ___, ___, YEL, YEL, ___, ___, ___,
+  ___, ___, YEL, YEL, ___, ___, ___, ___,
+  ___, YEL, YEL, ___, ___, ___, ___, ___,
+  ___, ___, ___, ___, ___, ___, ___, ___
+};
+
+// Snowflake
+const uint8_t ICON_SNOW[64] PROGMEM = {
+  ___, ___, ___, CYN, CYN, ___, ___, ___,
+  ___, CYN, ___, CYN, CYN, ___, CYN, ___,
+  ___, ___, CYN, CYN, CYN, CYN, ___, ___,
+  CYN, CYN, CYN, CYN, CYN, CYN, CYN, CYN,
+  CYN, CYN, CYN, CYN, CYN, CYN, CYN, CYN,
+  ___, ___, CYN, CYN, CYN, CYN, ___, ___,
+  ___, CYN, ___, CYN, CYN, ___, CYN, ___,
+  ___, ___, ___, CYN, CYN, ___, ___, ___
+};
+
+// Tree
+const uint8_t ICON_TREE[64] PROGMEM = {
+  ___, ___, ___, GRN, GRN, ___, ___, ___,
+  ___, ___, GRN, GRN, GRN, GRN, ___, ___,
+  ___, GRN, GRN, GRN, GRN, GRN, GRN, ___,
+  GRN, GRN, GRN, GRN, GRN, GRN, GRN, GRN,
+  GRN, GRN, GRN, GRN, GRN, GRN, GRN, GRN,
+  ___, ___, ___, BRN, BRN, ___, ___, ___,
+  ___, ___, ___, BRN, BRN, ___, ___, ___,
+  ___, ___, ___, BRN, BRN, ___, ___, ___
+};
+
+// Coin (gold)
+const uint8_t ICON_COIN[64] PROGMEM = {
+  ___, ___, YEL, YEL, YEL, YEL, ___, ___,
+  ___, YEL, ORG, ORG, ORG, ORG, YEL, ___,
+  YEL, ORG, YEL, ORG, ORG, YEL, ORG, YEL,
+  YEL, ORG, ORG, YEL, YEL, ORG, ORG, YEL,
+  YEL, ORG, ORG, YEL, YEL, ORG, ORG, YEL,
+  YEL, ORG, YEL, ORG, ORG, YEL, ORG, YEL,
+  ___, YEL, ORG, ORG, ORG, ORG, YEL, ___,
+  ___, ___, YEL, YEL, YEL, YEL, ___, ___
+};
+
+// Key
+const uint8_t ICON_KEY[64] PROGMEM = {
+  ___, ___, YEL, YEL, YEL, ___, ___, ___,
+  ___, YEL, ___, ___, ___, YEL, ___, ___,
+  ___, YEL, ___, ___, ___, YEL, ___, ___,
+  ___, ___, YEL, YEL, YEL, ___, ___, ___,
+  ___, ___, ___, YEL, ___, ___, ___, ___,
+  ___, ___, ___, YEL, YEL, ___, ___, ___,
+  ___, ___, ___, YEL, ___, ___, ___, ___,
+  ___, ___, ___, YEL, YEL, ___, ___, ___
+};
+
+// Gem (diamond)
+const uint8_t ICON_GEM[64] PROGMEM = {
+  ___, ___, CYN, CYN, CYN, CYN, ___, ___,
+  ___, CYN, WHT, CYN, CYN, WHT, CYN, ___,
+  CYN, WHT, CYN, CYN, CYN, CYN, WHT, CYN,
+  ___, CYN, CYN, CYN, CYN, CYN, CYN, ___,
+  ___, ___, CYN, CYN, CYN, CYN, ___, ___,
+  ___, ___, ___, CYN, CYN, ___, ___, ___,
+  ___, ___, ___, CYN, CYN, ___, ___, ___,
+  ___, ___, ___, ___, ___, ___, ___, ___
+};
+
 // Clean up index macros to avoid polluting namespace
 #undef ___
 #undef RED
@@ -529,7 +688,7 @@ const uint8_t ICON_POPSICLE[64] PROGMEM = {
 #undef PST
 
 // ==================== ICON COUNT ====================
-#define ICON_COUNT 28
+#define ICON_COUNT 41
 
 // Array of all icons for easy iteration
 const uint8_t* const ALL_ICONS[ICON_COUNT] PROGMEM = {
@@ -541,7 +700,10 @@ const uint8_t* const ALL_ICONS[ICON_COUNT] PROGMEM = {
   ICON_PACMAN, ICON_PACMAN_GHOST, ICON_SHY_GUY, ICON_MUSIC,
   ICON_WIFI, ICON_RAINBOW, ICON_MUSHROOM, ICON_SKELLY,
   ICON_CHICKEN, ICON_INVADER, ICON_DRAGON, ICON_TWINKLE_HEART,
-  ICON_POPSICLE
+  ICON_POPSICLE, ICON_SMILEY, ICON_QUESTION, ICON_EXCLAIM,
+  ICON_SUN, ICON_MOON, ICON_CLOUD, ICON_RAIN,
+  ICON_LIGHTNING, ICON_SNOW, ICON_TREE, ICON_COIN,
+  ICON_KEY, ICON_GEM
 };
 
 // Icon names for debugging
@@ -553,7 +715,9 @@ const char* const ICON_NAMES[ICON_COUNT] PROGMEM = {
   "ArrowRight", "Skull", "Ghost", "Alien",
   "Pacman", "PacGhost", "ShyGuy", "Music",
   "WiFi", "Rainbow", "Mushroom", "Skelly",
-  "chicken", "invader", "dragon", "twinkleheart", "popsicle"
+  "chicken", "invader", "dragon", "twinkleheart", "popsicle",
+  "Smiley", "Question", "Exclaim", "Sun", "Moon", "Cloud", "Rain",
+  "Lightning", "Snow", "Tree", "Coin", "Key", "Gem"
 };
 
 // Compatibility aliases for emoji system
@@ -561,4 +725,4 @@ const char* const ICON_NAMES[ICON_COUNT] PROGMEM = {
 #define emojiSprites ALL_ICONS
 #define emojiNames ICON_NAMES
 
-#endif // ICONS_8X8_H
+#endif // VIZFX_SPRITES_H
@@ -0,0 +1,201 @@
+// vizfx on every sketch's config: the registry against the sketch's counts,
+// XY() onto leds[], every effect run under make asan, the hi-res variants on
+// the target's screen size, and the icon set. Built once per profile — a
+// sketch and board, from PROFILE_* in the Makefile.
+
+#include "host_test.h"
+#include "config.h"
+
+// The screen for hi-res profiles. vizbot's GfxDevice is its LovyanGFX
+// DisplayProxy and vizpow's is Arduino_GFX; fills are all vizfx uses, so
+// the Arduino_GFX stub stands in for both.
+#if defined(HIRES_ENABLED)
+#include <Arduino_GFX_Library.h>
+struct DisplayProxy : Arduino_GFX {
+  DisplayProxy() : Arduino_GFX(LCD_WIDTH, LCD_HEIGHT) {}
+};
+#endif
+
+#include <vizfx.h>
+#include "host_clock.h"
+#include <set>
+#include <string>
+
+CRGB leds[NUM_LEDS];
+CRGBPalette16 currentPalette = RainbowColors_p;
+
+#if defined(VIZFX_MOTION)
+float accelX = 0, accelY = 0, accelZ = 1;
+float gyroX = 0, gyroY = 0, gyroZ = 0;
+#endif
+
+#if defined(VIZFX_HIRES)
+GfxDevice* gfx = nullptr;
+bool hiResMode = false;
+bool hiResRenderedThisFrame = false;
+  #if defined(TOUCH_ENABLED)
+bool menuVisible = false;
+  #endif
+#endif
+
+static void checkTable(const VizFxEffect* table, int count, bool wantHiRes) {
+  std::set<std::string> names;
+  for (int e = 0; e < count; e++) {
+    CHECK(table[e].name != nullptr && table[e].name[0] != '\0');
+    CHECK(table[e].render != nullptr);
+    CHECK_EQ(table[e].renderHiRes != nullptr, wantHiRes);
+    if (table[e].name) names.insert(table[e].name);
+  }
+  CHECK_EQ(names.size(), (size_t)count);   // The menus list them by name
+}
+
+TEST(registry_matches_sketch) {
+  CHECK_EQ(VIZFX_COUNT(ambientEffects), NUM_AMBIENT_EFFECTS);
+  CHECK_EQ(VIZFX_COUNT(palettes), NUM_PALETTES);
+#if defined(VIZFX_HIRES)
+  checkTable(ambientEffects, NUM_AMBIENT_EFFECTS, true);
+#else
+  checkTable(ambientEffects, NUM_AMBIENT_EFFECTS, false);
+#endif
+#if defined(VIZFX_MOTION)
+  CHECK_EQ(VIZFX_COUNT(motionEffects), NUM_MOTION_EFFECTS);
+  checkTable(motionEffects, NUM_MOTION_EFFECTS, false);
+#endif
+  // Out-of-range indices (a stale setting) are ignored
+  runAmbientEffect(NUM_AMBIENT_EFFECTS);
+  runAmbientEffect(255);
+}
+
+// The unattached canvas is the sketch's matrix, row-major, hitting every
+// LED once (fixed at compile time on the ESP8266)
+TEST(xy_covers_leds) {
+#if defined(VIZFX_LOW_MEMORY)
+  static_assert(canvas.size == NUM_LEDS && canvas.xyMap == nullptr, "constexpr canvas");
+#endif
+  CHECK_EQ(canvas.width, MATRIX_WIDTH);
+  CHECK_EQ(canvas.height, MATRIX_HEIGHT);
+  CHECK_EQ(canvas.size, NUM_LEDS);
+  std::vector<int> hits(NUM_LEDS);
+  int outside = 0;
+  for (int y = 0; y < MATRIX_HEIGHT; y++) {
+    for (int x = 0; x < MATRIX_WIDTH; x++) {
+      uint16_t i = XY(x, y);
+      if (i < NUM_LEDS) hits[i]++;
+      else outside++;
+    }
+  }
+  CHECK_EQ(outside, 0);
+  CHECK_EQ(std::count(hits.begin(), hits.end(), 1), NUM_LEDS);
+}
+
+// Every LED effect for 300 frames: it lights something, and make asan sees
+// every write
+TEST(every_effect_runs) {
+  int dark = 0;
+  for (int e = 0; e < NUM_AMBIENT_EFFECTS; e++) {
+    bool lit = false;
+    for (int f = 0; f < 300; f++) {
+      runAmbientEffect(e);
+      hostAdvanceMs(40);
+      for (const CRGB& c : leds) lit |= (c.r | c.g | c.b) != 0;
+    }
+    if (!lit) fprintf(stderr, "  %s never lit an LED\n", ambientEffects[e].name);
+    dark += !lit;
+  }
+#if defined(VIZFX_MOTION)
+  for (int e = 0; e < NUM_MOTION_EFFECTS; e++) {
+    bool lit = false;
+    for (int f = 0; f < 300; f++) {
+      accelX = 0.4f * sin(f * 0.07f);
+      accelY = 0.4f * cos(f * 0.05f);
+      accelZ = (f % 60 < 3) ? 2.5f : 1.0f;
+      gyroZ = 60 * cos(f * 0.02f);
+      runMotionEffect(e);
+      hostAdvanceMs(20);
+      for (const CRGB& c : leds) lit |= (c.r | c.g | c.b) != 0;
+    }
+    if (!lit) fprintf(stderr, "  %s never lit an LED\n", motionEffects[e].name);
+    dark += !lit;
+  }
+#endif
+  CHECK_EQ(dark, 0);
+}
+
+#if defined(VIZFX_HIRES)
+
+// Hi-res variants on this target's screen: each paints the whole screen,
+// nothing past its edges, says it rendered, and leaves leds[] alone
+TEST(hires_effects_fill_screen) {
+  DisplayProxy screen;
+  gfx = &screen;
+  hiResMode = true;
+  int bad = 0;
+  for (int e = 0; e < NUM_AMBIENT_EFFECTS; e++) {
+    fill_solid(leds, NUM_LEDS, CRGB::Black);
+    int unpainted = 0, unflagged = 0;
+    for (int f = 0; f < 100; f++) {
+      std::fill(screen.fb.begin(), screen.fb.end(), 0xDEAD);
+      hiResRenderedThisFrame = false;
+      runAmbientEffect(e);
+      unflagged += !hiResRenderedThisFrame;
+      unpainted += std::count(screen.fb.begin(), screen.fb.end(), 0xDEAD) != 0;
+    }
+    int ledsTouched = 0;
+    for (const CRGB& c : leds) ledsTouched += (c.r | c.g | c.b) != 0;
+    if (unpainted || unflagged || screen.offscreen || ledsTouched) {
+      fprintf(stderr, "  %s: %d frames left pixels unpainted, %d unflagged, %u shapes off screen, "
+              "%d LEDs written\n", ambientEffects[e].name, unpainted, unflagged, screen.offscreen,
+              ledsTouched);
+      bad++;
+    }
+    screen.offscreen = 0;
+  }
+  CHECK_EQ(bad, 0);
+
+  // Without a screen, or with the menu up, the LED version runs
+  auto ledsLit = [] {
+    int lit = 0;
+    for (const CRGB& c : leds) lit += (c.r | c.g | c.b) != 0;
+    fill_solid(leds, NUM_LEDS, CRGB::Black);
+    return lit;
+  };
+  const uint32_t fills = screen.fillRects;
+#if defined(TOUCH_ENABLED)
+  menuVisible = true;
+  runAmbientEffect(0);
+  CHECK(ledsLit() > 0);
+  menuVisible = false;
+#endif
+  gfx = nullptr;
+  runAmbientEffect(0);
+  CHECK(ledsLit() > 0);
+  CHECK_EQ(screen.fillRects, fills);
+}
+
+#endif // VIZFX_HIRES
+
+// Every icon only uses colours from the icon palette, shows something, and
+// differs from the others
+TEST(icons_decode) {
+  CHECK_EQ(ICON_COUNT, 41);
+  std::set<std::vector<uint8_t>> seen;
+  for (int i = 0; i < ICON_COUNT; i++) {
+    const uint8_t* icon = (const uint8_t*)pgm_read_ptr(&ALL_ICONS[i]);
+    int badIndex = 0, lit = 0;
+    for (int p = 0; p < 64; p++) {
+      badIndex += pgm_read_byte(&icon[p]) >= ICON_PALETTE_SIZE;
+      lit += pgm_read_byte(&icon[p]) != 0;
+    }
+    if (badIndex || !lit) fprintf(stderr, "  icon %s: %d bad indices, %d lit\n", ICON_NAMES[i], badIndex, lit);
+    CHECK_EQ(badIndex, 0);
+    CHECK(lit > 0);
+    seen.insert(std::vector<uint8_t>(icon, icon + 64));
+
+    CRGB px[64];
+    decodeIcon(icon, px);
+    for (int p = 0; p < 64; p++) CHECK(px[p] == iconPalette[icon[p]]);
+  }
+  CHECK_EQ(seen.size(), (size_t)ICON_COUNT);
+}
+
+HOST_TEST_MAIN
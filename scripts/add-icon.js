@@ -10,7 +10,7 @@
  * This script will:
  *   1. Parse WLED JSON format
  *   2. Convert to CRGB array format
- *   3. Add to emoji_sprites.h
+ *   3. Add to vizfx_sprites.h
  *   4. Update ICON_COUNT, ALL_ICONS, ICON_NAMES
  *   5. Update web_server.h emojiNames array
  */
@@ -18,7 +18,7 @@
 const fs = require('fs');
 const path = require('path');
 
-// Color shortcuts from emoji_sprites.h
+// Color shortcuts from vizfx_sprites.h
 const COLOR_SHORTCUTS = {
   '0,0,0': '___',
   '255,0,0': 'RED',
@@ -45,7 +45,7 @@ const COLOR_SHORTCUTS = {
 
 // Paths relative to project root
 const PROJECT_ROOT = path.join(__dirname, '..');
-const SPRITES_PATH = path.join(PROJECT_ROOT, 'vizpow', 'emoji_sprites.h');
+const SPRITES_PATH = path.join(PROJECT_ROOT, 'lib', 'vizfx', 'src', 'vizfx_sprites.h');
 const WEBSERVER_PATH = path.join(PROJECT_ROOT, 'vizpow', 'web_server.h');
 
 function rgbToCrgb(r, g, b) {
@@ -122,20 +122,20 @@ function updateEmojiSprites(iconName, pixels) {
 
   // Check if icon already exists
   if (content.includes(constName)) {
-    throw new Error(`Icon ${constName} already exists in emoji_sprites.h`);
+    throw new Error(`Icon ${constName} already exists in vizfx_sprites.h`);
   }
 
   // 1. Add icon definition before "// ==================== ICON COUNT ===================="
   const iconCountMarker = '// ==================== ICON COUNT ====================';
   if (!content.includes(iconCountMarker)) {
-    throw new Error('Could not find ICON COUNT marker in emoji_sprites.h');
+    throw new Error('Could not find ICON COUNT marker in vizfx_sprites.h');
   }
   content = content.replace(iconCountMarker, `${code}\n${iconCountMarker}`);
 
   // 2. Update ICON_COUNT
   const countMatch = content.match(/#define ICON_COUNT (\d+)/);
   if (!countMatch) {
-    throw new Error('Could not find ICON_COUNT in emoji_sprites.h');
+    throw new Error('Could not find ICON_COUNT in vizfx_sprites.h');
   }
   const oldCount = parseInt(countMatch[1]);
   const newCount = oldCount + 1;
@@ -145,7 +145,7 @@ function updateEmojiSprites(iconName, pixels) {
   // Find the last icon in the array and add after it
   const allIconsMatch = content.match(/const CRGB\* ALL_ICONS\[ICON_COUNT\] = \{([^}]+)\}/);
   if (!allIconsMatch) {
-    throw new Error('Could not find ALL_ICONS array in emoji_sprites.h');
+    throw new Error('Could not find ALL_ICONS array in vizfx_sprites.h');
   }
   const allIconsContent = allIconsMatch[1];
   const newAllIconsContent = allIconsContent.trimEnd() + `, ${constName}\n`;
@@ -159,7 +159,7 @@ function updateEmojiSprites(iconName, pixels) {
   const displayName = iconName.replace(/\s+/g, '');
   const iconNamesMatch = content.match(/const char\* ICON_NAMES\[ICON_COUNT\] = \{([^}]+)\}/);
   if (!iconNamesMatch) {
-    throw new Error('Could not find ICON_NAMES array in emoji_sprites.h');
+    throw new Error('Could not find ICON_NAMES array in vizfx_sprites.h');
   }
   const iconNamesContent = iconNamesMatch[1];
   const newIconNamesContent = iconNamesContent.trimEnd() + `, "${displayName}"\n`;
@@ -169,7 +169,7 @@ function updateEmojiSprites(iconName, pixels) {
   );
 
   fs.writeFileSync(SPRITES_PATH, content);
-  console.log(`Updated emoji_sprites.h:`);
+  console.log(`Updated vizfx_sprites.h:`);
   console.log(`  - Added ${constName} definition`);
   console.log(`  - Updated ICON_COUNT: ${oldCount} -> ${newCount}`);
   console.log(`  - Added to ALL_ICONS array`);
@@ -201,12 +201,12 @@ function updateWebServer(displayName) {
 
   // Update the comment with icon count
   content = content.replace(
-    /\/\/ Icon names matching emoji_sprites\.h \(\d+ icons\)/,
+    /\/\/ Icon names matching vizfx_sprites\.h \(\d+ icons\)/,
     (match) => {
       const countMatch = match.match(/\((\d+) icons\)/);
       if (countMatch) {
         const newCount = parseInt(countMatch[1]) + 1;
-        return `// Icon names matching emoji_sprites.h (${newCount} icons)`;
+        return `// Icon names matching vizfx_sprites.h (${newCount} icons)`;
       }
       return match;
     }
@@ -265,7 +265,7 @@ The WLED JSON should contain 64 pixels (192 RGB values) in one of these formats:
     const pixels = parseWledJson(jsonInput);
     console.log(`Parsed ${pixels.length} pixels from JSON\n`);
 
-    // Update emoji_sprites.h
+    // Update vizfx_sprites.h
     const { displayName } = updateEmojiSprites(iconName, pixels);
     console.log('');
 
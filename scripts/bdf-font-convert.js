@@ -0,0 +1,216 @@
+#!/usr/bin/env node
+
+/**
+ * BDF Font Converter for vizBot WLED text
+ *
+ * Usage:
+ *   node scripts/bdf-font-convert.js scripts/fonts/wled-5x7.bdf [outDir] [--spacing N]
+ *   node scripts/bdf-font-convert.js --dump scripts/fonts/wled-5x7.bdf
+ *
+ * Compiles a BDF bitmap font into vizbot/wled_font_<name>.h: one byte per
+ * glyph column (LSB = top row of the cell), stored in PROGMEM. Fonts whose
+ * glyphs all share one advance width are written as fixed-cell tables;
+ * anything else gets per-glyph offset and width tables as well. --dump prints
+ * every glyph as ASCII art so an edit can be checked before regenerating.
+ *
+ * Only printable ASCII (0x20–0x7E) is kept and cells must be at most 8 rows
+ * tall. Glyph width is the BDF advance minus the spacing (default 1), which
+ * the firmware adds back between characters.
+ *
+ * Format: see vizbot/wled_font.h (struct WledFont) — keep the two in sync.
+ */
+
+const fs = require('fs');
+const path = require('path');
+
+const FIRST = 0x20;
+const LAST = 0x7E;
+const COUNT = LAST - FIRST + 1;
+const MAX_HEIGHT = 8;   // Column masks are one byte
+
+function fail(msg) {
+  console.error(`Error: ${msg}`);
+  process.exit(1);
+}
+
+function parseBdf(text, file) {
+  const font = { name: null, ascent: null, descent: null, glyphs: new Map() };
+  const lines = text.split(/\r?\n/);
+  let g = null;
+  let bitmap = null;
+
+  for (let i = 0; i < lines.length; i++) {
+    const line = lines[i].trim();
+    const [key, ...args] = line.split(/\s+/);
+    if (bitmap) {
+      if (key === 'ENDCHAR') {
+        g.rows = bitmap;
+        if (g.encoding >= FIRST && g.encoding <= LAST) font.glyphs.set(g.encoding, g);
+        g = null;
+        bitmap = null;
+      } else {
+        bitmap.push(parseInt(key, 16));
+      }
+      continue;
+    }
+    switch (key) {
+      case 'FONT': font.name = args[0]; break;
+      case 'FONT_ASCENT': font.ascent = parseInt(args[0], 10); break;
+      case 'FONT_DESCENT': font.descent = parseInt(args[0], 10); break;
+      case 'STARTCHAR': g = { label: args.join(' '), encoding: -1, dwidth: 0, bbx: [0, 0, 0, 0] }; break;
+      case 'ENCODING': g.encoding = parseInt(args[0], 10); break;
+      case 'DWIDTH': g.dwidth = parseInt(args[0], 10); break;
+      case 'BBX': g.bbx = args.map(a => parseInt(a, 10)); break;
+      case 'BITMAP': bitmap = []; break;
+    }
+  }
+
+  if (font.ascent === null || font.descent === null) {
+    fail(`${file}: FONT_ASCENT/FONT_DESCENT missing`);
+  }
+  font.height = font.ascent + font.descent;
+  if (font.height > MAX_HEIGHT) {
+    fail(`${file}: ${font.height} rows tall, max ${MAX_HEIGHT}`);
+  }
+  for (let c = FIRST; c <= LAST; c++) {
+    if (!font.glyphs.has(c)) fail(`${file}: no glyph for 0x${c.toString(16)}`);
+  }
+  return font;
+}
+
+// Glyph → column masks `width` wide, bit 0 = top row of the cell
+function glyphColumns(font, g, width) {
+  const [bw, bh, bx, by] = g.bbx;
+  const rowBytes = Math.ceil(bw / 8);
+  const top = font.ascent - (by + bh);
+  const cols = new Array(width).fill(0);
+  g.rows.forEach((bits, i) => {
+    const y = top + i;
+    if (y < 0 || y >= font.height) return;
+    for (let c = 0; c < bw; c++) {
+      if (!(bits & (1 << (rowBytes * 8 - 1 - c)))) continue;
+      const x = bx + c;
+      if (x >= 0 && x < width) cols[x] |= 1 << y;
+    }
+  });
+  return cols;
+}
+
+function compile(font, spacing) {
+  const glyphs = [];
+  for (let c = FIRST; c <= LAST; c++) {
+    const g = font.glyphs.get(c);
+    const width = Math.max(g.dwidth - spacing, 1);
+    glyphs.push({ code: c, width, cols: glyphColumns(font, g, width) });
+  }
+  const fixed = glyphs.every(g => g.width === glyphs[0].width);
+  return { glyphs, fixed, width: Math.max(...glyphs.map(g => g.width)) };
+}
+
+function charLabel(c) {
+  const ch = String.fromCharCode(c);
+  return c === 0x20 ? "' ' (space)" : `'${ch}'`;
+}
+
+function hex(v, digits = 2) {
+  return '0x' + v.toString(16).toUpperCase().padStart(digits, '0');
+}
+
+function emitHeader(font, compiled, spacing, source) {
+  const id = font.name.replace(/^wled[-_]/i, '').replace(/[^A-Za-z0-9]/g, '_');
+  const sym = `WLED_FONT_${id.toUpperCase()}`;
+  const guard = `${sym}_H`;
+  const { glyphs, fixed } = compiled;
+  const total = glyphs.reduce((n, g) => n + g.width, 0);
+  const out = [];
+
+  out.push(`#ifndef ${guard}`, `#define ${guard}`, '');
+  out.push('// ============================================================================');
+  out.push(`// ${font.name} — generated by scripts/bdf-font-convert.js, do not edit`);
+  out.push('// ============================================================================');
+  out.push(`// Source: ${source}`);
+  out.push(`// ${fixed ? `Fixed ${compiled.width}` : `Proportional, up to ${compiled.width}`}` +
+           `x${font.height} px, ${spacing}px spacing, ${total} columns.`);
+  out.push('// One byte per column, LSB = top row. Included by wled_font.h.');
+  out.push('// ============================================================================', '');
+
+  out.push(`static const uint8_t PROGMEM ${sym}_COLS[${total}] = {`);
+  for (const g of glyphs) {
+    out.push(`  // ${hex(g.code)} ${charLabel(g.code)}`);
+    out.push('  ' + g.cols.map(v => hex(v) + ',').join(' '));
+  }
+  out.push('};', '');
+
+  if (!fixed) {
+    let offset = 0;
+    const offsets = glyphs.map(g => { const o = offset; offset += g.width; return o; });
+    out.push(`static const uint16_t PROGMEM ${sym}_OFFSETS[${COUNT}] = {`);
+    for (let i = 0; i < COUNT; i += 12) {
+      out.push('  ' + offsets.slice(i, i + 12).map(o => `${o},`).join(' '));
+    }
+    out.push('};', '');
+    out.push(`static const uint8_t PROGMEM ${sym}_WIDTHS[${COUNT}] = {`);
+    for (let i = 0; i < COUNT; i += 16) {
+      out.push('  ' + glyphs.slice(i, i + 16).map(g => `${g.width},`).join(' '));
+    }
+    out.push('};', '');
+  }
+
+  out.push(`static const WledFont ${sym} = {`);
+  out.push(`  "${id.toLowerCase()}", ${sym}_COLS,`);
+  out.push(fixed ? '  nullptr, nullptr,' : `  ${sym}_OFFSETS, ${sym}_WIDTHS,`);
+  out.push(`  ${compiled.width}, ${font.height}, ${hex(FIRST)}, ${COUNT}, ${spacing}`);
+  out.push('};', '');
+  out.push(`#endif // ${guard}`, '');
+
+  return { file: `wled_font_${id.toLowerCase()}.h`, text: out.join('\n') };
+}
+
+function dump(font, compiled) {
+  console.log(`${font.name}: ${font.height} rows, ascent ${font.ascent}, ` +
+              `${compiled.fixed ? 'fixed' : 'proportional'}, max width ${compiled.width}`);
+  for (const g of compiled.glyphs) {
+    console.log(`\n${hex(g.code)} ${charLabel(g.code)} width ${g.width}`);
+    for (let y = 0; y < font.height; y++) {
+      console.log('  ' + g.cols.map(c => (c >> y) & 1 ? '#' : '.').join(''));
+    }
+  }
+}
+
+function main() {
+  const args = process.argv.slice(2);
+  let spacing = 1;
+  const si = args.indexOf('--spacing');
+  if (si >= 0) {
+    spacing = parseInt(args[si + 1], 10);
+    if (!(spacing >= 0)) fail('--spacing needs a number');
+    args.splice(si, 2);
+  }
+  const dumpMode = args[0] === '--dump';
+  if (dumpMode) args.shift();
+  if (args.length < 1) {
+    console.error('Usage: node scripts/bdf-font-convert.js font.bdf [outDir] [--spacing N]');
+    console.error('       node scripts/bdf-font-convert.js --dump font.bdf');
+    process.exit(1);
+  }
+
+  const file = args[0];
+  const font = parseBdf(fs.readFileSync(file, 'utf8'), file);
+  if (!font.name) font.name = path.basename(file, '.bdf');
+  const compiled = compile(font, spacing);
+
+  if (dumpMode) {
+    dump(font, compiled);
+    return;
+  }
+
+  const outDir = args[1] || path.join(__dirname, '..', 'vizbot');
+  const source = path.relative(path.join(__dirname, '..'), path.resolve(file)).split(path.sep).join('/');
+  const header = emitHeader(font, compiled, spacing, source);
+  const outPath = path.join(outDir, header.file);
+  fs.writeFileSync(outPath, header.text);
+  const bytes = compiled.glyphs.reduce((n, g) => n + g.width, 0) + (compiled.fixed ? 0 : COUNT * 3);
+  console.log(`Wrote ${outPath} (${bytes} bytes of glyph data)`);
+}
+
+main();
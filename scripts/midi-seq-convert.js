@@ -0,0 +1,156 @@
+#!/usr/bin/env node
+
+/**
+ * MIDI Sequence Converter for vizBot
+ *
+ * Usage:
+ *   node scripts/midi-seq-convert.js sequences.json [outDir]
+ *   node scripts/midi-seq-convert.js --dump path/to/0.bin
+ *
+ * Converts a vizCloud sequences array (same JSON the bot receives) into the
+ * compact binary files the firmware stores under /cloud/seq/<n>.bin, or dumps
+ * a .bin back to JSON so a file pulled off a device can be checked.
+ *
+ * Format: see vizbot/midi_seq_file.h — keep the two in sync.
+ */
+
+const fs = require('fs');
+const path = require('path');
+
+const VERSION = 1;
+const STATUS_DEFAULT = 0x90;
+const STATUS_PROGRAM = 0xC0;
+const MAX_SEQUENCES = 20;   // MAX_CLOUD_SEQUENCES
+const MAX_EVENTS = 4096;    // MIDI_SEQ_MAX_EVENTS
+
+function vlq(value) {
+  const bytes = [value & 0x7F];
+  while ((value >>= 7) > 0) bytes.unshift(0x80 | (value & 0x7F));
+  return bytes;
+}
+
+function encodeSequence(seq) {
+  const name = Buffer.from(String(seq.name || 'Cloud')).subarray(0, 31);
+  const events = (seq.events || []).slice(0, MAX_EVENTS).map(ev => ({
+    note: ev.note ?? 0,
+    velocity: ev.velocity ?? 100,
+    channel: ev.channel ?? 0,
+    program: ev.program ?? 255,
+    duration: ev.duration ?? 100,
+    offset: ev.offset ?? 0,
+  }));
+  // Firmware walks events in order — sort here (stable, so chords keep order)
+  events.sort((a, b) => a.offset - b.offset);
+
+  const body = [];
+  let last = 0;
+  let status = STATUS_DEFAULT;
+  let program = 255;
+  let totalMs = 0;
+  for (const ev of events) {
+    body.push(...vlq(ev.offset - last));
+    last = ev.offset;
+    const ch = ev.channel & 0x0F;
+    const s = (ev.program === 255 ? STATUS_DEFAULT : STATUS_PROGRAM) | ch;
+    if (s !== status || (s >= STATUS_PROGRAM && ev.program !== program)) {
+      body.push(s);
+      if (s >= STATUS_PROGRAM) body.push(ev.program & 0x7F);
+      status = s;
+      program = ev.program;
+    }
+    body.push(ev.note & 0x7F, ev.velocity & 0x7F, ...vlq(ev.duration));
+    totalMs = Math.min(0xFFFF, Math.max(totalMs, ev.offset + ev.duration));
+  }
+
+  const header = Buffer.alloc(11);
+  header.write('VSQ', 0, 'ascii');
+  header[3] = VERSION;
+  header[4] = seq.defaultProgram ?? 0;
+  header[5] = 0;
+  header.writeUInt16LE(events.length, 6);
+  header.writeUInt16LE(totalMs, 8);
+  header[10] = name.length;
+  return Buffer.concat([header, name, Buffer.from(body)]);
+}
+
+function decodeSequence(buf) {
+  if (buf.toString('ascii', 0, 3) !== 'VSQ' || buf[3] !== VERSION) {
+    throw new Error('Not a VSQ v1 file');
+  }
+  const count = buf.readUInt16LE(6);
+  const nameLen = buf[10];
+  let pos = 11 + nameLen;
+  const readVlq = () => {
+    let v = 0;
+    let b;
+    do {
+      b = buf[pos++];
+      v = (v << 7) | (b & 0x7F);
+    } while (b & 0x80);
+    return v;
+  };
+
+  const events = [];
+  let status = STATUS_DEFAULT;
+  let program = 255;
+  let offset = 0;
+  for (let i = 0; i < count; i++) {
+    offset += readVlq();
+    if (buf[pos] & 0x80) {
+      status = buf[pos++];
+      program = (status & 0xF0) === STATUS_PROGRAM ? buf[pos++] : 255;
+    }
+    const note = buf[pos++];
+    const velocity = buf[pos++];
+    const duration = readVlq();
+    events.push({ note, velocity, channel: status & 0x0F, program, duration, offset });
+  }
+  return {
+    name: buf.toString('utf8', 11, 11 + nameLen),
+    defaultProgram: buf[4],
+    totalMs: buf.readUInt16LE(8),
+    events,
+  };
+}
+
+function main() {
+  const args = process.argv.slice(2);
+
+  if (args.length === 0) {
+    console.log(`
+Usage:
+  node scripts/midi-seq-convert.js sequences.json [outDir]
+  node scripts/midi-seq-convert.js --dump path/to/0.bin
+`);
+    process.exit(1);
+  }
+
+  try {
+    if (args[0] === '--dump') {
+      const seq = decodeSequence(fs.readFileSync(args[1]));
+      console.log(JSON.stringify(seq, null, 2));
+      return;
+    }
+
+    const sequences = JSON.parse(fs.readFileSync(args[0], 'utf8'));
+    if (!Array.isArray(sequences)) throw new Error('Expected a JSON array of sequences');
+    const outDir = args[1] || 'seq';
+    fs.mkdirSync(outDir, { recursive: true });
+
+    sequences.slice(0, MAX_SEQUENCES).forEach((seq, i) => {
+      const bin = encodeSequence(seq);
+      const jsonSize = Buffer.byteLength(JSON.stringify(seq));
+      const ramSize = (seq.events || []).length * 8;
+      fs.writeFileSync(path.join(outDir, `${i}.bin`), bin);
+      console.log(`${i}.bin  "${seq.name}"  ${(seq.events || []).length} events  ` +
+                  `${bin.length}B (JSON ${jsonSize}B, RAM ${ramSize}B)`);
+    });
+    console.log(`\nWrote ${Math.min(sequences.length, MAX_SEQUENCES)} file(s) to ${outDir}/`);
+    console.log('Upload them to /cloud/seq/ on LittleFS, or let the bot convert on its next cloud sync.');
+  } catch (e) {
+    console.error(`Error: ${e.message}`);
+    process.exit(1);
+  }
+}
+
+main();
@@ -0,0 +1,526 @@
+#!/usr/bin/env node
+
+/**
+ * WLED Emulator for vizBot
+ *
+ * Usage:
+ *   node scripts/wled-emulator.js [options]
+ *   node scripts/wled-emulator.js --stats frames.jsonl
+ *   node scripts/wled-emulator.js --render frames.jsonl out.png [--scale N] [--every N] [--max N]
+ *
+ * Stands in for a WLED matrix so the bot's WLED code can be exercised without
+ * hardware: point the bot's WLED IP (/wled/config?ip=) at this machine and it
+ * receives DDP on UDP 4048 and serves the /json/state API on HTTP 80, the same
+ * ports the firmware hard-codes. Like WLED, DDP puts it in realtime mode until
+ * 2.5s of silence or a POST with "live":false, and /ws pushes the full state
+ * to every WebSocket client on connect and after each change.
+ *
+ * Options (live mode):
+ *   --ddp-port N       UDP port for DDP (default 4048)
+ *   --http-port N      HTTP port (default 80)
+ *   --width N          Matrix width (default 32)
+ *   --height N         Matrix height (default 8)
+ *   --layout L         LED order: rtl (vizbot default, every row right→left),
+ *                      ltr, or serpentine
+ *   --record FILE      Append every displayed frame to FILE as JSON lines
+ *   --loss P           Drop DDP packets with probability P (0..1)
+ *   --latency MS       Delay each DDP packet by MS before it is displayed
+ *   --jitter MS        ...plus a random 0..MS on top
+ *   --http-delay MS    Delay every HTTP response by MS (firmware gives up at 500)
+ *   --http-fail P      Answer HTTP requests with 503 with probability P
+ *   --no-ws            Refuse /ws upgrades, like a WLED built without WebSockets
+ *   --ws-frag N        Send pushes as N-byte fragments (continuation frames)
+ *   --cycle MS         Change the palette every MS, like someone in the WLED app
+ *   --quiet            Only print the periodic stats line
+ *
+ * Stats are printed every 5s and on Ctrl-C: frames shown, injected drops,
+ * DDP sequence gaps (packets lost on the way), frame interval mean/p95/max,
+ * how long after the last frame each restore POST arrived, and the state
+ * traffic: GETs (polls) versus WebSocket pushes.
+ *
+ * --stats summarises a recording offline; --render writes it as a PNG
+ * filmstrip (one row of LEDs per frame, newest at the bottom).
+ */
+
+const crypto = require('crypto');
+const dgram = require('dgram');
+const fs = require('fs');
+const http = require('http');
+const zlib = require('zlib');
+
+const DDP_HEADER = 10;
+const DDP_FLAG_PUSH = 0x01;
+const DDP_FLAG_TIMECODE = 0x10;
+const REALTIME_TIMEOUT_MS = 2500;   // WLED's default realtime timeout
+const STATS_INTERVAL_MS = 5000;
+const WS_GUID = '258EAFA5-E914-47DA-95CA-C5AB0DC85B11';
+const WS_OP_CONT = 0x0;
+const WS_OP_TEXT = 0x1;
+const WS_OP_CLOSE = 0x8;
+const WS_OP_PING = 0x9;
+const WS_OP_PONG = 0xA;
+
+function parseArgs(argv) {
+  const opts = {
+    ddpPort: 4048, httpPort: 80, width: 32, height: 8, layout: 'rtl',
+    record: null, loss: 0, latency: 0, jitter: 0, httpDelay: 0, httpFail: 0,
+    noWs: false, wsFrag: 0, cycle: 0, quiet: false, scale: 8, every: 1, max: 400, positional: [],
+  };
+  const num = { '--ddp-port': 'ddpPort', '--http-port': 'httpPort', '--width': 'width',
+                '--height': 'height', '--loss': 'loss', '--latency': 'latency',
+                '--jitter': 'jitter', '--http-delay': 'httpDelay', '--http-fail': 'httpFail',
+                '--ws-frag': 'wsFrag', '--cycle': 'cycle',
+                '--scale': 'scale', '--every': 'every', '--max': 'max' };
+  for (let i = 0; i < argv.length; i++) {
+    const a = argv[i];
+    if (num[a]) {
+      const v = Number(argv[++i]);
+      if (!Number.isFinite(v)) fail(`${a} needs a number`);
+      opts[num[a]] = v;
+    } else if (a === '--layout') opts.layout = argv[++i];
+    else if (a === '--record') opts.record = argv[++i];
+    else if (a === '--quiet') opts.quiet = true;
+    else if (a === '--no-ws') opts.noWs = true;
+    else if (a === '--stats' || a === '--render') opts.mode = a.slice(2);
+    else opts.positional.push(a);
+  }
+  if (!['rtl', 'ltr', 'serpentine'].includes(opts.layout)) fail(`unknown layout ${opts.layout}`);
+  return opts;
+}
+
+function fail(msg) {
+  console.error(`Error: ${msg}`);
+  process.exit(1);
+}
+
+// Physical LED index → logical row-major pixel index (inverse of wledRemapPixels)
+function ledToLogical(opts, led) {
+  const y = Math.floor(led / opts.width);
+  const i = led % opts.width;
+  const rtl = opts.layout === 'rtl' || (opts.layout === 'serpentine' && (y & 1));
+  return y * opts.width + (rtl ? opts.width - 1 - i : i);
+}
+
+function percentile(sorted, p) {
+  if (!sorted.length) return 0;
+  return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))];
+}
+
+function intervalSummary(times) {
+  const gaps = [];
+  for (let i = 1; i < times.length; i++) gaps.push(times[i] - times[i - 1]);
+  gaps.sort((a, b) => a - b);
+  const mean = gaps.length ? gaps.reduce((a, b) => a + b, 0) / gaps.length : 0;
+  return `interval mean ${mean.toFixed(1)}ms p95 ${percentile(gaps, 0.95).toFixed(1)}ms ` +
+         `max ${(gaps[gaps.length - 1] || 0).toFixed(1)}ms`;
+}
+
+// ============================================================================
+// Live emulator
+// ============================================================================
+
+function runEmulator(opts) {
+  const leds = opts.width * opts.height;
+  const physical = Buffer.alloc(leds * 3);
+  const t0 = process.hrtime.bigint();
+  const now = () => Number(process.hrtime.bigint() - t0) / 1e6;
+  const log = (...a) => { if (!opts.quiet) console.log(`[${(now() / 1000).toFixed(3)}]`, ...a); };
+  const record = opts.record ? fs.createWriteStream(opts.record, { flags: 'a' }) : null;
+
+  const state = {
+    on: true, bri: 128, transition: 7, live: false,
+    seg: { id: 0, start: 0, stop: leds, fx: 0, sx: 128, ix: 128, pal: 0, n: '' },
+  };
+  let lastDdpMs = 0;
+  let lastSeq = -1;
+
+  const stats = {
+    packets: 0, frames: 0, injectedDrops: 0, seqGaps: 0, bad: 0,
+    frameTimes: [], httpGets: 0, httpPosts: 0, httpFailed: 0, restores: [],
+    wsConnects: 0, wsPushes: 0, wsPings: 0,
+  };
+  const wsClients = new Set();
+
+  function display(rxMs, seq) {
+    const px = Buffer.alloc(leds * 3);
+    for (let led = 0; led < leds; led++) {
+      physical.copy(px, ledToLogical(opts, led) * 3, led * 3, led * 3 + 3);
+    }
+    const t = now();
+    stats.frames++;
+    stats.frameTimes.push(t);
+    if (stats.frameTimes.length > 4096) stats.frameTimes.shift();
+    if (!state.live) log('realtime on (DDP)');
+    state.live = true;
+    lastDdpMs = t;
+    if (record) {
+      record.write(JSON.stringify({ t: +t.toFixed(2), rx: +rxMs.toFixed(2), seq,
+                                    w: opts.width, h: opts.height, px: px.toString('base64') }) + '\n');
+    }
+  }
+
+  function handleDdp(msg) {
+    const rxMs = now();
+    stats.packets++;
+    if (msg.length < DDP_HEADER || (msg[0] >> 6) !== 1) { stats.bad++; return; }
+    const flags = msg[0];
+    const seq = msg[1] & 0x0F;
+    const offset = msg.readUInt32BE(4);
+    const len = msg.readUInt16BE(8);
+    const dataStart = DDP_HEADER + (flags & DDP_FLAG_TIMECODE ? 4 : 0);
+    if (msg.length < dataStart + len) { stats.bad++; return; }
+
+    // Sequence 0 means "unused" in DDP; the bot wraps 0-15, so count both.
+    // Checked before injected loss, so seq gaps are only real network drops.
+    if (lastSeq >= 0 && seq !== ((lastSeq + 1) & 0x0F)) {
+      stats.seqGaps += (seq - lastSeq - 1) & 0x0F;
+    }
+    lastSeq = seq;
+    if (Math.random() < opts.loss) { stats.injectedDrops++; return; }
+
+    const apply = () => {
+      if (offset < physical.length) {
+        msg.copy(physical, offset, dataStart, dataStart + Math.min(len, physical.length - offset));
+      }
+      if (flags & DDP_FLAG_PUSH) display(rxMs, seq);
+    };
+    const delay = opts.latency + Math.random() * opts.jitter;
+    if (delay > 0) setTimeout(apply, delay); else apply();
+  }
+
+  function applyState(body) {
+    const segs = Array.isArray(body.seg) ? body.seg : body.seg ? [body.seg] : [];
+    for (const k of ['on', 'bri', 'transition']) if (k in body) state[k] = body[k];
+    for (const s of segs) {
+      if ((s.id ?? 0) !== 0) continue;
+      for (const k of ['fx', 'sx', 'ix', 'pal', 'n']) if (k in s) state.seg[k] = s[k];
+    }
+    if (body.live === false && state.live) {
+      state.live = false;
+      const sinceFrame = now() - lastDdpMs;
+      stats.restores.push(sinceFrame);
+      log(`realtime off (POST), ${sinceFrame.toFixed(0)}ms after last frame, ` +
+          `fx=${state.seg.fx} pal=${state.seg.pal} n="${state.seg.n}"`);
+    }
+  }
+
+  function stateJson() {
+    return JSON.stringify({ on: state.on, bri: state.bri, transition: state.transition,
+                            live: state.live, seg: [state.seg] });
+  }
+
+  function fullJson() {
+    const info = `{"ver":"emulator","leds":{"count":${leds}},"name":"WLED emulator","ws":${wsClients.size}}`;
+    return `{"state":${stateJson()},"info":${info}}`;
+  }
+
+  // ---- WebSocket (/ws) ----
+
+  function wsFrame(opcode, payload, fin = true) {
+    const len = payload.length;
+    let head;
+    if (len < 126) {
+      head = Buffer.from([(fin ? 0x80 : 0) | opcode, len]);
+    } else if (len < 65536) {
+      head = Buffer.from([(fin ? 0x80 : 0) | opcode, 126, len >> 8, len & 0xFF]);
+    } else {
+      head = Buffer.alloc(10);
+      head[0] = (fin ? 0x80 : 0) | opcode;
+      head[1] = 127;
+      head.writeBigUInt64BE(BigInt(len), 2);
+    }
+    return Buffer.concat([head, payload]);
+  }
+
+  // Text message, split into --ws-frag sized continuation frames if asked
+  function wsSendText(sock, text) {
+    const msg = Buffer.from(text);
+    const frag = opts.wsFrag > 0 ? opts.wsFrag : msg.length;
+    for (let i = 0; i < msg.length; i += frag) {
+      const last = i + frag >= msg.length;
+      sock.write(wsFrame(i === 0 ? WS_OP_TEXT : WS_OP_CONT, msg.subarray(i, i + frag), last));
+    }
+  }
+
+  function pushState() {
+    if (!wsClients.size) return;
+    const text = fullJson();
+    for (const sock of wsClients) wsSendText(sock, text);
+    stats.wsPushes += wsClients.size;
+  }
+
+  // Client frames are always masked. Returns the unparsed remainder.
+  function wsParse(sock, buf) {
+    while (buf.length >= 2) {
+      const opcode = buf[0] & 0x0F;
+      let len = buf[1] & 0x7F;
+      let off = 2;
+      if (len === 126) {
+        if (buf.length < 4) break;
+        len = buf.readUInt16BE(2);
+        off = 4;
+      } else if (len === 127) {
+        if (buf.length < 10) break;
+        len = Number(buf.readBigUInt64BE(2));
+        off = 10;
+      }
+      if (!(buf[1] & 0x80)) {
+        log('ws: unmasked client frame, closing');
+        sock.destroy();
+        return Buffer.alloc(0);
+      }
+      if (buf.length < off + 4 + len) break;
+      const mask = buf.subarray(off, off + 4);
+      const payload = Buffer.from(buf.subarray(off + 4, off + 4 + len));
+      for (let i = 0; i < len; i++) payload[i] ^= mask[i & 3];
+      buf = buf.subarray(off + 4 + len);
+
+      if (opcode === WS_OP_PING) {
+        stats.wsPings++;
+        sock.write(wsFrame(WS_OP_PONG, payload));
+      } else if (opcode === WS_OP_CLOSE) {
+        sock.end(wsFrame(WS_OP_CLOSE, payload.subarray(0, 2)));
+      } else if (opcode === WS_OP_TEXT) {
+        // WLED takes state JSON over the socket too; {"v":true} asks for a push
+        try {
+          const body = JSON.parse(payload.toString());
+          if (body.v) wsSendText(sock, fullJson());
+          else { applyState(body); pushState(); }
+        } catch (e) {
+          log(`ws: bad message ${payload.toString()}`);
+        }
+      }
+    }
+    return buf;
+  }
+
+  function handleUpgrade(req, sock) {
+    if (opts.noWs || req.url.split('?')[0] !== '/ws') {
+      sock.end('HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n');
+      return;
+    }
+    const accept = crypto.createHash('sha1')
+      .update(req.headers['sec-websocket-key'] + WS_GUID).digest('base64');
+    sock.write('HTTP/1.1 101 Switching Protocols\r\n' +
+               'Upgrade: websocket\r\n' +
+               'Connection: Upgrade\r\n' +
+               `Sec-WebSocket-Accept: ${accept}\r\n\r\n`);
+    sock.setNoDelay(true);
+    wsClients.add(sock);
+    stats.wsConnects++;
+    log(`ws client ${sock.remoteAddress} connected (${wsClients.size} open)`);
+    wsSendText(sock, fullJson());   // WLED pushes the state right away
+
+    let pending = Buffer.alloc(0);
+    sock.on('data', d => { pending = wsParse(sock, Buffer.concat([pending, d])); });
+    sock.on('error', () => {});
+    sock.on('close', () => {
+      wsClients.delete(sock);
+      log(`ws client closed (${wsClients.size} open)`);
+    });
+  }
+
+  const server = http.createServer((req, res) => {
+    let body = '';
+    req.on('data', c => { body += c; });
+    req.on('end', () => {
+      const reply = () => {
+        if (Math.random() < opts.httpFail) {
+          stats.httpFailed++;
+          res.writeHead(503, { 'Content-Type': 'text/plain' });
+          res.end('busy');
+          return;
+        }
+        const url = req.url.split('?')[0];
+        if (req.method === 'GET' && (url === '/json/state' || url === '/json/si' || url === '/json')) {
+          stats.httpGets++;
+          const out = url === '/json/state' ? stateJson() : fullJson();
+          res.writeHead(200, { 'Content-Type': 'application/json' });
+          res.end(out);
+        } else if (req.method === 'POST' && (url === '/json/state' || url === '/json')) {
+          stats.httpPosts++;
+          try {
+            applyState(JSON.parse(body));
+          } catch (e) {
+            res.writeHead(400, { 'Content-Type': 'application/json' });
+            res.end('{"error":9}');
+            log(`bad POST body: ${body}`);
+            return;
+          }
+          res.writeHead(200, { 'Content-Type': 'application/json' });
+          res.end('{"success":true}');
+          pushState();
+        } else {
+          res.writeHead(404);
+          res.end();
+        }
+      };
+      if (opts.httpDelay > 0) setTimeout(reply, opts.httpDelay); else reply();
+    });
+  });
+
+  const udp = dgram.createSocket('udp4');
+  udp.on('message', handleDdp);
+  udp.on('error', e => fail(`DDP socket: ${e.message}`));
+  udp.bind(opts.ddpPort, () => {
+    server.on('error', e => fail(`HTTP server: ${e.message}`));
+    server.on('upgrade', handleUpgrade);
+    server.listen(opts.httpPort, () => {
+      console.log(`WLED emulator ${opts.width}x${opts.height} (${opts.layout}): ` +
+                  `DDP udp/${opts.ddpPort}, HTTP tcp/${opts.httpPort}` +
+                  (record ? `, recording to ${opts.record}` : ''));
+    });
+  });
+
+  if (opts.cycle > 0) {
+    setInterval(() => {
+      state.seg.pal = (state.seg.pal + 1) % 71;
+      log(`palette -> ${state.seg.pal} (--cycle)`);
+      pushState();
+    }, opts.cycle);
+  }
+
+  // Realtime timeout, like WLED falling back to its effect
+  setInterval(() => {
+    if (state.live && now() - lastDdpMs > REALTIME_TIMEOUT_MS) {
+      state.live = false;
+      log('realtime off (timeout)');
+    }
+  }, 100);
+
+  let lastFrames = 0;
+  function printStats() {
+    const restores = stats.restores.slice().sort((a, b) => a - b);
+    console.log(`frames ${stats.frames} (+${stats.frames - lastFrames}), packets ${stats.packets}, ` +
+                `injected drops ${stats.injectedDrops}, seq gaps ${stats.seqGaps}, bad ${stats.bad}, ` +
+                `${intervalSummary(stats.frameTimes)}, http get ${stats.httpGets} post ${stats.httpPosts} ` +
+                `failed ${stats.httpFailed}, restores ${restores.length}` +
+                (restores.length ? ` (median ${percentile(restores, 0.5).toFixed(0)}ms after last frame)` : '') +
+                `, ws open ${wsClients.size} connects ${stats.wsConnects} pushes ${stats.wsPushes} ` +
+                `pings ${stats.wsPings}`);
+    lastFrames = stats.frames;
+  }
+  setInterval(printStats, STATS_INTERVAL_MS);
+  process.on('SIGINT', () => {
+    printStats();
+    if (record) record.end();
+    process.exit(0);
+  });
+}
+
+// ============================================================================
+// Offline: stats and PNG filmstrip from a recording
+// ============================================================================
+
+function loadRecording(file) {
+  if (!file) fail('no recording given');
+  return fs.readFileSync(file, 'utf8').split('\n').filter(Boolean).map(l => JSON.parse(l));
+}
+
+function printRecordingStats(frames) {
+  if (!frames.length) fail('recording is empty');
+  let gaps = 0;
+  for (let i = 1; i < frames.length; i++) {
+    gaps += ((frames[i].seq - frames[i - 1].seq - 1) & 0x0F);
+  }
+  const span = frames[frames.length - 1].t - frames[0].t;
+  const delays = frames.map(f => f.t - f.rx).sort((a, b) => a - b);
+  console.log(`${frames.length} frames over ${(span / 1000).toFixed(2)}s ` +
+              `(${(frames.length * 1000 / Math.max(span, 1)).toFixed(1)} fps)`);
+  console.log(`sequence gaps ${gaps} (${(gaps * 100 / (frames.length + gaps)).toFixed(2)}% lost)`);
+  console.log(intervalSummary(frames.map(f => f.t)));
+  console.log(`injected display delay median ${percentile(delays, 0.5).toFixed(1)}ms ` +
+              `max ${delays[delays.length - 1].toFixed(1)}ms`);
+}
+
+const CRC_TABLE = (() => {
+  const t = new Int32Array(256);
+  for (let n = 0; n < 256; n++) {
+    let c = n;
+    for (let k = 0; k < 8; k++) c = c & 1 ? 0xEDB88320 ^ (c >>> 1) : c >>> 1;
+    t[n] = c;
+  }
+  return t;
+})();
+
+function crc32(buf) {
+  let c = -1;
+  for (let i = 0; i < buf.length; i++) c = CRC_TABLE[(c ^ buf[i]) & 0xFF] ^ (c >>> 8);
+  return (c ^ -1) >>> 0;
+}
+
+function pngChunk(type, data) {
+  const len = Buffer.alloc(4);
+  len.writeUInt32BE(data.length);
+  const td = Buffer.concat([Buffer.from(type, 'ascii'), data]);
+  const crc = Buffer.alloc(4);
+  crc.writeUInt32BE(crc32(td));
+  return Buffer.concat([len, td, crc]);
+}
+
+function encodePng(width, height, rgb) {
+  const raw = Buffer.alloc((width * 3 + 1) * height);
+  for (let y = 0; y < height; y++) {
+    raw[y * (width * 3 + 1)] = 0;   // Filter: none
+    rgb.copy(raw, y * (width * 3 + 1) + 1, y * width * 3, (y + 1) * width * 3);
+  }
+  const ihdr = Buffer.alloc(13);
+  ihdr.writeUInt32BE(width, 0);
+  ihdr.writeUInt32BE(height, 4);
+  ihdr[8] = 8;    // Bit depth
+  ihdr[9] = 2;    // Truecolor RGB
+  return Buffer.concat([
+    Buffer.from([0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A]),
+    pngChunk('IHDR', ihdr),
+    pngChunk('IDAT', zlib.deflateSync(raw)),
+    pngChunk('IEND', Buffer.alloc(0)),
+  ]);
+}
+
+// Each LED is a scale x scale dot with a 1px dark border, frames stacked
+// top to bottom with a 2px gap
+function renderFilmstrip(frames, opts, outFile) {
+  const picked = frames.filter((_, i) => i % Math.max(1, opts.every) === 0).slice(-opts.max);
+  if (!picked.length) fail('nothing to render');
+  const { w, h } = picked[0];
+  const s = Math.max(2, opts.scale);
+  const gap = 2;
+  const W = w * s;
+  const H = picked.length * (h * s + gap) - gap;
+  const rgb = Buffer.alloc(W * H * 3, 0x10);
+
+  picked.forEach((f, fi) => {
+    const px = Buffer.from(f.px, 'base64');
+    const oy = fi * (h * s + gap);
+    for (let y = 0; y < h; y++) {
+      for (let x = 0; x < w; x++) {
+        const src = (y * w + x) * 3;
+        for (let dy = 1; dy < s; dy++) {
+          for (let dx = 1; dx < s; dx++) {
+            const dst = ((oy + y * s + dy) * W + x * s + dx) * 3;
+            rgb[dst] = px[src];
+            rgb[dst + 1] = px[src + 1];
+            rgb[dst + 2] = px[src + 2];
+          }
+        }
+      }
+    }
+  });
+
+  fs.writeFileSync(outFile, encodePng(W, H, rgb));
+  console.log(`Wrote ${outFile}: ${picked.length} frames, ${W}x${H}`);
+}
+
+function main() {
+  const opts = parseArgs(process.argv.slice(2));
+  if (opts.mode === 'stats') {
+    printRecordingStats(loadRecording(opts.positional[0]));
+  } else if (opts.mode === 'render') {
+    if (opts.positional.length < 2) fail('--render needs a recording and an output .png');
+    renderFilmstrip(loadRecording(opts.positional[0]), opts, opts.positional[1]);
+  } else {
+    runEmulator(opts);
+  }
+}
+
+main();
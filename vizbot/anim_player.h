@@ -0,0 +1,556 @@
+#ifndef ANIM_PLAYER_H
+#define ANIM_PLAYER_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "config.h"
+#include "system_status.h"
+#include "gif_decoder.h"
+
+// ============================================================================
+// Animation Player — GIF playback on the LCD and the WLED matrix
+// ============================================================================
+// Plays /anim/<name>.gif off LittleFS. With PSRAM the file is read into it
+// once when playback starts and decoded from there; without, it streams
+// from flash through the decoder's 1KB read buffer. The working set — the
+// GifDecoder (~28KB), a palette LUT and the WLED frame — is allocated when
+// playback starts, PSRAM first, and freed when it stops.
+//
+// Runs on Core 1 from the render loop. animUpdate() decodes a frame when
+// it is due and puts it on the chosen targets:
+//   LCD   rows go straight into the 16-bit canvas through the palette LUT,
+//         and only what changed (this frame's rectangle, plus last frame's
+//         if it was disposed) is pushed with flushCanvasRect(). The GIF is
+//         centred; with the hologram mirror on, rows are written flipped,
+//         since a partial flush doesn't mirror. The bot and the info page
+//         don't draw while it plays.
+//   WLED  the logical screen is sampled down to 32x8 (nearest pixel, so a
+//         32x8 GIF maps 1:1) into a persistent frame and published through
+//         wledFrames, held a little past the frame delay.
+// Frame times accumulate from the first frame, so playback doesn't drift;
+// a frame that comes up more than one delay late resyncs rather than
+// bursting to catch up.
+//
+// Started and stopped with CMD_PLAY_ANIM / CMD_STOP_ANIM (web, cloud).
+// ============================================================================
+
+#define ANIM_DIR              "/anim"
+#define ANIM_NAME_LEN         32
+#define ANIM_PSRAM_MAX        (512UL * 1024)   // Larger files stream from flash
+#define ANIM_WLED_HOLD_MS     400              // WLED hold past the frame delay
+#define ANIM_TARGET_LCD       0x01
+#define ANIM_TARGET_WLED      0x02
+
+#if defined(DISPLAY_LCD_ONLY) || defined(DISPLAY_DUAL)
+
+extern GfxDevice *gfx;
+
+// Allocated as one block while playing
+struct AnimWork {
+  GifDecoder gif;
+  uint16_t lut[256];              // Palette as canvas pixels (byte-swapped RGB565)
+  uint16_t lutSerial;
+  uint16_t line[GIF_MAX_WIDTH];   // Row staging for an 8-bit canvas
+  uint8_t  wled[WLED_PIXEL_BYTES];
+};
+
+struct AnimPlayerState {
+  bool active;
+  uint8_t target;                 // ANIM_TARGET_* bits
+  char name[ANIM_NAME_LEN];
+  uint16_t loops;                 // Plays asked for, 0 = as the file says
+  uint16_t plays;                 // Plays finished
+
+  AnimWork* work;
+  File file;                      // Streaming source
+  uint8_t* mem;                   // PSRAM source, or nullptr
+  uint32_t memLen;
+  uint32_t memPos;
+
+  unsigned long nextFrameMs;
+  int16_t offX, offY;             // GIF screen origin on the LCD
+  uint16_t* canvas;               // Direct canvas pixels for this frame, or nullptr
+  bool mirrored;
+  bool fullFlush;                 // Next flush sends the whole screen
+
+  bool disposePending;            // Last frame's rectangle goes back to background
+  GifFrameInfo dispose;
+
+  // Stats, read by the status page
+  uint32_t frames;
+  uint32_t late;
+  uint32_t decodeUsTotal;
+  uint32_t decodeUsMax;
+  uint32_t flushedPx;             // LCD pixels pushed, last frame
+  const char* error;
+};
+
+static AnimPlayerState anim = {};
+
+// ---- Sources ----
+
+static size_t animReadMem(void* src, uint8_t* buf, size_t n) {
+  AnimPlayerState* a = (AnimPlayerState*)src;
+  n = min(n, (size_t)(a->memLen - a->memPos));
+  memcpy(buf, a->mem + a->memPos, n);
+  a->memPos += n;
+  return n;
+}
+
+static bool animSeekMem(void* src, uint32_t pos) {
+  AnimPlayerState* a = (AnimPlayerState*)src;
+  if (pos > a->memLen) return false;
+  a->memPos = pos;
+  return true;
+}
+
+static size_t animReadFile(void* src, uint8_t* buf, size_t n) {
+  return ((AnimPlayerState*)src)->file.read(buf, n);
+}
+
+static bool animSeekFile(void* src, uint32_t pos) {
+  return ((AnimPlayerState*)src)->file.seek(pos);
+}
+
+// ---- Row sinks ----
+
+static void animBuildLut() {
+  AnimWork* w = anim.work;
+  const uint8_t* p = w->gif.palette;
+  for (uint16_t i = 0; i < 256; i++, p += 3) {
+    uint16_t c = ((p[0] & 0xF8) << 8) | ((p[1] & 0xFC) << 3) | (p[2] >> 3);
+    w->lut[i] = (c >> 8) | (c << 8);
+  }
+  w->lutSerial = w->gif.paletteSerial;
+}
+
+// Canvas row for GIF screen row y, after the mirror
+static int16_t animCanvasRow(int16_t y) {
+  int16_t sy = anim.offY + y;
+  return anim.mirrored ? LCD_HEIGHT - 1 - sy : sy;
+}
+
+static void animRowLcd(const GifFrameInfo& f, uint16_t y, const uint8_t* idx) {
+  int16_t sy = anim.offY + y;
+  if (sy < 0 || sy >= LCD_HEIGHT) return;
+  sy = animCanvasRow(y);
+
+  // Clip the row to the screen
+  int16_t sx = anim.offX + f.x;
+  int16_t x0 = sx < 0 ? -sx : 0;
+  int16_t x1 = min((int16_t)f.w, (int16_t)(LCD_WIDTH - sx));
+  if (x0 >= x1) return;
+
+  const uint16_t* lut = anim.work->lut;
+  int16_t t = f.transparent;
+  if (anim.canvas) {
+    uint16_t* dst = anim.canvas + sy * LCD_WIDTH + sx;
+    if (t < 0) {
+      for (int16_t i = x0; i < x1; i++) dst[i] = lut[idx[i]];
+    } else {
+      for (int16_t i = x0; i < x1; i++) {
+        if (idx[i] != t) dst[i] = lut[idx[i]];
+      }
+    }
+    return;
+  }
+
+  // 8-bit canvas: push runs of opaque pixels, in native RGB565
+  uint16_t* line = anim.work->line;
+  int16_t i = x0;
+  while (i < x1) {
+    while (i < x1 && idx[i] == t) i++;
+    int16_t start = i;
+    while (i < x1 && idx[i] != t) {
+      uint16_t c = lut[idx[i]];
+      line[i - start] = (c >> 8) | (c << 8);
+      i++;
+    }
+    if (i > start) gfx->pushCanvasRect(sx + start, sy, i - start, 1, line);
+  }
+}
+
+static void animRowWled(const GifFrameInfo& f, uint16_t y, const uint8_t* idx) {
+  const GifDecoder& g = anim.work->gif;
+  const uint8_t* pal = g.palette;
+  uint8_t* px = anim.work->wled;
+  for (uint8_t my = 0; my < WLED_DISPLAY_HEIGHT; my++) {
+    if ((uint32_t)(2 * my + 1) * g.height / (2 * WLED_DISPLAY_HEIGHT) != y) continue;
+    for (uint8_t mx = 0; mx < WLED_DISPLAY_WIDTH; mx++) {
+      uint16_t gx = (uint32_t)(2 * mx + 1) * g.width / (2 * WLED_DISPLAY_WIDTH);
+      if (gx < f.x || gx >= f.x + f.w) continue;
+      uint8_t i = idx[gx - f.x];
+      if (i == f.transparent) continue;
+      memcpy(px + (my * WLED_DISPLAY_WIDTH + mx) * 3, pal + i * 3, 3);
+    }
+  }
+}
+
+static void animRow(void* ctx, const GifFrameInfo& f, uint16_t y, const uint8_t* idx) {
+  if (anim.target & ANIM_TARGET_LCD) {
+    if (anim.work->lutSerial != anim.work->gif.paletteSerial) animBuildLut();
+    animRowLcd(f, y, idx);
+  }
+  if (anim.target & ANIM_TARGET_WLED) animRowWled(f, y, idx);
+}
+
+// ---- Disposal and flushing ----
+
+// Screen-space rectangle, clipped; false if nothing is on screen
+struct AnimRect {
+  int16_t x, y, w, h;
+};
+
+static bool animScreenRect(const GifFrameInfo& f, AnimRect& r) {
+  int16_t x0 = max(0, anim.offX + f.x);
+  int16_t y0 = max(0, anim.offY + f.y);
+  int16_t x1 = min((int)LCD_WIDTH, anim.offX + f.x + f.w);
+  int16_t y1 = min((int)LCD_HEIGHT, anim.offY + f.y + f.h);
+  if (x0 >= x1 || y0 >= y1) return false;
+  r.x = x0;
+  r.w = x1 - x0;
+  r.h = y1 - y0;
+  r.y = anim.mirrored ? LCD_HEIGHT - y1 : y0;
+  return true;
+}
+
+static void animUnion(AnimRect& a, bool& haveA, const AnimRect& b) {
+  if (!haveA) {
+    a = b;
+    haveA = true;
+    return;
+  }
+  int16_t x1 = max(a.x + a.w, b.x + b.w);
+  int16_t y1 = max(a.y + a.h, b.y + b.h);
+  a.x = min(a.x, b.x);
+  a.y = min(a.y, b.y);
+  a.w = x1 - a.x;
+  a.h = y1 - a.y;
+}
+
+// Back to black — the background, as most players draw it
+static void animClearLcd(const AnimRect& r) {
+  if (anim.canvas) {
+    for (int16_t y = r.y; y < r.y + r.h; y++) {
+      memset(anim.canvas + y * LCD_WIDTH + r.x, 0, r.w * sizeof(uint16_t));
+    }
+  } else {
+    gfx->fillRect(r.x, r.y, r.w, r.h, 0x0000);
+  }
+}
+
+static void animClearWled(const GifFrameInfo& f) {
+  const GifDecoder& g = anim.work->gif;
+  for (uint8_t my = 0; my < WLED_DISPLAY_HEIGHT; my++) {
+    uint16_t gy = (uint32_t)(2 * my + 1) * g.height / (2 * WLED_DISPLAY_HEIGHT);
+    if (gy < f.y || gy >= f.y + f.h) continue;
+    for (uint8_t mx = 0; mx < WLED_DISPLAY_WIDTH; mx++) {
+      uint16_t gx = (uint32_t)(2 * mx + 1) * g.width / (2 * WLED_DISPLAY_WIDTH);
+      if (gx < f.x || gx >= f.x + f.w) continue;
+      memset(anim.work->wled + (my * WLED_DISPLAY_WIDTH + mx) * 3, 0, 3);
+    }
+  }
+}
+
+// At the end of a play: done, or round again? The NETSCAPE block sits after
+// the first frame's header, so the file's count is only known by now.
+static bool animFinished() {
+  if (anim.plays < 0xFFFF) anim.plays++;
+  if (anim.loops) return anim.plays >= anim.loops;
+  const GifDecoder& g = anim.work->gif;
+  if (!g.hasLoopCount) return true;                 // No loop block: once
+  return g.loopCount != 0 && anim.plays > g.loopCount;   // n repeats after the first
+}
+
+// ---- Public API (Core 1) ----
+
+// Loops: 0 = as the file says (no NETSCAPE block = once), N = N plays
+bool animPlay(const char* name, uint8_t target, uint16_t loops);
+void animStop();
+
+bool animActive() {
+  return anim.active;
+}
+
+// Playing this file — an upload or delete has to wait
+bool animPlaying(const char* name) {
+  return anim.active && strcmp(anim.name, name) == 0;
+}
+
+// The LCD belongs to the animation — skip the bot / info page this frame
+bool animOwnsLcd() {
+  return anim.active && (anim.target & ANIM_TARGET_LCD);
+}
+
+// Scheduled / info WLED views hold off while the animation streams there
+bool animOwnsWled() {
+  return anim.active && (anim.target & ANIM_TARGET_WLED);
+}
+
+void animStop() {
+  if (!anim.active && !anim.work) return;
+  bool lcd = anim.target & ANIM_TARGET_LCD;
+  if (anim.file) anim.file.close();
+  if (anim.mem) heap_caps_free(anim.mem);
+  if (anim.work) heap_caps_free(anim.work);
+  anim.mem = nullptr;
+  anim.work = nullptr;
+  anim.active = false;
+  if (lcd) infoPageCached = false;   // The info page has to redraw from scratch
+  DBG("Anim: stopped after ");
+  DBG(anim.frames);
+  DBGLN(" frames");
+}
+
+bool animPlay(const char* name, uint8_t target, uint16_t loops) {
+  animStop();
+  anim.error = nullptr;
+  anim.frames = anim.late = 0;
+  anim.decodeUsTotal = anim.decodeUsMax = 0;
+  anim.flushedPx = 0;
+  strlcpy(anim.name, name, sizeof(anim.name));
+  anim.target = target & (ANIM_TARGET_LCD | ANIM_TARGET_WLED);
+  if (!anim.target) anim.target = ANIM_TARGET_LCD;
+
+  if (!sysStatus.littlefsReady) {
+    anim.error = "no filesystem";
+    return false;
+  }
+  if (!name[0] || strchr(name, '/')) {
+    anim.error = "bad name";
+    return false;
+  }
+  char path[48];
+  snprintf(path, sizeof(path), ANIM_DIR "/%s.gif", name);
+  File f = LittleFS.open(path, "r");
+  if (!f) {
+    anim.error = "not found";
+    return false;
+  }
+
+  if (sysStatus.psramAvailable) {
+    anim.work = (AnimWork*)heap_caps_calloc(1, sizeof(AnimWork), MALLOC_CAP_SPIRAM);
+  }
+  if (!anim.work) anim.work = (AnimWork*)heap_caps_calloc(1, sizeof(AnimWork), MALLOC_CAP_8BIT);
+  if (!anim.work) {
+    f.close();
+    anim.error = "out of memory";
+    return false;
+  }
+
+  // Whole file into PSRAM when it fits, so decoding never waits on flash
+  size_t size = f.size();
+  if (sysStatus.psramAvailable && size <= ANIM_PSRAM_MAX) {
+    anim.mem = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+    if (anim.mem && f.read(anim.mem, size) == size) {
+      anim.memLen = size;
+      anim.memPos = 0;
+      f.close();
+    } else if (anim.mem) {
+      heap_caps_free(anim.mem);
+      anim.mem = nullptr;
+      f.seek(0);
+    }
+  }
+  if (!anim.mem) anim.file = f;
+
+  GifDecoder& gif = anim.work->gif;
+  bool ok = anim.mem ? gif.begin(animReadMem, animSeekMem, &anim)
+                     : gif.begin(animReadFile, animSeekFile, &anim);
+  anim.work->lutSerial = gif.paletteSerial - 1;
+  if (!ok) {
+    anim.error = gif.error;
+    anim.active = true;   // So animStop() releases everything
+    animStop();
+    return false;
+  }
+
+  anim.loops = loops;
+  anim.plays = 0;
+  anim.offX = ((int16_t)LCD_WIDTH - (int16_t)gif.width) / 2;
+  anim.offY = ((int16_t)LCD_HEIGHT - (int16_t)gif.height) / 2;
+  anim.fullFlush = true;
+  anim.disposePending = false;
+  anim.nextFrameMs = millis();
+  anim.active = true;
+
+  DBG("Anim: ");
+  DBG(path);
+  DBG(" ");
+  DBG(gif.width);
+  DBG("x");
+  DBG(gif.height);
+  DBGLN(anim.mem ? " from PSRAM" : " from flash");
+  return true;
+}
+
+// Decode and show the next frame if it is due. Returns animOwnsLcd().
+bool animUpdate() {
+  if (!anim.active) return false;
+  unsigned long now = millis();
+  if ((long)(now - anim.nextFrameMs) < 0) return animOwnsLcd();
+
+  bool lcd = anim.target & ANIM_TARGET_LCD;
+  bool wled = anim.target & ANIM_TARGET_WLED;
+  GifDecoder& gif = anim.work->gif;
+  AnimRect dirty;
+  bool haveDirty = false;
+
+  if (lcd) {
+    gfx->beginCanvas();
+    anim.canvas = gfx->canvasPixels();
+    anim.mirrored = gfx->canvasMirrored();
+    if (anim.fullFlush) {
+      if (anim.canvas) memset(anim.canvas, 0, LCD_WIDTH * LCD_HEIGHT * sizeof(uint16_t));
+      else gfx->fillScreen(0x0000);
+    }
+  }
+  if (wled && anim.fullFlush) memset(anim.work->wled, 0, WLED_PIXEL_BYTES);
+
+  // The previous frame asked for its rectangle back
+  if (anim.disposePending) {
+    AnimRect r;
+    if (lcd && animScreenRect(anim.dispose, r)) {
+      animClearLcd(r);
+      animUnion(dirty, haveDirty, r);
+    }
+    if (wled) animClearWled(anim.dispose);
+    anim.disposePending = false;
+  }
+
+  uint32_t t0 = micros();
+  GifResult res = gif.nextFrame(animRow, nullptr);
+  if (res == GIF_END) {
+    if (animFinished()) {
+      if (lcd) gfx->flushCanvasRect(0, 0, 0, 0);   // Pushes nothing, leaves canvas mode
+      animStop();
+      return false;
+    }
+    res = gif.rewind() ? gif.nextFrame(animRow, nullptr) : GIF_ERROR;
+  }
+  uint32_t us = micros() - t0;
+
+  if (res != GIF_FRAME) {
+    anim.error = gif.error ? gif.error : "empty";
+    DBG("Anim: ");
+    DBGLN(anim.error);
+    if (lcd) gfx->flushCanvasRect(0, 0, 0, 0);
+    animStop();
+    return false;
+  }
+
+  anim.frames++;
+  anim.decodeUsTotal += us;
+  if (us > anim.decodeUsMax) anim.decodeUsMax = us;
+
+  const GifFrameInfo& f = gif.frame;
+  if (lcd) {
+    AnimRect r;
+    if (animScreenRect(f, r)) animUnion(dirty, haveDirty, r);
+    if (anim.fullFlush) {
+      dirty = { 0, 0, LCD_WIDTH, LCD_HEIGHT };
+      haveDirty = true;
+    }
+    if (haveDirty) {
+      gfx->flushCanvasRect(dirty.x, dirty.y, dirty.w, dirty.h);
+      anim.flushedPx = (uint32_t)dirty.w * dirty.h;
+    } else {
+      gfx->flushCanvasRect(0, 0, 0, 0);
+      anim.flushedPx = 0;
+    }
+  }
+  if (wled) {
+    memcpy(wledFrames.draft().px, anim.work->wled, WLED_PIXEL_BYTES);
+    wledQueueFrame(f.delayMs + ANIM_WLED_HOLD_MS);
+  }
+  anim.fullFlush = false;
+
+  if (f.disposal == 2) {
+    anim.dispose = f;
+    anim.disposePending = true;
+  }
+
+  // Next frame relative to this one's due time, not to when it was drawn
+  anim.nextFrameMs += f.delayMs;
+  now = millis();
+  if ((long)(now - anim.nextFrameMs) > 0) {
+    anim.late++;
+    anim.nextFrameMs = now + f.delayMs;
+  }
+  return lcd;
+}
+
+// How long the render loop may sleep before the next frame is due
+uint32_t animWaitMs(uint32_t maxMs) {
+  if (!anim.active) return maxMs;
+  long d = (long)(anim.nextFrameMs - millis());
+  if (d <= 0) return 0;
+  return min((uint32_t)d, maxMs);
+}
+
+// For /anim/status
+String getAnimStatusJson() {
+  String json = "{\"active\":";
+  json += anim.active ? "true" : "false";
+  json += ",\"name\":\"";
+  json += anim.name;
+  json += "\",\"target\":\"";
+  json += anim.target == (ANIM_TARGET_LCD | ANIM_TARGET_WLED) ? "both"
+        : anim.target == ANIM_TARGET_WLED ? "wled" : "lcd";
+  json += "\",\"source\":\"";
+  json += !anim.active ? "" : anim.mem ? "psram" : "flash";
+  json += "\",\"frames\":";
+  json += anim.frames;
+  json += ",\"late\":";
+  json += anim.late;
+  json += ",\"decodeAvgUs\":";
+  json += anim.frames ? anim.decodeUsTotal / anim.frames : 0;
+  json += ",\"decodeMaxUs\":";
+  json += anim.decodeUsMax;
+  json += ",\"flushedPx\":";
+  json += anim.flushedPx;
+  json += ",\"workBytes\":";
+  json += (uint32_t)sizeof(AnimWork);
+  if (anim.error) {
+    json += ",\"error\":\"";
+    json += anim.error;
+    json += "\"";
+  }
+
+  json += ",\"files\":[";
+  if (sysStatus.littlefsReady) {
+    File dir = LittleFS.open(ANIM_DIR);
+    bool first = true;
+    if (dir && dir.isDirectory()) {
+      for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+        if (!first) json += ",";
+        first = false;
+        json += "{\"name\":\"";
+        String n = f.name();
+        if (n.endsWith(".gif")) n.remove(n.length() - 4);
+        json += n;
+        json += "\",\"size\":";
+        json += (uint32_t)f.size();
+        json += "}";
+      }
+    }
+  }
+  json += "]}";
+  return json;
+}
+
+#else
+
+inline bool animPlay(const char*, uint8_t, uint16_t) { return false; }
+inline void animStop() {}
+inline bool animActive() { return false; }
+inline bool animPlaying(const char*) { return false; }
+inline bool animOwnsLcd() { return false; }
+inline bool animOwnsWled() { return false; }
+inline bool animUpdate() { return false; }
+inline uint32_t animWaitMs(uint32_t maxMs) { return maxMs; }
+inline String getAnimStatusJson() { return "{\"active\":false,\"error\":\"no display\",\"files\":[]}"; }
+
+#endif // DISPLAY_LCD_ONLY || DISPLAY_DUAL
+
+#endif // ANIM_PLAYER_H
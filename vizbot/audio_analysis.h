@@ -5,13 +5,17 @@
 
 #include <Arduino.h>
 #include <M5Unified.h>
+#include "audio_features.h"
+#include "audio_capture.h"
 
 // ============================================================================
 // Audio Analysis — Core S3 Dual MEMS Mic (ES7210 I2S)
 // ============================================================================
 // Non-blocking RMS analysis of microphone input. Computes smoothed level,
 // detects spikes (claps/bangs), sustained speech, and extended silence.
-// Runs at ~20Hz (50ms rate-limited) to keep CPU impact minimal.
+// Samples arrive gap-free from audioCapture's ring; every block is fed to
+// audioFeatures (FFT bands, onsets, tempo) as soon as it is available, and
+// the RMS event logic runs at ~20Hz over all samples since the last pass.
 //
 // Mutes input while speaker is active to avoid feedback loop.
 // ============================================================================
@@ -21,6 +25,7 @@ extern struct BotSounds botSounds;
 
 // Analysis configuration
 #define AUDIO_SAMPLE_COUNT    256    // Samples per analysis frame (512B at 16-bit)
+#define AUDIO_MAX_BLOCKS_PER_UPDATE 8 // Cap per-frame analysis work; the ring absorbs the rest
 #define AUDIO_UPDATE_MS       50     // Rate limit: analyze every 50ms (~20Hz)
 #define AUDIO_SPIKE_MULT      5.0f   // RMS must exceed movingAvg by this factor (high to ignore keyboard/taps)
 #define AUDIO_SPEECH_FLOOR    600.0f // Minimum RMS to count as speech (above keyboard/ambient noise)
@@ -29,8 +34,14 @@ extern struct BotSounds botSounds;
 #define AUDIO_MOVING_AVG_ALPHA 0.05f // Smoothing factor for moving average (lower = slower)
 #define AUDIO_SMOOTH_ALPHA    0.3f   // Smoothing factor for display level
 
+static_assert(AUDIO_SAMPLE_COUNT == AUDIO_FFT_SIZE, "audioFeatures analyzes one mic frame per FFT");
+static_assert(AUDIO_SAMPLE_COUNT == AUDIO_CAPTURE_BLOCK, "analysis frames match capture blocks");
+
+// Spectral feature extractor (FFT bands, onsets, beat tracking)
+AudioFeatures audioFeatures;
+
 struct AudioAnalysis {
-  // Sample buffer — internal SRAM for DMA compatibility
+  // Scratch block pulled from the capture ring
   int16_t sampleBuffer[AUDIO_SAMPLE_COUNT];
 
   // Computed levels
@@ -43,6 +54,8 @@ struct AudioAnalysis {
   bool spikeDetected;    // Sudden loud sound (clap, bang)
   bool speechDetected;   // Sustained mid-level sound (someone talking)
   bool silenceExtended;  // No sound above threshold for >30 seconds
+  bool onsetDetected;    // audioFeatures onset in any block since the last update
+  bool beatDetected;     // audioFeatures beat in any block since the last update
 
   // Internal state
   bool enabled;
@@ -51,6 +64,11 @@ struct AudioAnalysis {
   bool speechActive;               // Currently detecting speech
   unsigned long lastSoundMs;       // Last time RMS was above silence threshold
   unsigned long lastSpikeMs;       // Debounce: last spike detection time
+  int64_t pendingPeakSumSq;        // Loudest block's sum of squares since the last RMS pass
+  uint32_t pendingSamples;
+  uint32_t streamSamples;          // Samples analyzed — stream clock for audioFeatures
+  bool featuresStale;              // Muted or capture restarted — reset before the next block
+  uint32_t captureRestarts;        // audioCapture.restarts last seen
 
   void init() {
     enabled = true;
@@ -66,6 +84,14 @@ struct AudioAnalysis {
     speechActive = false;
     lastSoundMs = millis();
     lastSpikeMs = 0;
+    onsetDetected = false;
+    beatDetected = false;
+    pendingPeakSumSq = 0;
+    pendingSamples = 0;
+    streamSamples = 0;
+    featuresStale = false;
+    captureRestarts = 0;
+    audioFeatures.init();
 
     // Configure M5 mic
     auto cfg = M5.Mic.config();
@@ -74,14 +100,65 @@ struct AudioAnalysis {
     cfg.dma_buf_len = 256;
     M5.Mic.config(cfg);
     M5.Mic.begin();
+
+    // Capture runs in its own task from here on
+    audioCapture.init();
+    audioCapture.start();
   }
 
-  // Call each frame — rate-limited internally
+  // Call each frame — never waits on the mic; RMS events rate-limited internally
   void update() {
-    if (!enabled) return;
+    if (!enabled) {
+      audioCapture.discard();
+      featuresStale = true;
+      return;
+    }
+
+    // Mute while speaker is playing to avoid feedback
+    if (botSounds.playing) {
+      audioCapture.discard();
+      pendingPeakSumSq = 0;
+      pendingSamples = 0;
+      spikeDetected = false;
+      speechDetected = false;
+      silenceExtended = false;
+      featuresStale = true;
+      return;
+    }
+
+    // Flux, onset and tempo history would span the gap — start clean
+    uint32_t restarts = audioCapture.restarts;
+    if (restarts != captureRestarts) audioCapture.discard();   // Blocks from both sides of the gap
+    if (featuresStale || restarts != captureRestarts) {
+      audioFeatures.reset();
+      featuresStale = false;
+      captureRestarts = restarts;
+    }
+
+    // Drain whole blocks from the capture ring
+    onsetDetected = false;
+    beatDetected = false;
+    for (uint8_t n = 0; n < AUDIO_MAX_BLOCKS_PER_UPDATE; n++) {
+      if (!audioCapture.readBlock(sampleBuffer, AUDIO_SAMPLE_COUNT)) break;
+      int64_t sum = 0;
+      for (int i = 0; i < AUDIO_SAMPLE_COUNT; i++) {
+        int32_t s = sampleBuffer[i];
+        sum += s * s;
+      }
+      if (sum > pendingPeakSumSq) pendingPeakSumSq = sum;
+      pendingSamples += AUDIO_SAMPLE_COUNT;
+      streamSamples += AUDIO_SAMPLE_COUNT;
+
+      // Spectral features (bands, flux, onset, beat) on stream time
+      audioFeatures.process(sampleBuffer,
+                            (unsigned long)((uint64_t)streamSamples * 1000 / AUDIO_CAPTURE_RATE));
+      onsetDetected |= audioFeatures.onsetDetected;
+      beatDetected |= audioFeatures.beatDetected;
+    }
 
     unsigned long now = millis();
     if (now - lastUpdateMs < AUDIO_UPDATE_MS) return;
+    if (pendingSamples == 0) return;
     lastUpdateMs = now;
 
     // Reset event flags each analysis frame
@@ -89,19 +166,11 @@ struct AudioAnalysis {
     speechDetected = false;
     silenceExtended = false;
 
-    // Mute while speaker is playing to avoid feedback
-    if (botSounds.playing) return;
-
-    // Read mic samples
-    if (!M5.Mic.record(sampleBuffer, AUDIO_SAMPLE_COUNT, 16000)) return;
-
-    // Compute RMS
-    int64_t sum = 0;
-    for (int i = 0; i < AUDIO_SAMPLE_COUNT; i++) {
-      int32_t s = sampleBuffer[i];
-      sum += s * s;
-    }
-    rmsLevel = sqrtf((float)sum / AUDIO_SAMPLE_COUNT);
+    // RMS of the loudest block since the last pass — same 256-sample window
+    // as before, but no block is skipped, so short claps can't fall in a gap
+    rmsLevel = sqrtf((float)pendingPeakSumSq / AUDIO_SAMPLE_COUNT);
+    pendingPeakSumSq = 0;
+    pendingSamples = 0;
 
     // Smooth level (for display/animation)
     smoothLevel = smoothLevel * (1.0f - AUDIO_SMOOTH_ALPHA) + rmsLevel * AUDIO_SMOOTH_ALPHA;
@@ -0,0 +1,166 @@
+#ifndef AUDIO_CAPTURE_H
+#define AUDIO_CAPTURE_H
+
+#ifdef TARGET_CORES3
+
+#include <Arduino.h>
+#include <M5Unified.h>
+#include <atomic>
+
+// ============================================================================
+// Audio Capture — gap-free mic stream decoupled from the render loop
+// ============================================================================
+// M5Unified's mic task drains the ES7210 I2S DMA ring and fills whatever
+// buffers are queued with M5.Mic.record(). A small capture task keeps that
+// queue full by rotating three block buffers: once block k is queued,
+// record() has already waited for block k-2 to finish (the mic driver holds
+// at most two pending jobs), so k-2 is complete and is copied into a
+// single-producer/single-consumer ring.
+//
+// The render loop (Core 1) pulls whole blocks from the ring without ever
+// waiting on the mic. If the consumer falls behind, the producer drops the
+// new block and counts an overrun rather than blocking capture.
+//
+// record() fails while the mic is stopped (the speaker has the I2S bus). The
+// buffers queued before that never complete, so the rotation starts over
+// and restarts is bumped — the stream has a gap the consumer must not
+// analyse across.
+// ============================================================================
+
+#define AUDIO_CAPTURE_RATE       16000
+#define AUDIO_CAPTURE_BLOCK      256    // Samples per record() job (16ms at 16kHz)
+#define AUDIO_CAPTURE_BUFS       3      // Rotating record buffers (2 in flight + 1 complete)
+#define AUDIO_RING_SAMPLES       4096   // Power of two — 256ms of audio (8KB)
+#define AUDIO_CAPTURE_STACK      3072
+#define AUDIO_CAPTURE_PRIORITY   2      // Above wifi_srv (1), below the WiFi stack
+
+static_assert((AUDIO_RING_SAMPLES & (AUDIO_RING_SAMPLES - 1)) == 0, "ring size must be a power of two");
+
+struct AudioCapture {
+  // Ring storage — internal SRAM, written only by the capture task
+  int16_t ring[AUDIO_RING_SAMPLES];
+  // Free-running indices; acquire/release ordering makes the ring safe across cores
+  std::atomic<uint32_t> head;   // Total samples written (producer)
+  std::atomic<uint32_t> tail;   // Total samples read (consumer)
+
+  int16_t recBuf[AUDIO_CAPTURE_BUFS][AUDIO_CAPTURE_BLOCK];
+
+  // Stats (written by capture task, read anywhere)
+  volatile uint32_t blocksCaptured;
+  volatile uint32_t overruns;       // Blocks dropped because the ring was full
+  volatile uint32_t restarts;       // Capture resumed after record() failed
+  volatile bool running;
+
+  TaskHandle_t taskHandle;
+
+  void init() {
+    head.store(0);
+    tail.store(0);
+    blocksCaptured = 0;
+    overruns = 0;
+    restarts = 0;
+    running = false;
+    taskHandle = nullptr;
+  }
+
+  // Start the capture task on Core 0 (mic must already be begun)
+  void start();
+
+  // ---- Producer side (capture task only) ----
+  void pushBlock(const int16_t* src, uint16_t n) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    uint32_t t = tail.load(std::memory_order_acquire);
+    if (AUDIO_RING_SAMPLES - (h - t) < n) {
+      overruns++;
+      return;
+    }
+    for (uint16_t i = 0; i < n; i++) {
+      ring[(h + i) & (AUDIO_RING_SAMPLES - 1)] = src[i];
+    }
+    head.store(h + n, std::memory_order_release);
+    blocksCaptured++;
+  }
+
+  // ---- Consumer side (render loop only) ----
+  uint32_t available() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+  }
+
+  // Copy exactly n samples out. Returns false (and reads nothing) if fewer are buffered.
+  bool readBlock(int16_t* dst, uint16_t n) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t h = head.load(std::memory_order_acquire);
+    if (h - t < n) return false;
+    for (uint16_t i = 0; i < n; i++) {
+      dst[i] = ring[(t + i) & (AUDIO_RING_SAMPLES - 1)];
+    }
+    tail.store(t + n, std::memory_order_release);
+    return true;
+  }
+
+  // Drop everything buffered (e.g. audio captured while the speaker was playing)
+  void discard() {
+    tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+  }
+
+  // Buffered audio in milliseconds — the consumer's current capture latency
+  uint16_t latencyMs() const {
+    return (uint16_t)(available() * 1000UL / AUDIO_CAPTURE_RATE);
+  }
+};
+
+// Global instance
+AudioCapture audioCapture;
+
+// Static task stack in BSS (same pattern as wifi_srv in task_manager.h)
+static StackType_t audioCaptureStack[AUDIO_CAPTURE_STACK];
+static StaticTask_t audioCaptureTCB;
+
+void audioCaptureTask(void* param) {
+  AudioCapture* cap = (AudioCapture*)param;
+  uint8_t idx = 0;
+  uint8_t queued = 0;
+  bool stalled = false;
+  cap->running = true;
+  for (;;) {
+    // Blocks here (in this task, not the render loop) until a mic job slot frees
+    if (!M5.Mic.record(cap->recBuf[idx], AUDIO_CAPTURE_BLOCK, AUDIO_CAPTURE_RATE)) {
+      // Nothing queued survives a stopped mic — refill from scratch
+      idx = 0;
+      queued = 0;
+      stalled = true;
+      vTaskDelay(pdMS_TO_TICKS(5));
+      continue;
+    }
+    if (stalled) {
+      stalled = false;
+      cap->restarts++;
+    }
+    // Buffer queued two jobs ago is now complete
+    if (queued >= AUDIO_CAPTURE_BUFS - 1) {
+      uint8_t done = (idx + 1) % AUDIO_CAPTURE_BUFS;
+      cap->pushBlock(cap->recBuf[done], AUDIO_CAPTURE_BLOCK);
+    } else {
+      queued++;
+    }
+    idx = (idx + 1) % AUDIO_CAPTURE_BUFS;
+  }
+}
+
+void AudioCapture::start() {
+  if (taskHandle != nullptr) return;
+  taskHandle = xTaskCreateStaticPinnedToCore(
+    audioCaptureTask,
+    "mic_cap",
+    AUDIO_CAPTURE_STACK,
+    this,
+    AUDIO_CAPTURE_PRIORITY,
+    audioCaptureStack,
+    &audioCaptureTCB,
+    0                  // Core 0 — keep Core 1 free for rendering
+  );
+  DBGLN("Mic capture task started on Core 0");
+}
+
+#endif // TARGET_CORES3
+#endif // AUDIO_CAPTURE_H
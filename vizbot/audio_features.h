@@ -0,0 +1,348 @@
+#ifndef AUDIO_FEATURES_H
+#define AUDIO_FEATURES_H
+
+#ifdef TARGET_CORES3
+
+#include <Arduino.h>
+
+// ============================================================================
+// Audio Features — FFT bands, spectral flux onsets, beat tracking
+// ============================================================================
+// Streaming spectral analysis fed by AudioAnalysis with one block of mic
+// samples at a time. Each block is Hann-windowed and run through a real
+// radix-2 FFT, then reduced to:
+//   - octave band energies (62Hz .. 8kHz at 16kHz sample rate)
+//   - spectral flux (sum of positive log-magnitude changes between blocks)
+//   - onsets (flux peaks above an adaptive mean threshold)
+//   - tempo + beat phase (autocorrelation of the onset envelope)
+//
+// All buffers are fixed-size struct members — nothing is allocated after
+// init(). Block timing is measured, so the beat tracker stays correct
+// whether blocks arrive back-to-back or with gaps between them.
+//
+// Define AUDIO_USE_ESP_DSP to run the FFT through ESP-DSP's optimized
+// dsps_fft2r_fc32 instead of the portable fallback below.
+// ============================================================================
+
+// #define AUDIO_USE_ESP_DSP
+
+#ifdef AUDIO_USE_ESP_DSP
+#include "dsps_fft2r.h"
+#endif
+
+#define AUDIO_FFT_SIZE         256     // Must equal AUDIO_SAMPLE_COUNT (one block per FFT)
+#define AUDIO_FFT_LOG2         8
+#define AUDIO_FFT_BINS         (AUDIO_FFT_SIZE / 2 + 1)
+#define AUDIO_NUM_BANDS        7       // Octaves: bins [1,2) [2,4) ... [64,128]
+#define AUDIO_FLUX_COMPRESS    0.001f  // log1p(gamma * |X|) magnitude compression
+#define AUDIO_FLUX_HISTORY     16      // Blocks in the adaptive onset threshold window
+#define AUDIO_ONSET_MULT       1.5f    // Flux must exceed mean * mult ...
+#define AUDIO_ONSET_FLOOR      2.0f    // ... plus this absolute floor
+#define AUDIO_ONSET_MIN_MS     100     // Debounce between onsets
+#define AUDIO_ENV_LEN          256     // Onset envelope history (blocks)
+#define AUDIO_TEMPO_EVERY      8       // Re-estimate tempo every N blocks
+#define AUDIO_BPM_MIN          60
+#define AUDIO_BPM_MAX          200
+#define AUDIO_BPM_PREFERRED    120.0f  // Center of the tempo prior (log-gaussian, 1 octave sigma)
+#define AUDIO_TEMPO_CONFIDENCE 0.15f   // Normalized autocorr peak needed to track beats
+
+struct AudioFeatures {
+  // ---- Outputs (valid after each process() call) ----
+  float bandEnergy[AUDIO_NUM_BANDS];   // Mean power per octave band
+  float bandLevel[AUDIO_NUM_BANDS];    // 0.0-1.0 auto-gained band level (for display)
+  float flux;                          // Spectral flux of the latest block
+  float bpm;                           // Smoothed tempo estimate (0 = no tempo yet)
+  float tempoConfidence;               // 0.0-1.0 normalized autocorrelation peak
+  bool onsetDetected;                  // Onset in the latest block
+  bool beatDetected;                   // Predicted beat fell in the latest block
+  uint32_t lastCostUs;                 // CPU time of the latest process() call
+  uint32_t maxCostUs;                  // Worst process() time since init
+
+  // ---- Preallocated working buffers ----
+  float window[AUDIO_FFT_SIZE];        // Hann window
+  float twiddleCos[AUDIO_FFT_SIZE / 2];
+  float twiddleSin[AUDIO_FFT_SIZE / 2];
+  uint8_t bitRev[AUDIO_FFT_SIZE];
+#ifdef AUDIO_USE_ESP_DSP
+  float fftData[AUDIO_FFT_SIZE * 2];   // Interleaved re/im for ESP-DSP
+#else
+  float fftRe[AUDIO_FFT_SIZE];
+  float fftIm[AUDIO_FFT_SIZE];
+#endif
+  float logMag[AUDIO_FFT_BINS];
+  float prevLogMag[AUDIO_FFT_BINS];
+  float bandPeak[AUDIO_NUM_BANDS];     // Slow-decaying per-band peak for auto-gain
+  float fluxHistory[AUDIO_FLUX_HISTORY];
+  float onsetEnv[AUDIO_ENV_LEN];       // Ring of rectified flux (tempo input)
+
+  // ---- Internal state ----
+  uint8_t fluxHistPos;
+  uint16_t envPos;
+  uint16_t envCount;
+  uint8_t blocksSinceTempo;
+  float prevFlux;
+  float blockMs;                       // Smoothed interval between blocks
+  unsigned long lastBlockMs;
+  unsigned long lastOnsetMs;
+  unsigned long lastBeatMs;
+  unsigned long nextBeatMs;
+
+  void init() {
+    for (uint16_t i = 0; i < AUDIO_FFT_SIZE; i++) {
+      window[i] = 0.5f - 0.5f * cosf(2.0f * PI * i / (AUDIO_FFT_SIZE - 1));
+      uint16_t r = 0;
+      for (uint8_t b = 0; b < AUDIO_FFT_LOG2; b++) {
+        if (i & (1 << b)) r |= 1 << (AUDIO_FFT_LOG2 - 1 - b);
+      }
+      bitRev[i] = (uint8_t)r;
+    }
+    for (uint16_t i = 0; i < AUDIO_FFT_SIZE / 2; i++) {
+      twiddleCos[i] = cosf(2.0f * PI * i / AUDIO_FFT_SIZE);
+      twiddleSin[i] = -sinf(2.0f * PI * i / AUDIO_FFT_SIZE);
+    }
+#ifdef AUDIO_USE_ESP_DSP
+    dsps_fft2r_init_fc32(NULL, AUDIO_FFT_SIZE);
+#endif
+    reset();
+  }
+
+  // Clear all history (e.g. after the mic was muted for speaker playback)
+  void reset() {
+    for (uint8_t b = 0; b < AUDIO_NUM_BANDS; b++) {
+      bandEnergy[b] = 0;
+      bandLevel[b] = 0;
+      bandPeak[b] = 1.0f;
+    }
+    for (uint16_t k = 0; k < AUDIO_FFT_BINS; k++) prevLogMag[k] = 0;
+    for (uint8_t i = 0; i < AUDIO_FLUX_HISTORY; i++) fluxHistory[i] = 0;
+    for (uint16_t i = 0; i < AUDIO_ENV_LEN; i++) onsetEnv[i] = 0;
+    flux = 0;
+    prevFlux = 0;
+    bpm = 0;
+    tempoConfidence = 0;
+    onsetDetected = false;
+    beatDetected = false;
+    fluxHistPos = 0;
+    envPos = 0;
+    envCount = 0;
+    blocksSinceTempo = 0;
+    blockMs = 0;
+    lastBlockMs = 0;
+    lastOnsetMs = 0;
+    lastBeatMs = 0;
+    nextBeatMs = 0;
+    lastCostUs = 0;
+    maxCostUs = 0;
+  }
+
+  // Analyze one block of AUDIO_FFT_SIZE samples captured ending at nowMs
+  void process(const int16_t* samples, unsigned long nowMs) {
+    uint32_t startUs = micros();
+
+    // Track block spacing (first block has no interval yet)
+    if (lastBlockMs != 0) {
+      float dt = (float)(nowMs - lastBlockMs);
+      blockMs = (blockMs == 0) ? dt : blockMs * 0.9f + dt * 0.1f;
+    }
+    lastBlockMs = nowMs;
+
+    runFFT(samples);
+    computeBands();
+    detectOnset(nowMs);
+    trackBeat(nowMs);
+
+    lastCostUs = micros() - startUs;
+    if (lastCostUs > maxCostUs) maxCostUs = lastCostUs;
+  }
+
+  // ---- FFT: windowed real input -> logMag[0..N/2] ----
+  void runFFT(const int16_t* samples) {
+#ifdef AUDIO_USE_ESP_DSP
+    for (uint16_t i = 0; i < AUDIO_FFT_SIZE; i++) {
+      fftData[i * 2]     = samples[i] * (1.0f / 32768.0f) * window[i];
+      fftData[i * 2 + 1] = 0;
+    }
+    dsps_fft2r_fc32(fftData, AUDIO_FFT_SIZE);
+    dsps_bit_rev_fc32(fftData, AUDIO_FFT_SIZE);
+    for (uint16_t k = 0; k < AUDIO_FFT_BINS; k++) {
+      float re = fftData[k * 2], im = fftData[k * 2 + 1];
+      logMag[k] = log1pf(sqrtf(re * re + im * im) * 32768.0f * AUDIO_FLUX_COMPRESS);
+    }
+#else
+    // Bit-reversed load with window applied
+    for (uint16_t i = 0; i < AUDIO_FFT_SIZE; i++) {
+      uint8_t j = bitRev[i];
+      fftRe[j] = samples[i] * (1.0f / 32768.0f) * window[i];
+      fftIm[j] = 0;
+    }
+    // Iterative radix-2 decimation-in-time butterflies
+    for (uint16_t size = 2; size <= AUDIO_FFT_SIZE; size <<= 1) {
+      uint16_t half = size >> 1;
+      uint16_t step = AUDIO_FFT_SIZE / size;
+      for (uint16_t start = 0; start < AUDIO_FFT_SIZE; start += size) {
+        for (uint16_t k = 0; k < half; k++) {
+          float wr = twiddleCos[k * step];
+          float wi = twiddleSin[k * step];
+          uint16_t a = start + k;
+          uint16_t b = a + half;
+          float tr = fftRe[b] * wr - fftIm[b] * wi;
+          float ti = fftRe[b] * wi + fftIm[b] * wr;
+          fftRe[b] = fftRe[a] - tr;
+          fftIm[b] = fftIm[a] - ti;
+          fftRe[a] += tr;
+          fftIm[a] += ti;
+        }
+      }
+    }
+    for (uint16_t k = 0; k < AUDIO_FFT_BINS; k++) {
+      float mag = sqrtf(fftRe[k] * fftRe[k] + fftIm[k] * fftIm[k]);
+      logMag[k] = log1pf(mag * 32768.0f * AUDIO_FLUX_COMPRESS);
+    }
+#endif
+  }
+
+  // ---- Octave bands + spectral flux ----
+  void computeBands() {
+    flux = 0;
+    uint16_t lo = 1;
+    for (uint8_t b = 0; b < AUDIO_NUM_BANDS; b++) {
+      // Last band includes the Nyquist bin
+      uint16_t hi = (b == AUDIO_NUM_BANDS - 1) ? AUDIO_FFT_BINS : lo * 2;
+      float sum = 0;
+      for (uint16_t k = lo; k < hi; k++) {
+        float m = expm1f(logMag[k]);  // Undo compression for energy
+        sum += m * m;
+      }
+      bandEnergy[b] = sum / (hi - lo);
+
+      // Auto-gain: normalize against a slowly decaying per-band peak
+      if (bandEnergy[b] > bandPeak[b]) bandPeak[b] = bandEnergy[b];
+      else bandPeak[b] = max(bandPeak[b] * 0.998f, 1.0f);
+      bandLevel[b] = sqrtf(bandEnergy[b] / bandPeak[b]);
+      lo = hi;
+    }
+
+    for (uint16_t k = 1; k < AUDIO_FFT_BINS; k++) {
+      float d = logMag[k] - prevLogMag[k];
+      if (d > 0) flux += d;
+      prevLogMag[k] = logMag[k];
+    }
+  }
+
+  // ---- Onsets: flux above adaptive threshold and rising ----
+  void detectOnset(unsigned long nowMs) {
+    float mean = 0;
+    for (uint8_t i = 0; i < AUDIO_FLUX_HISTORY; i++) mean += fluxHistory[i];
+    mean /= AUDIO_FLUX_HISTORY;
+
+    float threshold = mean * AUDIO_ONSET_MULT + AUDIO_ONSET_FLOOR;
+    onsetDetected = (flux > threshold && flux > prevFlux &&
+                     nowMs - lastOnsetMs >= AUDIO_ONSET_MIN_MS);
+    if (onsetDetected) lastOnsetMs = nowMs;
+
+    fluxHistory[fluxHistPos] = flux;
+    fluxHistPos = (fluxHistPos + 1) % AUDIO_FLUX_HISTORY;
+    prevFlux = flux;
+
+    // Rectified, mean-removed flux feeds the tempo estimator
+    onsetEnv[envPos] = max(flux - mean, 0.0f);
+    envPos = (envPos + 1) % AUDIO_ENV_LEN;
+    if (envCount < AUDIO_ENV_LEN) envCount++;
+  }
+
+  // ---- Tempo (autocorrelation) + beat phase (onset-anchored prediction) ----
+  void trackBeat(unsigned long nowMs) {
+    beatDetected = false;
+
+    if (++blocksSinceTempo >= AUDIO_TEMPO_EVERY && envCount == AUDIO_ENV_LEN && blockMs > 0) {
+      blocksSinceTempo = 0;
+      estimateTempo();
+    }
+    if (bpm <= 0 || tempoConfidence < AUDIO_TEMPO_CONFIDENCE) return;
+
+    unsigned long periodMs = (unsigned long)(60000.0f / bpm);
+
+    // Drop a stale grid (tempo was lost for a while) and wait for a fresh onset
+    if (nextBeatMs != 0 && (long)(nowMs - nextBeatMs) > (long)(periodMs * 4)) {
+      nextBeatMs = 0;
+      lastBeatMs = 0;
+    }
+
+    // Re-anchor the beat grid on onsets that land near a predicted beat
+    if (onsetDetected && lastBeatMs != 0) {
+      long err = (long)(nowMs - nextBeatMs);
+      if (labs(err) < (long)(periodMs / 4)) {
+        nextBeatMs = nowMs;
+      }
+    }
+    if (nextBeatMs == 0) {
+      if (!onsetDetected) return;
+      nextBeatMs = nowMs;  // First onset after tempo lock starts the grid
+    }
+
+    // Report a beat if the predicted beat fell inside this block
+    if ((long)(nowMs - nextBeatMs) >= 0) {
+      beatDetected = true;
+      lastBeatMs = nextBeatMs;
+      while ((long)(nowMs - nextBeatMs) >= 0) nextBeatMs += periodMs;
+    }
+  }
+
+  void estimateTempo() {
+    int minLag = (int)(60000.0f / (AUDIO_BPM_MAX * blockMs));
+    int maxLag = (int)(60000.0f / (AUDIO_BPM_MIN * blockMs) + 0.5f);
+    if (minLag < 1) minLag = 1;
+    if (maxLag > AUDIO_ENV_LEN / 2) maxLag = AUDIO_ENV_LEN / 2;
+    if (minLag >= maxLag) return;
+
+    // Zero-lag energy for normalization
+    float energy = 0;
+    for (uint16_t i = 0; i < AUDIO_ENV_LEN; i++) energy += onsetEnv[i] * onsetEnv[i];
+    if (energy <= 0) { tempoConfidence = 0; return; }
+
+    float bestScore = 0, bestRaw = 0;
+    int bestLag = 0;
+    for (int lag = minLag; lag <= maxLag; lag++) {
+      float acc = 0;
+      for (uint16_t i = lag; i < AUDIO_ENV_LEN; i++) {
+        // Ring indices relative to oldest sample (envPos)
+        acc += onsetEnv[(envPos + i) % AUDIO_ENV_LEN] *
+               onsetEnv[(envPos + i - lag) % AUDIO_ENV_LEN];
+      }
+      acc /= (AUDIO_ENV_LEN - lag);  // Unbiased
+      float lagBpm = 60000.0f / (lag * blockMs);
+      float oct = log2f(lagBpm / AUDIO_BPM_PREFERRED);
+      float score = acc * expf(-0.5f * oct * oct);
+      if (score > bestScore) {
+        bestScore = score;
+        bestRaw = acc;
+        bestLag = lag;
+      }
+    }
+    if (bestLag == 0) return;
+
+    // Parabolic interpolation around the peak for sub-block lag precision
+    float lagF = bestLag;
+    if (bestLag > minLag && bestLag < maxLag) {
+      float y0 = autocorrAt(bestLag - 1), y1 = bestRaw, y2 = autocorrAt(bestLag + 1);
+      float denom = y0 - 2 * y1 + y2;
+      if (denom < 0) lagF += 0.5f * (y0 - y2) / denom;
+    }
+
+    tempoConfidence = constrain(bestRaw / (energy / AUDIO_ENV_LEN), 0.0f, 1.0f);
+    float newBpm = 60000.0f / (lagF * blockMs);
+    bpm = (bpm <= 0 || fabsf(newBpm - bpm) > bpm * 0.1f) ? newBpm : bpm * 0.8f + newBpm * 0.2f;
+  }
+
+  float autocorrAt(int lag) const {
+    float acc = 0;
+    for (uint16_t i = lag; i < AUDIO_ENV_LEN; i++) {
+      acc += onsetEnv[(envPos + i) % AUDIO_ENV_LEN] *
+             onsetEnv[(envPos + i - lag) % AUDIO_ENV_LEN];
+    }
+    return acc / (AUDIO_ENV_LEN - lag);
+  }
+};
+
+#endif // TARGET_CORES3
+#endif // AUDIO_FEATURES_H
@@ -595,24 +595,18 @@ extern uint8_t paletteIndex;
 extern uint8_t effectIndex;
 extern CRGB leds[];
 
-// Use the function pointer tables from effects_ambient.h
-#if defined(HIRES_ENABLED)
-extern const AmbientFunc ambientHiResFuncs[];
-#endif
-extern const AmbientFunc ambientLedFuncs[];
-
 // Render ambient effect as bot background (respects hiResMode)
 void renderBotAmbientBackground() {
   uint8_t idx = effectIndex % NUM_AMBIENT_EFFECTS;
 
-  #if defined(HIRES_ENABLED)
+  #if defined(VIZFX_HIRES)
   if (hiResMode) {
     // Hi-res: render effect directly to LCD canvas
-    ambientHiResFuncs[idx]();
+    ambientEffects[idx].renderHiRes();
   } else {
   #endif
     // Pixel mode: run LED effect, then render leds[] as blocky background
-    ambientLedFuncs[idx]();
+    ambientEffects[idx].render();
     for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
       for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
         uint16_t ledIndex = XY(x, y);
@@ -623,7 +617,7 @@ void renderBotAmbientBackground() {
         gfx->fillRect(screenX, screenY, PIXEL_SIZE, PIXEL_SIZE, c565);
       }
     }
-  #if defined(HIRES_ENABLED)
+  #if defined(VIZFX_HIRES)
   }
   #endif
 }
@@ -15,11 +15,13 @@
 // Bot Sounds — MIDI Sequence Engine with M5.Speaker Fallback
 // ============================================================================
 // Primary: drives SAM2695 MIDI synth via midi_synth.h (multi-voice, GM instruments)
-// Fallback: sine-wave tones via M5.Speaker when MIDI module not available
+// Fallback: soft_synth.h renders the same sequences (8 voices + drums) to
+// M5.Speaker when the MIDI module is not available
 //
 // Timeline-based sequencer: events have offsetMs from sequence start, enabling
 // polyphony (multiple events at same offset = chord/layered instruments).
-// Non-blocking: update() advances via millis(), never blocks the render loop.
+// Non-blocking: events are timed by the backend task on Core 0; update()
+// only tracks sequence end/loop via millis() and never blocks the render loop.
 // ============================================================================
 
 // --- Sequence IDs ---
@@ -91,13 +93,12 @@ struct MidiEvent {
 
 // --- Sequence Definition ---
 
-#define SEQ_MAX_EVENTS 128  // cloud-sequence event cap (matches vizCloud MAX_CLOUD_EVENTS)
 #define SEQ_FLAG_LOOP       0x01
 #define SEQ_FLAG_PERCUSSION 0x02
 
 struct MidiSequenceDef {
   const char*       name;
-  uint8_t           eventCount;
+  uint16_t          eventCount;
   uint8_t           defaultProgram;  // GM instrument for channel 0
   uint8_t           flags;
   const MidiEvent*  events;          // PROGMEM or heap pointer
@@ -711,56 +712,54 @@ static const MidiSequenceDef builtinSequences[] = {
 // ============================================================================
 // Cloud Sequence Runtime Storage
 // ============================================================================
+// Catalog only (name + header fields, events == nullptr). The events live in
+// binary files on LittleFS and only the playing sequence is decoded into RAM
+// (see midi_seq_file.h, loadCloudSequence() in content_cache.h).
 
 #define MAX_CLOUD_SEQUENCES 20
 
-MidiEvent  cloudSeqEvents[MAX_CLOUD_SEQUENCES][SEQ_MAX_EVENTS];
 MidiSequenceDef cloudSequences[MAX_CLOUD_SEQUENCES];
 uint8_t cloudSequenceCount = 0;
 
-// ============================================================================
-// Sine-wave fallback (M5.Speaker) — used when MIDI synth not available
-// ============================================================================
-
-#define SINE_BUF_MAX 200
-
-static int16_t _sineBuf[SINE_BUF_MAX];
-
-static void _playSine(uint16_t freq, uint16_t durationMs) {
-  if (freq == 0) return;
-  uint16_t samplesPerCycle = 48000 / freq;
-  if (samplesPerCycle > SINE_BUF_MAX) samplesPerCycle = SINE_BUF_MAX;
-
-  for (uint16_t i = 0; i < samplesPerCycle; i++) {
-    _sineBuf[i] = (int16_t)(20000.0f * sinf(2.0f * M_PI * i / samplesPerCycle));
-  }
-
-  uint8_t repeats = constrain((uint32_t)freq * durationMs / 1000, 1, 255);
-  M5.Speaker.playRaw(_sineBuf, samplesPerCycle, 48000, false, repeats);
-}
-
-// Convert MIDI note number to frequency (A4=440Hz)
-static uint16_t midiNoteToFreq(uint8_t note) {
-  if (note == 0) return 0;
-  return (uint16_t)(440.0f * powf(2.0f, (note - 69) / 12.0f));
-}
+// A backend holds a reference on every sequence it has been handed, from
+// the post until it drops the sequence (STOP, a newer PLAY, the last event,
+// or a failed post). loadCloudSequence() won't reuse a decoded slot while
+// that count is non-zero. Built-in sequences aren't counted.
+#ifdef CLOUD_ENABLED
+extern const MidiSequenceDef* loadCloudSequence(uint8_t idx);
+extern void cloudSequenceRetain(const MidiSequenceDef* def);
+extern void cloudSequenceRelease(const MidiSequenceDef* def);
+#else
+static inline void cloudSequenceRetain(const MidiSequenceDef*) {}
+static inline void cloudSequenceRelease(const MidiSequenceDef*) {}
+#endif
 
 // ============================================================================
-// Active Note Tracking (for proper note-off)
+// Speaker fallback — software synth (defined in soft_synth.h)
 // ============================================================================
+// Used when the SAM2695 isn't present. The synth task sequences events
+// itself at sample resolution, so BotSounds only hands it whole sequences.
 
-#define MAX_ACTIVE_NOTES 8
+extern void softSynthInit();
+extern void softSynthPlaySequence(const MidiSequenceDef* def);
+extern void softSynthPlayTone(uint16_t freq, uint16_t durationMs);
+extern void softSynthStop();
 
-struct ActiveNote {
-  uint8_t  channel;
-  uint8_t  note;
-  unsigned long offMs;  // millis() when note should be turned off
-  bool     active;
-};
+#ifdef MIDI_SYNTH_ENABLED
+// SAM2695 path — defined in midi_scheduler.h. Sequences are timed there by
+// esp_timer on Core 0, so BotSounds never fires individual notes.
+extern void midiSchedPlaySequence(const MidiSequenceDef* def);
+extern void midiSchedStop();
+extern void midiSchedSend(const uint8_t* data, uint8_t len, uint32_t delayMs);
+#define MIDI_SEQ_LEAD_MS 15  // Matches MIDI_PROGRAM_LEAD_MS (program change settle)
+#endif
 
 // ============================================================================
 // BotSounds — Global Sequencer
 // ============================================================================
+// Both backends (MIDI scheduler, soft synth) walk the event list themselves
+// with sub-millisecond timing. BotSounds picks the backend, hands it whole
+// sequences, and tracks when playback ends (the mic mutes while playing).
 
 struct BotSounds {
   bool enabled;
@@ -771,13 +770,9 @@ struct BotSounds {
   // Playback state
   MidiSequenceId currentSeqId;
   const MidiSequenceDef* currentDef;
-  uint8_t  eventIndex;       // Next event to fire
   unsigned long seqStartMs;  // millis() when sequence started
   unsigned long seqEndMs;    // millis() when last note-off finishes
 
-  // Active note tracking for MIDI note-off
-  ActiveNote activeNotes[MAX_ACTIVE_NOTES];
-
   // For fallback single-tone playback (web API freq+dur)
   bool singleTone;
   unsigned long singleToneEndMs;
@@ -788,16 +783,11 @@ struct BotSounds {
     playing = false;
     currentSeqId = SEQ_NONE;
     currentDef = nullptr;
-    eventIndex = 0;
     seqStartMs = 0;
     seqEndMs = 0;
     singleTone = false;
     singleToneEndMs = 0;
 
-    for (uint8_t i = 0; i < MAX_ACTIVE_NOTES; i++) {
-      activeNotes[i].active = false;
-    }
-
     // Try MIDI synth first
     useMidi = false;
 #ifdef MIDI_SYNTH_ENABLED
@@ -816,7 +806,8 @@ struct BotSounds {
       M5.Speaker.config(cfg);
       M5.Speaker.begin();
       M5.Speaker.setVolume(volume);
-      DBGLN("BotSounds: M5.Speaker fallback mode");
+      softSynthInit();
+      DBGLN("BotSounds: M5.Speaker soft synth mode");
     }
   }
 
@@ -852,28 +843,9 @@ struct BotSounds {
 
     currentSeqId = id;
     currentDef = def;
-    eventIndex = 0;
     singleTone = false;
     playing = true;
-    seqStartMs = millis();
-
-    // Calculate sequence end time (latest note-off)
-    uint16_t maxEnd = 0;
-    for (uint8_t i = 0; i < def->eventCount; i++) {
-      MidiEvent ev;
-      memcpy_P(&ev, &def->events[i], sizeof(MidiEvent));
-      uint16_t end = ev.offsetMs + ev.durationMs;
-      if (end > maxEnd) maxEnd = end;
-    }
-    seqEndMs = seqStartMs + maxEnd + 50;  // 50ms grace
-
-    // Set program for default channel
-    if (useMidi) {
-#ifdef MIDI_SYNTH_ENABLED
-      midiSynth.programChange(0, def->defaultProgram);
-      delay(15);  // SAM2695 needs time after instrument change before first note
-#endif
-    }
+    startBackend(millis());
   }
 
   // --- Play a single arbitrary tone (legacy web API: freq + duration) ---
@@ -893,10 +865,11 @@ struct BotSounds {
       note = constrain(note, 0, 127);
       midiSynth.programChange(0, GM_VIBRAPHONE);
       midiSynth.noteOn(0, note, 100);
-      addActiveNote(0, note, singleToneEndMs);
+      uint8_t off[] = {0x80, note, 0};
+      midiSchedSend(off, sizeof(off), durationMs);
 #endif
     } else {
-      _playSine(freq, durationMs);
+      softSynthPlayTone(freq, durationMs);
     }
   }
 
@@ -905,22 +878,16 @@ struct BotSounds {
   void stop() {
     if (useMidi) {
 #ifdef MIDI_SYNTH_ENABLED
-      // Turn off all tracked notes
-      for (uint8_t i = 0; i < MAX_ACTIVE_NOTES; i++) {
-        if (activeNotes[i].active) {
-          midiSynth.noteOff(activeNotes[i].channel, activeNotes[i].note);
-          activeNotes[i].active = false;
-        }
-      }
+      midiSchedStop();  // Releases every sounding sequence note
+      if (singleTone) midiSynth.allNotesOff(0);
 #endif
     } else {
-      M5.Speaker.stop();
+      softSynthStop();
     }
 
     playing = false;
     currentSeqId = SEQ_NONE;
     currentDef = nullptr;
-    eventIndex = 0;
     singleTone = false;
   }
 
@@ -933,8 +900,6 @@ struct BotSounds {
 
     // Handle single-tone playback
     if (singleTone) {
-      // Check note-offs for MIDI
-      if (useMidi) updateNoteOffs(now);
       if (now >= singleToneEndMs) {
         playing = false;
         singleTone = false;
@@ -948,36 +913,10 @@ struct BotSounds {
       return;
     }
 
-    // Fire events whose offsetMs has been reached
-    while (eventIndex < currentDef->eventCount) {
-      MidiEvent ev;
-      memcpy_P(&ev, &currentDef->events[eventIndex], sizeof(MidiEvent));
-
-      unsigned long eventFireMs = seqStartMs + ev.offsetMs;
-      if (now < eventFireMs) break;  // Not time yet
-
-      // Fire this event
-      fireEvent(ev, now);
-      eventIndex++;
-    }
-
-    // Handle note-offs for MIDI
-    if (useMidi) updateNoteOffs(now);
-
     // Check if sequence is complete
     if (now >= seqEndMs) {
       if (currentDef->flags & SEQ_FLAG_LOOP) {
-        // Restart
-        eventIndex = 0;
-        seqStartMs = now;
-        uint16_t maxEnd = 0;
-        for (uint8_t i = 0; i < currentDef->eventCount; i++) {
-          MidiEvent e;
-          memcpy_P(&e, &currentDef->events[i], sizeof(MidiEvent));
-          uint16_t end = e.offsetMs + e.durationMs;
-          if (end > maxEnd) maxEnd = end;
-        }
-        seqEndMs = seqStartMs + maxEnd + 50;
+        startBackend(now);  // Restart
       } else {
         playing = false;
         currentSeqId = SEQ_NONE;
@@ -988,81 +927,44 @@ struct BotSounds {
 
 private:
 
-  const MidiSequenceDef* lookupSequence(MidiSequenceId id) {
-    if (id < BUILTIN_SEQ_COUNT) {
-      return &builtinSequences[id];
-    }
-    // Cloud sequences
-    if (id >= SEQ_CLOUD_BASE) {
-      uint8_t cloudIdx = id - SEQ_CLOUD_BASE;
-      if (cloudIdx < cloudSequenceCount) {
-        return &cloudSequences[cloudIdx];
-      }
-    }
-    return nullptr;
-  }
+  // Hand currentDef to the active backend and compute when it ends
+  void startBackend(unsigned long now) {
+    seqStartMs = now;
 
-  void fireEvent(const MidiEvent& ev, unsigned long now) {
-    if (ev.note == 0 && ev.durationMs == 0) return;  // Terminator
+    // Sequence end time (latest note-off)
+    uint16_t maxEnd = 0;
+    for (uint16_t i = 0; i < currentDef->eventCount; i++) {
+      MidiEvent ev;
+      memcpy_P(&ev, &currentDef->events[i], sizeof(MidiEvent));
+      uint16_t end = ev.offsetMs + ev.durationMs;
+      if (end > maxEnd) maxEnd = end;
+    }
+    seqEndMs = seqStartMs + maxEnd + 50;  // 50ms grace
 
     if (useMidi) {
 #ifdef MIDI_SYNTH_ENABLED
-      // Set program if event overrides
-      uint8_t ch = ev.channel;
-      if (ev.program != 255 && ch != MIDI_CH_PERCUSSION) {
-        midiSynth.programChange(ch, ev.program);
-      }
-      midiSynth.noteOn(ch, ev.note, ev.velocity);
-      addActiveNote(ch, ev.note, now + ev.durationMs);
+      midiSchedPlaySequence(currentDef);  // Program change + settle lead handled there
+      seqEndMs += MIDI_SEQ_LEAD_MS;
 #endif
     } else {
-      // Fallback: play as sine-wave tone (ignore channel/program)
-      if (ev.channel != MIDI_CH_PERCUSSION) {
-        uint16_t freq = midiNoteToFreq(ev.note);
-        _playSine(freq, ev.durationMs);
-      }
-      // Percussion events are skipped in fallback mode
+      softSynthPlaySequence(currentDef);
     }
   }
 
-  void addActiveNote(uint8_t ch, uint8_t note, unsigned long offMs) {
-    // Find an empty slot
-    for (uint8_t i = 0; i < MAX_ACTIVE_NOTES; i++) {
-      if (!activeNotes[i].active) {
-        activeNotes[i].channel = ch;
-        activeNotes[i].note = note;
-        activeNotes[i].offMs = offMs;
-        activeNotes[i].active = true;
-        return;
-      }
-    }
-    // All slots full — steal the earliest one
-    uint8_t earliest = 0;
-    unsigned long earliestMs = ULONG_MAX;
-    for (uint8_t i = 0; i < MAX_ACTIVE_NOTES; i++) {
-      if (activeNotes[i].offMs < earliestMs) {
-        earliestMs = activeNotes[i].offMs;
-        earliest = i;
-      }
+  const MidiSequenceDef* lookupSequence(MidiSequenceId id) {
+    if (id < BUILTIN_SEQ_COUNT) {
+      return &builtinSequences[id];
     }
-#ifdef MIDI_SYNTH_ENABLED
-    midiSynth.noteOff(activeNotes[earliest].channel, activeNotes[earliest].note);
-#endif
-    activeNotes[earliest].channel = ch;
-    activeNotes[earliest].note = note;
-    activeNotes[earliest].offMs = offMs;
-    activeNotes[earliest].active = true;
-  }
-
-  void updateNoteOffs(unsigned long now) {
-#ifdef MIDI_SYNTH_ENABLED
-    for (uint8_t i = 0; i < MAX_ACTIVE_NOTES; i++) {
-      if (activeNotes[i].active && now >= activeNotes[i].offMs) {
-        midiSynth.noteOff(activeNotes[i].channel, activeNotes[i].note);
-        activeNotes[i].active = false;
+#ifdef CLOUD_ENABLED
+    // Cloud sequences — decoded from LittleFS on demand
+    if (id >= SEQ_CLOUD_BASE) {
+      uint8_t cloudIdx = id - SEQ_CLOUD_BASE;
+      if (cloudIdx < cloudSequenceCount) {
+        return loadCloudSequence(cloudIdx);
       }
     }
 #endif
+    return nullptr;
   }
 };
 
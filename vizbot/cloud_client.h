@@ -11,6 +11,7 @@
 #include "config.h"
 #include "system_status.h"
 #include "content_cache.h"
+#include "timeline.h"
 
 // GTS Root R4 — Google Trust Services root CA used by DigitalOcean App Platform.
 // Chain: server cert → WE1 (intermediate) → GTS Root R4 (this cert).
@@ -55,6 +56,8 @@ extern void cmdSetAmbientEffect(uint8_t val);
 extern void cmdPlaySound(uint16_t freq, uint16_t duration);
 extern void cmdPlaySequence(uint8_t seqId);
 extern void cmdSetVolume(uint8_t vol);
+extern void cmdPlayAnim(const char* name, uint8_t target, uint16_t loops);
+extern void cmdStopAnim();
 
 // Forward declarations from bot_mode.h
 extern uint8_t getBotPersonality();
@@ -90,18 +93,6 @@ static uint32_t cloudBackoffSec = 0;
 static unsigned long lastSyncAttempt = 0;
 static unsigned long cloudNextPollMs = 0;
 
-// Scheduled command buffer
-#define SCHED_CMD_SLOTS 8
-struct ScheduledCommand {
-  char id[48];
-  char type[20];
-  uint8_t payloadBuf[128];
-  uint16_t payloadLen;
-  time_t executeAt;
-  bool occupied;
-};
-static ScheduledCommand scheduledCmds[SCHED_CMD_SLOTS];
-
 // ISO-8601 UTC parser
 static time_t parseISO8601(const char* iso) {
   struct tm tm = {};
@@ -517,6 +508,42 @@ static void dispatchCloudCommand(const char* type, JsonObject& payload) {
     meshScanRequested = true;
     DBGLN("Cloud cmd: mesh_scan requested (stub)");
 
+  } else if (strcmp(type, "mesh_play") == 0) {
+    // Synchronized start on every bot in radio range (mesh clock)
+    extern bool meshPlayAt(uint8_t action, uint16_t arg, const char* text, uint32_t leadMs);
+    extern int8_t meshPlayActionFromName(const char* name);
+    const char* action = payload["action"] | "";
+    int8_t kind = meshPlayActionFromName(action);
+    uint16_t arg = payload["value"] | (strcmp(action, "say") == 0 ? 4000 : 0);
+    uint32_t lead = payload["leadMs"] | 500;
+    if (kind >= 0) {
+      meshPlayAt(kind, arg, payload["text"] | "", constrain(lead, 50, 10000));
+    }
+    DBG("Cloud cmd: mesh_play=");
+    DBGLN(action);
+
+  } else if (strcmp(type, "unschedule") == 0) {
+    const char* id = payload["id"] | "";
+    bool found = timelineCancelId(id);
+    DBG("Cloud cmd: unschedule ");
+    DBG(id);
+    DBGLN(found ? "" : " (not found)");
+
+  } else if (strcmp(type, "animation") == 0) {
+    // {"name":"sparkle","target":"lcd|wled|both","loops":0}
+    const char* name = payload["name"] | "";
+    const char* t = payload["target"] | "lcd";
+    uint8_t target = strcmp(t, "both") == 0 ? (ANIM_TARGET_LCD | ANIM_TARGET_WLED)
+                   : strcmp(t, "wled") == 0 ? ANIM_TARGET_WLED : ANIM_TARGET_LCD;
+    uint16_t loops = payload["loops"] | 0;
+    if (name[0]) cmdPlayAnim(name, target, loops);
+    DBG("Cloud cmd: animation ");
+    DBGLN(name);
+
+  } else if (strcmp(type, "stop_animation") == 0) {
+    cmdStopAnim();
+    DBGLN("Cloud cmd: stop_animation");
+
   } else if (strcmp(type, "reboot") == 0) {
     DBGLN("Cloud cmd: reboot");
     delay(100);
@@ -634,33 +661,36 @@ bool cloudSync() {
         JsonObject payload = cmd["payload"];
         const char* execAt = cmd["execute_at"] | "";
 
-        // Check if this is a scheduled command
+        // Check if this is a scheduled command — recurring (cron) or one-shot
+        // (execute_at). Either way it goes on the timeline and survives a reboot.
         bool scheduled = false;
-        if (strlen(execAt) > 0 && sysStatus.ntpSynced) {
+        const char* cron = cmd["cron"] | "";
+        if (strlen(cron) > 0) {
+          String payStr;
+          serializeJson(payload, payStr);
+          int16_t offsetMin = cmd["utc_offset_min"] | 0;
+          scheduled = true;   // A rule is never run on the spot, even if rejected
+          if (timelineCron(cron, offsetMin, TL_COMMAND, 0, id, type, payStr.c_str()) >= 0) {
+            DBG("Cloud: recurring cmd type=");
+            DBG(type);
+            DBG(" cron=");
+            DBGLN(cron);
+          } else {
+            DBG("Cloud: rejected cron cmd ");
+            DBGLN(cron);
+          }
+        } else if (strlen(execAt) > 0 && sysStatus.ntpSynced) {
           time_t execTime = parseISO8601(execAt);
           time_t now_t = time(NULL);
           if (execTime > now_t + 2) {
-            // Schedule for later — find a free slot
-            for (uint8_t s = 0; s < SCHED_CMD_SLOTS; s++) {
-              if (!scheduledCmds[s].occupied) {
-                strncpy(scheduledCmds[s].id, id, sizeof(scheduledCmds[s].id) - 1);
-                strncpy(scheduledCmds[s].type, type, sizeof(scheduledCmds[s].type) - 1);
-                // Serialize payload into buffer
-                String payStr;
-                serializeJson(payload, payStr);
-                uint16_t len = min((uint16_t)payStr.length(), (uint16_t)(sizeof(scheduledCmds[s].payloadBuf) - 1));
-                memcpy(scheduledCmds[s].payloadBuf, payStr.c_str(), len);
-                scheduledCmds[s].payloadBuf[len] = '\0';
-                scheduledCmds[s].payloadLen = len;
-                scheduledCmds[s].executeAt = execTime;
-                scheduledCmds[s].occupied = true;
-                scheduled = true;
-                DBG("Cloud: scheduled cmd type=");
-                DBG(type);
-                DBG(" at T+");
-                DBGLN(execTime - now_t);
-                break;
-              }
+            String payStr;
+            serializeJson(payload, payStr);
+            scheduled = timelineAddCommand(id, type, payStr.c_str(), (uint32_t)execTime);
+            if (scheduled) {
+              DBG("Cloud: scheduled cmd type=");
+              DBG(type);
+              DBG(" at T+");
+              DBGLN(execTime - now_t);
             }
           }
         }
@@ -761,25 +791,23 @@ bool cloudSync() {
 }
 
 // ============================================================================
-// Scheduled Command Polling — called from WiFi task loop
+// Scheduled Commands — run by the timeline (timeline.h) at their time
 // ============================================================================
 
-void pollScheduledCommands() {
-  if (!sysStatus.ntpSynced) return;
-  time_t now_t = time(NULL);
-  for (uint8_t i = 0; i < SCHED_CMD_SLOTS; i++) {
-    if (!scheduledCmds[i].occupied) continue;
-    if (now_t >= scheduledCmds[i].executeAt) {
-      // Time to execute — deserialize payload and dispatch
-      JsonDocument payDoc;
-      deserializeJson(payDoc, (const char*)scheduledCmds[i].payloadBuf);
-      JsonObject payload = payDoc.as<JsonObject>();
-      DBG("Cloud: executing scheduled cmd type=");
-      DBGLN(scheduledCmds[i].type);
-      dispatchCloudCommand(scheduledCmds[i].type, payload);
-      scheduledCmds[i].occupied = false;
-    }
-  }
+static bool cloudRunScheduled(uint8_t, const TimelineCmd* cmd) {
+  if (!cmd) return true;
+  JsonDocument payDoc;
+  deserializeJson(payDoc, cmd->payload);
+  JsonObject payload = payDoc.as<JsonObject>();
+  DBG("Cloud: executing scheduled cmd type=");
+  DBGLN(cmd->type);
+  dispatchCloudCommand(cmd->type, payload);
+  return true;
+}
+
+// Called from setup() — scheduled commands run with or without LittleFS
+void initCloudSchedule() {
+  timelineRegister(TL_COMMAND, cloudRunScheduled);
 }
 
 // ============================================================================
@@ -803,6 +831,9 @@ void initCloudClient() {
         cloudMeta.registered = true;
       }
     }
+#ifdef MIDI_SYNTH_ENABLED
+    applyCloudSequences();  // Catalog from cached sequence file headers
+#endif
   }
 
   // Boot delay — let WiFi stack settle before first cloud poll
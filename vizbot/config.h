@@ -250,9 +250,6 @@
   #define DBGLN(...)
 #endif
 
-// XY mapping - trying NO serpentine (straight rows)
-inline uint16_t XY(uint8_t x, uint8_t y) {
-  return y * MATRIX_WIDTH + x;
-}
+// XY() mapping lives in vizfx_canvas.h (straight rows, no serpentine)
 
 #endif
@@ -6,8 +6,10 @@
 #include <Arduino.h>
 #include <LittleFS.h>
 #include <ArduinoJson.h>
+#include <atomic>
 #include "config.h"
 #include "bot_sayings.h"
+#include "midi_seq_file.h"
 
 // ============================================================================
 // Content Cache — LittleFS-based cloud content storage
@@ -19,7 +21,7 @@
 //   /cloud/meta.json          — botId, contentVersion, pollInterval
 //   /cloud/sayings.json       — full sayings array from server
 //   /cloud/personalities.json — full personalities array from server
-//   /cloud/sequences.json     — MIDI sequences array from server
+//   /cloud/seq/<n>.bin        — MIDI sequences, compact binary (midi_seq_file.h)
 // ============================================================================
 
 // Thread safety: set true while cloud task writes, checked by getCloudSaying()
@@ -117,97 +119,240 @@ bool saveCloudMeta(const CloudMeta& meta) {
 // Content Read/Write
 // ============================================================================
 
-bool writeCloudSequences(const String& sequencesJson) {
-  if (sequencesJson.length() == 0) return true;
-  File f = LittleFS.open("/cloud/sequences.json", "w");
-  if (!f) {
-    DBGLN("Cache: failed to write sequences");
+#ifdef MIDI_SYNTH_ENABLED
+// Cloud sequence catalog and on-demand loader (storage defined in bot_sounds.h:
+// cloudSequences, cloudSequenceCount). The catalog only holds names and
+// header fields; events stay in MIDI_SEQ_DIR until a sequence is played.
+extern MidiSequenceDef cloudSequences[];
+extern uint8_t cloudSequenceCount;
+
+// Convert one JSON sequence object to MIDI_SEQ_DIR/<idx>.bin
+bool convertCloudSequence(JsonObject seq, uint8_t idx) {
+  char path[24];
+  midiSeqPath(path, sizeof(path), idx);
+
+  MidiSeqWriter w;
+  if (!w.begin(path, seq["name"] | "Cloud", seq["defaultProgram"] | 0, 0)) {
+    DBGLN("Cache: failed to open sequence file");
     return false;
   }
-  f.print(sequencesJson);
-  f.close();
-  return true;
+  JsonArray events = seq["events"];
+  if (events) {
+    for (JsonObject ev : events) {
+      MidiEvent me;
+      me.note       = ev["note"] | 0;
+      me.velocity   = ev["velocity"] | 100;
+      me.channel    = ev["channel"] | 0;
+      me.program    = ev["program"] | 255;
+      me.durationMs = ev["duration"] | 100;
+      me.offsetMs   = ev["offset"] | 0;
+      if (!w.add(me)) break;
+    }
+  }
+  return w.finish();
 }
 
-bool loadCloudSequences(JsonDocument& doc) {
-  File f = LittleFS.open("/cloud/sequences.json", "r");
-  if (!f) return false;
-  DeserializationError err = deserializeJson(doc, f);
-  f.close();
+// Convert a cloud sequences JSON array into binary files, replacing the old set
+bool convertCloudSequences(JsonArray arr) {
+  if (!LittleFS.exists(MIDI_SEQ_DIR)) {
+    LittleFS.mkdir(MIDI_SEQ_DIR);
+  }
+
+  bool ok = true;
+  uint8_t count = 0;
+  for (JsonObject seq : arr) {
+    if (count >= MAX_CLOUD_SEQUENCES) break;
+    ok &= convertCloudSequence(seq, count);
+    count++;
+  }
+
+  // Drop files left over from a longer previous set
+  char path[24];
+  for (uint8_t i = count; i < MAX_CLOUD_SEQUENCES; i++) {
+    midiSeqPath(path, sizeof(path), i);
+    if (LittleFS.exists(path)) LittleFS.remove(path);
+  }
+  return ok;
+}
+#endif // MIDI_SYNTH_ENABLED
+
+bool writeCloudSequences(const String& sequencesJson) {
+  if (sequencesJson.length() == 0) return true;
+#ifdef MIDI_SYNTH_ENABLED
+  JsonDocument doc;
+  DeserializationError err = deserializeJson(doc, sequencesJson);
   if (err) {
     DBG("Sequences parse error: ");
     DBGLN(err.c_str());
     return false;
   }
-  return true;
+  JsonArray arr = doc.as<JsonArray>();
+  if (arr.isNull()) return false;
+  if (!convertCloudSequences(arr)) {
+    DBGLN("Cache: failed to write sequences");
+    return false;
+  }
+#endif
+  return true;  // Nothing plays sequences without the MIDI engine
 }
 
-// Parse cloud sequences JSON into runtime MidiSequenceDef/MidiEvent arrays
-// (defined in bot_sounds.h: cloudSeqEvents, cloudSequences, cloudSequenceCount)
 #ifdef MIDI_SYNTH_ENABLED
-extern MidiEvent  cloudSeqEvents[][SEQ_MAX_EVENTS];
-extern MidiSequenceDef cloudSequences[];
-extern uint8_t cloudSequenceCount;
-
-void applyCloudSequences() {
+// Migrate a JSON cache written by older firmware to binary files
+static void migrateCloudSequencesJson() {
+  File f = LittleFS.open("/cloud/sequences.json", "r");
+  if (!f) return;
   JsonDocument doc;
-  if (!loadCloudSequences(doc)) {
-    DBGLN("Cache: no cloud sequences to apply");
-    return;
+  DeserializationError err = deserializeJson(doc, f);
+  f.close();
+  if (!err && doc.is<JsonArray>()) {
+    convertCloudSequences(doc.as<JsonArray>());
+    DBGLN("Cache: migrated sequences.json to binary");
+  }
+  LittleFS.remove("/cloud/sequences.json");
+}
+
+// Play slots — the decoded sequence currently handed to a backend, plus the
+// previous one. A new sequence is decoded into the other slot. The backend
+// tasks (Core 0) can still be reading a slot after BotSounds has moved on —
+// its STOP may sit in their queue — so each slot counts the references they
+// hold and is only freed at zero.
+//
+// Slots are only touched by loadCloudSequence() on Core 1. The cloud task
+// doesn't reset them when the files change; it bumps cloudSeqGen and the
+// loader drops its cached indexes on the next call.
+static MidiSequenceDef cloudSeqPlayDef[2];
+static MidiEvent* cloudSeqPlayEvents[2] = { nullptr, nullptr };
+static char cloudSeqPlayName[2][32];
+static int8_t cloudSeqPlayIdx[2] = { -1, -1 };   // Catalog index held, -1 = none
+static uint8_t cloudSeqPlayLast = 0;
+static uint32_t cloudSeqPlayGen = 0;              // cloudSeqGen the indexes belong to
+static std::atomic<uint8_t> cloudSeqPlayRefs[2];
+static std::atomic<uint32_t> cloudSeqGen(0);
+
+void cloudSequenceRetain(const MidiSequenceDef* def) {
+  for (uint8_t s = 0; s < 2; s++) {
+    if (def == &cloudSeqPlayDef[s]) cloudSeqPlayRefs[s].fetch_add(1, std::memory_order_relaxed);
   }
+}
 
-  JsonArray arr = doc.as<JsonArray>();
-  if (arr.isNull() || arr.size() == 0) {
-    DBGLN("Cache: cloud sequences array empty");
-    cloudSequenceCount = 0;
-    return;
+// Called by the backend once it won't read def's events again
+void cloudSequenceRelease(const MidiSequenceDef* def) {
+  for (uint8_t s = 0; s < 2; s++) {
+    if (def == &cloudSeqPlayDef[s]) cloudSeqPlayRefs[s].fetch_sub(1, std::memory_order_release);
   }
+}
+
+// Rebuild the catalog from the binary file headers
+void applyCloudSequences() {
+  migrateCloudSequencesJson();
 
   uint8_t count = 0;
-  for (JsonObject seq : arr) {
-    if (count >= MAX_CLOUD_SEQUENCES) break;
+  static char cloudSeqNames[MAX_CLOUD_SEQUENCES][32];
+  char path[24];
+  for (uint8_t i = 0; i < MAX_CLOUD_SEQUENCES; i++) {
+    midiSeqPath(path, sizeof(path), i);
+    File f = LittleFS.open(path, "r");
+    if (!f) break;
+    MidiSeqHeader hdr;
+    bool ok = midiSeqReadHeader(f, hdr);
+    f.close();
+    if (!ok) {
+      DBG("Cache: bad sequence file ");
+      DBGLN(path);
+      break;
+    }
 
     MidiSequenceDef& def = cloudSequences[count];
-    // Store name in a static buffer (names are short, reuse the event's memory footprint)
-    static char cloudSeqNames[MAX_CLOUD_SEQUENCES][32];
-    const char* name = seq["name"] | "Cloud";
-    strncpy(cloudSeqNames[count], name, sizeof(cloudSeqNames[count]) - 1);
-    cloudSeqNames[count][31] = '\0';
+    memcpy(cloudSeqNames[count], hdr.name, sizeof(hdr.name));
     def.name = cloudSeqNames[count];
+    def.eventCount = hdr.eventCount;
+    def.defaultProgram = hdr.defaultProgram;
+    def.flags = hdr.flags;
+    def.events = nullptr;  // Decoded on demand by loadCloudSequence()
 
-    def.defaultProgram = seq["defaultProgram"] | 0;
-    def.flags = 0;
-
-    JsonArray events = seq["events"];
-    uint8_t evCount = 0;
-    if (events) {
-      for (JsonObject ev : events) {
-        if (evCount >= SEQ_MAX_EVENTS) break;
-        MidiEvent& me = cloudSeqEvents[count][evCount];
-        me.note       = ev["note"] | 0;
-        me.velocity   = ev["velocity"] | 100;
-        me.channel    = ev["channel"] | 0;
-        me.program    = ev["program"] | 255;
-        me.durationMs = ev["duration"] | 100;
-        me.offsetMs   = ev["offset"] | 0;
-        evCount++;
-      }
-    }
-    def.eventCount = evCount;
-    def.events = cloudSeqEvents[count];
-
-    DBG("Cache: loaded cloud sequence [");
+    DBG("Cache: cloud sequence [");
     DBG(count);
     DBG("] ");
-    DBGLN(def.name);
+    DBG(def.name);
+    DBG(" (");
+    DBG(hdr.eventCount);
+    DBGLN(" events)");
 
     count++;
   }
 
   cloudSequenceCount = count;
+  cloudSeqGen.fetch_add(1, std::memory_order_release);   // Next play re-decodes
   DBG("Cache: total cloud sequences: ");
   DBGLN(cloudSequenceCount);
 }
+
+// Decode a cloud sequence into a play slot. Called from BotSounds when a
+// cloud sequence starts; returns nullptr if the file is missing or corrupt.
+const MidiSequenceDef* loadCloudSequence(uint8_t idx) {
+  if (idx >= cloudSequenceCount) return nullptr;
+
+  // Content changed since the slots were decoded
+  uint32_t gen = cloudSeqGen.load(std::memory_order_acquire);
+  if (gen != cloudSeqPlayGen) {
+    cloudSeqPlayIdx[0] = -1;
+    cloudSeqPlayIdx[1] = -1;
+    cloudSeqPlayGen = gen;
+  }
+
+  // Already resident (replay / loop)
+  for (uint8_t s = 0; s < 2; s++) {
+    if (cloudSeqPlayIdx[s] == idx) {
+      cloudSeqPlayLast = s;
+      return &cloudSeqPlayDef[s];
+    }
+  }
+
+  char path[24];
+  midiSeqPath(path, sizeof(path), idx);
+  File f = LittleFS.open(path, "r");
+  if (!f) return nullptr;
+  MidiSeqHeader hdr;
+  if (!midiSeqReadHeader(f, hdr) || hdr.eventCount == 0) {
+    f.close();
+    return nullptr;
+  }
+
+  // Evict the slot that isn't the most recently played one, unless a backend
+  // still reads it (STOP not handled yet) — then the other one, if it's idle
+  uint8_t slot = cloudSeqPlayLast ^ 1;
+  if (cloudSeqPlayRefs[slot].load(std::memory_order_acquire) != 0) slot ^= 1;
+  if (cloudSeqPlayRefs[slot].load(std::memory_order_acquire) != 0) {
+    f.close();
+    DBGLN("Cache: sequence slots busy");
+    return nullptr;
+  }
+  free(cloudSeqPlayEvents[slot]);
+  cloudSeqPlayIdx[slot] = -1;
+  uint16_t cap = min(hdr.eventCount, (uint16_t)MIDI_SEQ_MAX_EVENTS);
+  cloudSeqPlayEvents[slot] = (MidiEvent*)malloc(cap * sizeof(MidiEvent));
+  if (!cloudSeqPlayEvents[slot]) {
+    f.close();
+    DBGLN("Cache: no memory for sequence");
+    return nullptr;
+  }
+  uint16_t n = midiSeqDecode(f, cloudSeqPlayEvents[slot], cap);
+  f.close();
+  if (n == 0) return nullptr;
+
+  // From the file header — the catalog may be rewritten by the cloud task
+  memcpy(cloudSeqPlayName[slot], hdr.name, sizeof(hdr.name));
+  cloudSeqPlayName[slot][sizeof(cloudSeqPlayName[slot]) - 1] = '\0';
+  MidiSequenceDef& def = cloudSeqPlayDef[slot];
+  def.name = cloudSeqPlayName[slot];
+  def.defaultProgram = hdr.defaultProgram;
+  def.flags = hdr.flags;
+  def.eventCount = n;
+  def.events = cloudSeqPlayEvents[slot];
+  cloudSeqPlayIdx[slot] = idx;
+  cloudSeqPlayLast = slot;
+  return &def;
+}
 #endif // MIDI_SYNTH_ENABLED
 
 bool writeCloudContent(const String& sayingsJson, const String& personalitiesJson) {
@@ -369,6 +514,14 @@ void clearContentCache() {
   LittleFS.remove("/cloud/sayings.json");
   LittleFS.remove("/cloud/personalities.json");
   LittleFS.remove("/cloud/sequences.json");
+#ifdef MIDI_SYNTH_ENABLED
+  char path[24];
+  for (uint8_t i = 0; i < MAX_CLOUD_SEQUENCES; i++) {
+    midiSeqPath(path, sizeof(path), i);
+    LittleFS.remove(path);
+  }
+  cloudSequenceCount = 0;
+#endif
   DBGLN("Cache: cleared");
 }
 
@@ -2,6 +2,7 @@
 #define DISPLAY_LCD_H
 
 #include "config.h"
+#include <vizfx_canvas.h>
 
 // Only compile LCD code if LCD display is enabled
 #if defined(DISPLAY_LCD_ONLY) || defined(DISPLAY_DUAL)
@@ -158,6 +159,34 @@ struct DisplayProxy {
     }
     _dp_canvas_active = false;
   }
+
+  // Partial updates for a view that leaves its page in the canvas between
+  // frames and only redraws what moved. The canvas persists once allocated.
+  bool canvasPersists() { return _dp_canvas != nullptr; }
+  void readCanvasRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* buf) {
+    if (_dp_canvas) _dp_canvas->readRect(x, y, w, h, buf);
+  }
+  void pushCanvasRect(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* buf) {
+    if (_dp_canvas) _dp_canvas->pushImage(x, y, w, h, buf);
+  }
+  // Like flushCanvas(), but only the given rectangle goes to the display
+  void flushCanvasRect(int32_t x, int32_t y, int32_t w, int32_t h) {
+    if (_dp_canvas && _dp_canvas_active) {
+      M5.Display.setClipRect(x, y, w, h);
+      _dp_canvas->pushSprite(0, 0);
+      M5.Display.clearClipRect();
+    }
+    _dp_canvas_active = false;
+  }
+  // Raw canvas pixels for a sink that writes rows itself: row-major,
+  // LCD_WIDTH wide, RGB565 byte-swapped as the panel takes it. nullptr for
+  // an 8-bit (or missing) canvas.
+  uint16_t* canvasPixels() {
+    return (_dp_canvas && _dp_canvas->getColorDepth() > 8) ? (uint16_t*)_dp_canvas->getBuffer() : nullptr;
+  }
+  // Whether flushCanvas() flips the frame — never on this board
+  bool canvasMirrored() { return false; }
+
   // Pre-allocate the canvas early (before WiFi/tasks fragment the heap).
   // Called once from setup(). Does NOT activate — just reserves the memory.
   void preallocateCanvas() {
@@ -376,6 +405,37 @@ struct DisplayProxy {
     }
     _dp_canvas_active = false;
   }
+
+  // Partial updates for a view that leaves its page in the canvas between
+  // frames and only redraws what moved. The hologram mirror flips the canvas
+  // in place on every flush, so nothing persists while it is on.
+  bool canvasPersists() { return _dp_canvas != nullptr && !hologramMirrorLCD; }
+  void readCanvasRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* buf) {
+    if (_dp_canvas) _dp_canvas->readRect(x, y, w, h, buf);
+  }
+  void pushCanvasRect(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* buf) {
+    if (_dp_canvas) _dp_canvas->pushImage(x, y, w, h, buf);
+  }
+  // Like flushCanvas(), but only the given rectangle goes to the display.
+  // No mirror handling — callers check canvasPersists() first.
+  void flushCanvasRect(int32_t x, int32_t y, int32_t w, int32_t h) {
+    if (_dp_canvas && _dp_canvas_active) {
+      _lcd_display.setClipRect(x, y, w, h);
+      _dp_canvas->pushSprite(0, 0);
+      _lcd_display.clearClipRect();
+    }
+    _dp_canvas_active = false;
+  }
+  // Raw canvas pixels for a sink that writes rows itself: row-major,
+  // LCD_WIDTH wide, RGB565 byte-swapped as the panel takes it. nullptr for
+  // an 8-bit (or missing) canvas.
+  uint16_t* canvasPixels() {
+    return (_dp_canvas && _dp_canvas->getColorDepth() > 8) ? (uint16_t*)_dp_canvas->getBuffer() : nullptr;
+  }
+  // Whether flushCanvas() flips the frame for the hologram prism. A sink
+  // using flushCanvasRect() has to write its rows flipped itself.
+  bool canvasMirrored() { return hologramMirrorLCD; }
+
   // Pre-allocate the canvas early (before WiFi/tasks fragment the heap).
   void preallocateCanvas() {
     beginCanvas();   // allocates sprite
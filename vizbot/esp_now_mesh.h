@@ -3,65 +3,110 @@
 
 #include <Arduino.h>
 #include <esp_now.h>
+#include <esp_timer.h>
 #include <WiFi.h>
 #include "config.h"
+#include "mesh_protocol.h"
 
 // ============================================================================
 // ESP-NOW Local Mesh — Bot-to-Bot Discovery & WLED Coordination
 // ============================================================================
 // Lightweight ESP-NOW mesh for peer discovery and cooperative WLED arbitration.
-// All bots broadcast their state every 3 seconds; peers are cached locally.
+// Wire format and message registry live in mesh_protocol.h. Every bot sends a
+// full state keyframe every 3 seconds, deltas shortly after a discrete field
+// changes, and immediate events for expression changes and WLED/scheduler
+// claims. Peers are cached locally.
 //
-// WLED coordination: Before sending DDP, check meshAnyPeerWledActive().
-// If a peer is active, defer. When starting DDP, call meshSetWledActive(true)
-// which triggers an immediate broadcast so peers learn within ~1ms.
+// WLED coordination: bots sharing a WLED take turns through the lease in
+// wled_lease.h. The WLED-active flag (meshSetWledActive) still goes out as a
+// claim/release event so peers can show who is on the display.
+//
+// Sends share a token bucket (MESH_TX_BURST, MESH_TX_RATE_PER_SEC). A
+// throttled delta or event stays pending and goes out with the next one.
+// Receivers drop peers flooding beyond MESH_RX_MAX_PER_SEC.
 //
 // Thread safety:
 // - meshOnReceive() runs on Core 0 WiFi context (ISR-like, keep fast)
-// - pollMeshBroadcast() runs on Core 0 WiFi task loop
-// - meshAnyPeerWledActive() / meshSetWledActive() called from Core 0
+// - pollMeshBroadcast() and every send run on the Core 0 WiFi task loop
+// - meshSetWledActive() / lease queries called from Core 0
+// - pollMeshPlayAt() / meshFrameDelay() run on Core 1 (render loop)
+//
+// Mesh clock: bots agree on a shared microsecond timebase so a "play at mesh
+// time T" command starts an expression, saying or MIDI sequence on every bot
+// within a few ms. The lowest node id anywhere in the mesh (relayed peers
+// included) is the clock master, so every cell shares one timebase. Exchanges
+// only mean something between direct neighbours: a bot in the master's range
+// runs NTP-style request/response exchanges against it, one further out
+// against the neighbour closest to it (lowest stratum) on the same master,
+// and tracks offset + drift. Play-at stamps carry the master id and are
+// dropped by a bot on another master. Each bot also probes its other
+// neighbours round-robin — the per-peer error report (/bot/mesh), and how it
+// finds a parent when the master is out of range.
 // ============================================================================
 
 // Timing constants
-#define MESH_BROADCAST_INTERVAL_MS 3000   // Normal periodic broadcast
-#define MESH_STALE_TIMEOUT_MS      15000  // Peer expiry (5 missed broadcasts)
-#define MESH_MAX_PEERS             10
+#define MESH_BROADCAST_INTERVAL_MS 3000   // Full state keyframe
+#define MESH_STALE_TIMEOUT_MS      15000  // Peer expiry (5 missed keyframes)
+#define MESH_MAX_PEERS             16     // Peer table in internal RAM
+#define MESH_MAX_PEERS_PSRAM       64     // Peer table when PSRAM is present
+#define MESH_PEER_HASH_SIZE        128    // Power of two, >= 2x MESH_MAX_PEERS_PSRAM
+#define MESH_PEER_SLOT_EMPTY       0xFF
 #define MESH_SCAN_BURST_COUNT      3      // Rapid broadcasts on scan request
 #define MESH_SCAN_BURST_INTERVAL   500    // ms between burst broadcasts
-
-// Protocol version — increment on packet format change
-#define MESH_PROTOCOL_VERSION 1
+#define MESH_DELTA_CHECK_MS        50     // How often discrete state is diffed
+#define MESH_DELTA_MIN_MS          100    // Minimum gap between deltas
+
+// Rate limiting
+#define MESH_TX_BURST              10     // Token bucket depth
+#define MESH_TX_RATE_PER_SEC       20     // Sustained frames/s
+#define MESH_RX_MAX_PER_SEC        50     // Per-peer receive cap
+
+// Relay (multi-hop flooding)
+#define MESH_RELAY_TTL             8      // Forwards a frame may take past its first cell
+#define MESH_RELAY_SEEN_SETS       32     // (origin, seq) duplicate cache, 4-way, power of two
+#define MESH_RELAY_QUEUE           8      // Frames waiting for their forward slot
+#define MESH_RELAY_JITTER_MS       20     // Random forward delay — neighbours don't collide
+#define MESH_RELAY_BURST           10     // Forwarding token bucket, separate from our own sends
+#define MESH_RELAY_RATE_PER_SEC    30
 
 // ============================================================================
-// MeshStatePacket — 30 bytes, packed, broadcast via ESP-NOW
+// Clock Sync & Play-At Payloads
 // ============================================================================
-// Matches plan doc B.1. Contains bot identity, expression, sensors, and flags.
-
-struct __attribute__((packed)) MeshStatePacket {
-  uint8_t  version;        // Protocol version (MESH_PROTOCOL_VERSION)
-  uint8_t  deviceId;       // Last byte of MAC address (unique enough for local mesh)
-  uint8_t  expression;     // Current facial expression index
-  uint8_t  botState;       // BOT_ACTIVE=0, BOT_IDLE=1, etc.
-  uint8_t  battery;        // Battery % (0 for USB-powered, future use)
-  uint8_t  mode;           // Current mode (MODE_BOT=0)
-  uint8_t  effect;         // Current ambient effect index
-  uint8_t  palette;        // Current palette index
+// Timestamps are esp_timer microseconds: t1 is the requester's local clock,
+// t2/t3 are the responder's mesh clock, so one exchange yields the
+// responder's mesh time minus our local time (offset) and the round trip
+// with the responder's hold time removed (rtt). Ids are node ids
+// (meshNodeId), not the one-byte deviceId.
+
+#define MESH_SYNC_FLAG_SYNCED 0x01   // Responder's mesh clock is valid
+#define MESH_SYNC_FLAG_MASTER 0x02   // Responder is the clock master
+
+struct __attribute__((packed)) MeshSyncPayload {
+  uint32_t targetId;       // REQ: who should answer. RESP: who asked
+  uint32_t masterId;       // Sender's clock master
+  uint8_t  flags;          // MESH_SYNC_FLAG_* (RESP only)
+  uint8_t  stratum;        // Sender's sync hops from the master (0 = master)
+  int64_t  t1;             // Requester local send time (echoed back)
+  int64_t  t2;             // Responder mesh time at receive
+  int64_t  t3;             // Responder mesh time at send
+};
 
-  int16_t  pitch;          // Orientation pitch × 100 (degrees)
-  int16_t  roll;           // Orientation roll × 100 (degrees)
-  uint16_t heading;        // Compass heading (0-359, or 0xFFFF if unavailable)
+static_assert(sizeof(MeshSyncPayload) == 34, "MeshSyncPayload must be 34 bytes");
 
-  uint8_t  audioLevel;     // Mic audio level (0-255)
-  uint8_t  proximity;      // Proximity sensor raw (0-255)
-  uint16_t ambientLux;     // Ambient light (lux)
+// Play-at actions
+#define MESH_PLAY_EXPRESSION 0   // arg = expression index
+#define MESH_PLAY_SAY        1   // arg = duration ms, text = phrase
+#define MESH_PLAY_SEQUENCE   2   // arg = MidiSequenceId (Core S3)
 
-  uint8_t  reserved[6];    // reserved[0] bit 0 = wledActive flag
-                           // reserved[0] bit 1 = schedOwner flag
-                           // reserved[1..4] = WLED target IP (4 octets)
-                           // reserved[5] = future use
+struct __attribute__((packed)) MeshPlayAtPayload {
+  uint8_t  action;         // MESH_PLAY_*
+  uint16_t arg;
+  int64_t  atUs;           // Mesh time to start
+  uint32_t masterId;       // Clock master atUs was read from
+  char     text[60];       // MESH_PLAY_SAY only — sent up to the terminator
 };
 
-static_assert(sizeof(MeshStatePacket) == 24, "MeshStatePacket must be 24 bytes");
+#define MESH_PLAY_AT_FIXED (sizeof(MeshPlayAtPayload) - 60)
 
 // ============================================================================
 // MeshPeer — cached peer state
@@ -69,20 +114,55 @@ static_assert(sizeof(MeshStatePacket) == 24, "MeshStatePacket must be 24 bytes")
 
 struct MeshPeer {
   uint8_t          mac[6];
+  uint32_t         nodeId;         // meshNodeId(mac) — unique where deviceId is not
   uint8_t          deviceId;
-  MeshStatePacket  lastPacket;
+  MeshState        state;          // Keyframe + deltas + events applied
+  bool             hasState;       // At least one keyframe received
+  uint16_t         lastSeq;
+  bool             seqKnown;       // lastSeq set by a frame from this peer
   unsigned long    lastSeenMs;
   bool             active;
+  uint8_t          hops;           // Relays between us on the last first-seen frame (0 = direct)
+
+  // Receive accounting
+  uint32_t         rxLost;         // Sequence gaps
+  unsigned long    rxWindowMs;     // Start of the current 1s rate window
+  uint8_t          rxWindowCount;
+
+  // Mesh clock error as measured by our last exchange with this peer
+  int32_t          clockErrUs;     // Peer mesh time minus ours
+  uint32_t         clockRttUs;     // Round trip, responder hold time removed
+  unsigned long    clockSeenMs;    // 0 = never measured
+  bool             clockSynced;    // Peer reported a valid mesh clock
+  uint32_t         clockMaster;    // Peer's clock master, as of clockSeenMs
+  uint8_t          clockStratum;   // Peer's sync hops from that master
 };
 
 // ============================================================================
-// MeshData — static mesh state (~460 bytes BSS)
+// MeshData — static mesh state
 // ============================================================================
 
+static MeshPeer meshPeerTable[MESH_MAX_PEERS];   // Used when PSRAM isn't available
+
 static struct {
-  MeshPeer      peers[MESH_MAX_PEERS];
+  // Peer table: dense array + open-addressing MAC hash (slot = peer index)
+  MeshPeer*     peers;
+  uint8_t       peerCapacity;
   uint8_t       peerCount;
+  uint8_t       peerHash[MESH_PEER_HASH_SIZE];
+
+  // Per-WLED-IP index for the lease / scheduler queries — counts kept up to
+  // date as peer state changes, so each query is a couple of loads
+  uint32_t      indexIP;           // IP the counts below refer to
+  uint8_t       ipPeers;
+  uint8_t       ipWledActive;
+  uint8_t       ipSchedOwner;
+  uint32_t      ipLowestId;        // Lowest node id on indexIP (lease arbiter), 0 = none
+  bool          ipLowestStale;     // That peer left — rescan on the next query
+
   uint8_t       myDeviceId;
+  uint8_t       myMac[6];          // Source address of our frames (AP interface)
+  uint32_t      myNodeId;
   bool          initialized;
   bool          wledActive;        // Are WE currently sending DDP?
   bool          schedOwner;        // Are WE the scheduled content owner?
@@ -92,8 +172,198 @@ static struct {
   // Scan burst state
   uint8_t       scanBurstRemaining;
   unsigned long scanBurstNextMs;
+
+  // Sender side
+  uint16_t      txSeq;
+  MeshState     sentState;         // What peers believe our state is
+  unsigned long lastDeltaCheckMs;
+  unsigned long lastDeltaMs;
+  uint8_t       txTokens;
+  unsigned long txRefillMs;
+
+  // Stats
+  uint32_t      txFrames;
+  uint32_t      txThrottled;       // Sends refused by the token bucket
+  uint32_t      rxFrames;
+  uint32_t      rxRejected;        // Failed meshDecode()
+  uint32_t      rxThrottled;       // Dropped by the per-peer rate cap
+  uint32_t      rxDuplicates;      // Copies of frames already seen (relay)
 } meshData = {};
 
+// ============================================================================
+// MeshClock — offset/drift to the clock master
+// ============================================================================
+
+#define MESH_CLOCK_INTERVAL_MS   1000    // Exchange period once synced
+#define MESH_CLOCK_FAST_MS       200     // Exchange period while acquiring
+#define MESH_CLOCK_WINDOW        8       // Samples kept for the min-delay filter
+#define MESH_CLOCK_MIN_SAMPLES   4       // Samples before we call ourselves synced
+#define MESH_CLOCK_STEP_US       20000   // Residual that forces a step instead of a slew
+#define MESH_CLOCK_PHASE_GAIN    0.7f
+#define MESH_CLOCK_FREQ_GAIN     0.1f    // Gentle — each stratum would amplify its parent's wander
+#define MESH_CLOCK_MAX_PPM       200.0f  // ESP32 crystals are ±10-40ppm
+#define MESH_CLOCK_MAX_STRATUM   16      // Sync hops from the master; >= this = unsynced
+#define MESH_SYNC_REPLY_SLOTS    4
+
+struct MeshClockSample {
+  int64_t  localUs;    // Local midpoint of the exchange
+  int64_t  offsetUs;   // Master mesh time minus local time
+  uint32_t rttUs;
+};
+
+static struct {
+  // Correction model: mesh = local + offsetUs + driftPpm * (local - refLocalUs)
+  int64_t         offsetUs;
+  int64_t         refLocalUs;
+  float           driftPpm;
+  uint32_t        masterId;      // Node id — lowest in the mesh
+  uint32_t        parentId;      // Neighbour we sync to (master, or closer to it); 0 = none
+  uint8_t         stratum;       // Parent's stratum + 1, 0 on the master
+  bool            synced;
+  uint8_t         samples;       // Accepted samples since the master last changed
+
+  MeshClockSample window[MESH_CLOCK_WINDOW];
+  uint8_t         windowCount;
+  uint8_t         windowIdx;
+  int64_t         lastAppliedUs; // localUs of the last sample fed to the model
+
+  uint32_t        lastRttUs;
+  int32_t         lastResidualUs;
+  unsigned long   nextExchangeMs;
+  uint8_t         probeIdx;      // Round-robin over the other neighbours
+
+  // Requests waiting for a reply — filled by meshOnReceive, sent by poll
+  struct { uint32_t requester; int64_t t1; int64_t t2; } replies[MESH_SYNC_REPLY_SLOTS];
+  volatile uint8_t replyHead;
+  volatile uint8_t replyTail;
+} meshClock = {};
+
+// Model is updated from the WiFi task and read from both cores; int64 loads
+// aren't atomic on the LX7, so reads and updates go through a spinlock.
+static portMUX_TYPE meshClockMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Caller holds meshClockMux
+static inline int64_t meshClockCorrectionLocked(int64_t localUs) {
+  return meshClock.offsetUs +
+         (int64_t)(meshClock.driftPpm * (float)(localUs - meshClock.refLocalUs) * 1e-6f);
+}
+
+// Mesh time for a given local esp_timer time
+int64_t meshTimeAt(int64_t localUs) {
+  portENTER_CRITICAL(&meshClockMux);
+  int64_t t = localUs + meshClockCorrectionLocked(localUs);
+  portEXIT_CRITICAL(&meshClockMux);
+  return t;
+}
+
+int64_t meshTimeUs() {
+  return meshTimeAt(esp_timer_get_time());
+}
+
+// Local esp_timer time at which the mesh clock reads meshUs
+int64_t meshToLocalUs(int64_t meshUs) {
+  portENTER_CRITICAL(&meshClockMux);
+  int64_t local = meshUs - meshClockCorrectionLocked(meshUs - meshClock.offsetUs);
+  portEXIT_CRITICAL(&meshClockMux);
+  return local;
+}
+
+bool meshClockSynced() {
+  return meshClock.synced;
+}
+
+bool meshIsClockMaster() {
+  return meshClock.masterId == meshData.myNodeId;
+}
+
+// Forget the model (new master, or we became master). A new parent on the
+// same master keeps it — same timebase.
+static void meshClockReset(uint32_t masterId) {
+  portENTER_CRITICAL(&meshClockMux);
+  meshClock.masterId = masterId;
+  meshClock.parentId = 0;
+  meshClock.offsetUs = 0;
+  meshClock.driftPpm = 0;
+  meshClock.refLocalUs = esp_timer_get_time();
+  meshClock.samples = 0;
+  meshClock.windowCount = 0;
+  meshClock.windowIdx = 0;
+  meshClock.lastAppliedUs = 0;
+  meshClock.lastResidualUs = 0;
+  meshClock.synced = (masterId == meshData.myNodeId);  // Master's mesh time = local time
+  meshClock.stratum = meshClock.synced ? 0 : MESH_CLOCK_MAX_STRATUM;
+  portEXIT_CRITICAL(&meshClockMux);
+}
+
+// Feed one exchange with our parent. Keeps a small window and only uses the
+// lowest-delay sample (queueing delay only ever adds error), then slews the
+// offset and trims drift from the residual — a minimal NTP-style discipline.
+static void meshClockAddSample(int64_t localUs, int64_t offsetUs, uint32_t rttUs) {
+  portENTER_CRITICAL(&meshClockMux);
+  meshClock.window[meshClock.windowIdx] = { localUs, offsetUs, rttUs };
+  meshClock.windowIdx = (meshClock.windowIdx + 1) % MESH_CLOCK_WINDOW;
+  if (meshClock.windowCount < MESH_CLOCK_WINDOW) meshClock.windowCount++;
+  meshClock.lastRttUs = rttUs;
+
+  const MeshClockSample* best = &meshClock.window[0];
+  for (uint8_t i = 1; i < meshClock.windowCount; i++) {
+    if (meshClock.window[i].rttUs < best->rttUs) best = &meshClock.window[i];
+  }
+
+  if (best->localUs > meshClock.lastAppliedUs) {
+    if (meshClock.samples == 0) {
+      meshClock.offsetUs = best->offsetUs;
+      meshClock.refLocalUs = best->localUs;
+      meshClock.lastResidualUs = 0;
+    } else {
+      int64_t predicted = meshClockCorrectionLocked(best->localUs);
+      int64_t residual = best->offsetUs - predicted;
+      if (residual > MESH_CLOCK_STEP_US || residual < -MESH_CLOCK_STEP_US) {
+        meshClock.offsetUs = best->offsetUs;       // Step
+        meshClock.driftPpm = 0;
+      } else {
+        float dt = (float)(best->localUs - meshClock.refLocalUs);
+        meshClock.driftPpm += MESH_CLOCK_FREQ_GAIN * (float)residual / dt * 1e6f;
+        meshClock.driftPpm = constrain(meshClock.driftPpm, -MESH_CLOCK_MAX_PPM, MESH_CLOCK_MAX_PPM);
+        meshClock.offsetUs = predicted + (int64_t)(MESH_CLOCK_PHASE_GAIN * (float)residual);
+      }
+      meshClock.refLocalUs = best->localUs;
+      meshClock.lastResidualUs = (int32_t)residual;
+    }
+    meshClock.lastAppliedUs = best->localUs;
+    if (meshClock.samples < 255) meshClock.samples++;
+    if (meshClock.samples >= MESH_CLOCK_MIN_SAMPLES) meshClock.synced = true;
+  }
+  portEXIT_CRITICAL(&meshClockMux);
+}
+
+// ============================================================================
+// Play-At Queue — mesh packets (Core 0) -> render loop (Core 1)
+// ============================================================================
+
+#define MESH_PLAY_QUEUE_SIZE  4
+#define MESH_PLAY_LATE_MS     250    // Arrived this late = drop rather than play out of step
+#define MESH_PLAY_EARLY_US    500    // Fire when within this of the due time
+#define MESH_PLAY_MAX_AHEAD_MS 12000  // /bot/mesh/play caps lead at 10s; further out = bad stamp
+
+struct MeshPlayAction {
+  int64_t  localUs;       // Due time on our esp_timer clock
+  uint8_t  action;
+  uint16_t arg;
+  char     text[60];
+};
+
+static QueueHandle_t meshPlayQueue = nullptr;
+static esp_timer_handle_t meshPlayTimer = nullptr;
+static TaskHandle_t meshLoopTask = nullptr;
+static uint32_t meshPlayLateDrops = 0;
+static uint32_t meshPlayRejected = 0;   // Unsynced clock or stamp too far ahead
+
+// Wakes the render loop out of meshFrameDelay() right at the due time
+static void meshPlayTimerCb(void*) {
+  if (meshLoopTask) xTaskNotifyGive(meshLoopTask);
+}
+
 // ============================================================================
 // Forward declarations — externs from other headers
 // ============================================================================
@@ -109,129 +379,536 @@ extern volatile bool meshScanRequested;
 extern uint32_t wledGetIPAsU32();
 
 // ============================================================================
-// Packet Builder
+// State Builder
 // ============================================================================
 
-static void meshBuildPacket(MeshStatePacket& pkt) {
-  memset(&pkt, 0, sizeof(pkt));
-  pkt.version   = MESH_PROTOCOL_VERSION;
-  pkt.deviceId  = meshData.myDeviceId;
-  pkt.expression = getBotExpression();
-  pkt.botState  = getBotState();
-  pkt.battery   = 0;  // USB-powered, no battery monitoring yet
-  pkt.mode      = 0;  // MODE_BOT
-  pkt.effect    = effectIndex;
-  pkt.palette   = paletteIndex;
+static void meshBuildState(MeshState& st) {
+  memset(&st, 0, sizeof(st));
+  st.expression = getBotExpression();
+  st.botState   = getBotState();
+  st.battery    = 0;  // USB-powered, no battery monitoring yet
+  st.mode       = 0;  // MODE_BOT
+  st.effect     = effectIndex;
+  st.palette    = paletteIndex;
 
   // Orientation from accelerometer (pitch/roll in degrees × 100)
   if (sysStatus.imuReady) {
     float pitch = atan2(-accelX, sqrt(accelY * accelY + accelZ * accelZ)) * 57.2958f;
     float roll  = atan2(accelY, accelZ) * 57.2958f;
-    pkt.pitch = (int16_t)(pitch * 100);
-    pkt.roll  = (int16_t)(roll * 100);
+    st.pitch = (int16_t)(pitch * 100);
+    st.roll  = (int16_t)(roll * 100);
   }
-  pkt.heading = 0xFFFF;  // No magnetometer
+  st.heading = 0xFFFF;  // No magnetometer
 
   // Core S3 sensors
   #ifdef TARGET_CORES3
   if (sysStatus.proxLightReady) {
     extern struct ProxLightState proxLight;
-    pkt.proximity  = (uint8_t)min((uint16_t)255, proxLight.rawProximity);
-    pkt.ambientLux = proxLight.ambientLux;
+    st.proximity  = (uint8_t)min((uint16_t)255, proxLight.rawProximity);
+    st.ambientLux = proxLight.ambientLux;
   }
   if (sysStatus.micReady) {
     extern struct AudioAnalysis audioAnalysis;
-    pkt.audioLevel = (uint8_t)(constrain(audioAnalysis.smoothLevel * 255.0f, 0.0f, 255.0f));
+    st.audioLevel = (uint8_t)(constrain(audioAnalysis.smoothLevel * 255.0f, 0.0f, 255.0f));
   }
   #endif
 
-  // WLED active flag in reserved[0] bit 0
-  if (meshData.wledActive) {
-    pkt.reserved[0] |= 0x01;
-  }
-
-  // Scheduler owner flag in reserved[0] bit 1
-  if (meshData.schedOwner) {
-    pkt.reserved[0] |= 0x02;
-  }
-
-  // WLED target IP in reserved[1..4]
-  uint32_t wledIP = wledGetIPAsU32();
-  pkt.reserved[1] = (wledIP >> 24) & 0xFF;
-  pkt.reserved[2] = (wledIP >> 16) & 0xFF;
-  pkt.reserved[3] = (wledIP >> 8)  & 0xFF;
-  pkt.reserved[4] = wledIP & 0xFF;
+  if (meshData.wledActive) st.flags |= MESH_STATE_WLED_ACTIVE;
+  if (meshData.schedOwner) st.flags |= MESH_STATE_SCHED_OWNER;
+  st.wledIP = wledGetIPAsU32();
 }
 
 // ============================================================================
 // Peer Cache Management
 // ============================================================================
 
+// Receive path and the WiFi task both touch the table; eviction reorders it
+static portMUX_TYPE meshPeerMux = portMUX_INITIALIZER_UNLOCKED;
+
+static inline uint8_t meshMacHash(const uint8_t* mac) {
+  uint32_t h = meshNodeId(mac);
+  return (h ^ (h >> 16)) & (MESH_PEER_HASH_SIZE - 1);
+}
+
 // Find peer by MAC, returns index or -1
-static int8_t meshFindPeer(const uint8_t* mac) {
-  for (uint8_t i = 0; i < meshData.peerCount; i++) {
-    if (memcmp(meshData.peers[i].mac, mac, 6) == 0) {
-      return i;
-    }
+static int16_t meshFindPeer(const uint8_t* mac) {
+  uint8_t h = meshMacHash(mac);
+  for (uint8_t probe = 0; probe < MESH_PEER_HASH_SIZE; probe++) {
+    uint8_t slot = meshData.peerHash[h];
+    if (slot == MESH_PEER_SLOT_EMPTY) return -1;
+    if (memcmp(meshData.peers[slot].mac, mac, 6) == 0) return slot;
+    h = (h + 1) & (MESH_PEER_HASH_SIZE - 1);
   }
   return -1;
 }
 
-// Update existing peer or add new one
-static void meshUpsertPeer(const uint8_t* mac, const MeshStatePacket& pkt) {
-  int8_t idx = meshFindPeer(mac);
+static void meshHashInsert(uint8_t idx) {
+  uint8_t h = meshMacHash(meshData.peers[idx].mac);
+  while (meshData.peerHash[h] != MESH_PEER_SLOT_EMPTY) {
+    h = (h + 1) & (MESH_PEER_HASH_SIZE - 1);
+  }
+  meshData.peerHash[h] = idx;
+}
 
+// Linear probing has no cheap delete — rebuild after evictions (rare)
+static void meshRebuildHash() {
+  memset(meshData.peerHash, MESH_PEER_SLOT_EMPTY, sizeof(meshData.peerHash));
+  for (uint8_t i = 0; i < meshData.peerCount; i++) meshHashInsert(i);
+}
+
+// Add (dir = 1) or remove (dir = -1) a peer's share of the per-IP index.
+// Caller holds meshPeerMux.
+static void meshIndexPeer(const MeshPeer& p, int8_t dir) {
+  if (meshData.indexIP == 0 || p.state.wledIP != meshData.indexIP) return;
+  meshData.ipPeers += dir;
+  if (p.state.flags & MESH_STATE_WLED_ACTIVE) meshData.ipWledActive += dir;
+  if (p.state.flags & MESH_STATE_SCHED_OWNER) meshData.ipSchedOwner += dir;
+  // Lowest node id: a peer at or below the cached one is the new minimum
+  // (that also covers the lowest re-adding itself after a state update);
+  // only losing the lowest needs a walk
+  if (dir > 0) {
+    if (meshData.ipLowestId == 0 || p.nodeId <= meshData.ipLowestId) {
+      meshData.ipLowestId = p.nodeId;
+      meshData.ipLowestStale = false;
+    }
+  } else if (p.nodeId == meshData.ipLowestId) {
+    meshData.ipLowestStale = true;
+  }
+}
+
+// Our WLED IP changed — recount from scratch
+static void meshReindexIP(uint32_t ip) {
+  portENTER_CRITICAL(&meshPeerMux);
+  meshData.indexIP = ip;
+  meshData.ipPeers = 0;
+  meshData.ipWledActive = 0;
+  meshData.ipSchedOwner = 0;
+  meshData.ipLowestId = 0;
+  meshData.ipLowestStale = false;
+  for (uint8_t i = 0; i < meshData.peerCount; i++) meshIndexPeer(meshData.peers[i], 1);
+  portEXIT_CRITICAL(&meshPeerMux);
+}
+
+static inline void meshCheckIndexIP(uint32_t ip) {
+  if (ip != meshData.indexIP) meshReindexIP(ip);
+}
+
+// Find or add the sender of a frame. Returns index or -1 if the table is full.
+static int16_t meshTouchPeer(const uint8_t* mac, uint8_t deviceId) {
+  portENTER_CRITICAL(&meshPeerMux);
+  int16_t idx = meshFindPeer(mac);
   if (idx >= 0) {
-    // Update existing
-    meshData.peers[idx].lastPacket = pkt;
     meshData.peers[idx].lastSeenMs = millis();
     meshData.peers[idx].active = true;
-    return;
+    portEXIT_CRITICAL(&meshPeerMux);
+    return idx;
   }
 
-  // Add new peer
-  if (meshData.peerCount < MESH_MAX_PEERS) {
-    MeshPeer& p = meshData.peers[meshData.peerCount];
-    memcpy(p.mac, mac, 6);
-    p.deviceId   = pkt.deviceId;
-    p.lastPacket = pkt;
-    p.lastSeenMs = millis();
-    p.active     = true;
-    meshData.peerCount++;
-
-    DBG("Mesh: new peer 0x");
-    if (pkt.deviceId < 0x10) DBG("0");
-    DBGLN(String(pkt.deviceId, HEX));
+  if (meshData.peerCount >= meshData.peerCapacity) {
+    portEXIT_CRITICAL(&meshPeerMux);
+    return -1;
   }
+
+  idx = meshData.peerCount;
+  MeshPeer& p = meshData.peers[idx];
+  memset(&p, 0, sizeof(p));
+  memcpy(p.mac, mac, 6);
+  p.nodeId     = meshNodeId(mac);
+  p.deviceId   = deviceId;
+  p.lastSeenMs = millis();
+  p.rxWindowMs = p.lastSeenMs;
+  p.active     = true;
+  meshData.peerCount++;
+  meshHashInsert(idx);   // No state yet, so nothing for the per-IP index
+  portEXIT_CRITICAL(&meshPeerMux);
+
+  DBG("Mesh: new peer 0x");
+  if (deviceId < 0x10) DBG("0");
+  DBGLN(String(deviceId, HEX));
+  return idx;
 }
 
-// Remove stale peers not seen within MESH_STALE_TIMEOUT_MS
-static void meshEvictStale() {
+// Remove stale peers not seen within MESH_STALE_TIMEOUT_MS. Returns how many.
+static uint8_t meshEvictStale() {
   unsigned long now = millis();
+  uint8_t evicted = 0;
+  portENTER_CRITICAL(&meshPeerMux);
   for (uint8_t i = 0; i < meshData.peerCount; ) {
-    if (meshData.peers[i].active &&
-        (now - meshData.peers[i].lastSeenMs) > MESH_STALE_TIMEOUT_MS) {
-      DBG("Mesh: peer 0x");
-      if (meshData.peers[i].deviceId < 0x10) DBG("0");
-      DBG(String(meshData.peers[i].deviceId, HEX));
-      DBGLN(" stale, evicted");
-
-      // Shift remaining peers down
-      for (uint8_t j = i; j < meshData.peerCount - 1; j++) {
-        meshData.peers[j] = meshData.peers[j + 1];
-      }
+    MeshPeer& p = meshData.peers[i];
+    if (p.active && (now - p.lastSeenMs) > MESH_STALE_TIMEOUT_MS) {
+      meshIndexPeer(p, -1);
+      // Move the last peer into the hole — order doesn't matter, the hash does
       meshData.peerCount--;
-      // Don't increment i — check shifted element
+      if (i != meshData.peerCount) p = meshData.peers[meshData.peerCount];
+      evicted++;
+      // Don't increment i — check the moved element
     } else {
       i++;
     }
   }
+  if (evicted) meshRebuildHash();
+  portEXIT_CRITICAL(&meshPeerMux);
+
+  if (evicted) {
+    DBG("Mesh: evicted ");
+    DBG(evicted);
+    DBGLN(" stale peer(s)");
+  }
+  return evicted;
+}
+
+// ============================================================================
+// Message Handlers — registered in initMesh()
+// ============================================================================
+// All run in meshOnReceive() context after the sender was found/added in the
+// peer table, so meshFindPeer() succeeds unless the table is full.
+
+// State changes go through the per-IP index: take the peer's old share out,
+// apply, put the new share back.
+
+static void meshOnState(const uint8_t* mac, const MeshHeader& hdr,
+                        const uint8_t* payload, uint8_t len, int64_t rxUs) {
+  portENTER_CRITICAL(&meshPeerMux);
+  int16_t idx = meshFindPeer(mac);
+  if (idx >= 0) {
+    MeshPeer& p = meshData.peers[idx];
+    meshIndexPeer(p, -1);
+    memcpy(&p.state, payload, sizeof(MeshState));
+    p.hasState = true;
+    meshIndexPeer(p, 1);
+  }
+  portEXIT_CRITICAL(&meshPeerMux);
+}
+
+static void meshOnDelta(const uint8_t* mac, const MeshHeader& hdr,
+                        const uint8_t* payload, uint8_t len, int64_t rxUs) {
+  bool ok = true;
+  portENTER_CRITICAL(&meshPeerMux);
+  int16_t idx = meshFindPeer(mac);
+  if (idx >= 0) {
+    MeshPeer& p = meshData.peers[idx];
+    meshIndexPeer(p, -1);
+    ok = meshApplyDelta(p.state, payload, len);
+    meshIndexPeer(p, 1);
+  }
+  portEXIT_CRITICAL(&meshPeerMux);
+  if (!ok) meshData.rxRejected++;
+}
+
+static void meshOnEvent(const uint8_t* mac, const MeshHeader& hdr,
+                        const uint8_t* payload, uint8_t len, int64_t rxUs) {
+  MeshEvent ev;
+  memcpy(&ev, payload, sizeof(ev));
+  bool ok = true;
+  portENTER_CRITICAL(&meshPeerMux);
+  int16_t idx = meshFindPeer(mac);
+  if (idx >= 0) {
+    MeshPeer& p = meshData.peers[idx];
+    meshIndexPeer(p, -1);
+    ok = meshApplyEvent(p.state, ev);
+    meshIndexPeer(p, 1);
+  }
+  portEXIT_CRITICAL(&meshPeerMux);
+  if (!ok) meshData.rxRejected++;
+}
+
+// Someone asked us for the time — stamp t2 now, reply from pollMeshBroadcast()
+static void meshOnSyncRequest(const uint8_t* mac, const MeshHeader& hdr,
+                              const uint8_t* payload, uint8_t len, int64_t rxUs) {
+  MeshSyncPayload req;
+  memcpy(&req, payload, sizeof(req));
+  if (req.targetId != meshData.myNodeId) return;
+  uint8_t head = meshClock.replyHead;
+  uint8_t next = (head + 1) % MESH_SYNC_REPLY_SLOTS;
+  if (next == meshClock.replyTail) return;  // Full — requester will retry
+  meshClock.replies[head].requester = meshNodeId(mac);   // Not relayed — mac is the requester
+  meshClock.replies[head].t1 = req.t1;
+  meshClock.replies[head].t2 = meshTimeAt(rxUs);
+  meshClock.replyHead = next;
+}
+
+static void meshOnSyncResponse(const uint8_t* mac, const MeshHeader& hdr,
+                               const uint8_t* payload, uint8_t len, int64_t t4) {
+  MeshSyncPayload resp;
+  memcpy(&resp, payload, sizeof(resp));
+  if (resp.targetId != meshData.myNodeId) return;
+
+  int64_t offset = ((resp.t2 - resp.t1) + (resp.t3 - t4)) / 2;
+  int64_t rtt = (t4 - resp.t1) - (resp.t3 - resp.t2);
+  if (rtt < 0) rtt = 0;
+  int64_t mid = resp.t1 + (t4 - resp.t1) / 2;
+
+  // Only the parent disciplines our clock, and only while it runs on our
+  // master's timebase — a parent mid-switch would drag us onto its old one
+  uint32_t from = meshNodeId(mac);
+  if (from == meshClock.parentId && (resp.flags & MESH_SYNC_FLAG_SYNCED) &&
+      resp.masterId == meshClock.masterId && resp.stratum + 1 < MESH_CLOCK_MAX_STRATUM) {
+    meshClockAddSample(mid, offset, (uint32_t)rtt);
+    if (meshClock.synced) meshClock.stratum = resp.stratum + 1;
+  }
+
+  // Per-peer report: peer's mesh clock vs ours at the same instant
+  int16_t idx = meshFindPeer(mac);
+  if (idx >= 0) {
+    MeshPeer& p = meshData.peers[idx];
+    p.clockErrUs  = (int32_t)(mid + offset - meshTimeAt(mid));
+    p.clockRttUs  = (uint32_t)rtt;
+    p.clockSeenMs = millis();
+    p.clockSynced = (resp.flags & MESH_SYNC_FLAG_SYNCED) != 0;
+    p.clockMaster = resp.masterId;
+    p.clockStratum = resp.stratum;
+  }
+}
+
+static void meshOnPlayAt(const uint8_t* mac, const MeshHeader& hdr,
+                         const uint8_t* payload, uint8_t len, int64_t rxUs) {
+  if (meshPlayQueue == nullptr) return;
+  MeshPlayAtPayload pkt;
+  memcpy(&pkt, payload, len);
+  // Without a synced clock on the sender's master the stamp means nothing
+  // here (a partition heals, a relayed frame from a cell that hasn't
+  // converged yet), and a stamp far in the future would sit in the pending
+  // slots and starve real actions
+  if (!meshClockSynced() || pkt.masterId != meshClock.masterId ||
+      pkt.atUs - meshTimeAt(rxUs) > (int64_t)MESH_PLAY_MAX_AHEAD_MS * 1000) {
+    meshPlayRejected++;
+    return;
+  }
+  MeshPlayAction act;
+  act.localUs = meshToLocalUs(pkt.atUs);
+  act.action  = pkt.action;
+  act.arg     = pkt.arg;
+  int textLen = min((int)len - (int)MESH_PLAY_AT_FIXED, (int)sizeof(act.text) - 1);
+  memcpy(act.text, pkt.text, textLen);
+  act.text[textLen] = '\0';
+  xQueueSend(meshPlayQueue, &act, 0);
+}
+
+// ============================================================================
+// Relay — multi-hop flooding for installations bigger than one radio cell
+// ============================================================================
+// Every first-seen frame of a MESH_RELAY_TYPES type is re-broadcast once,
+// wrapped in a MESH_MSG_RELAY envelope that carries the origin MAC, a TTL
+// and a hop count. Copies are recognised by (origin node id, origin seq);
+// the one-byte deviceId in the header isn't unique in a big mesh. Each
+// forward waits a random 0-MESH_RELAY_JITTER_MS so neighbours that heard
+// the same frame don't transmit together, and lists our direct neighbours.
+// A queued forward is dropped once every one of our direct neighbours was
+// covered by the copies heard meanwhile (it sent one, or a sender listed it)
+// — in a dense cell most nodes stay quiet, while the one bot bridging to the
+// next cell still forwards, however many copies it heard. A token bucket
+// bounds forwarding airtime.
+
+static_assert(MESH_MAX_PEERS_PSRAM <= 64, "Relay coverage is a 64-bit peer index mask");
+
+struct MeshRelaySlot {
+  unsigned long dueMs;
+  uint32_t      origin;            // Origin (node id, seq), for duplicate counting
+  uint16_t      seq;
+  uint64_t      uncovered;         // Direct neighbours (peer index bits) no copy reached yet
+  uint8_t       len;               // 0 = free
+  uint8_t       payload[MESH_MAX_FRAME - sizeof(MeshHeader)];  // MeshRelayHeader + frame
+};
+
+static struct {
+  uint64_t      seen[MESH_RELAY_SEEN_SETS][4];   // origin << 16 | seq (origin != 0)
+  uint8_t       seenNext[MESH_RELAY_SEEN_SETS];  // Round-robin victim per set
+  MeshRelaySlot slots[MESH_RELAY_QUEUE];
+  uint16_t      seq;               // Outer header seq — relays don't use txSeq
+  uint8_t       tokens;
+  unsigned long refillMs;
+
+  // Stats
+  uint32_t      forwarded;
+  uint32_t      suppressed;        // Every neighbour covered, forward cancelled
+  uint32_t      dropped;           // Queue full or over the rate limit
+} meshRelay = {};
+
+static portMUX_TYPE meshRelayMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Set-associative so frames in flight at the same time don't evict each
+// other — a forgotten frame would be flooded again for its remaining TTL
+static inline uint8_t meshRelaySeenSet(uint32_t origin, uint16_t seq) {
+  return (seq + (origin ^ (origin >> 16)) * 37) & (MESH_RELAY_SEEN_SETS - 1);
+}
+
+// Our direct neighbours (bit = peer index) a copy sent by `from` reached:
+// the sender, the origin and every neighbour the sender listed
+static uint64_t meshRelayCovered(const uint8_t* from, const uint8_t* origin,
+                                 const uint8_t* nbr, uint8_t nbrCount) {
+  uint64_t covered = 0;
+  portENTER_CRITICAL(&meshPeerMux);
+  int16_t idx = meshFindPeer(from);
+  if (idx >= 0) covered |= 1ULL << idx;
+  idx = meshFindPeer(origin);
+  if (idx >= 0) covered |= 1ULL << idx;
+  for (uint8_t i = 0; i < meshData.peerCount && nbrCount > 0; i++) {
+    const MeshPeer& p = meshData.peers[i];
+    if (!p.active || p.hops != 0) continue;
+    uint16_t id = meshShortId(p.nodeId);
+    for (uint8_t k = 0; k < nbrCount; k++) {
+      uint16_t listed;
+      memcpy(&listed, nbr + 2 * k, 2);
+      if (listed == id) {
+        covered |= 1ULL << i;
+        break;
+      }
+    }
+  }
+  portEXIT_CRITICAL(&meshPeerMux);
+  return covered;
+}
+
+// Peer indices moved (eviction) — waiting forwards can't trust their masks
+static void meshRelayForgetCoverage() {
+  portENTER_CRITICAL(&meshRelayMux);
+  for (uint8_t i = 0; i < MESH_RELAY_QUEUE; i++) meshRelay.slots[i].uncovered = ~0ULL;
+  portEXIT_CRITICAL(&meshRelayMux);
+}
+
+// Record (origin, seq). False if it was already seen — the caller drops it,
+// after its coverage is taken off any forward still waiting.
+static bool meshRelayFirstSeen(uint32_t origin, uint16_t seq, uint64_t covered) {
+  uint64_t key = ((uint64_t)origin << 16) | seq;
+  uint8_t set = meshRelaySeenSet(origin, seq);
+  uint64_t* ways = meshRelay.seen[set];
+  portENTER_CRITICAL(&meshRelayMux);
+  bool first = ways[0] != key && ways[1] != key && ways[2] != key && ways[3] != key;
+  if (first) {
+    ways[meshRelay.seenNext[set]] = key;
+    meshRelay.seenNext[set] = (meshRelay.seenNext[set] + 1) & 3;
+  } else {
+    for (uint8_t i = 0; i < MESH_RELAY_QUEUE; i++) {
+      MeshRelaySlot& q = meshRelay.slots[i];
+      if (q.len && q.origin == origin && q.seq == seq) q.uncovered &= ~covered;
+    }
+  }
+  portEXIT_CRITICAL(&meshRelayMux);
+  if (!first) meshData.rxDuplicates++;
+  return first;
+}
+
+// Queue one forward of frame (origin header + payload) heard `hops` relays
+// from its origin, with `ttl` forwards left including this one. `covered` =
+// neighbours the copy we heard already reached.
+static void meshRelayQueue(const uint8_t* origin, uint8_t hops, uint8_t ttl,
+                           const uint8_t* frame, int len, uint64_t covered) {
+  if (ttl == 0) return;
+  if (len + sizeof(MeshRelayHeader) > sizeof(MeshRelaySlot::payload)) return;
+
+  uint64_t direct = 0;
+  portENTER_CRITICAL(&meshPeerMux);
+  for (uint8_t i = 0; i < meshData.peerCount; i++) {
+    const MeshPeer& p = meshData.peers[i];
+    if (p.active && p.hops == 0) direct |= 1ULL << i;
+  }
+  portEXIT_CRITICAL(&meshPeerMux);
+  if ((direct & ~covered) == 0) {
+    meshRelay.suppressed++;   // Nobody in range still needs it
+    return;
+  }
+
+  MeshHeader hdr;
+  memcpy(&hdr, frame, sizeof(hdr));
+  MeshRelayHeader rh;
+  rh.ttl  = ttl - 1;
+  rh.hops = hops + 1;
+  memcpy(rh.origin, origin, 6);
+  rh.nbrCount = 0;                 // Filled in when it goes out
+
+  bool queued = false;
+  portENTER_CRITICAL(&meshRelayMux);
+  for (uint8_t i = 0; i < MESH_RELAY_QUEUE; i++) {
+    MeshRelaySlot& q = meshRelay.slots[i];
+    if (q.len) continue;
+    q.dueMs    = millis() + random(0, MESH_RELAY_JITTER_MS + 1);
+    q.origin   = meshNodeId(origin);
+    q.seq      = hdr.seq;
+    q.uncovered = direct & ~covered;
+    memcpy(q.payload, &rh, sizeof(rh));
+    memcpy(q.payload + sizeof(rh), frame, len);
+    q.len      = sizeof(rh) + len;
+    queued = true;
+    break;
+  }
+  portEXIT_CRITICAL(&meshRelayMux);
+  if (!queued) meshRelay.dropped++;
+}
+
+// Per-peer flood guard. False = over MESH_RX_MAX_PER_SEC, drop the frame.
+static bool meshPeerAdmit(MeshPeer& p) {
+  unsigned long now = millis();
+  if (now - p.rxWindowMs >= 1000) {
+    p.rxWindowMs = now;
+    p.rxWindowCount = 0;
+  }
+  if (++p.rxWindowCount > MESH_RX_MAX_PER_SEC) {
+    meshData.rxThrottled++;
+    return false;
+  }
+  return true;
+}
+
+// Sequence gaps = lost frames. With relays a frame can arrive after its
+// successor over a longer path; that fills a gap we already counted.
+static void meshPeerCountSeq(MeshPeer& p, uint16_t seq) {
+  if (!p.seqKnown) {
+    p.lastSeq = seq;
+    p.seqKnown = true;
+    return;
+  }
+  int16_t step = (int16_t)(seq - p.lastSeq);
+  if (step > 0) {
+    p.rxLost += step - 1;
+    p.lastSeq = seq;
+  } else if (p.rxLost > 0) {
+    p.rxLost--;
+  }
+}
+
+// MESH_MSG_RELAY — unwrap, account against the origin, forward, dispatch
+static void meshOnRelay(const uint8_t* mac, const MeshHeader& outer,
+                        const uint8_t* payload, uint8_t len, int64_t rxUs) {
+  MeshRelayHeader rh;
+  memcpy(&rh, payload, sizeof(rh));
+  const uint8_t* nbr = payload + sizeof(rh);
+  const uint8_t* frame = nbr + 2 * rh.nbrCount;
+  int frameLen = (int)len - (int)sizeof(rh) - 2 * rh.nbrCount;
+
+  MeshHeader hdr;
+  const uint8_t* inner;
+  uint8_t innerLen;
+  if (frameLen < (int)sizeof(MeshHeader) ||
+      meshDecode(frame, frameLen, hdr, inner, innerLen) != MESH_DECODE_OK ||
+      !meshRelayable(hdr.type)) {
+    meshData.rxRejected++;
+    return;
+  }
+  if (memcmp(rh.origin, meshData.myMac, 6) == 0) return;  // Our own frame coming back
+  uint64_t covered = meshRelayCovered(mac, rh.origin, nbr, rh.nbrCount);
+  if (!meshRelayFirstSeen(meshNodeId(rh.origin), hdr.seq, covered)) {
+    // The first copy isn't always the shortest path — keep the fewest hops
+    int16_t idx = meshFindPeer(rh.origin);
+    if (idx >= 0 && rh.hops < meshData.peers[idx].hops) meshData.peers[idx].hops = rh.hops;
+    return;
+  }
+
+  int16_t idx = meshTouchPeer(rh.origin, hdr.deviceId);
+  if (idx >= 0) {
+    MeshPeer& p = meshData.peers[idx];
+    if (!meshPeerAdmit(p)) return;
+    meshPeerCountSeq(p, hdr.seq);
+    p.hops = rh.hops;
+  }
+
+  meshRelayQueue(rh.origin, rh.hops, rh.ttl, frame, frameLen, covered);
+  meshMsgTypes[hdr.type].handler(rh.origin, hdr, inner, innerLen, rxUs);
 }
 
 // ============================================================================
 // ESP-NOW Receive Callback
 // ============================================================================
-// Runs on Core 0 WiFi context. Must be fast — just memcpy and update cache.
+// Runs on Core 0 WiFi context. Must be fast — decode, update cache, dispatch.
 
 #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
 static void meshOnReceive(const esp_now_recv_info_t* info, const uint8_t* data, int len) {
@@ -239,33 +916,266 @@ static void meshOnReceive(const esp_now_recv_info_t* info, const uint8_t* data,
 #else
 static void meshOnReceive(const uint8_t* mac, const uint8_t* data, int len) {
 #endif
-  if (len != sizeof(MeshStatePacket)) return;
+  int64_t rxUs = esp_timer_get_time();  // Stamp first — it's the t2/t4 of a sync exchange
 
-  const MeshStatePacket* pkt = (const MeshStatePacket*)data;
+  MeshHeader hdr;
+  const uint8_t* payload;
+  uint8_t payloadLen;
+  if (meshDecode(data, len, hdr, payload, payloadLen) != MESH_DECODE_OK) {
+    meshData.rxRejected++;
+    return;
+  }
 
   // Ignore our own broadcasts (reflected by AP)
-  if (pkt->deviceId == meshData.myDeviceId) return;
-
-  // Version check
-  if (pkt->version != MESH_PROTOCOL_VERSION) return;
+  if (memcmp(mac, meshData.myMac, 6) == 0) return;
+
+  int16_t idx = meshTouchPeer(mac, hdr.deviceId);
+  if (idx >= 0 && !meshPeerAdmit(meshData.peers[idx])) return;
+
+  // Relay envelopes use their own seq space and are accounted in meshOnRelay
+  if (hdr.type != MESH_MSG_RELAY) {
+    bool relayable = meshRelayable(hdr.type);
+    uint64_t covered = idx >= 0 ? 1ULL << idx : 0;   // The origin itself
+    if (relayable && !meshRelayFirstSeen(meshNodeId(mac), hdr.seq, covered)) {
+      if (idx >= 0) meshData.peers[idx].hops = 0;  // Relayed copy beat the direct one
+      return;
+    }
+    if (idx >= 0) {
+      meshPeerCountSeq(meshData.peers[idx], hdr.seq);
+      meshData.peers[idx].hops = 0;
+    }
+    if (relayable) meshRelayQueue(mac, 0, MESH_RELAY_TTL, data, len, covered);
+  }
 
-  meshUpsertPeer(mac, *pkt);
+  meshData.rxFrames++;
+  meshMsgTypes[hdr.type].handler(mac, hdr, payload, payloadLen, rxUs);
 }
 
 // ============================================================================
 // Broadcast
 // ============================================================================
 
+static const uint8_t meshBroadcastAddr[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+static bool meshBucketTake(uint8_t& tokens, unsigned long& refillMs,
+                           uint32_t ratePerSec, uint8_t burst) {
+  unsigned long now = millis();
+  uint32_t add = (now - refillMs) * ratePerSec / 1000;
+  if (add > 0) {
+    tokens = min((uint32_t)burst, tokens + add);
+    refillMs += add * 1000 / ratePerSec;
+  }
+  if (tokens == 0) return false;
+  tokens--;
+  return true;
+}
+
+// Token bucket shared by every send
+static bool meshTxAllow() {
+  if (meshBucketTake(meshData.txTokens, meshData.txRefillMs, MESH_TX_RATE_PER_SEC, MESH_TX_BURST)) {
+    return true;
+  }
+  meshData.txThrottled++;
+  return false;
+}
+
+// Frame and broadcast one message. False if throttled or the radio refused.
+bool meshSend(uint8_t type, const void* payload, uint8_t len) {
+  if (!meshData.initialized) return false;
+  if (len > MESH_MAX_FRAME - sizeof(MeshHeader)) return false;
+  if (!meshTxAllow()) return false;
+
+  uint8_t frame[MESH_MAX_FRAME];
+  uint8_t n = meshEncodeFrame(frame, type, meshData.myDeviceId, meshData.txSeq, payload, len);
+  if (esp_now_send(meshBroadcastAddr, frame, n) != ESP_OK) return false;
+  meshData.txSeq++;
+  meshData.txFrames++;
+  return true;
+}
+
+// Send relay forwards that are due. Runs on the WiFi task via pollMeshBroadcast().
+static void pollMeshRelay(unsigned long now) {
+  for (uint8_t i = 0; i < MESH_RELAY_QUEUE; i++) {
+    MeshRelaySlot& q = meshRelay.slots[i];
+    if (!q.len || (long)(now - q.dueMs) < 0) continue;
+
+    // Take the slot out under the lock; the receive path may be covering it
+    uint8_t payload[sizeof(q.payload)];
+    portENTER_CRITICAL(&meshRelayMux);
+    uint8_t len = q.len;
+    uint64_t uncovered = q.uncovered;
+    memcpy(payload, q.payload, len);
+    q.len = 0;
+    portEXIT_CRITICAL(&meshRelayMux);
+
+    if (uncovered == 0) {
+      meshRelay.suppressed++;
+      continue;
+    }
+    if (!meshBucketTake(meshRelay.tokens, meshRelay.refillMs,
+                        MESH_RELAY_RATE_PER_SEC, MESH_RELAY_BURST)) {
+      meshRelay.dropped++;
+      continue;
+    }
+
+    // Splice our neighbour list in after the relay header, as much as fits
+    uint8_t envelope[sizeof(q.payload)];
+    uint8_t room = min((sizeof(envelope) - len) / 2, (size_t)MESH_RELAY_NBR_MAX);
+    uint8_t count = 0;
+    portENTER_CRITICAL(&meshPeerMux);
+    for (uint8_t k = 0; k < meshData.peerCount && count < room; k++) {
+      const MeshPeer& p = meshData.peers[k];
+      if (!p.active || p.hops != 0) continue;
+      uint16_t id = meshShortId(p.nodeId);
+      memcpy(envelope + sizeof(MeshRelayHeader) + 2 * count++, &id, 2);
+    }
+    portEXIT_CRITICAL(&meshPeerMux);
+    MeshRelayHeader rh;
+    memcpy(&rh, payload, sizeof(rh));
+    rh.nbrCount = count;
+    memcpy(envelope, &rh, sizeof(rh));
+    memcpy(envelope + sizeof(rh) + 2 * count, payload + sizeof(rh), len - sizeof(rh));
+
+    uint8_t frame[MESH_MAX_FRAME];
+    uint8_t n = meshEncodeFrame(frame, MESH_MSG_RELAY, meshData.myDeviceId, meshRelay.seq++,
+                                envelope, len + 2 * count);
+    if (esp_now_send(meshBroadcastAddr, frame, n) == ESP_OK) meshRelay.forwarded++;
+  }
+}
+
+// Full state keyframe — resets what peers believe
 static bool meshBroadcast() {
   if (!meshData.initialized) return false;
 
-  MeshStatePacket pkt;
-  meshBuildPacket(pkt);
+  MeshState st;
+  meshBuildState(st);
+  if (!meshSend(MESH_MSG_STATE, &st, sizeof(st))) return false;
+  meshData.sentState = st;
+  return true;
+}
 
-  static const uint8_t broadcastAddr[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
-  esp_err_t result = esp_now_send(broadcastAddr, (const uint8_t*)&pkt, sizeof(pkt));
+static bool meshSendEvent(uint8_t event, uint32_t arg) {
+  MeshEvent ev = { event, 0, arg };
+  if (!meshSend(MESH_MSG_EVENT, &ev, sizeof(ev))) return false;
+  meshApplyEvent(meshData.sentState, ev);
+  return true;
+}
+
+// Send discrete fields that changed since the last keyframe/delta/event.
+// True only if a frame went out (false = nothing changed, or throttled).
+static bool meshSendDelta(const MeshState& cur) {
+  uint8_t payload[2 + sizeof(MeshState)];
+  uint8_t len = meshEncodeDelta(meshData.sentState, cur, MESH_DELTA_FIELDS, payload);
+  if (len == 0) return false;
+  if (!meshSend(MESH_MSG_DELTA, payload, len)) return false;
+  meshApplyDelta(meshData.sentState, payload, len);
+  return true;
+}
+
+// REQ: t1 is stamped here. RESP: echo the requester's t1 and our receive t2.
+// Stamped as late as possible so the responder's hold time drops out of rtt.
+static bool meshSendSync(uint8_t type, uint32_t targetId, int64_t t1 = 0, int64_t t2 = 0) {
+  MeshSyncPayload pkt;
+  pkt.targetId = targetId;
+  pkt.masterId = meshClock.masterId;
+  pkt.flags    = (meshClock.synced ? MESH_SYNC_FLAG_SYNCED : 0) |
+                 (meshIsClockMaster() ? MESH_SYNC_FLAG_MASTER : 0);
+  pkt.stratum  = meshClock.synced ? meshClock.stratum : MESH_CLOCK_MAX_STRATUM;
+  if (type == MESH_MSG_SYNC_REQ) {
+    pkt.t1 = esp_timer_get_time();
+    pkt.t2 = 0;
+    pkt.t3 = 0;
+  } else {
+    pkt.t1 = t1;
+    pkt.t2 = t2;
+    pkt.t3 = meshTimeUs();
+  }
+  return meshSend(type, &pkt, sizeof(pkt));
+}
+
+// ============================================================================
+// Clock Poll — replies, master election, periodic exchanges (Core 0)
+// ============================================================================
+
+// Neighbour to sync to: the master itself when it is in range, else the
+// synced neighbour on the same master with the lowest stratum (the current
+// parent wins ties, so equal routes don't flap). 0 = none yet, or we are the
+// master.
+static uint32_t meshClockPickParent(uint32_t master, unsigned long now) {
+  if (master == meshData.myNodeId) return 0;
+  uint32_t best = 0;
+  uint8_t bestStratum = MESH_CLOCK_MAX_STRATUM - 1;
+  for (uint8_t i = 0; i < meshData.peerCount; i++) {
+    const MeshPeer& p = meshData.peers[i];
+    if (!p.active || p.hops != 0) continue;
+    if (p.nodeId == master) return master;
+    if (!p.clockSynced || p.clockMaster != master || p.clockSeenMs == 0 ||
+        now - p.clockSeenMs > MESH_STALE_TIMEOUT_MS) continue;
+    if (p.clockStratum < bestStratum ||
+        (p.clockStratum == bestStratum && p.nodeId == meshClock.parentId)) {
+      best = p.nodeId;
+      bestStratum = p.clockStratum;
+    }
+  }
+  return best;
+}
+
+static void pollMeshClock(unsigned long now) {
+  // Answer queued requests
+  while (meshClock.replyTail != meshClock.replyHead) {
+    uint8_t t = meshClock.replyTail;
+    meshSendSync(MESH_MSG_SYNC_RESP, meshClock.replies[t].requester,
+                 meshClock.replies[t].t1, meshClock.replies[t].t2);
+    meshClock.replyTail = (t + 1) % MESH_SYNC_REPLY_SLOTS;
+  }
+
+  // Master = lowest node id in the whole mesh (including us), relayed peers
+  // too — one timebase across cells, or relayed play-at stamps would be read
+  // against a different clock in every cell
+  uint32_t master = meshData.myNodeId;
+  for (uint8_t i = 0; i < meshData.peerCount; i++) {
+    const MeshPeer& p = meshData.peers[i];
+    if (p.active && p.nodeId < master) master = p.nodeId;
+  }
+  if (master != meshClock.masterId) {
+    DBG("Mesh: clock master now ");
+    DBGLN(String(master, HEX));
+    meshClockReset(master);
+    meshClock.nextExchangeMs = now;
+  }
+
+  // Holdover ends when no sample has been accepted for a while — the parent
+  // went away or every route left is a loop of bots syncing to each other
+  if (meshClock.synced && !meshIsClockMaster() &&
+      esp_timer_get_time() - meshClock.lastAppliedUs > (int64_t)MESH_STALE_TIMEOUT_MS * 1000) {
+    DBGLN("Mesh: clock lost its parent");
+    meshClockReset(master);
+  }
+
+  uint32_t parent = meshClockPickParent(master, now);
+  if (parent != meshClock.parentId) {
+    DBG("Mesh: clock parent now ");
+    DBGLN(String(parent, HEX));
+    meshClock.parentId = parent;
+  }
+
+  if ((long)(now - meshClock.nextExchangeMs) < 0) return;
+  meshClock.nextExchangeMs = now + (meshClock.synced ? MESH_CLOCK_INTERVAL_MS : MESH_CLOCK_FAST_MS);
+
+  if (parent) meshSendSync(MESH_MSG_SYNC_REQ, parent);
 
-  return (result == ESP_OK);
+  // Probe one other neighbour per round — the error report, and what tells
+  // a bot out of the master's range which neighbour to sync to
+  if ((meshClock.synced || !parent) && meshData.peerCount > 0) {
+    for (uint8_t tries = 0; tries < meshData.peerCount; tries++) {
+      meshClock.probeIdx = (meshClock.probeIdx + 1) % meshData.peerCount;
+      const MeshPeer& p = meshData.peers[meshClock.probeIdx];
+      if (p.active && p.hops == 0 && p.nodeId != parent) {
+        meshSendSync(MESH_MSG_SYNC_REQ, p.nodeId);
+        break;
+      }
+    }
+  }
 }
 
 // ============================================================================
@@ -275,10 +1185,23 @@ static bool meshBroadcast() {
 void initMesh() {
   if (meshData.initialized) return;
 
-  // Get our device ID from MAC
-  uint8_t mac[6];
-  WiFi.macAddress(mac);
-  meshData.myDeviceId = mac[5];  // Last byte of MAC
+  // Identity from the MAC our frames are sent from (broadcast peer is on the AP)
+  WiFi.softAPmacAddress(meshData.myMac);
+  meshData.myDeviceId = meshData.myMac[5];  // Last byte of MAC
+  meshData.myNodeId = meshNodeId(meshData.myMac);
+
+  // Peer table — PSRAM boards can track a room full of bots
+  meshData.peers = meshPeerTable;
+  meshData.peerCapacity = MESH_MAX_PEERS;
+  if (sysStatus.psramAvailable) {
+    MeshPeer* table = (MeshPeer*)heap_caps_calloc(MESH_MAX_PEERS_PSRAM, sizeof(MeshPeer),
+                                                  MALLOC_CAP_SPIRAM);
+    if (table) {
+      meshData.peers = table;
+      meshData.peerCapacity = MESH_MAX_PEERS_PSRAM;
+    }
+  }
+  meshRebuildHash();
 
   // Init ESP-NOW
   if (esp_now_init() != ESP_OK) {
@@ -286,6 +1209,26 @@ void initMesh() {
     return;
   }
 
+  // Clock + play-at plumbing before any packet can arrive
+  meshClockReset(meshData.myNodeId);
+  meshPlayQueue = xQueueCreate(MESH_PLAY_QUEUE_SIZE, sizeof(MeshPlayAction));
+  meshLoopTask = xTaskGetCurrentTaskHandle();  // setup() and loop() share the Arduino loop task
+  esp_timer_create_args_t timerArgs = {};
+  timerArgs.callback = meshPlayTimerCb;
+  timerArgs.name = "mesh_play";
+  esp_timer_create(&timerArgs, &meshPlayTimer);
+
+  // Message types this module handles
+  meshRegisterMsg(MESH_MSG_STATE,     sizeof(MeshState), sizeof(MeshState), meshOnState);
+  meshRegisterMsg(MESH_MSG_DELTA,     3, 2 + sizeof(MeshState), meshOnDelta);
+  meshRegisterMsg(MESH_MSG_EVENT,     sizeof(MeshEvent), sizeof(MeshEvent), meshOnEvent);
+  meshRegisterMsg(MESH_MSG_SYNC_REQ,  sizeof(MeshSyncPayload), sizeof(MeshSyncPayload), meshOnSyncRequest);
+  meshRegisterMsg(MESH_MSG_SYNC_RESP, sizeof(MeshSyncPayload), sizeof(MeshSyncPayload), meshOnSyncResponse);
+  meshRegisterMsg(MESH_MSG_PLAY_AT,   MESH_PLAY_AT_FIXED, sizeof(MeshPlayAtPayload), meshOnPlayAt);
+  meshRegisterMsg(MESH_MSG_RELAY,     sizeof(MeshRelayHeader) + sizeof(MeshHeader),
+                  MESH_MAX_FRAME - sizeof(MeshHeader), meshOnRelay);
+  initWledLease();  // MESH_MSG_WLED_LEASE (wled_lease.h)
+
   // Register receive callback
   esp_now_register_recv_cb(meshOnReceive);
 
@@ -304,6 +1247,8 @@ void initMesh() {
 
   meshData.initialized = true;
   meshData.lastBroadcastMs = millis();
+  meshData.txTokens = MESH_TX_BURST;
+  meshData.txRefillMs = millis();
 
   DBG("Mesh: ESP-NOW ready, deviceId=0x");
   if (meshData.myDeviceId < 0x10) DBG("0");
@@ -319,6 +1264,9 @@ void pollMeshBroadcast() {
 
   unsigned long now = millis();
 
+  pollMeshClock(now);
+  pollMeshRelay(now);
+
   // Handle scan burst (triggered by CMD_MESH_SCAN)
   if (meshScanRequested) {
     meshScanRequested = false;
@@ -337,58 +1285,99 @@ void pollMeshBroadcast() {
     return;
   }
 
-  // Normal periodic broadcast
+  // Expression changes go out as an event right away
+  uint8_t expr = getBotExpression();
+  if (expr != meshData.sentState.expression) {
+    meshSendEvent(MESH_EVT_EXPRESSION, expr);  // Throttled = retried next poll
+  }
+
+  // Other discrete fields (mode, effect, palette, WLED flags) as a delta
+  if (now - meshData.lastDeltaCheckMs >= MESH_DELTA_CHECK_MS &&
+      now - meshData.lastDeltaMs >= MESH_DELTA_MIN_MS) {
+    meshData.lastDeltaCheckMs = now;
+    MeshState cur;
+    meshBuildState(cur);
+    if (meshSendDelta(cur)) {
+      meshData.lastDeltaMs = now;
+    }
+  }
+
+  // Periodic keyframe — heals anything a lost delta/event left stale
   if (now - meshData.lastBroadcastMs >= MESH_BROADCAST_INTERVAL_MS) {
-    meshBroadcast();
-    meshData.lastBroadcastMs = now;
+    if (meshBroadcast()) {
+      meshData.lastBroadcastMs = now;
+    }
 
     // Evict stale peers on each normal broadcast cycle
-    meshEvictStale();
+    if (meshEvictStale()) meshRelayForgetCoverage();
   }
 }
 
 // ============================================================================
-// WLED Coordination — cooperative announce-and-check
+// WLED Coordination — peer queries for the lease (wled_lease.h)
 // ============================================================================
 
-// Returns true if any peer has wledActive=1 in their last state packet
-bool meshAnyPeerWledActive() {
-  for (uint8_t i = 0; i < meshData.peerCount; i++) {
-    if (meshData.peers[i].active &&
-        (meshData.peers[i].lastPacket.reserved[0] & 0x01)) {
-      return true;
+// These run every poll on the WiFi task, so they read the cached per-IP index
+// rather than walking the peer table. Leases name bots by node id — deviceId
+// collisions would elect two arbiters and let a grant match the wrong bot.
+
+// Lowest node id among peers targeting this WLED, or 0 if none. Only walks
+// the table after the lowest one left or moved to another WLED.
+uint32_t meshLowestIdForIP(uint32_t ip) {
+  if (ip == 0) return 0;
+  meshCheckIndexIP(ip);
+  if (meshData.ipPeers == 0) return 0;
+  if (meshData.ipLowestStale) {
+    portENTER_CRITICAL(&meshPeerMux);
+    uint32_t lowest = 0;
+    for (uint8_t i = 0; i < meshData.peerCount; i++) {
+      const MeshPeer& p = meshData.peers[i];
+      if (p.state.wledIP != ip) continue;
+      if (lowest == 0 || p.nodeId < lowest) lowest = p.nodeId;
     }
+    meshData.ipLowestId = lowest;
+    meshData.ipLowestStale = false;
+    portEXIT_CRITICAL(&meshPeerMux);
   }
-  return false;
+  return meshData.ipLowestId;
 }
 
-// Set our own wledActive flag and trigger immediate broadcast
+// Only asked while a lease is held, at the arbiter's poll rate
+bool meshPeerPresent(uint32_t nodeId) {
+  portENTER_CRITICAL(&meshPeerMux);
+  bool present = false;
+  for (uint8_t i = 0; i < meshData.peerCount && !present; i++) {
+    present = meshData.peers[i].nodeId == nodeId;
+  }
+  portEXIT_CRITICAL(&meshPeerMux);
+  return present;
+}
+
+// Returns true if any peer on the same WLED IP is sending DDP to it
+bool meshAnyPeerWledActiveForIP(uint32_t ip) {
+  if (ip == 0) return false;
+  meshCheckIndexIP(ip);
+  return meshData.ipWledActive > 0;
+}
+
+// Number of peers whose last state targets this WLED
+uint8_t meshPeersForIP(uint32_t ip) {
+  if (ip == 0) return 0;
+  meshCheckIndexIP(ip);
+  return meshData.ipPeers;
+}
+
+// Set our own wledActive flag and announce it with an immediate event
 void meshSetWledActive(bool active) {
   if (meshData.wledActive == active) return;
   meshData.wledActive = active;
 
-  // Immediate broadcast so peers learn in ~1ms
+  // Peers learn in ~1ms. If throttled, the next delta carries the flag.
   if (meshData.initialized) {
-    meshBroadcast();
+    meshSendEvent(active ? MESH_EVT_WLED_CLAIM : MESH_EVT_WLED_RELEASE, wledGetIPAsU32());
   }
 }
 
-// IP-aware: returns true if any peer on the SAME WLED IP has wledActive=1
-bool meshAnyPeerWledActiveForIP(uint32_t localIP) {
-  if (localIP == 0) return false;  // No WLED configured
-  for (uint8_t i = 0; i < meshData.peerCount; i++) {
-    if (!meshData.peers[i].active) continue;
-    if (!(meshData.peers[i].lastPacket.reserved[0] & 0x01)) continue;
-
-    // Reconstruct peer's WLED IP from reserved[1..4]
-    const uint8_t* r = meshData.peers[i].lastPacket.reserved;
-    uint32_t peerIP = ((uint32_t)r[1] << 24) | ((uint32_t)r[2] << 16) |
-                      ((uint32_t)r[3] << 8) | r[4];
-    if (peerIP == localIP) return true;
-  }
-  return false;
-}
-
 // ============================================================================
 // Scheduler Ownership — cooperative first-online-claims
 // ============================================================================
@@ -396,7 +1385,9 @@ bool meshAnyPeerWledActiveForIP(uint32_t localIP) {
 void meshSetSchedOwner(bool owner) {
   if (meshData.schedOwner == owner) return;
   meshData.schedOwner = owner;
-  if (meshData.initialized) meshBroadcast();
+  if (meshData.initialized) {
+    meshSendEvent(owner ? MESH_EVT_SCHED_CLAIM : MESH_EVT_SCHED_RELEASE, wledGetIPAsU32());
+  }
 }
 
 bool meshIsSchedOwner() {
@@ -406,26 +1397,197 @@ bool meshIsSchedOwner() {
 // Returns true if any peer on the same WLED IP claims scheduler ownership
 bool meshAnyPeerSchedOwnerForIP(uint32_t localIP) {
   if (localIP == 0) return false;
-  for (uint8_t i = 0; i < meshData.peerCount; i++) {
-    if (!meshData.peers[i].active) continue;
-    if (!(meshData.peers[i].lastPacket.reserved[0] & 0x02)) continue;
+  meshCheckIndexIP(localIP);
+  return meshData.ipSchedOwner > 0;
+}
+
+// ============================================================================
+// Play At Mesh Time — synchronized expressions, sayings, MIDI sequences
+// ============================================================================
+
+// Start an action on every bot in the mesh (and here) leadMs from now. The
+// lead must cover the broadcast, its relay hops and each bot's frame; ~100ms
+// is plenty in one cell, allow ~25ms per relay hop beyond it. Only goes out
+// once our clock is synced — false = played here only.
+// Safe from Core 0 (web/cloud handlers).
+bool meshPlayAt(uint8_t action, uint16_t arg, const char* text, uint32_t leadMs) {
+  MeshPlayAction act;
+  act.localUs = esp_timer_get_time() + (int64_t)leadMs * 1000;
+  act.action  = action;
+  act.arg     = arg;
+  strncpy(act.text, text ? text : "", sizeof(act.text) - 1);
+  act.text[sizeof(act.text) - 1] = '\0';
+
+  if (meshPlayQueue == nullptr) return false;
+  xQueueSend(meshPlayQueue, &act, 0);
+  if (!meshClock.synced) return false;   // Our stamp would mean nothing to peers
+
+  MeshPlayAtPayload pkt;
+  pkt.action   = action;
+  pkt.arg      = arg;
+  pkt.atUs     = meshTimeAt(act.localUs);
+  pkt.masterId = meshClock.masterId;
+  size_t textLen = strlen(act.text);
+  memcpy(pkt.text, act.text, textLen + 1);
+  uint8_t len = MESH_PLAY_AT_FIXED + (action == MESH_PLAY_SAY ? textLen + 1 : 0);
+  return meshSend(MESH_MSG_PLAY_AT, &pkt, len);
+}
+
+// "expression" / "say" / "sequence" -> MESH_PLAY_*, or -1
+int8_t meshPlayActionFromName(const char* name) {
+  if (strcmp(name, "expression") == 0) return MESH_PLAY_EXPRESSION;
+  if (strcmp(name, "say") == 0)        return MESH_PLAY_SAY;
+  if (strcmp(name, "sequence") == 0)   return MESH_PLAY_SEQUENCE;
+  return -1;
+}
 
-    const uint8_t* r = meshData.peers[i].lastPacket.reserved;
-    uint32_t peerIP = ((uint32_t)r[1] << 24) | ((uint32_t)r[2] << 16) |
-                      ((uint32_t)r[3] << 8) | r[4];
-    if (peerIP == localIP) return true;
+static void meshRunPlayAction(const MeshPlayAction& act) {
+  switch (act.action) {
+    case MESH_PLAY_EXPRESSION:
+      if (act.arg < BOT_NUM_EXPRESSIONS) setBotExpression((uint8_t)act.arg);
+      break;
+    case MESH_PLAY_SAY:
+      showBotSaying(act.text, act.arg);
+      break;
+    case MESH_PLAY_SEQUENCE:
+      #ifdef TARGET_CORES3
+      {
+        extern BotSounds botSounds;
+        botSounds.play((MidiSequenceId)act.arg);
+      }
+      #endif
+      break;
   }
-  return false;
+}
+
+// Core 1 — call at the top of loop(). Fires due actions and arms the wake
+// timer for the next one so meshFrameDelay() returns on time.
+void pollMeshPlayAt() {
+  if (meshPlayQueue == nullptr) return;
+  static MeshPlayAction pending[MESH_PLAY_QUEUE_SIZE];
+  static uint8_t pendingCount = 0;
+
+  // Always drain — when every slot is taken, the action due last gives way
+  // (possibly the new one), so the queue behind us never backs up
+  MeshPlayAction act;
+  while (xQueueReceive(meshPlayQueue, &act, 0) == pdTRUE) {
+    if (pendingCount < MESH_PLAY_QUEUE_SIZE) {
+      pending[pendingCount++] = act;
+      continue;
+    }
+    uint8_t last = 0;
+    for (uint8_t i = 1; i < pendingCount; i++) {
+      if (pending[i].localUs > pending[last].localUs) last = i;
+    }
+    meshPlayRejected++;
+    if (act.localUs < pending[last].localUs) pending[last] = act;
+  }
+
+  int64_t now = esp_timer_get_time();
+  int64_t nextDue = INT64_MAX;
+  for (uint8_t i = 0; i < pendingCount; ) {
+    int64_t due = pending[i].localUs;
+    if (due - now <= MESH_PLAY_EARLY_US) {
+      if (now - due > (int64_t)MESH_PLAY_LATE_MS * 1000) {
+        meshPlayLateDrops++;
+        DBGLN("Mesh: play-at arrived too late, dropped");
+      } else {
+        meshRunPlayAction(pending[i]);
+      }
+      pending[i] = pending[--pendingCount];
+      continue;
+    }
+    if (due < nextDue) nextDue = due;
+    i++;
+  }
+
+  if (meshPlayTimer) {
+    esp_timer_stop(meshPlayTimer);
+    if (nextDue != INT64_MAX) esp_timer_start_once(meshPlayTimer, nextDue - now);
+  }
+}
+
+// Frame delay for loop(): sleeps ms, or less if a play-at action comes due
+void meshFrameDelay(uint32_t ms) {
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+}
+
+// ============================================================================
+// Clock Status — for /bot/mesh
+// ============================================================================
+
+uint32_t meshClockMasterId()    { return meshClock.masterId; }
+uint8_t meshClockStratum()      { return meshClock.synced ? meshClock.stratum : MESH_CLOCK_MAX_STRATUM; }
+float   meshClockDriftPpm()     { return meshClock.driftPpm; }
+uint32_t meshClockRttUs()       { return meshClock.lastRttUs; }
+int32_t meshClockResidualUs()   { return meshClock.lastResidualUs; }
+uint32_t meshPlayLateDropCount() { return meshPlayLateDrops; }
+uint32_t meshPlayRejectedCount() { return meshPlayRejected; }
+
+// Traffic counters — for /bot/mesh
+void meshGetStats(uint32_t& txFrames, uint32_t& txThrottled, uint32_t& rxFrames,
+                  uint32_t& rxRejected, uint32_t& rxThrottled, uint32_t& rxLost) {
+  txFrames    = meshData.txFrames;
+  txThrottled = meshData.txThrottled;
+  rxFrames    = meshData.rxFrames;
+  rxRejected  = meshData.rxRejected;
+  rxThrottled = meshData.rxThrottled;
+  rxLost = 0;
+  for (uint8_t i = 0; i < meshData.peerCount; i++) rxLost += meshData.peers[i].rxLost;
+}
+
+// Relay counters — for /bot/mesh
+void meshGetRelayStats(uint32_t& forwarded, uint32_t& suppressed, uint32_t& dropped,
+                       uint32_t& duplicates) {
+  forwarded  = meshRelay.forwarded;
+  suppressed = meshRelay.suppressed;
+  dropped    = meshRelay.dropped;
+  duplicates = meshData.rxDuplicates;
+}
+
+int64_t meshClockOffsetUs() {
+  int64_t now = esp_timer_get_time();
+  return meshTimeAt(now) - now;
+}
+
+// Per-peer clock report. Returns false past the end of the table.
+bool meshGetPeerClock(uint8_t i, uint8_t& deviceId, int32_t& errUs, uint32_t& rttUs,
+                      uint32_t& ageMs, bool& synced) {
+  if (i >= meshData.peerCount) return false;
+  const MeshPeer& p = meshData.peers[i];
+  deviceId = p.deviceId;
+  errUs    = p.clockErrUs;
+  rttUs    = p.clockRttUs;
+  ageMs    = p.clockSeenMs ? millis() - p.clockSeenMs : UINT32_MAX;
+  synced   = p.clockSynced;
+  return true;
 }
 
 // ============================================================================
 // Accessors
 // ============================================================================
 
+uint8_t meshGetDeviceId() {
+  return meshData.myDeviceId;
+}
+
+uint32_t meshGetNodeId() {
+  return meshData.myNodeId;
+}
+
 uint8_t meshGetPeerCount() {
   return meshData.peerCount;
 }
 
+// Relays between us and peer i (0 = in radio range), or 0xFF past the end
+uint8_t meshGetPeerHops(uint8_t i) {
+  return i < meshData.peerCount ? meshData.peers[i].hops : 0xFF;
+}
+
+uint8_t meshGetPeerCapacity() {
+  return meshData.peerCapacity;
+}
+
 bool meshIsInitialized() {
   return meshData.initialized;
 }
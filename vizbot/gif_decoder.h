@@ -0,0 +1,451 @@
+#ifndef GIF_DECODER_H
+#define GIF_DECODER_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// GIF Decoder — streaming, one frame at a time, fixed working set
+// ============================================================================
+// Reads a GIF through a read callback (a LittleFS file, a PSRAM copy) and
+// hands each decoded row of palette indices to a row handler. Nothing is
+// allocated: the LZW tables, the read buffer and one row live in the
+// GifDecoder itself (~28KB), so the caller decides where that goes.
+//
+//   GifDecoder* gif = ...;            // PSRAM or heap, sizeof(GifDecoder)
+//   if (gif->begin(readFn, seekFn, src)) {
+//     while (gif->nextFrame(rowFn, ctx) == GIF_FRAME) {
+//       ... gif->frame says where the rows went, how long to show them
+//     }
+//   }
+//
+// Frames are the GIF's own frame deltas: each one covers only its rectangle
+// (gif->frame.x/y/w/h), and rows arrive already de-interlaced with their
+// screen y. Transparent pixels keep their index — the handler skips
+// frame.transparent. Disposal 2 (restore background) is the caller's job
+// after the frame has been shown; disposal 3 (restore previous) is treated
+// as 1, as most small decoders do.
+//
+// LZW strings are written straight into the row from their known length,
+// back to front; only a string that crosses a row end goes through the
+// stack. The palette in effect is gif->palette (RGB triplets);
+// paletteSerial changes whenever it does, so a sink can cache a converted
+// copy.
+// ============================================================================
+
+#define GIF_MAX_WIDTH          320    // Widest frame rectangle (row buffer)
+#define GIF_READ_BUF           1024   // Bytes read per refill
+#define GIF_LZW_CODES          4096
+#define GIF_DELAY_DEFAULT_MS   100    // For frames that ask for 0-1 cs, as browsers do
+#define GIF_NO_CODE            0xFFFF
+
+// Fills buf with up to n bytes, returns how many (0 = end of data)
+typedef size_t (*GifReadFn)(void* src, uint8_t* buf, size_t n);
+// Moves to an absolute offset — used to loop back to the first frame
+typedef bool (*GifSeekFn)(void* src, uint32_t pos);
+
+enum GifResult : uint8_t {
+  GIF_FRAME = 0,     // A frame was decoded
+  GIF_END,           // Trailer reached — rewind() to loop
+  GIF_ERROR,         // Bad or truncated data; see error
+};
+
+struct GifFrameInfo {
+  uint16_t x, y, w, h;     // Rectangle on the logical screen
+  uint16_t delayMs;
+  uint8_t  disposal;       // 1 leave (also for 0 and 3), 2 restore background
+  int16_t  transparent;    // Palette index, -1 = none
+  bool     interlaced;
+};
+
+// One decoded row of the frame rectangle: frame.w indices for screen row y
+typedef void (*GifRowHandler)(void* ctx, const GifFrameInfo& frame, uint16_t y, const uint8_t* idx);
+
+struct GifDecoder {
+  // Logical screen
+  uint16_t width;
+  uint16_t height;
+  uint8_t  bgIndex;
+  uint16_t loopCount;            // NETSCAPE2.0 loops, 0 = forever
+  bool     hasLoopCount;         // false = play once
+
+  GifFrameInfo frame;            // Last decoded frame
+  uint32_t frameIndex;           // Frames decoded since begin()/rewind()
+  const uint8_t* palette;        // In effect for the last frame, RGB x 256
+  uint16_t paletteSerial;        // Changes when palette does
+  const char* error;
+
+  // ---- Public API ----
+
+  bool begin(GifReadFn readFn, GifSeekFn seekFn, void* src) {
+    read = readFn;
+    seek = seekFn;
+    this->src = src;
+    bufBase = 0;
+    bufLen = bufPos = 0;
+    error = nullptr;
+    frameIndex = 0;
+    loopCount = 0;
+    hasLoopCount = false;
+    paletteSerial++;
+
+    uint8_t hdr[13];
+    if (!readBytes(hdr, sizeof(hdr))) return fail("short header");
+    if (memcmp(hdr, "GIF87a", 6) != 0 && memcmp(hdr, "GIF89a", 6) != 0) return fail("not a GIF");
+    width = hdr[6] | (hdr[7] << 8);
+    height = hdr[8] | (hdr[9] << 8);
+    bgIndex = hdr[11];
+    memset(globalPal, 0, sizeof(globalPal));
+    if (hdr[10] & 0x80) {
+      uint16_t n = 2 << (hdr[10] & 0x07);
+      if (!readBytes(globalPal, n * 3)) return fail("short palette");
+    }
+    palette = globalPal;
+    firstFramePos = position();
+    return true;
+  }
+
+  // Back to the first frame, for the next loop
+  bool rewind() {
+    if (!seek || !seek(src, firstFramePos)) return fail("can't seek");
+    bufBase = firstFramePos;
+    bufLen = bufPos = 0;
+    frameIndex = 0;
+    return true;
+  }
+
+  GifResult nextFrame(GifRowHandler rowFn, void* ctx) {
+    // Graphic control extension applies to the next image only
+    uint16_t delayCs = 0;
+    uint8_t disposal = 0;
+    int16_t transparent = -1;
+
+    for (;;) {
+      int b = readByte();
+      if (b < 0) {
+        // Missing trailer: end cleanly if anything played
+        if (frameIndex > 0) return GIF_END;
+        fail("truncated");
+        return GIF_ERROR;
+      }
+      if (b == 0x3B) return GIF_END;
+
+      if (b == 0x21) {
+        int label = readByte();
+        if (label == 0xF9) {
+          uint8_t gce[6];   // size 4, packed, delay, transparent, terminator
+          if (!readBytes(gce, sizeof(gce))) break;
+          disposal = (gce[1] >> 2) & 0x07;
+          delayCs = gce[2] | (gce[3] << 8);
+          transparent = (gce[1] & 0x01) ? gce[4] : -1;
+          if (gce[5] != 0) skipBlocks();
+        } else if (label == 0xFF) {
+          readAppExtension();
+        } else {
+          skipBlocks();
+        }
+        continue;
+      }
+
+      if (b != 0x2C) {
+        fail("bad block");
+        return GIF_ERROR;
+      }
+
+      uint8_t desc[9];
+      if (!readBytes(desc, sizeof(desc))) break;
+      frame.x = desc[0] | (desc[1] << 8);
+      frame.y = desc[2] | (desc[3] << 8);
+      frame.w = desc[4] | (desc[5] << 8);
+      frame.h = desc[6] | (desc[7] << 8);
+      frame.interlaced = desc[8] & 0x40;
+      frame.delayMs = delayCs < 2 ? GIF_DELAY_DEFAULT_MS : delayCs * 10;
+      frame.disposal = disposal == 2 ? 2 : 1;
+      frame.transparent = transparent;
+      if (frame.w == 0 || frame.w > GIF_MAX_WIDTH) {
+        fail("frame too wide");
+        return GIF_ERROR;
+      }
+
+      const uint8_t* pal = globalPal;
+      if (desc[8] & 0x80) {
+        uint16_t n = 2 << (desc[8] & 0x07);
+        memset(localPal, 0, sizeof(localPal));
+        if (!readBytes(localPal, n * 3)) break;
+        pal = localPal;
+        paletteSerial++;               // A local table is new every time
+      } else if (palette != globalPal) {
+        paletteSerial++;
+      }
+      palette = pal;
+
+      if (!decodeImage(rowFn, ctx)) return GIF_ERROR;
+      frameIndex++;
+      return GIF_FRAME;
+    }
+    fail("truncated");
+    return GIF_ERROR;
+  }
+
+  // ---- Internals ----
+
+  GifReadFn read;
+  GifSeekFn seek;
+  void* src;
+  uint32_t firstFramePos;
+  uint32_t bufBase;              // Stream offset of buf[0]
+  uint16_t bufLen;
+  uint16_t bufPos;
+  uint8_t buf[GIF_READ_BUF];
+
+  uint8_t globalPal[256 * 3];
+  uint8_t localPal[256 * 3];
+
+  // LZW string table: each code is its prefix code plus one byte
+  uint16_t prefix[GIF_LZW_CODES];
+  uint8_t  suffix[GIF_LZW_CODES];
+  uint16_t length[GIF_LZW_CODES];
+  uint8_t  stack[GIF_LZW_CODES];
+
+  // Image data bit reader
+  uint32_t bits;
+  uint8_t  bitCount;
+  uint8_t  blockLeft;
+  bool     blocksDone;           // Zero-length terminator block seen
+
+  // Row output
+  uint8_t  row[GIF_MAX_WIDTH];
+  uint16_t rowPos;
+  uint16_t rowsDone;
+  uint8_t  pass;                 // Interlace pass 0-3
+  uint16_t passY;                // Next row within the pass
+
+  bool fail(const char* why) {
+    if (!error) error = why;
+    return false;
+  }
+
+  uint32_t position() const {
+    return bufBase + bufPos;
+  }
+
+  bool refill() {
+    bufBase += bufLen;
+    bufPos = 0;
+    bufLen = read(src, buf, sizeof(buf));
+    return bufLen > 0;
+  }
+
+  int readByte() {
+    if (bufPos >= bufLen && !refill()) return -1;
+    return buf[bufPos++];
+  }
+
+  bool readBytes(uint8_t* dst, uint16_t n) {
+    while (n) {
+      if (bufPos >= bufLen && !refill()) return false;
+      uint16_t run = min((uint16_t)(bufLen - bufPos), n);
+      memcpy(dst, buf + bufPos, run);
+      bufPos += run;
+      dst += run;
+      n -= run;
+    }
+    return true;
+  }
+
+  // Skip data sub-blocks up to and including the terminator
+  void skipBlocks() {
+    for (;;) {
+      int n = readByte();
+      if (n <= 0) return;
+      if (bufLen - bufPos >= n) {
+        bufPos += n;
+      } else {
+        while (n-- > 0 && readByte() >= 0) {}
+      }
+    }
+  }
+
+  void readAppExtension() {
+    int n = readByte();
+    uint8_t id[11];
+    if (n == 11 && readBytes(id, sizeof(id)) && memcmp(id, "NETSCAPE2.0", 11) == 0) {
+      uint8_t sub[4];   // size 3, 1, loop count
+      if (readBytes(sub, sizeof(sub)) && sub[0] == 3 && sub[1] == 1) {
+        loopCount = sub[2] | (sub[3] << 8);
+        hasLoopCount = true;
+      }
+    } else if (n != 11) {
+      while (n-- > 0 && readByte() >= 0) {}
+    }
+    skipBlocks();
+  }
+
+  // Next byte of image data, across sub-block boundaries; -1 at the end
+  int dataByte() {
+    if (blockLeft == 0) {
+      if (blocksDone) return -1;
+      int n = readByte();
+      if (n <= 0) {
+        blocksDone = true;
+        return -1;
+      }
+      blockLeft = n;
+    }
+    blockLeft--;
+    return readByte();
+  }
+
+  uint16_t screenRow() const {
+    return frame.y + (frame.interlaced ? passY : rowsDone);
+  }
+
+  void emitRow(GifRowHandler rowFn, void* ctx) {
+    rowFn(ctx, frame, screenRow(), row);
+    rowPos = 0;
+    rowsDone++;
+    if (frame.interlaced) {
+      // Rows 0,8,16.. then 4,12.. then 2,6.. then 1,3..
+      static const uint8_t start[4] = { 0, 4, 2, 1 };
+      static const uint8_t step[4] = { 8, 8, 4, 2 };
+      passY += step[pass];
+      while (passY >= frame.h && pass < 3) {
+        pass++;
+        passY = start[pass];
+      }
+    }
+  }
+
+  // Write one code's string into the output rows; returns its first byte
+  uint8_t emitString(uint16_t code, GifRowHandler rowFn, void* ctx) {
+    uint16_t len = length[code];
+    if (rowPos + len <= frame.w) {
+      // Common case — the whole string lands in this row
+      uint8_t* p = row + rowPos + len - 1;
+      uint16_t c = code;
+      for (uint16_t i = len; i > 1; i--) {
+        *p-- = suffix[c];
+        c = prefix[c];
+      }
+      *p = suffix[c];
+      rowPos += len;
+      if (rowPos == frame.w) emitRow(rowFn, ctx);
+      return *p;
+    }
+
+    // Crosses a row end: unwind into the stack, then copy out row by row
+    uint8_t* p = stack + len - 1;
+    uint16_t c = code;
+    for (uint16_t i = len; i > 1; i--) {
+      *p-- = suffix[c];
+      c = prefix[c];
+    }
+    *p = suffix[c];
+    uint8_t first = *p;
+    const uint8_t* s = stack;
+    while (len && rowsDone < frame.h) {
+      uint16_t run = min(len, (uint16_t)(frame.w - rowPos));
+      memcpy(row + rowPos, s, run);
+      rowPos += run;
+      s += run;
+      len -= run;
+      if (rowPos == frame.w) emitRow(rowFn, ctx);
+    }
+    return first;
+  }
+
+  bool decodeImage(GifRowHandler rowFn, void* ctx) {
+    int minCode = readByte();
+    if (minCode < 1 || minCode > 11) return fail("bad LZW size");
+
+    uint16_t clear = 1 << minCode;
+    uint16_t eoi = clear + 1;
+    for (uint16_t i = 0; i < clear; i++) {
+      prefix[i] = GIF_NO_CODE;
+      suffix[i] = (uint8_t)i;
+      length[i] = 1;
+    }
+
+    bits = 0;
+    bitCount = 0;
+    blockLeft = 0;
+    blocksDone = false;
+    rowPos = 0;
+    rowsDone = 0;
+    pass = 0;
+    passY = 0;
+
+    uint8_t codeSize = minCode + 1;
+    uint16_t codeMask = (1 << codeSize) - 1;
+    uint16_t next = clear + 2;
+    uint16_t prev = GIF_NO_CODE;
+    uint8_t prevFirst = 0;
+
+    while (rowsDone < frame.h) {
+      while (bitCount < codeSize) {
+        int b = dataByte();
+        if (b < 0) goto done;            // Data ran out — keep what we have
+        bits |= (uint32_t)b << bitCount;
+        bitCount += 8;
+      }
+      uint16_t code = bits & codeMask;
+      bits >>= codeSize;
+      bitCount -= codeSize;
+
+      if (code == clear) {
+        codeSize = minCode + 1;
+        codeMask = (1 << codeSize) - 1;
+        next = clear + 2;
+        prev = GIF_NO_CODE;
+        continue;
+      }
+      if (code == eoi) break;
+
+      if (prev == GIF_NO_CODE) {
+        if (code >= clear) return fail("bad first code");
+        prevFirst = emitString(code, rowFn, ctx);
+        prev = code;
+        continue;
+      }
+
+      if (code < next) {
+        uint8_t first = emitString(code, rowFn, ctx);
+        if (next < GIF_LZW_CODES) {
+          prefix[next] = prev;
+          suffix[next] = first;
+          length[next] = length[prev] + 1;
+          next++;
+        }
+        prevFirst = first;
+      } else if (code == next && next < GIF_LZW_CODES) {
+        // KwKwK: the new string is prev + its own first byte
+        prefix[next] = prev;
+        suffix[next] = prevFirst;
+        length[next] = length[prev] + 1;
+        next++;
+        emitString(code, rowFn, ctx);
+      } else {
+        return fail("bad LZW code");
+      }
+      prev = code;
+
+      if (next > codeMask && codeSize < 12) {
+        codeSize++;
+        codeMask = (1 << codeSize) - 1;
+      }
+    }
+
+  done:
+    // Short data: the rest of the rectangle stays as it was
+    if (!blocksDone) {
+      // Drop what's left of this sub-block, then the rest
+      while (blockLeft) {
+        blockLeft--;
+        if (readByte() < 0) break;
+      }
+      skipBlocks();
+    }
+    return true;
+  }
+};
+
+#endif // GIF_DECODER_H
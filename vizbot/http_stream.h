@@ -0,0 +1,224 @@
+#ifndef HTTP_STREAM_H
+#define HTTP_STREAM_H
+
+#include <Arduino.h>
+#include "json_stream.h"
+
+// ============================================================================
+// HTTP Stream — response framing for streamed JSON bodies, no heap
+// ============================================================================
+// Takes raw bytes off a socket in whatever chunks they arrive, reads the
+// status line and the headers it cares about (Content-Length,
+// Transfer-Encoding: chunked), strips chunk framing and hands the body
+// straight to a JsonStream. Nothing is buffered beyond one header line.
+//
+//   HttpStream http;
+//   JsonStream js;
+//   js.begin(handler, ctx);
+//   http.begin(&js);
+//   while (... read n bytes into buf ...) {
+//     if (http.feed(buf, n) != JSON_STREAM_MORE) break;
+//   }
+//   if (http.status == 200 && js.result == JSON_STREAM_DONE) ...
+//
+// feed() returns the JsonStream's result once the body has started, so the
+// caller can drop the connection as soon as the handler has what it needs.
+// begin(nullptr) reads the status line and headers only and stops at the
+// blank line — for an Upgrade response, where what follows isn't a body.
+//
+// Other headers can be picked up with onHeader(): the callback sees each
+// header line (at most HTTP_STREAM_LINE_LEN - 1 chars, `truncated` set if it
+// was longer). reusable() tells a keep-alive caller whether the socket is
+// positioned at the next response once this one is complete.
+// ============================================================================
+
+#define HTTP_STREAM_LINE_LEN  64   // Header bytes kept per line — the rest is skipped
+
+// Called per header line, before the blank one
+typedef void (*HttpHeaderHandler)(const char* line, bool truncated, void* ctx);
+
+struct HttpStream {
+  enum : uint8_t {
+    H_STATUS = 0,      // Status line
+    H_HEADER,          // Header lines until the blank one
+    H_CHUNK_SIZE,      // Chunked: hex size line
+    H_CHUNK_DATA,      // Chunked: data bytes
+    H_CHUNK_CRLF,      // Chunked: CRLF after data
+    H_TRAILER,         // Chunked: trailer lines after the 0 chunk, until the blank one
+    H_BODY,            // Plain body (Content-Length or until close)
+    H_DONE,
+    H_ERROR,
+  };
+
+  int16_t status;             // HTTP status, 0 until the status line is in
+  int32_t contentLength;      // -1 = not given
+  bool chunked;
+  bool connectionClose;       // Server said "Connection: close"
+  uint8_t state;
+  uint32_t remaining;         // Body or chunk bytes left
+  uint32_t bodyBytes;
+  char line[HTTP_STREAM_LINE_LEN];
+  uint8_t lineLen;
+  bool lineTruncated;
+  JsonStream* json;
+  HttpHeaderHandler headerHandler;
+  void* headerCtx;
+
+  void begin(JsonStream* js) {
+    status = 0;
+    contentLength = -1;
+    chunked = false;
+    connectionClose = false;
+    state = H_STATUS;
+    remaining = 0;
+    bodyBytes = 0;
+    lineLen = 0;
+    lineTruncated = false;
+    json = js;
+    headerHandler = nullptr;
+    headerCtx = nullptr;
+  }
+
+  // Call after begin()
+  void onHeader(HttpHeaderHandler h, void* ctx) {
+    headerHandler = h;
+    headerCtx = ctx;
+  }
+
+  // True once the whole body has been seen (needs a length or chunking)
+  bool complete() const {
+    return state == H_DONE;
+  }
+
+  // True once the blank line after the headers has gone by
+  bool headersDone() const {
+    return state >= H_CHUNK_SIZE && state != H_ERROR;
+  }
+
+  // 1xx, 204 and 304 responses never carry a body, whatever the headers say
+  bool bodyless() const {
+    return (status >= 100 && status < 200) || status == 204 || status == 304;
+  }
+
+  // Response fully read and the server will take another request on this
+  // socket. A body that runs until close never completes, so never reusable.
+  bool reusable() const {
+    return state == H_DONE && !connectionClose;
+  }
+
+  JsonStreamResult feed(const uint8_t* buf, size_t n) {
+    size_t i = 0;
+    while (i < n) {
+      if (state == H_ERROR) return JSON_STREAM_ERROR;
+      if (state == H_DONE) break;
+
+      // Body bytes go to the parser in runs, not one at a time
+      if (state == H_BODY || state == H_CHUNK_DATA) {
+        size_t run = n - i;
+        if (state == H_CHUNK_DATA || contentLength >= 0) run = min(run, (size_t)remaining);
+        JsonStreamResult r = json->feed((const char*)buf + i, run);
+        bodyBytes += run;
+        i += run;
+        if (state == H_CHUNK_DATA || contentLength >= 0) {
+          remaining -= run;
+          if (remaining == 0) state = state == H_CHUNK_DATA ? H_CHUNK_CRLF : H_DONE;
+        }
+        if (r != JSON_STREAM_MORE) return r;
+        continue;
+      }
+
+      char c = buf[i++];
+      if (c == '\r') continue;
+      if (c != '\n') {
+        if (lineLen < HTTP_STREAM_LINE_LEN - 1) line[lineLen++] = c;
+        else lineTruncated = true;
+        continue;
+      }
+      line[lineLen] = '\0';
+      endLine();
+      lineLen = 0;
+      lineTruncated = false;
+    }
+    if (state == H_ERROR) return JSON_STREAM_ERROR;
+    if (!json) return state == H_DONE ? JSON_STREAM_DONE : JSON_STREAM_MORE;
+    if (state == H_DONE && json->result == JSON_STREAM_MORE) {
+      return bodyless() ? JSON_STREAM_DONE : JSON_STREAM_ERROR;   // Else body cut short
+    }
+    return state >= H_CHUNK_SIZE ? json->result : JSON_STREAM_MORE;
+  }
+
+  // ---- Internals ----
+
+  static bool startsWithNoCase(const char* s, const char* prefix) {
+    for (; *prefix; s++, prefix++) {
+      if (tolower((uint8_t)*s) != *prefix) return false;
+    }
+    return true;
+  }
+
+  static const char* headerValue(const char* s) {
+    while (*s && *s != ':') s++;
+    if (*s) s++;
+    while (*s == ' ' || *s == '\t') s++;
+    return s;
+  }
+
+  void startBody() {
+    if (!json || bodyless()) {
+      state = H_DONE;   // Headers only
+    } else if (chunked) {
+      state = H_CHUNK_SIZE;
+    } else if (contentLength == 0) {
+      state = H_DONE;
+    } else {
+      state = H_BODY;
+      remaining = contentLength > 0 ? contentLength : 0;
+    }
+  }
+
+  void endLine() {
+    switch (state) {
+      case H_STATUS:
+        // "HTTP/1.1 200 OK"
+        if (strncmp(line, "HTTP/", 5) != 0) { state = H_ERROR; return; }
+        {
+          const char* sp = strchr(line, ' ');
+          status = sp ? atoi(sp + 1) : 0;
+        }
+        connectionClose = strncmp(line + 5, "1.0", 3) == 0;   // 1.0 closes unless told otherwise
+        state = H_HEADER;
+        return;
+
+      case H_HEADER:
+        if (lineLen == 0) {
+          startBody();
+        } else if (startsWithNoCase(line, "content-length:")) {
+          contentLength = atol(headerValue(line));
+        } else if (startsWithNoCase(line, "transfer-encoding:")) {
+          chunked = startsWithNoCase(headerValue(line), "chunked");
+        } else if (startsWithNoCase(line, "connection:")) {
+          const char* v = headerValue(line);
+          if (startsWithNoCase(v, "close")) connectionClose = true;
+          else if (startsWithNoCase(v, "keep-alive")) connectionClose = false;
+        }
+        if (lineLen && headerHandler) headerHandler(line, lineTruncated, headerCtx);
+        return;
+
+      case H_CHUNK_SIZE:
+        if (lineLen == 0) return;   // Tolerate a stray blank line
+        remaining = strtoul(line, nullptr, 16);
+        state = remaining ? H_CHUNK_DATA : H_TRAILER;
+        return;
+
+      case H_CHUNK_CRLF:
+        state = H_CHUNK_SIZE;
+        return;
+
+      case H_TRAILER:
+        if (lineLen == 0) state = H_DONE;   // Trailer fields themselves are ignored
+        return;
+    }
+  }
+};
+
+#endif // HTTP_STREAM_H
@@ -18,6 +18,9 @@
 //
 // Architecture: weather is page 0. Tap to cycle future pages.
 // Uses the same double-buffered canvas as bot mode for flicker-free rendering.
+// Once a page is up it stays in the canvas: until the weather, WiFi state or
+// page changes, a frame only restores the patch under the mini eyes, redraws
+// them and sends that rectangle to the panel.
 // ============================================================================
 
 #if defined(DISPLAY_LCD_ONLY) || defined(DISPLAY_DUAL)
@@ -38,6 +41,12 @@ extern bool menuVisible;
 #define MINI_EYE_SPACING  21      // Distance from center to each eye
 #define MINI_PUPIL_R      6       // Pupil radius
 
+// Everything renderMiniEyes() can touch, with a pixel of margin
+#define MINI_EYE_BOX_X    (MINI_EYE_CX - MINI_EYE_SPACING - MINI_EYE_W - 1)
+#define MINI_EYE_BOX_Y    (MINI_EYE_CY - MINI_EYE_H - 1)
+#define MINI_EYE_BOX_W    ((MINI_EYE_SPACING + MINI_EYE_W + 1) * 2 + 1)
+#define MINI_EYE_BOX_H    ((MINI_EYE_H + 1) * 2 + 1)
+
 // Transition timing
 #define INFO_TRANSITION_MS     600   // Shrink/expand animation duration
 #define INFO_PRE_TRANSITION_MS 500   // Time for thinking expression before shrink
@@ -416,6 +425,41 @@ void renderWeatherPage() {
   renderForecastBars();
 }
 
+// ============================================================================
+// Page Cache
+// ============================================================================
+// The canvas keeps the last full frame, so the page itself is the cache;
+// infoEyePatch holds what the page has under the mini eyes.
+// ============================================================================
+
+static uint16_t infoEyePatch[MINI_EYE_BOX_W * MINI_EYE_BOX_H];
+static bool     infoPageCached = false;
+static uint16_t infoPageGen;
+static bool     infoPageWifi;
+static uint8_t  infoPageShown;
+
+// True if the canvas still holds the page this frame would draw
+static bool infoPageCurrent() {
+  return infoPageCached && gfx->canvasPersists() &&
+         infoPageGen == weatherData.generation &&
+         infoPageWifi == sysStatus.staConnected &&
+         infoPageShown == infoMode.currentPage;
+}
+
+// Draw the page (everything but the eyes) and remember what it was drawn from
+static void renderInfoPage() {
+  infoPageGen = weatherData.generation;   // Before drawing — a change mid-draw redraws
+  infoPageWifi = sysStatus.staConnected;
+  infoPageShown = infoMode.currentPage;
+  renderWeatherPage();
+  renderPageDots(infoMode.currentPage, INFO_PAGE_COUNT);
+  if (gfx->canvasPersists()) {
+    gfx->readCanvasRect(MINI_EYE_BOX_X, MINI_EYE_BOX_Y, MINI_EYE_BOX_W, MINI_EYE_BOX_H,
+                        infoEyePatch);
+    infoPageCached = true;
+  }
+}
+
 // ============================================================================
 // Render Transition Animation
 // ============================================================================
@@ -511,13 +555,28 @@ void renderInfoTransition(float t, bool entering) {
 
 void renderInfoMode() {
   if (gfx == nullptr) return;
-  if (menuVisible) return;
+  if (menuVisible) {
+    infoPageCached = false;   // The menu draws straight to the panel
+    return;
+  }
 
   // Begin double-buffered frame (both targets use DisplayProxy with LGFX_Sprite)
   gfx->beginCanvas();
 
+  if (infoMode.state == INFO_ACTIVE && infoPageCurrent()) {
+    // Page unchanged — only the mini eyes move
+    gfx->pushCanvasRect(MINI_EYE_BOX_X, MINI_EYE_BOX_Y, MINI_EYE_BOX_W, MINI_EYE_BOX_H,
+                        infoEyePatch);
+    renderMiniEyes(infoMode.miniEyes.blinkAmount,
+                   infoMode.miniEyes.pupilX,
+                   infoMode.miniEyes.pupilY);
+    gfx->flushCanvasRect(MINI_EYE_BOX_X, MINI_EYE_BOX_Y, MINI_EYE_BOX_W, MINI_EYE_BOX_H);
+    return;
+  }
+
   // Clear canvas
   gfx->fillScreen(BOT_COLOR_BG);
+  infoPageCached = false;
 
   switch (infoMode.state) {
     case INFO_PRE_ENTER:
@@ -539,14 +598,12 @@ void renderInfoMode() {
     }
 
     case INFO_ACTIVE:
-      // Render weather content
-      renderWeatherPage();
+      // Weather content and page dots
+      renderInfoPage();
       // Render mini eyes on top
       renderMiniEyes(infoMode.miniEyes.blinkAmount,
                      infoMode.miniEyes.pupilX,
                      infoMode.miniEyes.pupilY);
-      // Page dots
-      renderPageDots(infoMode.currentPage, INFO_PAGE_COUNT);
       break;
 
     case INFO_EXITING: {
@@ -0,0 +1,371 @@
+#ifndef JSON_STREAM_H
+#define JSON_STREAM_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// JSON Stream — byte-at-a-time JSON field extractor, no heap
+// ============================================================================
+// Parses JSON as it arrives from a socket and calls a handler for every
+// scalar (and every closing } or ]) together with the path it sits at, so a
+// caller can pick a few fields out of a multi-KB document without ever
+// holding it in memory. The handler matches paths with at():
+//
+//   "seg/0/fx"                 object key "seg", array element 0, key "fx"
+//   "daily/temperature_2m_max/*"   * matches any key or index
+//
+// State is a fixed-size struct: a stack of up to JSON_STREAM_MAX_DEPTH path
+// components (keys truncated to JSON_STREAM_KEY_LEN - 1 chars) and one value
+// window of JSON_STREAM_VALUE_LEN - 1 chars. Deeper levels are still parsed
+// correctly but never match a path; longer values are truncated
+// (valueTruncated is set). \uXXXX escapes decode to '?'.
+//
+// The handler returns false to stop early — e.g. once seg[0] has closed there
+// is nothing left worth reading and the socket can be dropped.
+// ============================================================================
+
+#define JSON_STREAM_MAX_DEPTH   8     // Path components kept for matching
+#define JSON_STREAM_MAX_NEST    32    // Hard nesting limit (arrayBits)
+#define JSON_STREAM_KEY_LEN     32    // Fits Open-Meteo's "precipitation_probability_max"
+#define JSON_STREAM_VALUE_LEN   48
+
+enum JsonEvent : uint8_t {
+  JSON_EV_VALUE = 0,   // A scalar: value/valueType hold it, path is its location
+  JSON_EV_END,         // A container closed: path is the container's location
+};
+
+enum JsonValueType : uint8_t {
+  JSON_STRING = 0,
+  JSON_NUMBER,
+  JSON_BOOL,
+  JSON_NULL,
+};
+
+enum JsonStreamResult : uint8_t {
+  JSON_STREAM_MORE = 0,   // Feed more bytes
+  JSON_STREAM_DONE,       // Root value complete
+  JSON_STREAM_STOPPED,    // Handler asked to stop
+  JSON_STREAM_ERROR,      // Malformed input
+};
+
+struct JsonStream;
+
+// Called per scalar / closed container. Return false to stop parsing.
+typedef bool (*JsonStreamHandler)(JsonStream& js, void* ctx);
+
+struct JsonStream {
+  struct Level {
+    uint16_t index;                   // Array element, or 0 in objects
+    char key[JSON_STREAM_KEY_LEN];    // Object key, "" in arrays
+  };
+
+  // Current event, valid inside the handler
+  JsonEvent event;
+  JsonValueType valueType;
+  char value[JSON_STREAM_VALUE_LEN];
+  uint8_t valueLen;
+  bool valueTruncated;
+
+  // Path: stack[0..depth-1], only the first JSON_STREAM_MAX_DEPTH stored
+  Level stack[JSON_STREAM_MAX_DEPTH];
+  uint8_t depth;
+  uint32_t arrayBits;                 // Bit n set = level n is an array
+
+  JsonStreamHandler handler;
+  void* ctx;
+  uint8_t state;
+  uint8_t keyLen;
+  uint8_t unicodeLeft;                // Hex digits of a \u escape still to skip
+  bool escape;
+  JsonStreamResult result;
+  uint32_t bytes;                     // Fed so far
+
+  enum : uint8_t {
+    S_VALUE = 0,       // Expect a value
+    S_VALUE_OR_END,    // After '[': a value or ']'
+    S_KEY_OR_END,      // After '{': a key or '}'
+    S_KEY_START,       // After ',' in an object: a key
+    S_KEY,             // Inside a key string
+    S_COLON,           // After a key
+    S_STRING,          // Inside a string value
+    S_LITERAL,         // Inside a number / true / false / null
+    S_AFTER,           // After a value: ',' or a close
+  };
+
+  void begin(JsonStreamHandler h, void* c) {
+    handler = h;
+    ctx = c;
+    depth = 0;
+    arrayBits = 0;
+    state = S_VALUE;
+    keyLen = 0;
+    unicodeLeft = 0;
+    escape = false;
+    valueLen = 0;
+    value[0] = '\0';
+    valueTruncated = false;
+    result = JSON_STREAM_MORE;
+    bytes = 0;
+  }
+
+  // Feed a chunk. Keeps returning the final result once done, stopped or
+  // broken, so callers can feed blindly and check once.
+  JsonStreamResult feed(const char* buf, size_t n) {
+    for (size_t i = 0; i < n && result == JSON_STREAM_MORE; i++) {
+      bytes++;
+      step(buf[i]);
+    }
+    return result;
+  }
+
+  // ---- Handler helpers ----
+
+  // Does the current path match? Components separated by '/', '*' = any.
+  bool at(const char* path) const {
+    return matchPrefix(path) == depth;
+  }
+
+  // Is the current value a direct member of the container at path? Lets one
+  // handler read "seg/0/*" keys whether the document is /json/state or a
+  // WebSocket push that wraps it in {"state": ...}.
+  bool childOf(const char* path) const {
+    return depth > 0 && matchPrefix(path) == depth - 1;
+  }
+
+  // Array index / object key at a level (0 = outermost)
+  uint16_t indexAt(uint8_t lvl) const {
+    return lvl < depth && lvl < JSON_STREAM_MAX_DEPTH ? stack[lvl].index : 0;
+  }
+  const char* keyAt(uint8_t lvl) const {
+    return lvl < depth && lvl < JSON_STREAM_MAX_DEPTH ? stack[lvl].key : "";
+  }
+
+  long asInt() const { return atol(value); }
+  float asFloat() const { return atof(value); }
+  bool asBool() const { return valueType == JSON_BOOL && value[0] == 't'; }
+  bool isNull() const { return valueType == JSON_NULL; }
+
+  // Copy the (string) value, always terminated
+  void copyValue(char* out, size_t size) const {
+    if (size == 0) return;
+    size_t n = min((size_t)valueLen, size - 1);
+    memcpy(out, value, n);
+    out[n] = '\0';
+  }
+
+  // ---- Parser internals ----
+
+  // Levels of the current path matched by all of `path`, or -1 on a mismatch
+  int16_t matchPrefix(const char* path) const {
+    uint8_t lvl = 0;
+    const char* p = path;
+    while (*p) {
+      if (lvl >= depth || lvl >= JSON_STREAM_MAX_DEPTH) return -1;
+      const char* end = p;
+      while (*end && *end != '/') end++;
+      size_t len = end - p;
+      if (!(len == 1 && *p == '*')) {
+        if (isArray(lvl)) {
+          uint16_t idx = 0;
+          for (const char* d = p; d < end; d++) {
+            if (*d < '0' || *d > '9') return -1;
+            idx = idx * 10 + (*d - '0');
+          }
+          if (len == 0 || idx != stack[lvl].index) return -1;
+        } else if (strncmp(stack[lvl].key, p, len) != 0 || stack[lvl].key[len] != '\0') {
+          return -1;
+        }
+      }
+      lvl++;
+      p = *end ? end + 1 : end;
+    }
+    return lvl;
+  }
+
+  bool isArray(uint8_t lvl) const {
+    return (arrayBits >> lvl) & 1;
+  }
+
+  void fail() {
+    result = JSON_STREAM_ERROR;
+  }
+
+  void emit(JsonEvent ev) {
+    event = ev;
+    if (handler && !handler(*this, ctx)) result = JSON_STREAM_STOPPED;
+  }
+
+  void emitValue(JsonValueType type) {
+    value[valueLen] = '\0';
+    valueType = type;
+    emit(JSON_EV_VALUE);
+    valueLen = 0;
+    valueTruncated = false;
+    state = S_AFTER;
+    if (depth == 0 && result == JSON_STREAM_MORE) result = JSON_STREAM_DONE;
+  }
+
+  void appendValue(char c) {
+    if (valueLen < JSON_STREAM_VALUE_LEN - 1) value[valueLen++] = c;
+    else valueTruncated = true;
+  }
+
+  void push(bool array) {
+    if (depth >= JSON_STREAM_MAX_NEST) { fail(); return; }
+    if (array) arrayBits |= 1UL << depth;
+    else arrayBits &= ~(1UL << depth);
+    if (depth < JSON_STREAM_MAX_DEPTH) {
+      stack[depth].index = 0;
+      stack[depth].key[0] = '\0';
+    }
+    depth++;
+    state = array ? S_VALUE_OR_END : S_KEY_OR_END;
+  }
+
+  void pop(bool array) {
+    if (depth == 0 || isArray(depth - 1) != array) { fail(); return; }
+    depth--;
+    state = S_AFTER;
+    valueLen = 0;
+    value[0] = '\0';
+    emit(JSON_EV_END);
+    if (depth == 0 && result == JSON_STREAM_MORE) result = JSON_STREAM_DONE;
+  }
+
+  // Start a value at c. Returns false if c can't start one.
+  bool startValue(char c) {
+    switch (c) {
+      case '{': push(false); return true;
+      case '[': push(true); return true;
+      case '"':
+        state = S_STRING;
+        valueLen = 0;
+        return true;
+      default:
+        if ((c >= '0' && c <= '9') || c == '-' || c == 't' || c == 'f' || c == 'n') {
+          state = S_LITERAL;
+          valueLen = 0;
+          appendValue(c);
+          return true;
+        }
+        return false;
+    }
+  }
+
+  static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+  }
+
+  // Next character of a string body with escapes resolved, or -1 if the
+  // character produced nothing (escape prefix or \u digit)
+  int16_t unescape(char c) {
+    if (unicodeLeft) {
+      unicodeLeft--;
+      return unicodeLeft == 0 ? '?' : -1;
+    }
+    if (escape) {
+      escape = false;
+      switch (c) {
+        case 'n': return '\n';
+        case 't': return '\t';
+        case 'r': return '\r';
+        case 'b': return '\b';
+        case 'f': return '\f';
+        case 'u': unicodeLeft = 4; return -1;
+        default:  return (uint8_t)c;   // \" \\ \/
+      }
+    }
+    if (c == '\\') {
+      escape = true;
+      return -1;
+    }
+    return (uint8_t)c;
+  }
+
+  void step(char c) {
+    switch (state) {
+      case S_VALUE_OR_END:
+        if (isSpace(c)) return;
+        if (c == ']') { pop(true); return; }
+        if (!startValue(c)) fail();
+        return;
+
+      case S_VALUE:
+        if (isSpace(c)) return;
+        if (!startValue(c)) fail();
+        return;
+
+      case S_KEY_OR_END:
+        if (isSpace(c)) return;
+        if (c == '}') { pop(false); return; }
+        // fallthrough
+      case S_KEY_START:
+        if (isSpace(c)) return;
+        if (c != '"') { fail(); return; }
+        state = S_KEY;
+        keyLen = 0;
+        return;
+
+      case S_KEY: {
+        if (c == '"' && !escape && !unicodeLeft) {
+          if (depth <= JSON_STREAM_MAX_DEPTH) stack[depth - 1].key[keyLen] = '\0';
+          state = S_COLON;
+          return;
+        }
+        int16_t ch = unescape(c);
+        if (ch >= 0 && depth <= JSON_STREAM_MAX_DEPTH && keyLen < JSON_STREAM_KEY_LEN - 1) {
+          stack[depth - 1].key[keyLen++] = (char)ch;
+        }
+        return;
+      }
+
+      case S_COLON:
+        if (isSpace(c)) return;
+        if (c != ':') { fail(); return; }
+        state = S_VALUE;
+        return;
+
+      case S_STRING: {
+        if (c == '"' && !escape && !unicodeLeft) {
+          emitValue(JSON_STRING);
+          return;
+        }
+        int16_t ch = unescape(c);
+        if (ch >= 0) appendValue((char)ch);
+        return;
+      }
+
+      case S_LITERAL:
+        if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+            c == '-' || c == '+' || c == '.' || c == 'E') {
+          appendValue(c);
+          return;
+        }
+        value[valueLen] = '\0';
+        emitValue(value[0] == 't' || value[0] == 'f' ? JSON_BOOL :
+                  value[0] == 'n' ? JSON_NULL : JSON_NUMBER);
+        if (result != JSON_STREAM_MORE) return;
+        step(c);   // The terminator belongs to the container
+        return;
+
+      case S_AFTER:
+        if (isSpace(c)) return;
+        if (depth == 0) { fail(); return; }
+        if (c == ',') {
+          if (isArray(depth - 1)) {
+            if (depth <= JSON_STREAM_MAX_DEPTH) stack[depth - 1].index++;
+            state = S_VALUE;
+          } else {
+            state = S_KEY_START;
+          }
+          return;
+        }
+        if (c == '}') { pop(false); return; }
+        if (c == ']') { pop(true); return; }
+        fail();
+        return;
+    }
+  }
+};
+
+#endif // JSON_STREAM_H
@@ -0,0 +1,298 @@
+#ifndef MESH_PROTOCOL_H
+#define MESH_PROTOCOL_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// Mesh Protocol — typed, versioned ESP-NOW messages
+// ============================================================================
+// Every mesh frame starts with a 5-byte MeshHeader (version, type, sender,
+// sequence) followed by a type-specific payload. Receivers look the type up
+// in a small registry that holds the handler and the allowed payload length,
+// so new message kinds (clock sync, WLED leases, ...) plug in with one
+// meshRegisterMsg() call instead of growing a length/magic-byte switch.
+//
+// State travels three ways:
+//   MESH_MSG_STATE  full MeshState keyframe, every MESH_BROADCAST_INTERVAL_MS
+//   MESH_MSG_DELTA  changed fields only (16-bit field mask + values), sent
+//                   shortly after a discrete field changes
+//   MESH_MSG_EVENT  immediate absolute updates — expression change, WLED
+//                   claim/release, scheduler claim/release
+//
+// Frames of the MESH_RELAY_TYPES are re-broadcast inside a MESH_MSG_RELAY
+// envelope so bots beyond radio range still hear them (esp_now_mesh.h).
+//
+// This file is pure encode/decode with no radio or RTOS dependencies.
+// ============================================================================
+
+// Protocol version — increment on wire format change (v1 = fixed 24-byte packet)
+#define MESH_PROTOCOL_VERSION 2
+
+#define MESH_MAX_FRAME     250     // ESP_NOW_MAX_DATA_LEN
+#define MESH_MAX_MSG_TYPES 16
+
+enum MeshMsgType : uint8_t {
+  MESH_MSG_STATE = 1,
+  MESH_MSG_DELTA,
+  MESH_MSG_EVENT,
+  MESH_MSG_SYNC_REQ,
+  MESH_MSG_SYNC_RESP,
+  MESH_MSG_PLAY_AT,
+  MESH_MSG_WLED_LEASE,     // wled_lease.h
+  MESH_MSG_RELAY,          // MeshRelayHeader + another node's frame
+};
+
+// Types that are flooded beyond the first radio cell. Clock sync is not:
+// its round trip only means something between direct neighbours, so the
+// mesh-wide timebase is passed on hop by hop instead (esp_now_mesh.h).
+#define MESH_RELAY_TYPES ((1 << MESH_MSG_STATE) | (1 << MESH_MSG_DELTA) | (1 << MESH_MSG_EVENT) | \
+                          (1 << MESH_MSG_PLAY_AT) | (1 << MESH_MSG_WLED_LEASE))
+
+inline bool meshRelayable(uint8_t type) {
+  return type < 32 && (MESH_RELAY_TYPES & (1UL << type));
+}
+
+struct __attribute__((packed)) MeshHeader {
+  uint8_t  version;        // MESH_PROTOCOL_VERSION
+  uint8_t  type;           // MeshMsgType
+  uint8_t  deviceId;       // Last byte of MAC address (unique enough for local mesh)
+  uint16_t seq;            // Per-sender frame counter (gap = lost frames)
+};
+
+static_assert(sizeof(MeshHeader) == 5, "MeshHeader must be 5 bytes");
+
+// Node id: 32-bit FNV-1a over the MAC, never 0. The header's deviceId (the
+// last MAC byte) collides once a few dozen bots share a mesh; payloads that
+// name a bot (clock sync, play-at, leases) carry this instead.
+inline uint32_t meshNodeId(const uint8_t* mac) {
+  uint32_t h = 2166136261u;
+  for (uint8_t i = 0; i < 6; i++) {
+    h = (h ^ mac[i]) * 16777619u;
+  }
+  return h ? h : 1;
+}
+
+// Short form of a node id, for the neighbour lists in relay envelopes
+inline uint16_t meshShortId(uint32_t nodeId) {
+  return (uint16_t)(nodeId ^ (nodeId >> 16));
+}
+
+// Relay envelope. The outer header names the relaying node; the inner frame
+// keeps the origin's header untouched, so (origin MAC, seq) identifies it on
+// every hop. Between the two sit nbrCount uint16 short ids of the relaying
+// node's direct neighbours — who this copy already reached.
+#define MESH_RELAY_NBR_MAX 12      // Short ids listed per forward (a subset if more)
+
+struct __attribute__((packed)) MeshRelayHeader {
+  uint8_t  ttl;            // Forwards left after this one
+  uint8_t  hops;           // Relays so far, including the sender of this copy
+  uint8_t  origin[6];      // Origin MAC — peers are keyed by MAC
+  uint8_t  nbrCount;       // Neighbour short ids that follow
+};
+
+static_assert(sizeof(MeshRelayHeader) == 9, "MeshRelayHeader must be 9 bytes");
+
+// ============================================================================
+// MeshState — bot identity, expression, sensors, WLED flags (21 bytes)
+// ============================================================================
+
+#define MESH_STATE_WLED_ACTIVE  0x01   // Sending DDP to wledIP
+#define MESH_STATE_SCHED_OWNER  0x02   // Owns scheduled content on wledIP
+
+struct __attribute__((packed)) MeshState {
+  uint8_t  expression;     // Current facial expression index
+  uint8_t  botState;       // BOT_ACTIVE=0, BOT_IDLE=1, etc.
+  uint8_t  battery;        // Battery % (0 for USB-powered, future use)
+  uint8_t  mode;           // Current mode (MODE_BOT=0)
+  uint8_t  effect;         // Current ambient effect index
+  uint8_t  palette;        // Current palette index
+
+  int16_t  pitch;          // Orientation pitch × 100 (degrees)
+  int16_t  roll;           // Orientation roll × 100 (degrees)
+  uint16_t heading;        // Compass heading (0-359, or 0xFFFF if unavailable)
+
+  uint8_t  audioLevel;     // Mic audio level (0-255)
+  uint8_t  proximity;      // Proximity sensor raw (0-255)
+  uint16_t ambientLux;     // Ambient light (lux)
+
+  uint8_t  flags;          // MESH_STATE_*
+  uint32_t wledIP;         // WLED target, host order (0 = none)
+};
+
+static_assert(sizeof(MeshState) == 21, "MeshState must be 21 bytes");
+
+// Field table for delta encoding — bit i of the mask = meshStateFields[i]
+struct MeshStateField {
+  uint8_t offset;
+  uint8_t size;
+};
+
+static const MeshStateField meshStateFields[] = {
+  { offsetof(MeshState, expression), 1 },   // 0
+  { offsetof(MeshState, botState),   1 },   // 1
+  { offsetof(MeshState, battery),    1 },   // 2
+  { offsetof(MeshState, mode),       1 },   // 3
+  { offsetof(MeshState, effect),     1 },   // 4
+  { offsetof(MeshState, palette),    1 },   // 5
+  { offsetof(MeshState, pitch),      2 },   // 6
+  { offsetof(MeshState, roll),       2 },   // 7
+  { offsetof(MeshState, heading),    2 },   // 8
+  { offsetof(MeshState, audioLevel), 1 },   // 9
+  { offsetof(MeshState, proximity),  1 },   // 10
+  { offsetof(MeshState, ambientLux), 2 },   // 11
+  { offsetof(MeshState, flags),      1 },   // 12
+  { offsetof(MeshState, wledIP),     4 },   // 13
+};
+
+#define MESH_STATE_FIELD_COUNT (sizeof(meshStateFields) / sizeof(meshStateFields[0]))
+
+// Discrete fields worth a delta as soon as they change. Sensor fields jitter
+// constantly and ride along on the periodic keyframe instead.
+#define MESH_DELTA_FIELDS ((1 << 1) | (1 << 3) | (1 << 4) | (1 << 5) | (1 << 12) | (1 << 13))
+
+// Encode fields that differ between base and cur (restricted to fieldMask).
+// Returns payload length, or 0 if nothing changed.
+uint8_t meshEncodeDelta(const MeshState& base, const MeshState& cur, uint16_t fieldMask,
+                        uint8_t* out) {
+  const uint8_t* b = (const uint8_t*)&base;
+  const uint8_t* c = (const uint8_t*)&cur;
+  uint16_t mask = 0;
+  uint8_t len = 2;
+  for (uint8_t i = 0; i < MESH_STATE_FIELD_COUNT; i++) {
+    if (!(fieldMask & (1 << i))) continue;
+    const MeshStateField& f = meshStateFields[i];
+    if (memcmp(b + f.offset, c + f.offset, f.size) == 0) continue;
+    mask |= (1 << i);
+    memcpy(out + len, c + f.offset, f.size);
+    len += f.size;
+  }
+  if (mask == 0) return 0;
+  out[0] = mask & 0xFF;
+  out[1] = mask >> 8;
+  return len;
+}
+
+// Apply a delta payload. Rejects (and leaves state untouched) unless the
+// mask only names known fields and the length matches exactly.
+bool meshApplyDelta(MeshState& state, const uint8_t* payload, uint8_t len) {
+  if (len < 2) return false;
+  uint16_t mask = payload[0] | (payload[1] << 8);
+  if (mask == 0 || (mask >> MESH_STATE_FIELD_COUNT) != 0) return false;
+
+  uint8_t need = 2;
+  for (uint8_t i = 0; i < MESH_STATE_FIELD_COUNT; i++) {
+    if (mask & (1 << i)) need += meshStateFields[i].size;
+  }
+  if (need != len) return false;
+
+  uint8_t* s = (uint8_t*)&state;
+  uint8_t pos = 2;
+  for (uint8_t i = 0; i < MESH_STATE_FIELD_COUNT; i++) {
+    if (!(mask & (1 << i))) continue;
+    const MeshStateField& f = meshStateFields[i];
+    memcpy(s + f.offset, payload + pos, f.size);
+    pos += f.size;
+  }
+  return true;
+}
+
+// ============================================================================
+// MeshEvent — immediate absolute updates (6 bytes)
+// ============================================================================
+
+enum MeshEventType : uint8_t {
+  MESH_EVT_EXPRESSION = 1,   // arg = expression index
+  MESH_EVT_WLED_CLAIM,       // arg = WLED IP — started sending DDP
+  MESH_EVT_WLED_RELEASE,     // arg = WLED IP — stopped
+  MESH_EVT_SCHED_CLAIM,      // arg = WLED IP — took scheduled content
+  MESH_EVT_SCHED_RELEASE,    // arg = WLED IP
+};
+
+struct __attribute__((packed)) MeshEvent {
+  uint8_t  event;          // MeshEventType
+  uint8_t  reserved;
+  uint32_t arg;
+};
+
+// Apply an event to a cached peer state. Returns false for unknown events.
+bool meshApplyEvent(MeshState& state, const MeshEvent& ev) {
+  switch (ev.event) {
+    case MESH_EVT_EXPRESSION:
+      state.expression = (uint8_t)ev.arg;
+      return true;
+    case MESH_EVT_WLED_CLAIM:
+      state.flags |= MESH_STATE_WLED_ACTIVE;
+      state.wledIP = ev.arg;
+      return true;
+    case MESH_EVT_WLED_RELEASE:
+      state.flags &= ~MESH_STATE_WLED_ACTIVE;
+      return true;
+    case MESH_EVT_SCHED_CLAIM:
+      state.flags |= MESH_STATE_SCHED_OWNER;
+      state.wledIP = ev.arg;
+      return true;
+    case MESH_EVT_SCHED_RELEASE:
+      state.flags &= ~MESH_STATE_SCHED_OWNER;
+      return true;
+  }
+  return false;
+}
+
+// ============================================================================
+// Message Registry & Dispatch
+// ============================================================================
+
+typedef void (*MeshMsgHandler)(const uint8_t* mac, const MeshHeader& hdr,
+                               const uint8_t* payload, uint8_t len, int64_t rxUs);
+
+struct MeshMsgTypeInfo {
+  MeshMsgHandler handler;
+  uint8_t        minLen;   // Payload bytes
+  uint8_t        maxLen;
+};
+
+static MeshMsgTypeInfo meshMsgTypes[MESH_MAX_MSG_TYPES] = {};
+
+bool meshRegisterMsg(uint8_t type, uint8_t minLen, uint8_t maxLen, MeshMsgHandler handler) {
+  if (type == 0 || type >= MESH_MAX_MSG_TYPES || handler == nullptr) return false;
+  if (minLen > maxLen || maxLen > MESH_MAX_FRAME - sizeof(MeshHeader)) return false;
+  meshMsgTypes[type] = { handler, minLen, maxLen };
+  return true;
+}
+
+enum MeshDecodeResult : uint8_t {
+  MESH_DECODE_OK = 0,
+  MESH_DECODE_SHORT,       // Shorter than a header
+  MESH_DECODE_VERSION,     // Other protocol version (incl. v1 24-byte packets)
+  MESH_DECODE_TYPE,        // Unregistered type
+  MESH_DECODE_LENGTH,      // Payload length outside the type's bounds
+};
+
+// Validate a frame and split it into header + payload. Never reads past len.
+MeshDecodeResult meshDecode(const uint8_t* data, int len, MeshHeader& hdr,
+                            const uint8_t*& payload, uint8_t& payloadLen) {
+  if (data == nullptr || len < (int)sizeof(MeshHeader)) return MESH_DECODE_SHORT;
+  memcpy(&hdr, data, sizeof(MeshHeader));
+  if (hdr.version != MESH_PROTOCOL_VERSION) return MESH_DECODE_VERSION;
+  if (hdr.type == 0 || hdr.type >= MESH_MAX_MSG_TYPES ||
+      meshMsgTypes[hdr.type].handler == nullptr) {
+    return MESH_DECODE_TYPE;
+  }
+  int plen = len - (int)sizeof(MeshHeader);
+  const MeshMsgTypeInfo& info = meshMsgTypes[hdr.type];
+  if (plen < info.minLen || plen > info.maxLen) return MESH_DECODE_LENGTH;
+  payload = data + sizeof(MeshHeader);
+  payloadLen = (uint8_t)plen;
+  return MESH_DECODE_OK;
+}
+
+// Build header + payload into out (at least sizeof(MeshHeader) + len bytes)
+uint8_t meshEncodeFrame(uint8_t* out, uint8_t type, uint8_t deviceId, uint16_t seq,
+                        const void* payload, uint8_t len) {
+  MeshHeader hdr = { MESH_PROTOCOL_VERSION, type, deviceId, seq };
+  memcpy(out, &hdr, sizeof(hdr));
+  if (len) memcpy(out + sizeof(hdr), payload, len);
+  return sizeof(hdr) + len;
+}
+
+#endif // MESH_PROTOCOL_H
@@ -0,0 +1,452 @@
+#ifndef MIDI_SCHEDULER_H
+#define MIDI_SCHEDULER_H
+
+#ifdef MIDI_SYNTH_ENABLED
+
+#include <Arduino.h>
+#include <atomic>
+#include "esp_timer.h"
+#include "config.h"
+
+// ============================================================================
+// MIDI Scheduler — timer-driven event output for the SAM2695
+// ============================================================================
+// Replaces frame-polled note firing (jitter = one render frame, 33ms+) and
+// blocking delay()s with two small Core 0 tasks:
+//
+//   midi_sched  Owns all timing. Sleeps until an esp_timer one-shot fires at
+//               the exact microsecond of the next due message, then encodes
+//               every due note-on / note-off / control message into the
+//               byte ring and re-arms the timer.
+//   midi_tx     Sole owner of Serial2. Drains the byte ring to the UART and
+//               is the only place that may block on the 31250 baud link.
+//
+// The render core only posts commands (play sequence, stop, all notes off,
+// raw message with a delay) to a FreeRTOS queue — it never writes the UART
+// or waits.
+// Each fired message records |fire time - due time| so jitter is reported
+// per event (lastErrUs / maxErrUs / avgErrUs).
+// ============================================================================
+
+#define MIDI_SCHED_PENDING     48     // Time-ordered pending messages (note-offs, control)
+#define MIDI_SCHED_CMD_QUEUE   16
+#define MIDI_TX_RING           512    // Byte ring (power of two) — ~160ms of 31250 baud
+#define MIDI_MSG_MAX           8      // Longest message (master volume SysEx)
+#define MIDI_SCHED_SLACK_US    200    // Fire messages due within this window together
+#define MIDI_SCHED_STACK       3072
+#define MIDI_TX_STACK          2048
+#define MIDI_SCHED_PRIORITY    4
+#define MIDI_TX_PRIORITY       3
+#define MIDI_PROGRAM_LEAD_MS   15     // SAM2695 settle time after program change
+
+static_assert((MIDI_TX_RING & (MIDI_TX_RING - 1)) == 0, "ring size must be a power of two");
+
+struct MidiMsg {
+  int64_t dueUs;
+  uint8_t len;
+  uint8_t data[MIDI_MSG_MAX];
+  bool    isNoteOff;     // Tracked as an active note (flushed on stop)
+};
+
+enum MidiSchedCmdType : uint8_t {
+  MIDI_SCHED_PLAY = 0,
+  MIDI_SCHED_STOP,
+  MIDI_SCHED_RAW,
+  MIDI_SCHED_HOLDOFF,
+  MIDI_SCHED_ALL_OFF,    // All Notes Off on every channel, one queue slot
+};
+
+struct MidiSchedCmd {
+  MidiSchedCmdType type;
+  const MidiSequenceDef* def;
+  uint32_t delayMs;      // RAW: send this long after processing; HOLDOFF: hold duration
+  MidiMsg  msg;
+};
+
+static portMUX_TYPE midiStatsMux = portMUX_INITIALIZER_UNLOCKED;
+
+struct MidiScheduler {
+  // ---- Byte ring (midi_sched -> midi_tx) ----
+  uint8_t ring[MIDI_TX_RING];
+  std::atomic<uint32_t> head;
+  std::atomic<uint32_t> tail;
+
+  // ---- Owned by midi_sched ----
+  MidiMsg pending[MIDI_SCHED_PENDING];   // Sorted by dueUs (stable)
+  uint8_t pendingCount;
+  const MidiSequenceDef* seq;
+  uint16_t seqIndex;
+  int64_t seqStartUs;
+  MidiEvent nextEv;
+  bool nextEvValid;
+  int64_t holdoffUntilUs;                // Immediate messages wait for this (init/reset)
+
+  // ---- Stats (read anywhere) ----
+  // errSumUs is 64-bit, which the 32-bit cores can't load or store in one go —
+  // it and eventsFired change together under midiStatsMux so avgErrUs()
+  // never sees half an update
+  volatile uint32_t lastErrUs;
+  volatile uint32_t maxErrUs;
+  uint32_t eventsFired;
+  uint64_t errSumUs;
+  volatile uint32_t droppedMsgs;         // Ring or pending list full
+  volatile bool uartReinitRequested;
+
+  QueueHandle_t cmdQueue;
+  TaskHandle_t schedTask;
+  TaskHandle_t txTask;
+  esp_timer_handle_t timer;
+
+  void init() {
+    head.store(0);
+    tail.store(0);
+    pendingCount = 0;
+    seq = nullptr;
+    nextEvValid = false;
+    holdoffUntilUs = 0;
+    lastErrUs = 0;
+    maxErrUs = 0;
+    eventsFired = 0;
+    errSumUs = 0;
+    droppedMsgs = 0;
+    uartReinitRequested = false;
+    schedTask = nullptr;
+    txTask = nullptr;
+    timer = nullptr;
+    cmdQueue = xQueueCreate(MIDI_SCHED_CMD_QUEUE, sizeof(MidiSchedCmd));
+  }
+
+  void start();
+
+  uint32_t avgErrUs() {
+    portENTER_CRITICAL(&midiStatsMux);
+    uint64_t sum = errSumUs;
+    uint32_t n = eventsFired;
+    portEXIT_CRITICAL(&midiStatsMux);
+    return n ? (uint32_t)(sum / n) : 0;
+  }
+
+  // ---- Command posting (any core, never blocks) ----
+
+  bool post(const MidiSchedCmd& cmd) {
+    if (cmdQueue == nullptr || schedTask == nullptr) return false;
+    if (xQueueSend(cmdQueue, &cmd, 0) != pdTRUE) {
+      droppedMsgs++;
+      return false;
+    }
+    xTaskNotifyGive(schedTask);
+    return true;
+  }
+
+  // ---- midi_sched internals ----
+
+  void insertPending(const MidiMsg& m) {
+    if (pendingCount >= MIDI_SCHED_PENDING) {
+      // Full — emit the earliest now to make room (same policy as note stealing)
+      emit(pending[0], esp_timer_get_time(), false);
+      removePending(0);
+    }
+    uint8_t i = pendingCount;
+    while (i > 0 && pending[i - 1].dueUs > m.dueUs) {
+      pending[i] = pending[i - 1];
+      i--;
+    }
+    pending[i] = m;
+    pendingCount++;
+  }
+
+  void removePending(uint8_t idx) {
+    for (uint8_t i = idx; i + 1 < pendingCount; i++) pending[i] = pending[i + 1];
+    pendingCount--;
+  }
+
+  // Copy one message into the byte ring; records timing error if requested
+  void emit(const MidiMsg& m, int64_t nowUs, bool measure) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    uint32_t t = tail.load(std::memory_order_acquire);
+    if (MIDI_TX_RING - (h - t) < m.len) {
+      droppedMsgs++;
+      return;
+    }
+    for (uint8_t i = 0; i < m.len; i++) ring[(h + i) & (MIDI_TX_RING - 1)] = m.data[i];
+    head.store(h + m.len, std::memory_order_release);
+
+    if (measure) {
+      int64_t err = nowUs - m.dueUs;
+      uint32_t e = (uint32_t)(err < 0 ? -err : err);
+      lastErrUs = e;
+      if (e > maxErrUs) maxErrUs = e;
+      portENTER_CRITICAL(&midiStatsMux);
+      errSumUs += e;
+      eventsFired++;
+      portEXIT_CRITICAL(&midiStatsMux);
+    }
+  }
+
+  static MidiMsg makeMsg(int64_t dueUs, uint8_t b0, uint8_t b1, uint8_t b2, uint8_t len) {
+    MidiMsg m;
+    m.dueUs = dueUs;
+    m.len = len;
+    m.data[0] = b0; m.data[1] = b1; m.data[2] = b2;
+    m.isNoteOff = false;
+    return m;
+  }
+
+  void loadNextEvent() {
+    nextEvValid = false;
+    if (!seq || seqIndex >= seq->eventCount) { dropSequence(); return; }
+    memcpy_P(&nextEv, &seq->events[seqIndex], sizeof(MidiEvent));
+    nextEvValid = true;
+  }
+
+  // Let go of the sequence — its events may be freed after this
+  void dropSequence() {
+    if (seq) cloudSequenceRelease(seq);
+    seq = nullptr;
+    nextEvValid = false;
+  }
+
+  int64_t nextEventUs() const {
+    return seqStartUs + (int64_t)nextEv.offsetMs * 1000;
+  }
+
+  // Release every sounding note right away
+  void flushNoteOffs(int64_t nowUs) {
+    uint8_t keep = 0;
+    for (uint8_t i = 0; i < pendingCount; i++) {
+      if (pending[i].isNoteOff) emit(pending[i], nowUs, false);
+      else pending[keep++] = pending[i];
+    }
+    pendingCount = keep;
+  }
+
+  void handleCmd(const MidiSchedCmd& cmd, int64_t nowUs) {
+    switch (cmd.type) {
+      case MIDI_SCHED_PLAY: {
+        flushNoteOffs(nowUs);
+        if (!cmd.def) break;
+        dropSequence();
+        seq = cmd.def;
+        seqIndex = 0;
+        int64_t t0 = max(nowUs, holdoffUntilUs);
+        // Program change for channel 0, then give the SAM2695 time to settle
+        insertPending(makeMsg(t0, 0xB0, 0x00, 0x00, 3));  // Bank select 0
+        MidiMsg pc = makeMsg(t0, 0xC0, seq->defaultProgram & 0x7F, 0, 2);
+        insertPending(pc);
+        seqStartUs = t0 + MIDI_PROGRAM_LEAD_MS * 1000;
+        loadNextEvent();
+        break;
+      }
+      case MIDI_SCHED_STOP:
+        dropSequence();
+        flushNoteOffs(nowUs);
+        break;
+      case MIDI_SCHED_RAW: {
+        MidiMsg m = cmd.msg;
+        m.dueUs = max(nowUs + (int64_t)cmd.delayMs * 1000, holdoffUntilUs);
+        insertPending(m);
+        break;
+      }
+      case MIDI_SCHED_HOLDOFF:
+        holdoffUntilUs = nowUs + (int64_t)cmd.delayMs * 1000;
+        break;
+      case MIDI_SCHED_ALL_OFF: {
+        flushNoteOffs(nowUs);   // Their note-offs would be redundant
+        int64_t t0 = max(nowUs, holdoffUntilUs);
+        for (uint8_t ch = 0; ch < MIDI_MAX_CHANNELS; ch++) {
+          insertPending(makeMsg(t0, 0xB0 | ch, 0x7B, 0x00, 3));   // CC 123 All Notes Off
+        }
+        break;
+      }
+    }
+  }
+
+  void fireSeqEvent(int64_t nowUs) {
+    const MidiEvent& ev = nextEv;
+    int64_t due = nextEventUs();
+    if (!(ev.note == 0 && ev.durationMs == 0)) {
+      uint8_t ch = ev.channel & 0x0F;
+      if (ev.program != 255 && ch != MIDI_CH_PERCUSSION) {
+        emit(makeMsg(due, 0xB0 | ch, 0x00, 0x00, 3), nowUs, false);
+        emit(makeMsg(due, 0xC0 | ch, ev.program & 0x7F, 0, 2), nowUs, false);
+      }
+      emit(makeMsg(due, 0x90 | ch, ev.note & 0x7F, ev.velocity & 0x7F, 3), nowUs, true);
+      MidiMsg off = makeMsg(due + (int64_t)ev.durationMs * 1000, 0x80 | ch, ev.note & 0x7F, 0, 3);
+      off.isNoteOff = true;
+      insertPending(off);
+    }
+    seqIndex++;
+    loadNextEvent();
+  }
+
+  // Fire everything due (within slack); returns true if bytes were queued
+  bool fireDue() {
+    bool any = false;
+    for (;;) {
+      int64_t now = esp_timer_get_time();
+      int64_t limit = now + MIDI_SCHED_SLACK_US;
+      bool pendDue = pendingCount > 0 && pending[0].dueUs <= limit;
+      bool seqDue = nextEvValid && nextEventUs() <= limit;
+      if (!pendDue && !seqDue) break;
+      // At equal times note-offs go first so re-struck notes retrigger
+      if (pendDue && (!seqDue || pending[0].dueUs <= nextEventUs())) {
+        emit(pending[0], now, true);
+        removePending(0);
+      } else {
+        fireSeqEvent(now);
+      }
+      any = true;
+    }
+    return any;
+  }
+
+  void armTimer() {
+    int64_t next = INT64_MAX;
+    if (pendingCount > 0) next = pending[0].dueUs;
+    if (nextEvValid) next = min(next, nextEventUs());
+    esp_timer_stop(timer);  // Not running is fine
+    if (next == INT64_MAX) return;
+    int64_t delta = next - esp_timer_get_time();
+    esp_timer_start_once(timer, delta > 50 ? (uint64_t)delta : 50);
+  }
+
+  // ---- midi_tx internals ----
+
+  void drainToUart() {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t h = head.load(std::memory_order_acquire);
+    while (t != h) {
+      uint32_t idx = t & (MIDI_TX_RING - 1);
+      uint32_t n = min(h - t, (uint32_t)(MIDI_TX_RING - idx));  // Contiguous chunk
+      Serial2.write(&ring[idx], n);
+      t += n;
+      tail.store(t, std::memory_order_release);
+      h = head.load(std::memory_order_acquire);
+    }
+  }
+};
+
+// Global instance
+MidiScheduler midiScheduler;
+
+static StackType_t midiSchedStack[MIDI_SCHED_STACK];
+static StaticTask_t midiSchedTCB;
+static StackType_t midiTxStack[MIDI_TX_STACK];
+static StaticTask_t midiTxTCB;
+
+static void midiSchedTimerCb(void* arg) {
+  xTaskNotifyGive(((MidiScheduler*)arg)->schedTask);
+}
+
+void midiSchedTask(void* param) {
+  MidiScheduler* s = (MidiScheduler*)param;
+  MidiSchedCmd cmd;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    int64_t now = esp_timer_get_time();
+    // Stop and play flush note-offs straight into the ring, so wake midi_tx
+    // on any new bytes, not just on messages that fell due
+    uint32_t h0 = s->head.load(std::memory_order_relaxed);
+    while (xQueueReceive(s->cmdQueue, &cmd, 0) == pdTRUE) {
+      s->handleCmd(cmd, now);
+    }
+    s->fireDue();
+    if (s->head.load(std::memory_order_relaxed) != h0) xTaskNotifyGive(s->txTask);
+    s->armTimer();
+  }
+}
+
+void midiTxTask(void* param) {
+  MidiScheduler* s = (MidiScheduler*)param;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    if (s->uartReinitRequested) {
+      // Something during boot reclaims GPIO 17/18 — rebind UART2 here, off the render core
+      s->uartReinitRequested = false;
+      Serial2.end();
+      vTaskDelay(pdMS_TO_TICKS(20));
+      Serial2.begin(MIDI_BAUD, SERIAL_8N1, MIDI_RX_PIN, MIDI_TX_PIN);
+      vTaskDelay(pdMS_TO_TICKS(50));
+    }
+    s->drainToUart();
+  }
+}
+
+void MidiScheduler::start() {
+  if (schedTask != nullptr || cmdQueue == nullptr) return;
+  esp_timer_create_args_t args = {};
+  args.callback = midiSchedTimerCb;
+  args.arg = this;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "midi_sched";
+  esp_timer_create(&args, &timer);
+  txTask = xTaskCreateStaticPinnedToCore(
+    midiTxTask, "midi_tx", MIDI_TX_STACK, this, MIDI_TX_PRIORITY,
+    midiTxStack, &midiTxTCB, 0);
+  schedTask = xTaskCreateStaticPinnedToCore(
+    midiSchedTask, "midi_sched", MIDI_SCHED_STACK, this, MIDI_SCHED_PRIORITY,
+    midiSchedStack, &midiSchedTCB, 0);
+  DBGLN("MIDI scheduler started on Core 0 (esp_timer + UART TX task)");
+}
+
+// ---- Interface for midi_synth.h / bot_sounds.h (declared extern there) ----
+
+void midiSchedStart() {
+  midiScheduler.init();
+  midiScheduler.start();
+}
+
+// Queue raw bytes (<= MIDI_MSG_MAX) to go out delayMs from now, in FIFO order
+void midiSchedSend(const uint8_t* data, uint8_t len, uint32_t delayMs) {
+  MidiSchedCmd cmd;
+  cmd.type = MIDI_SCHED_RAW;
+  cmd.def = nullptr;
+  cmd.delayMs = delayMs;
+  cmd.msg.len = min(len, (uint8_t)MIDI_MSG_MAX);
+  memcpy(cmd.msg.data, data, cmd.msg.len);
+  cmd.msg.isNoteOff = false;
+  midiScheduler.post(cmd);
+}
+
+// Hold back later messages and sequences until delayMs from now (device reset/boot)
+void midiSchedHoldoff(uint32_t delayMs) {
+  MidiSchedCmd cmd;
+  cmd.type = MIDI_SCHED_HOLDOFF;
+  cmd.def = nullptr;
+  cmd.delayMs = delayMs;
+  midiScheduler.post(cmd);
+}
+
+void midiSchedPlaySequence(const MidiSequenceDef* def) {
+  MidiSchedCmd cmd;
+  cmd.type = MIDI_SCHED_PLAY;
+  cmd.def = def;
+  cmd.delayMs = 0;
+  cloudSequenceRetain(def);
+  if (!midiScheduler.post(cmd)) cloudSequenceRelease(def);
+}
+
+void midiSchedStop() {
+  MidiSchedCmd cmd;
+  cmd.type = MIDI_SCHED_STOP;
+  cmd.def = nullptr;
+  cmd.delayMs = 0;
+  midiScheduler.post(cmd);
+}
+
+// Silence everything — one command, where 16 RAW CC 123s could overflow the queue
+void midiSchedAllOff() {
+  MidiSchedCmd cmd;
+  cmd.type = MIDI_SCHED_ALL_OFF;
+  cmd.def = nullptr;
+  cmd.delayMs = 0;
+  midiScheduler.post(cmd);
+}
+
+void midiSchedReinitUart() {
+  midiScheduler.uartReinitRequested = true;
+  if (midiScheduler.txTask) xTaskNotifyGive(midiScheduler.txTask);
+}
+
+#endif // MIDI_SYNTH_ENABLED
+#endif // MIDI_SCHEDULER_H
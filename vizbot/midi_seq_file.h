@@ -0,0 +1,229 @@
+#ifndef MIDI_SEQ_FILE_H
+#define MIDI_SEQ_FILE_H
+
+#ifdef MIDI_SYNTH_ENABLED
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+// ============================================================================
+// MIDI Sequence Files — compact binary cloud sequences on LittleFS
+// ============================================================================
+// Cloud sequences used to be parsed into a fixed 20x128 MidiEvent array that
+// reserved the worst case for every slot. They are now converted once into
+// variable-length files (one per sequence) and decoded on demand, so only the
+// sequence that is actually playing is resident in RAM.
+//
+// The event stream borrows two ideas from Standard MIDI Files:
+//   - delta times are variable-length quantities (7 bits per byte, MSB = more)
+//   - running status: the status byte is omitted when channel and program are
+//     the same as the previous event (the usual case)
+//
+// Layout (little-endian):
+//   0  'V' 'S' 'Q'              magic
+//   3  u8   version             MIDI_SEQ_FILE_VERSION
+//   4  u8   defaultProgram
+//   5  u8   flags               SEQ_FLAG_*
+//   6  u16  eventCount
+//   8  u16  totalMs             latest note-off (offset + duration)
+//  10  u8   nameLen, then nameLen bytes (no terminator)
+//   .. events:
+//        VLQ  delta              offsetMs - previous offsetMs
+//        [status]                0x90|ch = channel ch, program 255 (default)
+//                                0xC0|ch = channel ch, program byte follows
+//        [program]               only after 0xC0|ch
+//        u8   note               < 0x80, so it can't be mistaken for a status
+//        u8   velocity
+//        VLQ  durationMs
+//
+// Running status starts as 0x90 (channel 0, default program). A typical
+// event is 4-5 bytes versus 8 for MidiEvent in RAM.
+//
+// scripts/midi-seq-convert.js writes the same format on the host and can dump
+// a .bin back to JSON for checking.
+// ============================================================================
+
+#define MIDI_SEQ_DIR           "/cloud/seq"
+#define MIDI_SEQ_FILE_VERSION  1
+#define MIDI_SEQ_HEADER_SIZE   11      // Fixed part, before the name
+#define MIDI_SEQ_MAX_EVENTS    4096    // Sanity cap on a decoded sequence (32KB)
+
+#define MIDI_SEQ_STATUS_DEFAULT 0x90
+#define MIDI_SEQ_STATUS_PROGRAM 0xC0
+
+struct MidiSeqHeader {
+  uint8_t  defaultProgram;
+  uint8_t  flags;
+  uint16_t eventCount;
+  uint16_t totalMs;
+  char     name[32];
+};
+
+inline void midiSeqPath(char* buf, size_t len, uint8_t idx) {
+  snprintf(buf, len, MIDI_SEQ_DIR "/%u.bin", idx);
+}
+
+// ---- Writer (converter side) ----
+// Streams events straight to the file; eventCount and totalMs are patched
+// into the header by finish(), so callers don't need the events in RAM.
+
+struct MidiSeqWriter {
+  File     f;
+  uint16_t count;
+  uint16_t totalMs;
+  uint16_t lastOffset;
+  uint8_t  runningStatus;
+  uint8_t  runningProgram;
+  bool     ok;
+
+  bool begin(const char* path, const char* name, uint8_t defaultProgram, uint8_t flags) {
+    f = LittleFS.open(path, "w");
+    if (!f) return false;
+    count = 0;
+    totalMs = 0;
+    lastOffset = 0;
+    runningStatus = MIDI_SEQ_STATUS_DEFAULT;
+    runningProgram = 255;
+    ok = true;
+
+    uint8_t nameLen = (uint8_t)min(strlen(name), (size_t)31);
+    uint8_t hdr[MIDI_SEQ_HEADER_SIZE] = {
+      'V', 'S', 'Q', MIDI_SEQ_FILE_VERSION,
+      defaultProgram, flags,
+      0, 0,      // eventCount (patched)
+      0, 0,      // totalMs (patched)
+      nameLen
+    };
+    ok &= f.write(hdr, sizeof(hdr)) == sizeof(hdr);
+    ok &= f.write((const uint8_t*)name, nameLen) == nameLen;
+    return ok;
+  }
+
+  void putVlq(uint16_t v) {
+    uint8_t buf[3];
+    uint8_t n = 0;
+    buf[n++] = v & 0x7F;
+    while (v >>= 7) buf[n++] = 0x80 | (v & 0x7F);
+    while (n) ok &= f.write(buf[--n]) == 1;   // Most significant group first
+  }
+
+  // Events must arrive sorted by offsetMs (same rule as the PROGMEM tables)
+  bool add(const MidiEvent& ev) {
+    if (!ok || count >= MIDI_SEQ_MAX_EVENTS) return false;
+    uint16_t offset = max(ev.offsetMs, lastOffset);
+    putVlq(offset - lastOffset);
+    lastOffset = offset;
+
+    uint8_t ch = ev.channel & 0x0F;
+    uint8_t status = (ev.program == 255 ? MIDI_SEQ_STATUS_DEFAULT : MIDI_SEQ_STATUS_PROGRAM) | ch;
+    if (status != runningStatus ||
+        (status >= MIDI_SEQ_STATUS_PROGRAM && ev.program != runningProgram)) {
+      ok &= f.write(status) == 1;
+      if (status >= MIDI_SEQ_STATUS_PROGRAM) ok &= f.write(ev.program & 0x7F) == 1;
+      runningStatus = status;
+      runningProgram = ev.program;
+    }
+    ok &= f.write(ev.note & 0x7F) == 1;
+    ok &= f.write(ev.velocity & 0x7F) == 1;
+    putVlq(ev.durationMs);
+
+    uint32_t end = (uint32_t)offset + ev.durationMs;
+    if (end > totalMs) totalMs = (uint16_t)min(end, (uint32_t)0xFFFF);
+    count++;
+    return ok;
+  }
+
+  bool finish() {
+    if (f) {
+      uint8_t patch[4] = {
+        (uint8_t)(count & 0xFF), (uint8_t)(count >> 8),
+        (uint8_t)(totalMs & 0xFF), (uint8_t)(totalMs >> 8)
+      };
+      ok &= f.seek(6);
+      ok &= f.write(patch, sizeof(patch)) == sizeof(patch);
+      f.close();
+    }
+    return ok;
+  }
+};
+
+// ---- Reader (playback side) ----
+
+// Parse the fixed header + name. Leaves the file positioned at the first event.
+bool midiSeqReadHeader(File& f, MidiSeqHeader& hdr) {
+  uint8_t raw[MIDI_SEQ_HEADER_SIZE];
+  if (f.read(raw, sizeof(raw)) != sizeof(raw)) return false;
+  if (raw[0] != 'V' || raw[1] != 'S' || raw[2] != 'Q' || raw[3] != MIDI_SEQ_FILE_VERSION) {
+    return false;
+  }
+  hdr.defaultProgram = raw[4];
+  hdr.flags          = raw[5];
+  hdr.eventCount     = raw[6] | (raw[7] << 8);
+  hdr.totalMs        = raw[8] | (raw[9] << 8);
+  uint8_t nameLen    = min(raw[10], (uint8_t)(sizeof(hdr.name) - 1));
+  if (f.read((uint8_t*)hdr.name, nameLen) != nameLen) return false;
+  hdr.name[nameLen] = '\0';
+  f.seek(raw[10] - nameLen, SeekCur);
+  return true;
+}
+
+static bool midiSeqGetVlq(File& f, uint16_t& out) {
+  uint32_t v = 0;
+  for (uint8_t i = 0; i < 3; i++) {
+    int b = f.read();
+    if (b < 0) return false;
+    v = (v << 7) | (b & 0x7F);
+    if (!(b & 0x80)) {
+      out = (uint16_t)min(v, (uint32_t)0xFFFF);
+      return true;
+    }
+  }
+  return false;   // Longer than a uint16 ever needs — corrupt
+}
+
+// Decode up to maxEvents events into dst. Returns the number decoded; a short
+// count means the file was truncated or corrupt (the prefix is still usable).
+uint16_t midiSeqDecode(File& f, MidiEvent* dst, uint16_t maxEvents) {
+  uint8_t status = MIDI_SEQ_STATUS_DEFAULT;
+  uint8_t program = 255;
+  uint16_t offset = 0;
+  uint16_t n = 0;
+
+  while (n < maxEvents) {
+    uint16_t delta;
+    if (!midiSeqGetVlq(f, delta)) break;
+    offset += delta;
+
+    int b = f.read();
+    if (b < 0) break;
+    if (b & 0x80) {
+      status = b;
+      if ((status & 0xF0) == MIDI_SEQ_STATUS_PROGRAM) {
+        int p = f.read();
+        if (p < 0 || (p & 0x80)) break;
+        program = p;
+      } else if ((status & 0xF0) == MIDI_SEQ_STATUS_DEFAULT) {
+        program = 255;
+      } else {
+        break;   // Unknown status
+      }
+      b = f.read();
+      if (b < 0 || (b & 0x80)) break;
+    }
+    int vel = f.read();
+    uint16_t dur;
+    if (vel < 0 || !midiSeqGetVlq(f, dur)) break;
+
+    MidiEvent& ev = dst[n++];
+    ev.note       = b;
+    ev.velocity   = vel & 0x7F;
+    ev.channel    = status & 0x0F;
+    ev.program    = program;
+    ev.durationMs = dur;
+    ev.offsetMs   = offset;
+  }
+  return n;
+}
+
+#endif // MIDI_SYNTH_ENABLED
+#endif // MIDI_SEQ_FILE_H
@@ -12,6 +12,10 @@
 // ============================================================================
 // Wraps https://github.com/m5stack/M5-SAM2695
 // Core S3 Port C: GPIO 18 (TXD2), GPIO 17 (RXD2)
+//
+// The library is only used to open the UART. Every message is encoded here
+// and handed to midi_scheduler.h, whose Core 0 tasks own timing and Serial2,
+// so nothing in this driver blocks or delay()s the caller.
 // ============================================================================
 
 // GM instrument presets (subset)
@@ -52,6 +56,13 @@
 #define MIDI_CH_PERCUSSION 9
 #define MIDI_MAX_CHANNELS  16
 
+// Defined in midi_scheduler.h (included after bot_sounds.h)
+extern void midiSchedStart();
+extern void midiSchedSend(const uint8_t* data, uint8_t len, uint32_t delayMs);
+extern void midiSchedHoldoff(uint32_t delayMs);
+extern void midiSchedAllOff();
+extern void midiSchedReinitUart();
+
 // Thin wrapper around M5_SAM2695 official library
 struct MidiSynth {
   M5_SAM2695 sam;
@@ -67,66 +78,69 @@ struct MidiSynth {
     DBG(" TX=");
     DBGLN(MIDI_TX_PIN);
 
-    delay(100);
-    sam.reset();
-    delay(300);
-
-    sam.setMasterVolume(127);
-    delay(20);
-
-    sam.setInstrument(0, 0, GM_PIANO);
-    delay(20);
+    midiSchedStart();
 
-    // Test note
-    DBGLN("MIDI Synth: test note C5...");
-    sam.setNoteOn(0, 72, 127);
-    delay(600);
-    sam.setNoteOff(0, 72, 0);
-    delay(50);
+    // Boot script — same spacing the SAM2695 needs, but timed by the scheduler
+    const uint8_t reset[] = {0xFF};
+    const uint8_t piano[] = {0xB0, 0x00, 0x00, 0xC0, GM_PIANO};
+    const uint8_t testOn[] = {0x90, 72, 127};
+    const uint8_t testOff[] = {0x80, 72, 0};
+    midiSchedSend(reset, sizeof(reset), 100);
+    sendMasterVolume(127, 400);
+    midiSchedSend(piano, sizeof(piano), 420);
+    midiSchedSend(testOn, sizeof(testOn), 440);   // Test note C5
+    midiSchedSend(testOff, sizeof(testOff), 1040);
+    midiSchedHoldoff(1090);  // Everything else waits for the script to finish
 
     ready = true;
-    DBGLN("MIDI Synth: init OK");
+    DBGLN("MIDI Synth: init queued (test note C5)");
   }
 
   // Re-establish UART after boot — something during boot reclaims GPIO 17/18.
   // Call once after boot_sequence completes and before first real playback.
   void reinit() {
     if (!ready) return;
-    Serial2.end();
-    delay(20);
-    Serial2.begin(MIDI_BAUD, SERIAL_8N1, MIDI_RX_PIN, MIDI_TX_PIN);
-    delay(50);
-    sam.setMasterVolume(100);
-    delay(10);
-    DBGLN("MIDI Synth: UART re-initialized");
+    midiSchedReinitUart();   // UART rebind happens in the midi_tx task
+    sendMasterVolume(100, 80);
+    DBGLN("MIDI Synth: UART re-init queued");
   }
 
-  // --- Forwarding to official lib ---
+  // --- Raw message encoders (all queued, never block) ---
 
   void noteOn(uint8_t ch, uint8_t note, uint8_t velocity) {
-    sam.setNoteOn(ch, note, velocity);
+    uint8_t msg[] = {(uint8_t)(0x90 | (ch & 0x0F)), (uint8_t)(note & 0x7F), (uint8_t)(velocity & 0x7F)};
+    midiSchedSend(msg, 3, 0);
   }
 
   void noteOff(uint8_t ch, uint8_t note, uint8_t velocity = 0) {
-    sam.setNoteOff(ch, note, velocity);
+    uint8_t msg[] = {(uint8_t)(0x80 | (ch & 0x0F)), (uint8_t)(note & 0x7F), (uint8_t)(velocity & 0x7F)};
+    midiSchedSend(msg, 3, 0);
   }
 
   void programChange(uint8_t ch, uint8_t program) {
-    sam.setInstrument(0, ch, program);  // bank 0
+    // Bank select 0 + program change (same bytes as sam.setInstrument(0, ch, program))
+    uint8_t msg[] = {(uint8_t)(0xB0 | (ch & 0x0F)), 0x00, 0x00,
+                     (uint8_t)(0xC0 | (ch & 0x0F)), (uint8_t)(program & 0x7F)};
+    midiSchedSend(msg, sizeof(msg), 0);
   }
 
   void controlChange(uint8_t ch, uint8_t controller, uint8_t value) {
-    // Direct CC send via raw serial (official lib doesn't expose generic CC)
-    uint8_t cmd[] = {(uint8_t)(0xB0 | (ch & 0x0F)), (uint8_t)(controller & 0x7F), (uint8_t)(value & 0x7F)};
-    Serial2.write(cmd, 3);
+    uint8_t msg[] = {(uint8_t)(0xB0 | (ch & 0x0F)), (uint8_t)(controller & 0x7F), (uint8_t)(value & 0x7F)};
+    midiSchedSend(msg, 3, 0);
+  }
+
+  void sendMasterVolume(uint8_t vol127, uint32_t delayMs) {
+    // Universal SysEx master volume
+    uint8_t msg[] = {0xF0, 0x7F, 0x7F, 0x04, 0x01, 0x00, (uint8_t)(vol127 & 0x7F), 0xF7};
+    midiSchedSend(msg, sizeof(msg), delayMs);
   }
 
   void setVolume(uint8_t vol255) {
-    sam.setMasterVolume(vol255 >> 1);  // 0-255 -> 0-127
+    sendMasterVolume(vol255 >> 1, 0);  // 0-255 -> 0-127
   }
 
   void setChannelVolume(uint8_t ch, uint8_t vol127) {
-    sam.setVolume(ch, vol127);
+    controlChange(ch, 0x07, vol127);
   }
 
   void setReverb(uint8_t ch, uint8_t level) {
@@ -134,17 +148,16 @@ struct MidiSynth {
   }
 
   void allNotesOff(uint8_t ch) {
-    sam.setAllNotesOff(ch);
+    controlChange(ch, 0x7B, 0);
   }
 
   void allNotesOffAll() {
-    for (uint8_t ch = 0; ch < MIDI_MAX_CHANNELS; ch++) {
-      sam.setAllNotesOff(ch);
-    }
+    midiSchedAllOff();
   }
 
   void systemReset() {
-    sam.reset();
+    const uint8_t msg[] = {0xFF};
+    midiSchedSend(msg, 1, 0);
   }
 };
 
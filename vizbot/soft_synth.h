@@ -0,0 +1,536 @@
+#ifndef SOFT_SYNTH_H
+#define SOFT_SYNTH_H
+
+#ifdef TARGET_CORES3
+
+#include <Arduino.h>
+#include <M5Unified.h>
+#include "config.h"
+
+// ============================================================================
+// Soft Synth — polyphonic M5.Speaker renderer (no SAM2695 fallback)
+// ============================================================================
+// Renders MidiSequenceDef event streams directly to the speaker when the
+// SAM2695 module isn't plugged in:
+//   - 8 melodic voices: 256-entry wavetables (sine/triangle/square/saw),
+//     per-voice ADSR chosen from the GM program family
+//   - 1 percussion channel: LFSR noise through a one-pole filter plus a
+//     pitch-swept sine thump, shaped per GM drum note
+//
+// Runs in its own task so audio never depends on render frame timing.
+// Events are fired at their exact sample offset inside each 512-sample
+// block. Blocks alternate between two buffers fed to M5.Speaker.playRaw():
+// a new block is rendered only while fewer than two are queued, so the
+// buffer being written is never the one the speaker DMA is reading.
+//
+// BotSounds talks to the task through a small FreeRTOS queue via the
+// softSynth*() functions at the bottom of this file.
+// ============================================================================
+
+#define SYNTH_SAMPLE_RATE   48000
+#define SYNTH_BLOCK         512     // Samples per speaker block (10.7ms)
+#define SYNTH_CTRL          32      // Envelope/gain update interval (samples)
+#define SYNTH_VOICES        8
+#define SYNTH_MIDI_CHANNELS 16
+#define SYNTH_WAVE_LEN      256
+#define SYNTH_SPEAKER_CH    0       // M5.Speaker virtual channel
+#define SYNTH_CMD_QUEUE     8
+#define SYNTH_VOICE_AMP     0.18f   // Per-voice peak (headroom for 4-note chords + drums)
+#define SYNTH_STACK         4096
+#define SYNTH_PRIORITY      3       // Above mic_cap (2) and wifi_srv (1)
+#define SYNTH_CORE          0
+
+enum SynthWave : uint8_t { WAVE_SINE = 0, WAVE_TRIANGLE, WAVE_SQUARE, WAVE_SAW, WAVE_COUNT };
+
+// ADSR + waveform per GM family (program >> 3)
+struct SynthPatch {
+  uint8_t  wave;
+  uint16_t attackMs;
+  uint16_t decayMs;
+  uint8_t  sustain;     // 0-255 (0 = percussive, voice ends after decay)
+  uint16_t releaseMs;
+};
+
+static const SynthPatch synthFamilyPatches[16] = {
+  { WAVE_TRIANGLE, 2,   400, 60,  120 },  // 0   Piano
+  { WAVE_SINE,     1,   600, 0,   200 },  // 8   Chromatic perc (celesta, glock, vibes, marimba)
+  { WAVE_SQUARE,   10,  200, 180, 80  },  // 16  Organ
+  { WAVE_SAW,      2,   300, 40,  100 },  // 24  Guitar
+  { WAVE_TRIANGLE, 5,   200, 160, 80  },  // 32  Bass
+  { WAVE_SAW,      40,  200, 200, 200 },  // 40  Strings
+  { WAVE_SAW,      60,  300, 180, 300 },  // 48  Ensemble
+  { WAVE_SQUARE,   20,  100, 200, 80  },  // 56  Brass
+  { WAVE_SQUARE,   25,  100, 190, 80  },  // 64  Reed
+  { WAVE_SINE,     30,  100, 200, 100 },  // 72  Pipe (blown bottle, whistle)
+  { WAVE_SAW,      5,   100, 200, 60  },  // 80  Synth lead
+  { WAVE_TRIANGLE, 120, 300, 200, 400 },  // 88  Synth pad
+  { WAVE_SAW,      30,  400, 120, 300 },  // 96  Synth FX
+  { WAVE_SAW,      5,   300, 80,  120 },  // 104 Ethnic
+  { WAVE_SQUARE,   1,   150, 0,   60  },  // 112 Percussive (agogo, steel drums, woodblock)
+  { WAVE_SINE,     1,   200, 0,   60  },  // 120 Sound FX
+};
+
+// Percussion shaping per GM drum note
+struct SynthDrum {
+  uint8_t  note;
+  uint16_t noiseDecayMs;  // 0 = no noise component
+  uint16_t filterK;       // One-pole low-pass coefficient, Q15 (32767 = bright)
+  uint16_t toneStartHz;   // 0 = no tone component
+  uint16_t toneEndHz;
+  uint16_t toneDecayMs;
+};
+
+static const SynthDrum synthDrums[] = {
+  { 36, 30,  4000,  150, 45,  180 },  // Bass drum
+  { 38, 140, 20000, 220, 160, 60  },  // Snare
+  { 39, 120, 24000, 0,   0,   0   },  // Hand clap
+  { 42, 40,  32767, 0,   0,   0   },  // Closed hi-hat
+  { 46, 220, 32767, 0,   0,   0   },  // Open hi-hat
+  { 56, 0,   0,     800, 780, 150 },  // Cowbell
+  { 60, 0,   0,     420, 380, 90  },  // Hi bongo
+  { 61, 0,   0,     300, 260, 110 },  // Low bongo
+  { 69, 60,  28000, 0,   0,   0   },  // Cabasa
+  { 76, 0,   0,     1200,1100,40  },  // Woodblock
+  { 81, 0,   0,     2600,2600,500 },  // Triangle
+};
+static const SynthDrum synthDefaultDrum = { 0, 80, 16000, 0, 0, 0 };
+
+enum SynthEnvStage : uint8_t { ENV_IDLE = 0, ENV_ATTACK, ENV_DECAY, ENV_SUSTAIN, ENV_RELEASE };
+
+struct SynthVoice {
+  const int16_t* table;
+  uint32_t phase;
+  uint32_t inc;
+  int32_t  gainQ23;       // Current per-sample gain (Q15 << 8)
+  float    level;         // Envelope level 0.0-1.0
+  float    amp;           // Velocity-scaled peak
+  float    attackStep, decayStep, sustain, releaseStep;  // Per-sample
+  uint32_t offSample;     // Sample clock at which release begins
+  uint32_t startSample;   // For voice stealing (oldest first)
+  uint8_t  channel;
+  uint8_t  note;
+  uint8_t  stage;
+};
+
+struct SynthDrumVoice {
+  bool     active;
+  uint32_t lfsr;
+  int32_t  lp;            // Filter state
+  uint16_t filterK;
+  float    noiseGain, noiseMul;    // Exponential decay per sample
+  float    toneGain, toneMul;
+  uint32_t tonePhase;
+  float    toneInc, toneIncMul;    // Pitch sweep per sample
+};
+
+enum SynthCmdType : uint8_t {
+  SYNTH_CMD_PLAY_SEQ = 0,
+  SYNTH_CMD_TONE,
+  SYNTH_CMD_STOP,
+};
+
+struct SynthCmd {
+  SynthCmdType type;
+  const MidiSequenceDef* def;
+  uint16_t freq;
+  uint16_t durationMs;
+};
+
+struct SoftSynth {
+  int16_t waves[WAVE_COUNT][SYNTH_WAVE_LEN];
+  int16_t outBuf[2][SYNTH_BLOCK];
+  int32_t mix[SYNTH_CTRL];
+  uint8_t outIdx;
+
+  SynthVoice voices[SYNTH_VOICES];
+  SynthDrumVoice drum;
+  uint8_t channelProgram[SYNTH_MIDI_CHANNELS];
+
+  // Sequence cursor (sample-accurate)
+  const MidiSequenceDef* seq;
+  uint16_t seqIndex;
+  uint32_t seqStartSample;
+  MidiEvent nextEv;
+  bool     nextEvValid;
+
+  uint32_t sampleClock;   // Samples rendered since init
+
+  // Stats
+  volatile uint32_t lastBlockUs;
+  volatile uint32_t maxBlockUs;
+  volatile uint8_t  activeVoices;
+  volatile uint32_t underruns;     // Speaker queue found empty while sound was active
+  bool streaming;                  // A block was submitted and sound is still active
+
+  QueueHandle_t cmdQueue;
+  TaskHandle_t taskHandle;
+
+  void init() {
+    for (uint16_t i = 0; i < SYNTH_WAVE_LEN; i++) {
+      float ph = 2.0f * PI * i / SYNTH_WAVE_LEN;
+      float t = (float)i / SYNTH_WAVE_LEN;
+      waves[WAVE_SINE][i] = (int16_t)(32767.0f * sinf(ph));
+      waves[WAVE_TRIANGLE][i] = (int16_t)(32767.0f * (t < 0.25f ? 4 * t : t < 0.75f ? 2 - 4 * t : 4 * t - 4));
+      // Band-limited square/saw (additive, first harmonics only) to keep aliasing down
+      float sq = 0, sw = 0;
+      for (uint8_t h = 1; h <= 9; h++) {
+        if (h & 1) sq += sinf(ph * h) / h;
+        sw += sinf(ph * h) / h * ((h & 1) ? 1 : -1);
+      }
+      waves[WAVE_SQUARE][i] = (int16_t)(32767.0f * 0.8f * sq);
+      waves[WAVE_SAW][i] = (int16_t)(32767.0f * 0.55f * sw);
+    }
+    for (uint8_t v = 0; v < SYNTH_VOICES; v++) voices[v].stage = ENV_IDLE;
+    drum.active = false;
+    drum.lfsr = 0xACE1u;
+    resetChannels(0);
+    seq = nullptr;
+    nextEvValid = false;
+    sampleClock = 0;
+    outIdx = 0;
+    lastBlockUs = 0;
+    maxBlockUs = 0;
+    activeVoices = 0;
+    underruns = 0;
+    streaming = false;
+    taskHandle = nullptr;
+    cmdQueue = xQueueCreate(SYNTH_CMD_QUEUE, sizeof(SynthCmd));
+  }
+
+  void resetChannels(uint8_t defaultProgram) {
+    for (uint8_t ch = 0; ch < SYNTH_MIDI_CHANNELS; ch++) channelProgram[ch] = 0;
+    channelProgram[0] = defaultProgram;
+  }
+
+  void start();
+
+  // ---- Voice control (synth task only) ----
+
+  void noteOn(uint8_t ch, uint8_t note, uint8_t velocity, uint16_t durationMs) {
+    if (ch == MIDI_CH_PERCUSSION) {
+      drumHit(note, velocity);
+      return;
+    }
+    const SynthPatch& p = synthFamilyPatches[(channelProgram[ch] >> 3) & 0x0F];
+    SynthVoice& v = voices[allocVoice()];
+    v.table = waves[p.wave];
+    v.phase = 0;
+    float freq = 440.0f * powf(2.0f, (note - 69) / 12.0f);
+    v.inc = (uint32_t)(freq * (4294967296.0f / SYNTH_SAMPLE_RATE));
+    v.gainQ23 = 0;
+    v.level = 0;
+    v.amp = SYNTH_VOICE_AMP * velocity / 127.0f;
+    v.attackStep = 1.0f / max(1.0f, p.attackMs * (SYNTH_SAMPLE_RATE / 1000.0f));
+    v.sustain = p.sustain / 255.0f;
+    v.decayStep = (1.0f - v.sustain) / max(1.0f, p.decayMs * (SYNTH_SAMPLE_RATE / 1000.0f));
+    v.releaseStep = 1.0f / max(1.0f, p.releaseMs * (SYNTH_SAMPLE_RATE / 1000.0f));
+    v.startSample = sampleClock;
+    v.offSample = sampleClock + (uint32_t)durationMs * (SYNTH_SAMPLE_RATE / 1000);
+    v.channel = ch;
+    v.note = note;
+    v.stage = ENV_ATTACK;
+  }
+
+  uint8_t allocVoice() {
+    uint8_t best = 0;
+    uint32_t bestAge = 0;
+    for (uint8_t i = 0; i < SYNTH_VOICES; i++) {
+      if (voices[i].stage == ENV_IDLE) return i;
+      // Prefer stealing released voices, then the oldest
+      uint32_t age = sampleClock - voices[i].startSample;
+      if (voices[i].stage == ENV_RELEASE) age += 0x40000000u;
+      if (age >= bestAge) { bestAge = age; best = i; }
+    }
+    return best;
+  }
+
+  void drumHit(uint8_t note, uint8_t velocity) {
+    const SynthDrum* d = &synthDefaultDrum;
+    for (uint8_t i = 0; i < sizeof(synthDrums) / sizeof(synthDrums[0]); i++) {
+      if (synthDrums[i].note == note) { d = &synthDrums[i]; break; }
+    }
+    float vel = velocity / 127.0f;
+    const float msToSamples = SYNTH_SAMPLE_RATE / 1000.0f;
+    drum.active = true;
+    drum.lp = 0;
+    drum.filterK = d->filterK;
+    // Exponential decay to -60dB over the given time
+    drum.noiseGain = d->noiseDecayMs ? 0.35f * vel : 0;
+    drum.noiseMul = d->noiseDecayMs ? expf(-6.9f / (d->noiseDecayMs * msToSamples)) : 0;
+    drum.toneGain = d->toneStartHz ? 0.4f * vel : 0;
+    drum.toneMul = d->toneStartHz ? expf(-6.9f / (d->toneDecayMs * msToSamples)) : 0;
+    drum.tonePhase = 0;
+    drum.toneInc = d->toneStartHz * (4294967296.0f / SYNTH_SAMPLE_RATE);
+    drum.toneIncMul = (d->toneStartHz && d->toneEndHz != d->toneStartHz)
+      ? powf((float)d->toneEndHz / d->toneStartHz, 1.0f / (d->toneDecayMs * msToSamples))
+      : 1.0f;
+  }
+
+  void allOff() {
+    for (uint8_t v = 0; v < SYNTH_VOICES; v++) voices[v].stage = ENV_IDLE;
+    drum.active = false;
+    dropSequence();
+  }
+
+  // Let go of the sequence — its events may be freed after this
+  void dropSequence() {
+    if (seq) cloudSequenceRelease(seq);
+    seq = nullptr;
+    nextEvValid = false;
+  }
+
+  // ---- Sequence cursor ----
+
+  void startSequence(const MidiSequenceDef* def) {
+    allOff();
+    resetChannels(def->defaultProgram);
+    seq = def;
+    seqIndex = 0;
+    seqStartSample = sampleClock;
+    loadNextEvent();
+  }
+
+  void loadNextEvent() {
+    nextEvValid = false;
+    if (!seq || seqIndex >= seq->eventCount) return;
+    memcpy_P(&nextEv, &seq->events[seqIndex], sizeof(MidiEvent));
+    nextEvValid = true;
+  }
+
+  uint32_t nextEventSample() const {
+    return seqStartSample + (uint32_t)nextEv.offsetMs * (SYNTH_SAMPLE_RATE / 1000);
+  }
+
+  void fireDueEvents() {
+    while (nextEvValid && (int32_t)(sampleClock - nextEventSample()) >= 0) {
+      const MidiEvent& ev = nextEv;
+      if (!(ev.note == 0 && ev.durationMs == 0)) {
+        if (ev.program != 255 && ev.channel != MIDI_CH_PERCUSSION) {
+          channelProgram[ev.channel & 0x0F] = ev.program;
+        }
+        noteOn(ev.channel & 0x0F, ev.note, ev.velocity, ev.durationMs);
+      }
+      seqIndex++;
+      loadNextEvent();
+    }
+    if (!nextEvValid) dropSequence();
+  }
+
+  bool busy() const {
+    if (seq || drum.active) return true;
+    for (uint8_t v = 0; v < SYNTH_VOICES; v++) {
+      if (voices[v].stage != ENV_IDLE) return true;
+    }
+    return false;
+  }
+
+  // ---- Rendering ----
+
+  // Advance one voice's envelope by n samples; returns target Q23 gain
+  int32_t advanceEnvelope(SynthVoice& v, uint16_t n) {
+    if (v.stage != ENV_RELEASE && (int32_t)(sampleClock + n - v.offSample) >= 0) {
+      v.stage = ENV_RELEASE;
+      v.releaseStep = v.releaseStep * max(v.level, 0.05f);  // Linear from current level
+    }
+    switch (v.stage) {
+      case ENV_ATTACK:
+        v.level += v.attackStep * n;
+        if (v.level >= 1.0f) { v.level = 1.0f; v.stage = ENV_DECAY; }
+        break;
+      case ENV_DECAY:
+        v.level -= v.decayStep * n;
+        if (v.level <= v.sustain) {
+          v.level = v.sustain;
+          v.stage = (v.sustain > 0) ? ENV_SUSTAIN : ENV_IDLE;
+        }
+        break;
+      case ENV_RELEASE:
+        v.level -= v.releaseStep * n;
+        if (v.level <= 0) { v.level = 0; v.stage = ENV_IDLE; }
+        break;
+      default:
+        break;
+    }
+    return (int32_t)(v.level * v.amp * 32767.0f) << 8;
+  }
+
+  // Render n (<= SYNTH_CTRL) samples into out
+  void renderChunk(int16_t* out, uint16_t n) {
+    for (uint16_t i = 0; i < n; i++) mix[i] = 0;
+
+    for (uint8_t vi = 0; vi < SYNTH_VOICES; vi++) {
+      SynthVoice& v = voices[vi];
+      if (v.stage == ENV_IDLE) continue;
+      int32_t g = v.gainQ23;
+      int32_t target = advanceEnvelope(v, n);
+      int32_t step = (target - g) / n;
+      const int16_t* tbl = v.table;
+      uint32_t ph = v.phase, inc = v.inc;
+      for (uint16_t i = 0; i < n; i++) {
+        mix[i] += (tbl[ph >> 24] * (g >> 8)) >> 15;
+        ph += inc;
+        g += step;
+      }
+      v.phase = ph;
+      v.gainQ23 = target;
+    }
+
+    if (drum.active) {
+      int32_t ng = (int32_t)(drum.noiseGain * 32767.0f);
+      int32_t tg = (int32_t)(drum.toneGain * 32767.0f);
+      uint32_t lfsr = drum.lfsr;
+      int32_t lp = drum.lp;
+      for (uint16_t i = 0; i < n; i++) {
+        lfsr ^= lfsr << 13; lfsr ^= lfsr >> 17; lfsr ^= lfsr << 5;
+        int32_t x = (int16_t)(lfsr & 0xFFFF);
+        lp += ((x - lp) * drum.filterK) >> 15;
+        int32_t s = (lp * ng) >> 15;
+        if (tg) {
+          s += (waves[WAVE_SINE][drum.tonePhase >> 24] * tg) >> 15;
+          drum.tonePhase += (uint32_t)drum.toneInc;
+        }
+        mix[i] += s;
+      }
+      drum.lfsr = lfsr;
+      drum.lp = lp;
+      // Per-chunk decay (control rate)
+      drum.noiseGain *= powf(drum.noiseMul, n);
+      drum.toneGain *= powf(drum.toneMul, n);
+      drum.toneInc *= powf(drum.toneIncMul, n);
+      if (drum.noiseGain < 0.0005f && drum.toneGain < 0.0005f) drum.active = false;
+    }
+
+    for (uint16_t i = 0; i < n; i++) {
+      int32_t s = mix[i];
+      out[i] = (int16_t)constrain(s, -32767, 32767);
+    }
+    sampleClock += n;
+  }
+
+  // Render a full block, splitting at event boundaries for sample accuracy
+  void renderBlock(int16_t* out) {
+    uint16_t pos = 0;
+    while (pos < SYNTH_BLOCK) {
+      fireDueEvents();
+      uint16_t n = min((uint16_t)SYNTH_CTRL, (uint16_t)(SYNTH_BLOCK - pos));
+      if (nextEvValid) {
+        int32_t until = (int32_t)(nextEventSample() - sampleClock);
+        if (until > 0 && until < n) n = (uint16_t)until;
+      }
+      renderChunk(out + pos, n);
+      pos += n;
+    }
+    uint8_t count = drum.active ? 1 : 0;
+    for (uint8_t v = 0; v < SYNTH_VOICES; v++) {
+      if (voices[v].stage != ENV_IDLE) count++;
+    }
+    activeVoices = count;
+  }
+
+  void handleCmd(const SynthCmd& cmd) {
+    switch (cmd.type) {
+      case SYNTH_CMD_PLAY_SEQ:
+        if (cmd.def && cmd.def->eventCount > 0) startSequence(cmd.def);
+        else if (cmd.def) cloudSequenceRelease(cmd.def);
+        break;
+      case SYNTH_CMD_TONE: {
+        allOff();
+        resetChannels(GM_VIBRAPHONE);
+        float n = 69.0f + 12.0f * log2f(max((uint16_t)1, cmd.freq) / 440.0f);
+        noteOn(0, (uint8_t)constrain((int)(n + 0.5f), 0, 127), 100, cmd.durationMs);
+        break;
+      }
+      case SYNTH_CMD_STOP:
+        allOff();
+        M5.Speaker.stop(SYNTH_SPEAKER_CH);
+        break;
+    }
+  }
+
+  // Block duration in microseconds (budget reference for the load figure)
+  static constexpr uint32_t blockBudgetUs() {
+    return (uint32_t)SYNTH_BLOCK * 1000000UL / SYNTH_SAMPLE_RATE;
+  }
+
+  // Render CPU as a percentage of one core (last block)
+  uint8_t loadPercent() const {
+    return (uint8_t)min((uint32_t)100, lastBlockUs * 100 / blockBudgetUs());
+  }
+};
+
+// Global instance
+SoftSynth softSynth;
+
+static StackType_t softSynthStack[SYNTH_STACK];
+static StaticTask_t softSynthTCB;
+
+void softSynthTask(void* param) {
+  SoftSynth* s = (SoftSynth*)param;
+  SynthCmd cmd;
+  for (;;) {
+    // Idle: sleep on the command queue (zero CPU when silent)
+    TickType_t wait = s->busy() ? 0 : portMAX_DELAY;
+    while (xQueueReceive(s->cmdQueue, &cmd, wait) == pdTRUE) {
+      s->handleCmd(cmd);
+      wait = 0;
+    }
+    if (!s->busy()) {
+      s->streaming = false;
+      continue;
+    }
+
+    // Keep at most two blocks queued: one playing, one waiting
+    size_t queued = M5.Speaker.isPlaying(SYNTH_SPEAKER_CH);
+    if (queued >= 2) {
+      vTaskDelay(1);
+      continue;
+    }
+    if (queued == 0 && s->streaming) s->underruns++;
+
+    uint32_t t0 = micros();
+    int16_t* buf = s->outBuf[s->outIdx];
+    s->renderBlock(buf);
+    s->lastBlockUs = micros() - t0;
+    if (s->lastBlockUs > s->maxBlockUs) s->maxBlockUs = s->lastBlockUs;
+
+    M5.Speaker.playRaw(buf, SYNTH_BLOCK, SYNTH_SAMPLE_RATE, false, 1, SYNTH_SPEAKER_CH, false);
+    s->outIdx ^= 1;
+    s->streaming = true;
+  }
+}
+
+void SoftSynth::start() {
+  if (taskHandle != nullptr || cmdQueue == nullptr) return;
+  taskHandle = xTaskCreateStaticPinnedToCore(
+    softSynthTask, "synth", SYNTH_STACK, this, SYNTH_PRIORITY,
+    softSynthStack, &softSynthTCB, SYNTH_CORE);
+  DBGLN("Soft synth task started on Core 0");
+}
+
+// ---- BotSounds interface (declared extern in bot_sounds.h) ----
+
+void softSynthInit() {
+  softSynth.init();
+  softSynth.start();
+}
+
+void softSynthPlaySequence(const MidiSequenceDef* def) {
+  SynthCmd cmd = { SYNTH_CMD_PLAY_SEQ, def, 0, 0 };
+  cloudSequenceRetain(def);
+  if (!softSynth.cmdQueue || xQueueSend(softSynth.cmdQueue, &cmd, 0) != pdTRUE) {
+    cloudSequenceRelease(def);
+  }
+}
+
+void softSynthPlayTone(uint16_t freq, uint16_t durationMs) {
+  SynthCmd cmd = { SYNTH_CMD_TONE, nullptr, freq, durationMs };
+  if (softSynth.cmdQueue) xQueueSend(softSynth.cmdQueue, &cmd, 0);
+}
+
+void softSynthStop() {
+  SynthCmd cmd = { SYNTH_CMD_STOP, nullptr, 0, 0 };
+  if (softSynth.cmdQueue) xQueueSend(softSynth.cmdQueue, &cmd, 0);
+}
+
+#endif // TARGET_CORES3
+#endif // SOFT_SYNTH_H
@@ -71,6 +71,8 @@ enum CommandType : uint8_t {
   CMD_MESH_SCAN,
   CMD_SET_PERSONALITY_LIST,
   CMD_PLAY_SEQUENCE,
+  CMD_PLAY_ANIM,
+  CMD_STOP_ANIM,
 };
 
 // ~64-byte command payload — fits all command types including multi-word phrases
@@ -93,6 +95,11 @@ struct Command {
       uint8_t  count;
       uint32_t intervalMs;
     } plist;
+    struct {
+      char     name[ANIM_NAME_LEN];   // /anim/<name>.gif
+      uint8_t  target;                // ANIM_TARGET_* bits
+      uint16_t loops;                 // 0 = as the file says
+    } anim;
   };
 };
 
@@ -221,6 +228,22 @@ void cmdPlaySequence(uint8_t seqId) {
   pushCommand(cmd);
 }
 
+void cmdPlayAnim(const char* name, uint8_t target, uint16_t loops) {
+  Command cmd;
+  cmd.type = CMD_PLAY_ANIM;
+  strncpy(cmd.anim.name, name, sizeof(cmd.anim.name) - 1);
+  cmd.anim.name[sizeof(cmd.anim.name) - 1] = '\0';
+  cmd.anim.target = target;
+  cmd.anim.loops = loops;
+  pushCommand(cmd);
+}
+
+void cmdStopAnim() {
+  Command cmd;
+  cmd.type = CMD_STOP_ANIM;
+  pushCommand(cmd);
+}
+
 void cmdAutoBrightness(bool enabled) {
   Command cmd;
   cmd.type = CMD_AUTO_BRIGHTNESS;
@@ -258,25 +281,39 @@ extern bool autoCycle;
 extern bool hiResMode;
 extern void toggleHiResMode();
 
-// Deferred say — held until mesh peer finishes WLED
-static bool deferredSayPending = false;
-static Command deferredSayCmd;
-
-// Mesh peer check (defined in esp_now_mesh.h, safe to read from Core 1)
-extern bool meshAnyPeerWledActiveForIP(uint32_t);
-extern uint32_t wledGetIPAsU32();
+// Deferred says — held while another bot has the shared WLED. Only says
+// wait (in order); every other command keeps draining.
+#define DEFERRED_SAY_SLOTS 4
+static Command deferredSays[DEFERRED_SAY_SLOTS];
+static uint8_t deferredSayHead = 0;
+static uint8_t deferredSayCount = 0;
+
+// WLED lease (wled_lease.h, safe to read from Core 1)
+extern bool wledLeaseBusy();
+extern volatile bool wledLeaseSpeechWaiting;
+
+static void deferSay(const Command& cmd) {
+  if (deferredSayCount == DEFERRED_SAY_SLOTS) {
+    // Full — drop the oldest, the newest is what the user just asked for
+    deferredSayHead = (deferredSayHead + 1) % DEFERRED_SAY_SLOTS;
+    deferredSayCount--;
+  }
+  deferredSays[(deferredSayHead + deferredSayCount) % DEFERRED_SAY_SLOTS] = cmd;
+  deferredSayCount++;
+  wledLeaseSpeechWaiting = true;  // Queue for the lease now, not when the peer finishes
+  DBGLN("Say deferred — waiting for WLED lease");
+}
 
 void drainCommandQueue() {
   if (cmdQueue == nullptr) return;
 
-  // Check if a deferred say can now execute
-  if (deferredSayPending) {
-    if (!meshAnyPeerWledActiveForIP(wledGetIPAsU32())) {
-      deferredSayPending = false;
-      showBotSaying(deferredSayCmd.say.text, deferredSayCmd.say.duration);
-    }
-    // Still blocked — skip processing new commands to preserve ordering
-    return;
+  // One deferred say per frame once the WLED is ours
+  if (deferredSayCount > 0 && !wledLeaseBusy()) {
+    const Command& say = deferredSays[deferredSayHead];
+    showBotSaying(say.say.text, say.say.duration);
+    deferredSayHead = (deferredSayHead + 1) % DEFERRED_SAY_SLOTS;
+    deferredSayCount--;
+    wledLeaseSpeechWaiting = deferredSayCount > 0;
   }
 
   Command cmd;
@@ -302,12 +339,10 @@ void drainCommandQueue() {
         markSettingsDirty();
         break;
       case CMD_SAY_TEXT:
-        // Defer speech if a mesh peer is currently using WLED
-        if (meshAnyPeerWledActiveForIP(wledGetIPAsU32())) {
-          deferredSayPending = true;
-          deferredSayCmd = cmd;
-          DBGLN("Say deferred — mesh peer using WLED");
-          return;  // Stop draining — preserve command ordering
+        // Defer speech while another bot holds the WLED (or earlier says wait)
+        if (deferredSayCount > 0 || wledLeaseBusy()) {
+          deferSay(cmd);
+          break;
         }
         showBotSaying(cmd.say.text, cmd.say.duration);
         break;
@@ -381,6 +416,12 @@ void drainCommandQueue() {
         }
         #endif
         break;
+      case CMD_PLAY_ANIM:
+        animPlay(cmd.anim.name, cmd.anim.target, cmd.anim.loops);
+        break;
+      case CMD_STOP_ANIM:
+        animStop();
+        break;
       case CMD_AUTO_BRIGHTNESS:
         {
           extern bool autoBrightnessEnabled;
@@ -424,6 +465,9 @@ extern void pollWifiConnectTask();
 // Defined in wled_display.h — sends queued text to WLED + handles restore timer.
 extern void pollWledDisplay();
 
+// Defined in wled_lease.h — lease requests/renewals, and arbitration when we're the arbiter.
+extern void pollWledLease();
+
 // Defined in weather_data.h — checks fetchRequested flag and fetches if needed.
 extern void pollWeatherFetch();
 
@@ -433,9 +477,11 @@ extern void pollMeshBroadcast();
 // Defined in cloud_client.h — non-blocking cloud sync (TLS registration + polling).
 #ifdef CLOUD_ENABLED
 extern void pollCloudSync();
-extern void pollScheduledCommands();
 #endif
 
+// Defined in timeline.h — fires due events (cloud commands, content cycle steps).
+extern void pollTimeline();
+
 TaskHandle_t wifiTaskHandle = nullptr;
 
 // Static task stack — lives in BSS instead of heap, keeping the largest
@@ -449,11 +495,12 @@ void wifiServerTask(void* param) {
     if (wifiEnabled) {
       pollWifiConnectTask();             // connect request + STA poll
       pollWledDisplay();                 // WLED text send + restore
+      pollWledLease();                   // WLED lease requests, renewals, arbiter
       pollWeatherFetch();                // Weather API fetch (if requested)
       #ifdef CLOUD_ENABLED
       pollCloudSync();                   // Cloud registration + sync (TLS)
-      pollScheduledCommands();           // Execute scheduled commands at their target time
       #endif
+      pollTimeline();                    // Scheduled commands + content cycle steps, in time order
       pollScheduledContent();              // Periodic weather + emoji cycles
       pollMeshBroadcast();               // ESP-NOW mesh broadcast + stale eviction
       dnsServer.processNextRequest();    // Captive portal DNS
@@ -0,0 +1,40 @@
+#ifndef HOST_CLOCK_H
+#define HOST_CLOCK_H
+
+// ============================================================================
+// Host clock for single-bot tests — time only moves when the test says so
+// ============================================================================
+// Defines the clock, delay(), random() and esp_random() that stubs/Arduino.h declares.
+// Include it from exactly one file per test binary (the mesh simulations
+// bring their own, one clock per node).
+// ============================================================================
+
+#include <Arduino.h>
+#include <random>
+
+inline int64_t& hostNowUs() {
+  static int64_t now = 1000000;   // Not 0 — firmware uses 0 as "never"
+  return now;
+}
+
+inline void hostAdvanceUs(int64_t us) { hostNowUs() += us; }
+inline void hostAdvanceMs(int64_t ms) { hostNowUs() += ms * 1000; }
+
+inline std::mt19937& hostRng() {
+  static std::mt19937 rng(1);
+  return rng;
+}
+
+int64_t esp_timer_get_time() { return hostNowUs(); }
+unsigned long micros() { return (unsigned long)hostNowUs(); }
+unsigned long millis() { return (unsigned long)(hostNowUs() / 1000); }
+void delay(uint32_t ms) { hostAdvanceMs(ms); }
+void delayMicroseconds(uint32_t us) { hostAdvanceUs(us); }
+
+long random(long howbig) { return howbig > 0 ? (long)(hostRng()() % howbig) : 0; }
+long random(long howsmall, long howbig) {
+  return howbig > howsmall ? howsmall + random(howbig - howsmall) : howsmall;
+}
+uint32_t esp_random() { return hostRng()(); }
+
+#endif // HOST_CLOCK_H
@@ -0,0 +1,102 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+// ============================================================================
+// Minimal host test runner — CHECK macros and forked test cases
+// ============================================================================
+// Each TEST runs in a child process: the firmware headers keep their state
+// in file-scope statics, so a case gets a fresh "boot" and a crash fails only
+// that case. main() comes from HOST_TEST_MAIN in exactly one file per binary.
+// ============================================================================
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct HostTestCase {
+  const char* name;
+  void (*fn)();
+};
+
+inline std::vector<HostTestCase>& hostTestCases() {
+  static std::vector<HostTestCase> cases;
+  return cases;
+}
+
+inline int& hostTestFailures() {
+  static int failures = 0;
+  return failures;
+}
+
+struct HostTestRegistrar {
+  HostTestRegistrar(const char* name, void (*fn)()) { hostTestCases().push_back({name, fn}); }
+};
+
+#define TEST(name)                                                   \
+  static void test_##name();                                         \
+  static HostTestRegistrar registrar_##name(#name, test_##name);     \
+  static void test_##name()
+
+#define CHECK(cond)                                                                  \
+  do {                                                                               \
+    if (!(cond)) {                                                                   \
+      fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);     \
+      hostTestFailures()++;                                                          \
+    }                                                                                \
+  } while (0)
+
+#define CHECK_EQ(a, b)                                                               \
+  do {                                                                               \
+    long long va_ = (long long)(a), vb_ = (long long)(b);                            \
+    if (va_ != vb_) {                                                                \
+      fprintf(stderr, "  %s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__,  \
+              __LINE__, #a, #b, va_, vb_);                                           \
+      hostTestFailures()++;                                                          \
+    }                                                                                \
+  } while (0)
+
+#define CHECK_NEAR(a, b, tol)                                                        \
+  do {                                                                               \
+    double va_ = (double)(a), vb_ = (double)(b);                                     \
+    if (va_ - vb_ > (tol) || vb_ - va_ > (tol)) {                                    \
+      fprintf(stderr, "  %s:%d: CHECK_NEAR(%s, %s, %s) failed: %g vs %g\n", __FILE__, \
+              __LINE__, #a, #b, #tol, va_, vb_);                                     \
+      hostTestFailures()++;                                                          \
+    }                                                                                \
+  } while (0)
+
+// Informational numbers (timings, ratios) — printed, never checked
+#define REPORT(...) (printf("    "), printf(__VA_ARGS__), printf("\n"), fflush(stdout))
+
+inline int hostTestMain(int argc, char** argv) {
+  int failed = 0, ran = 0;
+  for (const HostTestCase& t : hostTestCases()) {
+    if (argc > 1 && strcmp(argv[1], t.name) != 0) continue;
+    ran++;
+    printf("%s\n", t.name);
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+      t.fn();
+      fflush(stdout);
+      _exit(hostTestFailures() ? 1 : 0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    if (!ok) {
+      failed++;
+      printf("  FAILED%s\n", WIFSIGNALED(status) ? " (crashed)" : "");
+    }
+  }
+  printf("%d/%d passed\n", ran - failed, ran);
+  return failed || ran == 0 ? 1 : 0;
+}
+
+#define HOST_TEST_MAIN \
+  int main(int argc, char** argv) { return hostTestMain(argc, argv); }
+
+#endif // HOST_TEST_H
@@ -0,0 +1,76 @@
+// One simulated bot: the real mesh headers in a namespace of their own.
+// Built once per node with -DMESH_SIM_NS=nodeK -DMESH_SIM_INDEX=K.
+
+#include "mesh_sim.h"
+#include "config.h"
+#include "system_status.h"
+
+namespace MESH_SIM_NS {
+
+// What the rest of the firmware would provide
+static uint8_t simExpression = 0;
+static uint32_t simWledIP = 0;
+uint8_t getBotExpression() { return simExpression; }
+uint8_t getBotState() { return 0; }
+uint8_t effectIndex = 0;
+uint8_t paletteIndex = 0;
+float accelX = 0, accelY = 0, accelZ = 1;
+volatile bool meshScanRequested = false;
+uint32_t wledGetIPAsU32() { return simWledIP; }
+void setBotExpression(uint8_t e) { MeshSim::active->fired(0, e); }          // MESH_PLAY_EXPRESSION
+void showBotSaying(const char*, uint16_t ms) { MeshSim::active->fired(1, ms); }  // MESH_PLAY_SAY
+
+#include "mesh_protocol.h"
+#include "wled_lease.h"
+#include "esp_now_mesh.h"
+
+struct Firmware : MeshSimFirmware {
+  void init(uint32_t wledIP) override {
+    simWledIP = wledIP;
+    initMesh();
+  }
+  void pollWifi() override {
+    pollMeshBroadcast();
+    pollWledLease();
+  }
+  void pollLoop() override { pollMeshPlayAt(); }
+  void setExpression(uint8_t e) override { simExpression = e; }
+  bool playAt(uint8_t action, uint16_t arg, const char* text, uint32_t leadMs) override {
+    return meshPlayAt(action, arg, text, leadMs);
+  }
+
+  void leaseRequest(uint8_t prio, uint16_t durationMs) override { wledLeaseRequest(prio, durationMs); }
+  bool leaseHeld() override { return wledLeaseHeld(); }
+  bool leaseRevoked() override { return wledLeaseRevoked(); }
+  void leaseRelease() override { wledLeaseRelease(); }
+  uint32_t leaseArbiter() override { return wledLease.arbiterId; }
+
+  uint32_t nodeId() override { return meshData.myNodeId; }
+  uint8_t peerCount() override { return meshData.peerCount; }
+  int peerHops(uint32_t nodeId) override {
+    for (uint8_t i = 0; i < meshData.peerCount; i++) {
+      if (meshData.peers[i].nodeId == nodeId) return meshData.peers[i].hops;
+    }
+    return -1;
+  }
+  uint8_t peerCapacity() override { return meshGetPeerCapacity(); }
+  bool peerPresent(uint32_t nodeId) override { return meshPeerPresent(nodeId); }
+  uint8_t peersForIP(uint32_t ip) override { return meshPeersForIP(ip); }
+  bool wledActiveForIP(uint32_t ip) override { return meshAnyPeerWledActiveForIP(ip); }
+  bool schedOwnerForIP(uint32_t ip) override { return meshAnyPeerSchedOwnerForIP(ip); }
+  uint32_t lowestIdForIP(uint32_t ip) override { return meshLowestIdForIP(ip); }
+  bool clockSynced() override { return meshClockSynced(); }
+  uint32_t clockMaster() override { return meshClock.masterId; }
+  uint8_t clockStratum() override { return meshClockStratum(); }
+  int64_t meshTimeAt(int64_t localUs) override { return MESH_SIM_NS::meshTimeAt(localUs); }
+  void relayStats(uint32_t& forwarded, uint32_t& suppressed, uint32_t& dropped,
+                  uint32_t& duplicates) override {
+    meshGetRelayStats(forwarded, suppressed, dropped, duplicates);
+  }
+  uint32_t playRejected() override { return meshPlayRejectedCount(); }
+};
+
+static Firmware firmware;
+static MeshSimRegistrar registrar(MESH_SIM_INDEX, &firmware);
+
+}  // namespace MESH_SIM_NS
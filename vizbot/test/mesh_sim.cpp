@@ -0,0 +1,246 @@
+#include "mesh_sim.h"
+#include "system_status.h"
+#include "mesh_protocol.h"
+
+SystemStatus sysStatus = {};
+MeshSim* MeshSim::active = nullptr;
+
+MeshSimFirmware*& meshSimFirmware(int index) {
+  static MeshSimFirmware* table[MESH_SIM_NODES] = {};
+  return table[index];
+}
+
+// ============================================================================
+// Simulator
+// ============================================================================
+
+MeshSim::MeshSim(int n, uint32_t seed) : rng(seed), nodes(n), adj(n, std::vector<bool>(n, false)) {
+  if (n > MESH_SIM_NODES) {
+    fprintf(stderr, "MeshSim: %d nodes, only %d built\n", n, MESH_SIM_NODES);
+    exit(2);
+  }
+  active = this;
+  sysStatus.psramAvailable = true;
+  for (int i = 0; i < n; i++) {
+    MeshSimNode& x = nodes[i];
+    x.fw = meshSimFirmware(i);
+    const uint8_t mac[6] = {0x24, 0x6F, 0x28, (uint8_t)rng(), (uint8_t)(i >> 8), (uint8_t)i};
+    memcpy(x.mac, mac, 6);
+    x.ppm = std::uniform_real_distribution<double>(-40, 40)(rng);
+  }
+}
+
+void MeshSim::fullyConnect(int from, int to) {
+  for (int a = from; a < to; a++) {
+    for (int b = a + 1; b < to; b++) link(a, b);
+  }
+}
+
+void MeshSim::line() {
+  for (int i = 0; i + 1 < size(); i++) link(i, i + 1);
+}
+
+void MeshSim::grid(int width, bool diagonals) {
+  for (int a = 0; a < size(); a++) {
+    for (int b = a + 1; b < size(); b++) {
+      int dx = abs(a % width - b % width), dy = abs(a / width - b / width);
+      if (diagonals ? (dx <= 1 && dy <= 1) : (dx + dy == 1)) link(a, b);
+    }
+  }
+}
+
+int MeshSim::hops(int a, int b) {
+  std::vector<int> dist(size(), -1);
+  std::deque<int> q = {a};
+  dist[a] = 0;
+  while (!q.empty()) {
+    int u = q.front();
+    q.pop_front();
+    for (int v = 0; v < size(); v++) {
+      if (adj[u][v] && dist[v] < 0) {
+        dist[v] = dist[u] + 1;
+        q.push_back(v);
+      }
+    }
+  }
+  return dist[b];
+}
+
+int64_t MeshSim::localUs(int i) const {
+  const MeshSimNode& x = nodes[i];
+  return (int64_t)((double)(nowUs - x.bootUs) * (1.0 + x.ppm * 1e-6));
+}
+
+int64_t MeshSim::trueFromLocal(int i, int64_t local) const {
+  const MeshSimNode& x = nodes[i];
+  return x.bootUs + (int64_t)ceil((double)local / (1.0 + x.ppm * 1e-6));
+}
+
+void MeshSim::boot(int i, uint32_t wledIP) {
+  MeshSimNode& x = nodes[i];
+  x.booted = true;
+  x.bootUs = nowUs;
+  x.nextWifiUs = nowUs + (int64_t)(rng() % MESH_SIM_WIFI_POLL_US);
+  x.nextLoopUs = nowUs + (int64_t)(rng() % MESH_SIM_FRAME_US);
+  as(i, [&] { x.fw->init(wledIP); });
+}
+
+void MeshSim::bootAll(int64_t staggerUs, uint32_t wledIP) {
+  for (int i = 0; i < size(); i++) {
+    boot(i, wledIP);
+    run(staggerUs ? (int64_t)(rng() % staggerUs) : 0);
+  }
+}
+
+void MeshSim::send(const uint8_t* data, size_t len) {
+  MeshSimNode& x = nodes[current];
+  int64_t airUs = radio.baseUs + (int64_t)(radio.usPerByte * len);
+  x.txFrames++;
+  x.txAirUs += airUs;
+  if (len > 1 && data[1] == MESH_MSG_RELAY) x.txRelayAirUs += airUs;
+  std::uniform_real_distribution<double> u(0, 1);
+  for (int j = 0; j < size(); j++) {
+    if (!adj[current][j] || u(rng) < radio.loss) continue;
+    int64_t jitter = radio.jitterUs ? (int64_t)(rng() % radio.jitterUs) : 0;
+    air.emplace(nowUs + airUs + jitter, Delivery{j, current, std::vector<uint8_t>(data, data + len)});
+  }
+}
+
+void MeshSim::inject(int i, const uint8_t* mac, const uint8_t* data, int len) {
+  MeshSimNode& x = nodes[i];
+  if (!x.booted || !x.recv) return;
+  esp_now_recv_info_t info = {(uint8_t*)mac, nullptr, nullptr};
+  as(i, [&] { x.recv(&info, data, len); });
+}
+
+void MeshSim::fired(uint8_t kind, uint16_t arg) {
+  nodes[current].fired.push_back({nowUs, kind, arg});
+}
+
+// One event: the earliest frame delivery, timer, WiFi poll or frame
+void MeshSim::step(int64_t limitUs) {
+  int64_t t = limitUs;
+  if (!air.empty()) t = std::min(t, air.begin()->first);
+  for (Timer* tm : timers) {
+    if (tm->dueUs >= 0) t = std::min(t, tm->dueUs);
+  }
+  for (MeshSimNode& x : nodes) {
+    if (!x.booted) continue;
+    t = std::min(t, std::min(x.nextWifiUs, x.notified ? nowUs : x.nextLoopUs));
+  }
+  nowUs = std::max(nowUs, t);
+  if (t >= limitUs) return;
+
+  if (!air.empty() && air.begin()->first <= nowUs) {
+    Delivery d = std::move(air.begin()->second);
+    air.erase(air.begin());
+    MeshSimNode& to = nodes[d.to];
+    if (!to.booted || !to.recv) return;
+    esp_now_recv_info_t info = {nodes[d.from].mac, nullptr, nullptr};
+    as(d.to, [&] { to.recv(&info, d.data.data(), (int)d.data.size()); });
+    return;
+  }
+  for (Timer* tm : timers) {
+    if (tm->dueUs < 0 || tm->dueUs > nowUs) continue;
+    tm->dueUs = -1;
+    as(tm->node, [&] { tm->cb(tm->arg); });
+    return;
+  }
+  for (int i = 0; i < size(); i++) {
+    MeshSimNode& x = nodes[i];
+    if (!x.booted) continue;
+    if (x.nextWifiUs <= nowUs) {
+      x.nextWifiUs = nowUs + MESH_SIM_WIFI_POLL_US;
+      as(i, [&] { x.fw->pollWifi(); });
+      return;
+    }
+    if (x.notified || x.nextLoopUs <= nowUs) {
+      x.notified = false;
+      x.nextLoopUs = nowUs + MESH_SIM_FRAME_US;
+      as(i, [&] { x.fw->pollLoop(); });
+      return;
+    }
+  }
+}
+
+void MeshSim::run(int64_t forUs) {
+  int64_t end = nowUs + forUs;
+  while (nowUs < end) step(end);
+}
+
+void MeshSim::runUntil(const std::function<bool()>& done, int64_t maxUs) {
+  int64_t end = nowUs + maxUs;
+  while (nowUs < end && !done()) step(std::min(end, nowUs + 1000));
+}
+
+// ============================================================================
+// Stubs — act on MeshSim::active->current
+// ============================================================================
+
+static MeshSimNode& cur() { return MeshSim::active->node(MeshSim::active->current); }
+
+int64_t esp_timer_get_time() { return MeshSim::active->localUs(MeshSim::active->current); }
+unsigned long micros() { return (unsigned long)esp_timer_get_time(); }
+unsigned long millis() { return (unsigned long)(esp_timer_get_time() / 1000); }
+
+long random(long howbig) { return howbig > 0 ? (long)(MeshSim::active->rng() % howbig) : 0; }
+long random(long howsmall, long howbig) {
+  return howbig > howsmall ? howsmall + random(howbig - howsmall) : howsmall;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() { return &cur(); }
+void xTaskNotifyGive(TaskHandle_t task) { ((MeshSimNode*)task)->notified = true; }
+uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+
+struct HostTimer : MeshSim::Timer {};
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out) {
+  HostTimer* t = new HostTimer;
+  t->node = MeshSim::active->current;
+  t->cb = args->callback;
+  t->arg = args->arg;
+  t->dueUs = -1;
+  MeshSim::active->timers.push_back(t);
+  *out = t;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t t, uint64_t timeoutUs) {
+  MeshSim* sim = MeshSim::active;
+  t->dueUs = sim->trueFromLocal(t->node, sim->localUs(t->node) + (int64_t)timeoutUs);
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t t) {
+  t->dueUs = -1;
+  return ESP_OK;
+}
+
+esp_err_t esp_now_init() { return ESP_OK; }
+esp_err_t esp_now_deinit() { return ESP_OK; }
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t*) { return ESP_OK; }
+
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t cb) {
+  cur().recv = cb;
+  return ESP_OK;
+}
+
+esp_err_t esp_now_send(const uint8_t*, const uint8_t* data, size_t len) {
+  if (len > ESP_NOW_MAX_DATA_LEN) return ESP_FAIL;
+  MeshSim::active->send(data, len);
+  return ESP_OK;
+}
+
+HostWiFi WiFi;
+
+uint8_t* HostWiFi::softAPmacAddress(uint8_t* mac) {
+  memcpy(mac, cur().mac, 6);
+  return mac;
+}
+
+// STA MAC is the AP MAC minus one on the ESP32
+uint8_t* HostWiFi::macAddress(uint8_t* mac) {
+  memcpy(mac, cur().mac, 6);
+  mac[5]--;
+  return mac;
+}
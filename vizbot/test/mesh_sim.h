@@ -0,0 +1,164 @@
+#ifndef MESH_SIM_H
+#define MESH_SIM_H
+
+// ============================================================================
+// Mesh Simulator — N bots on an in-process fake radio
+// ============================================================================
+// mesh_node.cpp compiles the real mesh_protocol.h, wled_lease.h and
+// esp_now_mesh.h into its own namespace; the Makefile builds it once per node
+// (MESH_SIM_NODES copies), so every simulated bot has its own peer table,
+// clock and lease state. The stubs those headers call (millis, esp_now_send,
+// esp_timer, WiFi MAC, task notify) land here and act on the node whose code
+// is running.
+//
+// Each node has its own boot time and crystal error, so esp_timer and
+// millis() differ between nodes the way they do on hardware. The radio
+// delivers a broadcast to every neighbour in the adjacency matrix after its
+// airtime plus random jitter, with optional random loss. Collisions and
+// carrier sense are not modelled.
+//
+// Event driven: the WiFi task polls every MESH_SIM_WIFI_POLL_US, the render
+// loop every MESH_SIM_FRAME_US and whenever a task notify (the play-at wake
+// timer) arrives.
+// ============================================================================
+
+#include <Arduino.h>
+#include <esp_now.h>
+#include <esp_timer.h>
+#include <WiFi.h>
+#include <functional>
+#include <map>
+#include <random>
+
+#define MESH_SIM_NODES        30
+#define MESH_SIM_WIFI_POLL_US 2000
+#define MESH_SIM_FRAME_US     20000
+#define BOT_NUM_EXPRESSIONS   25
+
+// The firmware entry points and state one node exposes to a test
+struct MeshSimFirmware {
+  virtual ~MeshSimFirmware() {}
+  virtual void init(uint32_t wledIP) = 0;
+  virtual void pollWifi() = 0;            // pollMeshBroadcast() + pollWledLease()
+  virtual void pollLoop() = 0;            // pollMeshPlayAt()
+  virtual void setExpression(uint8_t e) = 0;
+  virtual bool playAt(uint8_t action, uint16_t arg, const char* text, uint32_t leadMs) = 0;
+
+  virtual void leaseRequest(uint8_t prio, uint16_t durationMs) = 0;
+  virtual bool leaseHeld() = 0;
+  virtual bool leaseRevoked() = 0;
+  virtual void leaseRelease() = 0;
+  virtual uint32_t leaseArbiter() = 0;
+
+  virtual uint32_t nodeId() = 0;
+  virtual uint8_t  peerCount() = 0;
+  virtual int      peerHops(uint32_t nodeId) = 0;   // -1 = not in the table
+  virtual uint8_t  peerCapacity() = 0;
+  virtual bool     peerPresent(uint32_t nodeId) = 0;
+  virtual uint8_t  peersForIP(uint32_t ip) = 0;
+  virtual bool     wledActiveForIP(uint32_t ip) = 0;
+  virtual bool     schedOwnerForIP(uint32_t ip) = 0;
+  virtual uint32_t lowestIdForIP(uint32_t ip) = 0;
+  virtual bool     clockSynced() = 0;
+  virtual uint32_t clockMaster() = 0;
+  virtual uint8_t  clockStratum() = 0;
+  virtual int64_t  meshTimeAt(int64_t localUs) = 0;
+  virtual void relayStats(uint32_t& forwarded, uint32_t& suppressed, uint32_t& dropped,
+                          uint32_t& duplicates) = 0;
+  virtual uint32_t playRejected() = 0;
+};
+
+// Filled by each mesh_node.cpp copy at static-init time
+MeshSimFirmware*& meshSimFirmware(int index);
+
+struct MeshSimRegistrar {
+  MeshSimRegistrar(int index, MeshSimFirmware* fw) { meshSimFirmware(index) = fw; }
+};
+
+// Something a node did that a test wants to time (true simulation time)
+struct MeshSimFired {
+  int64_t  atUs;
+  uint8_t  kind;      // MESH_PLAY_* the action came from
+  uint16_t arg;
+};
+
+struct MeshSimNode {
+  MeshSimFirmware*  fw = nullptr;
+  uint8_t           mac[6] = {};
+  bool              booted = false;
+  int64_t           bootUs = 0;          // True time esp_timer started
+  double            ppm = 0;             // Crystal error
+  esp_now_recv_cb_t recv = nullptr;
+  int64_t           nextWifiUs = 0;
+  int64_t           nextLoopUs = 0;
+  bool              notified = false;
+  std::vector<MeshSimFired> fired;
+  uint32_t          txFrames = 0;
+  uint64_t          txAirUs = 0;
+  uint64_t          txRelayAirUs = 0;    // MESH_MSG_RELAY share of txAirUs
+};
+
+struct MeshSimRadio {
+  int64_t  baseUs = 200;            // Fixed latency per frame (stack + preamble)
+  double   usPerByte = 8;           // 1 Mbit/s
+  int64_t  jitterUs = 400;          // Uniform extra delay
+  double   loss = 0;                // Per-link frame loss
+};
+
+class MeshSim {
+ public:
+  explicit MeshSim(int n, uint32_t seed = 1);
+
+  int size() const { return (int)nodes.size(); }
+  MeshSimNode& node(int i) { return nodes[i]; }
+  MeshSimFirmware& fw(int i) { return *nodes[i].fw; }
+
+  // Topology
+  void link(int a, int b, bool on = true) { adj[a][b] = adj[b][a] = on; }
+  void fullyConnect(int from, int to);    // Nodes [from, to) all in range of each other
+  void line();
+  void grid(int width, bool diagonals);
+
+  // Boot node i at the current time (staggered boots = different clocks)
+  void boot(int i, uint32_t wledIP = 0);
+  void bootAll(int64_t staggerUs, uint32_t wledIP = 0);
+  void run(int64_t forUs);
+  void runUntil(const std::function<bool()>& done, int64_t maxUs);
+  int64_t now() const { return nowUs; }
+  int hops(int a, int b);                 // Shortest path in links, -1 = unreachable
+
+  // Runs f as node i (its clock, its radio)
+  template <typename F> void as(int i, F f) {
+    int prev = current;
+    current = i;
+    f();
+    current = prev;
+  }
+
+  // Hands node i a frame as if `mac` had sent it, bypassing the radio
+  void inject(int i, const uint8_t* mac, const uint8_t* data, int len);
+
+  int64_t localUs(int i) const;           // Node i's esp_timer now
+  int64_t trueFromLocal(int i, int64_t localUs) const;
+
+  MeshSimRadio radio;
+  std::mt19937 rng;
+
+  // Stub plumbing
+  static MeshSim* active;
+  int current = -1;
+  void send(const uint8_t* data, size_t len);
+  void fired(uint8_t kind, uint16_t arg);
+  struct Timer { int node; void (*cb)(void*); void* arg; int64_t dueUs; };
+  std::vector<Timer*> timers;
+
+ private:
+  struct Delivery { int to; int from; std::vector<uint8_t> data; };
+  std::vector<MeshSimNode> nodes;
+  std::vector<std::vector<bool>> adj;
+  std::multimap<int64_t, Delivery> air;
+  int64_t nowUs = 0;
+  void step(int64_t limitUs);
+};
+
+#endif // MESH_SIM_H
@@ -0,0 +1,260 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// ============================================================================
+// Host stand-in for the Arduino-ESP32 core — just what the headers under
+// test use. The clock (millis/micros/esp_timer_get_time, delay), random() and
+// esp_random() are declared here and defined by each test, so a simulation
+// can give every node its own time base.
+// ============================================================================
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <string>
+#include <deque>
+#include <vector>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+#define PROGMEM
+#define memcpy_P memcpy
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_ptr(addr)  (*(const void* const*)(addr))
+#define PI 3.1415926535897932384626433832795
+#define HEX 16
+#define DEC 10
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef bool boolean;
+typedef int esp_err_t;
+#define ESP_OK   0
+#define ESP_FAIL -1
+
+#define ESP_IDF_VERSION_VAL(major, minor, patch) (((major) << 16) | ((minor) << 8) | (patch))
+#define ESP_IDF_VERSION ESP_IDF_VERSION_VAL(5, 3, 0)
+
+unsigned long millis();
+unsigned long micros();
+int64_t esp_timer_get_time();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+long random(long howbig);
+long random(long howsmall, long howbig);
+uint32_t esp_random();
+
+// ---- GPIO — pins go nowhere ----
+
+#define INPUT  0x01
+#define OUTPUT 0x03
+#define LOW    0
+#define HIGH   1
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+inline void analogWrite(uint8_t, int) {}
+
+inline size_t strlcpy(char* dst, const char* src, size_t size) {
+  size_t len = strlen(src);
+  if (size) {
+    size_t n = len < size - 1 ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+
+// ---- String ----
+
+class String : public std::string {
+ public:
+  String(const char* s = "") : std::string(s ? s : "") {}
+  String(const std::string& s) : std::string(s) {}
+  String(char c) : std::string(1, c) {}
+  String(int v, int base = DEC) : std::string(fmt((long)v, base)) {}
+  String(unsigned v, int base = DEC) : std::string(fmtu(v, base)) {}
+  String(long v, int base = DEC) : std::string(fmt(v, base)) {}
+  String(unsigned long v, int base = DEC) : std::string(fmtu(v, base)) {}
+  String(float v, int decimals = 2) : std::string(fmtf(v, decimals)) {}
+  String(double v, int decimals = 2) : std::string(fmtf(v, decimals)) {}
+
+  int indexOf(const char* s, size_t from = 0) const {
+    size_t p = find(s, from);
+    return p == npos ? -1 : (int)p;
+  }
+  int indexOf(char c, size_t from = 0) const {
+    size_t p = find(c, from);
+    return p == npos ? -1 : (int)p;
+  }
+  bool startsWith(const char* s) const { return rfind(s, 0) == 0; }
+  bool endsWith(const char* s) const {
+    size_t n = strlen(s);
+    return size() >= n && compare(size() - n, n, s) == 0;
+  }
+  String substring(size_t from, size_t to = npos) const {
+    if (from > size()) return String();
+    return String(substr(from, to == npos ? npos : to - from));
+  }
+  long toInt() const { return strtol(c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(c_str(), nullptr); }
+  void remove(size_t i) { if (i < size()) erase(i); }
+  void trim() {
+    size_t a = find_first_not_of(" \t\r\n");
+    size_t b = find_last_not_of(" \t\r\n");
+    *this = a == npos ? String() : String(substr(a, b - a + 1));
+  }
+  void toLowerCase() { for (char& c : *this) c = (char)tolower((unsigned char)c); }
+  unsigned int length() const { return (unsigned int)size(); }
+
+ private:
+  static std::string fmt(long v, int base) {
+    if (base == DEC) return std::to_string(v);
+    return fmtu((unsigned long)v, base);
+  }
+  static std::string fmtu(unsigned long v, int base) {
+    if (base == DEC) return std::to_string(v);
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%lx", v);
+    return buf;
+  }
+  static std::string fmtf(double v, int decimals) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    return buf;
+  }
+};
+
+inline String operator+(const String& a, const String& b) {
+  return String(static_cast<const std::string&>(a) + static_cast<const std::string&>(b));
+}
+inline String operator+(const String& a, const char* b) { return String(static_cast<const std::string&>(a) + b); }
+inline String operator+(const char* a, const String& b) { return String(a + static_cast<const std::string&>(b)); }
+
+// ---- Serial — silent unless HOST_SERIAL_ECHO is set ----
+
+struct HostSerial {
+  bool echo = getenv("HOST_SERIAL_ECHO") != nullptr;
+  void print(const char* s) { if (echo) fputs(s, stdout); }
+  void print(const String& s) { print(s.c_str()); }
+  void print(char c) { if (echo) putchar(c); }
+  template <typename T> void print(T v) { print(String(v)); }
+  void println() { print("\n"); }
+  template <typename T> void println(T v) { print(v); println(); }
+};
+inline HostSerial Serial;
+
+// ---- HardwareSerial — bytes written land in out ----
+
+#define SERIAL_8N1 0x800001c
+
+struct HardwareSerial {
+  std::vector<uint8_t> out;
+  bool open = false;
+  void begin(unsigned long, uint32_t = SERIAL_8N1, int8_t = -1, int8_t = -1) { open = true; }
+  void end() { open = false; }
+  size_t write(const uint8_t* p, size_t n) {
+    out.insert(out.end(), p, p + n);
+    return n;
+  }
+};
+inline HardwareSerial Serial2;
+
+// ---- IPAddress ----
+
+struct IPAddress {
+  uint8_t b[4] = {0, 0, 0, 0};
+  IPAddress() {}
+  IPAddress(uint8_t a, uint8_t b1, uint8_t c, uint8_t d) : b{a, b1, c, d} {}
+  IPAddress(uint32_t v) { memcpy(b, &v, 4); }
+  operator uint32_t() const { uint32_t v; memcpy(&v, b, 4); return v; }
+  uint8_t operator[](int i) const { return b[i]; }
+  bool fromString(const char* s) {
+    unsigned v[4];
+    char tail;
+    if (!s || sscanf(s, "%u.%u.%u.%u%c", &v[0], &v[1], &v[2], &v[3], &tail) != 4) return false;
+    for (int i = 0; i < 4; i++) {
+      if (v[i] > 255) return false;
+      b[i] = (uint8_t)v[i];
+    }
+    return true;
+  }
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", b[0], b[1], b[2], b[3]);
+    return buf;
+  }
+};
+
+// ---- heap_caps ----
+
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_8BIT     (1 << 2)
+
+inline void* heap_caps_malloc(size_t n, uint32_t) { return malloc(n); }
+inline void* heap_caps_calloc(size_t n, size_t size, uint32_t) { return calloc(n, size); }
+inline void heap_caps_free(void* p) { free(p); }
+
+// ---- FreeRTOS — single-threaded stand-ins ----
+
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+struct portMUX_TYPE { int unused; };
+#define portMUX_INITIALIZER_UNLOCKED {0}
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux)  ((void)(mux))
+
+struct HostQueue {
+  size_t itemSize;
+  size_t depth;
+  std::deque<std::vector<uint8_t>> items;
+};
+typedef HostQueue* QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(size_t depth, size_t itemSize) {
+  return new HostQueue{itemSize, depth, {}};
+}
+inline BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t) {
+  if (q->items.size() >= q->depth) return pdFALSE;
+  const uint8_t* p = (const uint8_t*)item;
+  q->items.emplace_back(p, p + q->itemSize);
+  return pdTRUE;
+}
+inline BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t) {
+  if (q->items.empty()) return pdFALSE;
+  memcpy(item, q->items.front().data(), q->itemSize);
+  q->items.pop_front();
+  return pdTRUE;
+}
+
+// Tasks never start on the host — a test calls the task function itself.
+// The handle is the TCB, as in FreeRTOS.
+typedef void* TaskHandle_t;
+typedef uint8_t StackType_t;
+struct StaticTask_t { int unused; };
+inline void vTaskDelay(TickType_t) {}
+inline TaskHandle_t xTaskCreateStaticPinnedToCore(void (*)(void*), const char*, uint32_t, void*,
+                                                  unsigned, StackType_t*, StaticTask_t* tcb, BaseType_t) {
+  return tcb;
+}
+
+// Task notifications — defined by the test, which decides what a task is
+TaskHandle_t xTaskGetCurrentTaskHandle();
+void xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks);
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,75 @@
+#ifndef HOST_ARDUINO_GFX_LIBRARY_H
+#define HOST_ARDUINO_GFX_LIBRARY_H
+
+// ============================================================================
+// Host stand-in for Arduino_GFX — an RGB565 framebuffer and draw counters
+// ============================================================================
+// Fills land in fb (clipped to the panel) so a test can compare the screen
+// with what it should show; fillRects/fillScreens count the SPI pushes and
+// offscreen counts shapes that crossed the panel edge. Text is dropped.
+// ============================================================================
+
+#include <Arduino.h>
+
+#define GFX_NOT_DEFINED -1
+
+struct Arduino_DataBus {};
+
+struct Arduino_ESP32SPI : Arduino_DataBus {
+  Arduino_ESP32SPI(int8_t dc, int8_t cs, int8_t sck, int8_t mosi, int8_t miso) {}
+};
+
+class Arduino_GFX {
+ public:
+  int16_t width, height;
+  std::vector<uint16_t> fb;
+  uint32_t fillRects = 0;
+  uint32_t fillScreens = 0;
+  uint32_t offscreen = 0;
+
+  Arduino_GFX(int16_t w, int16_t h) : width(w), height(h), fb(w * h) {}
+  virtual ~Arduino_GFX() {}
+
+  bool begin() { return true; }
+
+  uint16_t pixel(int16_t x, int16_t y) const { return fb[y * width + x]; }
+
+  void fillScreen(uint16_t color) {
+    fillScreens++;
+    std::fill(fb.begin(), fb.end(), color);
+  }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    fillRects++;
+    paint(x, y, w, h, color);
+  }
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    paint(x, y, w, 1, color);
+    paint(x, y + h - 1, w, 1, color);
+    paint(x, y, 1, h, color);
+    paint(x + w - 1, y, 1, h, color);
+  }
+
+  void setCursor(int16_t, int16_t) {}
+  void setTextColor(uint16_t) {}
+  void setTextColor(uint16_t, uint16_t) {}
+  void setTextSize(uint8_t) {}
+  template <typename T> void print(T) {}
+
+ private:
+  void paint(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (x < 0 || y < 0 || x + w > width || y + h > height) offscreen++;
+    int16_t x1 = max<int16_t>(x, 0), y1 = max<int16_t>(y, 0);
+    int16_t x2 = min<int16_t>(x + w, width), y2 = min<int16_t>(y + h, height);
+    for (int16_t py = y1; py < y2; py++) {
+      for (int16_t px = x1; px < x2; px++) fb[py * width + px] = color;
+    }
+  }
+};
+
+struct Arduino_ST7789 : Arduino_GFX {
+  Arduino_ST7789(Arduino_DataBus* bus, int8_t rst, uint8_t rotation, bool ips, int16_t w,
+                 int16_t h, uint8_t colOffset1, uint8_t rowOffset1)
+      : Arduino_GFX(w, h) {}
+};
+
+#endif // HOST_ARDUINO_GFX_LIBRARY_H
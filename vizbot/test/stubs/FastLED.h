@@ -0,0 +1,232 @@
+#ifndef HOST_FASTLED_H
+#define HOST_FASTLED_H
+
+// ============================================================================
+// Host stand-in for FastLED — colours, controllers, show() and effect math
+// ============================================================================
+// addLeds() records each controller (pin, colour order, slice of leds[]) so
+// a test can check the wiring; show() counts frames. Brightness is stored,
+// not applied: tests read leds[] as the effects wrote it.
+//
+// The 8-bit math, noise and palettes follow FastLED's formulas closely
+// enough that effects look and cost about the same; they are not
+// bit-exact. The built-in palettes are coarse ramps of the real ones.
+// ============================================================================
+
+#include <Arduino.h>
+
+struct CRGB {
+  uint8_t r, g, b;
+
+  enum HTMLColorCode : uint32_t {
+    Black = 0x000000,
+    White = 0xFFFFFF,
+    Red   = 0xFF0000,
+    Green = 0x008000,
+    Blue  = 0x0000FF,
+  };
+
+  CRGB() = default;
+  constexpr CRGB(uint8_t r_, uint8_t g_, uint8_t b_) : r(r_), g(g_), b(b_) {}
+  constexpr CRGB(uint32_t rgb) : r(rgb >> 16), g(rgb >> 8), b(rgb) {}
+
+  CRGB& operator+=(const CRGB& o) {
+    r = min(255, r + o.r);
+    g = min(255, g + o.g);
+    b = min(255, b + o.b);
+    return *this;
+  }
+  CRGB& nscale8_video(uint8_t s);
+  bool operator==(const CRGB& o) const { return r == o.r && g == o.g && b == o.b; }
+  bool operator!=(const CRGB& o) const { return !(*this == o); }
+};
+
+// ---- 8-bit math ----
+
+inline uint8_t qadd8(uint8_t a, uint8_t b) { return min(255, a + b); }
+inline uint8_t qsub8(uint8_t a, uint8_t b) { return a > b ? a - b : 0; }
+inline uint8_t scale8(uint8_t v, uint8_t s) { return (v * (1 + s)) >> 8; }
+
+inline uint8_t sin8(uint8_t theta) {
+  static uint8_t table[256];
+  static bool ready = false;
+  if (!ready) {
+    for (int i = 0; i < 256; i++) table[i] = (uint8_t)lround(127.5 + 127.5 * sin(i * 2 * M_PI / 256));
+    ready = true;
+  }
+  return table[theta];
+}
+inline uint8_t cos8(uint8_t theta) { return sin8(theta + 64); }
+
+// FastLED's 16-bit LCG; random16_set_seed() makes a run repeatable
+inline uint16_t hostRand16 = 1337;
+inline void random16_set_seed(uint16_t seed) { hostRand16 = seed; }
+inline uint16_t random16() { return hostRand16 = hostRand16 * 2053 + 13849; }
+inline uint16_t random16(uint16_t lim) { return ((uint32_t)random16() * lim) >> 16; }
+inline uint8_t random8() {
+  uint16_t r = random16();
+  return (uint8_t)(r + (r >> 8));
+}
+inline uint8_t random8(uint8_t lim) { return (random8() * lim) >> 8; }
+inline uint8_t random8(uint8_t lo, uint8_t hi) { return lo + random8(hi - lo); }
+
+// ---- 3D Perlin noise (inoise8) ----
+
+namespace hostnoise {
+inline const uint8_t perm[257] = {
+  151,160,137,91,90,15,131,13,201,95,96,53,194,233,7,225,140,36,103,30,69,142,8,99,37,240,21,10,
+  23,190,6,148,247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,57,177,33,88,237,149,56,87,
+  174,20,125,136,171,168,68,175,74,165,71,134,139,48,27,166,77,146,158,231,83,111,229,122,60,211,
+  133,230,220,105,92,41,55,46,245,40,244,102,143,54,65,25,63,161,1,216,80,73,209,76,132,187,208,
+  89,18,169,200,196,135,130,116,188,159,86,164,100,109,198,173,186,3,64,52,217,226,250,124,123,5,
+  202,38,147,118,126,255,82,85,212,207,206,59,227,47,16,58,17,182,189,28,42,223,183,170,213,119,
+  248,152,2,44,154,163,70,221,153,101,155,167,43,172,9,129,22,39,253,19,98,108,110,79,113,224,232,
+  178,185,112,104,218,246,97,228,251,34,242,193,238,210,144,12,191,179,162,241,81,51,145,235,249,
+  14,239,107,49,192,214,31,181,199,106,157,184,84,204,176,115,121,50,45,127,4,150,254,138,236,205,
+  93,222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180,151
+};
+inline uint8_t P(uint8_t x) { return perm[x]; }
+inline int8_t grad(uint8_t h, int8_t x, int8_t y, int8_t z) {
+  h &= 0xF;
+  int8_t u = h < 8 ? x : y;
+  int8_t v = h < 4 ? y : (h == 12 || h == 14) ? x : z;
+  if (h & 1) u = -u;
+  if (h & 2) v = -v;
+  return (u + v) >> 1;
+}
+inline uint8_t ease(uint8_t i) {
+  return i < 128 ? (i * i) >> 7 : 255 - (((255 - i) * (255 - i)) >> 7);
+}
+inline int8_t lerp7(int8_t a, int8_t b, uint8_t f) { return a + (((b - a) * f) >> 8); }
+}  // namespace hostnoise
+
+inline uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z) {
+  using namespace hostnoise;
+  uint8_t X = x >> 8, Y = y >> 8, Z = z >> 8;
+  uint8_t A = P(X) + Y, AA = P(A) + Z, AB = P(A + 1) + Z;
+  uint8_t B = P(X + 1) + Y, BA = P(B) + Z, BB = P(B + 1) + Z;
+  uint8_t u = ease(x), v = ease(y), w = ease(z);
+  int8_t xx = (x >> 1) & 0x7F, yy = (y >> 1) & 0x7F, zz = (z >> 1) & 0x7F;
+  const int8_t N = 0x80;
+  int8_t x1 = lerp7(grad(P(AA), xx, yy, zz), grad(P(BA), xx - N, yy, zz), u);
+  int8_t x2 = lerp7(grad(P(AB), xx, yy - N, zz), grad(P(BB), xx - N, yy - N, zz), u);
+  int8_t x3 = lerp7(grad(P(AA + 1), xx, yy, zz - N), grad(P(BA + 1), xx - N, yy, zz - N), u);
+  int8_t x4 = lerp7(grad(P(AB + 1), xx, yy - N, zz - N), grad(P(BB + 1), xx - N, yy - N, zz - N), u);
+  int8_t n = lerp7(lerp7(x1, x2, v), lerp7(x3, x4, v), w);
+  return (uint8_t)constrain(n * 2 + 128, 0, 255);
+}
+
+// ---- Palettes ----
+
+#define DEFINE_GRADIENT_PALETTE(name) extern const uint8_t name[]; const uint8_t name[] PROGMEM =
+
+// Sixteen entries; built from gradient stops (index, r, g, b ... 255, r, g, b)
+struct CRGBPalette16 {
+  CRGB entries[16] = {};
+
+  CRGBPalette16() = default;
+  CRGBPalette16(const uint8_t* gradient) {
+    for (int i = 0; i < 16; i++) {
+      int pos = i * 17;
+      const uint8_t* a = gradient;
+      const uint8_t* b = gradient;
+      while (b[0] < pos) {
+        a = b;
+        b += 4;
+      }
+      int span = b[0] - a[0];
+      int f = span ? (pos - a[0]) * 255 / span : 0;
+      entries[i] = CRGB(a[1] + (b[1] - a[1]) * f / 255, a[2] + (b[2] - a[2]) * f / 255,
+                        a[3] + (b[3] - a[3]) * f / 255);
+    }
+  }
+};
+
+inline const uint8_t RainbowColors_p[] = {
+  0, 255, 0, 0,  64, 255, 255, 0,  128, 0, 255, 0,  192, 0, 0, 255,  255, 255, 0, 128 };
+inline const uint8_t OceanColors_p[] = {
+  0, 25, 25, 112,  128, 0, 128, 255,  255, 127, 255, 212 };
+inline const uint8_t LavaColors_p[] = {
+  0, 0, 0, 0,  96, 139, 0, 0,  192, 255, 165, 0,  255, 255, 255, 255 };
+inline const uint8_t ForestColors_p[] = {
+  0, 0, 100, 0,  128, 85, 107, 47,  255, 144, 238, 144 };
+inline const uint8_t PartyColors_p[] = {
+  0, 85, 0, 171,  64, 255, 0, 0,  128, 171, 171, 0,  192, 0, 85, 171,  255, 85, 0, 171 };
+inline const uint8_t HeatColors_p[] = {
+  0, 0, 0, 0,  85, 255, 0, 0,  170, 255, 255, 0,  255, 255, 255, 255 };
+inline const uint8_t CloudColors_p[] = {
+  0, 0, 0, 255,  128, 135, 206, 235,  255, 255, 255, 255 };
+
+// Blend between neighbouring entries, then scale by brightness
+inline CRGB ColorFromPalette(const CRGBPalette16& pal, uint8_t index, uint8_t brightness = 255) {
+  const CRGB& a = pal.entries[index >> 4];
+  const CRGB& b = pal.entries[((index >> 4) + 1) & 15];
+  uint8_t f2 = (index & 15) << 4, f1 = 255 - f2;
+  CRGB c(scale8(a.r, f1) + scale8(b.r, f2), scale8(a.g, f1) + scale8(b.g, f2),
+         scale8(a.b, f1) + scale8(b.b, f2));
+  if (brightness != 255) c = CRGB(scale8(c.r, brightness), scale8(c.g, brightness), scale8(c.b, brightness));
+  return c;
+}
+
+// ---- Colour ops ----
+
+// Scale without letting a lit channel reach zero
+inline uint8_t scale8_video(uint8_t v, uint8_t s) { return ((v * s) >> 8) + (v && s ? 1 : 0); }
+
+inline CRGB& CRGB::nscale8_video(uint8_t s) {
+  r = scale8_video(r, s);
+  g = scale8_video(g, s);
+  b = scale8_video(b, s);
+  return *this;
+}
+
+inline CRGB blend(const CRGB& a, const CRGB& b, uint8_t amountOfB) {
+  uint8_t amountOfA = 255 - amountOfB;
+  return CRGB(scale8(a.r, amountOfA) + scale8(b.r, amountOfB),
+              scale8(a.g, amountOfA) + scale8(b.g, amountOfB),
+              scale8(a.b, amountOfA) + scale8(b.b, amountOfB));
+}
+
+// ---- Buffers ----
+
+inline void fill_solid(CRGB* leds, int count, const CRGB& c) {
+  for (int i = 0; i < count; i++) leds[i] = c;
+}
+inline void fadeToBlackBy(CRGB* leds, uint16_t count, uint8_t fade) {
+  for (uint16_t i = 0; i < count; i++) {
+    leds[i] = CRGB(scale8(leds[i].r, 255 - fade), scale8(leds[i].g, 255 - fade),
+                   scale8(leds[i].b, 255 - fade));
+  }
+}
+
+enum EOrder { RGB = 0012, RBG = 0021, GRB = 0102, GBR = 0120, BRG = 0201, BGR = 0210 };
+enum ESPIChipsets { WS2812B };
+
+struct HostLedController {
+  uint8_t pin;
+  EOrder  order;
+  CRGB*   leds;
+  int     count;
+};
+
+struct HostFastLED {
+  std::vector<HostLedController> controllers;
+  uint8_t  brightness = 255;
+  uint32_t shows = 0;
+
+  template <ESPIChipsets CHIPSET, uint8_t PIN, EOrder ORDER>
+  void addLeds(CRGB* leds, int count) {
+    controllers.push_back({PIN, ORDER, leds, count});
+  }
+
+  void show() { shows++; }
+  void clear() {
+    for (HostLedController& c : controllers) memset(c.leds, 0, c.count * sizeof(CRGB));
+  }
+  void setBrightness(uint8_t b) { brightness = b; }
+  uint8_t getBrightness() const { return brightness; }
+};
+
+inline HostFastLED FastLED;
+
+#endif // HOST_FASTLED_H
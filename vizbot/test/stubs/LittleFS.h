@@ -0,0 +1,185 @@
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+// ============================================================================
+// Host stand-in for LittleFS — an in-memory flash
+// ============================================================================
+// Paths are flat keys; a directory exists once mkdir()ed or once a file is
+// under it. Writes land immediately (no close() needed to see them). A test
+// can shrink capacityBytes to make writes come up short, as on a full
+// partition, and reads counts bytes read for flash-traffic figures.
+// ============================================================================
+
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <set>
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+struct HostFS;
+
+class File {
+ public:
+  File() {}
+
+  explicit operator bool() const { return data != nullptr || isDir; }
+
+  size_t read(uint8_t* buf, size_t n);
+  int read() {
+    uint8_t b;
+    return read(&b, 1) == 1 ? b : -1;
+  }
+  int peek() {
+    if (!data || pos >= data->size()) return -1;
+    return (*data)[pos];
+  }
+  size_t write(const uint8_t* buf, size_t n);
+  size_t write(uint8_t b) { return write(&b, 1); }
+  size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+  size_t print(const String& s) { return print(s.c_str()); }
+
+  bool seek(uint32_t off, SeekMode mode = SeekSet) {
+    if (!data) return false;
+    size_t base = mode == SeekSet ? 0 : mode == SeekCur ? pos : data->size();
+    if (base + off > data->size()) return false;
+    pos = base + off;
+    return true;
+  }
+  size_t position() const { return pos; }
+  size_t size() const { return data ? data->size() : 0; }
+  int available() const { return data ? (int)(data->size() - pos) : 0; }
+  void flush() {}
+  void close() {
+    data.reset();
+    isDir = false;
+  }
+
+  bool isDirectory() const { return isDir; }
+  const char* name() const {
+    size_t slash = fullPath.rfind('/');
+    return fullPath.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+  }
+  const char* path() const { return fullPath.c_str(); }
+  File openNextFile();
+
+ private:
+  friend struct HostFS;
+  std::shared_ptr<std::vector<uint8_t>> data;
+  std::string fullPath;
+  size_t pos = 0;
+  bool writable = false;
+  bool isDir = false;
+  std::vector<std::string> entries;   // Directory listing, consumed by openNextFile()
+};
+
+struct HostFS {
+  std::map<std::string, std::shared_ptr<std::vector<uint8_t>>> files;
+  std::set<std::string> dirs;
+  size_t capacityBytes = 1 << 20;
+  uint64_t reads = 0;
+
+  bool begin(bool = false) { return true; }
+
+  size_t usedBytes() const {
+    size_t n = 0;
+    for (const auto& f : files) n += f.second->size();
+    return n;
+  }
+  size_t totalBytes() const { return capacityBytes; }
+
+  bool exists(const char* path) const { return files.count(path) || isDir(path); }
+  bool exists(const String& path) const { return exists(path.c_str()); }
+
+  bool isDir(const std::string& path) const {
+    if (dirs.count(path)) return true;
+    std::string prefix = path + "/";
+    auto it = files.lower_bound(prefix);
+    return it != files.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+  }
+
+  bool mkdir(const char* path) {
+    dirs.insert(path);
+    return true;
+  }
+  bool rmdir(const char* path) { return dirs.erase(path) > 0; }
+
+  bool remove(const char* path) { return files.erase(path) > 0; }
+  bool remove(const String& path) { return remove(path.c_str()); }
+
+  bool rename(const char* from, const char* to) {
+    auto it = files.find(from);
+    if (it == files.end()) return false;
+    files[to] = it->second;
+    files.erase(from);
+    return true;
+  }
+  bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+
+  File open(const char* path, const char* mode = "r") {
+    File f;
+    f.fullPath = path;
+    if (mode[0] == 'r' && isDir(path)) {
+      f.isDir = true;
+      std::string prefix = std::string(path) + "/";
+      for (const auto& e : files) {
+        if (e.first.compare(0, prefix.size(), prefix) == 0 &&
+            e.first.find('/', prefix.size()) == std::string::npos) {
+          f.entries.push_back(e.first);
+        }
+      }
+      return f;
+    }
+    auto it = files.find(path);
+    if (mode[0] == 'r') {
+      if (it == files.end()) return f;
+      f.data = it->second;
+    } else if (mode[0] == 'w' || it == files.end()) {
+      f.data = std::make_shared<std::vector<uint8_t>>();
+      files[path] = f.data;
+    } else {
+      f.data = it->second;
+    }
+    f.writable = mode[0] != 'r';
+    if (mode[0] == 'a') f.pos = f.data->size();
+    return f;
+  }
+  File open(const String& path, const char* mode = "r") { return open(path.c_str(), mode); }
+};
+
+inline HostFS LittleFS;
+
+inline size_t File::read(uint8_t* buf, size_t n) {
+  if (!data || pos >= data->size()) return 0;
+  n = std::min(n, data->size() - pos);
+  memcpy(buf, data->data() + pos, n);
+  pos += n;
+  LittleFS.reads += n;
+  return n;
+}
+
+inline size_t File::write(const uint8_t* buf, size_t n) {
+  if (!data || !writable) return 0;
+  size_t used = LittleFS.usedBytes();
+  size_t grow = pos + n > data->size() ? pos + n - data->size() : 0;
+  if (used + grow > LittleFS.capacityBytes) {
+    size_t room = LittleFS.capacityBytes > used ? LittleFS.capacityBytes - used : 0;
+    n -= std::min(n, grow - room);
+  }
+  if (pos + n > data->size()) data->resize(pos + n);
+  memcpy(data->data() + pos, buf, n);
+  pos += n;
+  return n;
+}
+
+inline File File::openNextFile() {
+  while (!entries.empty()) {
+    std::string p = entries.front();
+    entries.erase(entries.begin());
+    File f = LittleFS.open(p.c_str(), "r");
+    if (f) return f;
+  }
+  return File();
+}
+
+#endif // HOST_LITTLEFS_H
@@ -0,0 +1,97 @@
+#ifndef HOST_M5UNIFIED_H
+#define HOST_M5UNIFIED_H
+
+// ============================================================================
+// Host stand-in for M5Unified — the mic driver's job queue and the speaker
+// ============================================================================
+// record() queues a buffer; with two jobs pending it first completes the
+// oldest, as the real driver blocks until a slot frees. Sample values are
+// the stream position (mod 2^16) so a test can spot gaps, repeats and stale
+// buffers. stop() drops pending jobs — they never complete, like the I2S bus
+// being handed to the speaker — and skips the audio lost meanwhile.
+// ============================================================================
+
+#include <Arduino.h>
+#include <deque>
+#include <functional>
+
+struct HostMic {
+  struct config_t {
+    uint32_t sample_rate = 16000;
+    size_t dma_buf_count = 8;
+    size_t dma_buf_len = 128;
+  };
+
+  struct Job {
+    int16_t* buf;
+    size_t len;
+  };
+
+  config_t cfg;
+  bool enabled = true;
+  uint32_t nextSample = 0;
+  uint32_t recordCalls = 0;
+  std::deque<Job> pending;
+  std::function<void()> onRecord;   // Runs at the top of every record() — may throw to end a task
+
+  config_t config() const { return cfg; }
+  void config(const config_t& c) { cfg = c; }
+  bool begin() { enabled = true; return true; }
+
+  void stop(uint32_t lostSamples = 4000) {
+    enabled = false;
+    pending.clear();
+    nextSample += lostSamples;
+  }
+
+  bool record(int16_t* buf, size_t len, uint32_t) {
+    recordCalls++;
+    if (onRecord) onRecord();
+    if (!enabled) return false;
+    if (pending.size() >= 2) {
+      Job& j = pending.front();
+      for (size_t i = 0; i < j.len; i++) j.buf[i] = (int16_t)(nextSample++);
+      pending.pop_front();
+    }
+    pending.push_back({buf, len});
+    return true;
+  }
+};
+
+// playRaw() appends to played; the test decides how many blocks are still
+// queued in the speaker DMA (isPlaying)
+struct HostSpeaker {
+  struct config_t {
+    uint32_t sample_rate = 48000;
+  };
+
+  config_t cfg;
+  uint8_t volume = 0;
+  size_t queued = 0;
+  uint32_t stops = 0;
+  std::vector<int16_t> played;
+
+  config_t config() const { return cfg; }
+  void config(const config_t& c) { cfg = c; }
+  bool begin() { return true; }
+  void setVolume(uint8_t v) { volume = v; }
+  size_t isPlaying(uint8_t) const { return queued; }
+  void stop(uint8_t) {
+    queued = 0;
+    stops++;
+  }
+
+  bool playRaw(const int16_t* data, size_t n, uint32_t, bool, uint32_t, int, bool) {
+    played.insert(played.end(), data, data + n);
+    queued++;
+    return true;
+  }
+};
+
+struct HostM5 {
+  HostMic Mic;
+  HostSpeaker Speaker;
+};
+inline HostM5 M5;
+
+#endif // HOST_M5UNIFIED_H
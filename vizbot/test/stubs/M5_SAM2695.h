@@ -0,0 +1,16 @@
+#ifndef HOST_M5_SAM2695_H
+#define HOST_M5_SAM2695_H
+
+// Host stand-in for the M5-SAM2695 library — midi_synth.h only opens the
+// UART through it and encodes every message itself
+
+#include <Arduino.h>
+
+struct M5_SAM2695 {
+  void begin(HardwareSerial* serial, unsigned long baud, int8_t rx, int8_t tx) {
+    serial->begin(baud, SERIAL_8N1, rx, tx);
+  }
+  void setInstrument(uint8_t, uint8_t, uint8_t) {}
+};
+
+#endif // HOST_M5_SAM2695_H
@@ -0,0 +1,68 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+// Host stand-in for Preferences (NVS) — namespaces of key/value strings in
+// hostNvs, kept for the life of the test process.
+
+#include <Arduino.h>
+#include <map>
+
+inline std::map<std::string, std::map<std::string, std::string>> hostNvs;
+
+class Preferences {
+ public:
+  bool begin(const char* name, bool readOnly = false) {
+    ns = name;
+    ro = readOnly;
+    return true;
+  }
+  void end() { ns.clear(); }
+
+  bool isKey(const char* key) { return find(key) != nullptr; }
+  bool remove(const char* key) { return !ro && hostNvs[ns].erase(key) > 0; }
+  bool clear() {
+    if (ro) return false;
+    hostNvs[ns].clear();
+    return true;
+  }
+
+  uint8_t getUChar(const char* key, uint8_t def = 0) { return (uint8_t)getNum(key, def); }
+  bool getBool(const char* key, bool def = false) { return getNum(key, def) != 0; }
+  int32_t getInt(const char* key, int32_t def = 0) { return (int32_t)getNum(key, def); }
+  uint32_t getUInt(const char* key, uint32_t def = 0) { return (uint32_t)getNum(key, def); }
+  uint16_t getUShort(const char* key, uint16_t def = 0) { return (uint16_t)getNum(key, def); }
+  String getString(const char* key, const String& def = String()) {
+    const std::string* v = find(key);
+    return v ? String(*v) : def;
+  }
+
+  size_t putUChar(const char* key, uint8_t v) { return put(key, std::to_string(v), 1); }
+  size_t putBool(const char* key, bool v) { return put(key, std::to_string(v), 1); }
+  size_t putInt(const char* key, int32_t v) { return put(key, std::to_string(v), 4); }
+  size_t putUInt(const char* key, uint32_t v) { return put(key, std::to_string(v), 4); }
+  size_t putUShort(const char* key, uint16_t v) { return put(key, std::to_string(v), 2); }
+  size_t putString(const char* key, const char* v) { return put(key, v, strlen(v)); }
+  size_t putString(const char* key, const String& v) { return put(key, v, v.size()); }
+
+ private:
+  std::string ns;
+  bool ro = false;
+
+  const std::string* find(const char* key) {
+    auto n = hostNvs.find(ns);
+    if (n == hostNvs.end()) return nullptr;
+    auto k = n->second.find(key);
+    return k == n->second.end() ? nullptr : &k->second;
+  }
+  long long getNum(const char* key, long long def) {
+    const std::string* v = find(key);
+    return v ? strtoll(v->c_str(), nullptr, 10) : def;
+  }
+  size_t put(const char* key, const std::string& v, size_t size) {
+    if (ro || ns.empty()) return 0;
+    hostNvs[ns][key] = v;
+    return size;
+  }
+};
+
+#endif // HOST_PREFERENCES_H
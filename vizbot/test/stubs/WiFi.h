@@ -0,0 +1,138 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+// ============================================================================
+// Host stand-in for the WiFi object and TCP sockets
+// ============================================================================
+// WiFi.macAddress()/softAPmacAddress() are defined by the test. Sockets go to
+// hostNet: a WiFiClient's connect() asks hostNet.accept for a HostSocket (the
+// far end, scripted by the test) and refuses if it returns none. The bot's
+// writes collect in tx, where onSend can answer them; reads drain rx. A reply
+// put in `later` arrives once the host clock reaches laterAtUs.
+//
+// Polling an empty socket twice at the same instant costs a millisecond of
+// host clock (and calls hostNet.onWait, where a test runs the other core), so
+// the firmware's wait-for-data loops time out the way they do on a link.
+// ============================================================================
+
+#include <Arduino.h>
+#include <esp_now.h>
+#include <cstdarg>
+#include <functional>
+#include <memory>
+
+struct HostWiFi {
+  uint8_t* macAddress(uint8_t* mac);
+  uint8_t* softAPmacAddress(uint8_t* mac);
+};
+extern HostWiFi WiFi;
+
+// The far end of one connection
+struct HostSocket {
+  std::string rx;              // Sent by the peer, not yet read by the bot
+  std::string tx;              // Written by the bot
+  bool peerOpen = true;        // False once the peer has closed its side
+  bool closed = false;         // The bot called stop()
+  std::string later;           // Sent by the peer at laterAtUs
+  int64_t laterAtUs = -1;
+  bool closeAfterLater = false;
+  int64_t emptyPollUs = -1;    // Last poll that found nothing
+  std::function<void(HostSocket&)> onSend;   // Called after each write
+
+  void pump() {
+    if (laterAtUs < 0 || (int64_t)micros() < laterAtUs) return;
+    rx += later;
+    later.clear();
+    laterAtUs = -1;
+    if (closeAfterLater) peerOpen = false;
+  }
+};
+
+struct HostNet {
+  std::function<std::shared_ptr<HostSocket>(const char* host, uint16_t port)> accept;
+  std::function<void()> onWait;
+  uint32_t connects = 0;
+};
+inline HostNet hostNet;
+
+class WiFiClient {
+ public:
+  int connect(const char* host, uint16_t port) {
+    stop();
+    hostNet.connects++;
+    if (hostNet.accept) sock = hostNet.accept(host, port);
+    return sock != nullptr;
+  }
+  int connect(IPAddress ip, uint16_t port) { return connect(ip.toString().c_str(), port); }
+  void setTimeout(uint32_t) {}
+
+  uint8_t connected() {
+    if (!sock || sock->closed) return 0;
+    sock->pump();
+    return sock->peerOpen || !sock->rx.empty();
+  }
+  explicit operator bool() { return connected(); }
+
+  int available() {
+    if (!sock || sock->closed) return 0;
+    sock->pump();
+    if (sock->rx.empty()) {
+      if (sock->emptyPollUs == (int64_t)micros()) {
+        delay(1);
+        if (hostNet.onWait) hostNet.onWait();
+        sock->pump();
+      }
+      sock->emptyPollUs = micros();
+    }
+    return (int)sock->rx.size();
+  }
+  int read() {
+    uint8_t b;
+    return read(&b, 1) == 1 ? b : -1;
+  }
+  int read(uint8_t* buf, size_t n) {
+    if (!sock || sock->closed) return -1;
+    sock->pump();
+    if (sock->rx.empty()) return -1;
+    n = min(n, sock->rx.size());
+    memcpy(buf, sock->rx.data(), n);
+    sock->rx.erase(0, n);
+    return (int)n;
+  }
+  String readStringUntil(char end) {
+    String s;
+    int c;
+    while ((c = read()) >= 0 && c != end) s += (char)c;
+    return s;
+  }
+
+  size_t write(const uint8_t* buf, size_t n) {
+    if (!sock || sock->closed || !sock->peerOpen) return 0;
+    sock->tx.append((const char*)buf, n);
+    if (sock->onSend) sock->onSend(*sock);
+    return n;
+  }
+  size_t write(uint8_t b) { return write(&b, 1); }
+  size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+  size_t printf(const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(nullptr, 0, fmt, ap);
+    va_end(ap);
+    std::string s(n, '\0');
+    va_start(ap, fmt);
+    vsnprintf(&s[0], n + 1, fmt, ap);
+    va_end(ap);
+    return write((const uint8_t*)s.data(), s.size());
+  }
+
+  void stop() {
+    if (sock) sock->closed = true;
+    sock.reset();
+  }
+
+ private:
+  std::shared_ptr<HostSocket> sock;
+};
+
+#endif // HOST_WIFI_H
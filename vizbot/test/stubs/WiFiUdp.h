@@ -0,0 +1,45 @@
+#ifndef HOST_WIFIUDP_H
+#define HOST_WIFIUDP_H
+
+// Host stand-in for WiFiUDP — sent datagrams collect in hostUdpSent, oldest
+// first, stamped with the host clock. A test can set hostUdpFail to make
+// endPacket() report a send error.
+
+#include <Arduino.h>
+
+struct HostUdpPacket {
+  IPAddress ip;
+  uint16_t port;
+  std::vector<uint8_t> data;
+  unsigned long atMs;
+};
+inline std::vector<HostUdpPacket> hostUdpSent;
+inline bool hostUdpFail = false;
+
+class WiFiUDP {
+ public:
+  int beginPacket(IPAddress ip, uint16_t port) {
+    pkt = HostUdpPacket{ip, port, {}, 0};
+    open = true;
+    return 1;
+  }
+  size_t write(const uint8_t* buf, size_t n) {
+    if (!open) return 0;
+    pkt.data.insert(pkt.data.end(), buf, buf + n);
+    return n;
+  }
+  int endPacket() {
+    if (!open) return 0;
+    open = false;
+    if (hostUdpFail) return 0;
+    pkt.atMs = millis();
+    hostUdpSent.push_back(pkt);
+    return 1;
+  }
+
+ private:
+  HostUdpPacket pkt;
+  bool open = false;
+};
+
+#endif // HOST_WIFIUDP_H
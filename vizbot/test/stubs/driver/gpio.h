@@ -0,0 +1,17 @@
+#ifndef HOST_DRIVER_GPIO_H
+#define HOST_DRIVER_GPIO_H
+
+// Host stand-in for driver/gpio — wakeup levels only. Defined by the test.
+
+#include <Arduino.h>
+
+typedef int gpio_num_t;
+
+typedef enum {
+  GPIO_INTR_LOW_LEVEL = 4,
+  GPIO_INTR_HIGH_LEVEL = 5,
+} gpio_int_type_t;
+
+esp_err_t gpio_wakeup_enable(gpio_num_t gpio, gpio_int_type_t level);
+
+#endif // HOST_DRIVER_GPIO_H
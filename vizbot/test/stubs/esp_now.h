@@ -0,0 +1,35 @@
+#ifndef HOST_ESP_NOW_H
+#define HOST_ESP_NOW_H
+
+// Host stand-in for ESP-NOW. The fake radio in the test defines these.
+
+#include <Arduino.h>
+
+#define ESP_NOW_MAX_DATA_LEN 250
+
+typedef enum { WIFI_IF_STA = 0, WIFI_IF_AP = 1 } wifi_interface_t;
+
+typedef struct {
+  uint8_t* src_addr;
+  uint8_t* des_addr;
+  void*    rx_ctrl;
+} esp_now_recv_info_t;
+
+typedef void (*esp_now_recv_cb_t)(const esp_now_recv_info_t* info, const uint8_t* data, int len);
+
+typedef struct {
+  uint8_t          peer_addr[6];
+  uint8_t          lmk[16];
+  uint8_t          channel;
+  wifi_interface_t ifidx;
+  bool             encrypt;
+  void*            priv;
+} esp_now_peer_info_t;
+
+esp_err_t esp_now_init();
+esp_err_t esp_now_deinit();
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t cb);
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t* peer);
+esp_err_t esp_now_send(const uint8_t* peerAddr, const uint8_t* data, size_t len);
+
+#endif // HOST_ESP_NOW_H
@@ -0,0 +1,13 @@
+#ifndef HOST_ESP_SLEEP_H
+#define HOST_ESP_SLEEP_H
+
+// Host stand-in for esp_sleep — light sleep only. Defined by the test, which
+// decides how long a sleep lasts and what wakes it.
+
+#include <Arduino.h>
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t timeUs);
+esp_err_t esp_sleep_enable_gpio_wakeup();
+esp_err_t esp_light_sleep_start();
+
+#endif // HOST_ESP_SLEEP_H
@@ -0,0 +1,24 @@
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+// Host stand-in for esp_timer — one-shot timers only. Defined by the test.
+
+#include <Arduino.h>
+
+typedef struct HostTimer* esp_timer_handle_t;
+
+#define ESP_TIMER_TASK 0
+
+typedef struct {
+  void (*callback)(void* arg);
+  void* arg;
+  int dispatch_method;
+  const char* name;
+  bool skip_unhandled_events;
+} esp_timer_create_args_t;
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out);
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs);
+esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+
+#endif // HOST_ESP_TIMER_H
@@ -0,0 +1,190 @@
+// Mic capture (audio_capture.h): the record() rotation and the SPSC ring —
+// on a fake mic driver whose samples are their own stream position.
+
+#include "host_test.h"
+#include "host_clock.h"
+#include "config.h"
+#include "audio_capture.h"
+#include <thread>
+
+static const int kBlock = AUDIO_CAPTURE_BLOCK;
+
+struct TaskExit {};
+
+// What the render loop saw: every block it read, checked against the stream
+struct Reader {
+  uint32_t blocks = 0;
+  uint32_t gaps = 0;          // Block didn't start where the previous one ended
+  uint32_t backwards = 0;     // Block repeated or went back in the stream (stale buffer)
+  uint32_t torn = 0;          // Samples within one block not consecutive
+  bool have = false;
+  uint16_t expect = 0;
+  std::vector<uint16_t> starts;
+
+  void drain() {
+    int16_t buf[kBlock];
+    while (audioCapture.readBlock(buf, kBlock)) take(buf);
+  }
+
+  void take(const int16_t* buf) {
+    uint16_t first = (uint16_t)buf[0];
+    for (int i = 1; i < kBlock; i++) {
+      if ((uint16_t)buf[i] != (uint16_t)(first + i)) {
+        torn++;
+        break;
+      }
+    }
+    if (have && first != expect) {
+      if ((int16_t)(first - expect) < 0) backwards++;
+      else gaps++;
+    }
+    starts.push_back(first);
+    have = true;
+    expect = (uint16_t)(first + kBlock);
+    blocks++;
+  }
+};
+
+// Runs the capture task until the hook throws; the hook runs before every
+// record() call with the number of calls so far
+static void runTask(std::function<void(uint32_t)> hook) {
+  M5.Mic.onRecord = [&] { hook(M5.Mic.recordCalls); };
+  try {
+    audioCaptureTask(&audioCapture);
+  } catch (const TaskExit&) {
+  }
+  M5.Mic.onRecord = nullptr;
+}
+
+// A consumer keeping up sees every sample once, in order, from the first
+// completed block on
+TEST(steady_stream_is_gap_free) {
+  audioCapture.init();
+  Reader r;
+  runTask([&](uint32_t calls) {
+    r.drain();
+    if (calls > 2000) throw TaskExit();
+  });
+  r.drain();
+  CHECK_EQ(r.blocks, 2000 - (AUDIO_CAPTURE_BUFS - 1));
+  CHECK_EQ(audioCapture.blocksCaptured, r.blocks);
+  CHECK_EQ(r.starts[0], 0);
+  CHECK_EQ(r.gaps + r.backwards + r.torn, 0);
+  CHECK_EQ(audioCapture.overruns, 0);
+  CHECK_EQ(audioCapture.restarts, 0);
+}
+
+// A consumer that stalls loses whole blocks to overruns — never half a block
+TEST(slow_consumer_drops_whole_blocks) {
+  audioCapture.init();
+  Reader r;
+  runTask([&](uint32_t calls) {
+    if (calls % 40 == 0) r.drain();
+    if (calls > 2000) throw TaskExit();
+  });
+  r.drain();
+  CHECK(audioCapture.overruns > 0);
+  CHECK_EQ(audioCapture.blocksCaptured + audioCapture.overruns, 2000 - (AUDIO_CAPTURE_BUFS - 1));
+  CHECK_EQ(r.blocks, audioCapture.blocksCaptured);
+  CHECK_EQ(r.torn + r.backwards, 0);
+  for (uint16_t s : r.starts) CHECK_EQ(s % kBlock, 0);
+  REPORT("%u blocks read, %u dropped in %u stalls", r.blocks, (unsigned)audioCapture.overruns, r.gaps);
+}
+
+// The mic is taken by the speaker mid-stream, several times. Jobs queued
+// before each stop never complete, so the rotation must start over: no
+// stale buffer reaches the ring, each stop is exactly one gap, and the
+// consumer learns of it from restarts.
+TEST(mic_stop_restarts_rotation) {
+  audioCapture.init();
+  Reader r;
+  int stops = 0;
+  uint32_t failedAt = 0;
+  std::vector<uint16_t> resumeAt;
+  runTask([&](uint32_t calls) {
+    r.drain();
+    if (M5.Mic.enabled && calls % 100 == 50 && stops < 6) {
+      M5.Mic.stop();
+      stops++;
+      failedAt = calls;
+    } else if (!M5.Mic.enabled && calls - failedAt >= 7) {
+      M5.Mic.begin();
+      resumeAt.push_back((uint16_t)M5.Mic.nextSample);
+    }
+    if (calls > 1000) throw TaskExit();
+  });
+  r.drain();
+  CHECK_EQ(stops, 6);
+  CHECK_EQ(audioCapture.restarts, 6);
+  CHECK_EQ(r.backwards + r.torn, 0);
+  CHECK_EQ(r.gaps, 6);
+  // The first block after each restart is the first one recorded after it
+  for (uint16_t at : resumeAt) {
+    CHECK(std::find(r.starts.begin(), r.starts.end(), at) != r.starts.end());
+  }
+}
+
+// discard() drops what's buffered; the next block read is a fresh one
+TEST(discard_skips_to_live) {
+  audioCapture.init();
+  int16_t block[kBlock];
+  for (int b = 0; b < 10; b++) {
+    for (int i = 0; i < kBlock; i++) block[i] = (int16_t)(b * kBlock + i);
+    audioCapture.pushBlock(block, kBlock);
+  }
+  CHECK_EQ(audioCapture.available(), 10 * kBlock);
+  CHECK_EQ(audioCapture.latencyMs(), 10 * kBlock * 1000 / AUDIO_CAPTURE_RATE);
+  audioCapture.discard();
+  CHECK_EQ(audioCapture.available(), 0);
+  CHECK(!audioCapture.readBlock(block, kBlock));
+
+  for (int i = 0; i < kBlock; i++) block[i] = (int16_t)(7777 + i);
+  audioCapture.pushBlock(block, kBlock);
+  CHECK(audioCapture.readBlock(block, kBlock));
+  CHECK_EQ(block[0], 7777);
+}
+
+// Producer and consumer on two threads, as on the two cores: every block
+// read is one that was written, whole, and later than the one before. The
+// producer mostly waits for room, then now and then runs flat out.
+TEST(cross_thread_ring) {
+  audioCapture.init();
+  const uint32_t kBlocks = 200000;
+  auto fill = [](int16_t* block, uint32_t b) {
+    block[0] = (int16_t)(b & 0xFFFF);
+    block[1] = (int16_t)(b >> 16);
+    for (int i = 2; i < kBlock; i++) block[i] = (int16_t)(b * 31 + i);
+  };
+  std::thread producer([&] {
+    int16_t block[kBlock];
+    for (uint32_t b = 0; b < kBlocks; b++) {
+      fill(block, b);
+      if (b % 10000 < 9000) {
+        while (audioCapture.available() > AUDIO_RING_SAMPLES - kBlock) std::this_thread::yield();
+      }
+      audioCapture.pushBlock(block, kBlock);
+    }
+  });
+
+  uint32_t reads = 0, bad = 0;
+  int64_t last = -1;
+  int16_t buf[kBlock], want[kBlock];
+  auto check = [&] {
+    uint32_t b = (uint16_t)buf[0] | ((uint32_t)(uint16_t)buf[1] << 16);
+    fill(want, b);
+    if ((int64_t)b <= last || memcmp(buf, want, sizeof(buf)) != 0) bad++;
+    last = b;
+    reads++;
+  };
+  while (last < (int64_t)kBlocks - 1 && (int64_t)audioCapture.blocksCaptured + audioCapture.overruns < kBlocks) {
+    if (audioCapture.readBlock(buf, kBlock)) check();
+  }
+  producer.join();
+  while (audioCapture.readBlock(buf, kBlock)) check();
+  CHECK_EQ(bad, 0);
+  CHECK_EQ(reads, audioCapture.blocksCaptured);
+  CHECK_EQ(reads + audioCapture.overruns, kBlocks);
+  REPORT("%u blocks read, %u overruns", reads, (unsigned)audioCapture.overruns);
+}
+
+HOST_TEST_MAIN
@@ -0,0 +1,159 @@
+// Audio features (audio_features.h): octave bands, onsets, tempo and beat
+// phase — on synthetic 16 kHz mic blocks.
+
+#include "host_test.h"
+#include "host_clock.h"
+#include "config.h"
+#include "audio_features.h"
+
+static const int kRate = 16000;
+static const int kBlock = AUDIO_FFT_SIZE;              // 16 ms
+static const unsigned long kBlockMs = kBlock * 1000 / kRate;
+
+static AudioFeatures features;
+
+// Synthetic mic: a sine plus a decaying noise burst every periodMs
+struct Signal {
+  float toneHz = 0;
+  float toneAmp = 0;
+  float clickPeriodMs = 0;
+  float clickAmp = 12000;
+  float noiseAmp = 30;
+  uint64_t n = 0;
+  std::mt19937 rng{5};
+
+  void fill(int16_t* out) {
+    std::uniform_real_distribution<float> u(-1, 1);
+    for (int i = 0; i < kBlock; i++, n++) {
+      float t = (float)n / kRate;
+      float s = toneAmp * sinf(2 * (float)PI * toneHz * t) + noiseAmp * u(rng);
+      if (clickPeriodMs > 0) {
+        float sinceMs = fmodf(t * 1000, clickPeriodMs);
+        if (sinceMs < 30) s += clickAmp * expf(-sinceMs / 6) * u(rng);
+      }
+      out[i] = (int16_t)constrain(s, -32767.0f, 32767.0f);
+    }
+  }
+};
+
+struct Run {
+  int onsets = 0;
+  int beats = 0;
+  std::vector<unsigned long> beatMs;
+};
+
+static Run feed(Signal& sig, float seconds) {
+  Run r;
+  int16_t block[kBlock];
+  int blocks = (int)(seconds * 1000 / kBlockMs);
+  for (int b = 0; b < blocks; b++) {
+    sig.fill(block);
+    hostAdvanceMs(kBlockMs);
+    features.process(block, millis());
+    if (features.onsetDetected) r.onsets++;
+    if (features.beatDetected) {
+      r.beats++;
+      r.beatMs.push_back(millis());
+    }
+  }
+  return r;
+}
+
+static int loudestBand() {
+  int best = 0;
+  for (int b = 1; b < AUDIO_NUM_BANDS; b++) {
+    if (features.bandEnergy[b] > features.bandEnergy[best]) best = b;
+  }
+  return best;
+}
+
+// A tone lands in its octave: 1 kHz is bin 16, band [16,32); 200 Hz is bin
+// 3.2, band [2,4)
+TEST(tone_lands_in_its_band) {
+  features.init();
+  Signal sig;
+  sig.toneAmp = 8000;
+  sig.toneHz = 1000;
+  feed(sig, 0.5f);
+  CHECK_EQ(loudestBand(), 4);
+  CHECK_NEAR(features.bandLevel[4], 1.0f, 0.05f);
+
+  sig.toneHz = 200;
+  feed(sig, 0.5f);
+  CHECK_EQ(loudestBand(), 1);
+}
+
+// Steady noise and a steady tone are not onsets; every click is, once
+TEST(onsets_on_clicks_only) {
+  features.init();
+  Signal sig;
+  sig.toneAmp = 4000;
+  sig.toneHz = 440;
+  feed(sig, 1.0f);
+  Run quiet = feed(sig, 3.0f);
+  CHECK_EQ(quiet.onsets, 0);
+
+  sig.clickPeriodMs = 500;
+  Run clicks = feed(sig, 5.0f);
+  CHECK_NEAR(clicks.onsets, 10, 1);
+}
+
+// Click trains at a few tempos: the estimate settles within 3% and the
+// reported beats are one period apart
+static void checkTempo(float bpm) {
+  features.init();
+  Signal sig;
+  sig.clickPeriodMs = 60000 / bpm;
+  feed(sig, 8.0f);
+  CHECK_NEAR(features.bpm, bpm, bpm * 0.03f);
+  CHECK(features.tempoConfidence >= AUDIO_TEMPO_CONFIDENCE);
+
+  Run r = feed(sig, 6.0f);
+  CHECK_NEAR(r.beats, 6.0f * bpm / 60, 1);
+  for (size_t i = 1; i < r.beatMs.size(); i++) {
+    CHECK_NEAR(r.beatMs[i] - r.beatMs[i - 1], sig.clickPeriodMs, kBlockMs + 2);
+  }
+  REPORT("%.0f BPM: estimate %.1f, confidence %.2f, %d beats in 6 s",
+         bpm, features.bpm, features.tempoConfidence, r.beats);
+}
+
+TEST(tempo_90) { checkTempo(90); }
+TEST(tempo_120) { checkTempo(120); }
+TEST(tempo_150) { checkTempo(150); }
+
+// Gaps between blocks (the mic paused) don't skew the tempo — spacing is
+// measured, not assumed
+TEST(tempo_with_uneven_blocks) {
+  features.init();
+  Signal sig;
+  sig.clickPeriodMs = 500;
+  int16_t block[kBlock];
+  for (int b = 0; b < 900; b++) {
+    sig.fill(block);
+    hostAdvanceMs(kBlockMs + (b % 5 == 0 ? 1 : 0));
+    features.process(block, millis());
+  }
+  CHECK_NEAR(features.bpm, 120, 4);
+}
+
+// reset() (capture restarted) forgets the tempo and the onset envelope: a
+// steady tone afterwards yields no beats from the old click train
+TEST(reset_forgets_history) {
+  features.init();
+  Signal sig;
+  sig.clickPeriodMs = 500;
+  feed(sig, 8.0f);
+  CHECK(features.bpm > 0);
+
+  features.reset();
+  CHECK_EQ(features.bpm, 0);
+  CHECK_EQ(features.tempoConfidence, 0);
+  Signal steady;
+  steady.toneAmp = 8000;
+  steady.toneHz = 1000;
+  Run r = feed(steady, 3.0f);
+  CHECK_EQ(r.beats, 0);
+  CHECK_EQ(features.bpm, 0);
+}
+
+HOST_TEST_MAIN
@@ -0,0 +1,231 @@
+// Streamed JSON (json_stream.h, http_stream.h) and the WLED seg[0] read built
+// on them: real /json/state bodies under both framings at every read size,
+// generic paths, malformed input, wledFetchSegState() over a socket, and no
+// heap on the parse path.
+
+#include "host_test.h"
+#include "wled_host.h"
+#include <atomic>
+#include <new>
+
+// Heap use on the current thread while counting is on
+static std::atomic<long> heapAllocs(0);
+static bool countHeap = false;
+void* operator new(size_t n) {
+  if (countHeap) heapAllocs++;
+  void* p = malloc(n ? n : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+static std::string slurp(const char* path) {
+  std::string s;
+  FILE* f = fopen(path, "rb");
+  if (!f) return s;
+  char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) s.append(buf, n);
+  fclose(f);
+  return s;
+}
+
+struct Fixture {
+  const char* file;
+  int fx, sx, ix, pal;
+  const char* name;
+  uint8_t found;
+};
+
+// Compact 0.14 state; a segment with no name; and a pretty-printed
+// multi-segment one whose name has \u, \" and \\ escapes
+static const Fixture kFixtures[] = {
+    {"fixtures/state_014.json", 9, 128, 128, 11, "Desk Matrix", 0x1F},
+    {"fixtures/state_unnamed.json", 0, 128, 128, 0, "", 0x0F},
+    {"fixtures/state_multiseg_pretty.json", 72, 200, 40, 35, "Caf? \"Wall\" \\ 1", 0x1F},
+};
+
+enum Framing { LENGTH, CHUNKED, CLOSE };
+
+static std::string response(const std::string& body, Framing framing) {
+  std::string http = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n";
+  if (framing == LENGTH) {
+    http += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+  } else if (framing == CLOSE) {
+    http += "Connection: close\r\n\r\n" + body;
+  } else {
+    http += "transfer-encoding: Chunked\r\n\r\n";
+    for (size_t i = 0; i < body.size(); i += 97) {
+      char size[24];
+      snprintf(size, sizeof(size), "%zX;ext=1\r\n", min((size_t)97, body.size() - i));
+      http += size + body.substr(i, 97) + "\r\n";
+    }
+    http += "0\r\n\r\n";
+  }
+  return http;
+}
+
+// A response through HttpStream in `step`-byte reads
+static JsonStreamResult parseSteps(const std::string& http, size_t step, WledSegState& seg,
+                                   uint32_t* bodyRead = nullptr) {
+  memset(&seg, 0, sizeof(seg));
+  seg.path = "seg/0";
+  JsonStream js;
+  HttpStream hs;
+  js.begin(wledSegHandler, &seg);
+  hs.begin(&js);
+  JsonStreamResult r = JSON_STREAM_MORE;
+  for (size_t i = 0; i < http.size() && r == JSON_STREAM_MORE; i += step) {
+    r = hs.feed((const uint8_t*)http.data() + i, min(step, http.size() - i));
+  }
+  if (bodyRead) *bodyRead = js.bytes;
+  return r;
+}
+
+static bool matches(const WledSegState& s, const Fixture& f) {
+  return s.fx == f.fx && s.sx == f.sx && s.ix == f.ix && s.pal == f.pal &&
+         strcmp(s.name, f.name) == 0 && s.found == f.found;
+}
+
+// Every fixture, Content-Length and chunked, read 1 byte at a time up to all
+// at once: the fields come out right and parsing stops once seg[0] closes
+TEST(seg_fields_any_read_size) {
+  for (const Fixture& f : kFixtures) {
+    const std::string body = slurp(f.file);
+    CHECK(!body.empty());
+    for (Framing framing : {LENGTH, CHUNKED}) {
+      const std::string http = response(body, framing);
+      for (size_t step : {1, 2, 3, 7, 64, 128, 1460, 100000}) {
+        WledSegState s;
+        uint32_t read = 0;
+        CHECK_EQ(parseSteps(http, step, s, &read), JSON_STREAM_STOPPED);
+        CHECK(matches(s, f));
+        CHECK(read < body.size());
+      }
+    }
+  }
+}
+
+// Paths through a full /json document: nested keys, * over an array, and a
+// count after the part a seg handler would have stopped at
+TEST(generic_paths) {
+  const std::string body = slurp("fixtures/json_full.json");
+  struct Seen {
+    int fx = -1, effects = 0, palCount = -1;
+    char lastFx[JSON_STREAM_VALUE_LEN] = "";
+  } seen;
+  JsonStream js;
+  js.begin(
+      [](JsonStream& j, void* p) {
+        Seen& seen = *(Seen*)p;
+        if (j.event != JSON_EV_VALUE) return true;
+        if (j.at("state/seg/0/fx")) seen.fx = j.asInt();
+        if (j.at("effects/*")) {
+          seen.effects++;
+          j.copyValue(seen.lastFx, sizeof(seen.lastFx));
+        }
+        if (j.at("info/palcount")) seen.palCount = j.asInt();
+        return true;
+      },
+      &seen);
+  CHECK_EQ(js.feed(body.data(), body.size()), JSON_STREAM_DONE);
+  CHECK_EQ(seen.fx, 9);
+  CHECK_EQ(seen.effects, 187);
+  CHECK(strcmp(seen.lastFx, "Effect 186") == 0);
+  CHECK_EQ(seen.palCount, 71);
+}
+
+TEST(malformed_input) {
+  for (const char* bad : {"{\"a\":}", "{\"a\" 1}", "[1,2}", "{\"a\":1]", "{\"a\":1,}x", "{,}", "]"}) {
+    JsonStream js;
+    js.begin(nullptr, nullptr);
+    CHECK_EQ(js.feed(bad, strlen(bad)), JSON_STREAM_ERROR);
+  }
+  for (const char* good : {"{}", "[]", " [ ] ", "{\"a\":[[],{}],\"b\":-1.5e+3,\"c\":null,\"d\":true}",
+                           "7 ", "\"x\\u00e9y\""}) {
+    JsonStream js;
+    js.begin(nullptr, nullptr);
+    CHECK_EQ(js.feed(good, strlen(good)), JSON_STREAM_DONE);
+  }
+
+  // Past JSON_STREAM_MAX_DEPTH still parses but never matches; past
+  // JSON_STREAM_MAX_NEST is an error
+  std::string deep;
+  for (int i = 0; i < 20; i++) deep += "{\"k\":";
+  deep += "1";
+  for (int i = 0; i < 20; i++) deep += "}";
+  int hits = 0;
+  JsonStream js;
+  js.begin(
+      [](JsonStream& j, void* p) {
+        if (j.event == JSON_EV_VALUE && j.at("k/k")) (*(int*)p)++;
+        return true;
+      },
+      &hits);
+  CHECK_EQ(js.feed(deep.data(), deep.size()), JSON_STREAM_DONE);
+  CHECK_EQ(hits, 0);
+  std::string tooDeep(JSON_STREAM_MAX_NEST + 8, '[');
+  js.begin(nullptr, nullptr);
+  CHECK_EQ(js.feed(tooDeep.data(), tooDeep.size()), JSON_STREAM_ERROR);
+
+  // A body cut short of its Content-Length, and no status line at all
+  WledSegState s;
+  CHECK_EQ(parseSteps("HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\n{\"seg\":[{\"f", 4, s),
+           JSON_STREAM_ERROR);
+  CHECK_EQ(parseSteps("garbage\r\n\r\n{}", 5, s), JSON_STREAM_ERROR);
+}
+
+// wledFetchSegState() against a socket serving each fixture under each
+// framing, including a server that only ends the body by closing
+TEST(fetch_over_socket) {
+  wledHostBoot();
+  static std::string served;
+  hostNet.accept = [](const char*, uint16_t) {
+    auto s = std::make_shared<HostSocket>();
+    s->onSend = [](HostSocket& s) {
+      if (s.tx.find("\r\n\r\n") == std::string::npos) return;
+      s.rx = served;
+      s.peerOpen = false;
+    };
+    return s;
+  };
+  for (const Fixture& f : kFixtures) {
+    for (Framing framing : {LENGTH, CHUNKED, CLOSE}) {
+      served = response(slurp(f.file), framing);
+      WledSegState s;
+      CHECK(wledFetchSegState(s));
+      CHECK(matches(s, f));
+    }
+  }
+  served = "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n";
+  WledSegState s;
+  CHECK(!wledFetchSegState(s));
+}
+
+// The parse path itself never touches the heap, and what it costs per byte
+TEST(no_heap_and_cost) {
+  for (const Fixture& f : kFixtures) {
+    const std::string http = response(slurp(f.file), LENGTH);
+    WledSegState s;
+    heapAllocs = 0;
+    countHeap = true;
+    parseSteps(http, WLED_HTTP_WINDOW, s);
+    countHeap = false;
+    CHECK_EQ(heapAllocs.load(), 0);
+
+    const int reps = 2000;
+    struct timespec a, b;
+    clock_gettime(CLOCK_MONOTONIC, &a);
+    uint32_t read = 0;
+    for (int i = 0; i < reps; i++) parseSteps(http, WLED_HTTP_WINDOW, s, &read);
+    clock_gettime(CLOCK_MONOTONIC, &b);
+    const double ns = ((b.tv_sec - a.tv_sec) * 1e9 + (b.tv_nsec - a.tv_nsec)) / reps;
+    REPORT("%-28s %5zu bytes, stopped after %4u of the body: %6.0f ns", strrchr(f.file, '/') + 1,
+           http.size(), read, ns);
+  }
+  REPORT("sizeof JsonStream %zu, HttpStream %zu, window %d", sizeof(JsonStream),
+         sizeof(HttpStream), WLED_HTTP_WINDOW);
+}
+
+HOST_TEST_MAIN
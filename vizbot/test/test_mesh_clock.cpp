@@ -0,0 +1,155 @@
+// Mesh clock (esp_now_mesh.h): one timebase across radio cells, and relayed
+// play-at actions firing together on every bot — on the fake radio.
+
+#include "host_test.h"
+#include "mesh_sim.h"
+
+static const uint8_t kPlayExpression = 0;   // MESH_PLAY_EXPRESSION
+
+static bool allSynced(MeshSim& sim, const std::vector<int>& nodes) {
+  for (int i : nodes) {
+    if (!sim.fw(i).clockSynced() || sim.fw(i).clockMaster() != sim.fw(nodes[0]).clockMaster()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static std::vector<int> range(int from, int to) {
+  std::vector<int> v;
+  for (int i = from; i < to; i++) v.push_back(i);
+  return v;
+}
+
+static int masterIndex(MeshSim& sim, const std::vector<int>& nodes) {
+  for (int i : nodes) {
+    if (sim.fw(i).nodeId() == sim.fw(i).clockMaster()) return i;
+  }
+  return -1;
+}
+
+// Node i's mesh time minus node ref's, at the same true instant
+static int64_t clockError(MeshSim& sim, int i, int ref) {
+  return sim.fw(i).meshTimeAt(sim.localUs(i)) - sim.fw(ref).meshTimeAt(sim.localUs(ref));
+}
+
+// Worst |error| against the master over a window, sampled every 100ms
+static int64_t worstError(MeshSim& sim, const std::vector<int>& nodes, int master, int64_t forUs) {
+  int64_t worst = 0;
+  for (int64_t t = 0; t < forUs; t += 100000) {
+    sim.run(100000);
+    for (int i : nodes) worst = std::max<int64_t>(worst, std::llabs(clockError(sim, i, master)));
+  }
+  return worst;
+}
+
+// Starts an expression from `origin` and returns the spread of the fire
+// times across `nodes` (true time, us); every node must fire exactly once
+static int64_t playSpread(MeshSim& sim, int origin, const std::vector<int>& nodes, uint16_t expr) {
+  for (int i : nodes) sim.node(i).fired.clear();
+  bool sent = false;
+  sim.as(origin, [&] { sent = sim.fw(origin).playAt(kPlayExpression, expr, nullptr, 400); });
+  CHECK(sent);
+  sim.run(1500000);
+  int64_t first = INT64_MAX, last = INT64_MIN;
+  for (int i : nodes) {
+    CHECK_EQ(sim.node(i).fired.size(), 1u);
+    CHECK_EQ(sim.node(i).fired[0].arg, expr);
+    first = std::min(first, sim.node(i).fired[0].atUs);
+    last = std::max(last, sim.node(i).fired[0].atUs);
+  }
+  return last - first;
+}
+
+// Two cells of three bots, bridged by one link and booted seconds apart. A
+// play-at started in the cell without the master crosses the bridge as a
+// relay and must fire on all six together — with a master per cell the far
+// cell read the stamp against its own clock and fired seconds off.
+TEST(two_cells_fire_together) {
+  MeshSim sim(6, 11);
+  sim.fullyConnect(0, 3);
+  sim.fullyConnect(3, 6);
+  sim.link(2, 3);
+  sim.bootAll(3000000);
+  std::vector<int> all = range(0, 6);
+  int64_t start = sim.now();
+  sim.runUntil([&] { return allSynced(sim, all); }, 30000000);
+  CHECK(allSynced(sim, all));
+  REPORT("one master, all synced after %.1f s", (sim.now() - start) / 1e6);
+  sim.run(10000000);
+
+  int master = masterIndex(sim, all);
+  CHECK(master >= 0);
+  if (master < 0) return;
+  int origin = master < 3 ? 5 : 0;   // Far end of the other cell
+  int far = master < 3 ? 4 : 1;      // Two bridge hops from the master
+  CHECK_EQ(sim.fw(far).clockStratum(), sim.hops(far, master));
+
+  int64_t spread = playSpread(sim, origin, all, 7);
+  CHECK(spread < 2000);
+  REPORT("master node %d, fired from node %d, spread %lld us", master, origin, (long long)spread);
+}
+
+// Four cells of four in a chain: two strata per cell, up to 7 with the
+// master at one end. Drift is trimmed gently (cascaded loops amplify wander
+// otherwise), so the far cells take ~40 s after sync to settle; after that
+// the error stays sub-ms.
+TEST(chain_of_cells_error) {
+  MeshSim sim(16, 5);
+  for (int c = 0; c < 4; c++) sim.fullyConnect(c * 4, c * 4 + 4);
+  for (int c = 0; c < 3; c++) sim.link(c * 4 + 3, c * 4 + 4);
+  sim.bootAll(1000000);
+  std::vector<int> all = range(0, 16);
+  sim.runUntil([&] { return allSynced(sim, all); }, 60000000);
+  CHECK(allSynced(sim, all));
+  sim.run(60000000);
+
+  int master = masterIndex(sim, all);
+  CHECK(master >= 0);
+  if (master < 0) return;
+  uint8_t maxStratum = 0;
+  for (int i : all) maxStratum = std::max(maxStratum, sim.fw(i).clockStratum());
+  int64_t worst = worstError(sim, all, master, 20000000);
+  CHECK(worst < 1000);
+  REPORT("max stratum %u, worst error vs master %lld us", maxStratum, (long long)worst);
+
+  int64_t spread = playSpread(sim, master < 8 ? 15 : 0, all, 9);
+  CHECK(spread < 2000);
+  REPORT("play-at across 4 cells, spread %lld us", (long long)spread);
+}
+
+// The master drops out: once it is evicted everyone agrees on the next
+// lowest node id, resyncs, and play-at works again
+TEST(master_leaves) {
+  MeshSim sim(6, 11);
+  sim.fullyConnect(0, 3);
+  sim.fullyConnect(3, 6);
+  sim.link(2, 3);
+  sim.bootAll(3000000);
+  std::vector<int> all = range(0, 6);
+  sim.runUntil([&] { return allSynced(sim, all); }, 30000000);
+  int master = masterIndex(sim, all);
+  CHECK(master >= 0);
+  if (master < 0) return;
+
+  for (int j : all) {
+    if (j != master) sim.link(master, j, false);
+  }
+  std::vector<int> rest;
+  for (int i : all) {
+    if (i != master) rest.push_back(i);
+  }
+  if (master == 2 || master == 3) sim.link(1, 4);   // Keep the survivors connected
+  sim.runUntil([&] {
+    return allSynced(sim, rest) && sim.fw(rest[0]).clockMaster() != sim.fw(master).nodeId();
+  }, 40000000);
+  CHECK(allSynced(sim, rest));
+  CHECK(sim.fw(rest[0]).clockMaster() != sim.fw(master).nodeId());
+  sim.run(10000000);
+
+  int64_t spread = playSpread(sim, rest.back(), rest, 3);
+  CHECK(spread < 2000);
+  REPORT("new master node %d, spread %lld us", masterIndex(sim, rest), (long long)spread);
+}
+
+HOST_TEST_MAIN
@@ -0,0 +1,151 @@
+// WLED lease (wled_lease.h): one arbiter per WLED, never two holders at
+// once, everyone served in turn, speech ahead of streams — on the fake radio.
+
+#include "host_test.h"
+#include "mesh_sim.h"
+
+static const uint32_t kWledIP = 0x0A01A8C0;   // 192.168.1.10
+static const uint8_t kPrioStream = 0;         // WLED_LEASE_PRIO_STREAM
+static const uint8_t kPrioSpeech = 1;         // WLED_LEASE_PRIO_SPEECH
+static const int64_t kTickUs = 2000;
+
+// What a display mode does with the lease: ask every tick until granted,
+// send for a while (wledLeaseHeld() each frame), release, pause
+struct LeaseClient {
+  uint8_t  prio = kPrioStream;
+  int64_t  useUs = 1500000;
+  int64_t  nextStartUs = 0;
+  bool     wanting = false;
+  int64_t  grantedUs = -1;
+  int64_t  firstGrantUs = -1;
+  int      grants = 0;
+  bool     holding = false;    // wledLeaseHeld() on the last tick
+};
+
+static void clientTick(MeshSim& sim, int i, LeaseClient& c) {
+  sim.as(i, [&] {
+    MeshSimFirmware& fw = sim.fw(i);
+    c.holding = false;
+    if (!c.wanting) {
+      if (sim.now() < c.nextStartUs) return;
+      c.wanting = true;
+      c.grantedUs = -1;
+    }
+    fw.leaseRequest(c.prio, c.prio == kPrioSpeech ? 4000 : 3000);
+    if (!fw.leaseHeld()) return;
+    c.holding = true;
+    if (c.grantedUs < 0) {
+      c.grantedUs = sim.now();
+      if (c.grants++ == 0) c.firstGrantUs = sim.now();
+    }
+    if (sim.now() - c.grantedUs >= c.useUs || fw.leaseRevoked()) {
+      fw.leaseRelease();
+      c.holding = false;
+      c.wanting = false;
+      c.nextStartUs = sim.now() + 300000 + (int64_t)(sim.rng() % 1500000);
+    }
+  });
+}
+
+// Runs the clients for forUs; returns the most bots holding at one instant
+static int runClients(MeshSim& sim, std::vector<LeaseClient>& clients, int64_t forUs) {
+  int most = 0;
+  for (int64_t t = 0; t < forUs; t += kTickUs) {
+    sim.run(kTickUs);
+    int holding = 0;
+    for (int i = 0; i < (int)clients.size(); i++) {
+      clientTick(sim, i, clients[i]);
+      if (clients[i].holding) holding++;
+    }
+    most = std::max(most, holding);
+  }
+  return most;
+}
+
+static uint32_t lowestNodeId(MeshSim& sim) {
+  uint32_t lowest = UINT32_MAX;
+  for (int i = 0; i < sim.size(); i++) lowest = std::min(lowest, sim.fw(i).nodeId());
+  return lowest;
+}
+
+// Eight bots on one WLED whose MACs share the last byte, so every header
+// carries the same deviceId. With the lease keyed on deviceId each bot saw
+// "lowest id == mine", arbitrated for itself and granted itself.
+TEST(colliding_device_ids_one_holder) {
+  MeshSim sim(8, 3);
+  for (int i = 0; i < sim.size(); i++) sim.node(i).mac[5] = 0x5A;
+  sim.fullyConnect(0, sim.size());
+  sim.bootAll(200000, kWledIP);
+  sim.run(3000000);
+
+  uint32_t arbiter = lowestNodeId(sim);
+  for (int i = 0; i < sim.size(); i++) CHECK_EQ(sim.fw(i).leaseArbiter(), arbiter);
+
+  std::vector<LeaseClient> clients(sim.size());
+  int most = runClients(sim, clients, 60000000);
+  CHECK_EQ(most, 1);
+  int fewest = INT32_MAX, total = 0;
+  for (const LeaseClient& c : clients) {
+    fewest = std::min(fewest, c.grants);
+    total += c.grants;
+  }
+  CHECK(fewest >= 2);
+  REPORT("%d grants in 60 s, fewest per bot %d", total, fewest);
+}
+
+// Two cells of four bridged by one link: half the bots reach the arbiter only
+// through relays, and still see the same arbiter and the same single holder
+TEST(relayed_arbiter) {
+  MeshSim sim(8, 5);
+  sim.fullyConnect(0, 4);
+  sim.fullyConnect(4, 8);
+  sim.link(3, 4);
+  sim.bootAll(200000, kWledIP);
+  sim.run(5000000);
+
+  uint32_t arbiter = lowestNodeId(sim);
+  for (int i = 0; i < sim.size(); i++) CHECK_EQ(sim.fw(i).leaseArbiter(), arbiter);
+
+  std::vector<LeaseClient> clients(sim.size());
+  int most = runClients(sim, clients, 60000000);
+  CHECK_EQ(most, 1);
+  int fewest = INT32_MAX;
+  for (const LeaseClient& c : clients) fewest = std::min(fewest, c.grants);
+  CHECK(fewest >= 2);
+}
+
+// A bot streaming indefinitely is asked to step aside as soon as a say
+// queues. Neither is the arbiter, so the REVOKE and the handover go over the
+// radio.
+TEST(speech_preempts_stream) {
+  MeshSim sim(4, 9);
+  for (int i = 0; i < sim.size(); i++) sim.node(i).mac[5] = 0x11;
+  sim.fullyConnect(0, sim.size());
+  sim.bootAll(200000, kWledIP);
+  sim.run(3000000);
+
+  std::vector<int> others;
+  for (int i = 0; i < sim.size(); i++) {
+    if (sim.fw(i).nodeId() != lowestNodeId(sim)) others.push_back(i);
+  }
+  int streamer = others[0], speaker = others[1];
+
+  std::vector<LeaseClient> clients(sim.size());
+  for (LeaseClient& c : clients) c.nextStartUs = INT64_MAX;
+  clients[streamer].useUs = INT64_MAX;
+  clients[streamer].nextStartUs = 0;
+  runClients(sim, clients, 5000000);
+  CHECK(clients[streamer].holding);
+
+  clients[speaker].prio = kPrioSpeech;
+  clients[speaker].useUs = 1000000;
+  clients[speaker].nextStartUs = sim.now();
+  int64_t asked = sim.now();
+  int most = runClients(sim, clients, 2000000);
+  CHECK_EQ(most, 1);
+  const LeaseClient& c = clients[speaker];
+  CHECK(c.firstGrantUs >= 0 && c.firstGrantUs - asked < 1000000);
+  REPORT("speech granted %.0f ms after asking", (c.firstGrantUs - asked) / 1e3);
+}
+
+HOST_TEST_MAIN
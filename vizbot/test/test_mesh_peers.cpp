@@ -0,0 +1,211 @@
+// Mesh peer table (esp_now_mesh.h): the MAC hash and the per-WLED-IP index
+// against a brute-force model, with a full table, eviction and rejoining —
+// synthetic frames from up to 70 MACs injected into one bot.
+
+#include "host_test.h"
+#include "mesh_sim.h"
+#include <time.h>
+
+// The wire format, for building frames (mesh_sim.cpp has its own copy)
+namespace wire {
+#include "mesh_protocol.h"
+}
+
+static const uint32_t kIpA = 0x0A000001;   // The bot's own WLED
+static const uint32_t kIpB = 0x0A000002;
+
+struct FakePeer {
+  uint8_t mac[6];
+  uint32_t id;
+  uint16_t seq = 0;
+  bool inTable = false;   // Where the model says it should be
+  wire::MeshState st = {};
+};
+
+static std::vector<FakePeer> makePeers(int n) {
+  std::vector<FakePeer> v(n);
+  for (int i = 0; i < n; i++) {
+    const uint8_t mac[6] = {0x30, 0xAE, 0xA4, (uint8_t)(i * 37), (uint8_t)(i >> 8), (uint8_t)i};
+    memcpy(v[i].mac, mac, 6);
+    v[i].id = wire::meshNodeId(mac);
+  }
+  return v;
+}
+
+static uint32_t randomIP(std::mt19937& rng) {
+  int r = rng() % 5;
+  return r < 3 ? kIpA : r == 3 ? kIpB : 0;
+}
+
+// One random STATE, DELTA or EVENT frame from p, applied to the model too
+static void sendRandom(MeshSim& sim, FakePeer& p, int& modelCount, uint8_t capacity,
+                       std::mt19937& rng) {
+  if (!p.inTable) p.st = {};   // A new entry starts blank
+  uint8_t payload[2 + sizeof(wire::MeshState)];
+  uint8_t len = 0, type = 0;
+  wire::MeshState next = p.st;
+  int kind = rng() % 10;
+  if (kind < 4) {
+    type = wire::MESH_MSG_STATE;
+    for (size_t i = 0; i < sizeof(next); i++) ((uint8_t*)&next)[i] = (uint8_t)rng();
+    next.flags = rng() % 4;
+    next.wledIP = randomIP(rng);
+    memcpy(payload, &next, sizeof(next));
+    len = sizeof(next);
+  } else if (kind < 7) {
+    type = wire::MESH_MSG_EVENT;
+    wire::MeshEvent ev = {(uint8_t)(wire::MESH_EVT_EXPRESSION + rng() % 5), 0, 0};
+    ev.arg = ev.event == wire::MESH_EVT_EXPRESSION ? rng() % 20 : randomIP(rng);
+    wire::meshApplyEvent(next, ev);
+    memcpy(payload, &ev, sizeof(ev));
+    len = sizeof(ev);
+  } else {
+    type = wire::MESH_MSG_DELTA;
+    next.flags = rng() % 4;
+    if (rng() % 2) next.wledIP = randomIP(rng);
+    next.effect = (p.st.effect + 1 + rng() % 7) % 8;   // Never an empty delta
+    len = wire::meshEncodeDelta(p.st, next, 0x3FFF, payload);
+  }
+
+  uint8_t frame[MESH_MAX_FRAME];
+  uint8_t n = wire::meshEncodeFrame(frame, type, p.mac[5], ++p.seq, payload, len);
+  sim.inject(0, p.mac, frame, n);
+
+  if (!p.inTable && modelCount < capacity) {
+    p.inTable = true;
+    modelCount++;
+  }
+  if (p.inTable) p.st = next;
+}
+
+// The index must give what a scan of the model gives
+static void checkQueries(MeshSim& sim, const std::vector<FakePeer>& peers, uint32_t ip) {
+  uint8_t count = 0;
+  bool wled = false, sched = false;
+  uint32_t lowest = 0;
+  for (const FakePeer& p : peers) {
+    if (!p.inTable || p.st.wledIP != ip) continue;
+    count++;
+    wled |= (p.st.flags & MESH_STATE_WLED_ACTIVE) != 0;
+    sched |= (p.st.flags & MESH_STATE_SCHED_OWNER) != 0;
+    if (lowest == 0 || p.id < lowest) lowest = p.id;
+  }
+  sim.as(0, [&] {
+    CHECK_EQ(sim.fw(0).peersForIP(ip), count);
+    CHECK_EQ(sim.fw(0).wledActiveForIP(ip), wled);
+    CHECK_EQ(sim.fw(0).schedOwnerForIP(ip), sched);
+    CHECK_EQ(sim.fw(0).lowestIdForIP(ip), lowest);
+  });
+}
+
+static void checkMembership(MeshSim& sim, const std::vector<FakePeer>& peers, int modelCount) {
+  CHECK_EQ(sim.fw(0).peerCount(), modelCount);
+  for (const FakePeer& p : peers) {
+    sim.as(0, [&] { CHECK_EQ(sim.fw(0).peerPresent(p.id), p.inTable); });
+    CHECK_EQ(sim.fw(0).peerHops(p.id) >= 0, p.inTable);
+  }
+}
+
+// 70 MACs talk to a bot with a 64-peer table: the first 64 get in, the rest
+// are refused, and every query matches the model after every few frames.
+// Half then go quiet; once they're evicted the refused ones get in, and the
+// queries still match (incrementally on our WLED, by recount on another).
+TEST(full_table_evict_and_rejoin) {
+  MeshSim sim(1, 3);
+  sim.boot(0, kIpA);
+  const uint8_t capacity = sim.fw(0).peerCapacity();
+  CHECK_EQ(capacity, 64);
+
+  std::mt19937 rng(4);
+  std::vector<FakePeer> peers = makePeers(70);
+  int modelCount = 0;
+  for (int f = 0; f < 20000; f++) {
+    sendRandom(sim, peers[rng() % peers.size()], modelCount, capacity, rng);
+    sim.run(1000);
+    if (f % 50 == 0) checkQueries(sim, peers, kIpA);
+  }
+  CHECK_EQ(modelCount, capacity);
+  checkMembership(sim, peers, modelCount);
+
+  // Every other admitted peer goes quiet; the refused ones wait too. Half
+  // the senders, half the frame rate, so no one hits the receive cap.
+  std::vector<int> talking;
+  for (int i = 0; i < (int)peers.size(); i++) {
+    if (peers[i].inTable && i % 2 == 0) talking.push_back(i);
+  }
+  for (int f = 0; f < 10000; f++) {
+    sendRandom(sim, peers[talking[rng() % talking.size()]], modelCount, capacity, rng);
+    sim.run(2000);
+    if (f < 7000 && f % 25 == 0) checkQueries(sim, peers, kIpA);   // Before any eviction
+  }
+  for (FakePeer& p : peers) {
+    bool stays = false;
+    for (int i : talking) stays |= (&peers[i] == &p);
+    if (p.inTable && !stays) {
+      p.inTable = false;
+      modelCount--;
+    }
+  }
+  checkMembership(sim, peers, modelCount);
+  checkQueries(sim, peers, kIpA);
+
+  // Everyone back: the table refills to capacity
+  for (int f = 0; f < 20000; f++) {
+    sendRandom(sim, peers[rng() % peers.size()], modelCount, capacity, rng);
+    sim.run(1000);
+    if (f % 50 == 0) checkQueries(sim, peers, kIpA);
+  }
+  CHECK_EQ(modelCount, capacity);
+  checkMembership(sim, peers, modelCount);
+  checkQueries(sim, peers, kIpB);
+  checkQueries(sim, peers, kIpA);
+}
+
+// Receive and query cost with all 64 peers in the table (figures only;
+// spinlocks are no-ops on the host)
+TEST(receive_and_query_cost) {
+  MeshSim sim(1, 5);
+  sim.boot(0, kIpA);
+  std::mt19937 rng(6);
+  std::vector<FakePeer> peers = makePeers(64);
+  int modelCount = 0;
+  for (FakePeer& p : peers) sendRandom(sim, p, modelCount, 64, rng);
+  CHECK_EQ(sim.fw(0).peerCount(), 64);
+
+  std::vector<std::vector<uint8_t>> frames;
+  std::vector<int> from;
+  for (int f = 0; f < 64 * 100; f++) {
+    FakePeer& p = peers[f % 64];
+    wire::MeshEvent ev = {wire::MESH_EVT_WLED_CLAIM, 0, (rng() % 2) ? kIpA : kIpB};
+    uint8_t frame[MESH_MAX_FRAME];
+    uint8_t n = wire::meshEncodeFrame(frame, wire::MESH_MSG_EVENT, p.mac[5], ++p.seq, &ev, sizeof(ev));
+    frames.emplace_back(frame, frame + n);
+    from.push_back(f % 64);
+  }
+
+  struct timespec t0, t1;
+  double rxNs = 0;
+  for (size_t f = 0; f < frames.size(); f += 64) {
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (size_t k = f; k < f + 64; k++) {
+      sim.inject(0, peers[from[k]].mac, frames[k].data(), (int)frames[k].size());
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    rxNs += (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+    sim.run(25000);   // 40 frames/s per peer, under the receive cap
+  }
+
+  int hits = 0;
+  const int queries = 1000000;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  sim.as(0, [&] {
+    for (int q = 0; q < queries; q++) hits += sim.fw(0).wledActiveForIP(kIpA);
+  });
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  double queryNs = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / queries;
+  CHECK_EQ(hits, queries);
+  REPORT("64 peers: %.0f ns per received frame, %.1f ns per WLED query", rxNs / frames.size(),
+         queryNs);
+}
+
+HOST_TEST_MAIN
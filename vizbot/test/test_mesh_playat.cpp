@@ -0,0 +1,143 @@
+// Play at mesh time (esp_now_mesh.h) in one radio cell: clock error against
+// the master, start spread, and the stamps a receiver must refuse — on the
+// fake radio.
+
+#include "host_test.h"
+#include "mesh_sim.h"
+
+static const uint8_t kPlayExpression = 0;   // MESH_PLAY_EXPRESSION
+
+static bool allSynced(MeshSim& sim, int n) {
+  for (int i = 0; i < n; i++) {
+    if (!sim.fw(i).clockSynced() || sim.fw(i).clockMaster() != sim.fw(0).clockMaster()) return false;
+  }
+  return true;
+}
+
+static int masterIndex(MeshSim& sim, int n) {
+  for (int i = 0; i < n; i++) {
+    if (sim.fw(i).nodeId() == sim.fw(i).clockMaster()) return i;
+  }
+  return -1;
+}
+
+static void clearFired(MeshSim& sim) {
+  for (int i = 0; i < sim.size(); i++) sim.node(i).fired.clear();
+}
+
+static bool firedArg(MeshSim& sim, int i, uint16_t arg) {
+  for (const MeshSimFired& f : sim.node(i).fired) {
+    if (f.arg == arg) return true;
+  }
+  return false;
+}
+
+// Five bots at +/-40 ppm, 400 us jitter: every clock stays within half a
+// millisecond of the master, and a play-at starts on all five together
+TEST(one_cell_error_and_spread) {
+  const int n = 5;
+  MeshSim sim(n, 3);
+  sim.fullyConnect(0, n);
+  sim.bootAll(2000000);
+  sim.runUntil([&] { return allSynced(sim, n); }, 20000000);
+  CHECK(allSynced(sim, n));
+  sim.run(20000000);
+
+  int master = masterIndex(sim, n);
+  CHECK(master >= 0);
+  if (master < 0) return;
+  int64_t worst = 0;
+  for (int t = 0; t < 200; t++) {
+    sim.run(100000);
+    for (int i = 0; i < n; i++) {
+      int64_t err = sim.fw(i).meshTimeAt(sim.localUs(i)) - sim.fw(master).meshTimeAt(sim.localUs(master));
+      worst = std::max<int64_t>(worst, std::llabs(err));
+    }
+  }
+  CHECK(worst < 500);
+
+  int origin = (master + 1) % n;
+  clearFired(sim);
+  bool sent = false;
+  sim.as(origin, [&] { sent = sim.fw(origin).playAt(kPlayExpression, 4, nullptr, 100); });
+  CHECK(sent);
+  sim.run(500000);
+  int64_t first = INT64_MAX, last = INT64_MIN;
+  for (int i = 0; i < n; i++) {
+    CHECK_EQ(sim.node(i).fired.size(), 1u);
+    if (sim.node(i).fired.empty()) continue;
+    first = std::min(first, sim.node(i).fired[0].atUs);
+    last = std::max(last, sim.node(i).fired[0].atUs);
+  }
+  CHECK(last - first < 2000);
+  REPORT("worst error vs master %lld us over 20 s, start spread %lld us", (long long)worst,
+         (long long)(last - first));
+}
+
+// A bot that booted a moment ago has no clock yet: it refuses the stamp
+// instead of reading it against its own timebase, and the synced bots
+// still play
+TEST(unsynced_receiver_rejects) {
+  MeshSim sim(3, 5);
+  sim.fullyConnect(0, 3);
+  sim.boot(0);
+  sim.run(50000);
+  sim.boot(1);
+  sim.runUntil([&] { return allSynced(sim, 2); }, 20000000);
+  CHECK(allSynced(sim, 2));
+  sim.boot(2);
+  sim.run(50000);
+  CHECK(!sim.fw(2).clockSynced());
+
+  clearFired(sim);
+  bool sent = false;
+  sim.as(0, [&] { sent = sim.fw(0).playAt(kPlayExpression, 6, nullptr, 200); });
+  CHECK(sent);
+  sim.run(600000);
+  CHECK(firedArg(sim, 0, 6));
+  CHECK(firedArg(sim, 1, 6));
+  CHECK(!firedArg(sim, 2, 6));
+  CHECK_EQ(sim.fw(2).playRejected(), 1u);
+
+  // Once it syncs it plays along
+  sim.runUntil([&] { return allSynced(sim, 3); }, 20000000);
+  clearFired(sim);
+  sim.as(1, [&] { sim.fw(1).playAt(kPlayExpression, 8, nullptr, 200); });
+  sim.run(600000);
+  for (int i = 0; i < 3; i++) CHECK(firedArg(sim, i, 8));
+}
+
+// A stamp past MESH_PLAY_MAX_AHEAD_MS is refused by every receiver; stamps
+// inside it fill the pending slots, yet a near action sent after them
+// still fires on time everywhere — the drain never stalls behind them
+TEST(far_stamps_never_starve) {
+  const int n = 4;
+  MeshSim sim(n, 9);
+  sim.fullyConnect(0, n);
+  sim.bootAll(1000000);
+  sim.runUntil([&] { return allSynced(sim, n); }, 20000000);
+  CHECK(allSynced(sim, n));
+  sim.run(5000000);
+
+  clearFired(sim);
+  sim.as(0, [&] { sim.fw(0).playAt(kPlayExpression, 1, nullptr, 60000); });
+  sim.run(200000);
+  for (int i = 1; i < n; i++) CHECK_EQ(sim.fw(i).playRejected(), 1u);
+
+  // Five long leads, one more than the pending slots, then a short one
+  for (uint16_t k = 0; k < 5; k++) {
+    sim.as(0, [&] { sim.fw(0).playAt(kPlayExpression, 10 + k, nullptr, 11000); });
+    sim.run(30000);
+  }
+  int64_t sentUs = sim.now();
+  sim.as(0, [&] { sim.fw(0).playAt(kPlayExpression, 20, nullptr, 300); });
+  sim.run(1000000);
+  for (int i = 1; i < n; i++) {
+    CHECK(firedArg(sim, i, 20));
+    for (const MeshSimFired& f : sim.node(i).fired) {
+      if (f.arg == 20) CHECK(std::llabs(f.atUs - sentUs - 300000) < 2000);
+    }
+  }
+}
+
+HOST_TEST_MAIN
@@ -0,0 +1,174 @@
+// Mesh protocol (mesh_protocol.h): the frame decoder against random bytes,
+// delta encode/apply round trips, events and the type registry.
+
+#include "host_test.h"
+#include "mesh_protocol.h"
+#include <random>
+
+static int handled;
+static void countingHandler(const uint8_t*, const MeshHeader&, const uint8_t* payload, uint8_t len,
+                            int64_t) {
+  volatile uint8_t sum = 0;
+  for (uint8_t i = 0; i < len; i++) sum += payload[i];   // Touch every byte (make asan)
+  handled++;
+}
+
+static void registerStateTypes() {
+  meshRegisterMsg(MESH_MSG_STATE, sizeof(MeshState), sizeof(MeshState), countingHandler);
+  meshRegisterMsg(MESH_MSG_DELTA, 3, 2 + sizeof(MeshState), countingHandler);
+  meshRegisterMsg(MESH_MSG_EVENT, sizeof(MeshEvent), sizeof(MeshEvent), countingHandler);
+}
+
+static MeshState randomState(std::mt19937& rng) {
+  MeshState s;
+  for (size_t i = 0; i < sizeof(s); i++) ((uint8_t*)&s)[i] = (uint8_t)rng();
+  return s;
+}
+
+// Random frames, half of them with a valid version and type so they get
+// past the first checks: the decoder only says OK for a registered type
+// within its length bounds, its payload lies inside the frame, and applying
+// whatever decodes never reads past it (run under make asan)
+TEST(decoder_fuzz) {
+  registerStateTypes();
+  std::mt19937 rng(1);
+  int ok = 0, applied = 0;
+  for (int it = 0; it < 500000; it++) {
+    int len = rng() % 40;
+    std::vector<uint8_t> buf(len);
+    for (uint8_t& b : buf) b = (uint8_t)rng();
+    if (len > 0 && rng() % 2) buf[0] = MESH_PROTOCOL_VERSION;
+    if (len > 1 && rng() % 2) buf[1] = 1 + rng() % 3;
+
+    MeshHeader hdr;
+    const uint8_t* payload = nullptr;
+    uint8_t plen = 0;
+    if (meshDecode(buf.data(), len, hdr, payload, plen) != MESH_DECODE_OK) continue;
+    ok++;
+    CHECK(hdr.version == MESH_PROTOCOL_VERSION);
+    CHECK(hdr.type >= MESH_MSG_STATE && hdr.type <= MESH_MSG_EVENT);
+    CHECK(payload == buf.data() + sizeof(MeshHeader));
+    CHECK_EQ(plen + sizeof(MeshHeader), (size_t)len);
+    CHECK(plen >= meshMsgTypes[hdr.type].minLen && plen <= meshMsgTypes[hdr.type].maxLen);
+    MeshState s = {};
+    if (hdr.type == MESH_MSG_DELTA) applied += meshApplyDelta(s, payload, plen);
+    if (hdr.type == MESH_MSG_EVENT) {
+      MeshEvent ev;
+      memcpy(&ev, payload, sizeof(ev));
+      meshApplyEvent(s, ev);
+    }
+    countingHandler(nullptr, hdr, payload, plen, 0);
+  }
+  CHECK(ok > 0 && applied > 0);
+  REPORT("%d of 500000 random frames decoded, %d deltas applied", ok, applied);
+}
+
+TEST(decode_results) {
+  registerStateTypes();
+  uint8_t frame[64];
+  MeshState s = {};
+  MeshHeader hdr;
+  const uint8_t* payload;
+  uint8_t plen;
+
+  uint8_t n = meshEncodeFrame(frame, MESH_MSG_STATE, 7, 0x1234, &s, sizeof(s));
+  CHECK_EQ(meshDecode(frame, n, hdr, payload, plen), MESH_DECODE_OK);
+  CHECK_EQ(hdr.deviceId, 7);
+  CHECK_EQ(hdr.seq, 0x1234);
+  CHECK_EQ(plen, sizeof(MeshState));
+
+  CHECK_EQ(meshDecode(frame, sizeof(MeshHeader) - 1, hdr, payload, plen), MESH_DECODE_SHORT);
+  CHECK_EQ(meshDecode(nullptr, n, hdr, payload, plen), MESH_DECODE_SHORT);
+  CHECK_EQ(meshDecode(frame, n - 1, hdr, payload, plen), MESH_DECODE_LENGTH);
+  frame[1] = MESH_MSG_SYNC_REQ;   // Not registered here
+  CHECK_EQ(meshDecode(frame, n, hdr, payload, plen), MESH_DECODE_TYPE);
+  frame[1] = MESH_MAX_MSG_TYPES;
+  CHECK_EQ(meshDecode(frame, n, hdr, payload, plen), MESH_DECODE_TYPE);
+  frame[0] = 1;                   // A v1 24-byte packet starts with anything but 2
+  CHECK_EQ(meshDecode(frame, n, hdr, payload, plen), MESH_DECODE_VERSION);
+}
+
+// Registration refuses type 0, out-of-range types, a missing handler, and
+// bounds that don't fit a frame
+TEST(registry_bounds) {
+  CHECK(!meshRegisterMsg(0, 1, 1, countingHandler));
+  CHECK(!meshRegisterMsg(MESH_MAX_MSG_TYPES, 1, 1, countingHandler));
+  CHECK(!meshRegisterMsg(MESH_MSG_STATE, 1, 1, nullptr));
+  CHECK(!meshRegisterMsg(MESH_MSG_STATE, 5, 4, countingHandler));
+  CHECK(!meshRegisterMsg(MESH_MSG_STATE, 1, MESH_MAX_FRAME - sizeof(MeshHeader) + 1, countingHandler));
+  CHECK(meshRegisterMsg(MESH_MSG_STATE, 1, MESH_MAX_FRAME - sizeof(MeshHeader), countingHandler));
+}
+
+// Any two states: the delta carries exactly the changed fields, and applying
+// it to the base gives the new state
+TEST(delta_round_trip) {
+  std::mt19937 rng(2);
+  for (int it = 0; it < 100000; it++) {
+    MeshState a = randomState(rng), b = a;
+    for (size_t i = 0; i < sizeof(b); i++) {
+      if (rng() % 3 == 0) ((uint8_t*)&b)[i] = (uint8_t)rng();
+    }
+    uint8_t out[2 + sizeof(MeshState)];
+    uint8_t n = meshEncodeDelta(a, b, 0x3FFF, out);
+    MeshState c = a;
+    if (n == 0) {
+      CHECK(memcmp(&a, &b, sizeof(a)) == 0);
+      continue;
+    }
+    CHECK(n <= sizeof(out));
+    CHECK(meshApplyDelta(c, out, n));
+    CHECK(memcmp(&c, &b, sizeof(c)) == 0);
+  }
+}
+
+// The field mask limits what's sent; other changes wait for the keyframe
+TEST(delta_field_mask) {
+  MeshState a = {}, b = {};
+  b.expression = 3;
+  b.pitch = 120;
+  b.effect = 9;
+  uint8_t out[2 + sizeof(MeshState)];
+  uint8_t n = meshEncodeDelta(a, b, MESH_DELTA_FIELDS, out);
+  CHECK_EQ(n, 3);                          // Mask + effect only
+  CHECK_EQ(out[0] | (out[1] << 8), 1 << 4);
+  CHECK_EQ(meshEncodeDelta(a, a, 0x3FFF, out), 0);
+}
+
+// A bad mask or a length that doesn't match it leaves the state untouched
+TEST(delta_rejects_malformed) {
+  std::mt19937 rng(3);
+  MeshState a = randomState(rng), b = randomState(rng);
+  uint8_t out[2 + sizeof(MeshState) + 1];
+  uint8_t n = meshEncodeDelta(a, b, 0x3FFF, out);
+  CHECK(n > 2);
+
+  MeshState c = a;
+  CHECK(!meshApplyDelta(c, out, n - 1));
+  CHECK(!meshApplyDelta(c, out, n + 1));
+  CHECK(!meshApplyDelta(c, out, 1));
+  uint8_t zero[2] = {0, 0};
+  CHECK(!meshApplyDelta(c, zero, 2));
+  uint8_t unknown[3] = {0, 0x40, 0};       // Bit 14: past the last field
+  CHECK(!meshApplyDelta(c, unknown, 3));
+  CHECK(memcmp(&c, &a, sizeof(c)) == 0);
+}
+
+TEST(events_apply) {
+  MeshState s = {};
+  CHECK(meshApplyEvent(s, {MESH_EVT_EXPRESSION, 0, 12}));
+  CHECK_EQ(s.expression, 12);
+  CHECK(meshApplyEvent(s, {MESH_EVT_WLED_CLAIM, 0, 0x0A000005}));
+  CHECK(meshApplyEvent(s, {MESH_EVT_SCHED_CLAIM, 0, 0x0A000005}));
+  CHECK_EQ(s.flags, MESH_STATE_WLED_ACTIVE | MESH_STATE_SCHED_OWNER);
+  CHECK_EQ(s.wledIP, 0x0A000005u);
+  CHECK(meshApplyEvent(s, {MESH_EVT_WLED_RELEASE, 0, 0}));
+  CHECK_EQ(s.flags, MESH_STATE_SCHED_OWNER);
+  CHECK(meshApplyEvent(s, {MESH_EVT_SCHED_RELEASE, 0, 0}));
+  CHECK_EQ(s.flags, 0);
+  MeshState before = s;
+  CHECK(!meshApplyEvent(s, {0, 0, 1}));
+  CHECK(!meshApplyEvent(s, {99, 0, 1}));
+  CHECK(memcmp(&s, &before, sizeof(s)) == 0);
+}
+
+HOST_TEST_MAIN
@@ -0,0 +1,112 @@
+// Relay layer (esp_now_mesh.h): peer discovery across radio cells, hop
+// counts, duplicate and own-frame suppression — on the fake radio.
+
+#include "host_test.h"
+#include "mesh_sim.h"
+
+static const int kRelayTtl = 8;   // MESH_RELAY_TTL in esp_now_mesh.h
+
+// Every node knows every other node, and its hop count is the shortest path
+static void checkTables(MeshSim& sim, int& exact) {
+  exact = 0;
+  for (int i = 0; i < sim.size(); i++) {
+    CHECK_EQ(sim.fw(i).peerCount(), sim.size() - 1);
+    CHECK_EQ(sim.fw(i).peerHops(sim.fw(i).nodeId()), -1);   // Never ourselves
+    for (int j = 0; j < sim.size(); j++) {
+      if (j == i) continue;
+      int hops = sim.fw(i).peerHops(sim.fw(j).nodeId());
+      int relays = sim.hops(i, j) - 1;
+      CHECK(hops >= relays);
+      if (hops == relays) exact++;
+    }
+  }
+}
+
+static void reportAirtime(MeshSim& sim) {
+  uint64_t air = 0, relayAir = 0;
+  uint32_t fwd = 0, supp = 0, drop = 0, dup = 0;
+  for (int i = 0; i < sim.size(); i++) {
+    air += sim.node(i).txAirUs;
+    relayAir += sim.node(i).txRelayAirUs;
+    uint32_t f, s, d, u;
+    sim.fw(i).relayStats(f, s, d, u);
+    fwd += f;
+    supp += s;
+    drop += d;
+    dup += u;
+  }
+  REPORT("relay airtime %.2fx of originals, forwarded %u, suppressed %u, dropped %u, duplicates %u",
+         (double)relayAir / (double)(air - relayAir), fwd, supp, drop, dup);
+}
+
+// 30 bots on a 6x5 grid where every bot hears its 8 neighbours. The last MAC
+// byte (the header's deviceId) repeats every 8 bots, so neither duplicate
+// suppression nor own-frame detection may key on it.
+TEST(grid_with_colliding_device_ids) {
+  MeshSim sim(30, 7);
+  for (int i = 0; i < sim.size(); i++) sim.node(i).mac[5] = 0x40 + i % 8;
+  sim.grid(6, true);
+  sim.bootAll(70000);
+  int64_t start = sim.now();
+  sim.runUntil([&] {
+    for (int i = 0; i < sim.size(); i++) {
+      if (sim.fw(i).peerCount() < sim.size() - 1) return false;
+    }
+    return true;
+  }, 20000000);
+  REPORT("all peer tables complete after %.1f s", (sim.now() - start) / 1e6);
+  sim.run(5000000);
+  int exact;
+  checkTables(sim, exact);
+  REPORT("hop counts exact for %d of %d pairs", exact, 30 * 29);
+  reportAirtime(sim);
+}
+
+// Cells of five where one bot per cell hears the next cell. The bridge bot
+// hears the frame from its cell-mates too; it must still forward, or the
+// next cell only hears frames whenever the bridge wins the jitter race and
+// its peers flap in and out of the table.
+TEST(cells_bridged_by_one_bot) {
+  MeshSim sim(20, 5);
+  for (int c = 0; c < 4; c++) sim.fullyConnect(c * 5, c * 5 + 5);
+  for (int c = 0; c < 3; c++) sim.link(c * 5 + 4, c * 5 + 5);
+  sim.bootAll(1000000);
+  sim.run(10000000);
+  int incomplete = 0;
+  for (int t = 0; t < 60; t++) {
+    sim.run(500000);
+    for (int i = 0; i < sim.size(); i++) {
+      if (sim.fw(i).peerCount() < sim.size() - 1) incomplete++;
+    }
+  }
+  CHECK_EQ(incomplete, 0);
+  int exact;
+  checkTables(sim, exact);
+  CHECK_EQ(exact, sim.size() * (sim.size() - 1));
+  reportAirtime(sim);
+}
+
+// A line is the worst case: one path, every hop must forward. TTL forwards
+// reach TTL + 1 links out.
+TEST(line_reaches_ttl) {
+  MeshSim sim(kRelayTtl + 2, 3);
+  sim.line();
+  sim.bootAll(200000);
+  sim.run(15000000);
+  int exact;
+  checkTables(sim, exact);
+  CHECK_EQ(exact, sim.size() * (sim.size() - 1));
+  reportAirtime(sim);
+}
+
+// One link past the TTL the far ends never hear each other
+TEST(line_beyond_ttl) {
+  MeshSim sim(kRelayTtl + 3, 3);
+  sim.line();
+  sim.bootAll(200000);
+  sim.run(15000000);
+  CHECK_EQ(sim.fw(0).peerHops(sim.fw(sim.size() - 1).nodeId()), -1);
+  CHECK_EQ(sim.fw(0).peerCount(), sim.size() - 2);
+}
+
+HOST_TEST_MAIN
@@ -0,0 +1,299 @@
+// MIDI scheduler (midi_scheduler.h): the real midi_sched and midi_tx task
+// bodies on a host clock whose esp_timer fires a little late, with every
+// byte the UART is handed stamped with its time.
+
+#include "host_test.h"
+#include "host_clock.h"
+#include "config.h"
+#include "bot_sounds.h"
+#include "midi_scheduler.h"
+#include <map>
+
+// content_cache.h's refcount, as seen by the backends
+static std::map<const MidiSequenceDef*, int> seqRefs;
+void cloudSequenceRetain(const MidiSequenceDef* def) { seqRefs[def]++; }
+void cloudSequenceRelease(const MidiSequenceDef* def) { seqRefs[def]--; }
+
+// ---- One esp_timer, task notifications, and the wire ----
+
+struct HostTimer {
+  void (*cb)(void*);
+  void* arg;
+  int64_t dueUs;
+};
+static HostTimer schedTimer = {nullptr, nullptr, -1};
+static uint32_t timerLatencyUs = 0;   // Fires up to this late
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out) {
+  schedTimer = {args->callback, args->arg, -1};
+  *out = &schedTimer;
+  return ESP_OK;
+}
+esp_err_t esp_timer_start_once(esp_timer_handle_t t, uint64_t timeoutUs) {
+  t->dueUs = hostNowUs() + (int64_t)timeoutUs;
+  return ESP_OK;
+}
+esp_err_t esp_timer_stop(esp_timer_handle_t t) {
+  t->dueUs = -1;
+  return ESP_OK;
+}
+
+// A task function runs until it would block on an empty notification
+struct TaskBlocked {};
+static TaskHandle_t currentTask = nullptr;
+static std::map<TaskHandle_t, uint32_t> notifications;
+
+TaskHandle_t xTaskGetCurrentTaskHandle() { return currentTask; }
+void xTaskNotifyGive(TaskHandle_t task) { notifications[task]++; }
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t) {
+  uint32_t n = notifications[currentTask];
+  if (n == 0) throw TaskBlocked();
+  notifications[currentTask] = clearOnExit ? 0 : n - 1;
+  return n;
+}
+
+static void runTask(void (*fn)(void*), TaskHandle_t handle) {
+  currentTask = handle;
+  try {
+    fn(&midiScheduler);
+  } catch (const TaskBlocked&) {
+  }
+  currentTask = nullptr;
+}
+
+struct WireMsg {
+  int64_t us;
+  std::vector<uint8_t> bytes;
+};
+static std::vector<WireMsg> wire;
+static size_t wireParsed = 0;
+
+static size_t msgLen(const uint8_t* p, size_t avail) {
+  uint8_t hi = p[0] & 0xF0;
+  if (p[0] == 0xF0) {
+    for (size_t i = 1; i < avail; i++) {
+      if (p[i] == 0xF7) return i + 1;
+    }
+    return 0;
+  }
+  if (p[0] == 0xFF) return 1;
+  size_t n = (hi == 0xC0 || hi == 0xD0) ? 2 : 3;
+  return n <= avail ? n : 0;
+}
+
+// Split new UART bytes into messages stamped with the current time
+static void collectWire() {
+  const std::vector<uint8_t>& out = Serial2.out;
+  while (wireParsed < out.size()) {
+    size_t n = msgLen(&out[wireParsed], out.size() - wireParsed);
+    if (n == 0) break;
+    wire.push_back({hostNowUs(), std::vector<uint8_t>(&out[wireParsed], &out[wireParsed] + n)});
+    wireParsed += n;
+  }
+}
+
+// Run both tasks until neither has a notification pending
+static void settle() {
+  while (notifications[midiScheduler.schedTask] || notifications[midiScheduler.txTask]) {
+    if (notifications[midiScheduler.schedTask]) runTask(midiSchedTask, midiScheduler.schedTask);
+    if (notifications[midiScheduler.txTask]) runTask(midiTxTask, midiScheduler.txTask);
+    collectWire();
+  }
+}
+
+static void runForUs(int64_t us) {
+  int64_t end = hostNowUs() + us;
+  settle();
+  while (schedTimer.dueUs >= 0 && schedTimer.dueUs <= end) {
+    int64_t late = timerLatencyUs ? (int64_t)(hostRng()() % timerLatencyUs) : 0;
+    hostNowUs() = std::max(hostNowUs(), schedTimer.dueUs + late);
+    schedTimer.dueUs = -1;
+    schedTimer.cb(schedTimer.arg);
+    settle();
+  }
+  hostNowUs() = std::max(hostNowUs(), end);
+}
+
+static void boot() {
+  midiSchedStart();
+  Serial2.begin(MIDI_BAUD);
+}
+
+static std::vector<WireMsg> messages(uint8_t statusHi) {
+  std::vector<WireMsg> r;
+  for (const WireMsg& m : wire) {
+    if ((m.bytes[0] & 0xF0) == statusHi) r.push_back(m);
+  }
+  return r;
+}
+
+static MidiSequenceDef makeSeq(const MidiEvent* events, uint16_t count) {
+  return MidiSequenceDef{"test", count, GM_PIANO, 0, events};
+}
+
+// Note-ons and note-offs go out at their due microsecond: early by at most
+// the batching slack, late by at most the timer's dispatch latency
+TEST(notes_fire_on_time) {
+  boot();
+  timerLatencyUs = 150;
+  std::vector<MidiEvent> ev;
+  for (int i = 0; i < 24; i++) {
+    ev.push_back({(uint8_t)(60 + i % 12), 100, (uint8_t)(i % 3 == 0 ? MIDI_CH_PERCUSSION : 0), 255,
+                  (uint16_t)(30 + i * 7), (uint16_t)(i * 37)});
+  }
+  MidiSequenceDef def = makeSeq(ev.data(), (uint16_t)ev.size());
+  runForUs(1000);
+  int64_t t0 = hostNowUs();
+  midiSchedPlaySequence(&def);
+  runForUs(3000000);
+
+  int64_t start = t0 + MIDI_PROGRAM_LEAD_MS * 1000;
+  std::vector<WireMsg> ons = messages(0x90), offs = messages(0x80);
+  CHECK_EQ(ons.size(), ev.size());
+  CHECK_EQ(offs.size(), ev.size());
+  int64_t worst = 0;
+  for (size_t i = 0; i < ons.size() && i < ev.size(); i++) {
+    int64_t due = start + ev[i].offsetMs * 1000;
+    CHECK_EQ(ons[i].bytes[1], ev[i].note);
+    CHECK(ons[i].us >= due - MIDI_SCHED_SLACK_US && ons[i].us <= due + (int64_t)timerLatencyUs);
+    worst = std::max(worst, std::abs(ons[i].us - due));
+  }
+  CHECK(midiScheduler.maxErrUs <= MIDI_SCHED_SLACK_US + timerLatencyUs);
+  CHECK(midiScheduler.avgErrUs() <= midiScheduler.maxErrUs);
+  CHECK_EQ(midiScheduler.eventsFired, ev.size() * 2 + 2);   // + bank select, program change
+  CHECK_EQ(midiScheduler.droppedMsgs, 0);
+  REPORT("worst note-on error %lld us, avg %u us", (long long)worst, midiScheduler.avgErrUs());
+}
+
+// At equal times the old note's note-off goes first, so a re-struck note
+// retriggers instead of being cut off
+TEST(restruck_note_retriggers) {
+  boot();
+  static const MidiEvent ev[] = {{60, 100, 0, 255, 100, 0}, {60, 100, 0, 255, 100, 100}};
+  MidiSequenceDef def = makeSeq(ev, 2);
+  midiSchedPlaySequence(&def);
+  runForUs(1000000);
+  std::vector<uint8_t> order;
+  for (const WireMsg& m : wire) {
+    if ((m.bytes[0] & 0xE0) == 0x80) order.push_back(m.bytes[0] & 0xF0);
+  }
+  CHECK(order == std::vector<uint8_t>({0x90, 0x80, 0x90, 0x80}));
+}
+
+// Stop silences every sounding note at once and lets go of the sequence.
+// Nothing else is due afterwards, so midi_tx must be woken by the flushed
+// note-offs themselves.
+TEST(stop_flushes_note_offs) {
+  boot();
+  static const MidiEvent ev[] = {{60, 100, 0, 255, 2000, 0}, {64, 100, 0, 255, 2000, 0},
+                                 {67, 100, 0, 255, 2000, 0}, {72, 100, 0, 255, 100, 1500}};
+  MidiSequenceDef def = makeSeq(ev, 4);
+  midiSchedPlaySequence(&def);
+  runForUs(500000);
+  CHECK_EQ(seqRefs[&def], 1);
+  int64_t stopAt = hostNowUs();
+  midiSchedStop();
+  runForUs(3000000);
+  std::vector<WireMsg> offs = messages(0x80);
+  CHECK_EQ(messages(0x90).size(), 3);
+  CHECK_EQ(offs.size(), 3);
+  for (const WireMsg& m : offs) CHECK_EQ(m.us, stopAt);
+  CHECK_EQ(seqRefs[&def], 0);
+  CHECK_EQ(midiScheduler.pendingCount, 0);
+}
+
+// All notes off is one queue slot however full the queue is, and sends
+// CC 123 on all 16 channels after the sounding notes' note-offs
+TEST(all_off_is_one_command) {
+  boot();
+  static const MidiEvent ev[] = {{60, 100, 0, 255, 5000, 0}, {40, 100, 1, 255, 5000, 0}};
+  MidiSequenceDef def = makeSeq(ev, 2);
+  midiSchedPlaySequence(&def);
+  runForUs(100000);
+
+  const uint8_t cc[] = {0xB0, 0x07, 100};
+  for (int i = 0; i < MIDI_SCHED_CMD_QUEUE - 1; i++) midiSchedSend(cc, 3, 0);
+  midiSynth.allNotesOffAll();
+  CHECK_EQ(midiScheduler.droppedMsgs, 0);
+  size_t before = wire.size();
+  runForUs(10000);
+
+  int allOff = 0, notesOff = 0;
+  bool offsFirst = true;
+  for (size_t i = before; i < wire.size(); i++) {
+    const std::vector<uint8_t>& b = wire[i].bytes;
+    if ((b[0] & 0xF0) == 0x80) {
+      notesOff++;
+      if (allOff) offsFirst = false;
+    }
+    if ((b[0] & 0xF0) == 0xB0 && b[1] == 0x7B) allOff++;
+  }
+  CHECK_EQ(allOff, MIDI_MAX_CHANNELS);
+  CHECK_EQ(notesOff, 2);
+  CHECK(offsFirst);
+}
+
+// The boot script's holdoff delays everything queued behind it: the SAM2695
+// sees nothing but the script until it has settled
+TEST(holdoff_gates_boot_script) {
+  midiSynth.init();
+  Serial2.out.clear();
+  int64_t booted = hostNowUs();
+  static const MidiEvent ev[] = {{64, 100, 0, 255, 50, 0}};
+  MidiSequenceDef def = makeSeq(ev, 1);
+  midiSchedPlaySequence(&def);
+  midiSynth.noteOn(0, 50, 90);
+  runForUs(3000000);
+
+  int64_t reset = -1, testOn = -1, seqOn = -1, rawOn = -1;
+  for (const WireMsg& m : wire) {
+    if (m.bytes[0] == 0xFF) reset = m.us;
+    if (m.bytes[0] == 0x90 && m.bytes[1] == 72) testOn = m.us;
+    if (m.bytes[0] == 0x90 && m.bytes[1] == 64) seqOn = m.us;
+    if (m.bytes[0] == 0x90 && m.bytes[1] == 50) rawOn = m.us;
+  }
+  CHECK_NEAR(reset - booted, 100000, 500);
+  CHECK_NEAR(testOn - booted, 440000, 500);
+  CHECK(rawOn - booted >= 1090000);
+  CHECK(seqOn - booted >= 1090000 + MIDI_PROGRAM_LEAD_MS * 1000);
+  CHECK(wire.front().bytes[0] == 0xFF);
+}
+
+// More sounding notes than pending slots: the earliest note-off goes out
+// early to make room, but none is lost
+TEST(pending_overflow_keeps_note_offs) {
+  boot();
+  std::vector<MidiEvent> ev;
+  for (int i = 0; i < 80; i++) ev.push_back({(uint8_t)(30 + i), 80, 0, 255, (uint16_t)(1000 + i), 0});
+  MidiSequenceDef def = makeSeq(ev.data(), (uint16_t)ev.size());
+  midiSchedPlaySequence(&def);
+  runForUs(5000000);
+  CHECK_EQ(messages(0x90).size(), 80);
+  CHECK_EQ(messages(0x80).size(), 80);
+  CHECK_EQ(midiScheduler.droppedMsgs, 0);
+  CHECK_EQ(midiScheduler.pendingCount, 0);
+}
+
+// One reference per queued or playing sequence: replaced and finished
+// sequences are released, and a post that doesn't fit gives its back
+TEST(sequence_reference) {
+  boot();
+  static const MidiEvent ev[] = {{60, 100, 0, 255, 100, 0}, {62, 100, 0, 255, 100, 300}};
+  MidiSequenceDef a = makeSeq(ev, 2), b = makeSeq(ev, 2);
+  midiSchedPlaySequence(&a);
+  runForUs(100000);
+  midiSchedPlaySequence(&b);
+  runForUs(1000);
+  CHECK_EQ(seqRefs[&a], 0);
+  CHECK_EQ(seqRefs[&b], 1);
+  runForUs(1000000);
+  CHECK_EQ(seqRefs[&b], 0);
+
+  for (int i = 0; i < MIDI_SCHED_CMD_QUEUE + 4; i++) midiSchedPlaySequence(&a);
+  CHECK_EQ(seqRefs[&a], MIDI_SCHED_CMD_QUEUE);
+  CHECK_EQ(midiScheduler.droppedMsgs, 4);
+  runForUs(2000000);
+  CHECK_EQ(seqRefs[&a], 0);
+}
+
+HOST_TEST_MAIN
@@ -0,0 +1,231 @@
+// MIDI sequence files (midi_seq_file.h): writer/reader round trips, running
+// status, and decoding truncated or corrupt files — on an in-memory LittleFS.
+
+#include "host_test.h"
+#include "host_clock.h"
+#include "config.h"
+#include "bot_sounds.h"
+#include "midi_seq_file.h"
+
+static const char* kPath = MIDI_SEQ_DIR "/0.bin";
+
+static bool sameEvent(const MidiEvent& a, const MidiEvent& b) {
+  return a.note == b.note && a.velocity == b.velocity && a.channel == b.channel &&
+         a.program == b.program && a.durationMs == b.durationMs && a.offsetMs == b.offsetMs;
+}
+
+static bool writeSeq(const char* name, const std::vector<MidiEvent>& ev, uint8_t program = GM_PIANO,
+                     uint8_t flags = 0) {
+  MidiSeqWriter w;
+  if (!w.begin(kPath, name, program, flags)) return false;
+  for (const MidiEvent& e : ev) w.add(e);
+  return w.finish();
+}
+
+static std::vector<MidiEvent> readSeq(MidiSeqHeader& hdr, bool& headerOk) {
+  File f = LittleFS.open(kPath, "r");
+  std::vector<MidiEvent> out;
+  headerOk = midiSeqReadHeader(f, hdr);
+  if (!headerOk) return out;
+  out.resize(hdr.eventCount);
+  out.resize(midiSeqDecode(f, out.data(), hdr.eventCount));
+  f.close();
+  return out;
+}
+
+// Sorted random events over the full field ranges the format allows
+static std::vector<MidiEvent> randomEvents(int n, std::mt19937& rng) {
+  std::vector<MidiEvent> ev;
+  uint16_t offset = 0;
+  for (int i = 0; i < n; i++) {
+    MidiEvent e;
+    e.note = rng() % 128;
+    e.velocity = rng() % 128;
+    e.channel = rng() % 16;
+    e.program = (rng() % 4 == 0) ? rng() % 128 : 255;
+    e.durationMs = (rng() % 8 == 0) ? rng() % 65536 : rng() % 2000;
+    uint32_t step = (rng() % 3 == 0) ? 0 : rng() % (rng() % 16 == 0 ? 20000 : 300);
+    offset = (uint16_t)std::min<uint32_t>(offset + step, 0xFFFF);
+    e.offsetMs = offset;
+    ev.push_back(e);
+  }
+  return ev;
+}
+
+TEST(random_round_trip) {
+  std::mt19937 rng(7);
+  for (int round = 0; round < 50; round++) {
+    std::vector<MidiEvent> in = randomEvents(1 + rng() % 600, rng);
+    CHECK(writeSeq("Random", in, 5, 3));
+    MidiSeqHeader hdr;
+    bool ok;
+    std::vector<MidiEvent> out = readSeq(hdr, ok);
+    CHECK(ok);
+    CHECK_EQ(hdr.eventCount, in.size());
+    CHECK_EQ(hdr.defaultProgram, 5);
+    CHECK_EQ(hdr.flags, 3);
+    CHECK(strcmp(hdr.name, "Random") == 0);
+    uint32_t total = 0;
+    for (const MidiEvent& e : in) total = std::max(total, (uint32_t)e.offsetMs + e.durationMs);
+    CHECK_EQ(hdr.totalMs, std::min(total, (uint32_t)0xFFFF));
+    CHECK_EQ(out.size(), in.size());
+    int bad = 0;
+    for (size_t i = 0; i < out.size() && i < in.size(); i++) bad += !sameEvent(in[i], out[i]);
+    CHECK_EQ(bad, 0);
+  }
+}
+
+// The built-in songs survive the trip in well under 8 bytes an event. A few
+// of their tables list an event earlier than the one before it; every cursor
+// plays that one late, at the previous event's time, and the file stores
+// that as-played time.
+TEST(builtin_sequences_round_trip) {
+  size_t events = 0, bytes = 0;
+  for (const MidiSequenceDef& def : builtinSequences) {
+    if (!def.events || def.eventCount == 0) continue;
+    std::vector<MidiEvent> in(def.events, def.events + def.eventCount);
+    for (size_t i = 1; i < in.size(); i++) in[i].offsetMs = std::max(in[i].offsetMs, in[i - 1].offsetMs);
+    CHECK(writeSeq(def.name, in, def.defaultProgram, def.flags));
+    MidiSeqHeader hdr;
+    bool ok;
+    std::vector<MidiEvent> out = readSeq(hdr, ok);
+    CHECK(ok && strcmp(hdr.name, def.name) == 0);
+    CHECK_EQ(out.size(), in.size());
+    for (size_t i = 0; i < out.size() && i < in.size(); i++) CHECK(sameEvent(in[i], out[i]));
+    events += in.size();
+    bytes += LittleFS.open(kPath, "r").size() - MIDI_SEQ_HEADER_SIZE - strlen(def.name);
+  }
+  CHECK(bytes < events * 6);
+  REPORT("%zu events in %zu bytes: %.2f bytes/event vs %zu in RAM", events, bytes,
+         (double)bytes / events, sizeof(MidiEvent));
+}
+
+// Same channel and program as the previous event: no status byte, so a
+// short note is 4 bytes (delta, note, velocity, duration)
+TEST(running_status) {
+  std::vector<MidiEvent> in;
+  for (int i = 0; i < 10; i++) in.push_back({(uint8_t)(60 + i), 100, 0, 255, 100, (uint16_t)(i * 100)});
+  CHECK(writeSeq("", in));
+  CHECK_EQ(LittleFS.open(kPath, "r").size(), MIDI_SEQ_HEADER_SIZE + 10 * 4);
+
+  // A program change costs two bytes once, then runs again
+  in[5].program = 24;
+  for (int i = 6; i < 10; i++) in[i].program = 24;
+  CHECK(writeSeq("", in));
+  CHECK_EQ(LittleFS.open(kPath, "r").size(), MIDI_SEQ_HEADER_SIZE + 10 * 4 + 2);
+}
+
+// Names longer than 31 bytes are cut, not overflowed
+TEST(long_name_truncated) {
+  std::vector<MidiEvent> in = {{60, 100, 0, 255, 100, 0}};
+  std::string name(80, 'x');
+  CHECK(writeSeq(name.c_str(), in));
+  MidiSeqHeader hdr;
+  bool ok;
+  std::vector<MidiEvent> out = readSeq(hdr, ok);
+  CHECK(ok);
+  CHECK_EQ(strlen(hdr.name), 31);
+  CHECK_EQ(out.size(), 1);
+}
+
+// Out-of-order offsets are clamped to the previous one (the delta can't go
+// negative)
+TEST(unsorted_offsets_clamped) {
+  std::vector<MidiEvent> in = {{60, 100, 0, 255, 100, 500}, {62, 100, 0, 255, 100, 200},
+                               {64, 100, 0, 255, 100, 700}};
+  CHECK(writeSeq("", in));
+  MidiSeqHeader hdr;
+  bool ok;
+  std::vector<MidiEvent> out = readSeq(hdr, ok);
+  CHECK_EQ(out.size(), 3);
+  CHECK_EQ(out[1].offsetMs, 500);
+  CHECK_EQ(out[2].offsetMs, 700);
+}
+
+TEST(bad_header_rejected) {
+  std::vector<MidiEvent> in = {{60, 100, 0, 255, 100, 0}};
+  for (int which = 0; which < 4; which++) {
+    CHECK(writeSeq("x", in));
+    (*LittleFS.files[kPath])[which] ^= 0x40;   // Magic or version
+    MidiSeqHeader hdr;
+    bool ok;
+    readSeq(hdr, ok);
+    CHECK(!ok);
+  }
+  LittleFS.open(kPath, "w").close();
+  MidiSeqHeader hdr;
+  bool ok;
+  readSeq(hdr, ok);
+  CHECK(!ok);
+}
+
+// A file cut short decodes to an exact prefix of what was written
+TEST(truncated_file_decodes_prefix) {
+  std::mt19937 rng(11);
+  std::vector<MidiEvent> in = randomEvents(300, rng);
+  CHECK(writeSeq("Cut", in));
+  std::vector<uint8_t> whole = *LittleFS.files[kPath];
+  for (size_t len = MIDI_SEQ_HEADER_SIZE + 3; len < whole.size(); len += 7) {
+    *LittleFS.files[kPath] = std::vector<uint8_t>(whole.begin(), whole.begin() + len);
+    MidiSeqHeader hdr;
+    bool ok;
+    std::vector<MidiEvent> out = readSeq(hdr, ok);
+    CHECK(ok);
+    CHECK(out.size() < in.size());
+    for (size_t i = 0; i < out.size(); i++) CHECK(sameEvent(in[i], out[i]));
+  }
+}
+
+// Random damage never decodes past maxEvents or reads out of bounds (run
+// under make asan); every event it does return has in-range fields
+TEST(corrupt_files_stay_bounded) {
+  std::mt19937 rng(13);
+  std::vector<MidiEvent> in = randomEvents(200, rng);
+  CHECK(writeSeq("Fuzz", in));
+  std::vector<uint8_t> whole = *LittleFS.files[kPath];
+  int shorter = 0;
+  for (int round = 0; round < 3000; round++) {
+    std::vector<uint8_t> bytes = whole;
+    int flips = 1 + rng() % 8;
+    for (int i = 0; i < flips; i++) {
+      size_t at = MIDI_SEQ_HEADER_SIZE + 4 + rng() % (bytes.size() - MIDI_SEQ_HEADER_SIZE - 4);
+      bytes[at] = (uint8_t)rng();
+    }
+    *LittleFS.files[kPath] = bytes;
+    File f = LittleFS.open(kPath, "r");
+    MidiSeqHeader hdr;
+    if (!midiSeqReadHeader(f, hdr)) continue;
+    std::vector<MidiEvent> out(64);
+    uint16_t n = midiSeqDecode(f, out.data(), 64);
+    CHECK(n <= 64);
+    for (uint16_t i = 0; i < n; i++) {
+      CHECK(out[i].note < 128 && out[i].velocity < 128 && out[i].channel < 16);
+      CHECK(out[i].program < 128 || out[i].program == 255);
+    }
+    if (n < 64) shorter++;
+  }
+  REPORT("%d of 3000 damaged files stopped early", shorter);
+}
+
+// A full partition makes the writer report failure rather than leave a
+// file whose header claims events it doesn't hold
+TEST(full_flash_fails_write) {
+  std::mt19937 rng(17);
+  std::vector<MidiEvent> in = randomEvents(500, rng);
+  LittleFS.capacityBytes = 600;
+  CHECK(!writeSeq("Big", in));
+  LittleFS.capacityBytes = 1 << 20;
+  CHECK(writeSeq("Big", in));
+}
+
+TEST(event_cap) {
+  MidiSeqWriter w;
+  CHECK(w.begin(kPath, "Cap", 0, 0));
+  MidiEvent e = {60, 100, 0, 255, 10, 0};
+  int added = 0;
+  for (int i = 0; i < MIDI_SEQ_MAX_EVENTS + 10; i++) added += w.add(e);
+  CHECK_EQ(added, MIDI_SEQ_MAX_EVENTS);
+  CHECK(w.finish());
+}
+
+HOST_TEST_MAIN
@@ -0,0 +1,224 @@
+// Soft synth (soft_synth.h): pitch, sample-accurate event timing, envelopes,
+// voice stealing and the sequence reference it holds — rendered on the host.
+
+#include "host_test.h"
+#include "host_clock.h"
+#include "config.h"
+#include "bot_sounds.h"
+#include "soft_synth.h"
+#include <map>
+
+// content_cache.h's refcount, as seen by the backends
+static std::map<const MidiSequenceDef*, int> seqRefs;
+void cloudSequenceRetain(const MidiSequenceDef* def) { seqRefs[def]++; }
+void cloudSequenceRelease(const MidiSequenceDef* def) { seqRefs[def]--; }
+
+static const uint32_t kMsSamples = SYNTH_SAMPLE_RATE / 1000;
+static const uint8_t kOrgan = 16;   // GM organ family: square, sustains, 80 ms release
+
+static MidiSequenceDef makeSeq(const MidiEvent* events, uint16_t count, uint8_t program = GM_PIANO) {
+  return MidiSequenceDef{"test", count, program, 0, events};
+}
+
+// Renders blocks until the synth is idle (or maxMs passes); returns every sample
+static std::vector<int16_t> renderAll(uint32_t maxMs = 10000) {
+  std::vector<int16_t> out;
+  int16_t block[SYNTH_BLOCK];
+  while (softSynth.busy() && out.size() < maxMs * kMsSamples) {
+    softSynth.renderBlock(block);
+    out.insert(out.end(), block, block + SYNTH_BLOCK);
+  }
+  return out;
+}
+
+static size_t firstSound(const std::vector<int16_t>& s, size_t from = 0) {
+  for (size_t i = from; i < s.size(); i++) {
+    if (s[i] != 0) return i;
+  }
+  return s.size();
+}
+
+static int peakOf(const std::vector<int16_t>& s, size_t from, size_t to) {
+  int peak = 0;
+  for (size_t i = from; i < to && i < s.size(); i++) peak = std::max(peak, abs((int)s[i]));
+  return peak;
+}
+
+// Rising zero crossings per second over [from, to)
+static float pitchOf(const std::vector<int16_t>& s, size_t from, size_t to) {
+  int crossings = 0;
+  size_t first = 0, last = 0;
+  for (size_t i = from + 1; i < to; i++) {
+    if (s[i - 1] < 0 && s[i] >= 0) {
+      if (crossings++ == 0) first = i;
+      last = i;
+    }
+  }
+  return crossings > 1 ? (crossings - 1) * (float)SYNTH_SAMPLE_RATE / (last - first) : 0;
+}
+
+// A4 on a sine-family program sounds at 440 Hz; C6 two octaves and a
+// minor third up
+TEST(note_pitch) {
+  softSynth.init();
+  static const MidiEvent ev[] = {{69, 100, 0, 255, 300, 0}, {84, 100, 0, 255, 300, 400}};
+  MidiSequenceDef def = makeSeq(ev, 2, GM_CELESTA);
+  softSynth.startSequence(&def);
+  std::vector<int16_t> s = renderAll();
+  CHECK_NEAR(pitchOf(s, 20 * kMsSamples, 250 * kMsSamples), 440.0f, 2.0f);
+  CHECK_NEAR(pitchOf(s, 420 * kMsSamples, 650 * kMsSamples), 1046.5f, 4.0f);
+}
+
+// Events fire on their exact sample, not the next block or control chunk
+TEST(events_are_sample_accurate) {
+  static const uint16_t offsets[] = {0, 7, 100, 333, 1001};
+  for (uint16_t off : offsets) {
+    softSynth.init();
+    MidiEvent ev[] = {{60, 127, 0, 255, 50, off}};
+    MidiSequenceDef def = makeSeq(ev, 1, kOrgan);
+    softSynth.startSequence(&def);
+    std::vector<int16_t> s = renderAll();
+    // The first sample of a note is phase 0 (silent); sound starts right after
+    size_t at = firstSound(s);
+    CHECK(at >= off * kMsSamples && at <= off * kMsSamples + 2);
+  }
+}
+
+// A note lasts its duration plus the patch release, then the voice frees up
+// and the synth goes idle
+TEST(envelope_ends_after_release) {
+  softSynth.init();
+  static const MidiEvent ev[] = {{60, 100, 0, 255, 200, 0}};
+  MidiSequenceDef def = makeSeq(ev, 1, kOrgan);
+  softSynth.startSequence(&def);
+  std::vector<int16_t> s = renderAll();
+  CHECK(!softSynth.busy());
+  CHECK_EQ(softSynth.activeVoices, 0);
+  CHECK(peakOf(s, 100 * kMsSamples, 190 * kMsSamples) > 2000);
+  CHECK_NEAR(s.size() / (float)kMsSamples, 200 + 80, 12);
+  CHECK_EQ(peakOf(s, s.size() - SYNTH_BLOCK / 4, s.size()), 0);
+}
+
+// More notes than voices: the oldest are stolen, nothing clips past full
+// scale, and the synth still finishes
+TEST(voice_stealing) {
+  softSynth.init();
+  std::vector<MidiEvent> ev;
+  for (int i = 0; i < 20; i++) ev.push_back({(uint8_t)(48 + i), 127, 0, 255, 400, (uint16_t)(i * 5)});
+  MidiSequenceDef def = makeSeq(ev.data(), (uint16_t)ev.size(), kOrgan);
+  softSynth.startSequence(&def);
+  int16_t block[SYNTH_BLOCK];
+  uint8_t most = 0;
+  std::vector<int16_t> s;
+  while (softSynth.busy() && s.size() < 5 * SYNTH_SAMPLE_RATE) {
+    softSynth.renderBlock(block);
+    s.insert(s.end(), block, block + SYNTH_BLOCK);
+    most = std::max(most, (uint8_t)softSynth.activeVoices);
+  }
+  CHECK_EQ(most, SYNTH_VOICES);
+  CHECK(!softSynth.busy());
+  CHECK(peakOf(s, 0, s.size()) <= 32767);
+  for (const SynthVoice& v : softSynth.voices) CHECK_EQ(v.stage, ENV_IDLE);
+}
+
+// Percussion goes to the drum voice and decays on its own
+TEST(drum_hit_decays) {
+  softSynth.init();
+  static const MidiEvent ev[] = {{PERC_SNARE, 127, MIDI_CH_PERCUSSION, 255, 20, 0}};
+  MidiSequenceDef def = makeSeq(ev, 1);
+  softSynth.startSequence(&def);
+  std::vector<int16_t> s = renderAll();
+  CHECK(peakOf(s, 0, 10 * kMsSamples) > 4000);
+  CHECK(!softSynth.drum.active);
+  CHECK(s.size() < 400 * kMsSamples);
+  for (const SynthVoice& v : softSynth.voices) CHECK_EQ(v.stage, ENV_IDLE);
+}
+
+// Every built-in sequence renders to the end without clipping
+TEST(builtin_sequences_finish) {
+  int longest = 0;
+  for (const MidiSequenceDef& def : builtinSequences) {
+    if (!def.events || def.eventCount == 0) continue;
+    softSynth.init();
+    softSynth.startSequence(&def);
+    std::vector<int16_t> s = renderAll(120000);
+    CHECK(!softSynth.busy());
+    int clipped = 0;
+    for (int16_t v : s) clipped += (v == 32767 || v == -32767);
+    CHECK(clipped < (int)s.size() / 1000);
+    longest = std::max(longest, (int)(s.size() / kMsSamples));
+  }
+  REPORT("longest built-in: %d ms", longest);
+}
+
+// The synth holds one reference to the sequence it plays: taken when the
+// command is posted, dropped when the sequence ends, is replaced, is
+// stopped, or the post fails
+TEST(sequence_reference) {
+  softSynth.init();
+  seqRefs.clear();
+  static const MidiEvent ev[] = {{60, 100, 0, 255, 100, 0}, {64, 100, 0, 255, 100, 200}};
+  MidiSequenceDef a = makeSeq(ev, 2), b = makeSeq(ev, 2);
+
+  SynthCmd cmd;
+  softSynthPlaySequence(&a);
+  CHECK_EQ(seqRefs[&a], 1);
+  while (xQueueReceive(softSynth.cmdQueue, &cmd, 0) == pdTRUE) softSynth.handleCmd(cmd);
+  renderAll();
+  CHECK_EQ(seqRefs[&a], 0);
+
+  softSynthPlaySequence(&a);
+  softSynthPlaySequence(&b);
+  while (xQueueReceive(softSynth.cmdQueue, &cmd, 0) == pdTRUE) softSynth.handleCmd(cmd);
+  CHECK_EQ(seqRefs[&a], 0);
+  CHECK_EQ(seqRefs[&b], 1);
+  softSynthStop();
+  while (xQueueReceive(softSynth.cmdQueue, &cmd, 0) == pdTRUE) softSynth.handleCmd(cmd);
+  CHECK_EQ(seqRefs[&b], 0);
+  CHECK_EQ(M5.Speaker.stops, 1);
+
+  // Queue full: the post that doesn't fit gives its reference straight back
+  for (int i = 0; i < SYNTH_CMD_QUEUE + 3; i++) softSynthPlaySequence(&a);
+  CHECK_EQ(seqRefs[&a], SYNTH_CMD_QUEUE);
+  while (xQueueReceive(softSynth.cmdQueue, &cmd, 0) == pdTRUE) softSynth.handleCmd(cmd);
+  CHECK_EQ(seqRefs[&a], 1);
+  renderAll();
+  CHECK_EQ(seqRefs[&a], 0);
+
+  // An empty sequence is released without playing
+  MidiSequenceDef empty = makeSeq(ev, 0);
+  softSynthPlaySequence(&empty);
+  while (xQueueReceive(softSynth.cmdQueue, &cmd, 0) == pdTRUE) softSynth.handleCmd(cmd);
+  CHECK_EQ(seqRefs[&empty], 0);
+  CHECK(!softSynth.busy());
+}
+
+// A tone is one vibraphone note at the nearest semitone
+TEST(tone_command) {
+  softSynth.init();
+  SynthCmd cmd = {SYNTH_CMD_TONE, nullptr, 880, 150};
+  softSynth.handleCmd(cmd);
+  std::vector<int16_t> s = renderAll();
+  CHECK_NEAR(pitchOf(s, 5 * kMsSamples, 140 * kMsSamples), 880.0f, 4.0f);
+  CHECK(s.size() < 500 * kMsSamples);
+}
+
+// Rendering a block of eight voices plus drums fits well inside its 10.7 ms
+// budget even on the host's -O1 build (figure only)
+TEST(render_cost) {
+  softSynth.init();
+  std::vector<MidiEvent> ev;
+  for (int i = 0; i < 8; i++) ev.push_back({(uint8_t)(60 + i), 100, 0, 255, 2000, 0});
+  ev.push_back({PERC_OPEN_HH, 100, MIDI_CH_PERCUSSION, 255, 20, 0});
+  MidiSequenceDef def = makeSeq(ev.data(), (uint16_t)ev.size(), kOrgan);
+  softSynth.startSequence(&def);
+  int16_t block[SYNTH_BLOCK];
+  struct timespec t0, t1;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for (int b = 0; b < 100; b++) softSynth.renderBlock(block);
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  double us = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / 1e3 / 100;
+  REPORT("%.1f us per %u-sample block (budget %u us)", us, SYNTH_BLOCK, SoftSynth::blockBudgetUs());
+}
+
+HOST_TEST_MAIN
@@ -0,0 +1,292 @@
+// WLED fonts (wled_font.h): the generated tables against their BDF sources,
+// the glyph cache against a bit-by-bit draw straight from the tables at every
+// scale and clip position, widths, fallback glyphs, and the font setting.
+
+#include "host_test.h"
+#include "wled_host.h"
+#include <fstream>
+#include <map>
+#include <sstream>
+
+static const char* const kBdf[WLED_FONT_ID_COUNT] = {
+  "../../scripts/fonts/wled-3x5.bdf",
+  "../../scripts/fonts/wled-5x7.bdf",
+  "../../scripts/fonts/wled-prop8.bdf",
+};
+
+static const char* const kTexts[] = {
+  "Hi!", "72F", "Mon 72F", "Hello there, how are you today?",
+  "The quick brown fox jumps over the lazy dog 0123456789", "~{|}`_^@\x7f\t\xc3\xa9",
+};
+
+// ---- Reference: the BDF cell and a draw that tests every bit ----
+
+struct BdfGlyph {
+  int dwidth = 0, bw = 0, bh = 0, bx = 0, by = 0;
+  std::vector<uint32_t> rows;
+};
+
+struct BdfFont {
+  int ascent = -1, descent = -1;
+  std::map<int, BdfGlyph> glyphs;
+};
+
+static BdfFont readBdf(const char* path) {
+  BdfFont font;
+  std::ifstream in(path);
+  std::string line;
+  BdfGlyph g;
+  int encoding = -1;
+  bool bitmap = false;
+  while (std::getline(in, line)) {
+    std::istringstream ls(line);
+    std::string key;
+    ls >> key;
+    if (bitmap) {
+      if (key == "ENDCHAR") {
+        font.glyphs[encoding] = g;
+        bitmap = false;
+      } else {
+        g.rows.push_back(strtoul(key.c_str(), nullptr, 16));
+      }
+    } else if (key == "FONT_ASCENT") {
+      ls >> font.ascent;
+    } else if (key == "FONT_DESCENT") {
+      ls >> font.descent;
+    } else if (key == "STARTCHAR") {
+      g = BdfGlyph();
+    } else if (key == "ENCODING") {
+      ls >> encoding;
+    } else if (key == "DWIDTH") {
+      ls >> g.dwidth;
+    } else if (key == "BBX") {
+      ls >> g.bw >> g.bh >> g.bx >> g.by;
+    } else if (key == "BITMAP") {
+      bitmap = true;
+    }
+  }
+  return font;
+}
+
+static uint8_t tableWidth(const WledFont* f, uint8_t i) {
+  return f->widths ? pgm_read_byte(&f->widths[i]) : f->width;
+}
+
+static uint8_t tableColumn(const WledFont* f, uint8_t i, uint8_t k) {
+  uint16_t start = f->offsets ? pgm_read_word(&f->offsets[i]) : i * f->width;
+  return pgm_read_byte(&f->cols[start + k]);
+}
+
+static void naiveDraw(const WledFont* f, uint8_t scale, uint8_t* buf, int bw, int bh, int x, int y,
+                      const char* s, uint8_t r, uint8_t g, uint8_t b) {
+  const uint8_t fallback = '?' - f->first;
+  for (const char* p = s; *p; p++) {
+    if (p != s) x += f->spacing * scale;
+    uint8_t i = (uint8_t)*p - f->first;
+    if (i >= f->count) i = fallback;
+    for (uint8_t k = 0; k < tableWidth(f, i); k++) {
+      uint8_t bits = tableColumn(f, i, k);
+      for (uint8_t row = 0; row < f->height; row++) {
+        if (!(bits & (1 << row))) continue;
+        for (int dy = 0; dy < scale; dy++) {
+          for (int dx = 0; dx < scale; dx++) {
+            int px = x + k * scale + dx, py = y + row * scale + dy;
+            if (px < 0 || py < 0 || px >= bw || py >= bh) continue;
+            uint8_t* o = buf + (py * bw + px) * 3;
+            o[0] = r;
+            o[1] = g;
+            o[2] = b;
+          }
+        }
+      }
+    }
+    x += tableWidth(f, i) * scale;
+  }
+}
+
+// The compiled tables are the BDF glyphs: one column per advance pixel less
+// the spacing, placed on the baseline, LSB at the top of the cell
+TEST(tables_match_bdf) {
+  for (uint8_t id = 0; id < WLED_FONT_ID_COUNT; id++) {
+    const WledFont* f = wledFontById(id);
+    BdfFont bdf = readBdf(kBdf[id]);
+    CHECK(bdf.ascent >= 0);
+    CHECK_EQ(f->height, bdf.ascent + bdf.descent);
+    CHECK_EQ(f->first, 0x20);
+    CHECK_EQ(f->count, WLED_FONT_MAX_GLYPHS);
+    int wrong = 0;
+    uint8_t widest = 0;
+    for (uint8_t i = 0; i < f->count; i++) {
+      auto it = bdf.glyphs.find(f->first + i);
+      if (it == bdf.glyphs.end()) {
+        wrong++;
+        continue;
+      }
+      const BdfGlyph& g = it->second;
+      const uint8_t w = max(g.dwidth - f->spacing, 1);
+      widest = max(widest, w);
+      if (tableWidth(f, i) != w) {
+        wrong++;
+        continue;
+      }
+      const int rowBits = (g.bw + 7) / 8 * 8;
+      const int top = bdf.ascent - (g.by + g.bh);
+      for (uint8_t k = 0; k < w; k++) {
+        uint8_t want = 0;
+        for (size_t row = 0; row < g.rows.size(); row++) {
+          int y = top + (int)row, c = k - g.bx;
+          if (y < 0 || y >= f->height || c < 0 || c >= g.bw) continue;
+          if (g.rows[row] & (1u << (rowBits - 1 - c))) want |= 1 << y;
+        }
+        wrong += tableColumn(f, i, k) != want;
+      }
+    }
+    if (wrong) fprintf(stderr, "  %s: %d glyphs or columns differ from %s\n", f->name, wrong, kBdf[id]);
+    CHECK_EQ(wrong, 0);
+    CHECK_EQ(f->width, widest);
+  }
+}
+
+// Cache draws match the bit-by-bit draw for every font at scales 1-4, on
+// the 32x8 panel and the taller ones, anywhere from well off the left/top to
+// well off the right/bottom — and never touch a byte outside the buffer
+TEST(cache_matches_reference) {
+  struct Geo { int w, h; };
+  static const Geo kGeos[] = { {32, 8}, {32, 16}, {64, 32} };
+  static WledGlyphCache c;
+  int wrong = 0, draws = 0, spilled = 0;
+  for (uint8_t id = 0; id < WLED_FONT_ID_COUNT; id++) {
+    for (uint8_t scale = 1; scale <= WLED_FONT_MAX_SCALE; scale++) {
+      CHECK(wledGlyphCacheLoad(c, wledFontById(id), scale));
+      CHECK_EQ(c.height, wledFontById(id)->height * scale);
+      for (const Geo& g : kGeos) {
+        // A tallest-glyph's worth of guard rows below the panel
+        const size_t bytes = g.w * g.h * 3, guard = g.w * 32 * 3;
+        std::vector<uint8_t> a(bytes + guard), b(bytes);
+        for (const char* text : kTexts) {
+          for (int y = -40; y <= 40; y += 3) {
+            for (int x = -70; x <= 70; x += 7) {
+              memset(a.data(), 0, bytes);
+              memset(a.data() + bytes, 0xA5, guard);
+              std::fill(b.begin(), b.end(), 0);
+              int16_t end = wledGlyphDrawString(c, a.data(), g.w, g.h, x, y, text, 9, 99, 199);
+              naiveDraw(c.font, scale, b.data(), g.w, g.h, x, y, text, 9, 99, 199);
+              wrong += memcmp(a.data(), b.data(), bytes) != 0;
+              spilled += std::count(a.begin() + bytes, a.end(), 0xA5) != (long)guard;
+              if (y >= 0 && y < g.h && x + (int)wledGlyphTextWidth(c, text) <= g.w) {
+                wrong += end != x + wledGlyphTextWidth(c, text);
+              }
+              draws++;
+            }
+          }
+        }
+      }
+    }
+  }
+  CHECK_EQ(wrong, 0);
+  CHECK_EQ(spilled, 0);
+  CHECK(draws > 10000);
+}
+
+// Characters outside printable ASCII draw as '?', and width counts them as
+// '?'
+TEST(fallback_glyph) {
+  static WledGlyphCache c;
+  for (uint8_t id = 0; id < WLED_FONT_ID_COUNT; id++) {
+    wledGlyphCacheLoad(c, wledFontById(id), 1);
+    uint8_t a[WLED_PIXEL_BYTES] = {}, b[WLED_PIXEL_BYTES] = {};
+    wledGlyphDrawString(c, a, 32, 8, 0, 0, "A\x7f\tB\xc3", 255, 255, 255);
+    wledGlyphDrawString(c, b, 32, 8, 0, 0, "A??B?", 255, 255, 255);
+    CHECK(memcmp(a, b, sizeof(a)) == 0);
+    CHECK_EQ(wledGlyphTextWidth(c, "\x01\xff"), wledGlyphTextWidth(c, "??"));
+  }
+}
+
+// The largest whole scale that fits the panel height, and a loaded cache
+// isn't rebuilt for the same font and scale
+TEST(fit_scale_and_reload) {
+  CHECK_EQ(wledFontFitScale(&WLED_FONT_3X5, 8), 1);
+  CHECK_EQ(wledFontFitScale(&WLED_FONT_3X5, 16), 3);
+  CHECK_EQ(wledFontFitScale(&WLED_FONT_5X7, 16), 2);
+  CHECK_EQ(wledFontFitScale(&WLED_FONT_PROP8, 32), 4);
+  CHECK_EQ(wledFontFitScale(&WLED_FONT_3X5, 64), WLED_FONT_MAX_SCALE);
+  CHECK_EQ(wledFontFitScale(&WLED_FONT_PROP8, 4), 1);
+
+  static WledGlyphCache c;
+  CHECK(wledGlyphCacheLoad(c, &WLED_FONT_5X7, 2));
+  c.cols[0] = 0xDEADBEEF;
+  CHECK(wledGlyphCacheLoad(c, &WLED_FONT_5X7, 2));
+  CHECK_EQ(c.cols[0], 0xDEADBEEF);   // Same font and scale: kept
+  CHECK(wledGlyphCacheLoad(c, &WLED_FONT_5X7, 3));
+  CHECK(c.cols[0] != 0xDEADBEEF);
+}
+
+// The font setting: saved to NVS, read back at boot, bad ids ignored or
+// reset to 3x5, and a static frame too wide for it drawn in 3x5
+TEST(font_setting) {
+  wledHostBoot();
+  CHECK_EQ(wledData.font, WLED_FONT_ID_3X5);
+  wledSetFont(WLED_FONT_ID_PROP8);
+  wledSetFont(WLED_FONT_ID_COUNT);
+  CHECK_EQ(wledData.font, WLED_FONT_ID_PROP8);
+  wledData.font = WLED_FONT_ID_3X5;
+  loadWledSettings();
+  CHECK_EQ(wledData.font, WLED_FONT_ID_PROP8);
+
+  Preferences prefs;
+  prefs.begin("vizbot", false);
+  prefs.putUChar("wledFont", 200);
+  prefs.end();
+  loadWledSettings();
+  CHECK_EQ(wledData.font, WLED_FONT_ID_3X5);
+
+  static WledGlyphCache c;
+  const char* wide = "Wednesday";
+  wledData.font = WLED_FONT_ID_5X7;
+  wledGlyphCacheLoad(c, &WLED_FONT_5X7, 1);
+  CHECK(wledGlyphTextWidth(c, wide) > WLED_DISPLAY_WIDTH);
+  uint8_t a[WLED_PIXEL_BYTES], b[WLED_PIXEL_BYTES] = {};
+  wledPixelClear(a);
+  wledPixelDrawText(a, wide, 255, 0, 0);
+  wledGlyphCacheLoad(c, &WLED_FONT_3X5, 1);
+  wledGlyphDrawCentered(c, b, WLED_DISPLAY_WIDTH, WLED_DISPLAY_HEIGHT, wide, 255, 0, 0);
+  CHECK(memcmp(a, b, sizeof(a)) == 0);
+}
+
+static double wallNs() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+// Draw cost per string, cache against the bit-by-bit draw, at the scale
+// each panel height gets (figures only)
+TEST(draw_cost) {
+  struct Geo { int w, h; };
+  static const Geo kGeos[] = { {32, 8}, {32, 16}, {64, 32} };
+  static WledGlyphCache c;
+  const char* text = "Hello there, how are you today?";
+  const int reps = 20000;
+  for (const Geo& g : kGeos) {
+    std::vector<uint8_t> buf(g.w * g.h * 3);
+    for (uint8_t id = 0; id < WLED_FONT_ID_COUNT; id++) {
+      const uint8_t scale = wledFontFitScale(wledFontById(id), g.h);
+      wledGlyphCacheLoad(c, wledFontById(id), scale);
+      const int y = (g.h - c.height) / 2;
+      double t0 = wallNs();
+      for (int i = 0; i < reps; i++) {
+        wledGlyphDrawString(c, buf.data(), g.w, g.h, -(i & 63), y, text, 255, 128, 0);
+      }
+      const double cacheNs = (wallNs() - t0) / reps;
+      t0 = wallNs();
+      for (int i = 0; i < reps; i++) {
+        naiveDraw(c.font, scale, buf.data(), g.w, g.h, -(i & 63), y, text, 255, 128, 0);
+      }
+      const double naiveNs = (wallNs() - t0) / reps;
+      REPORT("%2dx%-2d %-5s x%d  cache %5.0f ns  bit-by-bit %5.0f ns", g.w, g.h, c.font->name, scale,
+             cacheNs, naiveNs);
+    }
+  }
+}
+
+HOST_TEST_MAIN
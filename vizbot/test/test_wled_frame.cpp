@@ -0,0 +1,164 @@
+// WLED frame exchange (wled_frame.h): the triple buffer's hand-off rules, a
+// producer and consumer thread racing through it, and frames queued on
+// Core 1 reaching WLED whole through pollWledDisplay().
+
+#include "host_test.h"
+#include "wled_host.h"
+#include <thread>
+
+// Fill a slot so every pixel and the text say which publish it was
+static void drawNumbered(WledFrame& f, uint32_t n) {
+  memset(f.px, (uint8_t)(n * 7 + 1), WLED_PIXEL_BYTES);
+  snprintf(f.text, MAX_SAY_LEN, "frame %u", n);
+}
+
+// A frame is whole if all its pixels and its text agree with its seq
+static bool whole(const WledFrame& f) {
+  const uint8_t want = (uint8_t)(f.seq * 7 + 1);
+  for (int i = 0; i < WLED_PIXEL_BYTES; i++) {
+    if (f.px[i] != want) return false;
+  }
+  char text[MAX_SAY_LEN];
+  snprintf(text, sizeof(text), "frame %u", f.seq);
+  return strcmp(f.text, text) == 0;
+}
+
+// The producer, the hand-off and the consumer always own three different
+// slots
+static bool slotsDistinct(const WledFrameExchange& x) {
+  uint8_t mid = x.middle.load() & WLED_FRAME_INDEX;
+  return x.back != mid && x.back != x.front && mid != x.front && x.back < 3 && mid < 3 &&
+         x.front < 3;
+}
+
+TEST(hand_off) {
+  static WledFrameExchange x;
+  x.init();
+  CHECK(!x.pending());
+  CHECK(x.acquire() == nullptr);
+
+  // Two publishes before a take: the sender gets the newer, the older counts
+  // as dropped
+  drawNumbered(x.draft(), 1);
+  x.publish(3000, WLED_LEASE_PRIO_SPEECH);
+  CHECK(slotsDistinct(x));
+  drawNumbered(x.draft(), 2);
+  hostAdvanceMs(5);
+  x.publish(1500, WLED_LEASE_PRIO_STREAM);
+  CHECK(slotsDistinct(x));
+  CHECK(x.pending());
+  const WledFrame* f = x.acquire();
+  CHECK(f != nullptr);
+  CHECK_EQ(f->seq, 2);
+  CHECK(whole(*f));
+  CHECK_EQ(f->holdMs, 1500);
+  CHECK_EQ(f->prio, WLED_LEASE_PRIO_STREAM);
+  CHECK_EQ(f->publishedMs, millis());
+  CHECK_EQ(x.published, 2);
+  CHECK_EQ(x.dropped, 1);
+  CHECK_EQ(x.taken, 1);
+  CHECK(x.acquire() == nullptr);   // Nothing new since
+
+  // The taken frame stays put while the producer keeps going
+  for (uint32_t n = 3; n < 50; n++) {
+    drawNumbered(x.draft(), n);
+    CHECK(&x.draft() != f);
+    x.publish(100, WLED_LEASE_PRIO_STREAM);
+    CHECK(slotsDistinct(x));
+  }
+  CHECK_EQ(f->seq, 2);
+  CHECK(whole(*f));
+
+  const WledFrame* g = x.acquire();
+  CHECK(g != nullptr && g->seq == 49 && whole(*g));
+  CHECK_EQ(x.published, x.taken + x.dropped);
+}
+
+// Core 1 and Core 0 as two threads, one drawing and publishing, one taking
+// and checking. Every frame taken is whole and newer than the last; every
+// frame published is either taken or counted dropped.
+static void race(uint32_t frames, bool yieldEach, uint32_t& torn, uint32_t& backwards,
+                 uint32_t& received, uint32_t& lastSeq) {
+  static WledFrameExchange x;
+  x.init();
+  std::atomic<bool> done(false);
+  torn = backwards = received = lastSeq = 0;
+
+  std::thread consumer([&] {
+    for (;;) {
+      bool finished = done.load(std::memory_order_acquire);
+      const WledFrame* f = x.acquire();
+      if (!f) {
+        if (finished) break;
+        continue;
+      }
+      received++;
+      torn += !whole(*f);
+      backwards += f->seq <= lastSeq;
+      lastSeq = f->seq;
+    }
+  });
+  for (uint32_t n = 1; n <= frames; n++) {
+    drawNumbered(x.draft(), n);
+    x.publish(100, WLED_LEASE_PRIO_STREAM);
+    if (yieldEach) std::this_thread::yield();
+  }
+  done.store(true, std::memory_order_release);
+  consumer.join();
+
+  CHECK_EQ(x.published, frames);
+  CHECK_EQ(x.taken, received);
+  CHECK_EQ(x.taken + x.dropped, frames);
+}
+
+TEST(threads_never_tear) {
+  uint32_t torn, backwards, received, lastSeq;
+  race(400000, false, torn, backwards, received, lastSeq);
+  CHECK_EQ(torn, 0);
+  CHECK_EQ(backwards, 0);
+  CHECK_EQ(lastSeq, 400000);   // The newest frame always gets through
+  REPORT("free-running, 400k frames: %u taken, torn=%u backwards=%u", received, torn, backwards);
+
+  race(100000, true, torn, backwards, received, lastSeq);
+  CHECK_EQ(torn, 0);
+  CHECK_EQ(backwards, 0);
+  CHECK_EQ(lastSeq, 100000);
+  REPORT("yield per frame, 100k frames: %u taken, torn=%u backwards=%u", received, torn, backwards);
+}
+
+// wledQueueText() on Core 1 to DDP on Core 0: the packet is the published
+// frame, a frame replaced before the poll never goes out, and the web test
+// button is drawn by the render loop, not the web handler
+TEST(queued_frames_reach_wled) {
+  wledHostBoot();
+  wledQueueText("HI", 2000);
+  const WledFrame published = wledFrames.slots[wledFrames.middle.load() & WLED_FRAME_INDEX];
+  hostAdvanceMs(3);
+  wledHostPoll();
+  CHECK_EQ(hostUdpSent.size(), 1);
+  if (hostUdpSent.size() != 1) return;
+  CHECK(wledHostDdp(hostUdpSent[0]) == std::vector<uint8_t>(published.px, published.px + WLED_PIXEL_BYTES));
+  CHECK_EQ(wledData.frameLatencyMs, 3);
+  CHECK(wledHostActive);
+  CHECK(wledData.phase == WLED_PHASE_HOLD);
+
+  // Two more before the next poll: only the second is sent
+  wledQueueText("ONE", 2000);
+  wledQueueText("TWO", 2000);
+  const WledFrame two = wledFrames.slots[wledFrames.middle.load() & WLED_FRAME_INDEX];
+  wledHostPoll();
+  CHECK_EQ(hostUdpSent.size(), 2);
+  CHECK(wledHostDdp(hostUdpSent.back()) == std::vector<uint8_t>(two.px, two.px + WLED_PIXEL_BYTES));
+  CHECK_EQ(wledFrames.dropped, 1);
+  CHECK_EQ(wledFrames.published, 3);
+
+  // The web handler only raises the flag; the render loop draws and publishes
+  wledRequestTest();
+  CHECK_EQ(wledFrames.published, 3);
+  wledPollTestRequest();
+  CHECK_EQ(wledFrames.published, 4);
+  const WledFrame* f = wledFrames.acquire();
+  CHECK(f != nullptr && strcmp(f->text, "Hello") == 0);
+}
+
+HOST_TEST_MAIN
@@ -0,0 +1,229 @@
+// WLED marquee (wled_marquee.h): the column strip against the glyph renderer,
+// the sub-pixel blend, the first frame matching position 0, and a whole
+// scroll through pollWledDisplay() — lead, 50 FPS paced frames, tail, restore.
+
+#include "host_test.h"
+#include "wled_host.h"
+
+static const char* const kLong =
+    "The quick brown fox jumps over the lazy dog, then naps 12 hours!";
+
+static std::vector<uint8_t> frame(const uint8_t* px) {
+  return std::vector<uint8_t>(px, px + WLED_PIXEL_BYTES);
+}
+
+static uint32_t lightIn(const std::vector<uint8_t>& px) {
+  uint32_t sum = 0;
+  for (uint8_t v : px) sum += v;
+  return sum;
+}
+
+// At every whole-pixel offset the strip gives what drawing the glyphs
+// shifted left would, in every font
+TEST(strip_matches_glyph_path) {
+  static WledMarqueeStrip strip;
+  static WledGlyphCache c;
+  int wrong = 0, frames = 0;
+  for (uint8_t font = 0; font < WLED_FONT_ID_COUNT; font++) {
+    c.font = nullptr;
+    wledGlyphCacheLoad(c, wledFontById(font), 1);
+    uint16_t w = wledMarqueeRasterize(strip, c, kLong);
+    CHECK_EQ(w, wledGlyphTextWidth(c, kLong));
+    for (uint16_t pos = 0; pos + WLED_DISPLAY_WIDTH <= w; pos++) {
+      uint8_t a[WLED_PIXEL_BYTES], b[WLED_PIXEL_BYTES];
+      wledMarqueeRender(strip, (uint32_t)pos << 8, a, 200, 120, 40);
+      memset(b, 0, sizeof(b));
+      wledGlyphDrawString(c, b, WLED_DISPLAY_WIDTH, WLED_DISPLAY_HEIGHT, -pos,
+                          (WLED_DISPLAY_HEIGHT - c.height) / 2, kLong, 200, 120, 40);
+      wrong += memcmp(a, b, sizeof(a)) != 0;
+      frames++;
+    }
+  }
+  CHECK_EQ(wrong, 0);
+  CHECK(frames > 200);
+}
+
+// Between two whole offsets each pixel blends the columns it straddles: a
+// pixel lit on both sides keeps full colour, one side alone fades in or out
+// with the fraction, and the frame's total light moves smoothly between the
+// two whole-pixel frames
+TEST(subpixel_blend) {
+  static WledMarqueeStrip strip;
+  static WledGlyphCache c;
+  wledGlyphCacheLoad(c, &WLED_FONT_5X7, 1);
+  wledMarqueeRasterize(strip, c, kLong);
+  uint8_t px[WLED_PIXEL_BYTES];
+  int bad = 0;
+  for (uint16_t pos = 0; pos < 40; pos++) {
+    wledMarqueeRender(strip, (uint32_t)pos << 8, px, 255, 255, 255);
+    std::vector<uint8_t> left = frame(px);
+    wledMarqueeRender(strip, (uint32_t)(pos + 1) << 8, px, 255, 255, 255);
+    std::vector<uint8_t> right = frame(px);
+    for (uint16_t frac = 16; frac < 256; frac += 16) {
+      wledMarqueeRender(strip, ((uint32_t)pos << 8) | frac, px, 255, 255, 255);
+      for (int i = 0; i < WLED_PIXEL_BYTES; i++) {
+        uint8_t want = left[i] && right[i] ? 255
+                     : left[i]             ? (255 * (256 - frac)) >> 8
+                     : right[i]            ? (255 * frac) >> 8
+                                           : 0;
+        bad += px[i] != want;
+      }
+      double mix = (lightIn(left) * (256.0 - frac) + lightIn(right) * frac) / 256;
+      bad += fabs(lightIn(frame(px)) - mix) > WLED_PIXEL_BYTES;
+    }
+  }
+  CHECK_EQ(bad, 0);
+}
+
+// The frame Core 1 publishes for long text is the marquee at position 0, so
+// the scroll starts without a jump
+TEST(first_frame_is_position_0) {
+  wledHostBoot();
+  for (uint8_t font = 0; font < WLED_FONT_ID_COUNT; font++) {
+    wledData.font = font;
+    wledQueueText(kLong, 3000);
+    const WledFrame* f = wledFrames.acquire();
+    CHECK(f != nullptr);
+    if (!f) continue;
+    CHECK(wledMarqueeStart(f->text, f->font, wledData.r, wledData.g, wledData.b));
+    uint8_t px[WLED_PIXEL_BYTES];
+    wledMarqueeRender(wledMarquee.strip, 0, px, wledData.r, wledData.g, wledData.b);
+    CHECK(frame(px) == frame(f->px));
+  }
+}
+
+// A whole long say through the WiFi task's 2 ms poll (with jitter): still
+// for the lead, 50 FPS with no bursts while it moves, position only ever
+// forward at the set speed, parked on the end for the tail, then restored
+// after exactly the stretched hold
+TEST(scroll_timeline) {
+  wledHostBoot();
+  wledData.scrollSpeed = 200;
+  wledQueueText(kLong, 2000);
+  const unsigned long durationMs = wledMarqueeDurationMs(kLong, wledData.font);
+  CHECK(durationMs > 2000);
+
+  const unsigned long t0 = millis();
+  std::vector<unsigned long> sentMs;
+  std::vector<uint32_t> posQ8;
+  std::mt19937 rng(3);
+  while (millis() - t0 < durationMs + 500) {
+    size_t before = hostUdpSent.size();
+    wledHostPoll();
+    if (hostUdpSent.size() > before) {
+      sentMs.push_back(millis() - t0);
+      posQ8.push_back(wledMarquee.lastPosQ8);
+    }
+    hostAdvanceUs(1500 + rng() % 1000);
+  }
+  CHECK(sentMs.size() > 10);
+  if (sentMs.size() < 10) return;
+  CHECK_EQ(sentMs[0], 0);
+
+  // Lead: nothing but the first frame
+  CHECK(sentMs[1] >= WLED_MARQUEE_LEAD_MS);
+
+  // Scroll: paced frames, position forward at pxPerSec
+  double sum = 0, worst = 0;
+  int moving = 0, backwards = 0;
+  for (size_t i = 2; i < sentMs.size(); i++) {
+    if (posQ8[i] == posQ8[i - 1]) continue;   // Keepalive at the end
+    double gap = sentMs[i] - sentMs[i - 1];
+    sum += gap;
+    worst = max(worst, gap);
+    moving++;
+    backwards += posQ8[i] < posQ8[i - 1];
+  }
+  const uint32_t endQ8 = wledMarquee.endQ8;
+  CHECK_EQ(backwards, 0);
+  CHECK_NEAR(sum / moving, WLED_MARQUEE_FRAME_MS, 0.5);
+  CHECK(worst <= WLED_MARQUEE_FRAME_MS + 3);
+  const double expectMs = (double)(endQ8 >> 8) * 1000 / wledMarqueePxPerSec();
+  CHECK_NEAR(moving, expectMs / WLED_MARQUEE_FRAME_MS, 3);
+  CHECK_EQ(posQ8.back(), endQ8);
+  uint8_t last[WLED_PIXEL_BYTES];
+  wledMarqueeRender(wledMarquee.strip, endQ8, last, wledData.r, wledData.g, wledData.b);
+  CHECK(wledHostDdp(hostUdpSent.back()) == frame(last));
+
+  // Tail, then restore at the end of the stretched hold
+  CHECK(!wledMarquee.active);
+  CHECK_EQ(wledHostSpeechEnds, 1);
+  CHECK(!wledHostActive);
+  REPORT("%zu frames over %lu ms (%d moving, %.2f ms apart, worst %.0f ms)", sentMs.size(),
+         durationMs, moving, sum / moving, worst);
+}
+
+// Text that fits is one centred frame, held for the time asked
+TEST(short_text_does_not_scroll) {
+  wledHostBoot();
+  CHECK_EQ(wledMarqueeDurationMs("HELLO", wledData.font), 0);
+  wledQueueText("HELLO", 1500);
+  const unsigned long t0 = millis();
+  while (millis() - t0 < 2000) {
+    wledHostPoll();
+    hostAdvanceMs(2);
+    if (wledHostSpeechEnds) break;
+  }
+  CHECK_EQ(hostUdpSent.size(), 1);
+  CHECK(!wledMarquee.active);
+  CHECK_NEAR(millis() - t0, 1500, 3);
+}
+
+// scrollSpeed spans 8-40 px/s and the hold grows to fit
+TEST(speed_setting) {
+  wledHostBoot();
+  wledData.scrollSpeed = 0;
+  CHECK_EQ(wledMarqueePxPerSec(), WLED_MARQUEE_MIN_PXS);
+  const unsigned long slow = wledMarqueeDurationMs(kLong, WLED_FONT_ID_3X5);
+  wledData.scrollSpeed = 255;
+  CHECK_EQ(wledMarqueePxPerSec(), WLED_MARQUEE_MAX_PXS);
+  const unsigned long fast = wledMarqueeDurationMs(kLong, WLED_FONT_ID_3X5);
+  CHECK(slow > fast);
+  static WledGlyphCache c;
+  wledGlyphCacheLoad(c, &WLED_FONT_3X5, 1);
+  const uint16_t travel = wledGlyphTextWidth(c, kLong) - WLED_DISPLAY_WIDTH;
+  CHECK_EQ(fast, WLED_MARQUEE_LEAD_MS + travel * 1000 / WLED_MARQUEE_MAX_PXS + WLED_MARQUEE_TAIL_MS);
+  CHECK_EQ(slow, WLED_MARQUEE_LEAD_MS + travel * 1000 / WLED_MARQUEE_MIN_PXS + WLED_MARQUEE_TAIL_MS);
+}
+
+static double wallUs() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+// Frame build from the strip, with the blend, against redrawing the glyphs
+// at whole pixels (figures only)
+TEST(frame_cost) {
+  static WledMarqueeStrip strip;
+  static WledGlyphCache c;
+  wledGlyphCacheLoad(c, &WLED_FONT_5X7, 1);
+  const int reps = 200;
+  double t0 = wallUs();
+  for (int r = 0; r < reps; r++) wledMarqueeRasterize(strip, c, kLong);
+  const double rasterUs = (wallUs() - t0) / reps;
+  const uint32_t endQ8 = (uint32_t)(strip.width - WLED_DISPLAY_WIDTH) << 8;
+  uint8_t px[WLED_PIXEL_BYTES];
+  int frames = 0;
+  t0 = wallUs();
+  for (int r = 0; r < reps; r++) {
+    for (uint32_t pos = 0; pos <= endQ8; pos += 167, frames++) {
+      wledMarqueeRender(strip, pos, px, 255, 255, 255);
+    }
+  }
+  const double stripUs = (wallUs() - t0) / frames;
+  frames = 0;
+  t0 = wallUs();
+  for (int r = 0; r < reps; r++) {
+    for (uint32_t pos = 0; pos <= endQ8; pos += 167, frames++) {
+      memset(px, 0, sizeof(px));
+      wledGlyphDrawString(c, px, WLED_DISPLAY_WIDTH, WLED_DISPLAY_HEIGHT, -(int16_t)(pos >> 8), 0,
+                          kLong, 255, 255, 255);
+    }
+  }
+  const double glyphUs = (wallUs() - t0) / frames;
+  REPORT("rasterize %.2f us once; per frame: strip+blend %.2f us, glyph redraw %.2f us", rasterUs,
+         stripUs, glyphUs);
+}
+
+HOST_TEST_MAIN
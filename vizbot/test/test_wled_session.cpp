@@ -0,0 +1,188 @@
+// Whole WLED sessions against hostWled, the scripted WLED in wled_host.h:
+// a 25 FPS stream burst, a say and a scrolling say on a clean network, the
+// same on a lossy one with slow HTTP, and a WLED too slow to answer the
+// state poll at all.
+
+#include "host_test.h"
+#include "wled_host.h"
+#include <algorithm>
+
+static const char* const kLong =
+    "The quick brown fox jumps over the lazy dog, then naps 12 hours!";
+
+#define STREAM_FRAME_MS 40    // 25 FPS
+#define STREAM_HOLD_MS  100
+
+// ---- Core 1: the say and stream schedule ----
+// Runs from the main loop and from every millisecond Core 0 spends blocked
+// in a socket wait, so frames keep coming while an HTTP round trip is out.
+
+struct Say {
+  unsigned long atMs;
+  const char* text;
+  uint16_t holdMs;
+};
+
+static unsigned long t0;
+static std::vector<Say> says;
+static size_t nextSay;
+static unsigned long streamFromMs, streamToMs, nextStreamMs;
+static uint32_t streamFrames;
+
+static void core1() {
+  const unsigned long t = millis() - t0;
+  while (nextSay < says.size() && t >= says[nextSay].atMs) {
+    wledQueueText(says[nextSay].text, says[nextSay].holdMs);
+    nextSay++;
+  }
+  if (t >= streamFromMs && t < streamToMs && t >= nextStreamMs) {
+    memset(wledFrames.draft().px, (uint8_t)(streamFrames * 7 + 1), WLED_PIXEL_BYTES);
+    wledQueueFrame(STREAM_HOLD_MS);
+    streamFrames++;
+    nextStreamMs += STREAM_FRAME_MS;
+  }
+}
+
+static void begin() {
+  hostWled.attach();
+  hostNet.onWait = [] {
+    core1();
+    hostWled.service();
+  };
+  wledHostBoot();
+  t0 = millis();
+}
+
+// The Core 0 loop: a WLED pass every 2 ms until endMs. Each publish-to-send
+// latency is collected in latencyMs.
+static void run(unsigned long endMs, std::vector<unsigned long>& latencyMs) {
+  while (millis() - t0 < endMs) {
+    core1();
+    if ((millis() - t0) % 2 == 0) {
+      const uint32_t taken = wledFrames.taken;
+      const size_t sent = hostUdpSent.size();
+      wledHostPoll();
+      if (wledFrames.taken > taken && hostUdpSent.size() > sent) {
+        latencyMs.push_back(wledData.frameLatencyMs);
+      }
+    } else {
+      hostWled.service();
+    }
+    hostAdvanceMs(1);
+  }
+}
+
+static unsigned long worstOf(std::vector<unsigned long> v) {
+  return v.empty() ? 0 : *std::max_element(v.begin(), v.end());
+}
+
+// A stream burst, a short say, then a long one, each restored in turn. The
+// stream comes first so its opening frames wait on the state capture.
+#define SAY_SHORT_MS 4500
+#define SAY_LONG_MS  7500
+
+static unsigned long scriptSession() {
+  streamFromMs = nextStreamMs = 0;
+  streamToMs = 3000;
+  says = {{SAY_SHORT_MS, "HI", 2000}, {SAY_LONG_MS, kLong, 2000}};
+  return SAY_LONG_MS + wledMarqueeDurationMs(kLong, WLED_FONT_ID_5X7) + 1500;
+}
+
+TEST(clean_session) {
+  begin();
+  wledData.font = WLED_FONT_ID_5X7;
+  const unsigned long endMs = scriptSession();
+  std::vector<unsigned long> latencyMs;
+  run(endMs, latencyMs);
+
+  // Every packet arrives, in order, and is shown
+  CHECK(hostWled.packets > 100);
+  CHECK_EQ(hostWled.packets, hostUdpSent.size());
+  CHECK_EQ(hostWled.shown, hostWled.packets);
+  CHECK_EQ(hostWled.seqLost, 0);
+
+  // Every frame Core 1 published was sent, within one poll
+  CHECK_EQ(streamFrames, 3000 / STREAM_FRAME_MS);
+  CHECK_EQ(wledFrames.published, 2 + streamFrames);
+  CHECK_EQ(wledFrames.dropped, 0);
+  CHECK_EQ(wledFrames.taken, wledFrames.published);
+  CHECK_EQ(latencyMs.size(), wledFrames.taken);
+  CHECK(worstOf(latencyMs) <= 2);
+
+  // Three restores, each after its hold and before WLED's own timeout
+  CHECK_EQ(hostWled.restoreMs.size(), 3);
+  CHECK_EQ(hostWled.timeouts, 0);
+  CHECK_EQ(wledHostSpeechEnds, 3);
+  CHECK(!hostWled.live);
+  if (hostWled.restoreMs.size() == 3) {
+    CHECK_NEAR(hostWled.restoreGapMs[0], STREAM_HOLD_MS, 2);
+    CHECK_NEAR(hostWled.restoreGapMs[1], 2000, 2);
+    CHECK(hostWled.restoreMs[2] - t0 >= SAY_LONG_MS + wledMarqueeDurationMs(kLong, WLED_FONT_ID_5X7));
+    for (unsigned long gap : hostWled.restoreGapMs) CHECK(gap < WLED_HOST_REALTIME_MS);
+  }
+  CHECK_EQ(hostWled.fx, 9);
+  CHECK_EQ(hostWled.pal, 6);
+  CHECK(hostWled.name == "Main");
+  REPORT("%u frames shown, %u stream frames, worst latency %lu ms, %u GETs, %u POSTs",
+         hostWled.shown, streamFrames, worstOf(latencyMs), hostWled.gets, hostWled.posts);
+}
+
+// 10% loss, 30-50 ms display latency, 300 ms per HTTP answer: losses show up
+// as sequence gaps, Core 0 stuck in a state capture lets the stream overrun
+// the exchange, and the restores still land
+TEST(faulty_network) {
+  begin();
+  hostWled.loss = 0.1;
+  hostWled.latencyMs = 30;
+  hostWled.jitterMs = 20;
+  hostWled.httpDelayMs = 300;
+  wledData.font = WLED_FONT_ID_5X7;
+  const unsigned long endMs = scriptSession();
+  std::vector<unsigned long> latencyMs;
+  run(endMs, latencyMs);
+
+  CHECK(hostWled.injectedDrops > 0);
+  CHECK_EQ(hostWled.seqLost, hostWled.injectedDrops);
+  CHECK_EQ(hostWled.shown, hostWled.packets - hostWled.injectedDrops);
+
+  CHECK(wledFrames.dropped > 0);
+  CHECK_EQ(wledFrames.taken + wledFrames.dropped, wledFrames.published);
+  CHECK(worstOf(latencyMs) >= hostWled.httpDelayMs);
+
+  CHECK_EQ(hostWled.restoreMs.size(), 3);
+  CHECK_EQ(wledHostSpeechEnds, 3);
+  REPORT("%u of %u packets shown (%u dropped, %u seen as gaps), %u stream frames dropped in "
+         "the exchange, worst latency %lu ms, %u realtime timeouts",
+         hostWled.shown, hostWled.packets, hostWled.injectedDrops, hostWled.seqLost,
+         wledFrames.dropped, worstOf(latencyMs), hostWled.timeouts);
+}
+
+// A WLED that answers after 600 ms misses the 500 ms HTTP timeout. The
+// failed state poll starts the unreachable backoff, and that holds back DDP
+// too: nothing is shown for WLED_RETRY_BACKOFF_MS even after WLED recovers
+TEST(slow_http_backs_off_ddp) {
+  begin();
+  hostWled.httpDelayMs = 600;
+  says = {{2000, "HI", 1000}, {12000, "AGAIN", 1000}, {32000, "BACK", 1000}};
+  std::vector<unsigned long> latencyMs;
+
+  run(1500, latencyMs);
+  CHECK(!wledData.reachable);
+  const unsigned long failedAt = wledData.lastFailTime - t0;
+  CHECK(failedAt < 1500);
+
+  run(10000, latencyMs);
+  hostWled.httpDelayMs = 0;   // WLED is fine again
+  run(failedAt + WLED_RETRY_BACKOFF_MS - 1, latencyMs);
+  CHECK_EQ(wledFrames.published, 2);
+  CHECK_EQ(hostWled.packets, 0);
+  CHECK_EQ(hostWled.shown, 0);
+
+  // Past the backoff the next say goes out
+  run(34000, latencyMs);
+  CHECK_EQ(hostWled.shown, 1);
+  CHECK(wledData.reachable);
+  CHECK_EQ(hostWled.restoreMs.size(), 1);
+}
+
+HOST_TEST_MAIN
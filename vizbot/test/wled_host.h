@@ -0,0 +1,239 @@
+#ifndef WLED_HOST_H
+#define WLED_HOST_H
+
+// ============================================================================
+// One bot and its WLED, no mesh peers — for the WLED unit tests
+// ============================================================================
+// Pulls in wled_display.h and defines what the rest of the sketch links it
+// against: the WiFi object, sysStatus, and a mesh with nobody else on it, so
+// this bot arbitrates its own lease. Includes host_clock.h — include this
+// from the test file only.
+//
+// DDP frames land in hostUdpSent and wledHostDdp() turns one back into the
+// logical row-major frame. hostWled is a WLED at WLED_HOST_IP for tests that
+// want one answering; without attach() nothing listens there.
+// ============================================================================
+
+#include "config.h"
+#include "wled_display.h"
+#include "host_clock.h"
+#include <map>
+
+#define WLED_HOST_IP "192.168.1.10"
+
+HostWiFi WiFi;
+uint8_t* HostWiFi::macAddress(uint8_t* mac) {
+  static const uint8_t kMac[6] = {0x24, 0x6F, 0x28, 0x11, 0x22, 0x33};
+  memcpy(mac, kMac, 6);
+  return mac;
+}
+uint8_t* HostWiFi::softAPmacAddress(uint8_t* mac) {
+  macAddress(mac);
+  mac[5]++;
+  return mac;
+}
+
+SystemStatus sysStatus = {};
+
+// ---- A mesh with no peers ----
+
+static const uint32_t kWledHostNodeId = 0x1234;
+static bool wledHostActive = false;   // Last meshSetWledActive()
+static int wledHostSpeechEnds = 0;    // schedOnSpeechEnd() calls
+
+uint32_t meshGetNodeId() { return kWledHostNodeId; }
+uint32_t meshLowestIdForIP(uint32_t) { return WLED_LEASE_NONE; }
+bool meshPeerPresent(uint32_t) { return false; }
+bool meshSend(uint8_t, const void*, uint8_t) { return true; }
+void meshSetWledActive(bool active) { wledHostActive = active; }
+void schedOnSpeechEnd() { wledHostSpeechEnds++; }
+
+// Boot as setup() does, pointed at WLED_HOST_IP with STA up
+static void wledHostBoot() {
+  Preferences prefs;
+  prefs.begin("vizbot", false);
+  prefs.putString("wledIP", WLED_HOST_IP);
+  prefs.end();
+  sysStatus.staConnected = true;
+  loadWledSettings();
+  pollWledLease();
+}
+
+// A DDP packet's pixels back in logical row-major order
+static std::vector<uint8_t> wledHostDdp(const HostUdpPacket& pkt) {
+  std::vector<uint8_t> px(WLED_PIXEL_BYTES);
+  if (pkt.data.size() != WLED_DDP_HEADER_SIZE + WLED_PIXEL_BYTES) return {};
+  const uint8_t* in = pkt.data.data() + WLED_DDP_HEADER_SIZE;
+  for (int y = 0; y < WLED_DISPLAY_HEIGHT; y++) {
+    for (int x = 0; x < WLED_DISPLAY_WIDTH; x++) {
+      int led = y * WLED_DISPLAY_WIDTH + (WLED_DISPLAY_WIDTH - 1 - x);
+      memcpy(&px[(y * WLED_DISPLAY_WIDTH + x) * 3], in + led * 3, 3);
+    }
+  }
+  return px;
+}
+
+// ---- A WLED at WLED_HOST_IP ----
+// The C++ twin of scripts/wled-emulator.js. DDP on WLED_DDP_PORT puts it in
+// realtime mode until WLED_HOST_REALTIME_MS of silence or a POST with
+// "live":false; GET /json/state answers with seg[0] and POST applies a
+// restore. Anything else (/ws included) is a 404. The fault knobs are the
+// emulator's --loss, --latency, --jitter, --http-delay and --http-fail.
+// service() takes in the DDP sent since the last call and shows what's due;
+// wledHostPoll() runs it.
+
+#define WLED_HOST_REALTIME_MS 2500   // WLED's default realtime timeout
+
+struct HostWled {
+  // Faults
+  double loss = 0;                 // Chance a DDP packet is dropped
+  unsigned long latencyMs = 0;     // Before a packet is shown...
+  unsigned long jitterMs = 0;      // ...plus 0..jitterMs
+  unsigned long httpDelayMs = 0;   // Before every HTTP response
+  double httpFail = 0;             // Chance of a 503
+
+  // State
+  bool live = false;
+  int fx = 9, sx = 128, ix = 128, pal = 6;
+  std::string name = "Main";
+
+  // What it saw
+  uint32_t packets = 0;            // DDP packets sent to it
+  uint32_t injectedDrops = 0;
+  uint32_t seqLost = 0;            // Missing DDP sequence numbers
+  uint32_t shown = 0;
+  uint32_t gets = 0, posts = 0, failed = 0;
+  uint32_t timeouts = 0;           // Realtime ended by silence, not a restore
+  std::vector<unsigned long> shownMs;
+  std::vector<unsigned long> restoreMs;      // When each restore POST arrived
+  std::vector<unsigned long> restoreGapMs;   // ...and how long after the last frame
+  std::vector<uint8_t> px;                   // Last frame shown, logical order
+
+  bool attached = false;
+  size_t cursor = 0;
+  int lastSeq = -1;
+  unsigned long lastFrameMs = 0;
+  std::mt19937 rng{44};
+  std::multimap<unsigned long, HostUdpPacket> inFlight;   // Due time → packet
+
+  void attach() {
+    attached = true;
+    hostNet.accept = [this](const char* host, uint16_t port) -> std::shared_ptr<HostSocket> {
+      if (strcmp(host, WLED_HOST_IP) != 0 || port != 80) return nullptr;
+      auto s = std::make_shared<HostSocket>();
+      s->onSend = [this](HostSocket& s) { request(s); };
+      return s;
+    };
+  }
+
+  bool chance(double p) { return p > 0 && std::uniform_real_distribution<double>(0, 1)(rng) < p; }
+
+  void service() {
+    if (!attached) return;
+    IPAddress ip;
+    ip.fromString(WLED_HOST_IP);
+    for (; cursor < hostUdpSent.size(); cursor++) {
+      const HostUdpPacket& p = hostUdpSent[cursor];
+      if ((uint32_t)p.ip != (uint32_t)ip || p.port != WLED_DDP_PORT) continue;
+      packets++;
+      if (chance(loss)) {
+        injectedDrops++;
+        continue;
+      }
+      int seq = p.data.size() > 1 ? p.data[1] & 0x0F : 0;
+      if (lastSeq >= 0) seqLost += (seq - lastSeq - 1) & 0x0F;
+      lastSeq = seq;
+      unsigned long due = p.atMs + latencyMs + (jitterMs ? rng() % (jitterMs + 1) : 0);
+      inFlight.emplace(due, p);
+    }
+    while (!inFlight.empty() && inFlight.begin()->first <= millis()) {
+      px = wledHostDdp(inFlight.begin()->second);
+      lastFrameMs = inFlight.begin()->first;
+      shownMs.push_back(lastFrameMs);
+      shown++;
+      live = true;
+      inFlight.erase(inFlight.begin());
+    }
+    if (live && millis() - lastFrameMs >= WLED_HOST_REALTIME_MS) {
+      live = false;
+      timeouts++;
+    }
+  }
+
+  static bool field(const std::string& json, const char* key, int& v) {
+    size_t at = json.find(std::string("\"") + key + "\":");
+    if (at == std::string::npos) return false;
+    v = atoi(json.c_str() + at + strlen(key) + 3);
+    return true;
+  }
+
+  void apply(const std::string& body) {
+    field(body, "fx", fx);
+    field(body, "sx", sx);
+    field(body, "ix", ix);
+    field(body, "pal", pal);
+    size_t n = body.find("\"n\":\"");
+    if (n != std::string::npos) name = body.substr(n + 5, body.find('"', n + 5) - n - 5);
+    if (body.find("\"live\":false") != std::string::npos) {
+      restoreMs.push_back(millis());
+      restoreGapMs.push_back(millis() - lastFrameMs);
+      live = false;
+    }
+  }
+
+  std::string stateJson() const {
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+             "{\"on\":true,\"bri\":128,\"transition\":7,\"ps\":-1,\"live\":%s,\"seg\":[{\"id\":0,"
+             "\"start\":0,\"stop\":%d,\"fx\":%d,\"sx\":%d,\"ix\":%d,\"pal\":%d,\"n\":\"%s\"}]}",
+             live ? "true" : "false", WLED_DISPLAY_WIDTH * WLED_DISPLAY_HEIGHT, fx, sx, ix, pal,
+             name.c_str());
+    return buf;
+  }
+
+  // Answer once the whole request (headers + Content-Length body) is in
+  void request(HostSocket& s) {
+    size_t end = s.tx.find("\r\n\r\n");
+    if (end == std::string::npos) return;
+    size_t len = 0, cl = s.tx.find("Content-Length: ");
+    if (cl != std::string::npos && cl < end) len = atoi(s.tx.c_str() + cl + 16);
+    if (s.tx.size() < end + 4 + len) return;
+    const std::string head = s.tx.substr(0, end), body = s.tx.substr(end + 4, len);
+    s.tx.erase(0, end + 4 + len);
+
+    const char* status = "404 Not Found";
+    std::string reply;
+    if (chance(httpFail)) {
+      status = "503 Service Unavailable";
+      failed++;
+    } else if (head.rfind("GET /json/state ", 0) == 0) {
+      status = "200 OK";
+      reply = stateJson();
+      gets++;
+    } else if (head.rfind("POST /json/state ", 0) == 0) {
+      status = "200 OK";
+      apply(body);
+      reply = "{\"success\":true}";
+      posts++;
+    }
+    char hdr[160];
+    snprintf(hdr, sizeof(hdr),
+             "HTTP/1.1 %s\r\nContent-Type: application/json\r\nContent-Length: %zu\r\n"
+             "Connection: close\r\n\r\n",
+             status, reply.size());
+    s.later = hdr + reply;
+    s.laterAtUs = micros() + (int64_t)httpDelayMs * 1000;
+    s.closeAfterLater = true;
+  }
+};
+static HostWled hostWled;
+
+// One pass of the Core 0 WiFi task's WLED work, then whatever WLED has
+// received by now
+static void wledHostPoll() {
+  pollWledLease();
+  pollWledDisplay();
+  hostWled.service();
+}
+
+#endif // WLED_HOST_H
@@ -0,0 +1,725 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <time.h>
+#include "config.h"
+#include "system_status.h"
+
+// ============================================================================
+// Timeline — one ordered queue for everything that happens at a set time
+// ============================================================================
+// Cloud commands with an execute_at, the steps of the WLED content cycle and
+// recurring rules all go through a single min-heap keyed on (due, seq):
+//   - events fire in due order, and events due at the same moment fire in
+//     the order they were added, whichever subsystem added them
+//   - a handler that can't run yet (speech has the WLED, another bot owns
+//     the schedule) returns false and its event is retried
+//     TIMELINE_RETRY_MS later; anything else due meanwhile goes first
+//   - at most TIMELINE_FIRE_PER_POLL events run per Core 0 pass
+// Adding or firing an event is O(log n), so a few hundred pending items cost
+// nothing per pass. Cancelling is a linear filter — it's rare.
+//
+// The clock is milliseconds since boot, widened to 64 bits. Items anchored
+// to wall-clock time (cloud execute_at, cron rules) are mapped onto it once
+// NTP has synced; until then they wait, parked.
+//
+// Rules repeat an action either every N ms (uptime, no NTP needed) or on a
+// cron expression — "min hour day-of-month month day-of-week", with *, lists,
+// ranges and /steps — evaluated in UTC plus the rule's offset. When both day
+// fields are restricted either one matches, as in cron.
+//
+// Stored commands (one-shot cloud commands and cron rules carrying one) are
+// saved to TIMELINE_PATH on LittleFS and reloaded at boot. A one-shot
+// command that came due while the bot was off still runs if it's less than
+// TIMELINE_LATE_GRACE_S late. Local rules (the content cycle) aren't saved
+// — their owner rebuilds them from its NVS settings.
+//
+// Core 0 only: every call here comes from the WiFi task.
+// ============================================================================
+
+#define TIMELINE_MAX_EVENTS        32     // Heap in internal RAM
+#define TIMELINE_MAX_EVENTS_PSRAM  512    // Heap when PSRAM is present
+#define TIMELINE_MAX_CMDS          8      // Stored commands in internal RAM
+#define TIMELINE_MAX_CMDS_PSRAM    128    // Stored commands when PSRAM is present
+#define TIMELINE_MAX_RULES         8
+#define TIMELINE_RETRY_MS          250    // A deferred event tries again this much later
+#define TIMELINE_FIRE_PER_POLL     4
+#define TIMELINE_LATE_GRACE_S      600    // Missed-while-off commands later than this are dropped
+#define TIMELINE_SAVE_DELAY_MS     2000   // Changes are batched into one write
+#define TIMELINE_PATH              "/timeline.bin"
+#define TIMELINE_FILE_VERSION      1
+
+#define TIMELINE_ID_LEN            48
+#define TIMELINE_TYPE_LEN          20
+#define TIMELINE_PAYLOAD_LEN       128
+#define TIMELINE_CRON_LEN          32
+#define TIMELINE_NONE              0xFFFF
+
+// Event kinds — one handler each
+enum TimelineKind : uint8_t {
+  TL_NONE = 0,
+  TL_CONTENT,      // WLED content cycle step (arg = step)
+  TL_COMMAND,      // Stored command (cloud_client.h dispatches it)
+  TL_KIND_COUNT
+};
+
+// A stored command: what a cloud command or a rule carrying one will run
+struct TimelineCmd {
+  char id[TIMELINE_ID_LEN];
+  char type[TIMELINE_TYPE_LEN];
+  char payload[TIMELINE_PAYLOAD_LEN];   // JSON object text
+  uint32_t epoch;                       // One-shot due time (UTC), 0 = owned by a rule
+  bool used;
+  bool queued;                          // On the heap; false = parked until NTP
+};
+
+// Returns false to have the event retried TIMELINE_RETRY_MS later
+typedef bool (*TimelineHandler)(uint8_t arg, const TimelineCmd* cmd);
+
+struct TimelineEvent {
+  uint64_t dueMs;
+  uint32_t seq;
+  uint8_t kind;
+  uint8_t arg;
+  uint8_t rule;                         // Rule that made it, 0xFF = none
+  uint8_t reserved;
+  uint16_t cmd;                         // Command slot, TIMELINE_NONE = none
+};
+
+struct TimelineCron {
+  uint64_t minutes;                     // Bit per minute, 0-59
+  uint32_t hours;                       // Bit per hour, 0-23
+  uint32_t days;                        // Bit per day of month, 1-31
+  uint16_t months;                      // Bit per month, 1-12
+  uint8_t weekdays;                     // Bit per day of week, Sunday = 0
+  bool anyDay;                          // Day-of-month field was *
+  bool anyWeekday;                      // Day-of-week field was *
+};
+
+struct TimelineRule {
+  uint8_t kind;                         // TL_NONE = free slot
+  uint8_t arg;
+  uint16_t cmd;                         // Command slot it runs, TIMELINE_NONE = none
+  uint32_t everyMs;                     // Interval rule; 0 = cron rule
+  int16_t utcOffsetMin;                 // Cron is evaluated at UTC + this
+  bool queued;                          // Next occurrence is on the heap
+  TimelineCron cron;
+  char cronText[TIMELINE_CRON_LEN];
+};
+
+static TimelineEvent timelineHeapInternal[TIMELINE_MAX_EVENTS];
+static TimelineCmd   timelineCmdsInternal[TIMELINE_MAX_CMDS];
+
+static struct {
+  TimelineEvent* heap;
+  uint16_t heapSize;
+  uint16_t heapCapacity;
+  TimelineCmd* cmds;
+  uint16_t cmdCapacity;
+  TimelineRule rules[TIMELINE_MAX_RULES];
+  TimelineHandler handlers[TL_KIND_COUNT];
+  uint32_t seq;
+
+  // Clock
+  uint32_t lastMillis;
+  uint32_t millisHigh;
+
+  bool parked;                          // Something waits for NTP
+
+  // Persistence
+  bool dirty;
+  unsigned long dirtySinceMs;
+
+  // Stats
+  uint32_t fired;
+  uint32_t deferred;
+  uint32_t dropped;                     // Missed commands, or no room
+  uint16_t maxDepth;
+} timeline = { timelineHeapInternal, 0, TIMELINE_MAX_EVENTS, timelineCmdsInternal, TIMELINE_MAX_CMDS };
+
+// ============================================================================
+// Clock
+// ============================================================================
+
+// millis() widened to 64 bits — called at least once a pass, so no wrap is missed
+uint64_t timelineNowMs() {
+  uint32_t m = millis();
+  if (m < timeline.lastMillis) timeline.millisHigh++;
+  timeline.lastMillis = m;
+  return ((uint64_t)timeline.millisHigh << 32) | m;
+}
+
+// Wall-clock time to timeline time; the past maps to now. Needs NTP.
+static uint64_t timelineEpochToMs(uint32_t epoch) {
+  uint64_t nowMs = timelineNowMs();
+  int64_t aheadS = (int64_t)epoch - (int64_t)time(nullptr);
+  return aheadS > 0 ? nowMs + (uint64_t)aheadS * 1000 : nowMs;
+}
+
+// ============================================================================
+// Heap
+// ============================================================================
+
+static bool timelineBefore(const TimelineEvent& a, const TimelineEvent& b) {
+  if (a.dueMs != b.dueMs) return a.dueMs < b.dueMs;
+  return (int32_t)(a.seq - b.seq) < 0;
+}
+
+static void timelineSiftUp(uint16_t i) {
+  TimelineEvent* h = timeline.heap;
+  TimelineEvent e = h[i];
+  while (i > 0) {
+    uint16_t parent = (i - 1) / 2;
+    if (!timelineBefore(e, h[parent])) break;
+    h[i] = h[parent];
+    i = parent;
+  }
+  h[i] = e;
+}
+
+static void timelineSiftDown(uint16_t i) {
+  TimelineEvent* h = timeline.heap;
+  uint16_t n = timeline.heapSize;
+  TimelineEvent e = h[i];
+  for (;;) {
+    uint16_t child = i * 2 + 1;
+    if (child >= n) break;
+    if (child + 1 < n && timelineBefore(h[child + 1], h[child])) child++;
+    if (!timelineBefore(h[child], e)) break;
+    h[i] = h[child];
+    i = child;
+  }
+  h[i] = e;
+}
+
+static bool timelinePush(const TimelineEvent& e) {
+  if (timeline.heapSize >= timeline.heapCapacity) return false;
+  timeline.heap[timeline.heapSize] = e;
+  timelineSiftUp(timeline.heapSize++);
+  if (timeline.heapSize > timeline.maxDepth) timeline.maxDepth = timeline.heapSize;
+  return true;
+}
+
+static TimelineEvent timelinePop() {
+  TimelineEvent top = timeline.heap[0];
+  timeline.heap[0] = timeline.heap[--timeline.heapSize];
+  if (timeline.heapSize) timelineSiftDown(0);
+  return top;
+}
+
+static bool timelineQueue(uint64_t dueMs, uint8_t kind, uint8_t arg, uint8_t rule, uint16_t cmd) {
+  TimelineEvent e = {};
+  e.dueMs = dueMs;
+  e.seq = timeline.seq++;
+  e.kind = kind;
+  e.arg = arg;
+  e.rule = rule;
+  e.cmd = cmd;
+  return timelinePush(e);
+}
+
+// Drop every queued event that matches, then restore the heap order
+template <typename Pred>
+static void timelineRemoveIf(Pred match) {
+  uint16_t n = 0;
+  for (uint16_t i = 0; i < timeline.heapSize; i++) {
+    if (!match(timeline.heap[i])) timeline.heap[n++] = timeline.heap[i];
+  }
+  timeline.heapSize = n;
+  for (int i = n / 2 - 1; i >= 0; i--) timelineSiftDown(i);
+}
+
+// ============================================================================
+// Cron
+// ============================================================================
+
+// One field: "*", "*/n", "a", "a-b", "a-b/n", comma-separated
+static bool timelineCronField(const char*& s, uint8_t lo, uint8_t hi, uint64_t& bits, bool& any) {
+  bits = 0;
+  any = false;
+  for (;;) {
+    int from, to, step = 1;
+    if (*s == '*') {
+      s++;
+      from = lo;
+      to = hi;
+      any = true;
+    } else {
+      if (*s < '0' || *s > '9') return false;
+      from = strtol(s, (char**)&s, 10);
+      to = from;
+      if (*s == '-') {
+        s++;
+        if (*s < '0' || *s > '9') return false;
+        to = strtol(s, (char**)&s, 10);
+      }
+    }
+    if (*s == '/') {
+      s++;
+      step = strtol(s, (char**)&s, 10);
+      if (step < 1) return false;
+      if (from == to && !any) to = hi;   // "a/n" = a, a+n, ... as in cron
+      any = false;
+    }
+    if (from < lo || to > hi || from > to) return false;
+    for (int v = from; v <= to; v += step) bits |= 1ULL << v;
+    if (*s != ',') break;
+    s++;
+    any = false;
+  }
+  return *s == ' ' || *s == '\t' || *s == '\0';
+}
+
+bool timelineCronParse(const char* text, TimelineCron& c) {
+  const char* s = text;
+  uint64_t bits[5];
+  bool any[5];
+  static const uint8_t lo[5] = { 0, 0, 1, 1, 0 };
+  static const uint8_t hi[5] = { 59, 23, 31, 12, 7 };
+  for (uint8_t f = 0; f < 5; f++) {
+    while (*s == ' ' || *s == '\t') s++;
+    if (!timelineCronField(s, lo[f], hi[f], bits[f], any[f])) return false;
+  }
+  while (*s == ' ' || *s == '\t') s++;
+  if (*s) return false;
+  c.minutes = bits[0];
+  c.hours = (uint32_t)bits[1];
+  c.days = (uint32_t)bits[2];
+  c.months = (uint16_t)bits[3];
+  c.weekdays = (uint8_t)((bits[4] | (bits[4] >> 7)) & 0x7F);   // 7 is Sunday too
+  c.anyDay = any[2];
+  c.anyWeekday = any[4];
+  return true;
+}
+
+static bool timelineCronDayMatches(const TimelineCron& c, const struct tm& t) {
+  if (!(c.months & (1 << (t.tm_mon + 1)))) return false;
+  bool dom = c.days & (1UL << t.tm_mday);
+  bool dow = c.weekdays & (1 << t.tm_wday);
+  if (c.anyDay) return dow;
+  if (c.anyWeekday) return dom;
+  return dom || dow;
+}
+
+// First matching minute strictly after `after`, 0 if none within ~5 years
+uint32_t timelineCronNext(const TimelineCron& c, int16_t utcOffsetMin, uint32_t after) {
+  int32_t offsetS = (int32_t)utcOffsetMin * 60;
+  time_t t = (time_t)after + offsetS;
+  t = t - t % 60 + 60;
+  for (uint16_t guard = 0; guard < 2000; ) {
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    if (!timelineCronDayMatches(c, tm)) {
+      t += (time_t)(24 * 3600 - tm.tm_hour * 3600 - tm.tm_min * 60);   // Next midnight
+      guard++;
+      continue;
+    }
+    if (!(c.hours & (1UL << tm.tm_hour))) {
+      t += (time_t)(3600 - tm.tm_min * 60);                            // Next hour
+      continue;
+    }
+    if (!(c.minutes & (1ULL << tm.tm_min))) {
+      t += 60;
+      continue;
+    }
+    return (uint32_t)(t - offsetS);
+  }
+  return 0;
+}
+
+// ============================================================================
+// Stored commands and rules
+// ============================================================================
+
+static void timelineMarkDirty() {
+  if (!timeline.dirty) timeline.dirtySinceMs = millis();
+  timeline.dirty = true;
+}
+
+static uint16_t timelineAllocCmd(const char* id, const char* type, const char* payload) {
+  for (uint16_t i = 0; i < timeline.cmdCapacity; i++) {
+    TimelineCmd& c = timeline.cmds[i];
+    if (c.used) continue;
+    c = {};
+    strncpy(c.id, id, sizeof(c.id) - 1);
+    strncpy(c.type, type, sizeof(c.type) - 1);
+    strncpy(c.payload, payload, sizeof(c.payload) - 1);
+    c.used = true;
+    return i;
+  }
+  return TIMELINE_NONE;
+}
+
+// Put a rule's next occurrence on the heap. Cron rules wait for NTP.
+static void timelineQueueRule(uint8_t r, uint64_t firstDueMs) {
+  TimelineRule& rule = timeline.rules[r];
+  uint64_t due;
+  if (rule.everyMs) {
+    due = firstDueMs;
+  } else {
+    if (!sysStatus.ntpSynced) {
+      timeline.parked = true;
+      return;
+    }
+    uint32_t next = timelineCronNext(rule.cron, rule.utcOffsetMin, (uint32_t)time(nullptr));
+    if (!next) return;
+    due = timelineEpochToMs(next);
+  }
+  rule.queued = timelineQueue(due, rule.kind, rule.arg, r, rule.cmd);
+  if (!rule.queued) timeline.dropped++;
+}
+
+static void timelineQueueCmd(uint16_t slot) {
+  TimelineCmd& c = timeline.cmds[slot];
+  c.queued = timelineQueue(timelineEpochToMs(c.epoch), TL_COMMAND, 0, 0xFF, slot);
+  if (!c.queued) timeline.dropped++;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void timelineRegister(uint8_t kind, TimelineHandler handler) {
+  if (kind < TL_KIND_COUNT) timeline.handlers[kind] = handler;
+}
+
+// One-shot local event, delayMs from now. Not saved.
+bool timelineAfter(uint32_t delayMs, uint8_t kind, uint8_t arg) {
+  bool ok = timelineQueue(timelineNowMs() + delayMs, kind, arg, 0xFF, TIMELINE_NONE);
+  if (!ok) timeline.dropped++;
+  return ok;
+}
+
+// One-shot command at a UTC time. Saved, and parked until NTP if need be.
+bool timelineAddCommand(const char* id, const char* type, const char* payload, uint32_t epoch) {
+  uint16_t slot = timelineAllocCmd(id, type, payload);
+  if (slot == TIMELINE_NONE) return false;
+  timeline.cmds[slot].epoch = epoch;
+  if (sysStatus.ntpSynced) {
+    timelineQueueCmd(slot);
+    if (!timeline.cmds[slot].queued) {
+      timeline.cmds[slot].used = false;
+      return false;
+    }
+  } else {
+    timeline.parked = true;
+  }
+  timelineMarkDirty();
+  return true;
+}
+
+// Repeat a local event every everyMs, the first firstDelayMs from now.
+// Returns the rule index, or -1 if the rule table is full.
+int8_t timelineEvery(uint32_t everyMs, uint32_t firstDelayMs, uint8_t kind, uint8_t arg) {
+  if (!everyMs) return -1;
+  for (uint8_t r = 0; r < TIMELINE_MAX_RULES; r++) {
+    TimelineRule& rule = timeline.rules[r];
+    if (rule.kind != TL_NONE) continue;
+    rule = {};
+    rule.kind = kind;
+    rule.arg = arg;
+    rule.cmd = TIMELINE_NONE;
+    rule.everyMs = everyMs;
+    timelineQueueRule(r, timelineNowMs() + firstDelayMs);
+    return r;
+  }
+  return -1;
+}
+
+// Repeat on a cron expression. With a command (id/type/payload) the rule is
+// saved and runs that command; without one it fires kind/arg locally.
+// Returns the rule index, or -1 for a bad expression or no room.
+int8_t timelineCron(const char* cron, int16_t utcOffsetMin, uint8_t kind, uint8_t arg,
+                    const char* id = nullptr, const char* type = nullptr,
+                    const char* payload = nullptr) {
+  TimelineCron c;
+  if (strlen(cron) >= TIMELINE_CRON_LEN || !timelineCronParse(cron, c)) return -1;
+  if (!timelineCronNext(c, 0, 1704067200)) return -1;   // Never matches (Feb 30, ...)
+  for (uint8_t r = 0; r < TIMELINE_MAX_RULES; r++) {
+    TimelineRule& rule = timeline.rules[r];
+    if (rule.kind != TL_NONE) continue;
+    uint16_t slot = TIMELINE_NONE;
+    if (id) {
+      slot = timelineAllocCmd(id, type, payload ? payload : "{}");
+      if (slot == TIMELINE_NONE) return -1;
+      timelineMarkDirty();
+    }
+    rule = {};
+    rule.kind = kind;
+    rule.arg = arg;
+    rule.cmd = slot;
+    rule.utcOffsetMin = utcOffsetMin;
+    rule.cron = c;
+    strcpy(rule.cronText, cron);
+    timelineQueueRule(r, 0);
+    return r;
+  }
+  return -1;
+}
+
+// Remove local rules and pending events of a kind (rules carrying a stored
+// command are left alone — cancel those by id)
+void timelineCancel(uint8_t kind) {
+  for (uint8_t r = 0; r < TIMELINE_MAX_RULES; r++) {
+    if (timeline.rules[r].kind == kind && timeline.rules[r].cmd == TIMELINE_NONE) {
+      timeline.rules[r].kind = TL_NONE;
+    }
+  }
+  timelineRemoveIf([kind](const TimelineEvent& e) { return e.kind == kind && e.cmd == TIMELINE_NONE; });
+}
+
+// Remove the stored command (one-shot or rule) with this id
+bool timelineCancelId(const char* id) {
+  bool found = false;
+  for (uint16_t i = 0; i < timeline.cmdCapacity; i++) {
+    TimelineCmd& c = timeline.cmds[i];
+    if (!c.used || strcmp(c.id, id) != 0) continue;
+    for (uint8_t r = 0; r < TIMELINE_MAX_RULES; r++) {
+      if (timeline.rules[r].kind != TL_NONE && timeline.rules[r].cmd == i) timeline.rules[r].kind = TL_NONE;
+    }
+    timelineRemoveIf([i](const TimelineEvent& e) { return e.cmd == i; });
+    c.used = false;
+    found = true;
+  }
+  if (found) timelineMarkDirty();
+  return found;
+}
+
+// ============================================================================
+// Persistence
+// ============================================================================
+// File: header, then one record per stored command — the command itself plus
+// the cron rule that owns it, if any.
+
+struct TimelineFileHeader {
+  char magic[2];                        // 'T' 'L'
+  uint8_t version;                      // TIMELINE_FILE_VERSION
+  uint8_t reserved;
+  uint16_t count;
+  uint16_t recordSize;
+};
+
+struct TimelineFileRecord {
+  TimelineCmd cmd;                      // epoch 0 = cron rule below
+  uint8_t kind;
+  uint8_t arg;
+  int16_t utcOffsetMin;
+  char cron[TIMELINE_CRON_LEN];
+};
+
+static void timelineSave() {
+  timeline.dirty = false;
+  if (!sysStatus.littlefsReady) return;
+  TimelineFileHeader hdr = {};
+  hdr.magic[0] = 'T';
+  hdr.magic[1] = 'L';
+  hdr.version = TIMELINE_FILE_VERSION;
+  hdr.recordSize = sizeof(TimelineFileRecord);
+  for (uint16_t i = 0; i < timeline.cmdCapacity; i++) {
+    if (timeline.cmds[i].used) hdr.count++;
+  }
+
+  // Write aside and rename, so a reset mid-write leaves the old file intact
+  File f = LittleFS.open(TIMELINE_PATH ".tmp", "w");
+  if (!f) return;
+  bool ok = f.write((const uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr);
+  for (uint16_t i = 0; ok && i < timeline.cmdCapacity; i++) {
+    if (!timeline.cmds[i].used) continue;
+    TimelineFileRecord rec = {};
+    rec.cmd = timeline.cmds[i];
+    rec.kind = TL_COMMAND;
+    for (uint8_t r = 0; r < TIMELINE_MAX_RULES; r++) {
+      const TimelineRule& rule = timeline.rules[r];
+      if (rule.kind == TL_NONE || rule.cmd != i) continue;
+      rec.kind = rule.kind;
+      rec.arg = rule.arg;
+      rec.utcOffsetMin = rule.utcOffsetMin;
+      strcpy(rec.cron, rule.cronText);
+    }
+    ok = f.write((const uint8_t*)&rec, sizeof(rec)) == sizeof(rec);
+  }
+  f.close();
+  if (ok) ok = LittleFS.rename(TIMELINE_PATH ".tmp", TIMELINE_PATH);
+  if (!ok) LittleFS.remove(TIMELINE_PATH ".tmp");
+  DBG("Timeline: saved ");
+  DBG(hdr.count);
+  DBGLN(ok ? " commands" : " commands — write failed");
+}
+
+// Boot: size the tables and read back saved commands. Call once, after
+// LittleFS is mounted and before anything is scheduled.
+void timelineLoad() {
+  if (sysStatus.psramAvailable && timeline.heap == timelineHeapInternal) {
+    TimelineEvent* heap = (TimelineEvent*)heap_caps_calloc(TIMELINE_MAX_EVENTS_PSRAM, sizeof(TimelineEvent),
+                                                           MALLOC_CAP_SPIRAM);
+    TimelineCmd* cmds = (TimelineCmd*)heap_caps_calloc(TIMELINE_MAX_CMDS_PSRAM, sizeof(TimelineCmd),
+                                                       MALLOC_CAP_SPIRAM);
+    if (heap && cmds) {
+      timeline.heap = heap;
+      timeline.heapCapacity = TIMELINE_MAX_EVENTS_PSRAM;
+      timeline.cmds = cmds;
+      timeline.cmdCapacity = TIMELINE_MAX_CMDS_PSRAM;
+    } else {
+      free(heap);
+      free(cmds);
+    }
+  }
+
+  if (!sysStatus.littlefsReady) return;
+  File f = LittleFS.open(TIMELINE_PATH, "r");
+  if (!f) return;
+  TimelineFileHeader hdr;
+  bool ok = f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr) &&
+            hdr.magic[0] == 'T' && hdr.magic[1] == 'L' &&
+            hdr.version == TIMELINE_FILE_VERSION &&
+            hdr.recordSize == sizeof(TimelineFileRecord);
+  uint16_t loaded = 0;
+  for (uint16_t i = 0; ok && i < hdr.count; i++) {
+    TimelineFileRecord rec;
+    if (f.read((uint8_t*)&rec, sizeof(rec)) != sizeof(rec)) break;
+    rec.cmd.id[sizeof(rec.cmd.id) - 1] = '\0';
+    rec.cmd.type[sizeof(rec.cmd.type) - 1] = '\0';
+    rec.cmd.payload[sizeof(rec.cmd.payload) - 1] = '\0';
+    rec.cron[sizeof(rec.cron) - 1] = '\0';
+    bool added;
+    if (rec.cmd.epoch) {
+      // Parked: the next poll with NTP queues it, or drops it if it's too late
+      uint16_t slot = timelineAllocCmd(rec.cmd.id, rec.cmd.type, rec.cmd.payload);
+      added = slot != TIMELINE_NONE;
+      if (added) timeline.cmds[slot].epoch = rec.cmd.epoch;
+      timeline.parked = true;
+    } else {
+      added = timelineCron(rec.cron, rec.utcOffsetMin, rec.kind, rec.arg,
+                           rec.cmd.id, rec.cmd.type, rec.cmd.payload) >= 0;
+    }
+    if (added) loaded++;
+  }
+  f.close();
+  timeline.dirty = false;               // What's in memory is what's on disk
+  DBG("Timeline: loaded ");
+  DBG(loaded);
+  DBGLN(" commands");
+}
+
+// ============================================================================
+// Main Poll — called from task_manager.h (Core 0)
+// ============================================================================
+
+void pollTimeline() {
+  uint64_t nowMs = timelineNowMs();
+
+  // NTP just became available: anchor parked commands and cron rules
+  if (timeline.parked && sysStatus.ntpSynced) {
+    timeline.parked = false;
+    uint32_t nowEpoch = (uint32_t)time(nullptr);
+    for (uint16_t i = 0; i < timeline.cmdCapacity; i++) {
+      TimelineCmd& c = timeline.cmds[i];
+      if (!c.used || c.queued || !c.epoch) continue;
+      if (c.epoch + TIMELINE_LATE_GRACE_S < nowEpoch) {
+        DBG("Timeline: dropped missed command ");
+        DBGLN(c.id);
+        c.used = false;
+        timeline.dropped++;
+        timelineMarkDirty();
+        continue;
+      }
+      timelineQueueCmd(i);
+    }
+    for (uint8_t r = 0; r < TIMELINE_MAX_RULES; r++) {
+      const TimelineRule& rule = timeline.rules[r];
+      if (rule.kind != TL_NONE && !rule.queued && !rule.everyMs) timelineQueueRule(r, 0);
+    }
+  }
+
+  for (uint8_t n = 0; n < TIMELINE_FIRE_PER_POLL; n++) {
+    if (!timeline.heapSize || timeline.heap[0].dueMs > nowMs) break;
+    TimelineEvent e = timelinePop();
+    const TimelineCmd* cmd = e.cmd != TIMELINE_NONE ? &timeline.cmds[e.cmd] : nullptr;
+    TimelineHandler h = e.kind < TL_KIND_COUNT ? timeline.handlers[e.kind] : nullptr;
+
+    // A one-shot command comes off the store, on disk too, before it runs —
+    // if it reboots the bot it mustn't run again at boot. So it can't defer.
+    TimelineCmd oneShot;
+    bool taken = cmd && e.rule == 0xFF;
+    if (taken) {
+      oneShot = *cmd;
+      cmd = &oneShot;
+      timeline.cmds[e.cmd].used = false;
+      timelineSave();
+    }
+
+    if (h && !h(e.arg, cmd) && !taken) {
+      e.dueMs = nowMs + TIMELINE_RETRY_MS;   // Keeps its seq
+      timelinePush(e);
+      timeline.deferred++;
+      continue;
+    }
+    timeline.fired++;
+
+    if (e.rule != 0xFF) {
+      TimelineRule& rule = timeline.rules[e.rule];
+      rule.queued = false;
+      if (rule.kind != TL_NONE) timelineQueueRule(e.rule, nowMs + rule.everyMs);
+    }
+  }
+
+  if (timeline.dirty && millis() - timeline.dirtySinceMs >= TIMELINE_SAVE_DELAY_MS) {
+    timelineSave();
+  }
+}
+
+// For /api/schedule
+String getTimelineStatusJson() {
+  uint16_t cmds = 0, parked = 0;
+  for (uint16_t i = 0; i < timeline.cmdCapacity; i++) {
+    if (!timeline.cmds[i].used) continue;
+    cmds++;
+    if (timeline.cmds[i].epoch && !timeline.cmds[i].queued) parked++;
+  }
+  String json = "{\"events\":";
+  json += timeline.heapSize;
+  json += ",\"capacity\":";
+  json += timeline.heapCapacity;
+  json += ",\"commands\":";
+  json += cmds;
+  json += ",\"parked\":";
+  json += parked;
+  json += ",\"rules\":[";
+  bool first = true;
+  for (uint8_t r = 0; r < TIMELINE_MAX_RULES; r++) {
+    const TimelineRule& rule = timeline.rules[r];
+    if (rule.kind == TL_NONE) continue;
+    if (!first) json += ",";
+    first = false;
+    json += "{\"kind\":";
+    json += rule.kind;
+    if (rule.everyMs) {
+      json += ",\"everyS\":";
+      json += rule.everyMs / 1000;
+    } else {
+      json += ",\"cron\":\"";
+      json += rule.cronText;
+      json += "\"";
+    }
+    if (rule.cmd != TIMELINE_NONE) {
+      json += ",\"id\":\"";
+      json += timeline.cmds[rule.cmd].id;
+      json += "\"";
+    }
+    json += "}";
+  }
+  json += "],\"fired\":";
+  json += timeline.fired;
+  json += ",\"deferred\":";
+  json += timeline.deferred;
+  json += ",\"dropped\":";
+  json += timeline.dropped;
+  json += ",\"maxDepth\":";
+  json += timeline.maxDepth;
+  json += "}";
+  return json;
+}
+
+#endif // TIMELINE_H
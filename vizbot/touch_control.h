@@ -92,14 +92,9 @@ extern uint8_t getBotBackgroundStyle();
 extern bool wifiEnabled;
 extern void toggleWifiAP();
 
-// Ambient effect names (for background overlay control)
-const char* ambientEffectNames[] = {
-  "Plasma", "Rainbow", "Fire", "Ocean", "Sparkle",
-  "Matrix", "Lava", "Aurora", "Confetti", "Comet",
-  "Galaxy", "Heart", "Donut"
-};
+// Effect names come from the vizfx registry (ambientEffects[].name)
 
-// Palette names (must match order in palettes.h)
+// Palette names (must match order in vizfx_palettes.h)
 const char* paletteNames[] = {
   "Rainbow", "Ocean", "Lava", "Forest", "Party",
   "Heat", "Cloud", "Sunset", "Cyber", "Toxic",
@@ -263,7 +258,7 @@ void drawMenuHeader() {
   gfx->setCursor(4, 18);
   gfx->setTextColor(0xFFFF);
   if (getBotBackgroundStyle() == 4) {
-    gfx->print(ambientEffectNames[effectIndex % NUM_AMBIENT_EFFECTS]);
+    gfx->print(ambientEffects[effectIndex % NUM_AMBIENT_EFFECTS].name);
   } else {
     gfx->print("Black");
   }
@@ -287,7 +282,7 @@ void drawMenuHeader() {
   gfx->setCursor(10, 24);
   gfx->setTextColor(0xFFFF);
   if (getBotBackgroundStyle() == 4) {
-    gfx->print(ambientEffectNames[effectIndex % NUM_AMBIENT_EFFECTS]);
+    gfx->print(ambientEffects[effectIndex % NUM_AMBIENT_EFFECTS].name);
   } else {
     gfx->print("Black");
   }
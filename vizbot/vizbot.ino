@@ -33,13 +33,14 @@
 
 #include "config.h"
 #include "device_id.h"  // Per-device unique SSID + mDNS hostname (from eFuse MAC)
-#include "palettes.h"
 #include "display_lcd.h"    // Must come before any file that calls gfx->methods() (defines DisplayProxy)
 #include "tween.h"          // Tween animation system (must come before bot_mode.h)
-#include "effects_ambient.h"
+#include <vizfx.h>          // Canvas, palettes, sprites, ambient effects (lib/vizfx)
 #ifdef TARGET_CORES3
 #include "midi_synth.h"     // SAM2695 MIDI synth driver (must come before bot_sounds.h)
 #include "bot_sounds.h"     // MIDI sequence engine + M5.Speaker fallback (must come before bot_mode.h)
+#include "soft_synth.h"     // Polyphonic speaker synth for the no-SAM2695 fallback
+#include "midi_scheduler.h" // esp_timer MIDI event scheduler + UART TX task (SAM2695)
 #include "audio_analysis.h" // Core S3 mic audio analysis
 #include "proximity_light.h" // Core S3 proximity & ambient light sensor
 #endif
@@ -47,7 +48,9 @@
 #include "info_mode.h"
 #include "wled_display.h"
 #include "wled_weather_view.h"
+#include "timeline.h"       // Time-ordered events + rules (must come before wled_scheduled_content.h)
 #include "wled_scheduled_content.h"
+#include "anim_player.h"    // GIF playback (after info_mode.h and wled_display.h)
 #ifdef CLOUD_ENABLED
 #include <ArduinoJson.h>
 #include "content_cache.h"
@@ -349,7 +352,13 @@ void setup() {
 
   // Load WLED display settings from NVS
   loadWledSettings();
+
+  // Timeline: saved scheduled commands from LittleFS, then the content cycle rule
+  timelineLoad();
   loadScheduleSettings();
+  #ifdef CLOUD_ENABLED
+  initCloudSchedule();
+  #endif
 
   // Apply loaded settings to hardware
   FastLED.setBrightness(brightness);
@@ -391,6 +400,9 @@ void setup() {
 }
 
 void loop() {
+  // Mesh play-at actions first — the frame delay wakes us right at their due time
+  pollMeshPlayAt();
+
   // Only read IMU if it initialized successfully
   if (sysStatus.imuReady) {
     readIMU();
@@ -497,10 +509,24 @@ void loop() {
   }
   prevInfoActive = infoMode.active;
 
-  if (infoMode.active && wledIsSyncing()) {
+  if (infoMode.active && wledIsSyncing() && !animOwnsWled()) {
     wledWeatherViewUpdate();
   }
 
+  // Scheduled weather phase — flagged from Core 0, drawn here. Paused (not
+  // ended) while speech has the WLED.
+  static bool prevSchedWeather = false;
+  bool schedWeather = wledWeatherScheduled;
+  if (schedWeather && !prevSchedWeather) wledWeatherViewReset();
+  if (!schedWeather && prevSchedWeather) wledWeatherViewOnExit();
+  prevSchedWeather = schedWeather;
+  if (schedWeather && !schedContent.speechInterrupted && !animOwnsWled()) {
+    wledWeatherViewUpdate();
+  }
+
+  // WLED test frame requested from the web UI
+  wledPollTestRequest();
+
   // Poll WiFi provisioning state machine (scan results, STA connect, AP linger)
   pollWifiProvisioning();
 
@@ -528,12 +554,16 @@ void loop() {
   }
   #endif
 
-  // Run the appropriate mode
-  if (infoMode.active) {
+  // Run the appropriate mode — a GIF playing on the LCD has it to itself
+  if (animUpdate()) {
+    // Frame (if due) already drawn
+  } else if (infoMode.active) {
     runInfoMode();
   } else {
     runBotMode();
   }
 
-  delay(BOT_FRAME_DELAY_MS);
+  // delay() that a due play-at action can cut short; an animation wakes us
+  // for its next frame
+  meshFrameDelay(animWaitMs(BOT_FRAME_DELAY_MS));
 }
@@ -3,8 +3,11 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
+#include <LittleFS.h>
+#include <time.h>
 #include "config.h"
 #include "system_status.h"
+#include "http_stream.h"
 
 extern char weatherLat[12];
 extern char weatherLon[12];
@@ -12,14 +15,55 @@ extern char weatherLon[12];
 // ============================================================================
 // Weather Data — Open-Meteo API integration
 // ============================================================================
-// Fetches current conditions + 3-day forecast from Open-Meteo (free, no key).
-// Uses raw WiFiClient (same pattern as wled_display.h — no HTTPClient lib).
+// Fetches current conditions, a WEATHER_FORECAST_DAYS daily forecast and the
+// next WEATHER_HOURLY_COUNT hours from Open-Meteo (free, no key). Uses raw
+// WiFiClient (same pattern as wled_display.h — no HTTPClient lib).
+//
+// The fetch is a small state machine driven by pollWeatherFetch(): connect
+// and send, then each Core 0 pass reads at most WEATHER_READ_BUDGET bytes
+// through HttpStream/JsonStream, so the WiFi task never sits in a wait loop
+// and the response size doesn't matter (~3KB for 7 days + 24 hours, chunked
+// or not). Values are parsed into weatherFetch.next and published into
+// weatherData in one copy once the document is complete; a failed or
+// truncated fetch leaves the previous data in place.
+//
+// Refresh is cache-aware:
+//   - a request within WEATHER_REFRESH_MS of the last good fetch for the
+//     same location is answered from memory, no network
+//   - an ETag / Last-Modified from the server is sent back as
+//     If-None-Match / If-Modified-Since; a 304 just renews the data's age
+//     (Open-Meteo sends neither today, so in practice the TTL does the work)
+//   - the socket is kept open for WEATHER_KEEPALIVE_MS after a response, so
+//     requests that land close together skip DNS + TCP setup
+//   - the last good report is saved to WEATHER_CACHE_PATH on LittleFS and
+//     loaded on the first poll, so the info screen has data before WiFi is
+//     up (only on builds that mount LittleFS, i.e. CLOUD_ENABLED)
 //
 // Thread safety: Core 1 (render) sets fetchRequested = true.
 // Core 0 (WiFi task) checks it, fetches, writes results.
-// Core 1 reads results only when valid == true && fetching == false.
+// Core 1 reads results only when valid == true.
 // ============================================================================
 
+#ifndef WEATHER_HOST
+#define WEATHER_HOST            "api.open-meteo.com"
+#endif
+#ifndef WEATHER_PORT
+#define WEATHER_PORT            80
+#endif
+#define WEATHER_FORECAST_DAYS   7
+#define WEATHER_HOURLY_COUNT    24
+#define WEATHER_REFRESH_MS      900000UL   // 15 min — Open-Meteo's "current" interval
+#define WEATHER_TIMEOUT_MS      8000       // Whole response, from connect
+#define WEATHER_KEEPALIVE_MS    60000      // Idle socket kept for the next request
+#define WEATHER_DRAIN_MS        1000       // Wait for the chunked terminator after the JSON
+#define WEATHER_READ_BUDGET     1024       // Bytes read per pollWeatherFetch()
+#define WEATHER_READ_WINDOW     128        // Stack window per socket read
+#define WEATHER_CACHE_PATH      "/weather.bin"
+#define WEATHER_CACHE_VERSION   1
+#define WEATHER_CACHE_MAX_AGE_S 43200      // Older cache files aren't shown (needs NTP)
+#define WEATHER_ETAG_LEN        48
+#define WEATHER_LASTMOD_LEN     32
+
 // ============================================================================
 // WMO Weather Code → condition text mapping
 // ============================================================================
@@ -80,6 +124,25 @@ uint16_t getTempColor(int tempF) {
   return 0xF800;                        // Red (very hot)
 }
 
+// Get day-of-week name from date string "YYYY-MM-DD"
+static void dateToDayName(const char* dateStr, char* dayBuf, uint8_t bufSize) {
+  // Parse date
+  int year = 0, month = 0, day = 0;
+  sscanf(dateStr, "%d-%d-%d", &year, &month, &day);
+
+  // Use struct tm + mktime to get day of week
+  struct tm t = {};
+  t.tm_year = year - 1900;
+  t.tm_mon = month - 1;
+  t.tm_mday = day;
+  mktime(&t);
+
+  const char* days[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+  strncpy(dayBuf, days[t.tm_wday], bufSize - 1);
+  dayBuf[bufSize - 1] = '\0';
+}
+
+
 // ============================================================================
 // Data Structures
 // ============================================================================
@@ -95,251 +158,498 @@ struct WeatherForecastDay {
   float highF;                   // Daily max temp
   float lowF;                    // Daily min temp
   uint8_t weatherCode;           // WMO code for the day
+  uint8_t precipPct;             // Max precipitation probability (0-100)
   char dayName[4];               // "Mon", "Tue", etc.
 };
 
-struct WeatherData {
+struct WeatherHour {
+  float tempF;
+  uint8_t weatherCode;
+  uint8_t precipPct;             // Precipitation probability (0-100)
+  uint8_t hour;                  // Local hour of day (0-23)
+};
+
+// One complete response — what a fetch publishes and the cache file holds
+struct WeatherReport {
+  char lat[12];                         // Location the report is for
+  char lon[12];
+  uint32_t fetchedEpoch;                // Unix time of the fetch, 0 if NTP wasn't synced
   WeatherCurrent current;
-  WeatherForecastDay forecast[3];      // 3-day forecast
+  WeatherForecastDay forecast[WEATHER_FORECAST_DAYS];
+  uint8_t forecastDays;                 // Entries of forecast[] filled
+  WeatherHour hourly[WEATHER_HOURLY_COUNT];   // From the current hour on
+  uint8_t hourlyCount;
+};
+
+struct WeatherData : WeatherReport {
   bool valid;                           // Data is populated and usable
   bool fetching;                        // Fetch in progress on Core 0
-  unsigned long lastFetchMs;            // When data was last refreshed
+  unsigned long lastFetchMs;            // When data was last refreshed (0 = not this boot)
   char errorMsg[24];                    // Error description if fetch failed
   volatile bool fetchRequested;         // Core 1 sets, Core 0 reads/clears
+  volatile uint16_t generation;         // Core 0 bumps after any change above — views cache on it
 };
 
 WeatherData weatherData = {};
 
 // ============================================================================
-// JSON Parsing Helpers (manual — no ArduinoJson, matches project pattern)
+// Fetch State (Core 0 only)
 // ============================================================================
 
-// Find a key in JSON and extract the numeric value after it
-// Returns true if found, sets outVal
-static bool jsonExtractFloat(const char* json, const char* key, float& outVal) {
-  const char* pos = strstr(json, key);
-  if (!pos) return false;
-  pos += strlen(key);
-  // Skip to colon and whitespace
-  while (*pos && (*pos == '"' || *pos == ':' || *pos == ' ')) pos++;
-  outVal = atof(pos);
-  return true;
-}
-
-// Find a key and extract integer value
-static bool jsonExtractInt(const char* json, const char* key, int& outVal) {
-  float f;
-  if (!jsonExtractFloat(json, key, f)) return false;
-  outVal = (int)(f + 0.5f);
-  return true;
-}
+enum WeatherFetchState : uint8_t {
+  WEATHER_FETCH_IDLE = 0,
+  WEATHER_FETCH_READ,                   // Request sent, reading the response
+  WEATHER_FETCH_DRAIN,                  // Published; reading the end of the framing
+};
 
-// Extract an array of floats from JSON: finds key, then reads comma-separated values
-// "key":[val0,val1,val2,...]
-static int jsonExtractFloatArray(const char* json, const char* key, float* outArr, int maxCount) {
-  const char* pos = strstr(json, key);
-  if (!pos) return 0;
-  // Find the opening bracket
-  pos = strchr(pos, '[');
-  if (!pos) return 0;
-  pos++; // skip '['
-
-  int count = 0;
-  while (*pos && *pos != ']' && count < maxCount) {
-    // Skip whitespace
-    while (*pos == ' ' || *pos == ',') pos++;
-    if (*pos == ']') break;
-    outArr[count++] = atof(pos);
-    // Skip to next comma or end
-    while (*pos && *pos != ',' && *pos != ']') pos++;
-  }
-  return count;
-}
+struct WeatherFetch {
+  WiFiClient client;
+  WeatherFetchState state;
+  HttpStream http;
+  JsonStream json;
+  WeatherReport next;                   // Parsed into here, published on success
+  uint8_t dayFields[WEATHER_FORECAST_DAYS];    // WEATHER_DAY_* bits seen per day
+  uint8_t hourFields[WEATHER_HOURLY_COUNT];    // WEATHER_HOUR_* bits seen per hour
+  char reason[24];                      // Open-Meteo's {"error":true,"reason":...}
+  unsigned long startMs;
+  unsigned long idleSinceMs;            // Kept-alive socket idle since
+  unsigned long drainMs;                // DRAIN start
+  bool reused;                          // Request went out on a kept-alive socket
+  bool cacheChecked;
+  uint32_t rxBytes;
+
+  // Validators for the data in weatherData, and the ones the current
+  // response carries (adopted when it succeeds)
+  char etag[WEATHER_ETAG_LEN];
+  char lastModified[WEATHER_LASTMOD_LEN];
+  char newEtag[WEATHER_ETAG_LEN];
+  char newLastModified[WEATHER_LASTMOD_LEN];
+
+  // Stats
+  uint16_t requests;                    // Requests sent
+  uint16_t notModified;                 // 304s
+  uint16_t reuses;                      // Requests on a kept-alive socket
+  uint16_t fresh;                       // Requests answered from memory
+  uint32_t lastBytes;                   // Size of the last response
+  uint16_t lastMs;                      // Duration of the last fetch
+};
 
-// Extract integer array
-static int jsonExtractIntArray(const char* json, const char* key, int* outArr, int maxCount) {
-  float fArr[8];
-  int count = jsonExtractFloatArray(json, key, fArr, min(maxCount, 8));
-  for (int i = 0; i < count; i++) {
-    outArr[i] = (int)(fArr[i] + 0.5f);
-  }
-  return count;
-}
+static WeatherFetch weatherFetch = {};
 
-// Get day-of-week name from date string "YYYY-MM-DD"
-static void dateToDayName(const char* dateStr, char* dayBuf, uint8_t bufSize) {
-  // Parse date
-  int year = 0, month = 0, day = 0;
-  sscanf(dateStr, "%d-%d-%d", &year, &month, &day);
+#define WEATHER_DAY_TIME  0x01
+#define WEATHER_DAY_MAX   0x02
+#define WEATHER_DAY_MIN   0x04
+#define WEATHER_DAY_CODE  0x08
+#define WEATHER_DAY_ALL   0x0F          // precipitation is optional
 
-  // Use struct tm + mktime to get day of week
-  struct tm t = {};
-  t.tm_year = year - 1900;
-  t.tm_mon = month - 1;
-  t.tm_mday = day;
-  mktime(&t);
+#define WEATHER_HOUR_TIME 0x01
+#define WEATHER_HOUR_TEMP 0x02
+#define WEATHER_HOUR_CODE 0x04
+#define WEATHER_HOUR_ALL  0x07
 
-  const char* days[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
-  strncpy(dayBuf, days[t.tm_wday], bufSize - 1);
-  dayBuf[bufSize - 1] = '\0';
+inline bool weatherLocationMatches(const WeatherReport& r) {
+  return strcmp(r.lat, weatherLat) == 0 && strcmp(r.lon, weatherLon) == 0;
 }
 
-// Extract date strings from "time" array in daily block
-static int jsonExtractDateArray(const char* json, const char* key, char dayNames[][4], int maxCount) {
-  const char* pos = strstr(json, key);
-  if (!pos) return 0;
-  pos = strchr(pos, '[');
-  if (!pos) return 0;
-  pos++; // skip '['
-
-  int count = 0;
-  while (*pos && *pos != ']' && count < maxCount) {
-    // Skip to opening quote
-    while (*pos && *pos != '"') pos++;
-    if (*pos != '"') break;
-    pos++; // skip opening quote
-
-    // Read date string (10 chars: YYYY-MM-DD)
-    char dateStr[12] = {};
-    int di = 0;
-    while (*pos && *pos != '"' && di < 10) {
-      dateStr[di++] = *pos++;
-    }
-    dateStr[di] = '\0';
-    if (*pos == '"') pos++; // skip closing quote
+// Seconds since the published data was fetched, -1 if unknown
+long weatherAgeSec() {
+  if (weatherData.lastFetchMs) return (millis() - weatherData.lastFetchMs) / 1000;
+  if (!sysStatus.ntpSynced || !weatherData.fetchedEpoch) return -1;
+  time_t now = time(nullptr);
+  return now >= (time_t)weatherData.fetchedEpoch ? (long)(now - weatherData.fetchedEpoch) : -1;
+}
 
-    dateToDayName(dateStr, dayNames[count], 4);
-    count++;
-  }
-  return count;
+// Good enough to answer a request without going to the network
+bool weatherIsFresh() {
+  if (!weatherData.valid || !weatherLocationMatches(weatherData)) return false;
+  long age = weatherAgeSec();
+  return age >= 0 && age < (long)(WEATHER_REFRESH_MS / 1000);
 }
 
 // ============================================================================
-// Parse the full Open-Meteo response
+// Streaming Response Parser
 // ============================================================================
+// Open-Meteo returns column arrays: "daily":{"time":[...],"weather_code":[...]}
+// so entry i of every array under "daily" belongs to day i. Each field sets
+// a bit per entry; only leading entries with every required bit count.
+
+static bool weatherJsonHandler(JsonStream& js, void* ctx) {
+  WeatherFetch& f = *(WeatherFetch*)ctx;
+  WeatherReport& r = f.next;
+  if (js.event != JSON_EV_VALUE) return true;
+
+  if (js.depth == 1) {
+    if (js.at("reason")) js.copyValue(f.reason, sizeof(f.reason));
+    return true;
+  }
 
-static void parseWeatherResponse(const char* response) {
-  // Find the JSON body (after HTTP headers — empty line)
-  const char* body = strstr(response, "\r\n\r\n");
-  if (!body) body = response;  // Fallback: maybe no headers
-  else body += 4;
-
-  // Current conditions
-  // Look for "current" block
-  const char* currentBlock = strstr(body, "\"current\"");
-  if (currentBlock) {
-    float tempVal;
-    if (jsonExtractFloat(currentBlock, "\"temperature_2m\"", tempVal)) {
-      weatherData.current.tempF = tempVal;
+  if (js.depth == 2 && js.childOf("current")) {
+    const char* k = js.keyAt(1);
+    if (strcmp(k, "temperature_2m") == 0) {
+      r.current.tempF = js.asFloat();
+    } else if (strcmp(k, "weather_code") == 0) {
+      r.current.weatherCode = (uint8_t)js.asInt();
+      wmoToText(r.current.weatherCode, r.current.conditionText, sizeof(r.current.conditionText));
+    } else if (strcmp(k, "is_day") == 0) {
+      r.current.isDay = js.asInt() == 1;
     }
+    return true;
+  }
 
-    int codeVal;
-    if (jsonExtractInt(currentBlock, "\"weather_code\"", codeVal)) {
-      weatherData.current.weatherCode = (uint8_t)codeVal;
-      wmoToText(codeVal, weatherData.current.conditionText,
-                sizeof(weatherData.current.conditionText));
+  if (js.depth != 3) return true;
+  const char* k = js.keyAt(1);
+  uint16_t i = js.indexAt(2);
+
+  if (js.childOf("daily/*")) {
+    if (i >= WEATHER_FORECAST_DAYS) return true;
+    WeatherForecastDay& d = r.forecast[i];
+    uint8_t bit = 0;
+    if (strcmp(k, "time") == 0) {
+      dateToDayName(js.value, d.dayName, sizeof(d.dayName));
+      bit = WEATHER_DAY_TIME;
+    } else if (strcmp(k, "temperature_2m_max") == 0) {
+      d.highF = js.asFloat();
+      bit = WEATHER_DAY_MAX;
+    } else if (strcmp(k, "temperature_2m_min") == 0) {
+      d.lowF = js.asFloat();
+      bit = WEATHER_DAY_MIN;
+    } else if (strcmp(k, "weather_code") == 0) {
+      d.weatherCode = (uint8_t)js.asInt();
+      bit = WEATHER_DAY_CODE;
+    } else if (strcmp(k, "precipitation_probability_max") == 0) {
+      d.precipPct = (uint8_t)constrain(js.asInt(), 0, 100);
     }
-
-    int isDayVal;
-    if (jsonExtractInt(currentBlock, "\"is_day\"", isDayVal)) {
-      weatherData.current.isDay = (isDayVal == 1);
+    f.dayFields[i] |= bit;
+  } else if (js.childOf("hourly/*")) {
+    if (i >= WEATHER_HOURLY_COUNT) return true;
+    WeatherHour& h = r.hourly[i];
+    uint8_t bit = 0;
+    if (strcmp(k, "time") == 0) {
+      h.hour = js.valueLen >= 13 ? (uint8_t)atoi(js.value + 11) : 0;   // "2026-10-18T14:00"
+      bit = WEATHER_HOUR_TIME;
+    } else if (strcmp(k, "temperature_2m") == 0) {
+      h.tempF = js.asFloat();
+      bit = WEATHER_HOUR_TEMP;
+    } else if (strcmp(k, "weather_code") == 0) {
+      h.weatherCode = (uint8_t)js.asInt();
+      bit = WEATHER_HOUR_CODE;
+    } else if (strcmp(k, "precipitation_probability") == 0) {
+      h.precipPct = (uint8_t)constrain(js.asInt(), 0, 100);
     }
+    f.hourFields[i] |= bit;
   }
+  return true;
+}
 
-  // Daily forecast
-  const char* dailyBlock = strstr(body, "\"daily\"");
-  if (dailyBlock) {
-    // Extract arrays
-    float highs[3], lows[3];
-    int codes[3];
-    char dayNames[3][4];
-
-    int nHighs = jsonExtractFloatArray(dailyBlock, "\"temperature_2m_max\"", highs, 3);
-    int nLows = jsonExtractFloatArray(dailyBlock, "\"temperature_2m_min\"", lows, 3);
-    int nCodes = jsonExtractIntArray(dailyBlock, "\"weather_code\"", codes, 3);
-    int nDays = jsonExtractDateArray(dailyBlock, "\"time\"", dayNames, 3);
-
-    int forecastCount = min(min(nHighs, nLows), min(nCodes, nDays));
-    if (forecastCount > 3) forecastCount = 3;
-
-    for (int i = 0; i < forecastCount; i++) {
-      weatherData.forecast[i].highF = highs[i];
-      weatherData.forecast[i].lowF = lows[i];
-      weatherData.forecast[i].weatherCode = (uint8_t)codes[i];
-      strncpy(weatherData.forecast[i].dayName, dayNames[i], 3);
-      weatherData.forecast[i].dayName[3] = '\0';
-    }
+// ETag / Last-Modified, if the server sends them. A header longer than the
+// line buffer is dropped rather than echoed back cut short.
+static void weatherHeaderHandler(const char* line, bool truncated, void* ctx) {
+  WeatherFetch& f = *(WeatherFetch*)ctx;
+  if (truncated) return;
+  char* dst = nullptr;
+  size_t size = 0;
+  if (HttpStream::startsWithNoCase(line, "etag:")) {
+    dst = f.newEtag;
+    size = sizeof(f.newEtag);
+  } else if (HttpStream::startsWithNoCase(line, "last-modified:")) {
+    dst = f.newLastModified;
+    size = sizeof(f.newLastModified);
+  }
+  if (!dst) return;
+  const char* v = HttpStream::headerValue(line);
+  if (strlen(v) >= size) return;
+  strcpy(dst, v);
+}
+
+// ============================================================================
+// LittleFS Cache
+// ============================================================================
+// Layout: WeatherCacheHeader then WeatherReport, both as laid out in RAM.
+// reportSize doubles as a layout check — a build where WeatherReport changed
+// shape ignores the old file and the next fetch overwrites it.
+
+struct WeatherCacheHeader {
+  char magic[2];                        // 'W' 'X'
+  uint8_t version;                      // WEATHER_CACHE_VERSION
+  uint8_t reserved;
+  uint16_t reportSize;                  // sizeof(WeatherReport)
+  char etag[WEATHER_ETAG_LEN];
+  char lastModified[WEATHER_LASTMOD_LEN];
+};
+
+void saveWeatherCache() {
+  if (!sysStatus.littlefsReady) return;
+  WeatherCacheHeader hdr = {};
+  hdr.magic[0] = 'W';
+  hdr.magic[1] = 'X';
+  hdr.version = WEATHER_CACHE_VERSION;
+  hdr.reportSize = sizeof(WeatherReport);
+  memcpy(hdr.etag, weatherFetch.etag, sizeof(hdr.etag));
+  memcpy(hdr.lastModified, weatherFetch.lastModified, sizeof(hdr.lastModified));
+
+  // Write aside and rename, so a reset mid-write leaves the old file intact
+  File f = LittleFS.open(WEATHER_CACHE_PATH ".tmp", "w");
+  if (!f) return;
+  bool ok = f.write((const uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr);
+  ok &= f.write((const uint8_t*)(const WeatherReport*)&weatherData, sizeof(WeatherReport)) == sizeof(WeatherReport);
+  f.close();
+  if (ok) ok = LittleFS.rename(WEATHER_CACHE_PATH ".tmp", WEATHER_CACHE_PATH);
+  if (!ok) LittleFS.remove(WEATHER_CACHE_PATH ".tmp");
+  DBGLN(ok ? "Weather: cache saved" : "Weather: cache write failed");
+}
+
+// Load the saved report if it's for the current location (and, when the
+// clock is known, not older than WEATHER_CACHE_MAX_AGE_S)
+bool loadWeatherCache() {
+  File f = LittleFS.open(WEATHER_CACHE_PATH, "r");
+  if (!f) return false;
+  WeatherCacheHeader hdr;
+  WeatherReport r;
+  bool ok = f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr) &&
+            hdr.magic[0] == 'W' && hdr.magic[1] == 'X' &&
+            hdr.version == WEATHER_CACHE_VERSION &&
+            hdr.reportSize == sizeof(WeatherReport) &&
+            f.read((uint8_t*)&r, sizeof(r)) == sizeof(r);
+  f.close();
+  if (!ok) {
+    DBGLN("Weather: cache unreadable, ignored");
+    return false;
   }
+  r.lat[sizeof(r.lat) - 1] = '\0';
+  r.lon[sizeof(r.lon) - 1] = '\0';
+  if (!weatherLocationMatches(r)) return false;
+  if (sysStatus.ntpSynced && r.fetchedEpoch &&
+      time(nullptr) - (time_t)r.fetchedEpoch > WEATHER_CACHE_MAX_AGE_S) {
+    return false;
+  }
+
+  (WeatherReport&)weatherData = r;
+  hdr.etag[sizeof(hdr.etag) - 1] = '\0';
+  hdr.lastModified[sizeof(hdr.lastModified) - 1] = '\0';
+  strcpy(weatherFetch.etag, hdr.etag);
+  strcpy(weatherFetch.lastModified, hdr.lastModified);
+  weatherData.lastFetchMs = 0;        // Age comes from fetchedEpoch
+  weatherData.valid = true;
+  weatherData.generation++;
+  DBG("Weather: loaded cache, ");
+  DBG(r.forecastDays);
+  DBGLN(" days");
+  return true;
 }
 
 // ============================================================================
 // Weather Fetch (runs on Core 0 — WiFi task)
 // ============================================================================
 
-void fetchWeather() {
+static void weatherFetchEnd(const char* error) {
+  WeatherFetch& f = weatherFetch;
+  f.state = WEATHER_FETCH_IDLE;
+  weatherData.fetching = false;
+  f.lastBytes = f.rxBytes;
+  f.lastMs = (uint16_t)min(millis() - f.startMs, 65535UL);
+  if (error) {
+    strncpy(weatherData.errorMsg, error, sizeof(weatherData.errorMsg) - 1);
+    weatherData.errorMsg[sizeof(weatherData.errorMsg) - 1] = '\0';
+    DBG("Weather fetch failed: ");
+    DBGLN(error);
+  }
+  weatherData.generation++;   // fetching cleared, and new data or an error with it
+  if (f.http.reusable()) {
+    f.idleSinceMs = millis();
+  } else if (!error && !f.http.connectionClose && (f.http.chunked || f.http.contentLength >= 0)) {
+    // The JSON closed before the framing did (chunked "0" usually trails
+    // in its own segment) — read up to it so the socket can be reused
+    f.state = WEATHER_FETCH_DRAIN;
+    f.drainMs = millis();
+  } else {
+    f.client.stop();
+  }
+}
+
+// Send the request — on the kept-alive socket if there is one
+static bool weatherSendRequest() {
+  WeatherFetch& f = weatherFetch;
+  f.reused = f.client.connected();
+  if (!f.reused) {
+    f.client.stop();
+    if (!f.client.connect(WEATHER_HOST, WEATHER_PORT)) return false;
+  }
+
+  // Validators only describe the data we hold for this location
+  bool conditional = weatherData.valid && weatherLocationMatches(weatherData);
+  char req[512];
+  int n = snprintf(req, sizeof(req),
+    "GET /v1/forecast?latitude=%s&longitude=%s"
+    "&current=temperature_2m,weather_code,is_day"
+    "&hourly=temperature_2m,weather_code,precipitation_probability"
+    "&daily=temperature_2m_max,temperature_2m_min,weather_code,precipitation_probability_max"
+    "&temperature_unit=fahrenheit"
+    "&forecast_days=%d&forecast_hours=%d"
+    "&timezone=auto HTTP/1.1\r\n"
+    "Host: " WEATHER_HOST "\r\n"
+    "Connection: keep-alive\r\n"
+    "%s%s%s%s%s%s"
+    "\r\n",
+    weatherLat, weatherLon, WEATHER_FORECAST_DAYS, WEATHER_HOURLY_COUNT,
+    conditional && f.etag[0] ? "If-None-Match: " : "",
+    conditional && f.etag[0] ? f.etag : "",
+    conditional && f.etag[0] ? "\r\n" : "",
+    conditional && f.lastModified[0] ? "If-Modified-Since: " : "",
+    conditional && f.lastModified[0] ? f.lastModified : "",
+    conditional && f.lastModified[0] ? "\r\n" : "");
+  if (n <= 0 || n >= (int)sizeof(req)) return false;
+  return f.client.write((const uint8_t*)req, n) == (size_t)n;
+}
+
+static void weatherFetchStart() {
+  WeatherFetch& f = weatherFetch;
   if (!sysStatus.staConnected) {
     strncpy(weatherData.errorMsg, "No WiFi", sizeof(weatherData.errorMsg));
-    weatherData.fetching = false;
+    weatherData.generation++;
     return;
   }
 
   weatherData.fetching = true;
   weatherData.errorMsg[0] = '\0';
-
-  WiFiClient client;
-  client.setTimeout(5000);
-
-  if (!client.connect("api.open-meteo.com", 80)) {
-    strncpy(weatherData.errorMsg, "Connect failed", sizeof(weatherData.errorMsg));
-    weatherData.fetching = false;
+  weatherData.generation++;
+  f.startMs = millis();
+  f.rxBytes = 0;
+  f.next = {};
+  strncpy(f.next.lat, weatherLat, sizeof(f.next.lat) - 1);
+  strncpy(f.next.lon, weatherLon, sizeof(f.next.lon) - 1);
+  memset(f.dayFields, 0, sizeof(f.dayFields));
+  memset(f.hourFields, 0, sizeof(f.hourFields));
+  f.reason[0] = '\0';
+  f.newEtag[0] = '\0';
+  f.newLastModified[0] = '\0';
+  f.json.begin(weatherJsonHandler, &f);
+  f.http.begin(&f.json);
+  f.http.onHeader(weatherHeaderHandler, &f);
+
+  bool sent = weatherSendRequest();
+  if (!sent && f.reused) {
+    f.client.stop();                  // Server had closed it; one fresh try
+    sent = weatherSendRequest();
+  }
+  if (!sent) {
+    weatherFetchEnd("Connect failed");
     return;
   }
+  f.requests++;
+  if (f.reused) f.reuses++;
+  f.state = WEATHER_FETCH_READ;
+}
 
-  // Build request path with configured lat/lon
-  char request[256];
-  snprintf(request, sizeof(request),
-    "GET /v1/forecast?latitude=%s&longitude=%s"
-    "&current=temperature_2m,weather_code,is_day"
-    "&daily=temperature_2m_max,temperature_2m_min,weather_code"
-    "&temperature_unit=fahrenheit"
-    "&forecast_days=3"
-    "&timezone=auto HTTP/1.1",
-    weatherLat, weatherLon);
-
-  client.println(request);
-  client.println("Host: api.open-meteo.com");
-  client.println("Connection: close");
-  client.println();
-
-  // Wait for response (same pattern as POC)
-  unsigned long timeout = millis();
-  while (client.available() == 0) {
-    if (millis() - timeout > 8000) {
-      strncpy(weatherData.errorMsg, "Timeout", sizeof(weatherData.errorMsg));
-      weatherData.fetching = false;
-      client.stop();
-      return;
-    }
-    delay(10);
+// Response complete: publish a 200, renew on a 304
+static void weatherFetchFinish() {
+  WeatherFetch& f = weatherFetch;
+  int16_t status = f.http.status;
+
+  if (status == 304) {
+    f.notModified++;
+    if (f.newEtag[0]) strcpy(f.etag, f.newEtag);
+    if (f.newLastModified[0]) strcpy(f.lastModified, f.newLastModified);
+    weatherData.fetchedEpoch = sysStatus.ntpSynced ? (uint32_t)time(nullptr) : 0;
+    weatherData.lastFetchMs = millis();
+    weatherFetchEnd(nullptr);
+    DBGLN("Weather: not modified");
+    return;
   }
 
-  // Read response into stack buffer
-  char response[1200];
-  int responseLen = 0;
-  while (client.available() && responseLen < (int)(sizeof(response) - 1)) {
-    response[responseLen++] = client.read();
+  if (status != 200) {
+    char msg[24];
+    if (f.reason[0]) strncpy(msg, f.reason, sizeof(msg));
+    else snprintf(msg, sizeof(msg), "HTTP %d", status);
+    msg[sizeof(msg) - 1] = '\0';
+    weatherFetchEnd(msg);
+    return;
   }
-  response[responseLen] = '\0';
-  client.stop();
 
-  // Parse
-  parseWeatherResponse(response);
+  WeatherReport& r = f.next;
+  while (r.forecastDays < WEATHER_FORECAST_DAYS &&
+         (f.dayFields[r.forecastDays] & WEATHER_DAY_ALL) == WEATHER_DAY_ALL) {
+    r.forecastDays++;
+  }
+  while (r.hourlyCount < WEATHER_HOURLY_COUNT &&
+         (f.hourFields[r.hourlyCount] & WEATHER_HOUR_ALL) == WEATHER_HOUR_ALL) {
+    r.hourlyCount++;
+  }
+  if (r.forecastDays < 3 || !r.current.conditionText[0]) {
+    weatherFetchEnd("Bad response");   // The views need current + 3 days
+    return;
+  }
 
+  r.fetchedEpoch = sysStatus.ntpSynced ? (uint32_t)time(nullptr) : 0;
+  (WeatherReport&)weatherData = r;
   weatherData.lastFetchMs = millis();
-  weatherData.fetching = false;
   weatherData.valid = true;
+  strcpy(f.etag, f.newEtag);
+  strcpy(f.lastModified, f.newLastModified);
+  weatherFetchEnd(nullptr);
+  saveWeatherCache();
+
+  DBG("Weather fetch OK: ");
+  DBG(r.forecastDays);
+  DBG(" days, ");
+  DBG(r.hourlyCount);
+  DBG(" hours, ");
+  DBG(f.lastBytes);
+  DBGLN(" bytes");
+}
+
+// Feed what has arrived to the response parser, up to the per-pass budget.
+// Returns false once the server has closed the socket and nothing is left.
+static bool weatherFetchPump() {
+  WeatherFetch& f = weatherFetch;
+  uint8_t win[WEATHER_READ_WINDOW];
+  uint16_t budget = WEATHER_READ_BUDGET;
+
+  while (budget > 0 && !f.http.complete()) {
+    int avail = f.client.available();
+    if (avail <= 0) return f.client.connected();
+    int n = f.client.read(win, min(avail, (int)min((uint16_t)sizeof(win), budget)));
+    if (n <= 0) break;
+    budget -= n;
+    f.rxBytes += n;
+    JsonStreamResult r = f.http.feed(win, n);
+    if (r == JSON_STREAM_ERROR || r == JSON_STREAM_STOPPED) break;
+  }
+  return true;
+}
 
-  DBGLN("Weather fetch OK");
+static void weatherFetchRead() {
+  WeatherFetch& f = weatherFetch;
+  bool open = weatherFetchPump();
+  JsonStreamResult r = f.http.feed(nullptr, 0);   // Where things stand
+
+  if (r == JSON_STREAM_DONE) {
+    weatherFetchFinish();
+  } else if (r != JSON_STREAM_MORE) {
+    char msg[24] = "Bad response";
+    if (f.http.status && f.http.status != 200) snprintf(msg, sizeof(msg), "HTTP %d", f.http.status);
+    weatherFetchEnd(msg);
+  } else if (!open && f.reused && f.rxBytes == 0) {
+    // The server dropped the kept-alive socket as we sent: one fresh try
+    f.client.stop();
+    weatherFetchStart();
+  } else if (!open) {
+    weatherFetchEnd("Connection lost");
+  } else if (millis() - f.startMs > WEATHER_TIMEOUT_MS) {
+    weatherFetchEnd("Timeout");
+  }
+}
+
+static void weatherFetchDrain() {
+  WeatherFetch& f = weatherFetch;
+  bool open = weatherFetchPump();
+  if (f.http.reusable()) {
+    f.state = WEATHER_FETCH_IDLE;
+    f.idleSinceMs = millis();
+  } else if (!open || f.http.complete() || f.http.state == HttpStream::H_ERROR ||
+             millis() - f.drainMs > WEATHER_DRAIN_MS) {
+    f.state = WEATHER_FETCH_IDLE;
+    f.client.stop();
+  }
 }
 
 // ============================================================================
@@ -347,9 +657,34 @@ void fetchWeather() {
 // ============================================================================
 
 void pollWeatherFetch() {
+  WeatherFetch& f = weatherFetch;
+  if (!f.cacheChecked && sysStatus.littlefsReady) {
+    f.cacheChecked = true;
+    if (!weatherData.valid) loadWeatherCache();
+  }
+
+  if (f.state == WEATHER_FETCH_READ) {
+    weatherFetchRead();
+    return;
+  }
+  if (f.state == WEATHER_FETCH_DRAIN) {
+    weatherFetchDrain();
+    return;
+  }
+
+  // Let an idle kept-alive socket go
+  if (millis() - f.idleSinceMs > WEATHER_KEEPALIVE_MS && f.client.connected()) {
+    f.client.stop();
+  }
+
   if (!weatherData.fetchRequested) return;
   weatherData.fetchRequested = false;
-  fetchWeather();
+  if (weatherIsFresh()) {
+    f.fresh++;
+    DBGLN("Weather: fresh, no fetch");
+    return;
+  }
+  weatherFetchStart();
 }
 
 // Request a weather fetch (called from Core 1)
@@ -357,4 +692,35 @@ void requestWeatherFetch() {
   weatherData.fetchRequested = true;
 }
 
+// For /api/state
+String getWeatherStatusJson() {
+  const WeatherFetch& f = weatherFetch;
+  String json = "{\"valid\":";
+  json += weatherData.valid ? "true" : "false";
+  json += ",\"fetching\":";
+  json += weatherData.fetching ? "true" : "false";
+  json += ",\"days\":";
+  json += weatherData.forecastDays;
+  json += ",\"hours\":";
+  json += weatherData.hourlyCount;
+  json += ",\"ageS\":";
+  json += weatherAgeSec();
+  json += ",\"error\":\"";
+  json += weatherData.errorMsg;
+  json += "\",\"requests\":";
+  json += f.requests;
+  json += ",\"notModified\":";
+  json += f.notModified;
+  json += ",\"reused\":";
+  json += f.reuses;
+  json += ",\"fresh\":";
+  json += f.fresh;
+  json += ",\"lastBytes\":";
+  json += f.lastBytes;
+  json += ",\"lastMs\":";
+  json += f.lastMs;
+  json += "}";
+  return json;
+}
+
 #endif // WEATHER_DATA_H
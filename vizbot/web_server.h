@@ -6,7 +6,7 @@
 #include <ESPmDNS.h>
 #include <FastLED.h>
 #include "config.h"
-#include "palettes.h"
+#include <vizfx_palettes.h>
 #include "ota_update.h"
 
 // External references to globals
@@ -200,10 +200,31 @@ input[type=range]::-webkit-slider-thumb{-webkit-appearance:none;width:20px;heigh
             <input type="number" id="schedMin" value="30" min="1" max="120" class="inp-sm" onchange="updateSched()">
             <span class="lbl">min</span>
           </div>
+          <div class="row">
+            <span class="lbl">or at (cron)</span>
+            <input type="text" id="schedCron" placeholder="0 8-20 * * *" class="inp flex1" maxlength="31" onchange="updateSched()">
+          </div>
           <div id="schedStatus" class="hint"></div>
         </div>
       </div>
 
+      <div class="card">
+        <h2 class="shdr" onclick="tgl('secAnim')">Animations <span class="chv">&#9662;</span></h2>
+        <div class="sbody" id="secAnim">
+          <select id="animName" class="sel"></select>
+          <div class="row" style="margin-top:8px">
+            <select id="animTarget" class="sel flex1"><option value="lcd">LCD</option><option value="wled">WLED</option><option value="both">Both</option></select>
+            <button onclick="playAnim()" class="btn-start flex1">Play</button>
+            <button onclick="stopAnim()" class="flex1">Stop</button>
+          </div>
+          <div class="row" style="margin-top:8px">
+            <input type="file" id="animFile" accept=".gif,image/gif" class="inp flex1">
+            <button onclick="uploadAnim()" id="animUpBtn">Upload</button>
+          </div>
+          <div id="animStatus" class="hint"></div>
+        </div>
+      </div>
+
       <div class="card">
         <h2 class="shdr" onclick="tgl('secWifi')">WiFi <span class="chv">&#9662;</span></h2>
         <div class="sbody" id="secWifi">
@@ -235,6 +256,11 @@ input[type=range]::-webkit-slider-thumb{-webkit-appearance:none;width:20px;heigh
           <div id="wledStatus"></div>
           <div class="trow"><span>Forward Speech</span><div class="tog" id="wledToggle" onclick="toggleWled()"></div></div>
           <div class="trow"><span>Hologram Mode</span><div class="tog" id="hologramToggle" onclick="toggleHologram()"></div></div>
+          <select id="wledFont" onchange="setWledFont(this.value)" class="sel" style="margin-top:8px">
+            <option value="0">Font: 3x5 compact</option>
+            <option value="1">Font: 5x7 lowercase</option>
+            <option value="2">Font: proportional 8px</option>
+          </select>
           <div class="row" style="margin-top:8px">
             <input type="text" id="wledIP" placeholder="WLED IP" class="inp flex1" maxlength="15">
             <button onclick="setWledIP()">Set</button>
@@ -360,7 +386,9 @@ input[type=range]::-webkit-slider-thumb{-webkit-appearance:none;width:20px;heigh
     }
     function updateSched() {
       const min = document.getElementById('schedMin').value;
-      api('/schedule?intervalMin=' + min);
+      const cron = document.getElementById('schedCron').value.trim();
+      api('/schedule?intervalMin=' + min + '&cron=' + encodeURIComponent(cron) +
+          '&tzMin=' + (-new Date().getTimezoneOffset()));
     }
     async function loadSchedule() {
       try {
@@ -369,6 +397,7 @@ input[type=range]::-webkit-slider-thumb{-webkit-appearance:none;width:20px;heigh
         schedOn = d.enabled;
         document.getElementById('schedToggle').className = 'tog ' + (schedOn ? 'on' : '');
         document.getElementById('schedMin').value = d.intervalMin;
+        document.getElementById('schedCron').value = d.cron || '';
         const phases = ['Idle','Weather','Gap','Emoji'];
         document.getElementById('schedStatus').textContent =
           d.isOwner ? 'Owner \u2022 Phase: ' + (phases[d.phase] || 'Idle') : (d.enabled ? 'Deferred to another bot' : '');
@@ -376,6 +405,43 @@ input[type=range]::-webkit-slider-thumb{-webkit-appearance:none;width:20px;heigh
     }
     loadSchedule();
 
+    async function loadAnims() {
+      try {
+        const r = await fetch('/anim/status');
+        const d = await r.json();
+        const sel = document.getElementById('animName');
+        const cur = sel.value;
+        sel.innerHTML = d.files.map(f =>
+          `<option value="${f.name}">${f.name} (${Math.round(f.size / 1024)}KB)</option>`).join('');
+        if (cur) sel.value = cur;
+        document.getElementById('animStatus').textContent = d.error ? 'Error: ' + d.error :
+          d.active ? 'Playing ' + d.name + ' \u2022 ' + d.frames + ' frames, ' +
+                     (d.decodeAvgUs / 1000).toFixed(1) + 'ms decode' : '';
+      } catch(e) {}
+    }
+    function playAnim() {
+      const name = document.getElementById('animName').value;
+      if (!name) return;
+      api('/anim/play?name=' + encodeURIComponent(name) + '&target=' +
+          document.getElementById('animTarget').value).then(() => setTimeout(loadAnims, 500));
+    }
+    function stopAnim() { api('/anim/stop').then(() => setTimeout(loadAnims, 300)); }
+    function uploadAnim() {
+      const file = document.getElementById('animFile').files[0];
+      if (!file) return;
+      const name = file.name.replace(/\.gif$/i, '').replace(/[^A-Za-z0-9_-]/g, '_').slice(0, 31);
+      const form = new FormData();
+      form.append('file', file);
+      const btn = document.getElementById('animUpBtn');
+      btn.textContent = '...';
+      fetch('/anim/upload?name=' + encodeURIComponent(name), {method:'POST', body: form})
+        .then(r => r.json())
+        .then(d => { document.getElementById('animStatus').textContent = d.success ? 'Uploaded ' + name : 'Error: ' + d.error; })
+        .catch(() => {})
+        .finally(() => { btn.textContent = 'Upload'; loadAnims(); });
+    }
+    loadAnims();
+
     let infoOn = false;
     function toggleInfo() {
       infoOn = !infoOn;
@@ -604,6 +670,7 @@ input[type=range]::-webkit-slider-thumb{-webkit-appearance:none;width:20px;heigh
       const ip = document.getElementById('wledIP').value.trim();
       if (ip) { api('/wled/config?ip=' + encodeURIComponent(ip)); wledUpdateStatus(); }
     }
+    function setWledFont(v) { api('/wled/config?font=' + v); }
     function testWled() { api('/wled/test'); }
     async function wledUpdateStatus() {
       const r = await api('/wled/status');
@@ -614,6 +681,7 @@ input[type=range]::-webkit-slider-thumb{-webkit-appearance:none;width:20px;heigh
       hologramOn = !!d.hologram;
       document.getElementById('hologramToggle').className = 'tog ' + (hologramOn ? 'on' : '');
       if (d.ip) document.getElementById('wledIP').value = d.ip;
+      if (d.font !== undefined) document.getElementById('wledFont').value = d.font;
       const dot = document.getElementById('wledDot');
       if (d.enabled && d.reachable) dot.className = 'dot on';
       else if (d.enabled) dot.className = 'dot err';
@@ -725,6 +793,7 @@ void handleRoot() {
 extern bool isBotTimeOverlayEnabled();
 extern bool hiResMode;
 extern String getWledStatusJson();
+extern String getWeatherStatusJson();
 extern struct InfoModeData infoMode;
 extern char weatherLat[12];
 extern char weatherLon[12];
@@ -763,6 +832,7 @@ void handleState() {
                 "},\"wled\":" + getWledStatusJson() +
                 ",\"wledEmoji\":" + getWledEmojiJson() +
                 ",\"infoActive\":" + (infoMode.active ? "true" : "false") +
+                ",\"weather\":" + getWeatherStatusJson() +
                 ",\"weatherLat\":\"" + String(weatherLat) + "\"" +
                 ",\"weatherLon\":\"" + String(weatherLon) + "\"" +
                 ",\"device\":\"" + String(apSSID) + "\"" +
@@ -775,6 +845,14 @@ void handleState() {
                   "\"speaker\":" + (sysStatus.speakerReady ? "true" : "false") +
                   ",\"midiSynth\":" + (sysStatus.midiReady ? "true" : "false") +
                   ",\"useMidi\":" + (botSounds.useMidi ? "true" : "false") +
+                  ",\"synthLoad\":" + String(softSynth.loadPercent()) +
+                  ",\"synthMaxUs\":" + String(softSynth.maxBlockUs) +
+                  ",\"synthVoices\":" + String(softSynth.activeVoices) +
+                  ",\"synthUnderruns\":" + String(softSynth.underruns) +
+                  ",\"midiErrUs\":" + String(midiScheduler.lastErrUs) +
+                  ",\"midiErrMaxUs\":" + String(midiScheduler.maxErrUs) +
+                  ",\"midiErrAvgUs\":" + String(midiScheduler.avgErrUs()) +
+                  ",\"midiDropped\":" + String(midiScheduler.droppedMsgs) +
                   ",\"mic\":" + (sysStatus.micReady ? "true" : "false") +
                   ",\"proxLight\":" + (sysStatus.proxLightReady ? "true" : "false") +
                   ",\"soundEnabled\":" + (botSounds.enabled ? "true" : "false") +
@@ -1125,8 +1203,9 @@ extern void wledSetEnabled(bool on);
 extern void wledSetColor(uint8_t r, uint8_t g, uint8_t b);
 extern void wledSetSpeed(uint8_t spd);
 extern void wledSetIx(uint8_t ix);
+extern void wledSetFont(uint8_t font);
 extern String getWledStatusJson();
-extern void wledQueueText(const char* text, uint16_t durationMs);
+extern void wledRequestTest();
 extern void wledSetHologram(bool on);
 
 void handleWledStatus() {
@@ -1146,6 +1225,9 @@ void handleWledConfig() {
   if (server.hasArg("ix")) {
     wledSetIx(constrain(server.arg("ix").toInt(), 0, 255));
   }
+  if (server.hasArg("font")) {
+    wledSetFont(constrain(server.arg("font").toInt(), 0, 255));
+  }
   if (server.hasArg("hologram")) {
     wledSetHologram(server.arg("hologram").toInt() == 1);
   }
@@ -1159,7 +1241,7 @@ void handleWledConfig() {
 }
 
 void handleWledTest() {
-  wledQueueText("Hello", 5000);
+  wledRequestTest();  // Drawn on Core 1 — only the render loop publishes frames
   server.send(200, "text/plain", "OK");
 }
 
@@ -1241,6 +1323,8 @@ void handleCloudSync() {
 #ifdef TARGET_CORES3
 extern struct BotSounds botSounds;
 extern struct AudioAnalysis audioAnalysis;
+extern struct AudioFeatures audioFeatures;
+extern struct AudioCapture audioCapture;
 extern struct ProxLightState proxLight;
 
 void handleBotSound() {
@@ -1284,11 +1368,133 @@ void handleBotMic() {
                 ",\"spike\":" + (audioAnalysis.spikeDetected ? "true" : "false") +
                 ",\"speech\":" + (audioAnalysis.speechDetected ? "true" : "false") +
                 ",\"enabled\":" + (audioAnalysis.enabled ? "true" : "false") +
-                "}";
+                ",\"bands\":[";
+  for (uint8_t b = 0; b < AUDIO_NUM_BANDS; b++) {
+    if (b > 0) json += ",";
+    json += String(audioFeatures.bandLevel[b], 3);
+  }
+  json += "],\"flux\":" + String(audioFeatures.flux, 2) +
+          ",\"onset\":" + (audioAnalysis.onsetDetected ? "true" : "false") +
+          ",\"beat\":" + (audioAnalysis.beatDetected ? "true" : "false") +
+          ",\"bpm\":" + String(audioFeatures.bpm, 1) +
+          ",\"tempoConf\":" + String(audioFeatures.tempoConfidence, 2) +
+          ",\"fftUs\":" + String(audioFeatures.lastCostUs) +
+          ",\"fftMaxUs\":" + String(audioFeatures.maxCostUs) +
+          ",\"latencyMs\":" + String(audioCapture.latencyMs()) +
+          ",\"overruns\":" + String(audioCapture.overruns) +
+          "}";
   server.send(200, "application/json", json);
 }
 #endif
 
+// ============================================================================
+// Mesh Clock Endpoints — sync status + play at mesh time
+// ============================================================================
+// Defined in esp_now_mesh.h (included after this file)
+extern bool meshIsInitialized();
+extern bool meshClockSynced();
+extern bool meshIsClockMaster();
+extern uint32_t meshClockMasterId();
+extern uint8_t meshClockStratum();
+extern int64_t meshClockOffsetUs();
+extern float meshClockDriftPpm();
+extern uint32_t meshClockRttUs();
+extern int32_t meshClockResidualUs();
+extern uint32_t meshPlayLateDropCount();
+extern uint32_t meshPlayRejectedCount();
+extern bool meshGetPeerClock(uint8_t i, uint8_t& deviceId, int32_t& errUs, uint32_t& rttUs,
+                             uint32_t& ageMs, bool& synced);
+extern bool meshPlayAt(uint8_t action, uint16_t arg, const char* text, uint32_t leadMs);
+extern int8_t meshPlayActionFromName(const char* name);
+extern void meshGetStats(uint32_t& txFrames, uint32_t& txThrottled, uint32_t& rxFrames,
+                         uint32_t& rxRejected, uint32_t& rxThrottled, uint32_t& rxLost);
+extern uint8_t meshGetPeerCapacity();
+extern uint8_t meshGetPeerHops(uint8_t i);
+extern void meshGetRelayStats(uint32_t& forwarded, uint32_t& suppressed, uint32_t& dropped,
+                              uint32_t& duplicates);
+extern uint8_t meshPeersForIP(uint32_t ip);
+extern bool meshAnyPeerWledActiveForIP(uint32_t ip);
+
+void handleBotMesh() {
+  String json = "{\"ready\":" + String(meshIsInitialized() ? "true" : "false") +
+                ",\"synced\":" + (meshClockSynced() ? "true" : "false") +
+                ",\"master\":" + (meshIsClockMaster() ? "true" : "false") +
+                ",\"masterId\":" + String(meshClockMasterId()) +
+                ",\"stratum\":" + String(meshClockStratum()) +
+                ",\"offsetUs\":" + String((long)meshClockOffsetUs()) +
+                ",\"driftPpm\":" + String(meshClockDriftPpm(), 2) +
+                ",\"rttUs\":" + String(meshClockRttUs()) +
+                ",\"residualUs\":" + String(meshClockResidualUs()) +
+                ",\"lateDrops\":" + String(meshPlayLateDropCount()) +
+                ",\"playRejected\":" + String(meshPlayRejectedCount());
+  uint32_t txFrames, txThrottled, rxFrames, rxRejected, rxThrottled, rxLost;
+  meshGetStats(txFrames, txThrottled, rxFrames, rxRejected, rxThrottled, rxLost);
+  json += ",\"tx\":" + String(txFrames) +
+          ",\"txThrottled\":" + String(txThrottled) +
+          ",\"rx\":" + String(rxFrames) +
+          ",\"rxRejected\":" + String(rxRejected) +
+          ",\"rxThrottled\":" + String(rxThrottled) +
+          ",\"rxLost\":" + String(rxLost) +
+          ",\"capacity\":" + String(meshGetPeerCapacity());
+  uint32_t relayFwd, relaySuppressed, relayDropped, rxDuplicates;
+  meshGetRelayStats(relayFwd, relaySuppressed, relayDropped, rxDuplicates);
+  json += ",\"relay\":{\"forwarded\":" + String(relayFwd) +
+          ",\"suppressed\":" + String(relaySuppressed) +
+          ",\"dropped\":" + String(relayDropped) +
+          ",\"duplicates\":" + String(rxDuplicates) + "}";
+  uint32_t wledIP = wledGetIPAsU32();
+  json += ",\"wledPeers\":" + String(meshPeersForIP(wledIP)) +
+          ",\"wledActive\":" + (meshAnyPeerWledActiveForIP(wledIP) ? "true" : "false");
+  uint32_t arbiterId, holderId;
+  uint8_t leaseQueued;
+  bool leaseHeld;
+  uint32_t leaseWaitMs, leaseMaxWaitMs, leaseGrants, leaseRevokes;
+  wledLeaseGetStatus(arbiterId, holderId, leaseQueued, leaseHeld, leaseWaitMs, leaseMaxWaitMs,
+                     leaseGrants, leaseRevokes);
+  json += ",\"lease\":{\"arbiter\":" + String(arbiterId) +
+          ",\"holder\":" + (holderId == WLED_LEASE_NONE ? String("null") : String(holderId)) +
+          ",\"held\":" + (leaseHeld ? "true" : "false") +
+          ",\"queued\":" + String(leaseQueued) +
+          ",\"waitMs\":" + String(leaseWaitMs) +
+          ",\"maxWaitMs\":" + String(leaseMaxWaitMs) +
+          ",\"grants\":" + String(leaseGrants) +
+          ",\"revokes\":" + String(leaseRevokes) + "}" +
+          ",\"peers\":[";
+  uint8_t id;
+  int32_t errUs;
+  uint32_t rttUs, ageMs;
+  bool synced;
+  for (uint8_t i = 0; meshGetPeerClock(i, id, errUs, rttUs, ageMs, synced); i++) {
+    if (i > 0) json += ",";
+    json += "{\"id\":" + String(id) +
+            ",\"hops\":" + String(meshGetPeerHops(i)) +
+            ",\"errUs\":" + String(errUs) +
+            ",\"rttUs\":" + String(rttUs) +
+            ",\"ageMs\":" + (ageMs == UINT32_MAX ? String("null") : String(ageMs)) +
+            ",\"synced\":" + (synced ? "true" : "false") + "}";
+  }
+  json += "]}";
+  server.send(200, "application/json", json);
+}
+
+// /bot/mesh/play?action=expression|say|sequence&v=<arg>&text=...&lead=<ms>
+void handleBotMeshPlay() {
+  String action = server.arg("action");
+  uint16_t arg = server.hasArg("v") ? constrain(server.arg("v").toInt(), 0, 65535) : 0;
+  uint32_t lead = server.hasArg("lead") ? constrain(server.arg("lead").toInt(), 50, 10000) : 300;
+  String text = server.arg("text");
+
+  int8_t kind = meshPlayActionFromName(action.c_str());
+  if (kind < 0) {
+    server.send(400, "text/plain", "action must be expression, say or sequence");
+    return;
+  }
+  if (action == "say" && !server.hasArg("v")) arg = 4000;  // Saying duration ms
+
+  bool ok = meshPlayAt(kind, arg, text.c_str(), lead);
+  server.send(200, "text/plain", ok ? "OK" : "Local only");
+}
+
 // ============================================================================
 // Captive Portal — redirect OS connectivity checks to control page
 // ============================================================================
@@ -1306,34 +1512,192 @@ extern void saveScheduleSettings();
 
 void handleSchedule() {
   bool changed = false;
+  bool wasEnabled = schedContent.enabled;
   if (server.hasArg("enabled")) {
-    bool wasEnabled = schedContent.enabled;
     schedContent.enabled = server.arg("enabled") == "1";
     changed = true;
-    // First enable: trigger first cycle in ~1 minute instead of waiting full interval
-    if (schedContent.enabled && !wasEnabled) {
-      schedContent.lastCycleStartMs = millis() - schedContent.cycleIntervalMs + 60000;
-    }
   }
   if (server.hasArg("intervalMin")) {
     uint32_t min = constrain(server.arg("intervalMin").toInt(), 1, 120);
     schedContent.cycleIntervalMs = min * 60000;
     changed = true;
   }
-  if (changed) saveScheduleSettings();
+  if (server.hasArg("cron")) {
+    // Empty = back to the interval. A bad expression falls back to it too.
+    String cron = server.arg("cron");
+    cron.trim();
+    TimelineCron parsed;
+    if (cron.length() == 0 || (cron.length() < sizeof(schedContent.cron) &&
+                               timelineCronParse(cron.c_str(), parsed))) {
+      cron.toCharArray(schedContent.cron, sizeof(schedContent.cron));
+      changed = true;
+    }
+  }
+  if (server.hasArg("tzMin")) {
+    schedContent.utcOffsetMin = constrain(server.arg("tzMin").toInt(), -840, 840);
+    changed = true;
+  }
+  if (changed) {
+    saveScheduleSettings();
+    // First enable: trigger first cycle in ~1 minute instead of waiting full interval
+    schedRebuild(schedContent.enabled && !wasEnabled ? SCHED_FIRST_CYCLE_MS : schedContent.cycleIntervalMs);
+  }
 
   String json = "{\"enabled\":";
   json += schedContent.enabled ? "true" : "false";
   json += ",\"intervalMin\":";
   json += schedContent.cycleIntervalMs / 60000;
+  json += ",\"cron\":\"";
+  json += schedContent.cron;
+  json += "\",\"tzMin\":";
+  json += schedContent.utcOffsetMin;
   json += ",\"phase\":";
   json += (uint8_t)schedContent.phase;
   json += ",\"isOwner\":";
   json += schedContent.isOwner ? "true" : "false";
+  json += ",\"timeline\":";
+  json += getTimelineStatusJson();
   json += "}";
   server.send(200, "application/json", json);
 }
 
+// ============================================================================
+// Animation Handlers — GIFs in /anim on LittleFS
+// ============================================================================
+
+extern void cmdPlayAnim(const char* name, uint8_t target, uint16_t loops);
+extern void cmdStopAnim();
+
+// The name becomes a path: letters, digits, '-' and '_' only
+static bool animNameOk(const String& name) {
+  if (name.length() == 0 || name.length() >= ANIM_NAME_LEN) return false;
+  for (size_t i = 0; i < name.length(); i++) {
+    char c = name[i];
+    if (!isalnum((uint8_t)c) && c != '-' && c != '_') return false;
+  }
+  return true;
+}
+
+static String animPath(const String& name) {
+  return String(ANIM_DIR "/") + name + ".gif";
+}
+
+void handleAnimPlay() {
+  String name = server.arg("name");
+  if (!animNameOk(name)) {
+    server.send(400, "text/plain", "Invalid name");
+    return;
+  }
+  if (!sysStatus.littlefsReady || !LittleFS.exists(animPath(name))) {
+    server.send(404, "text/plain", "Animation not found");
+    return;
+  }
+  String t = server.arg("target");
+  uint8_t target = t == "both" ? (ANIM_TARGET_LCD | ANIM_TARGET_WLED)
+                 : t == "wled" ? ANIM_TARGET_WLED : ANIM_TARGET_LCD;
+  uint16_t loops = server.hasArg("loops") ? constrain(server.arg("loops").toInt(), 0, 1000) : 0;
+  cmdPlayAnim(name.c_str(), target, loops);
+  server.send(200, "text/plain", "OK");
+}
+
+void handleAnimStop() {
+  cmdStopAnim();
+  server.send(200, "text/plain", "OK");
+}
+
+void handleAnimStatus() {
+  server.send(200, "application/json", getAnimStatusJson());
+}
+
+void handleAnimDelete() {
+  String name = server.arg("name");
+  if (!animNameOk(name)) {
+    server.send(400, "text/plain", "Invalid name");
+    return;
+  }
+  if (animPlaying(name.c_str())) {
+    server.send(409, "text/plain", "Playing");
+    return;
+  }
+  bool ok = sysStatus.littlefsReady && LittleFS.remove(animPath(name));
+  server.send(ok ? 200 : 404, "text/plain", ok ? "OK" : "Animation not found");
+}
+
+// Upload goes to a .tmp file and is renamed into place once complete, so a
+// failed upload never leaves half a GIF behind. animUploadError holds the
+// outcome for handleAnimUploadResult(), which re-arms it with "No file" so
+// a request without a file part can't report an earlier upload's result.
+static const char* const animUploadNoFile = "No file";
+static File animUploadFile;
+static String animUploadName;
+static const char* animUploadError = animUploadNoFile;
+
+static void handleAnimUpload() {
+  HTTPUpload& upload = server.upload();
+
+  if (upload.status == UPLOAD_FILE_START) {
+    animUploadError = nullptr;
+    animUploadName = server.hasArg("name") ? server.arg("name") : upload.filename;
+    if (animUploadName.endsWith(".gif")) animUploadName.remove(animUploadName.length() - 4);
+    if (!sysStatus.littlefsReady) {
+      animUploadError = "No filesystem";
+    } else if (!animNameOk(animUploadName)) {
+      animUploadError = "Invalid name";
+    } else if (animPlaying(animUploadName.c_str())) {
+      animUploadError = "Playing";
+    } else {
+      if (!LittleFS.exists(ANIM_DIR)) LittleFS.mkdir(ANIM_DIR);
+      animUploadFile = LittleFS.open(animPath(animUploadName) + ".tmp", "w");
+      if (!animUploadFile) animUploadError = "Open failed";
+    }
+
+  } else if (upload.status == UPLOAD_FILE_WRITE) {
+    if (animUploadError) return;
+    if (upload.totalSize == 0 && (upload.currentSize < 4 || memcmp(upload.buf, "GIF8", 4) != 0)) {
+      animUploadError = "Not a GIF";
+    } else if (LittleFS.totalBytes() - LittleFS.usedBytes() < upload.currentSize + 4096) {
+      animUploadError = "Filesystem full";
+    } else if (animUploadFile.write(upload.buf, upload.currentSize) != upload.currentSize) {
+      animUploadError = "Write failed";
+    }
+    if (animUploadError) {
+      animUploadFile.close();
+      LittleFS.remove(animPath(animUploadName) + ".tmp");
+    }
+
+  } else if (upload.status == UPLOAD_FILE_END) {
+    if (animUploadError) return;
+    animUploadFile.close();
+    String path = animPath(animUploadName);
+    // Playback may have started on this name while the body was arriving
+    if (animPlaying(animUploadName.c_str())) {
+      animUploadError = "Playing";
+      LittleFS.remove(path + ".tmp");
+      return;
+    }
+    LittleFS.remove(path);
+    if (!LittleFS.rename(path + ".tmp", path)) animUploadError = "Rename failed";
+    DBG("Anim upload: ");
+    DBG(path);
+    DBG(" ");
+    DBGLN(upload.totalSize);
+
+  } else if (upload.status == UPLOAD_FILE_ABORTED) {
+    if (animUploadFile) animUploadFile.close();
+    if (animNameOk(animUploadName)) LittleFS.remove(animPath(animUploadName) + ".tmp");
+    animUploadError = "Aborted";
+  }
+}
+
+static void handleAnimUploadResult() {
+  if (animUploadError) {
+    server.send(400, "application/json", String("{\"success\":false,\"error\":\"") + animUploadError + "\"}");
+  } else {
+    server.send(200, "application/json", "{\"success\":true}");
+  }
+  animUploadError = animUploadNoFile;
+}
+
 void handleCaptiveRedirect() {
   // In STA-only mode, no captive portal — just serve root
   String ip = sysStatus.staConnected ? sysStatus.staIP.toString() : WiFi.softAPIP().toString();
@@ -1388,6 +1752,10 @@ void setupWebServer() {
   server.on("/bot/mic", handleBotMic);
   #endif
 
+  // Mesh clock sync + synchronized playback
+  server.on("/bot/mesh", handleBotMesh);
+  server.on("/bot/mesh/play", handleBotMeshPlay);
+
   // Cloud endpoints
   #ifdef CLOUD_ENABLED
   server.on("/cloud/status", handleCloudStatus);
@@ -1397,6 +1765,13 @@ void setupWebServer() {
   // Schedule endpoints
   server.on("/schedule", handleSchedule);
 
+  // Animation endpoints
+  server.on("/anim/play", handleAnimPlay);
+  server.on("/anim/stop", handleAnimStop);
+  server.on("/anim/status", handleAnimStatus);
+  server.on("/anim/delete", handleAnimDelete);
+  server.on("/anim/upload", HTTP_POST, handleAnimUploadResult, handleAnimUpload);
+
   // OTA firmware update endpoints
   server.on("/update", HTTP_GET, handleOTAPage);
   server.on("/update", HTTP_POST, handleOTAResult, handleOTAUpload);
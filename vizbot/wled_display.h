@@ -8,7 +8,9 @@
 #include "config.h"
 #include "system_status.h"
 #include "wled_font.h"
-#include "emoji_sprites.h"
+#include "http_stream.h"
+#include <vizfx_sprites.h>
+#include "wled_lease.h"
 
 // WLED ownership gate — set by cloud_client.h after parsing sync response.
 // True = this bot is allowed to send emoji/weather DDP frames.
@@ -22,9 +24,13 @@ static bool wledStreamAllowed = true;
 // WLED-controlled LED matrix over UDP using DDP. This gives full creative
 // freedom — custom fonts, pixel art, sprites, animations.
 //
-// Cross-core design (matches wifi_provisioning.h pattern):
-//   Core 1 (render loop) calls wledQueueText() or wledQueueFrame()
-//   Core 0 (WiFi task)   calls pollWledDisplay() to send DDP + manage restore
+// Cross-core design:
+//   Core 1 (render loop) calls wledQueueText() or wledQueueFrame(), which
+//                        publish a finished frame into wledFrames
+//   Core 0 (WiFi task)   calls pollWledDisplay(), which takes the newest frame
+//                        to send over DDP + manage the hold and restore
+// Frames change hands through a lock-free triple buffer (wled_frame.h), so
+// neither core waits and a frame is never sent half-drawn.
 //
 // DDP is first-class in WLED (enabled by default since 0.13). WLED auto-enters
 // "realtime mode" on DDP frames and auto-resumes its previous effect when
@@ -47,6 +53,8 @@ static bool wledStreamAllowed = true;
 #define WLED_NUM_PIXELS      (WLED_DISPLAY_WIDTH * WLED_DISPLAY_HEIGHT)  // 256
 #define WLED_PIXEL_BYTES     (WLED_NUM_PIXELS * 3)                       // 768
 
+#include "wled_frame.h"
+
 // DDP protocol constants
 #define WLED_DDP_PORT        4048
 #define WLED_DDP_HEADER_SIZE 10
@@ -56,22 +64,26 @@ static bool wledStreamAllowed = true;
 
 // Timeouts
 #define WLED_HTTP_TIMEOUT_MS 500
+#define WLED_HTTP_IDLE_MS    100   // Silence after data that ends a response with no length
+
+// Socket read window for streamed JSON — the only buffer a state poll uses
+#define WLED_HTTP_WINDOW     128
 
 // Retry backoff after failure (don't spam unreachable device)
 #define WLED_RETRY_BACKOFF_MS 30000
 
-// How often to poll WLED palette when idle (faster than WLED's typical ~5s cycle)
+// Idle state poll, used only when WLED's WebSocket push (wled_ws.h) is down.
+// Starts at the minimum and doubles each time nothing changed, up to the max.
 #define WLED_PAL_POLL_INTERVAL_MS 1000
+#define WLED_PAL_POLL_MAX_MS      8000
+
+// Saved state older than this is re-read before taking over the display
+#define WLED_STATE_FRESH_MS       1500
 
 // ============================================================================
 // WLED State — shared between cores
 // ============================================================================
 
-enum WledSendState : uint8_t {
-  WLED_IDLE = 0,
-  WLED_FRAME_REQUESTED,       // DDP frame ready in pixel buffer
-};
-
 // Animation phases for hold timer
 enum WledPhase : uint8_t {
   WLED_PHASE_NONE = 0,        // Idle — nothing active
@@ -82,30 +94,26 @@ struct WledDisplayData {
   // Configuration (persisted in NVS)
   char ip[16];
   bool enabled;
-  uint8_t scrollSpeed;       // 0-255 (kept for NVS compatibility)
+  uint8_t scrollSpeed;       // 0-255, marquee scroll speed
   uint8_t textIx;            // 0-255 (kept for NVS compatibility)
+  uint8_t font;              // WledFontId for say text
   uint8_t r, g, b;           // text color
   bool hologramMode;         // horizontal mirror for Pepper's ghost prism
 
-  // Pixel buffer — 256 pixels × 3 bytes RGB (BSS, not stack)
-  uint8_t pixelBuffer[WLED_PIXEL_BYTES];
-
   // DDP transport (Core 0 only)
   WiFiUDP udp;
   uint8_t ddpSequence;
 
-  // Cross-core signaling (Core 1 writes, Core 0 reads)
-  volatile WledSendState sendState;
-  uint16_t frameDurationMs;
+  // Frame taken from wledFrames, waiting for the lease (Core 0 only)
+  const WledFrame* frame;
+  bool frameUnsent;
+  unsigned long frameLatencyMs;  // Publish → DDP send of the last frame
 
-  // Text buffer for wledQueueText compatibility (Core 1 writes, Core 0 reads)
-  char textBuffer[MAX_SAY_LEN];
+  // Core 0's own drawing surface — emoji and marquee frames
+  uint8_t sendBuf[WLED_PIXEL_BYTES];
 
-  // Word sequence state (for multi-word phrases)
-  char words[8][12];            // Up to 8 words, 11 chars each
-  uint8_t wordCount;            // Total words in current sequence
-  uint8_t currentWord;          // Index of word being displayed
-  uint16_t perWordDurationMs;   // Hold time per word
+  // Web test frame (Core 0 sets, Core 1 draws and clears)
+  volatile bool testRequested;
 
   // Saved segment state for restore (Core 0 only)
   int savedFx;
@@ -129,9 +137,13 @@ struct WledDisplayData {
   bool reachable;
   unsigned long lastFailTime;
   unsigned long lastPalPollMs;
+  uint16_t palPollMs;               // Current idle poll interval (adaptive)
+  unsigned long stateAtMs;          // When the saved state was last confirmed
+  uint32_t statePolls;              // Idle polls made (status page)
 };
 
 static WledDisplayData wledData = {};
+static WledFrameExchange wledFrames;
 
 // Parse IPv4 string "x.x.x.x" to uint32_t (network byte order)
 static uint32_t wledParseIPv4(const char* ip) {
@@ -162,6 +174,8 @@ void loadWledSettings() {
   wledData.enabled     = prefs.getBool("wledOn", true);
   wledData.scrollSpeed = prefs.getUChar("wledSpd", 200);
   wledData.textIx      = prefs.getUChar("wledIx", 128);
+  wledData.font        = prefs.getUChar("wledFont", WLED_FONT_ID_3X5);
+  if (wledData.font >= WLED_FONT_ID_COUNT) wledData.font = WLED_FONT_ID_3X5;
   wledData.r           = prefs.getUChar("wledR", 255);
   wledData.g           = prefs.getUChar("wledG", 255);
   wledData.b           = prefs.getUChar("wledB", 255);
@@ -174,7 +188,9 @@ void loadWledSettings() {
   prefs.end();
 
   wledData.reachable     = true;   // assume reachable until proven otherwise
-  wledData.sendState     = WLED_IDLE;
+  wledData.frame         = nullptr;
+  wledData.frameUnsent   = false;
+  wledData.testRequested = false;
   wledData.hasSavedState = false;
   wledData.restoreAtMs   = 0;
   wledData.savedFx       = -1;
@@ -182,10 +198,10 @@ void loadWledSettings() {
   wledData.phaseEndMs    = 0;
   wledData.ddpSequence   = 0;
   wledData.pendingPalSync = -1;
-  wledData.wordCount     = 0;
-  wledData.currentWord   = 0;
+  wledData.palPollMs     = WLED_PAL_POLL_INTERVAL_MS;
 
-  memset(wledData.pixelBuffer, 0, WLED_PIXEL_BYTES);
+  memset(wledData.sendBuf, 0, WLED_PIXEL_BYTES);
+  wledFrames.init();
 
   WLED_DBG("WLED: ");
   WLED_DBG(wledData.enabled ? "ON" : "OFF");
@@ -201,6 +217,7 @@ void saveWledSettings() {
   prefs.putBool("wledOn", wledData.enabled);
   prefs.putUChar("wledSpd", wledData.scrollSpeed);
   prefs.putUChar("wledIx", wledData.textIx);
+  prefs.putUChar("wledFont", wledData.font);
   prefs.putUChar("wledR", wledData.r);
   prefs.putUChar("wledG", wledData.g);
   prefs.putUChar("wledB", wledData.b);
@@ -211,34 +228,88 @@ void saveWledSettings() {
 }
 
 // ============================================================================
-// Pixel buffer drawing functions — called from Core 1
+// Pixel buffer drawing functions
 // ============================================================================
+// Every helper takes the buffer to draw into: Core 1 draws into
+// wledFrames.draft().px, Core 0 into wledData.sendBuf. Never draw into a
+// buffer the other core owns.
 
-void wledPixelClear() {
-  memset(wledData.pixelBuffer, 0, WLED_PIXEL_BYTES);
+void wledPixelClear(uint8_t* px) {
+  memset(px, 0, WLED_PIXEL_BYTES);
 }
 
-void wledPixelSet(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b) {
+void wledPixelSet(uint8_t* px, uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b) {
   if (x >= WLED_DISPLAY_WIDTH || y >= WLED_DISPLAY_HEIGHT) return;
   uint16_t offset = (y * WLED_DISPLAY_WIDTH + x) * 3;
-  wledData.pixelBuffer[offset]     = r;
-  wledData.pixelBuffer[offset + 1] = g;
-  wledData.pixelBuffer[offset + 2] = b;
+  px[offset]     = r;
+  px[offset + 1] = g;
+  px[offset + 2] = b;
 }
 
-void wledPixelFill(uint8_t r, uint8_t g, uint8_t b) {
+void wledPixelFill(uint8_t* px, uint8_t r, uint8_t g, uint8_t b) {
   for (uint16_t i = 0; i < WLED_PIXEL_BYTES; i += 3) {
-    wledData.pixelBuffer[i]     = r;
-    wledData.pixelBuffer[i + 1] = g;
-    wledData.pixelBuffer[i + 2] = b;
+    px[i]     = r;
+    px[i + 1] = g;
+    px[i + 2] = b;
   }
 }
 
-// Render centered text into the pixel buffer using the 3x5 font
-void wledPixelDrawText(const char* text, uint8_t r, uint8_t g, uint8_t b) {
-  wledFontDrawString(wledData.pixelBuffer,
-                     WLED_DISPLAY_WIDTH, WLED_DISPLAY_HEIGHT,
-                     text, r, g, b);
+// Perceived brightness (0-255) → LED drive level, gamma 2.2. WLED passes
+// realtime data straight to PWM, so an even-looking fade has to step
+// through this curve rather than scale linearly.
+static const uint8_t wledGamma8[256] PROGMEM = {
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1,
+    1,  1,  1,  1,  1,  1,  1,  1,  1,  2,  2,  2,  2,  2,  2,  2,
+    3,  3,  3,  3,  3,  4,  4,  4,  4,  5,  5,  5,  5,  6,  6,  6,
+    6,  7,  7,  7,  8,  8,  8,  9,  9,  9, 10, 10, 11, 11, 11, 12,
+   12, 13, 13, 13, 14, 14, 15, 15, 16, 16, 17, 17, 18, 18, 19, 19,
+   20, 20, 21, 22, 22, 23, 23, 24, 25, 25, 26, 26, 27, 28, 28, 29,
+   30, 30, 31, 32, 33, 33, 34, 35, 35, 36, 37, 38, 39, 39, 40, 41,
+   42, 43, 43, 44, 45, 46, 47, 48, 49, 49, 50, 51, 52, 53, 54, 55,
+   56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71,
+   73, 74, 75, 76, 77, 78, 79, 81, 82, 83, 84, 85, 87, 88, 89, 90,
+   91, 93, 94, 95, 97, 98, 99,100,102,103,105,106,107,109,110,111,
+  113,114,116,117,119,120,121,123,124,126,127,129,130,132,133,135,
+  137,138,140,141,143,145,146,148,149,151,153,154,156,158,159,161,
+  163,165,166,168,170,172,173,175,177,179,181,182,184,186,188,190,
+  192,194,196,197,199,201,203,205,207,209,211,213,215,217,219,221,
+  223,225,227,229,231,234,236,238,240,242,244,246,248,251,253,255,
+};
+
+// Copy a frame at a perceived brightness level — 255 is an exact copy,
+// 0 is black
+void wledPixelFade(uint8_t* dst, const uint8_t* src, uint8_t level) {
+  if (level == 255) {
+    memcpy(dst, src, WLED_PIXEL_BYTES);
+    return;
+  }
+  uint16_t k = pgm_read_byte(&wledGamma8[level]) + 1;   // +1 so 255 maps to 255
+  for (uint16_t i = 0; i < WLED_PIXEL_BYTES; i++) {
+    dst[i] = (src[i] * k) >> 8;
+  }
+}
+
+// Core 1 glyph cache — say text and weather cards
+static WledGlyphCache wledTextGlyphs = {};
+
+// Load a font into the Core 1 cache at the largest scale the matrix fits
+static WledGlyphCache& wledTextFont(uint8_t font) {
+  const WledFont* f = wledFontById(font);
+  if (!wledGlyphCacheLoad(wledTextGlyphs, f, wledFontFitScale(f, WLED_DISPLAY_HEIGHT))) {
+    wledGlyphCacheLoad(wledTextGlyphs, &WLED_FONT_3X5, 1);
+  }
+  return wledTextGlyphs;
+}
+
+// Render centered text into a pixel buffer in the configured font. A static
+// frame can't scroll, so text too wide for it falls back to the 3x5 font.
+// Core 1 only.
+void wledPixelDrawText(uint8_t* px, const char* text, uint8_t r, uint8_t g, uint8_t b) {
+  WledGlyphCache* c = &wledTextFont(wledData.font);
+  if (wledGlyphTextWidth(*c, text) > WLED_DISPLAY_WIDTH) {
+    c = &wledTextFont(WLED_FONT_ID_3X5);
+  }
+  wledGlyphDrawCentered(*c, px, WLED_DISPLAY_WIDTH, WLED_DISPLAY_HEIGHT, text, r, g, b);
 }
 
 // ============================================================================
@@ -263,10 +334,10 @@ static void wledRemapPixels(uint8_t* ddpOut, const uint8_t* logicalBuf) {
   }
 }
 
-// Send the pixel buffer to WLED via DDP over UDP.
+// Send a logical pixel buffer to WLED via DDP over UDP.
 // DDP header is 10 bytes, followed by 768 bytes of RGB data.
 // Total packet: 778 bytes — well within UDP MTU of 1472 bytes.
-bool wledSendDDP() {
+bool wledSendDDP(const uint8_t* px) {
   IPAddress targetIP;
   if (!targetIP.fromString(wledData.ip)) return false;
 
@@ -286,7 +357,7 @@ bool wledSendDDP() {
   wledData.ddpSequence = (wledData.ddpSequence + 1) & 0x0F;
 
   uint8_t ddpPayload[WLED_PIXEL_BYTES];
-  wledRemapPixels(ddpPayload, wledData.pixelBuffer);
+  wledRemapPixels(ddpPayload, px);
 
   if (!wledData.udp.beginPacket(targetIP, WLED_DDP_PORT)) return false;
   wledData.udp.write(header, WLED_DDP_HEADER_SIZE);
@@ -336,13 +407,16 @@ bool wledHttpPost(const char* jsonBody) {
   return (statusLine.indexOf("200") > 0);
 }
 
-// GET path, return response body (after headers)
-String wledHttpGet(const char* path) {
+// GET path and stream the JSON body through handler (json_stream.h) as it
+// arrives, through a small stack window — no String, no heap. Reading stops
+// as soon as the handler has what it needs. Returns true on HTTP 200 with the
+// body parsed or stopped by the handler.
+bool wledHttpGetJson(const char* path, JsonStreamHandler handler, void* ctx) {
   WiFiClient client;
   client.setTimeout(WLED_HTTP_TIMEOUT_MS);
 
   if (!client.connect(wledData.ip, 80)) {
-    return "";
+    return false;
   }
 
   client.printf("GET %s HTTP/1.1\r\n"
@@ -351,33 +425,76 @@ String wledHttpGet(const char* path) {
                 "\r\n",
                 path, wledData.ip);
 
-  unsigned long timeout = millis();
-  while (client.available() == 0) {
-    if (millis() - timeout > WLED_HTTP_TIMEOUT_MS) {
-      client.stop();
-      return "";
-    }
-  }
+  JsonStream js;
+  HttpStream http;
+  js.begin(handler, ctx);
+  http.begin(&js);
 
-  // Read until 100ms of silence — handles keep-alive connections that stay open
-  // after the response body is sent, without blocking for a full 2-second timeout.
-  String response = "";
+  // First byte within WLED_HTTP_TIMEOUT_MS, then until the body is complete,
+  // the handler stops, or WLED_HTTP_IDLE_MS of silence (keep-alive servers
+  // that leave the socket open)
+  uint8_t win[WLED_HTTP_WINDOW];
+  JsonStreamResult r = JSON_STREAM_MORE;
   unsigned long lastDataMs = millis();
-  while (client.connected() || client.available()) {
-    if (client.available()) {
-      response += (char)client.read();
+  while (r == JSON_STREAM_MORE) {
+    int avail = client.available();
+    if (avail > 0) {
+      int n = client.read(win, min(avail, (int)sizeof(win)));
+      if (n <= 0) break;
+      r = http.feed(win, n);
       lastDataMs = millis();
-    } else if (millis() - lastDataMs > 100) {
-      break;  // No new data for 100ms — response complete
+    } else if (!client.connected()) {
+      break;
+    } else if (millis() - lastDataMs > (http.status ? WLED_HTTP_IDLE_MS : WLED_HTTP_TIMEOUT_MS)) {
+      break;
     }
   }
   client.stop();
 
-  int bodyStart = response.indexOf("\r\n\r\n");
-  if (bodyStart >= 0) {
-    return response.substring(bodyStart + 4);
+  return http.status == 200 && (r == JSON_STREAM_DONE || r == JSON_STREAM_STOPPED);
+}
+
+// ============================================================================
+// Segment state — the seg[0] fields of /json/state
+// ============================================================================
+
+#define WLED_SEG_FX   0x01
+#define WLED_SEG_SX   0x02
+#define WLED_SEG_IX   0x04
+#define WLED_SEG_PAL  0x08
+#define WLED_SEG_NAME 0x10
+
+struct WledSegState {
+  const char* path;  // Where seg[0] sits: "seg/0", or "state/seg/0" in a push
+  int fx, sx, ix, pal;
+  char name[32];
+  uint8_t found;     // WLED_SEG_* for the fields present
+};
+
+// Picks fx/sx/ix/pal/n out of seg[0] and stops once seg[0] closes — the
+// effect list, info and the other segments are never read
+static bool wledSegHandler(JsonStream& js, void* ctx) {
+  WledSegState& seg = *(WledSegState*)ctx;
+  if (js.event == JSON_EV_END) return !js.at(seg.path);
+  if (!js.childOf(seg.path)) return true;
+
+  const char* key = js.keyAt(js.depth - 1);
+  if      (strcmp(key, "fx") == 0)  { seg.fx  = js.asInt(); seg.found |= WLED_SEG_FX; }
+  else if (strcmp(key, "sx") == 0)  { seg.sx  = js.asInt(); seg.found |= WLED_SEG_SX; }
+  else if (strcmp(key, "ix") == 0)  { seg.ix  = js.asInt(); seg.found |= WLED_SEG_IX; }
+  else if (strcmp(key, "pal") == 0) { seg.pal = js.asInt(); seg.found |= WLED_SEG_PAL; }
+  else if (strcmp(key, "n") == 0 && js.valueType == JSON_STRING) {
+    js.copyValue(seg.name, sizeof(seg.name));
+    seg.found |= WLED_SEG_NAME;
   }
-  return response;
+  return true;
+}
+
+// Fetch seg[0] of /json/state. Returns false if WLED didn't answer.
+bool wledFetchSegState(WledSegState& seg) {
+  memset(&seg, 0, sizeof(seg));
+  seg.path = "seg/0";
+  return wledHttpGetJson("/json/state", wledSegHandler, &seg);
 }
 
 // ============================================================================
@@ -417,59 +534,44 @@ inline int8_t wledMapPalette(int wledPal) {
   return 0;  // Unknown WLED palette → Rainbow
 }
 
-bool wledCaptureState() {
-  String json = wledHttpGet("/json/state");
-  if (json.length() == 0) return false;
-
-  int segIdx = json.indexOf("\"seg\"");
-  if (segIdx < 0) return false;
-
-  // Find first segment object
-  int segStart = json.indexOf('{', segIdx);
-  if (segStart < 0) return false;
-  int segEnd = json.indexOf('}', segStart);
-  if (segEnd < 0) return false;
-
-  String seg = json.substring(segStart, segEnd + 1);
-
-  // Parse int fields
-  auto findInt = [&](const char* key, int& out) -> bool {
-    char pattern[16];
-    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
-    int idx = seg.indexOf(pattern);
-    if (idx >= 0) {
-      out = seg.substring(idx + strlen(pattern)).toInt();
-      return true;
-    }
-    return false;
-  };
-
-  wledData.savedFx = -1;
-  findInt("fx", wledData.savedFx);
-  findInt("sx", wledData.savedSx);
-  findInt("ix", wledData.savedIx);
-  findInt("pal", wledData.savedPal);
+// Take seg[0] as the state to restore and queue its palette for Core 1.
+// Shared by the HTTP capture and the WebSocket push. Returns true if
+// anything differs from what was saved before.
+bool wledStoreSegState(const WledSegState& seg) {
+  int fx = (seg.found & WLED_SEG_FX) ? seg.fx : -1;
+  bool changed = fx != wledData.savedFx ||
+                 strncmp(seg.name, wledData.savedSegName, sizeof(wledData.savedSegName)) != 0 ||
+                 ((seg.found & WLED_SEG_SX)  && seg.sx  != wledData.savedSx) ||
+                 ((seg.found & WLED_SEG_IX)  && seg.ix  != wledData.savedIx) ||
+                 ((seg.found & WLED_SEG_PAL) && seg.pal != wledData.savedPal);
+
+  wledData.savedFx = fx;
+  if (seg.found & WLED_SEG_SX)  wledData.savedSx  = seg.sx;
+  if (seg.found & WLED_SEG_IX)  wledData.savedIx  = seg.ix;
+  if (seg.found & WLED_SEG_PAL) wledData.savedPal = seg.pal;
   wledData.pendingPalSync = wledMapPalette(wledData.savedPal);
-
-  // Parse segment name
-  wledData.savedSegName[0] = '\0';
-  int nIdx = seg.indexOf("\"n\":\"");
-  if (nIdx >= 0) {
-    nIdx += 5;
-    int nEnd = seg.indexOf("\"", nIdx);
-    if (nEnd > nIdx && (nEnd - nIdx) < 31) {
-      seg.substring(nIdx, nEnd).toCharArray(wledData.savedSegName, 32);
-    }
-  }
+  strncpy(wledData.savedSegName, seg.name, sizeof(wledData.savedSegName) - 1);
+  wledData.savedSegName[sizeof(wledData.savedSegName) - 1] = '\0';
 
   wledData.hasSavedState = (wledData.savedFx >= 0);
+  wledData.stateAtMs = millis();
+
+  if (changed) {
+    WLED_DBG("WLED captured: fx=");
+    WLED_DBG(wledData.savedFx);
+    WLED_DBG(" pal=");
+    WLED_DBG(wledData.savedPal);
+    WLED_DBG(" n=\"");
+    WLED_DBG(wledData.savedSegName);
+    WLED_DBGLN("\"");
+  }
+  return changed;
+}
 
-  WLED_DBG("WLED captured: fx=");
-  WLED_DBG(wledData.savedFx);
-  WLED_DBG(" n=\"");
-  WLED_DBG(wledData.savedSegName);
-  WLED_DBGLN("\"");
-
+bool wledCaptureState() {
+  WledSegState seg;
+  if (!wledFetchSegState(seg)) return false;
+  wledStoreSegState(seg);
   return wledData.hasSavedState;
 }
 
@@ -477,67 +579,54 @@ bool wledCaptureState() {
 // Queue functions — called from Core 1 (render loop)
 // ============================================================================
 
-// Queue a raw pixel frame for DDP transmission.
-// The pixel buffer must already be populated before calling this.
+// Publish the frame drawn into wledFrames.draft().px for DDP transmission.
+// Draw the whole frame first — the draft slot holds stale pixels.
 void wledQueueFrame(uint16_t durationMs) {
   if (!wledData.enabled) return;
   if (wledData.ip[0] == '\0') return;
   if (!sysStatus.staConnected) return;
 
-  wledData.frameDurationMs = durationMs;
-  wledData.sendState = WLED_FRAME_REQUESTED;
+  wledFrames.draft().text[0] = '\0';
+  wledFrames.publish(durationMs, WLED_LEASE_PRIO_STREAM);
 }
 
-// Queue text for display — renders into pixel buffer, then queues DDP frame.
-// Multi-word text is split into words and sequenced one at a time by pollWledDisplay().
+// Queue text for display — renders it into the draft frame and publishes it
+// with the text attached. Text that fits is centered; wider text is drawn
+// left-aligned and pollWledDisplay() scrolls it as a marquee (wled_marquee.h).
 void wledQueueText(const char* text, uint16_t durationMs) {
   if (!wledData.enabled) return;
   if (wledData.ip[0] == '\0') return;
   if (!sysStatus.staConnected) return;
 
-  // Store text for debug logging
-  strncpy(wledData.textBuffer, text, MAX_SAY_LEN - 1);
-  wledData.textBuffer[MAX_SAY_LEN - 1] = '\0';
-
-  // Check if text has spaces (multi-word)
-  bool hasSpace = false;
-  for (const char* p = text; *p; p++) {
-    if (*p == ' ') { hasSpace = true; break; }
-  }
+  WledFrame& f = wledFrames.draft();
+  strncpy(f.text, text, MAX_SAY_LEN - 1);
+  f.text[MAX_SAY_LEN - 1] = '\0';
+  f.font = wledData.font;   // The marquee scrolls in the font the frame was drawn in
 
-  if (!hasSpace) {
-    // Single word — render directly (existing behavior)
-    wledData.wordCount = 0;
-    wledPixelClear();
-    wledPixelDrawText(text, wledData.r, wledData.g, wledData.b);
-    wledData.frameDurationMs = durationMs;
-    wledData.sendState = WLED_FRAME_REQUESTED;
-    return;
-  }
-
-  // Multi-word: split by spaces into words[]
-  wledData.wordCount = 0;
-  const char* p = text;
-  while (*p && wledData.wordCount < 8) {
-    while (*p == ' ') p++;  // skip leading spaces
-    if (!*p) break;
-    uint8_t len = 0;
-    while (p[len] && p[len] != ' ' && len < 11) len++;
-    memcpy(wledData.words[wledData.wordCount], p, len);
-    wledData.words[wledData.wordCount][len] = '\0';
-    wledData.wordCount++;
-    p += len;
+  const WledGlyphCache& c = wledTextFont(f.font);
+  wledPixelClear(f.px);
+  if (wledGlyphTextWidth(c, f.text) <= WLED_DISPLAY_WIDTH) {
+    wledGlyphDrawCentered(c, f.px, WLED_DISPLAY_WIDTH, WLED_DISPLAY_HEIGHT, f.text,
+                          wledData.r, wledData.g, wledData.b);
+  } else {
+    wledGlyphDrawString(c, f.px, WLED_DISPLAY_WIDTH, WLED_DISPLAY_HEIGHT, 0,
+                        (WLED_DISPLAY_HEIGHT - c.height) / 2, f.text,
+                        wledData.r, wledData.g, wledData.b);
   }
+  wledFrames.publish(durationMs, WLED_LEASE_PRIO_SPEECH);
+}
 
-  // Per-word duration: total / wordCount, min 800ms
-  wledData.perWordDurationMs = max((uint16_t)(durationMs / wledData.wordCount), (uint16_t)800);
-  wledData.currentWord = 0;
+// Web "test" button — the handler runs on Core 0, which can't publish, so it
+// only raises the flag and the render loop draws the frame.
+void wledRequestTest() {
+  wledData.testRequested = true;
+}
 
-  // Render first word and queue
-  wledPixelClear();
-  wledPixelDrawText(wledData.words[0], wledData.r, wledData.g, wledData.b);
-  wledData.frameDurationMs = wledData.perWordDurationMs;
-  wledData.sendState = WLED_FRAME_REQUESTED;
+// Core 1 — call once per loop iteration
+void wledPollTestRequest() {
+  if (!wledData.testRequested) return;
+  wledData.testRequested = false;
+  wledQueueText("Hello", 5000);
 }
 
 // ============================================================================
@@ -545,27 +634,17 @@ void wledQueueText(const char* text, uint16_t durationMs) {
 // ============================================================================
 
 void wledPollPalette() {
-  String json = wledHttpGet("/json/state");
-  if (json.length() == 0) {
+  WledSegState seg;
+  if (!wledFetchSegState(seg)) {
     wledData.reachable = false;
     wledData.lastFailTime = millis();
     return;
   }
 
   wledData.reachable = true;
+  if (!(seg.found & WLED_SEG_PAL)) return;
 
-  int segIdx = json.indexOf("\"seg\"");
-  if (segIdx < 0) return;
-  int segStart = json.indexOf('{', segIdx);
-  if (segStart < 0) return;
-  int segEnd = json.indexOf('}', segStart);
-  if (segEnd < 0) return;
-
-  String seg = json.substring(segStart, segEnd + 1);
-  int palIdx = seg.indexOf("\"pal\":");
-  if (palIdx < 0) return;
-
-  int pal = seg.substring(palIdx + 6).toInt();
+  int pal = seg.pal;
   wledData.pendingPalSync = wledMapPalette(pal);
 
   WLED_DBG("WLED: pal poll wled=");
@@ -579,49 +658,69 @@ void wledPollPalette() {
 // ============================================================================
 #include "wled_emoji.h"
 
+// ============================================================================
+// WLED Marquee — smooth scrolling for text wider than the matrix
+// ============================================================================
+#include "wled_marquee.h"
+
+// ============================================================================
+// WLED WebSocket — state changes pushed from /ws, polling as the fallback
+// ============================================================================
+#include "wled_ws.h"
+
 // ============================================================================
 // Poll — called from Core 0 (WiFi task)
 // ============================================================================
 
 void pollWledDisplay() {
-  // Emoji display mode — continuous DDP stream (gated by ownership)
-  if (wledStreamAllowed) {
-    wledEmojiUpdate();
+  // State pushes — drained every pass, whatever else is going on
+  wledWsPoll();
+
+  // Emoji display mode — continuous DDP stream (gated by ownership + lease)
+  if (wledStreamAllowed && wledEmoji.active) {
+    wledLeaseRequest(WLED_LEASE_PRIO_STREAM, WLED_LEASE_STREAM_MS);
+    if (wledLeaseRevoked()) {
+      // Speech or a long-waiting stream is queued — step aside and rejoin the
+      // back of the queue. WLED resumes its own effect after the DDP timeout.
+      wledLeaseRelease();
+    } else if (wledLeaseHeld()) {
+      wledEmojiUpdate();
+    } else {
+      wledEmoji.lastSendMs = 0;  // Resend at once when the lease comes back
+    }
   }
   if (wledEmoji.active) return;  // emoji mode owns WLED, skip normal logic
 
-  // ---- Hold complete → advance word or restore ----
+  // ---- Take the newest published frame (replaces one still waiting) ----
+  const WledFrame* fresh = wledFrames.acquire();
+  if (fresh) {
+    wledData.frame = fresh;
+    wledData.frameUnsent = true;
+  }
+
+  // ---- Lease lost or revoked mid-hold → stop scrolling, restore now ----
+  if (wledData.phase == WLED_PHASE_HOLD && (!wledLeaseHeld() || wledLeaseRevoked())) {
+    WLED_DBGLN("WLED: lease ended, cutting hold short");
+    wledData.phaseEndMs = millis();
+  }
+
+  // ---- Holding a long message → stream the next marquee frame ----
+  if (wledData.phase == WLED_PHASE_HOLD && millis() < wledData.phaseEndMs &&
+      !wledMarqueeUpdate()) {
+    // DDP failed — give up on the rest of the message
+    wledData.phaseEndMs = millis();
+  }
+
+  // ---- Hold complete → restore ----
   if (wledData.phase == WLED_PHASE_HOLD && millis() >= wledData.phaseEndMs) {
-    // New content already queued — skip restore, let new frame take priority
-    if (wledData.sendState == WLED_FRAME_REQUESTED) {
+    wledMarqueeStop();
+    wledData.phase = WLED_PHASE_NONE;
+    if (wledData.frameUnsent) {
+      // New content already queued — skip restore, let new frame take priority
       WLED_DBGLN("WLED: hold expired but new frame queued — skipping restore");
-      wledData.phase = WLED_PHASE_NONE;
-      wledData.wordCount = 0;
       wledData.restoreAtMs = 0;
-      // Falls through to FRAME_REQUESTED handling below
-    }
-    // Multi-word sequence: advance to next word
-    else if (wledData.wordCount > 0 && wledData.currentWord + 1 < wledData.wordCount) {
-      wledData.currentWord++;
-      wledPixelClear();
-      wledPixelDrawText(wledData.words[wledData.currentWord],
-                        wledData.r, wledData.g, wledData.b);
-
-      if (wledSendDDP()) {
-        wledData.phaseEndMs = millis() + wledData.perWordDurationMs;
-        WLED_DBG("WLED: word ");
-        WLED_DBG(wledData.currentWord);
-        WLED_DBG("/");
-        WLED_DBGLN(wledData.wordCount);
-      } else {
-        // DDP failed — fall through to restore
-        wledData.phase = WLED_PHASE_NONE;
-        wledData.restoreAtMs = millis();
-      }
+      // Falls through to the send below
     } else {
-      // No more words — restore
-      wledData.wordCount = 0;
-      wledData.phase = WLED_PHASE_NONE;
       wledData.restoreAtMs = millis();
       WLED_DBGLN("WLED: hold done, restoring");
     }
@@ -651,12 +750,14 @@ void pollWledDisplay() {
       }
       // Keep hasSavedState=true — WLED just resumed these exact values, so
       // the saved state is still valid for the next say (skips inline capture).
-      // The idle poll will refresh it in the background within 1 second.
+      // A push or the idle poll picks up any later change.
+      wledData.stateAtMs = millis();
     } else {
       // No saved state to restore — just clear wledActive
       extern void meshSetWledActive(bool);
       meshSetWledActive(false);
     }
+    wledLeaseRelease();
 
     // Resume scheduled content after speech completes
     extern void schedOnSpeechEnd();
@@ -664,37 +765,59 @@ void pollWledDisplay() {
   }
 
   // ---- Send DDP frame (checked before idle poll — urgent requests skip blocking HTTP) ----
-  if (wledData.sendState != WLED_FRAME_REQUESTED) {
+  if (!wledData.frameUnsent) {
     // Skip idle poll if WLED unreachable (30s backoff, same as DDP sends)
     if (!wledData.reachable &&
         millis() - wledData.lastFailTime < WLED_RETRY_BACKOFF_MS) {
       return;
     }
-    // Nothing urgent — run periodic state capture so hasSavedState is ready for next say
+    // Nothing urgent — keep the saved state current so hasSavedState is
+    // ready for the next say. WLED pushes changes over /ws; only without it
+    // do we poll, backing off while nothing changes.
     if (wledData.enabled && wledData.ip[0] != '\0' && sysStatus.staConnected &&
-        wledData.phase == WLED_PHASE_NONE &&
-        millis() - wledData.lastPalPollMs >= WLED_PAL_POLL_INTERVAL_MS) {
-      wledData.lastPalPollMs = millis();
-      bool ok = wledCaptureState();  // captures palette AND full segment state
-      wledData.reachable = ok;
-      if (!ok) wledData.lastFailTime = millis();
+        wledData.phase == WLED_PHASE_NONE) {
+      if (wledWsRetryDue()) {
+        wledWsConnect();
+      } else if (wledWs.state == WLED_WS_CLOSED &&
+                 millis() - wledData.lastPalPollMs >= wledData.palPollMs) {
+        wledData.lastPalPollMs = millis();
+        wledData.statePolls++;
+        WledSegState seg;
+        bool ok = wledFetchSegState(seg);
+        wledData.reachable = ok;
+        if (!ok) {
+          wledData.lastFailTime = millis();
+        } else if (wledStoreSegState(seg)) {
+          wledData.palPollMs = WLED_PAL_POLL_INTERVAL_MS;
+        } else {
+          wledData.palPollMs = min(wledData.palPollMs * 2, WLED_PAL_POLL_MAX_MS);
+        }
+      }
     }
     return;
   }
 
-  // Mesh coordination: defer if a peer is sending DDP.
-  // Don't consume the request — leave sendState as WLED_FRAME_REQUESTED
-  // so we retry on the next poll cycle (~2ms) until the peer finishes.
-  extern bool meshAnyPeerWledActiveForIP(uint32_t);
-  extern uint32_t wledGetIPAsU32();
+  // Mesh coordination: send only while holding the WLED lease. The request
+  // is idempotent — we join the arbiter's queue once and keep the frame
+  // pending (frameUnsent stays set) until the grant arrives. A newer frame
+  // published meanwhile simply replaces it. A lease covers the whole hold —
+  // stretched to fit a scrolling message — plus the restore.
   extern void meshSetWledActive(bool);
-  if (meshAnyPeerWledActiveForIP(wledGetIPAsU32())) {
-    WLED_DBGLN("WLED: deferred — mesh peer active");
-    return;  // sendState stays WLED_FRAME_REQUESTED → retries next cycle
+  const WledFrame* f = wledData.frame;
+  if (wledLeaseRevoked()) {
+    wledLeaseRelease();  // Give way — the request below puts us back in line
+  }
+  unsigned long holdMs = max((unsigned long)f->holdMs,
+                             wledMarqueeDurationMs(f->text, f->font));
+  wledLeaseRequest(f->prio,
+                   (uint16_t)min((uint32_t)holdMs + 500, (uint32_t)WLED_LEASE_MAX_MS));
+  if (!wledLeaseHeld()) {
+    return;
   }
 
-  // Consume the request
-  wledData.sendState = WLED_IDLE;
+  // Consume the frame
+  wledData.frameUnsent = false;
+  wledMarqueeStop();
 
   // Check backoff
   if (!wledData.reachable) {
@@ -703,15 +826,20 @@ void pollWledDisplay() {
     }
   }
 
+  // Saved state is current if WLED pushes its changes or a poll just read
+  // it; a backed-off poll can be seconds old, so re-read it before taking over
+  bool midDisplay = wledData.phase == WLED_PHASE_HOLD || wledData.restoreAtMs > 0;
+  bool stateCurrent = wledWsOpen() || millis() - wledData.stateAtMs < WLED_STATE_FRESH_MS;
+
   // Cancel any active phase
   wledData.phase = WLED_PHASE_NONE;
   wledData.phaseEndMs = 0;
 
-  if (wledData.hasSavedState) {
-    // Already mid-display — keep original saved state, cancel pending restore
+  if (wledData.hasSavedState && (midDisplay || stateCurrent)) {
+    // Mid-display or known current — keep the saved state, cancel pending restore
     wledData.restoreAtMs = 0;
     WLED_DBG("WLED: replacing frame \"");
-    WLED_DBG(wledData.textBuffer);
+    WLED_DBG(f->text);
     WLED_DBGLN("\"");
   } else {
     // First frame — capture current state for later restore
@@ -720,23 +848,28 @@ void pollWledDisplay() {
     } else {
       WLED_DBG("WLED: capture failed, sending DDP \"");
     }
-    WLED_DBG(wledData.textBuffer);
+    WLED_DBG(f->text);
     WLED_DBGLN("\"");
   }
 
   meshSetWledActive(true);
 
-  // Send pixel buffer via DDP
-  if (wledSendDDP()) {
+  // Send the frame via DDP
+  if (wledSendDDP(f->px)) {
     wledData.reachable = true;
+    wledData.frameLatencyMs = millis() - f->publishedMs;
 
-    // Hold: frame displayed, wait for duration, then restore
+    // Hold: frame displayed, wait for duration, then restore. Long text
+    // scrolls from here on.
     wledData.phase = WLED_PHASE_HOLD;
-    wledData.phaseEndMs = millis() + wledData.frameDurationMs;
+    wledData.phaseEndMs = millis() + holdMs;
     wledData.restoreAtMs = 0;
+    wledMarqueeStart(f->text, f->font, wledData.r, wledData.g, wledData.b);
 
-    WLED_DBG("WLED: DDP frame for ");
-    WLED_DBG(wledData.frameDurationMs);
+    WLED_DBG("WLED: DDP frame #");
+    WLED_DBG(f->seq);
+    WLED_DBG(" for ");
+    WLED_DBG(holdMs);
     WLED_DBGLN("ms");
   } else {
     wledData.reachable = false;
@@ -754,6 +887,8 @@ void wledSetIP(const char* ip) {
   wledData.ip[15] = '\0';
   wledData.reachable = true;
   wledData.lastFailTime = 0;
+  wledData.palPollMs = WLED_PAL_POLL_INTERVAL_MS;
+  wledWsClose(0);   // Reconnect to the new address on the next idle pass
   saveWledSettings();
 }
 
@@ -762,6 +897,8 @@ void wledSetEnabled(bool on) {
   if (on) {
     wledData.reachable = true;
     wledData.lastFailTime = 0;
+  } else {
+    wledWsClose(0);
   }
   saveWledSettings();
 }
@@ -778,6 +915,12 @@ void wledSetSpeed(uint8_t spd) {
   saveWledSettings();
 }
 
+void wledSetFont(uint8_t font) {
+  if (font >= WLED_FONT_ID_COUNT) return;
+  wledData.font = font;
+  saveWledSettings();
+}
+
 void wledSetIx(uint8_t ix) {
   wledData.textIx = ix;
   saveWledSettings();
@@ -803,6 +946,8 @@ String getWledStatusJson() {
   json += wledData.scrollSpeed;
   json += ",\"ix\":";
   json += wledData.textIx;
+  json += ",\"font\":";
+  json += wledData.font;
   json += ",\"r\":";
   json += wledData.r;
   json += ",\"g\":";
@@ -811,7 +956,29 @@ String getWledStatusJson() {
   json += wledData.b;
   json += ",\"hologram\":";
   json += wledData.hologramMode ? "true" : "false";
-  json += "}";
+  json += ",\"sync\":{\"mode\":\"";
+  json += wledWsOpen() ? "ws" : "poll";
+  json += "\",\"pollMs\":";
+  json += wledData.palPollMs;
+  json += ",\"polls\":";
+  json += wledData.statePolls;
+  json += ",\"pushes\":";
+  json += wledWs.pushes;
+  json += "},\"frames\":{\"published\":";
+  json += wledFrames.published;
+  json += ",\"dropped\":";
+  json += wledFrames.dropped;
+  json += ",\"latencyMs\":";
+  json += wledData.frameLatencyMs;
+  json += "},\"marquee\":{\"active\":";
+  json += wledMarquee.active ? "true" : "false";
+  json += ",\"frames\":";
+  json += wledMarquee.frames;
+  json += ",\"buildUs\":";
+  json += wledMarquee.buildUs;
+  json += ",\"pxPerSec\":";
+  json += wledMarqueePxPerSec();
+  json += "}}";
   return json;
 }
 
@@ -11,8 +11,10 @@
 //          slot 0                slot 1                slot 2
 //          x=0..7               x=12..19              x=24..31
 //
-// Requires: emoji_sprites.h, wled_display.h functions (wledPixelClear,
-//           wledSendDDP, wledCaptureState, wledHttpPost, wledData)
+// Requires: vizfx_sprites.h, wled_display.h functions (wledPixelClear,
+//           wledSendDDP, wledCaptureState, wledHttpPost, wledData), wled_lease.h
+// Runs entirely on Core 0, so frames are drawn into wledData.sendBuf rather
+// than published through wledFrames.
 // Must be #included inside wled_display.h after those functions are defined.
 // ============================================================================
 
@@ -91,10 +93,10 @@ void wledEmojiClear() {
 }
 
 // ============================================================================
-// Rendering — per-slot, decode from PROGMEM directly into pixelBuffer
+// Rendering — per-slot, decode from PROGMEM directly into sendBuf
 // ============================================================================
 
-// Render one sprite at a slot position, scaled by alpha, ADDed to pixelBuffer.
+// Render one sprite at a slot position, scaled by alpha, ADDed to sendBuf.
 static void wledEmojiRenderSpriteScaled(uint8_t slot, uint8_t spriteIdx, uint8_t alpha) {
   if (slot >= WLED_EMOJI_SLOTS || spriteIdx >= ICON_COUNT || alpha == 0) return;
 
@@ -114,13 +116,13 @@ static void wledEmojiRenderSpriteScaled(uint8_t slot, uint8_t spriteIdx, uint8_t
 
       uint16_t offset = (y * WLED_DISPLAY_WIDTH + px) * 3;
       if (alpha == 255) {
-        wledData.pixelBuffer[offset]     = color.r;
-        wledData.pixelBuffer[offset + 1] = color.g;
-        wledData.pixelBuffer[offset + 2] = color.b;
+        wledData.sendBuf[offset]     = color.r;
+        wledData.sendBuf[offset + 1] = color.g;
+        wledData.sendBuf[offset + 2] = color.b;
       } else {
-        wledData.pixelBuffer[offset]     = qadd8(wledData.pixelBuffer[offset],     scale8(color.r, alpha));
-        wledData.pixelBuffer[offset + 1] = qadd8(wledData.pixelBuffer[offset + 1], scale8(color.g, alpha));
-        wledData.pixelBuffer[offset + 2] = qadd8(wledData.pixelBuffer[offset + 2], scale8(color.b, alpha));
+        wledData.sendBuf[offset]     = qadd8(wledData.sendBuf[offset],     scale8(color.r, alpha));
+        wledData.sendBuf[offset + 1] = qadd8(wledData.sendBuf[offset + 1], scale8(color.g, alpha));
+        wledData.sendBuf[offset + 2] = qadd8(wledData.sendBuf[offset + 2], scale8(color.b, alpha));
       }
     }
   }
@@ -128,7 +130,7 @@ static void wledEmojiRenderSpriteScaled(uint8_t slot, uint8_t spriteIdx, uint8_t
 
 // Clear buffer and render all 3 slots at their current alpha.
 static void wledEmojiRenderFrame() {
-  wledPixelClear();
+  wledPixelClear(wledData.sendBuf);
   for (uint8_t s = 0; s < WLED_EMOJI_SLOTS; s++) {
     if (wledEmoji.slotSprites[s] < 0 || wledEmoji.slotAlpha[s] == 0) continue;
     wledEmojiRenderSpriteScaled(s, (uint8_t)wledEmoji.slotSprites[s], wledEmoji.slotAlpha[s]);
@@ -196,10 +198,10 @@ void wledEmojiStart() {
     wledCaptureState();
   }
 
-  // Render initial frame (all black since alpha=0)
+  // Render initial frame (all black since alpha=0). It goes out from
+  // wledEmojiUpdate() once pollWledDisplay() holds the WLED lease.
   wledEmojiRenderFrame();
-  wledSendDDP();
-  wledEmoji.lastSendMs = millis();
+  wledEmoji.lastSendMs = 0;
 
   WLED_DBGLN("WLED emoji: started (3-slot sequential)");
 }
@@ -213,8 +215,9 @@ void wledEmojiStop() {
     wledEmoji.slotAlpha[s] = 0;
   }
 
-  // Restore WLED's normal effect
-  if (wledData.hasSavedState) {
+  // Restore WLED's normal effect — unless the lease moved on to another bot,
+  // which is drawing on it now
+  if (wledData.hasSavedState && wledLeaseHeld()) {
     char body[160];
     snprintf(body, sizeof(body),
       "{\"on\":true,\"live\":false,\"transition\":0,\"seg\":{\"id\":%d,\"fx\":%d,\"sx\":%d,\"ix\":%d,\"pal\":%d}}",
@@ -223,6 +226,8 @@ void wledEmojiStop() {
       wledData.savedIx, wledData.savedPal);
     wledHttpPost(body);
   }
+  // The lease itself is given back by pollWledLease() once it sits idle —
+  // a say that interrupted us (schedOnSpeechStart) picks it up instead
 
   WLED_DBGLN("WLED emoji: stopped, restored");
 }
@@ -373,7 +378,7 @@ void wledEmojiUpdate() {
 
   if (needSend) {
     wledEmojiRenderFrame();
-    wledSendDDP();
+    wledSendDDP(wledData.sendBuf);
     wledEmoji.lastSendMs = now;
   }
 }
@@ -4,272 +4,182 @@
 #include <Arduino.h>
 
 // ============================================================================
-// 3x5 Pixel Font — Compact bitmap font for 32x8 LED matrix
+// WLED Pixel Fonts — bitmap fonts and a RAM glyph cache for LED matrix text
 // ============================================================================
-// Each printable ASCII character (0x20–0x7E, 95 chars) is encoded as 3 bytes.
-// Each byte represents one column (LSB = top row, bit 4 = bottom row).
-// At 4px pitch (3px glyph + 1px gap), 8 characters fit in 32 pixels.
+// Fonts are compiled from BDF sources in scripts/fonts/ by
+// scripts/bdf-font-convert.js into wled_font_<name>.h. Each glyph is stored as
+// one byte per column (LSB = top row of the cell), in PROGMEM:
 //
-// Text is vertically centered on the 8-pixel display:
-//   Row 0: padding
-//   Rows 1–5: glyph
-//   Rows 6–7: padding
+//   3x5     fixed 4px pitch, capitals only — 8 characters across 32px
+//   5x7     fixed 6px pitch, true lowercase
+//   prop8   proportional, 6px capitals + 2px descenders, ~3px average
+//
+// Drawing never reads the PROGMEM tables directly. wledGlyphCacheLoad()
+// expands a font once into a WledGlyphCache: per-glyph start/width and one
+// 32-bit row mask per column, already stretched to the requested scale. A
+// blit is then a walk over the set bits of each mask (ctz), so blank columns
+// and rows cost nothing. Scale lets the same 8px fonts fill a 16- or 32-row
+// matrix: wledFontFitScale() picks the largest whole multiple that fits.
+//
+// A cache is single-owner state: each core keeps its own (wled_display.h for
+// Core 1 text, wled_marquee.h for Core 0 scrolling) and reloads it only when
+// the font or scale changes.
 // ============================================================================
 
-// 3 bytes per character, 95 printable ASCII characters (space through tilde)
-static const uint8_t PROGMEM WLED_FONT_3X5[95 * 3] = {
-  // 0x20 ' ' (space)
-  0x00, 0x00, 0x00,
-  // 0x21 '!'
-  0x00, 0x17, 0x00,
-  // 0x22 '"'
-  0x03, 0x00, 0x03,
-  // 0x23 '#'
-  0x0A, 0x1F, 0x0A,
-  // 0x24 '$'
-  0x12, 0x1F, 0x09,
-  // 0x25 '%'
-  0x09, 0x04, 0x12,
-  // 0x26 '&'
-  0x0A, 0x15, 0x1A,
-  // 0x27 '''
-  0x00, 0x03, 0x00,
-  // 0x28 '('
-  0x00, 0x0E, 0x11,
-  // 0x29 ')'
-  0x11, 0x0E, 0x00,
-  // 0x2A '*'
-  0x05, 0x02, 0x05,
-  // 0x2B '+'
-  0x04, 0x0E, 0x04,
-  // 0x2C ','
-  0x10, 0x08, 0x00,
-  // 0x2D '-'
-  0x04, 0x04, 0x04,
-  // 0x2E '.'
-  0x00, 0x10, 0x00,
-  // 0x2F '/'
-  0x08, 0x04, 0x02,
-  // 0x30 '0'
-  0x0E, 0x11, 0x0E,
-  // 0x31 '1'
-  0x12, 0x1F, 0x10,
-  // 0x32 '2'
-  0x19, 0x15, 0x12,
-  // 0x33 '3'
-  0x11, 0x15, 0x0A,
-  // 0x34 '4'
-  0x07, 0x04, 0x1F,
-  // 0x35 '5'
-  0x17, 0x15, 0x09,
-  // 0x36 '6'
-  0x0E, 0x15, 0x08,
-  // 0x37 '7'
-  0x01, 0x19, 0x07,
-  // 0x38 '8'
-  0x0A, 0x15, 0x0A,
-  // 0x39 '9'
-  0x02, 0x15, 0x0E,
-  // 0x3A ':'
-  0x00, 0x0A, 0x00,
-  // 0x3B ';'
-  0x10, 0x0A, 0x00,
-  // 0x3C '<'
-  0x04, 0x0A, 0x11,
-  // 0x3D '='
-  0x0A, 0x0A, 0x0A,
-  // 0x3E '>'
-  0x11, 0x0A, 0x04,
-  // 0x3F '?'
-  0x01, 0x15, 0x02,
-  // 0x40 '@'
-  0x0E, 0x15, 0x16,
-  // 0x41 'A'
-  0x1E, 0x05, 0x1E,
-  // 0x42 'B'
-  0x1F, 0x15, 0x0A,
-  // 0x43 'C'
-  0x0E, 0x11, 0x11,
-  // 0x44 'D'
-  0x1F, 0x11, 0x0E,
-  // 0x45 'E'
-  0x1F, 0x15, 0x11,
-  // 0x46 'F'
-  0x1F, 0x05, 0x01,
-  // 0x47 'G'
-  0x0E, 0x11, 0x1D,
-  // 0x48 'H'
-  0x1F, 0x04, 0x1F,
-  // 0x49 'I'
-  0x11, 0x1F, 0x11,
-  // 0x4A 'J'
-  0x08, 0x10, 0x0F,
-  // 0x4B 'K'
-  0x1F, 0x04, 0x1B,
-  // 0x4C 'L'
-  0x1F, 0x10, 0x10,
-  // 0x4D 'M'
-  0x1F, 0x02, 0x1F,
-  // 0x4E 'N'
-  0x1F, 0x06, 0x1F,
-  // 0x4F 'O'
-  0x0E, 0x11, 0x0E,
-  // 0x50 'P'
-  0x1F, 0x05, 0x02,
-  // 0x51 'Q'
-  0x0E, 0x19, 0x16,
-  // 0x52 'R'
-  0x1F, 0x05, 0x1A,
-  // 0x53 'S'
-  0x12, 0x15, 0x09,
-  // 0x54 'T'
-  0x01, 0x1F, 0x01,
-  // 0x55 'U'
-  0x0F, 0x10, 0x0F,
-  // 0x56 'V'
-  0x07, 0x18, 0x07,
-  // 0x57 'W'
-  0x1F, 0x08, 0x1F,
-  // 0x58 'X'
-  0x1B, 0x04, 0x1B,
-  // 0x59 'Y'
-  0x03, 0x1C, 0x03,
-  // 0x5A 'Z'
-  0x19, 0x15, 0x13,
-  // 0x5B '['
-  0x00, 0x1F, 0x11,
-  // 0x5C '\'
-  0x02, 0x04, 0x08,
-  // 0x5D ']'
-  0x11, 0x1F, 0x00,
-  // 0x5E '^'
-  0x02, 0x01, 0x02,
-  // 0x5F '_'
-  0x10, 0x10, 0x10,
-  // 0x60 '`'
-  0x00, 0x01, 0x02,
-  // 0x61 'a'
-  0x1E, 0x05, 0x1E,
-  // 0x62 'b'
-  0x1F, 0x15, 0x0A,
-  // 0x63 'c'
-  0x0E, 0x11, 0x11,
-  // 0x64 'd'
-  0x1F, 0x11, 0x0E,
-  // 0x65 'e'
-  0x1F, 0x15, 0x11,
-  // 0x66 'f'
-  0x1F, 0x05, 0x01,
-  // 0x67 'g'
-  0x0E, 0x11, 0x1D,
-  // 0x68 'h'
-  0x1F, 0x04, 0x1F,
-  // 0x69 'i'
-  0x11, 0x1F, 0x11,
-  // 0x6A 'j'
-  0x08, 0x10, 0x0F,
-  // 0x6B 'k'
-  0x1F, 0x04, 0x1B,
-  // 0x6C 'l'
-  0x1F, 0x10, 0x10,
-  // 0x6D 'm'
-  0x1F, 0x02, 0x1F,
-  // 0x6E 'n'
-  0x1F, 0x06, 0x1F,
-  // 0x6F 'o'
-  0x0E, 0x11, 0x0E,
-  // 0x70 'p'
-  0x1F, 0x05, 0x02,
-  // 0x71 'q'
-  0x0E, 0x19, 0x16,
-  // 0x72 'r'
-  0x1F, 0x05, 0x1A,
-  // 0x73 's'
-  0x12, 0x15, 0x09,
-  // 0x74 't'
-  0x01, 0x1F, 0x01,
-  // 0x75 'u'
-  0x0F, 0x10, 0x0F,
-  // 0x76 'v'
-  0x07, 0x18, 0x07,
-  // 0x77 'w'
-  0x1F, 0x08, 0x1F,
-  // 0x78 'x'
-  0x1B, 0x04, 0x1B,
-  // 0x79 'y'
-  0x03, 0x1C, 0x03,
-  // 0x7A 'z'
-  0x19, 0x15, 0x13,
-  // 0x7B '{'
-  0x04, 0x0E, 0x11,
-  // 0x7C '|'
-  0x00, 0x1F, 0x00,
-  // 0x7D '}'
-  0x11, 0x0E, 0x04,
-  // 0x7E '~'
-  0x02, 0x06, 0x04,
+#define WLED_FONT_MAX_GLYPHS   95    // Printable ASCII, 0x20–0x7E
+#define WLED_FONT_MAX_SCALE    4     // 8px × 4 = 32 rows, one uint32_t mask per column
+#define WLED_GLYPH_CACHE_COLS  512   // Columns of the widest font (5x7: 475)
+
+struct WledFont {
+  const char* name;
+  const uint8_t* cols;       // PROGMEM column masks, glyphs back to back
+  const uint16_t* offsets;   // PROGMEM first column per glyph, nullptr = fixed cell
+  const uint8_t* widths;     // PROGMEM columns per glyph, nullptr = fixed cell
+  uint8_t width;             // Cell width (fixed) or widest glyph (proportional)
+  uint8_t height;            // Rows, at most 8
+  uint8_t first;             // First character code
+  uint8_t count;             // Glyphs
+  uint8_t spacing;           // Blank columns between characters
+};
+
+#include "wled_font_3x5.h"
+#include "wled_font_5x7.h"
+#include "wled_font_prop8.h"
+
+enum WledFontId : uint8_t {
+  WLED_FONT_ID_3X5 = 0,
+  WLED_FONT_ID_5X7,
+  WLED_FONT_ID_PROP8,
+  WLED_FONT_ID_COUNT
+};
+
+static const WledFont* const WLED_FONTS[WLED_FONT_ID_COUNT] = {
+  &WLED_FONT_3X5, &WLED_FONT_5X7, &WLED_FONT_PROP8
 };
 
-// Font metrics
-#define WLED_FONT_CHAR_W   3   // Glyph width in pixels
-#define WLED_FONT_CHAR_H   5   // Glyph height in pixels
-#define WLED_FONT_PITCH    4   // Character pitch (3px glyph + 1px gap)
-#define WLED_FONT_Y_OFFSET 1   // Top padding for vertical centering on 8px display
+inline const WledFont* wledFontById(uint8_t id) {
+  return WLED_FONTS[id < WLED_FONT_ID_COUNT ? id : (uint8_t)WLED_FONT_ID_3X5];
+}
+
+// Largest whole scale at which the font fits in `rows` (at least 1)
+inline uint8_t wledFontFitScale(const WledFont* font, uint8_t rows) {
+  uint8_t s = rows / font->height;
+  return constrain(s, 1, WLED_FONT_MAX_SCALE);
+}
 
 // ============================================================================
-// Font rendering functions
+// Glyph cache
 // ============================================================================
 
-// Return pixel width of a string (no trailing gap)
-inline uint16_t wledFontStringWidth(const char* str) {
-  uint16_t len = 0;
-  while (*str) { len++; str++; }
-  if (len == 0) return 0;
-  return len * WLED_FONT_PITCH - 1;  // No gap after last char
+struct WledGlyphCache {
+  const WledFont* font;      // nullptr until loaded
+  uint8_t scale;
+  uint8_t height;            // font->height * scale
+  uint8_t spacing;           // font->spacing * scale
+  uint8_t fallback;          // Glyph index drawn for characters outside the font
+  uint16_t start[WLED_FONT_MAX_GLYPHS];  // First column in cols[]
+  uint8_t width[WLED_FONT_MAX_GLYPHS];   // Columns before horizontal scaling
+  uint32_t cols[WLED_GLYPH_CACHE_COLS];  // Row masks, vertically scaled, LSB = top
+};
+
+// Stretch a column mask vertically: each row becomes `scale` rows
+inline uint32_t wledGlyphStretch(uint8_t bits, uint8_t scale) {
+  uint32_t out = 0;
+  uint32_t run = (1UL << scale) - 1;
+  for (uint8_t y = 0; bits; y++, bits >>= 1) {
+    if (bits & 1) out |= run << (y * scale);
+  }
+  return out;
 }
 
-// Draw a single character into an RGB buffer.
-// buf: pointer to row-major RGB buffer (width * height * 3 bytes)
-// bufWidth: buffer width in pixels
-// cx, cy: top-left corner of glyph in buffer coordinates
-// r, g, b: glyph color
-inline void wledFontDrawChar(uint8_t* buf, uint16_t bufWidth, uint8_t bufHeight,
-                             int16_t cx, int16_t cy,
-                             char ch, uint8_t r, uint8_t g, uint8_t b) {
-  if (ch < 0x20 || ch > 0x7E) ch = '?';
-  uint16_t idx = (ch - 0x20) * 3;
+// Expand font into the cache at the given scale. No-op if it is already
+// loaded; returns false if the font doesn't fit (the cache is left empty).
+bool wledGlyphCacheLoad(WledGlyphCache& c, const WledFont* font, uint8_t scale) {
+  scale = constrain(scale, 1, WLED_FONT_MAX_SCALE);
+  if (c.font == font && c.scale == scale) return true;
 
-  for (uint8_t col = 0; col < WLED_FONT_CHAR_W; col++) {
-    uint8_t colBits = pgm_read_byte(&WLED_FONT_3X5[idx + col]);
-    for (uint8_t row = 0; row < WLED_FONT_CHAR_H; row++) {
-      if (colBits & (1 << row)) {
-        int16_t px = cx + col;
-        int16_t py = cy + row;
-        if (px >= 0 && px < (int16_t)bufWidth && py >= 0 && py < (int16_t)bufHeight) {
-          uint16_t offset = (py * bufWidth + px) * 3;
-          buf[offset]     = r;
-          buf[offset + 1] = g;
-          buf[offset + 2] = b;
-        }
-      }
+  c.font = nullptr;
+  uint8_t count = min(font->count, (uint8_t)WLED_FONT_MAX_GLYPHS);
+  uint16_t n = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    uint16_t src = font->offsets ? pgm_read_word(&font->offsets[i]) : i * font->width;
+    uint8_t w = font->widths ? pgm_read_byte(&font->widths[i]) : font->width;
+    if (n + w > WLED_GLYPH_CACHE_COLS) return false;
+    c.start[i] = n;
+    c.width[i] = w;
+    for (uint8_t k = 0; k < w; k++) {
+      c.cols[n++] = wledGlyphStretch(pgm_read_byte(&font->cols[src + k]), scale);
     }
   }
+  for (uint8_t i = count; i < WLED_FONT_MAX_GLYPHS; i++) {
+    c.start[i] = 0;
+    c.width[i] = 0;
+  }
+  c.scale = scale;
+  c.height = font->height * scale;
+  c.spacing = font->spacing * scale;
+  c.fallback = ('?' >= font->first && '?' < font->first + count) ? '?' - font->first : 0;
+  c.font = font;
+  return true;
 }
 
-// Draw a string centered horizontally, vertically offset by WLED_FONT_Y_OFFSET.
-// Renders into an RGB pixel buffer for a display of given dimensions.
-inline void wledFontDrawString(uint8_t* buf, uint16_t bufWidth, uint8_t bufHeight,
-                               const char* str, uint8_t r, uint8_t g, uint8_t b) {
-  uint16_t textW = wledFontStringWidth(str);
-  int16_t startX = ((int16_t)bufWidth - (int16_t)textW) / 2;
-  int16_t curX = startX;
+inline uint8_t wledGlyphIndex(const WledGlyphCache& c, char ch) {
+  uint8_t i = (uint8_t)ch - c.font->first;
+  return i < c.font->count ? i : c.fallback;
+}
 
-  while (*str) {
-    wledFontDrawChar(buf, bufWidth, bufHeight, curX, WLED_FONT_Y_OFFSET,
-                     *str, r, g, b);
-    curX += WLED_FONT_PITCH;
-    str++;
+// Pixel width of a string (no trailing gap)
+inline uint16_t wledGlyphTextWidth(const WledGlyphCache& c, const char* str) {
+  uint16_t w = 0;
+  for (const char* p = str; *p; p++) {
+    if (p != str) w += c.spacing;
+    w += c.width[wledGlyphIndex(c, *p)] * c.scale;
   }
+  return w;
+}
+
+// Draw a string with its top-left corner at (x, y), clipped to the buffer.
+// buf: row-major RGB, bufWidth x bufHeight. Returns the x after the last glyph.
+int16_t wledGlyphDrawString(const WledGlyphCache& c, uint8_t* buf,
+                            uint16_t bufWidth, uint8_t bufHeight,
+                            int16_t x, int16_t y, const char* str,
+                            uint8_t r, uint8_t g, uint8_t b) {
+  // Row clipping is the same for every column: fold it into one shift + mask
+  if (y >= (int16_t)bufHeight || y <= -(int16_t)c.height) return x;
+  uint8_t skip = y < 0 ? -y : 0;
+  uint8_t rows = min((int16_t)(bufHeight - y), (int16_t)32) - skip;
+  uint32_t keep = rows >= 32 ? 0xFFFFFFFFUL : (1UL << rows) - 1;
+  uint8_t* top = buf + (uint16_t)(y + skip) * bufWidth * 3;
+  uint16_t stride = bufWidth * 3;
+
+  for (const char* p = str; *p && x < (int16_t)bufWidth; p++) {
+    if (p != str) x += c.spacing;
+    uint8_t i = wledGlyphIndex(c, *p);
+    const uint32_t* col = &c.cols[c.start[i]];
+    for (uint8_t k = 0; k < c.width[i]; k++) {
+      uint32_t mask = (col[k] >> skip) & keep;
+      for (uint8_t s = 0; s < c.scale; s++, x++) {
+        if (!mask || x < 0 || x >= (int16_t)bufWidth) continue;
+        uint8_t* colTop = top + x * 3;
+        for (uint32_t m = mask; m; m &= m - 1) {
+          uint8_t* px = colTop + __builtin_ctzl(m) * stride;
+          px[0] = r;
+          px[1] = g;
+          px[2] = b;
+        }
+      }
+    }
+  }
+  return x;
+}
+
+// Draw a string centered in the buffer
+inline void wledGlyphDrawCentered(const WledGlyphCache& c, uint8_t* buf,
+                                  uint16_t bufWidth, uint8_t bufHeight,
+                                  const char* str, uint8_t r, uint8_t g, uint8_t b) {
+  int16_t x = ((int16_t)bufWidth - (int16_t)wledGlyphTextWidth(c, str)) / 2;
+  int16_t y = ((int16_t)bufHeight - (int16_t)c.height) / 2;
+  wledGlyphDrawString(c, buf, bufWidth, bufHeight, x, y, str, r, g, b);
 }
 
 #endif // WLED_FONT_H
@@ -0,0 +1,211 @@
+#ifndef WLED_FONT_3X5_H
+#define WLED_FONT_3X5_H
+
+// ============================================================================
+// wled-3x5 — generated by scripts/bdf-font-convert.js, do not edit
+// ============================================================================
+// Source: scripts/fonts/wled-3x5.bdf
+// Fixed 3x5 px, 1px spacing, 285 columns.
+// One byte per column, LSB = top row. Included by wled_font.h.
+// ============================================================================
+
+static const uint8_t PROGMEM WLED_FONT_3X5_COLS[285] = {
+  // 0x20 ' ' (space)
+  0x00, 0x00, 0x00,
+  // 0x21 '!'
+  0x00, 0x17, 0x00,
+  // 0x22 '"'
+  0x03, 0x00, 0x03,
+  // 0x23 '#'
+  0x0A, 0x1F, 0x0A,
+  // 0x24 '$'
+  0x12, 0x1F, 0x09,
+  // 0x25 '%'
+  0x09, 0x04, 0x12,
+  // 0x26 '&'
+  0x0A, 0x15, 0x1A,
+  // 0x27 '''
+  0x00, 0x03, 0x00,
+  // 0x28 '('
+  0x00, 0x0E, 0x11,
+  // 0x29 ')'
+  0x11, 0x0E, 0x00,
+  // 0x2A '*'
+  0x05, 0x02, 0x05,
+  // 0x2B '+'
+  0x04, 0x0E, 0x04,
+  // 0x2C ','
+  0x10, 0x08, 0x00,
+  // 0x2D '-'
+  0x04, 0x04, 0x04,
+  // 0x2E '.'
+  0x00, 0x10, 0x00,
+  // 0x2F '/'
+  0x08, 0x04, 0x02,
+  // 0x30 '0'
+  0x0E, 0x11, 0x0E,
+  // 0x31 '1'
+  0x12, 0x1F, 0x10,
+  // 0x32 '2'
+  0x19, 0x15, 0x12,
+  // 0x33 '3'
+  0x11, 0x15, 0x0A,
+  // 0x34 '4'
+  0x07, 0x04, 0x1F,
+  // 0x35 '5'
+  0x17, 0x15, 0x09,
+  // 0x36 '6'
+  0x0E, 0x15, 0x08,
+  // 0x37 '7'
+  0x01, 0x19, 0x07,
+  // 0x38 '8'
+  0x0A, 0x15, 0x0A,
+  // 0x39 '9'
+  0x02, 0x15, 0x0E,
+  // 0x3A ':'
+  0x00, 0x0A, 0x00,
+  // 0x3B ';'
+  0x10, 0x0A, 0x00,
+  // 0x3C '<'
+  0x04, 0x0A, 0x11,
+  // 0x3D '='
+  0x0A, 0x0A, 0x0A,
+  // 0x3E '>'
+  0x11, 0x0A, 0x04,
+  // 0x3F '?'
+  0x01, 0x15, 0x02,
+  // 0x40 '@'
+  0x0E, 0x15, 0x16,
+  // 0x41 'A'
+  0x1E, 0x05, 0x1E,
+  // 0x42 'B'
+  0x1F, 0x15, 0x0A,
+  // 0x43 'C'
+  0x0E, 0x11, 0x11,
+  // 0x44 'D'
+  0x1F, 0x11, 0x0E,
+  // 0x45 'E'
+  0x1F, 0x15, 0x11,
+  // 0x46 'F'
+  0x1F, 0x05, 0x01,
+  // 0x47 'G'
+  0x0E, 0x11, 0x1D,
+  // 0x48 'H'
+  0x1F, 0x04, 0x1F,
+  // 0x49 'I'
+  0x11, 0x1F, 0x11,
+  // 0x4A 'J'
+  0x08, 0x10, 0x0F,
+  // 0x4B 'K'
+  0x1F, 0x04, 0x1B,
+  // 0x4C 'L'
+  0x1F, 0x10, 0x10,
+  // 0x4D 'M'
+  0x1F, 0x02, 0x1F,
+  // 0x4E 'N'
+  0x1F, 0x06, 0x1F,
+  // 0x4F 'O'
+  0x0E, 0x11, 0x0E,
+  // 0x50 'P'
+  0x1F, 0x05, 0x02,
+  // 0x51 'Q'
+  0x0E, 0x19, 0x16,
+  // 0x52 'R'
+  0x1F, 0x05, 0x1A,
+  // 0x53 'S'
+  0x12, 0x15, 0x09,
+  // 0x54 'T'
+  0x01, 0x1F, 0x01,
+  // 0x55 'U'
+  0x0F, 0x10, 0x0F,
+  // 0x56 'V'
+  0x07, 0x18, 0x07,
+  // 0x57 'W'
+  0x1F, 0x08, 0x1F,
+  // 0x58 'X'
+  0x1B, 0x04, 0x1B,
+  // 0x59 'Y'
+  0x03, 0x1C, 0x03,
+  // 0x5A 'Z'
+  0x19, 0x15, 0x13,
+  // 0x5B '['
+  0x00, 0x1F, 0x11,
+  // 0x5C '\'
+  0x02, 0x04, 0x08,
+  // 0x5D ']'
+  0x11, 0x1F, 0x00,
+  // 0x5E '^'
+  0x02, 0x01, 0x02,
+  // 0x5F '_'
+  0x10, 0x10, 0x10,
+  // 0x60 '`'
+  0x00, 0x01, 0x02,
+  // 0x61 'a'
+  0x1E, 0x05, 0x1E,
+  // 0x62 'b'
+  0x1F, 0x15, 0x0A,
+  // 0x63 'c'
+  0x0E, 0x11, 0x11,
+  // 0x64 'd'
+  0x1F, 0x11, 0x0E,
+  // 0x65 'e'
+  0x1F, 0x15, 0x11,
+  // 0x66 'f'
+  0x1F, 0x05, 0x01,
+  // 0x67 'g'
+  0x0E, 0x11, 0x1D,
+  // 0x68 'h'
+  0x1F, 0x04, 0x1F,
+  // 0x69 'i'
+  0x11, 0x1F, 0x11,
+  // 0x6A 'j'
+  0x08, 0x10, 0x0F,
+  // 0x6B 'k'
+  0x1F, 0x04, 0x1B,
+  // 0x6C 'l'
+  0x1F, 0x10, 0x10,
+  // 0x6D 'm'
+  0x1F, 0x02, 0x1F,
+  // 0x6E 'n'
+  0x1F, 0x06, 0x1F,
+  // 0x6F 'o'
+  0x0E, 0x11, 0x0E,
+  // 0x70 'p'
+  0x1F, 0x05, 0x02,
+  // 0x71 'q'
+  0x0E, 0x19, 0x16,
+  // 0x72 'r'
+  0x1F, 0x05, 0x1A,
+  // 0x73 's'
+  0x12, 0x15, 0x09,
+  // 0x74 't'
+  0x01, 0x1F, 0x01,
+  // 0x75 'u'
+  0x0F, 0x10, 0x0F,
+  // 0x76 'v'
+  0x07, 0x18, 0x07,
+  // 0x77 'w'
+  0x1F, 0x08, 0x1F,
+  // 0x78 'x'
+  0x1B, 0x04, 0x1B,
+  // 0x79 'y'
+  0x03, 0x1C, 0x03,
+  // 0x7A 'z'
+  0x19, 0x15, 0x13,
+  // 0x7B '{'
+  0x04, 0x0E, 0x11,
+  // 0x7C '|'
+  0x00, 0x1F, 0x00,
+  // 0x7D '}'
+  0x11, 0x0E, 0x04,
+  // 0x7E '~'
+  0x02, 0x06, 0x04,
+};
+
+static const WledFont WLED_FONT_3X5 = {
+  "3x5", WLED_FONT_3X5_COLS,
+  nullptr, nullptr,
+  3, 5, 0x20, 95, 1
+};
+
+#endif // WLED_FONT_3X5_H
@@ -0,0 +1,231 @@
+#ifndef WLED_FONT_PROP8_H
+#define WLED_FONT_PROP8_H
+
+// ============================================================================
+// wled-prop8 — generated by scripts/bdf-font-convert.js, do not edit
+// ============================================================================
+// Source: scripts/fonts/wled-prop8.bdf
+// Proportional, up to 5x8 px, 1px spacing, 316 columns.
+// One byte per column, LSB = top row. Included by wled_font.h.
+// ============================================================================
+
+static const uint8_t PROGMEM WLED_FONT_PROP8_COLS[316] = {
+  // 0x20 ' ' (space)
+  0x00, 0x00,
+  // 0x21 '!'
+  0x2F,
+  // 0x22 '"'
+  0x03, 0x00, 0x03,
+  // 0x23 '#'
+  0x12, 0x3F, 0x12, 0x3F, 0x12,
+  // 0x24 '$'
+  0x24, 0x2A, 0x7F, 0x2A, 0x12,
+  // 0x25 '%'
+  0x13, 0x0B, 0x04, 0x1A, 0x19,
+  // 0x26 '&'
+  0x1A, 0x25, 0x2A, 0x10, 0x28,
+  // 0x27 '''
+  0x03,
+  // 0x28 '('
+  0x1E, 0x21,
+  // 0x29 ')'
+  0x21, 0x1E,
+  // 0x2A '*'
+  0x0A, 0x04, 0x0A,
+  // 0x2B '+'
+  0x08, 0x1C, 0x08,
+  // 0x2C ','
+  0x40, 0x20,
+  // 0x2D '-'
+  0x08, 0x08, 0x08,
+  // 0x2E '.'
+  0x20,
+  // 0x2F '/'
+  0x20, 0x18, 0x06, 0x01,
+  // 0x30 '0'
+  0x1E, 0x29, 0x25, 0x1E,
+  // 0x31 '1'
+  0x22, 0x3F, 0x20,
+  // 0x32 '2'
+  0x32, 0x29, 0x25, 0x22,
+  // 0x33 '3'
+  0x21, 0x25, 0x25, 0x1A,
+  // 0x34 '4'
+  0x07, 0x04, 0x04, 0x3F,
+  // 0x35 '5'
+  0x27, 0x25, 0x25, 0x19,
+  // 0x36 '6'
+  0x1E, 0x25, 0x25, 0x18,
+  // 0x37 '7'
+  0x01, 0x39, 0x05, 0x03,
+  // 0x38 '8'
+  0x1A, 0x25, 0x25, 0x1A,
+  // 0x39 '9'
+  0x06, 0x29, 0x29, 0x1E,
+  // 0x3A ':'
+  0x24,
+  // 0x3B ';'
+  0x40, 0x24,
+  // 0x3C '<'
+  0x08, 0x14, 0x22,
+  // 0x3D '='
+  0x14, 0x14, 0x14,
+  // 0x3E '>'
+  0x22, 0x14, 0x08,
+  // 0x3F '?'
+  0x02, 0x29, 0x05, 0x02,
+  // 0x40 '@'
+  0x1E, 0x21, 0x2D, 0x2D, 0x06,
+  // 0x41 'A'
+  0x3E, 0x09, 0x09, 0x3E,
+  // 0x42 'B'
+  0x3F, 0x25, 0x25, 0x1A,
+  // 0x43 'C'
+  0x1E, 0x21, 0x21, 0x21,
+  // 0x44 'D'
+  0x3F, 0x21, 0x21, 0x1E,
+  // 0x45 'E'
+  0x3F, 0x25, 0x25, 0x21,
+  // 0x46 'F'
+  0x3F, 0x05, 0x05, 0x01,
+  // 0x47 'G'
+  0x1E, 0x21, 0x25, 0x3D,
+  // 0x48 'H'
+  0x3F, 0x04, 0x04, 0x3F,
+  // 0x49 'I'
+  0x21, 0x3F, 0x21,
+  // 0x4A 'J'
+  0x10, 0x20, 0x1F,
+  // 0x4B 'K'
+  0x3F, 0x04, 0x0A, 0x31,
+  // 0x4C 'L'
+  0x3F, 0x20, 0x20,
+  // 0x4D 'M'
+  0x3F, 0x02, 0x04, 0x02, 0x3F,
+  // 0x4E 'N'
+  0x3F, 0x02, 0x04, 0x3F,
+  // 0x4F 'O'
+  0x1E, 0x21, 0x21, 0x1E,
+  // 0x50 'P'
+  0x3F, 0x09, 0x09, 0x06,
+  // 0x51 'Q'
+  0x1E, 0x21, 0x11, 0x2E,
+  // 0x52 'R'
+  0x3F, 0x09, 0x19, 0x26,
+  // 0x53 'S'
+  0x22, 0x25, 0x25, 0x19,
+  // 0x54 'T'
+  0x01, 0x3F, 0x01,
+  // 0x55 'U'
+  0x1F, 0x20, 0x20, 0x1F,
+  // 0x56 'V'
+  0x07, 0x18, 0x20, 0x18, 0x07,
+  // 0x57 'W'
+  0x3F, 0x10, 0x0C, 0x10, 0x3F,
+  // 0x58 'X'
+  0x21, 0x12, 0x0C, 0x12, 0x21,
+  // 0x59 'Y'
+  0x01, 0x02, 0x3C, 0x02, 0x01,
+  // 0x5A 'Z'
+  0x31, 0x29, 0x25, 0x23,
+  // 0x5B '['
+  0x3F, 0x21,
+  // 0x5C '\'
+  0x01, 0x06, 0x18, 0x20,
+  // 0x5D ']'
+  0x21, 0x3F,
+  // 0x5E '^'
+  0x02, 0x01, 0x02,
+  // 0x5F '_'
+  0x40, 0x40, 0x40, 0x40,
+  // 0x60 '`'
+  0x01, 0x02,
+  // 0x61 'a'
+  0x18, 0x24, 0x3C,
+  // 0x62 'b'
+  0x3F, 0x24, 0x18,
+  // 0x63 'c'
+  0x18, 0x24, 0x24,
+  // 0x64 'd'
+  0x18, 0x24, 0x3F,
+  // 0x65 'e'
+  0x18, 0x2C, 0x28,
+  // 0x66 'f'
+  0x3E, 0x05,
+  // 0x67 'g'
+  0x98, 0xA4, 0x7C,
+  // 0x68 'h'
+  0x3F, 0x04, 0x38,
+  // 0x69 'i'
+  0x3D,
+  // 0x6A 'j'
+  0x80, 0x7D,
+  // 0x6B 'k'
+  0x3F, 0x08, 0x34,
+  // 0x6C 'l'
+  0x3F,
+  // 0x6D 'm'
+  0x3C, 0x04, 0x3C, 0x04, 0x38,
+  // 0x6E 'n'
+  0x3C, 0x04, 0x38,
+  // 0x6F 'o'
+  0x18, 0x24, 0x18,
+  // 0x70 'p'
+  0xFC, 0x24, 0x18,
+  // 0x71 'q'
+  0x18, 0x24, 0xFC,
+  // 0x72 'r'
+  0x3C, 0x08, 0x04,
+  // 0x73 's'
+  0x28, 0x24, 0x14,
+  // 0x74 't'
+  0x04, 0x1F, 0x24,
+  // 0x75 'u'
+  0x1C, 0x20, 0x3C,
+  // 0x76 'v'
+  0x1C, 0x20, 0x1C,
+  // 0x77 'w'
+  0x1C, 0x20, 0x18, 0x20, 0x1C,
+  // 0x78 'x'
+  0x24, 0x18, 0x24,
+  // 0x79 'y'
+  0x9C, 0xA0, 0x7C,
+  // 0x7A 'z'
+  0x24, 0x34, 0x2C,
+  // 0x7B '{'
+  0x04, 0x1E, 0x21,
+  // 0x7C '|'
+  0x7F,
+  // 0x7D '}'
+  0x21, 0x1E, 0x04,
+  // 0x7E '~'
+  0x08, 0x04, 0x08, 0x04,
+};
+
+static const uint16_t PROGMEM WLED_FONT_PROP8_OFFSETS[95] = {
+  0, 2, 3, 6, 11, 16, 21, 26, 27, 29, 31, 34,
+  37, 39, 42, 43, 47, 51, 54, 58, 62, 66, 70, 74,
+  78, 82, 86, 87, 89, 92, 95, 98, 102, 107, 111, 115,
+  119, 123, 127, 131, 135, 139, 142, 145, 149, 152, 157, 161,
+  165, 169, 173, 177, 181, 184, 188, 193, 198, 203, 208, 212,
+  214, 218, 220, 223, 227, 229, 232, 235, 238, 241, 244, 246,
+  249, 252, 253, 255, 258, 259, 264, 267, 270, 273, 276, 279,
+  282, 285, 288, 291, 296, 299, 302, 305, 308, 309, 312,
+};
+
+static const uint8_t PROGMEM WLED_FONT_PROP8_WIDTHS[95] = {
+  2, 1, 3, 5, 5, 5, 5, 1, 2, 2, 3, 3, 2, 3, 1, 4,
+  4, 3, 4, 4, 4, 4, 4, 4, 4, 4, 1, 2, 3, 3, 3, 4,
+  5, 4, 4, 4, 4, 4, 4, 4, 4, 3, 3, 4, 3, 5, 4, 4,
+  4, 4, 4, 4, 3, 4, 5, 5, 5, 5, 4, 2, 4, 2, 3, 4,
+  2, 3, 3, 3, 3, 3, 2, 3, 3, 1, 2, 3, 1, 5, 3, 3,
+  3, 3, 3, 3, 3, 3, 3, 5, 3, 3, 3, 3, 1, 3, 4,
+};
+
+static const WledFont WLED_FONT_PROP8 = {
+  "prop8", WLED_FONT_PROP8_COLS,
+  WLED_FONT_PROP8_OFFSETS, WLED_FONT_PROP8_WIDTHS,
+  5, 8, 0x20, 95, 1
+};
+
+#endif // WLED_FONT_PROP8_H
@@ -0,0 +1,103 @@
+#ifndef WLED_FRAME_H
+#define WLED_FRAME_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// ============================================================================
+// WLED Frame Exchange — lock-free triple buffer, Core 1 → Core 0
+// ============================================================================
+// Core 1 (say text, weather cards) draws whole frames; the Core 0 WiFi task
+// sends them over DDP. Three slots rotate between the two sides:
+//
+//   back    Core 1 only — the frame being drawn (draft())
+//   middle  the hand-off slot, with a FRESH bit when it holds an unsent frame
+//   front   Core 0 only — the frame being sent (acquire())
+//
+// publish() swaps back and middle in one atomic exchange, acquire() swaps
+// middle and front. Neither side ever waits on the other or touches a slot
+// the other owns, so a frame can't tear mid-send and Core 1 can draw the next
+// frame while one is in flight. If Core 1 publishes twice before Core 0 looks,
+// the older frame is overwritten — the sender always gets the newest complete
+// one — and counted in dropped.
+//
+// Release on publish pairs with acquire on take, so the pixels and metadata
+// written before publish() are visible to the sender after acquire().
+//
+// Single producer, single consumer: only Core 1 may call draft()/publish(),
+// only Core 0 pending()/acquire(). Core 0's own frames (emoji slideshow,
+// marquee scroll) are drawn into wledData.sendBuf, outside the exchange.
+// ============================================================================
+
+#define WLED_FRAME_FRESH   0x80   // Middle slot holds a frame not yet taken
+#define WLED_FRAME_INDEX   0x03
+
+struct WledFrame {
+  uint8_t px[WLED_PIXEL_BYTES];  // Logical row-major RGB
+  char text[MAX_SAY_LEN];        // Source text for the marquee and logs, "" for raw frames
+  uint8_t font;                  // WledFontId the text was drawn in
+  uint16_t holdMs;               // How long the sender holds it before restoring
+  uint8_t prio;                  // WLED_LEASE_PRIO_*
+  uint32_t seq;                  // Publish count, 1-based
+  unsigned long publishedMs;     // millis() at publish
+};
+
+struct WledFrameExchange {
+  WledFrame slots[3];
+  std::atomic<uint8_t> middle;   // Slot index | WLED_FRAME_FRESH
+  uint8_t back;                  // Producer's slot (Core 1)
+  uint8_t front;                 // Consumer's slot (Core 0)
+
+  // Stats
+  uint32_t published;            // Producer only
+  volatile uint32_t dropped;     // Published frames overwritten before they were taken
+  volatile uint32_t taken;       // Consumer only
+
+  void init() {
+    back = 0;
+    middle.store(1, std::memory_order_relaxed);
+    front = 2;
+    published = 0;
+    dropped = 0;
+    taken = 0;
+    memset(slots, 0, sizeof(slots));
+  }
+
+  // ---- Producer side (Core 1 only) ----
+
+  // Slot to draw the next frame into. Contents are whatever a past frame left
+  // there — draw the whole frame.
+  WledFrame& draft() {
+    return slots[back];
+  }
+
+  // Hand the drafted frame to the sender. Never blocks.
+  void publish(uint16_t holdMs, uint8_t prio) {
+    WledFrame& f = slots[back];
+    f.holdMs = holdMs;
+    f.prio = prio;
+    f.seq = ++published;
+    f.publishedMs = millis();
+    uint8_t prev = middle.exchange(back | WLED_FRAME_FRESH, std::memory_order_acq_rel);
+    if (prev & WLED_FRAME_FRESH) dropped++;
+    back = prev & WLED_FRAME_INDEX;
+  }
+
+  // ---- Consumer side (Core 0 only) ----
+
+  bool pending() const {
+    return middle.load(std::memory_order_relaxed) & WLED_FRAME_FRESH;
+  }
+
+  // Take the newest published frame, or nullptr if nothing new since the last
+  // take. The frame stays valid (and unchanged) until the next acquire().
+  const WledFrame* acquire() {
+    if (!pending()) return nullptr;
+    uint8_t prev = middle.exchange(front, std::memory_order_acq_rel);
+    front = prev & WLED_FRAME_INDEX;
+    taken++;
+    return &slots[front];
+  }
+};
+
+#endif // WLED_FRAME_H
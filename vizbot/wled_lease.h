@@ -0,0 +1,529 @@
+#ifndef WLED_LEASE_H
+#define WLED_LEASE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "mesh_protocol.h"
+
+// ============================================================================
+// WLED Lease — mesh-wide lock on a shared WLED target
+// ============================================================================
+// Bots that share a WLED used to announce "I'm sending DDP" and have everyone
+// else poll that flag every 2ms. Whoever polled first after the flag dropped
+// won, so a busy bot could starve the others, and the command queue stalled
+// behind a deferred say the whole time.
+//
+// Now one bot per WLED IP — the lowest node id among bots targeting it,
+// same rule as the mesh clock master — arbitrates a lease. Messages name bots
+// by node id (MAC hash), not the one-byte deviceId: two bots sharing a last
+// MAC byte would each elect themselves arbiter and accept each other's
+// grants.
+//
+//
+//   REQUEST  requester -> arbiter   resent every WLED_LEASE_RETRY_MS until granted
+//   GRANT    arbiter   -> all       holder + duration; everyone tracks the holder
+//   RELEASE  holder    -> all       done early
+//   REVOKE   arbiter   -> holder    a higher-priority or long-waiting request is
+//                                   queued; stop within WLED_LEASE_REVOKE_MS
+//
+// The arbiter keeps a FIFO of waiters and grants the oldest speech request
+// first, then the oldest stream (emoji / weather). Holders renew by repeating
+// REQUEST before expiry. The arbiter refuses a renewal with REVOKE when
+// speech is waiting behind a stream, or when any request has waited while
+// the holder kept the lease past its slice.
+//
+// Grants expire, so a lost RELEASE or a bot dropping off the mesh only costs
+// the remaining lease time. The holder stops WLED_LEASE_GUARD_MS before
+// its expiry. The arbiter waits WLED_LEASE_GRACE_MS after it before
+// re-granting. That margin absorbs the one-way latency, so two grants never
+// overlap.
+//
+// Standalone (no peers on our WLED) we are our own arbiter and requests are
+// granted on the spot — no radio traffic, no added latency.
+//
+// Threading: the ESP-NOW receive callback only queues messages; everything
+// else runs from pollWledLease() and pollWledDisplay() on the Core 0 WiFi
+// task. Core 1 reads wledLeaseBusy() and sets wledLeaseSpeechWaiting.
+// ============================================================================
+
+#define WLED_LEASE_PRIO_STREAM      0      // Emoji slideshow, weather cards
+#define WLED_LEASE_PRIO_SPEECH      1      // Say text
+
+#define WLED_LEASE_RETRY_MS         250    // Re-send REQUEST while waiting
+#define WLED_LEASE_SPEECH_MS        4000   // Default speech lease
+#define WLED_LEASE_STREAM_MS        3000   // Stream lease, renewed while streaming
+#define WLED_LEASE_MIN_MS           500
+#define WLED_LEASE_MAX_MS           10000  // Longer holds renew
+#define WLED_LEASE_RENEW_MS         1000   // Renew when this close to expiry
+#define WLED_LEASE_GUARD_MS         100    // Holder stops this early
+#define WLED_LEASE_GRACE_MS         300    // Arbiter waits this long past expiry
+#define WLED_LEASE_REVOKE_MS        500    // Revoked holder's remaining time
+#define WLED_LEASE_STREAM_SLICE_MS  30000  // Stream yields to a waiting stream after this
+#define WLED_LEASE_MAX_HOLD_MS      20000  // Speech yields to waiters after this
+#define WLED_LEASE_IDLE_MS          500    // Granted but unused — give it back
+#define WLED_LEASE_WAITER_TTL_MS    1000   // Waiter not heard from — drop it
+#define WLED_LEASE_QUEUE_SIZE       8
+#define WLED_LEASE_INBOX_SIZE       8
+
+#define WLED_LEASE_NONE             0      // No holder / no arbiter (node ids are never 0)
+
+enum WledLeaseOp : uint8_t {
+  WLED_LEASE_OP_REQUEST = 1,
+  WLED_LEASE_OP_GRANT,
+  WLED_LEASE_OP_RELEASE,
+  WLED_LEASE_OP_REVOKE,
+};
+
+struct __attribute__((packed)) WledLeasePayload {
+  uint8_t  op;           // WledLeaseOp
+  uint32_t nodeId;       // REQUEST/RELEASE: requester; GRANT/REVOKE: holder
+  uint8_t  prio;         // WLED_LEASE_PRIO_*
+  uint8_t  token;        // Requester's lease counter — ties grants to requests
+  uint16_t durationMs;   // REQUEST: wanted; GRANT: granted
+  uint32_t wledIP;       // Lease scope
+};
+
+static_assert(sizeof(WledLeasePayload) == 13, "WledLeasePayload must be 13 bytes");
+
+struct WledLeaseWaiter {
+  uint32_t      nodeId;
+  uint8_t       prio;
+  uint8_t       token;
+  uint16_t      durationMs;
+  unsigned long queuedMs;
+  unsigned long heardMs;
+};
+
+static struct {
+  // Our own request (requester side)
+  volatile bool want;
+  uint8_t       wantPrio;
+  uint16_t      wantDurationMs;
+  uint8_t       token;
+  unsigned long wantSinceMs;
+  unsigned long nextRequestMs;
+  bool          granted;           // First grant for this token arrived
+  volatile bool held;
+  unsigned long heldUntilMs;       // Local, already shortened by the guard
+  bool          revoked;
+  unsigned long lastUsedMs;        // pollWledDisplay() touches this while sending
+
+  // Current grant as seen on the air (every bot tracks this)
+  volatile uint32_t holderId;
+  uint8_t       holderPrio;
+  uint8_t       holderToken;
+  unsigned long holderSinceMs;
+  unsigned long holderUntilMs;
+  bool          holderRevoked;
+  unsigned long revokeSentMs;
+
+  // Arbiter side — only used while we are the arbiter
+  uint32_t      arbiterId;
+  WledLeaseWaiter queue[WLED_LEASE_QUEUE_SIZE];
+  uint8_t       queueCount;
+
+  // Receive inbox — filled by the ESP-NOW callback, drained by the poll
+  struct { WledLeasePayload msg; uint32_t from; } inbox[WLED_LEASE_INBOX_SIZE];
+  volatile uint8_t inboxHead;
+  volatile uint8_t inboxTail;
+
+  // Stats
+  uint32_t      grants;
+  uint32_t      revokes;
+  uint32_t      lastWaitMs;        // Our last request -> grant
+  uint32_t      maxWaitMs;
+} wledLease = { false, 0, 0, 0, 0, 0, false, false, 0, false, 0,
+                WLED_LEASE_NONE, 0, 0, 0, 0, false, 0,
+                WLED_LEASE_NONE };
+
+// Core 1 sets this while a say is parked in drainCommandQueue(), so our place
+// in the arbiter's queue is taken before the frame is even rendered
+volatile bool wledLeaseSpeechWaiting = false;
+
+// Defined in wled_display.h / esp_now_mesh.h (included around us)
+extern uint32_t wledGetIPAsU32();
+extern uint32_t meshGetNodeId();
+extern uint32_t meshLowestIdForIP(uint32_t ip);
+extern bool meshPeerPresent(uint32_t nodeId);
+extern bool meshSend(uint8_t type, const void* payload, uint8_t len);
+
+static inline bool wledLeaseIsArbiter() {
+  return wledLease.arbiterId == meshGetNodeId();
+}
+
+static void wledLeaseSend(uint8_t op, uint32_t nodeId, uint8_t prio, uint8_t token,
+                          uint16_t durationMs) {
+  // No one else targets this WLED — nobody to tell
+  if (meshLowestIdForIP(wledGetIPAsU32()) == WLED_LEASE_NONE) return;
+  WledLeasePayload msg = { op, nodeId, prio, token, durationMs, wledGetIPAsU32() };
+  meshSend(MESH_MSG_WLED_LEASE, &msg, sizeof(msg));
+}
+
+// ============================================================================
+// Holder Bookkeeping — same on every bot
+// ============================================================================
+
+static void wledLeaseSetHolder(uint32_t nodeId, uint8_t prio, uint8_t token,
+                               uint16_t durationMs, unsigned long now) {
+  if (wledLease.holderId != nodeId || wledLease.holderToken != token) {
+    wledLease.holderSinceMs = now;
+    wledLease.holderRevoked = false;
+  }
+  wledLease.holderId      = nodeId;
+  wledLease.holderPrio    = prio;
+  wledLease.holderToken   = token;
+  wledLease.holderUntilMs = now + durationMs;
+
+  // Ours?
+  if (nodeId == meshGetNodeId() && wledLease.want && token == wledLease.token) {
+    if (!wledLease.granted) {
+      wledLease.granted = true;
+      uint32_t waited = now - wledLease.wantSinceMs;
+      wledLease.lastWaitMs = waited;
+      if (waited > wledLease.maxWaitMs) wledLease.maxWaitMs = waited;
+      wledLease.lastUsedMs = now;
+      DBG("Lease: granted after ");
+      DBG(waited);
+      DBGLN("ms");
+    }
+    wledLease.heldUntilMs = now + durationMs - WLED_LEASE_GUARD_MS;
+    wledLease.held = true;
+  }
+}
+
+static void wledLeaseClearHolder() {
+  wledLease.holderId = WLED_LEASE_NONE;
+  wledLease.holderRevoked = false;
+}
+
+// ============================================================================
+// Arbiter
+// ============================================================================
+
+static void wledLeaseArbiterGrant(const WledLeaseWaiter& w, unsigned long now) {
+  uint16_t dur = constrain(w.durationMs, WLED_LEASE_MIN_MS, WLED_LEASE_MAX_MS);
+  wledLeaseSetHolder(w.nodeId, w.prio, w.token, dur, now);
+  wledLeaseSend(WLED_LEASE_OP_GRANT, w.nodeId, w.prio, w.token, dur);
+  wledLease.grants++;
+}
+
+// Ask the holder to wrap up. The grant itself isn't shortened — a lost REVOKE
+// must not let the next grant overlap — but it won't be renewed either.
+static void wledLeaseArbiterRevoke(unsigned long now) {
+  wledLease.revokeSentMs = now;
+  if (!wledLease.holderRevoked) {
+    wledLease.holderRevoked = true;
+    wledLease.revokes++;
+    DBGLN("Lease: revoking holder");
+  }
+  if (wledLease.holderId == meshGetNodeId()) {
+    wledLease.revoked = true;
+  } else {
+    wledLeaseSend(WLED_LEASE_OP_REVOKE, wledLease.holderId, wledLease.holderPrio,
+                  wledLease.holderToken, WLED_LEASE_REVOKE_MS);
+  }
+}
+
+// Should the current holder give way to someone in the queue?
+static bool wledLeaseShouldYield(unsigned long now) {
+  if (wledLease.queueCount == 0) return false;
+  bool speechWaiting = false;
+  for (uint8_t i = 0; i < wledLease.queueCount; i++) {
+    if (wledLease.queue[i].prio == WLED_LEASE_PRIO_SPEECH) speechWaiting = true;
+  }
+  unsigned long held = now - wledLease.holderSinceMs;
+  if (wledLease.holderPrio == WLED_LEASE_PRIO_STREAM) {
+    return speechWaiting || held >= WLED_LEASE_STREAM_SLICE_MS;
+  }
+  return held >= WLED_LEASE_MAX_HOLD_MS;
+}
+
+static void wledLeaseArbiterRequest(const WledLeasePayload& req, unsigned long now) {
+  // Renewal (or a retry whose GRANT was lost) from the current holder
+  if (wledLease.holderId == req.nodeId && wledLease.holderToken == req.token) {
+    if (wledLease.holderRevoked || wledLeaseShouldYield(now)) {
+      wledLeaseArbiterRevoke(now);   // Repeated in case the first REVOKE was lost
+    } else {
+      WledLeaseWaiter w = { req.nodeId, req.prio, req.token, req.durationMs, now, now };
+      wledLeaseArbiterGrant(w, now);
+    }
+    return;
+  }
+
+  // Already queued — refresh, keep its place
+  for (uint8_t i = 0; i < wledLease.queueCount; i++) {
+    WledLeaseWaiter& w = wledLease.queue[i];
+    if (w.nodeId != req.nodeId) continue;
+    w.prio       = req.prio;
+    w.token      = req.token;
+    w.durationMs = req.durationMs;
+    w.heardMs    = now;
+    return;
+  }
+
+  if (wledLease.queueCount >= WLED_LEASE_QUEUE_SIZE) return;  // Requester retries
+  WledLeaseWaiter& w = wledLease.queue[wledLease.queueCount++];
+  w.nodeId     = req.nodeId;
+  w.prio       = req.prio;
+  w.token      = req.token;
+  w.durationMs = req.durationMs;
+  w.queuedMs   = now;
+  w.heardMs    = now;
+}
+
+static void wledLeaseQueueRemove(uint8_t i) {
+  for (uint8_t j = i; j + 1 < wledLease.queueCount; j++) {
+    wledLease.queue[j] = wledLease.queue[j + 1];
+  }
+  wledLease.queueCount--;
+}
+
+static void pollWledLeaseArbiter(unsigned long now) {
+  // Drop waiters that stopped asking
+  for (uint8_t i = 0; i < wledLease.queueCount; ) {
+    if (now - wledLease.queue[i].heardMs > WLED_LEASE_WAITER_TTL_MS) {
+      wledLeaseQueueRemove(i);
+    } else {
+      i++;
+    }
+  }
+
+  if (wledLease.holderId != WLED_LEASE_NONE) {
+    bool gone = wledLease.holderId != meshGetNodeId() &&
+                !meshPeerPresent(wledLease.holderId);
+    if (!gone && (long)(now - (wledLease.holderUntilMs + WLED_LEASE_GRACE_MS)) < 0) {
+      bool resend = wledLease.holderRevoked &&
+                    now - wledLease.revokeSentMs >= WLED_LEASE_RETRY_MS;  // First one lost?
+      if (resend || (!wledLease.holderRevoked && wledLeaseShouldYield(now))) {
+        wledLeaseArbiterRevoke(now);
+      }
+      return;
+    }
+    wledLeaseClearHolder();
+  }
+
+  if (wledLease.queueCount == 0) return;
+
+  // Oldest speech request, else oldest stream
+  uint8_t pick = 0;
+  for (uint8_t i = 0; i < wledLease.queueCount; i++) {
+    if (wledLease.queue[i].prio > wledLease.queue[pick].prio) pick = i;
+  }
+  WledLeaseWaiter w = wledLease.queue[pick];
+  wledLeaseQueueRemove(pick);
+  wledLeaseArbiterGrant(w, now);
+}
+
+// ============================================================================
+// Receive — ESP-NOW callback context, just queue it
+// ============================================================================
+
+static void meshOnWledLease(const uint8_t* mac, const MeshHeader& hdr,
+                            const uint8_t* payload, uint8_t len, int64_t rxUs) {
+  uint8_t head = wledLease.inboxHead;
+  uint8_t next = (head + 1) % WLED_LEASE_INBOX_SIZE;
+  if (next == wledLease.inboxTail) return;  // Full — REQUESTs are retried, grants expire
+  memcpy(&wledLease.inbox[head].msg, payload, sizeof(WledLeasePayload));
+  wledLease.inbox[head].from = meshNodeId(mac);   // Origin MAC when relayed
+  wledLease.inboxHead = next;
+}
+
+static void wledLeaseHandle(const WledLeasePayload& msg, uint32_t from, unsigned long now) {
+  if (msg.wledIP != wledGetIPAsU32()) return;  // Someone else's WLED
+
+  switch (msg.op) {
+    case WLED_LEASE_OP_REQUEST:
+      if (wledLeaseIsArbiter() && msg.nodeId == from) wledLeaseArbiterRequest(msg, now);
+      break;
+
+    case WLED_LEASE_OP_GRANT:
+      // Trusted from any sender: only a bot that sees itself as arbiter
+      // grants, and peer tables converge within a keyframe
+      wledLeaseSetHolder(msg.nodeId, msg.prio, msg.token, msg.durationMs, now);
+      // Granted something we no longer want (request outlived a release)
+      if (msg.nodeId == meshGetNodeId() &&
+          (!wledLease.want || msg.token != wledLease.token)) {
+        wledLeaseSend(WLED_LEASE_OP_RELEASE, msg.nodeId, msg.prio, msg.token, 0);
+      }
+      break;
+
+    case WLED_LEASE_OP_RELEASE:
+      if (msg.nodeId == from && wledLease.holderId == from &&
+          wledLease.holderToken == msg.token) {
+        wledLeaseClearHolder();
+      }
+      break;
+
+    case WLED_LEASE_OP_REVOKE:
+      if (msg.nodeId == meshGetNodeId() && wledLease.held &&
+          msg.token == wledLease.token) {
+        wledLease.revoked = true;
+        unsigned long cap = now + msg.durationMs;
+        if ((long)(wledLease.heldUntilMs - cap) > 0) wledLease.heldUntilMs = cap;
+        DBGLN("Lease: revoked");
+      }
+      break;
+  }
+}
+
+// ============================================================================
+// Public API — Core 0 (WiFi task) unless noted
+// ============================================================================
+
+// Ask for the lease (idempotent — call every poll while you need it). A
+// higher priority upgrades a pending request. Check wledLeaseHeld().
+void wledLeaseRequest(uint8_t prio, uint16_t durationMs) {
+  unsigned long now = millis();
+  if (!wledLease.want) {
+    wledLease.want = true;
+    wledLease.token++;
+    wledLease.wantSinceMs = now;
+    wledLease.nextRequestMs = now;
+    wledLease.granted = false;
+    wledLease.revoked = false;
+    wledLease.wantPrio = prio;
+  } else if (prio > wledLease.wantPrio) {
+    wledLease.wantPrio = prio;
+    wledLease.nextRequestMs = now;
+  }
+  wledLease.wantDurationMs = max(durationMs, (uint16_t)WLED_LEASE_MIN_MS);
+
+  // Standalone, or we arbitrate and it's free: grant right here
+  if (!wledLease.held && wledLeaseIsArbiter()) {
+    WledLeasePayload req = { WLED_LEASE_OP_REQUEST, meshGetNodeId(), wledLease.wantPrio,
+                             wledLease.token, wledLease.wantDurationMs, wledGetIPAsU32() };
+    wledLeaseArbiterRequest(req, now);
+    pollWledLeaseArbiter(now);
+  }
+}
+
+static bool wledLeaseValid(unsigned long now) {
+  if (!wledLease.held) return false;
+  if ((long)(now - wledLease.heldUntilMs) >= 0) {
+    wledLease.held = false;   // Expired without a renewal
+    return false;
+  }
+  return true;
+}
+
+// True while our grant is valid. Calling it also marks the lease as in use,
+// so only call it from code that is (about to be) sending.
+bool wledLeaseHeld() {
+  unsigned long now = millis();
+  if (!wledLeaseValid(now)) return false;
+  wledLease.lastUsedMs = now;
+  return true;
+}
+
+// The arbiter wants the WLED back — wrap up and release
+bool wledLeaseRevoked() {
+  return wledLease.held && wledLease.revoked;
+}
+
+void wledLeaseRelease() {
+  if (!wledLease.want) return;
+  bool wasHolder = wledLease.holderId == meshGetNodeId() &&
+                   wledLease.holderToken == wledLease.token;
+  wledLease.want = false;
+  wledLease.held = false;
+  wledLease.revoked = false;
+  if (wasHolder) {
+    wledLeaseClearHolder();
+    wledLeaseSend(WLED_LEASE_OP_RELEASE, meshGetNodeId(), wledLease.wantPrio,
+                  wledLease.token, 0);
+    if (wledLeaseIsArbiter()) pollWledLeaseArbiter(millis());  // Straight to the next waiter
+  }
+}
+
+// Safe from Core 1: another bot has the WLED, or we are still queued for it
+bool wledLeaseBusy() {
+  if (wledLease.held) return false;
+  uint32_t holder = wledLease.holderId;
+  if (holder != WLED_LEASE_NONE && holder != meshGetNodeId()) return true;
+  return wledLease.want;
+}
+
+void initWledLease() {
+  meshRegisterMsg(MESH_MSG_WLED_LEASE, sizeof(WledLeasePayload), sizeof(WledLeasePayload),
+                  meshOnWledLease);
+}
+
+// ============================================================================
+// Poll — called from wifiServerTask loop (Core 0)
+// ============================================================================
+
+void pollWledLease() {
+  unsigned long now = millis();
+
+  // Arbiter = lowest node id targeting this WLED, us included
+  uint32_t ip = wledGetIPAsU32();
+  uint32_t arbiter = meshGetNodeId();
+  uint32_t lowest = meshLowestIdForIP(ip);
+  if (lowest != WLED_LEASE_NONE && lowest < arbiter) arbiter = lowest;
+  if (arbiter != wledLease.arbiterId) {
+    DBG("Lease: arbiter now 0x");
+    DBGLN(String(arbiter, HEX));
+    wledLease.arbiterId = arbiter;
+    wledLease.queueCount = 0;   // Waiters re-request within WLED_LEASE_RETRY_MS
+    wledLease.nextRequestMs = now;
+  }
+
+  while (wledLease.inboxTail != wledLease.inboxHead) {
+    uint8_t t = wledLease.inboxTail;
+    wledLeaseHandle(wledLease.inbox[t].msg, wledLease.inbox[t].from, now);
+    wledLease.inboxTail = (t + 1) % WLED_LEASE_INBOX_SIZE;
+  }
+
+  // A say parked on Core 1 queues up before its frame exists
+  if (wledLeaseSpeechWaiting) {
+    wledLeaseRequest(WLED_LEASE_PRIO_SPEECH, WLED_LEASE_SPEECH_MS);
+  }
+
+  // Expired holder seen from a non-arbiter: stop reporting busy
+  if (!wledLeaseIsArbiter() && wledLease.holderId != WLED_LEASE_NONE &&
+      (long)(now - (wledLease.holderUntilMs + WLED_LEASE_GRACE_MS)) >= 0) {
+    wledLeaseClearHolder();
+  }
+
+  if (wledLease.want) {
+    bool held = wledLeaseValid(now);
+    // Granted but nothing is using it (say dropped, stream stopped)
+    if (held && !wledLeaseSpeechWaiting && now - wledLease.lastUsedMs > WLED_LEASE_IDLE_MS) {
+      DBGLN("Lease: idle, releasing");
+      wledLeaseRelease();
+    } else if (wledLeaseIsArbiter()) {
+      if (!held || (!wledLease.revoked &&
+                    (long)(wledLease.heldUntilMs - now) < WLED_LEASE_RENEW_MS)) {
+        WledLeasePayload req = { WLED_LEASE_OP_REQUEST, meshGetNodeId(), wledLease.wantPrio,
+                                 wledLease.token, wledLease.wantDurationMs, ip };
+        wledLeaseArbiterRequest(req, now);
+      }
+    } else if ((long)(now - wledLease.nextRequestMs) >= 0 &&
+               (!held || (!wledLease.revoked &&
+                          (long)(wledLease.heldUntilMs - now) < WLED_LEASE_RENEW_MS))) {
+      // Waiting (resend until granted) or renewing
+      wledLease.nextRequestMs = now + WLED_LEASE_RETRY_MS;
+      wledLeaseSend(WLED_LEASE_OP_REQUEST, meshGetNodeId(), wledLease.wantPrio,
+                    wledLease.token, wledLease.wantDurationMs);
+    }
+  }
+
+  if (wledLeaseIsArbiter()) pollWledLeaseArbiter(now);
+}
+
+// ---- Status (for /bot/mesh) ----
+
+void wledLeaseGetStatus(uint32_t& arbiterId, uint32_t& holderId, uint8_t& queued, bool& held,
+                        uint32_t& lastWaitMs, uint32_t& maxWaitMs,
+                        uint32_t& grants, uint32_t& revokes) {
+  arbiterId  = wledLease.arbiterId;
+  holderId   = wledLease.holderId;
+  queued     = wledLease.queueCount;
+  held       = wledLease.held;
+  lastWaitMs = wledLease.lastWaitMs;
+  maxWaitMs  = wledLease.maxWaitMs;
+  grants     = wledLease.grants;
+  revokes    = wledLease.revokes;
+}
+
+#endif // WLED_LEASE_H
@@ -0,0 +1,195 @@
+#ifndef WLED_MARQUEE_H
+#define WLED_MARQUEE_H
+
+// ============================================================================
+// WLED Marquee — smooth-scrolling text for messages wider than the matrix
+// ============================================================================
+// Text that fits in 32px is shown centered as a single frame. Anything wider
+// scrolls: the message is rasterized once into a column strip (one byte per
+// pixel column, bit = row), then pollWledDisplay() streams frames from it at
+// WLED_MARQUEE_FPS for the length of the hold. The strip is built from the
+// marquee's own glyph cache in the font the frame was drawn in (WledFrame.font),
+// so a font change mid-message can't make the scroll jump.
+//
+// Position is kept in 1/256 px and derived from the time since the scroll
+// started, so a late frame never slows the text down. Each output pixel
+// blends the two strip columns it straddles, which makes the motion smooth at
+// low speeds instead of stepping a whole pixel at a time. The sub-pixel
+// fraction is the same across a frame, so the blend is a 4-entry colour
+// table per frame and a table lookup per lit pixel.
+//
+// Timeline: text left-aligned for WLED_MARQUEE_LEAD_MS, scroll until the last
+// character reaches the right edge, hold there for WLED_MARQUEE_TAIL_MS.
+// Speed follows wledData.scrollSpeed.
+//
+// Core 0 only. The first frame is drawn by wledQueueText() on Core 1 and is
+// identical to the marquee at position 0.
+// Must be #included inside wled_display.h after wledSendDDP().
+// ============================================================================
+
+#define WLED_MARQUEE_FPS        50
+#define WLED_MARQUEE_FRAME_MS   (1000 / WLED_MARQUEE_FPS)
+#define WLED_MARQUEE_KEEPALIVE_MS 1000     // Resend while paused (WLED times out at 2.5s)
+#define WLED_MARQUEE_LEAD_MS    600        // Read the start before it moves
+#define WLED_MARQUEE_TAIL_MS    800        // Read the end before restore
+#define WLED_MARQUEE_MIN_PXS    8          // Scroll speed at scrollSpeed 0, px/s
+#define WLED_MARQUEE_MAX_PXS    40         // ...and at 255
+#define WLED_MARQUEE_MAX_COLS   (MAX_SAY_LEN * 6)   // Widest pitch: 5x7 + 1px gap
+
+struct WledMarqueeStrip {
+  uint8_t cols[WLED_MARQUEE_MAX_COLS + 1];  // +1: a blank column to blend into
+  uint16_t width;                           // Used columns
+};
+
+struct WledMarquee {
+  WledMarqueeStrip strip;
+  WledGlyphCache glyphs;          // Core 0's cache, separate from wledTextGlyphs
+  bool active;
+  uint8_t r, g, b;
+  uint16_t pxPerSec;
+  uint32_t endQ8;                 // Final position, 1/256 px
+  unsigned long startMs;          // Scroll start (after the lead pause)
+  unsigned long lastFrameMs;      // Last send
+  unsigned long nextFrameMs;      // Frame deadline — paced, so poll jitter doesn't add up
+  uint32_t lastPosQ8;
+
+  // Stats
+  uint32_t frames;
+  uint16_t buildUs;               // Last frame build time
+};
+
+static WledMarquee wledMarquee = {};
+
+// Load a font into the marquee's cache, at scale 1 — the strip is 8 rows
+static const WledGlyphCache& wledMarqueeFont(uint8_t font) {
+  if (!wledGlyphCacheLoad(wledMarquee.glyphs, wledFontById(font), 1)) {
+    wledGlyphCacheLoad(wledMarquee.glyphs, &WLED_FONT_3X5, 1);
+  }
+  return wledMarquee.glyphs;
+}
+
+// Rasterize text into a column strip, vertically centered like
+// wledGlyphDrawCentered(). Returns the width in columns.
+uint16_t wledMarqueeRasterize(WledMarqueeStrip& s, const WledGlyphCache& c,
+                              const char* text) {
+  uint8_t yOff = (WLED_DISPLAY_HEIGHT - c.height) / 2;
+  uint16_t w = 0;
+  for (const char* p = text; *p; p++) {
+    uint8_t i = wledGlyphIndex(c, *p);
+    uint8_t gap = p != text ? c.spacing : 0;
+    if (w + gap + c.width[i] > WLED_MARQUEE_MAX_COLS) break;
+    for (uint8_t k = 0; k < gap; k++) s.cols[w++] = 0;
+    const uint32_t* col = &c.cols[c.start[i]];
+    for (uint8_t k = 0; k < c.width[i]; k++) {
+      s.cols[w++] = (uint8_t)(col[k] << yOff);
+    }
+  }
+  s.cols[w] = 0;
+  s.width = w;
+  return w;
+}
+
+// Render the strip at posQ8 (1/256 px from the left) into a 32x8 RGB buffer
+void wledMarqueeRender(const WledMarqueeStrip& s, uint32_t posQ8, uint8_t* px,
+                       uint8_t r, uint8_t g, uint8_t b) {
+  uint16_t first = posQ8 >> 8;
+  uint16_t frac = posQ8 & 0xFF;
+
+  // Colour by coverage: [left column lit][right column lit]
+  uint8_t lut[4][3];
+  uint16_t wl = 256 - frac;
+  lut[1][0] = (r * wl) >> 8;   lut[1][1] = (g * wl) >> 8;   lut[1][2] = (b * wl) >> 8;
+  lut[2][0] = (r * frac) >> 8; lut[2][1] = (g * frac) >> 8; lut[2][2] = (b * frac) >> 8;
+  lut[3][0] = r;               lut[3][1] = g;               lut[3][2] = b;
+
+  memset(px, 0, WLED_PIXEL_BYTES);
+  for (uint8_t x = 0; x < WLED_DISPLAY_WIDTH; x++) {
+    uint16_t i = first + x;
+    uint8_t c0 = i < s.width ? s.cols[i] : 0;
+    uint8_t c1 = (frac && i + 1 < s.width) ? s.cols[i + 1] : 0;
+    uint8_t any = c0 | c1;
+    for (uint8_t y = 0; any; y++, any >>= 1) {
+      if (!(any & 1)) continue;
+      uint8_t k = ((c0 >> y) & 1) | (((c1 >> y) & 1) << 1);
+      uint8_t* p = px + (y * WLED_DISPLAY_WIDTH + x) * 3;
+      p[0] = lut[k][0];
+      p[1] = lut[k][1];
+      p[2] = lut[k][2];
+    }
+  }
+}
+
+inline uint16_t wledMarqueePxPerSec() {
+  return WLED_MARQUEE_MIN_PXS +
+         (uint16_t)wledData.scrollSpeed * (WLED_MARQUEE_MAX_PXS - WLED_MARQUEE_MIN_PXS) / 255;
+}
+
+// How long text needs on screen as a marquee, or 0 if it fits without scrolling
+unsigned long wledMarqueeDurationMs(const char* text, uint8_t font) {
+  uint16_t w = min(wledGlyphTextWidth(wledMarqueeFont(font), text),
+                   (uint16_t)WLED_MARQUEE_MAX_COLS);
+  if (w <= WLED_DISPLAY_WIDTH) return 0;
+  return WLED_MARQUEE_LEAD_MS +
+         (unsigned long)(w - WLED_DISPLAY_WIDTH) * 1000 / wledMarqueePxPerSec() +
+         WLED_MARQUEE_TAIL_MS;
+}
+
+void wledMarqueeStop() {
+  wledMarquee.active = false;
+}
+
+// Start scrolling text. Returns false (and stays stopped) if it fits as-is.
+bool wledMarqueeStart(const char* text, uint8_t font, uint8_t r, uint8_t g, uint8_t b) {
+  uint16_t w = wledMarqueeRasterize(wledMarquee.strip, wledMarqueeFont(font), text);
+  if (w <= WLED_DISPLAY_WIDTH) {
+    wledMarqueeStop();
+    return false;
+  }
+  unsigned long now = millis();
+  wledMarquee.r = r;
+  wledMarquee.g = g;
+  wledMarquee.b = b;
+  wledMarquee.pxPerSec = wledMarqueePxPerSec();
+  wledMarquee.endQ8 = (uint32_t)(w - WLED_DISPLAY_WIDTH) << 8;
+  wledMarquee.startMs = now + WLED_MARQUEE_LEAD_MS;
+  wledMarquee.lastFrameMs = now;   // Position 0 went out with the queued frame
+  wledMarquee.nextFrameMs = now + WLED_MARQUEE_FRAME_MS;
+  wledMarquee.lastPosQ8 = 0;
+  wledMarquee.active = true;
+  return true;
+}
+
+// Stream the next frame when one is due. Returns false if a send failed.
+bool wledMarqueeUpdate() {
+  if (!wledMarquee.active) return true;
+  unsigned long now = millis();
+  if ((long)(now - wledMarquee.nextFrameMs) < 0) return true;
+  wledMarquee.nextFrameMs += WLED_MARQUEE_FRAME_MS;
+  if ((long)(now - wledMarquee.nextFrameMs) >= 0) {
+    wledMarquee.nextFrameMs = now + WLED_MARQUEE_FRAME_MS;  // Fell behind — don't burst
+  }
+
+  uint32_t pos = 0;
+  if ((long)(now - wledMarquee.startMs) > 0) {
+    uint32_t elapsed = min(now - wledMarquee.startMs, 60000UL);  // Past the end anyway
+    pos = elapsed * wledMarquee.pxPerSec * 256 / 1000;
+    if (pos > wledMarquee.endQ8) pos = wledMarquee.endQ8;
+  }
+  // Paused at either end: only keep WLED in realtime mode
+  if (pos == wledMarquee.lastPosQ8 &&
+      now - wledMarquee.lastFrameMs < WLED_MARQUEE_KEEPALIVE_MS) {
+    return true;
+  }
+
+  uint32_t t0 = micros();
+  wledMarqueeRender(wledMarquee.strip, pos, wledData.sendBuf,
+                    wledMarquee.r, wledMarquee.g, wledMarquee.b);
+  wledMarquee.buildUs = micros() - t0;
+
+  wledMarquee.lastFrameMs = now;
+  wledMarquee.lastPosQ8 = pos;
+  wledMarquee.frames++;
+  return wledSendDDP(wledData.sendBuf);
+}
+
+#endif // WLED_MARQUEE_H
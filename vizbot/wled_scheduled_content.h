@@ -4,15 +4,25 @@
 #include <Arduino.h>
 #include <Preferences.h>
 #include "config.h"
+#include "timeline.h"
 
 // ============================================================================
 // Scheduled Content — Periodic Weather + Emoji Cycles on WLED
 // ============================================================================
 // Every N minutes (default 30): 2-min weather display + 4-min emoji slideshow.
+// Or, with a cron expression set, at the times it names (local time, via the
+// UTC offset the web UI sends along).
 // Speech interrupts the cycle (pauses display, resumes after).
 // Only one bot per WLED runs the scheduler (first-online claims ownership).
 //
 // Flow: IDLE -> WEATHER -> GAP -> EMOJI -> IDLE
+//
+// The cycle runs on the timeline (timeline.h): a rule fires TL_CONTENT step 0
+// and each step queues the next one when it starts. A step that can't run
+// yet — speech, streaming paused — is deferred by the timeline and retried,
+// so it starts late rather than cutting into what's playing. On a bot that
+// doesn't own the schedule the step is dropped: the owner runs the cycle,
+// and retrying here would only spin until ownership changed.
 // ============================================================================
 
 #define SCHED_DEFAULT_INTERVAL_MS  1800000  // 30 minutes
@@ -20,6 +30,7 @@
 #define SCHED_EMOJI_DURATION_MS    240000   // 4 minutes
 #define SCHED_GAP_DURATION_MS      3000     // 3s gap between weather and emoji
 #define SCHED_EMOJI_COUNT          20       // Random emojis per cycle
+#define SCHED_FIRST_CYCLE_MS       60000    // First cycle after enabling from the web UI
 
 // Forward declarations — mesh functions defined in esp_now_mesh.h (included after us)
 extern bool meshAnyPeerSchedOwnerForIP(uint32_t localIP);
@@ -33,6 +44,8 @@ extern uint32_t wledGetIPAsU32();
 struct ScheduledContentState {
   bool     enabled;
   uint32_t cycleIntervalMs;
+  char     cron[TIMELINE_CRON_LEN];   // Empty = every cycleIntervalMs
+  int16_t  utcOffsetMin;              // Local time for the cron expression
   unsigned long lastCycleStartMs;
 
   enum Phase : uint8_t {
@@ -50,6 +63,22 @@ struct ScheduledContentState {
 
 static ScheduledContentState schedContent = {};
 
+// The cycle, in order. TL_CONTENT's arg is an index here; one past the end
+// ends the cycle.
+struct SchedStep {
+  ScheduledContentState::Phase phase;
+  uint32_t durationMs;
+};
+
+static const SchedStep SCHED_PROGRAM[] = {
+  { ScheduledContentState::SCHED_WEATHER, SCHED_WEATHER_DURATION_MS },
+  { ScheduledContentState::SCHED_GAP,     SCHED_GAP_DURATION_MS },
+  { ScheduledContentState::SCHED_EMOJI,   SCHED_EMOJI_DURATION_MS },
+};
+#define SCHED_STEPS  (sizeof(SCHED_PROGRAM) / sizeof(SCHED_PROGRAM[0]))
+
+static void schedRebuild(uint32_t firstDelayMs);
+
 // ============================================================================
 // NVS Persistence
 // ============================================================================
@@ -59,12 +88,15 @@ void loadScheduleSettings() {
   prefs.begin("schedule", true);
   schedContent.enabled = prefs.getBool("enabled", false);
   schedContent.cycleIntervalMs = prefs.getUInt("intervalMs", SCHED_DEFAULT_INTERVAL_MS);
+  prefs.getString("cron", schedContent.cron, sizeof(schedContent.cron));
+  schedContent.utcOffsetMin = prefs.getShort("tzMin", 0);
   prefs.end();
 
   schedContent.phase = ScheduledContentState::SCHED_IDLE;
   schedContent.lastCycleStartMs = millis();
   schedContent.isOwner = false;
   schedContent.speechInterrupted = false;
+  schedRebuild(schedContent.cycleIntervalMs);
 }
 
 void saveScheduleSettings() {
@@ -72,6 +104,8 @@ void saveScheduleSettings() {
   prefs.begin("schedule", false);
   prefs.putBool("enabled", schedContent.enabled);
   prefs.putUInt("intervalMs", schedContent.cycleIntervalMs);
+  prefs.putString("cron", schedContent.cron);
+  prefs.putShort("tzMin", schedContent.utcOffsetMin);
   prefs.end();
 }
 
@@ -118,7 +152,95 @@ void schedOnSpeechEnd() {
     // Re-start emoji display with remaining time
     wledEmojiStart();
   }
-  // Weather: wledWeatherViewUpdate() will resume on next poll
+  // Weather: the render loop resumes wledWeatherViewUpdate() on its own
+}
+
+// ============================================================================
+// Cycle Steps — run by the timeline (Core 0)
+// ============================================================================
+
+// Leave the current phase
+static void schedExitPhase() {
+  switch (schedContent.phase) {
+    case ScheduledContentState::SCHED_WEATHER:
+      wledWeatherScheduled = false;  // Core 1 lingers on the card, then stops
+      break;
+    case ScheduledContentState::SCHED_EMOJI:
+      wledEmojiStop();
+      break;
+    default:
+      break;
+  }
+  schedContent.phase = ScheduledContentState::SCHED_IDLE;
+}
+
+static void schedEnterPhase(ScheduledContentState::Phase phase) {
+  switch (phase) {
+    case ScheduledContentState::SCHED_WEATHER:
+      requestWeatherFetch();
+      wledWeatherScheduled = true;   // Core 1 resets and drives the view
+      DBGLN("Sched: starting weather phase");
+      break;
+    case ScheduledContentState::SCHED_GAP:
+      DBGLN("Sched: weather done, gap");
+      break;
+    case ScheduledContentState::SCHED_EMOJI:
+      // Pick random emojis and start slideshow
+      schedPickRandomEmojis();
+      wledEmojiClear();
+      for (uint8_t i = 0; i < SCHED_EMOJI_COUNT; i++) {
+        wledEmojiAdd(schedContent.randomEmojis[i]);
+      }
+      wledEmojiStart();
+      DBGLN("Sched: starting emoji phase");
+      break;
+    default:
+      break;
+  }
+  schedContent.phase = phase;
+  schedContent.phaseStartMs = millis();
+}
+
+// TL_CONTENT handler. Returning false has the timeline retry the step.
+static bool schedContentEvent(uint8_t step, const TimelineCmd*) {
+  if (!schedContent.enabled) return true;   // Stale event — drop it
+  if (!schedContent.isOwner) {
+    schedExitPhase();                        // Lost ownership mid-cycle
+    return true;
+  }
+  if (!wledStreamAllowed || schedContent.speechInterrupted) return false;
+
+  if (step == 0) {
+    // A cycle still playing (a long speech stretched it) finishes first
+    if (schedContent.phase != ScheduledContentState::SCHED_IDLE) return false;
+    schedContent.lastCycleStartMs = millis();
+  }
+
+  schedExitPhase();
+  if (step >= SCHED_STEPS) {
+    DBGLN("Sched: cycle complete");
+    return true;
+  }
+  schedEnterPhase(SCHED_PROGRAM[step].phase);
+  timelineAfter(SCHED_PROGRAM[step].durationMs, TL_CONTENT, step + 1);
+  return true;
+}
+
+// Replace the cycle rule after a settings change; a cycle in progress stops.
+// Interval cycles first start firstDelayMs from now, cron cycles at the next
+// matching time.
+static void schedRebuild(uint32_t firstDelayMs) {
+  timelineRegister(TL_CONTENT, schedContentEvent);
+  timelineCancel(TL_CONTENT);
+  schedExitPhase();
+  if (!schedContent.enabled) return;
+
+  if (schedContent.cron[0]) {
+    if (timelineCron(schedContent.cron, schedContent.utcOffsetMin, TL_CONTENT, 0) >= 0) return;
+    DBG("Sched: bad cron expression, using the interval: ");
+    DBGLN(schedContent.cron);
+  }
+  timelineEvery(schedContent.cycleIntervalMs, firstDelayMs, TL_CONTENT, 0);
 }
 
 // ============================================================================
@@ -130,8 +252,6 @@ void pollScheduledContent() {
   if (!wledStreamAllowed) return;
   if (schedContent.speechInterrupted) return;
 
-  unsigned long now = millis();
-
   // Scheduler ownership: only one bot per WLED runs cycles
   uint32_t localIP = wledGetIPAsU32();
   if (localIP == 0) return;  // No WLED configured
@@ -151,53 +271,7 @@ void pollScheduledContent() {
     meshSetSchedOwner(true);
     DBGLN("Sched: claimed scheduler ownership");
   }
-
-  switch (schedContent.phase) {
-    case ScheduledContentState::SCHED_IDLE:
-      if ((now - schedContent.lastCycleStartMs) >= schedContent.cycleIntervalMs) {
-        // Start new cycle: weather phase
-        schedContent.phase = ScheduledContentState::SCHED_WEATHER;
-        schedContent.phaseStartMs = now;
-        schedContent.lastCycleStartMs = now;
-        requestWeatherFetch();
-        wledWeatherViewReset();
-        DBGLN("Sched: starting weather phase");
-      }
-      break;
-
-    case ScheduledContentState::SCHED_WEATHER:
-      wledWeatherViewUpdate();
-      if ((now - schedContent.phaseStartMs) >= SCHED_WEATHER_DURATION_MS) {
-        wledWeatherViewOnExit();
-        schedContent.phase = ScheduledContentState::SCHED_GAP;
-        schedContent.phaseStartMs = now;
-        DBGLN("Sched: weather done, gap");
-      }
-      break;
-
-    case ScheduledContentState::SCHED_GAP:
-      if ((now - schedContent.phaseStartMs) >= SCHED_GAP_DURATION_MS) {
-        // Start emoji phase: pick random emojis and start slideshow
-        schedPickRandomEmojis();
-        wledEmojiClear();
-        for (uint8_t i = 0; i < SCHED_EMOJI_COUNT; i++) {
-          wledEmojiAdd(schedContent.randomEmojis[i]);
-        }
-        wledEmojiStart();
-        schedContent.phase = ScheduledContentState::SCHED_EMOJI;
-        schedContent.phaseStartMs = now;
-        DBGLN("Sched: starting emoji phase");
-      }
-      break;
-
-    case ScheduledContentState::SCHED_EMOJI:
-      if ((now - schedContent.phaseStartMs) >= SCHED_EMOJI_DURATION_MS) {
-        wledEmojiStop();
-        schedContent.phase = ScheduledContentState::SCHED_IDLE;
-        DBGLN("Sched: cycle complete");
-      }
-      break;
-  }
+  // The cycle itself runs from the timeline
 }
 
 #endif // WLED_SCHEDULED_CONTENT_H
@@ -9,7 +9,8 @@
 #define WLED_WEATHER_GAP_MS         2000   // How long WLED shows its own effect between cards
 #define WLED_WEATHER_NUM_CARDS      5
 
-// Fade: 8 steps × 50ms = ~400ms per transition
+// Fade: 8 steps × 50ms = ~400ms per transition, even steps of perceived
+// brightness (wledGamma8 turns them into drive levels)
 #define WLED_WEATHER_FADE_STEPS     8
 #define WLED_WEATHER_FADE_STEP_MS   50
 #define WLED_WEATHER_FADE_FRAME_MS  150    // DDP hold per fade frame (> step interval)
@@ -17,16 +18,20 @@
 // ─── State machine ────────────────────────────────────────────────────────────
 //
 //   IDLE
-//    │  (first update, build card 0)
+//    │  (first update, card 0)
 //    ▼
 //   FADE_IN  ──────────────►  SHOWING  ──────────────►  FADE_OUT
-//    ▲   (scale 0→255, DDP)             (keepalive)      (scale 255→0, DDP)
+//    ▲   (level 0→255, DDP)             (keepalive)      (level 255→0, DDP)
 //    │                                                         │
-//    │   (build next card)                                     │ (last frame hold=150ms
+//    │   (next card)                                           │ (last frame hold=150ms
 //    └────────────── WLED_GAP ◄──────────────────────────────┘   → auto-restore fires;
 //                   (no DDP; WLED                                   wait GAP_MS)
 //                    runs freely)
 //
+// Cards are rendered once per weather update (or font change) into a frame
+// store at full brightness; showing one is a memcpy and a fade step is one
+// multiply per byte.
+//
 // ─────────────────────────────────────────────────────────────────────────────
 
 enum WledWeatherState : uint8_t {
@@ -43,8 +48,10 @@ static uint32_t         wledWeatherStepMs      = 0;
 static uint8_t          wledWeatherFadeStep    = 0;
 static uint32_t         wledWeatherKeepaliveMs = 0;
 
-// Full-brightness snapshot of current card — source for brightness-scaled fades
-static uint8_t          wledWeatherCardBuf[WLED_PIXEL_BYTES];
+// Full-brightness frame per card — source for every frame the view sends
+static uint8_t          wledWeatherCards[WLED_WEATHER_NUM_CARDS][WLED_PIXEL_BYTES];
+static uint16_t         wledWeatherCardsGen    = 0;
+static uint8_t          wledWeatherCardsFont   = 0xFF;   // 0xFF = not built yet
 
 // ─── Helpers ──────────────────────────────────────────────────────────────────
 
@@ -57,46 +64,58 @@ inline void wledTempColor(float f, uint8_t& r, uint8_t& g, uint8_t& b) {
   else              { r=255; g=0;   b=0;   }
 }
 
-// Render the current card into the pixel buffer and snapshot at full brightness
-static void wledWeatherBuildCard() {
+// Render one card at full brightness into the frame store
+static void wledWeatherBuildCard(uint8_t card) {
   uint8_t r, g, b;
   char buf[9];
-  wledPixelClear();
+  uint8_t* px = wledWeatherCards[card];
+  wledPixelClear(px);
 
-  switch (wledWeatherCard) {
+  switch (card) {
     case 0:
       snprintf(buf, sizeof(buf), "%dF", (int)weatherData.current.tempF);
       wledTempColor(weatherData.current.tempF, r, g, b);
-      wledPixelDrawText(buf, r, g, b);
+      wledPixelDrawText(px, buf, r, g, b);
       break;
     case 1:
       strncpy(buf, weatherData.current.conditionText, 8);
       buf[8] = '\0';
-      wledPixelDrawText(buf, 255, 255, 255);
+      wledPixelDrawText(px, buf, 255, 255, 255);
       break;
     case 2: case 3: case 4: {
-      uint8_t d = wledWeatherCard - 2;
+      uint8_t d = card - 2;
       snprintf(buf, sizeof(buf), "%s %dF",
                weatherData.forecast[d].dayName,
                (int)weatherData.forecast[d].highF);
       wledTempColor(weatherData.forecast[d].highF, r, g, b);
-      wledPixelDrawText(buf, r, g, b);
+      wledPixelDrawText(px, buf, r, g, b);
       break;
     }
   }
+}
 
-  memcpy(wledWeatherCardBuf, wledData.pixelBuffer, WLED_PIXEL_BYTES);
+// Re-render the frame store if the weather or the font changed since it was built
+static void wledWeatherSyncCards() {
+  uint16_t gen = weatherData.generation;
+  if (gen == wledWeatherCardsGen && wledData.font == wledWeatherCardsFont) return;
+  for (uint8_t i = 0; i < WLED_WEATHER_NUM_CARDS; i++) wledWeatherBuildCard(i);
+  wledWeatherCardsGen  = gen;
+  wledWeatherCardsFont = wledData.font;
 }
 
-// Scale the card snapshot into the pixel buffer and queue a DDP frame
-static void wledWeatherSendScaled(uint8_t scale, uint16_t holdMs) {
-  for (uint16_t i = 0; i < WLED_PIXEL_BYTES; i++) {
-    wledData.pixelBuffer[i] = ((uint16_t)wledWeatherCardBuf[i] * scale) >> 8;
-  }
+// Publish the current card at a perceived brightness level
+static void wledWeatherSend(uint8_t level, uint16_t holdMs) {
+  wledPixelFade(wledFrames.draft().px, wledWeatherCards[wledWeatherCard], level);
   wledQueueFrame(holdMs);
 }
 
 // ─── Public API ───────────────────────────────────────────────────────────────
+//
+// Everything here runs on Core 1 — the view publishes frames into wledFrames,
+// which takes a single producer. The scheduled weather phase (Core 0) only
+// raises wledWeatherScheduled and the render loop drives the view.
+
+volatile bool wledWeatherScheduled = false;
 
 void wledWeatherViewReset() {
   wledWeatherCard       = 0;
@@ -112,38 +131,39 @@ void wledWeatherViewOnExit() {
   if (!weatherData.valid) return;
   if (wledWeatherState == WWEATHER_WLED_GAP ||
       wledWeatherState == WWEATHER_IDLE) return;
-  wledWeatherSendScaled(255, 2500);
+  wledWeatherSyncCards();
+  wledWeatherSend(255, 2500);
 }
 
 void wledWeatherViewUpdate() {
   if (!weatherData.valid) return;
+  wledWeatherSyncCards();
 
   uint32_t now = millis();
 
   switch (wledWeatherState) {
 
-    // ── IDLE: first call — build card 0 and start fading in immediately ───────
+    // ── IDLE: first call — start fading card 0 in immediately ────────────────
     case WWEATHER_IDLE:
-      wledWeatherBuildCard();
       wledWeatherFadeStep = 0;
       wledWeatherStepMs   = 0;   // 0 forces immediate first step (now - 0 > STEP_MS)
       wledWeatherState    = WWEATHER_FADE_IN;
       break;
 
-    // ── FADE_IN: scale 0→255, send DDP frames every FADE_STEP_MS ─────────────
+    // ── FADE_IN: level 0→255, send DDP frames every FADE_STEP_MS ─────────────
     case WWEATHER_FADE_IN:
       if (now - wledWeatherStepMs < WLED_WEATHER_FADE_STEP_MS) return;
       wledWeatherStepMs = now;
       {
         // Ramp: ~31, 63, 95, 127, 159, 191, 223, 255
-        uint8_t scale = ((uint16_t)(wledWeatherFadeStep + 1) * 255) / WLED_WEATHER_FADE_STEPS;
-        wledWeatherSendScaled(scale, WLED_WEATHER_FADE_FRAME_MS);
+        uint8_t level = ((uint16_t)(wledWeatherFadeStep + 1) * 255) / WLED_WEATHER_FADE_STEPS;
+        wledWeatherSend(level, WLED_WEATHER_FADE_FRAME_MS);
         wledWeatherFadeStep++;
         if (wledWeatherFadeStep >= WLED_WEATHER_FADE_STEPS) {
           wledWeatherKeepaliveMs = now;
           wledWeatherStepMs      = now;
           wledWeatherState       = WWEATHER_SHOWING;
-          wledWeatherSendScaled(255, 2500);   // initial full-brightness hold
+          wledWeatherSend(255, 2500);   // initial full-brightness hold
         }
       }
       break;
@@ -153,7 +173,7 @@ void wledWeatherViewUpdate() {
       // Keepalive every 2s — WLED exits realtime after 2.5s without DDP frames
       if (now - wledWeatherKeepaliveMs >= 2000) {
         wledWeatherKeepaliveMs = now;
-        wledWeatherSendScaled(255, 2500);
+        wledWeatherSend(255, 2500);
       }
       if (now - wledWeatherStepMs < WLED_WEATHER_CARD_MS) return;
       wledWeatherFadeStep = 0;
@@ -161,25 +181,25 @@ void wledWeatherViewUpdate() {
       wledWeatherState    = WWEATHER_FADE_OUT;
       break;
 
-    // ── FADE_OUT: scale 255→0, last frame's short hold triggers auto-restore ─
+    // ── FADE_OUT: level 255→0, last frame's short hold triggers auto-restore ─
     case WWEATHER_FADE_OUT:
       if (now - wledWeatherStepMs < WLED_WEATHER_FADE_STEP_MS) return;
       wledWeatherStepMs = now;
       {
         // Ramp: ~223, 191, 159, 127, 95, 63, 31, 0
-        uint8_t scale = ((uint16_t)(WLED_WEATHER_FADE_STEPS - wledWeatherFadeStep - 1) * 255)
+        uint8_t level = ((uint16_t)(WLED_WEATHER_FADE_STEPS - wledWeatherFadeStep - 1) * 255)
                         / WLED_WEATHER_FADE_STEPS;
         wledWeatherFadeStep++;
         if (wledWeatherFadeStep >= WLED_WEATHER_FADE_STEPS) {
           // Send a black frame with a short hold — when it expires (~150ms),
           // pollWledDisplay() fires the HTTP restore and WLED resumes its effect.
-          wledWeatherSendScaled(0, WLED_WEATHER_FADE_FRAME_MS);
+          wledWeatherSend(0, WLED_WEATHER_FADE_FRAME_MS);
           // Advance card and sit in gap for GAP_MS
           wledWeatherCard = (wledWeatherCard + 1) % WLED_WEATHER_NUM_CARDS;
           wledWeatherStepMs = now;
           wledWeatherState  = WWEATHER_WLED_GAP;
         } else {
-          wledWeatherSendScaled(scale, WLED_WEATHER_FADE_FRAME_MS);
+          wledWeatherSend(level, WLED_WEATHER_FADE_FRAME_MS);
         }
       }
       break;
@@ -187,8 +207,7 @@ void wledWeatherViewUpdate() {
     // ── WLED_GAP: no DDP — WLED runs its own effect freely ───────────────────
     case WWEATHER_WLED_GAP:
       if (now - wledWeatherStepMs < WLED_WEATHER_GAP_MS) return;
-      // Gap done — build next card and fade it in
-      wledWeatherBuildCard();
+      // Gap done — fade the next card in
       wledWeatherFadeStep = 0;
       wledWeatherStepMs   = 0;   // force immediate first fade-in step
       wledWeatherState    = WWEATHER_FADE_IN;
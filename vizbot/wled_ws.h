@@ -0,0 +1,315 @@
+#ifndef WLED_WS_H
+#define WLED_WS_H
+
+// ============================================================================
+// WLED WebSocket — live state push instead of polling /json/state
+// ============================================================================
+// WLED sends its whole {"state": ..., "info": ...} document to every /ws
+// client right after the upgrade and again whenever anything changes (app,
+// button, preset, sync from another device). Keeping that socket open
+// replaces the idle /json/state poll: a palette change reaches Core 1 one
+// loop pass after WLED sends it, and a WLED that sits still costs a 6-byte
+// ping every WLED_WS_PING_MS.
+//
+// Pushes are parsed as the bytes arrive with the same handler as the HTTP
+// capture (wledSegHandler, path "state/seg/0"), so a message is never held
+// in memory — the seg[0] fields are picked out and the rest (info, other
+// segments) skipped unparsed. At most WLED_WS_READ_BUDGET bytes are read per
+// call so a big push can't stall the Core 0 loop.
+//
+// When the socket can't be opened (WLED built without WebSockets, its client
+// limit reached) or goes silent, pollWledDisplay() falls back to the adaptive
+// /json/state poll and tries again after WLED_WS_RETRY_MS. The handshake
+// doesn't check Sec-WebSocket-Accept: that needs SHA-1 and buys nothing on a
+// LAN socket we only read state from.
+//
+// Core 0 only. Must be #included inside wled_display.h after
+// wledStoreSegState().
+// ============================================================================
+
+#define WLED_WS_PING_MS      15000   // Keepalive after this much silence
+#define WLED_WS_DEAD_MS      40000   // No data, not even a pong → drop it
+#define WLED_WS_RETRY_MS     60000   // Wait after a failed or lost connection
+#define WLED_WS_READ_BUDGET  1024    // Bytes read per wledWsPoll()
+#define WLED_WS_CTRL_LEN     125     // Largest control frame payload (RFC 6455)
+
+// Frame opcodes
+#define WLED_WS_OP_CONT   0x0
+#define WLED_WS_OP_TEXT   0x1
+#define WLED_WS_OP_BINARY 0x2
+#define WLED_WS_OP_CLOSE  0x8
+#define WLED_WS_OP_PING   0x9
+#define WLED_WS_OP_PONG   0xA
+
+enum WledWsState : uint8_t {
+  WLED_WS_CLOSED = 0,
+  WLED_WS_HANDSHAKE,            // Upgrade sent, reading the response headers
+  WLED_WS_OPEN,
+};
+
+struct WledWs {
+  WiFiClient client;
+  WledWsState state;
+  HttpStream http;              // Upgrade response (headers only)
+  unsigned long sinceMs;        // Handshake start
+  unsigned long lastRxMs;       // Last byte received
+  unsigned long lastPingMs;
+  unsigned long closedMs;       // With retryMs: when to try again
+  unsigned long retryMs;
+
+  // Frame parser
+  uint8_t hdr[14];
+  uint8_t hdrLen;
+  uint8_t hdrNeed;
+  uint8_t opcode;               // Frame being read
+  bool fin;
+  uint32_t payloadLeft;
+  bool textMsg;                 // Current message is text → JSON parser
+  JsonStream json;
+  WledSegState seg;
+  uint8_t ctrl[WLED_WS_CTRL_LEN];
+  uint8_t ctrlLen;
+
+  // Stats
+  uint32_t connects;
+  uint32_t pushes;              // State pushes applied
+};
+
+static WledWs wledWs = {};
+
+inline bool wledWsOpen() {
+  return wledWs.state == WLED_WS_OPEN;
+}
+
+// Drop the socket; the idle poll takes over until retryMs has passed
+void wledWsClose(unsigned long retryMs) {
+  if (wledWs.state != WLED_WS_CLOSED) wledWs.client.stop();
+  wledWs.state = WLED_WS_CLOSED;
+  wledWs.closedMs = millis();
+  wledWs.retryMs = retryMs;
+}
+
+// True once the retry wait after the last close has run out
+inline bool wledWsRetryDue() {
+  return wledWs.state == WLED_WS_CLOSED &&
+         millis() - wledWs.closedMs >= wledWs.retryMs;
+}
+
+// Client → server frames must be masked. Control frames only, so len ≤ 125.
+static bool wledWsSend(uint8_t opcode, const uint8_t* data, uint8_t len) {
+  uint8_t frame[6 + WLED_WS_CTRL_LEN];
+  uint32_t key = esp_random();
+  frame[0] = 0x80 | opcode;     // FIN
+  frame[1] = 0x80 | len;        // MASK
+  memcpy(frame + 2, &key, 4);
+  for (uint8_t i = 0; i < len; i++) frame[6 + i] = data[i] ^ frame[2 + (i & 3)];
+  return wledWs.client.write(frame, 6 + len) == (size_t)(6 + len);
+}
+
+// Open /ws and send the upgrade request. Blocks only for the TCP connect,
+// like the HTTP helpers — the response is read by wledWsPoll().
+bool wledWsConnect() {
+  wledWsClose(WLED_WS_RETRY_MS);   // Where we end up if anything below fails
+  if (!wledWs.client.connect(wledData.ip, 80)) return false;
+
+  // Sec-WebSocket-Key: 16 random bytes, base64
+  static const char B64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  uint8_t nonce[18] = {0};
+  for (uint8_t i = 0; i < 16; i += 4) {
+    uint32_t r = esp_random();
+    memcpy(nonce + i, &r, 4);
+  }
+  char key[25];
+  for (uint8_t i = 0, o = 0; i < 18; i += 3) {
+    uint32_t v = ((uint32_t)nonce[i] << 16) | (nonce[i + 1] << 8) | nonce[i + 2];
+    key[o++] = B64[(v >> 18) & 63];
+    key[o++] = B64[(v >> 12) & 63];
+    key[o++] = B64[(v >> 6) & 63];
+    key[o++] = B64[v & 63];
+  }
+  key[22] = '=';
+  key[23] = '=';
+  key[24] = '\0';
+
+  wledWs.client.printf("GET /ws HTTP/1.1\r\n"
+                       "Host: %s\r\n"
+                       "Upgrade: websocket\r\n"
+                       "Connection: Upgrade\r\n"
+                       "Sec-WebSocket-Key: %s\r\n"
+                       "Sec-WebSocket-Version: 13\r\n"
+                       "\r\n",
+                       wledData.ip, key);
+
+  wledWs.http.begin(nullptr);
+  wledWs.state = WLED_WS_HANDSHAKE;
+  wledWs.sinceMs = millis();
+  wledWs.connects++;
+  return true;
+}
+
+// A frame's payload is complete. Returns false to drop the connection.
+static bool wledWsEndFrame() {
+  switch (wledWs.opcode) {
+    case WLED_WS_OP_CLOSE:
+      wledWsSend(WLED_WS_OP_CLOSE, wledWs.ctrl, min(wledWs.ctrlLen, (uint8_t)2));
+      WLED_DBGLN("WLED: ws closed by WLED");
+      return false;
+
+    case WLED_WS_OP_PING:
+      return wledWsSend(WLED_WS_OP_PONG, wledWs.ctrl, wledWs.ctrlLen);
+
+    case WLED_WS_OP_PONG:
+      return true;
+
+    default:
+      if (!wledWs.fin || !wledWs.textMsg) return true;
+      wledWs.textMsg = false;
+      // Replies like {"success":true} have no seg[0] and are ignored
+      if ((wledWs.json.result == JSON_STREAM_DONE || wledWs.json.result == JSON_STREAM_STOPPED) &&
+          wledWs.seg.found) {
+        wledStoreSegState(wledWs.seg);
+        wledData.reachable = true;
+        wledWs.pushes++;
+      }
+      return true;
+  }
+}
+
+// Header complete — set up for the payload. Returns false on a frame we
+// can't accept (masked, oversized control, 64-bit length).
+static bool wledWsBeginFrame() {
+  const uint8_t* h = wledWs.hdr;
+  uint8_t len7 = h[1] & 0x7F;
+  uint32_t len = len7;
+  if (len7 == 126) {
+    len = ((uint32_t)h[2] << 8) | h[3];
+  } else if (len7 == 127) {
+    if (h[2] | h[3] | h[4] | h[5]) return false;
+    len = ((uint32_t)h[6] << 24) | ((uint32_t)h[7] << 16) | ((uint32_t)h[8] << 8) | h[9];
+  }
+
+  wledWs.fin = h[0] & 0x80;
+  wledWs.opcode = h[0] & 0x0F;
+  wledWs.payloadLeft = len;
+
+  switch (wledWs.opcode) {
+    case WLED_WS_OP_TEXT:
+      memset(&wledWs.seg, 0, sizeof(wledWs.seg));
+      wledWs.seg.path = "state/seg/0";
+      wledWs.json.begin(wledSegHandler, &wledWs.seg);
+      wledWs.textMsg = true;
+      break;
+    case WLED_WS_OP_CONT:
+      break;                    // Continues whatever message is open
+    case WLED_WS_OP_BINARY:
+      wledWs.textMsg = false;   // Live LED preview — not ours, skipped
+      break;
+    default:
+      if (len > WLED_WS_CTRL_LEN) return false;
+      wledWs.ctrlLen = 0;
+      break;
+  }
+
+  return len > 0 || wledWsEndFrame();
+}
+
+// Run received bytes through the frame parser. Returns false to drop the
+// connection.
+static bool wledWsFeed(const uint8_t* buf, size_t n) {
+  size_t i = 0;
+  while (i < n) {
+    if (wledWs.payloadLeft == 0) {
+      wledWs.hdr[wledWs.hdrLen++] = buf[i++];
+      if (wledWs.hdrLen == 2) {
+        if (wledWs.hdr[1] & 0x80) return false;   // Servers never mask
+        uint8_t len7 = wledWs.hdr[1] & 0x7F;
+        wledWs.hdrNeed = 2 + (len7 == 126 ? 2 : len7 == 127 ? 8 : 0);
+      }
+      if (wledWs.hdrLen < wledWs.hdrNeed) continue;
+      wledWs.hdrLen = 0;
+      wledWs.hdrNeed = 2;
+      if (!wledWsBeginFrame()) return false;
+      continue;
+    }
+
+    size_t run = min(n - i, (size_t)wledWs.payloadLeft);
+    if (wledWs.opcode >= WLED_WS_OP_CLOSE) {
+      memcpy(wledWs.ctrl + wledWs.ctrlLen, buf + i, run);
+      wledWs.ctrlLen += run;
+    } else if (wledWs.textMsg) {
+      wledWs.json.feed((const char*)buf + i, run);   // No-op once seg[0] is read
+    }
+    i += run;
+    wledWs.payloadLeft -= run;
+    if (wledWs.payloadLeft == 0 && !wledWsEndFrame()) return false;
+  }
+  return true;
+}
+
+// Service the socket: finish the handshake, apply pushes, keep it alive.
+// Cheap when closed — call every pass of the Core 0 loop.
+void wledWsPoll() {
+  if (wledWs.state == WLED_WS_CLOSED) return;
+  WiFiClient& c = wledWs.client;
+  uint16_t budget = WLED_WS_READ_BUDGET;
+
+  if (wledWs.state == WLED_WS_HANDSHAKE) {
+    // A byte at a time: the first push can follow the headers in one segment
+    while (budget > 0 && !wledWs.http.headersDone() && c.available() > 0) {
+      uint8_t b = c.read();
+      budget--;
+      if (wledWs.http.feed(&b, 1) == JSON_STREAM_ERROR) break;
+    }
+    if (wledWs.http.headersDone() && wledWs.http.status == 101) {
+      wledWs.state = WLED_WS_OPEN;
+      wledWs.lastRxMs = millis();
+      wledWs.lastPingMs = millis();
+      wledWs.hdrLen = 0;
+      wledWs.hdrNeed = 2;
+      wledWs.payloadLeft = 0;
+      wledWs.textMsg = false;
+      WLED_DBGLN("WLED: ws connected, state pushed");
+    } else if (wledWs.http.headersDone() || wledWs.http.state == HttpStream::H_ERROR ||
+               !c.connected() || millis() - wledWs.sinceMs > WLED_HTTP_TIMEOUT_MS) {
+      WLED_DBG("WLED: no ws (HTTP ");
+      WLED_DBG(wledWs.http.status);
+      WLED_DBGLN("), polling");
+      wledWsClose(WLED_WS_RETRY_MS);
+      return;
+    } else {
+      return;
+    }
+  }
+
+  uint8_t win[WLED_HTTP_WINDOW];
+  while (budget > 0) {
+    int avail = c.available();
+    if (avail <= 0) {
+      if (!c.connected()) {
+        WLED_DBGLN("WLED: ws dropped, polling");
+        wledWsClose(WLED_WS_RETRY_MS);
+        return;
+      }
+      break;
+    }
+    int n = c.read(win, min(avail, (int)min((uint16_t)sizeof(win), budget)));
+    if (n <= 0) break;
+    budget -= n;
+    wledWs.lastRxMs = millis();
+    if (!wledWsFeed(win, n)) {
+      wledWsClose(WLED_WS_RETRY_MS);
+      return;
+    }
+  }
+
+  unsigned long quiet = millis() - wledWs.lastRxMs;
+  if (quiet > WLED_WS_DEAD_MS) {
+    WLED_DBGLN("WLED: ws silent, polling");
+    wledWsClose(WLED_WS_RETRY_MS);
+  } else if (quiet > WLED_WS_PING_MS && millis() - wledWs.lastPingMs > WLED_WS_PING_MS) {
+    wledWs.lastPingMs = millis();
+    if (!wledWsSend(WLED_WS_OP_PING, nullptr, 0)) wledWsClose(WLED_WS_RETRY_MS);
+  }
+}
+
+#endif // WLED_WS_H
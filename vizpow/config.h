@@ -49,6 +49,14 @@
 // Manual override: uncomment to enable both displays (if hardware supports)
 // #define DISPLAY_DUAL
 
+#if defined(DISPLAY_LCD_ONLY) || defined(DISPLAY_DUAL)
+  #define LCD_WIDTH 240
+  #define LCD_HEIGHT 280
+  // Forward-declared here so vizfx's hi-res effects can use 'extern GfxDevice *gfx;'
+  class Arduino_GFX;
+  typedef Arduino_GFX GfxDevice;
+#endif
+
 // ============================================================================
 // Hardware Configuration - Board Specific
 // ============================================================================
@@ -58,6 +66,10 @@
   #define DATA_PIN 14
   #define I2C_SDA 11
   #define I2C_SCL 12
+  // QMI8658 INT2 isn't routed on this board. If it is wired to a free GPIO,
+  // define IMU_WAKE_PIN to wake from light sleep on motion.
+  // #define IMU_WAKE_PIN 13
+  #define IMU_WAKE_THRESHOLD_MG 200  // Wake-on-motion threshold
 
 #elif defined(BOARD_ESP32S3_LCD_169)
   // Waveshare ESP32-S3-Touch-LCD-1.69 board pins
@@ -81,12 +93,41 @@
   #error "Select a board: BOARD_ESP32S3_MATRIX or BOARD_ESP32S3_LCD_169"
 #endif
 
+// ============================================================================
+// LED Layout — canvas size, data pins and panel map (see led_output.h)
+// ============================================================================
+// Default: the onboard 8x8 on DATA_PIN. Larger installations select a layout
+// with a build flag; each output pin drives its own chain in parallel.
+// Panel fields: output, x, y, w, h, rotation (quarter turns cw), serpentine
+#if defined(LED_LAYOUT_QUAD_16X16)
+  // Four 16x16 serpentine panels as a 32x32 canvas, one panel per pin
+  #if defined(TARGET_LCD)
+    #error "LED_LAYOUT_QUAD_16X16 is for TARGET_LED builds"
+  #endif
+  #define MATRIX_WIDTH 32
+  #define MATRIX_HEIGHT 32
+  #define LED_OUTPUT_PINS { 1, 2, 4, 5 }
+  #define LED_PANEL_MAP { \
+    { 0,  0,  0, 16, 16, 0, true }, \
+    { 1, 16,  0, 16, 16, 0, true }, \
+    { 2,  0, 16, 16, 16, 0, true }, \
+    { 3, 16, 16, 16, 16, 0, true }, \
+  }
+  #define LED_COLOR_ORDER GRB
+  #undef MAX_LED_POWER_MA
+  #define MAX_LED_POWER_MA 8000      // External 5V supply sized for the panels
+#else
+  #define MATRIX_WIDTH 8
+  #define MATRIX_HEIGHT 8
+  #define LED_OUTPUT_PINS { DATA_PIN }
+  #define LED_PANEL_MAP { { 0, 0, 0, 8, 8, 0, false } }
+  #define LED_COLOR_ORDER RGB
+#endif
+
 // ============================================================================
 // Common Configuration
 // ============================================================================
-#define NUM_LEDS 64
-#define MATRIX_WIDTH 8
-#define MATRIX_HEIGHT 8
+#define NUM_LEDS (MATRIX_WIDTH * MATRIX_HEIGHT)
 
 // WiFi AP configuration
 #define WIFI_SSID "VizPow"
@@ -123,9 +164,6 @@
   #define DBGLN(...)
 #endif
 
-// XY mapping - trying NO serpentine (straight rows)
-inline uint16_t XY(uint8_t x, uint8_t y) {
-  return y * MATRIX_WIDTH + x;
-}
+// XY() mapping lives in vizfx_canvas.h (table built by led_output.h)
 
 #endif
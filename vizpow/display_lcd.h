@@ -2,15 +2,14 @@
 #define DISPLAY_LCD_H
 
 #include "config.h"
+#include <vizfx_canvas.h>
 
 // Only compile LCD code if LCD display is enabled
 #if defined(DISPLAY_LCD_ONLY) || defined(DISPLAY_DUAL)
 
 #include <Arduino_GFX_Library.h>
 
-// LCD display constants
-#define LCD_WIDTH 240
-#define LCD_HEIGHT 280
+// LCD display constants (LCD_WIDTH / LCD_HEIGHT are in config.h)
 #define PIXEL_SIZE 26
 #define PIXEL_GAP 4
 #define GRID_SIZE (PIXEL_SIZE * MATRIX_WIDTH + PIXEL_GAP * (MATRIX_WIDTH - 1))  // 224 pixels total
@@ -28,12 +27,25 @@ Arduino_GFX *gfx = nullptr;
 bool hiResMode = false;
 bool hiResRenderedThisFrame = false;  // Set by hi-res effects to skip 8x8 rendering
 
+// What each grid cell currently shows (RGB565 after brightness), so frames
+// only push the cells that changed. Anything else drawing on the screen
+// (menu, hi-res effects, clears) must invalidate it.
+uint16_t lcdCellCache[NUM_LEDS];
+bool lcdGridValid = false;
+uint32_t lcdCellsPushed = 0;    // fillRect calls for grid cells
+uint32_t lcdFramesSkipped = 0;  // Frames with nothing to push
+
+inline void invalidateLCDGrid() {
+  lcdGridValid = false;
+}
+
 // Toggle hi-res mode
 inline void toggleHiResMode() {
   hiResMode = !hiResMode;
   if (gfx != nullptr) {
     gfx->fillScreen(COLOR_BLACK);  // Clear screen when switching modes
   }
+  invalidateLCDGrid();
   DBG("Hi-Res Mode: ");
   DBGLN(hiResMode ? "ON" : "OFF");
 }
@@ -91,31 +103,47 @@ extern bool menuVisible;
 extern uint8_t currentMode;
 
 // Render the leds[] buffer to the LCD display
-// Each LED is drawn as a PIXEL_SIZE x PIXEL_SIZE square
-void renderToLCD() {
+// Each LED is drawn as a PIXEL_SIZE x PIXEL_SIZE square; only cells whose
+// colour changed since the last push are redrawn. frameChanged comes from
+// showDisplay()'s frame diff and lets a held frame skip the walk entirely.
+void renderToLCD(bool frameChanged) {
   // Don't render LED display while touch menu is visible
   #if defined(TOUCH_ENABLED)
-  if (menuVisible) return;
+  if (menuVisible) {
+    invalidateLCDGrid();  // Menu covers the grid — repaint all when it closes
+    return;
+  }
   #endif
 
   // Don't render 8x8 grid if a hi-res effect already rendered this frame
   if (hiResRenderedThisFrame) {
     hiResRenderedThisFrame = false;  // Reset for next frame
+    invalidateLCDGrid();
     return;
   }
 
   extern CRGB leds[];      // Reference the global leds array from vizpow.ino
   extern uint8_t brightness; // Reference brightness for LCD scaling
+  static uint8_t lastBrightness = 0;
+
+  if (!frameChanged && lcdGridValid && brightness == lastBrightness) {
+    lcdFramesSkipped++;
+    return;
+  }
+  lastBrightness = brightness;
 
+  bool pushed = false;
   for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
     for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
       // Get the LED color using the XY mapping
-      uint16_t ledIndex = XY(x, y);
-      CRGB color = leds[ledIndex];
+      CRGB color = leds[XY(x, y)];
       color.nscale8_video(brightness);  // Apply brightness scaling for LCD
 
-      // Convert to RGB565
+      // Convert to RGB565 and skip cells that already show it
       uint16_t color565 = crgbToRgb565(color);
+      uint16_t& cell = lcdCellCache[y * MATRIX_WIDTH + x];
+      if (lcdGridValid && cell == color565) continue;
+      cell = color565;
 
       // Calculate screen position for this "pixel"
       int16_t screenX = GRID_OFFSET_X + x * (PIXEL_SIZE + PIXEL_GAP);
@@ -123,8 +151,12 @@ void renderToLCD() {
 
       // Draw filled rectangle
       gfx->fillRect(screenX, screenY, PIXEL_SIZE, PIXEL_SIZE, color565);
+      lcdCellsPushed++;
+      pushed = true;
     }
   }
+  if (!pushed) lcdFramesSkipped++;
+  lcdGridValid = true;
 }
 
 // Optional: Set LCD backlight brightness (0-255)
@@ -135,13 +167,14 @@ void setLCDBacklight(uint8_t brightness) {
 // Optional: Clear the LCD to black
 void clearLCD() {
   gfx->fillScreen(COLOR_BLACK);
+  invalidateLCDGrid();
 }
 
 #else
 
 // Stub functions when LCD is disabled (allows code to compile)
 inline void initLCD() {}
-inline void renderToLCD() {}
+inline void renderToLCD(bool frameChanged) {}
 inline void setLCDBacklight(uint8_t brightness) {}
 inline void clearLCD() {}
 
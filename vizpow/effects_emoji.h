@@ -3,14 +3,17 @@
 
 #include <FastLED.h>
 #include "config.h"
-#include "emoji_sprites.h"
+#include <vizfx_canvas.h>
+#include <vizfx_sprites.h>
 
 // External references to globals defined in main sketch
 extern CRGB leds[];
 
+#define EMOJI_SIZE 8   // Icons are 8x8 whatever the canvas size
+
 // Emoji frame structure - stores 64 RGB pixels
 struct EmojiFrame {
-  CRGB pixels[64];
+  CRGB pixels[EMOJI_SIZE * EMOJI_SIZE];
   bool active;
 };
 
@@ -96,22 +99,35 @@ bool addEmojiByIndex(uint8_t spriteIndex) {
   return true;
 }
 
+// Icon pixel under canvas pixel (x, y), or -1 in the margin beside a
+// centred icon on non-square canvases
+inline int emojiSrcIndex(uint8_t x, uint8_t y) {
+  uint8_t sx, sy;
+  if (!canvasSpriteCell(x, y, sx, sy)) return -1;
+  return sy * EMOJI_SIZE + sx;
+}
+
 // Display single emoji using XY() mapping
 void displayEmoji(EmojiFrame* frame) {
   // Icons are stored in visual order (left-to-right, top-to-bottom)
-  // XY() converts visual coordinates to physical LED index for serpentine matrix
-  for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-    for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-      leds[XY(x, y)] = frame->pixels[y * MATRIX_WIDTH + x];
+  // XY() converts visual coordinates to physical LED index via the panel map
+  for (uint8_t y = 0; y < canvas.height; y++) {
+    for (uint8_t x = 0; x < canvas.width; x++) {
+      int srcIndex = emojiSrcIndex(x, y);
+      leds[XY(x, y)] = srcIndex < 0 ? CRGB::Black : frame->pixels[srcIndex];
     }
   }
 }
 
 // Blend between two emojis for fade transition
 void blendEmojis(EmojiFrame* from, EmojiFrame* to, uint8_t blendAmount) {
-  for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
-    for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
-      int srcIndex = y * MATRIX_WIDTH + x;  // Direct mapping - XY() handles serpentine
+  for (uint8_t y = 0; y < canvas.height; y++) {
+    for (uint8_t x = 0; x < canvas.width; x++) {
+      int srcIndex = emojiSrcIndex(x, y);  // XY() handles the panel wiring
+      if (srcIndex < 0) {
+        leds[XY(x, y)] = CRGB::Black;
+        continue;
+      }
       leds[XY(x, y)] = blend(from->pixels[srcIndex], to->pixels[srcIndex], blendAmount);
     }
   }
@@ -121,12 +137,13 @@ void blendEmojis(EmojiFrame* from, EmojiFrame* to, uint8_t blendAmount) {
 void runEmojiEffect() {
   // Handle empty queue - show a subtle indication
   if (emojiQueueCount == 0) {
-    FastLED.clear();
+    fill_solid(leds, canvas.size, CRGB::Black);
     // Show a dim center pixel as "waiting" indicator
-    leds[XY(3, 3)] = CRGB(5, 5, 10);
-    leds[XY(4, 3)] = CRGB(5, 5, 10);
-    leds[XY(3, 4)] = CRGB(5, 5, 10);
-    leds[XY(4, 4)] = CRGB(5, 5, 10);
+    uint8_t cx = canvas.width / 2, cy = canvas.height / 2;
+    leds[XY(cx - 1, cy - 1)] = CRGB(5, 5, 10);
+    leds[XY(cx, cy - 1)] = CRGB(5, 5, 10);
+    leds[XY(cx - 1, cy)] = CRGB(5, 5, 10);
+    leds[XY(cx, cy)] = CRGB(5, 5, 10);
     return;
   }
 
@@ -0,0 +1,148 @@
+#ifndef LED_OUTPUT_H
+#define LED_OUTPUT_H
+
+#include <FastLED.h>
+#include "config.h"
+#include <vizfx_canvas.h>
+
+// ============================================================================
+// LED Outputs — canvas → panels → data pins
+// ============================================================================
+// Effects draw on a MATRIX_WIDTH x MATRIX_HEIGHT canvas through XY(). The
+// canvas is cut into panels (LED_PANEL_MAP in config.h); every panel sits on
+// one data pin, and panels sharing a pin are chained in table order.
+//
+// leds[] is kept in wire order — output 0's chain, then output 1's, ... — so
+// each output is one contiguous slice handed straight to FastLED, and XY() is
+// a single table lookup. No per-frame copy or reorder.
+//
+// Each output is its own FastLED controller, i.e. its own RMT channel on the
+// ESP32-S3 (4 TX channels). FastLED starts every channel before waiting for
+// any, so a frame costs the longest chain rather than the sum of them:
+//   frame time ≈ LEDs on the longest output × 30 µs + 300 µs reset
+// ============================================================================
+
+struct LedPanel {
+  uint8_t output;      // Index into LED_OUTPUT_PINS
+  uint8_t x, y;        // Top-left corner on the canvas
+  uint8_t w, h;        // Footprint on the canvas, in LEDs
+  uint8_t rotation;    // Quarter turns clockwise as mounted (0-3)
+  bool    serpentine;  // Odd rows (as wired) run backwards
+};
+
+static constexpr uint8_t ledOutputPins[] = LED_OUTPUT_PINS;
+static constexpr LedPanel ledPanels[] = LED_PANEL_MAP;
+
+#define LED_OUTPUT_COUNT (sizeof(ledOutputPins) / sizeof(ledOutputPins[0]))
+#define LED_PANEL_COUNT  (sizeof(ledPanels) / sizeof(ledPanels[0]))
+#define LED_RESET_US     300     // WS2812B latch (newer parts need > 280 µs)
+#define LED_US_PER_LED   30      // 24 bits x 1.25 µs
+
+static_assert(LED_OUTPUT_COUNT >= 1 && LED_OUTPUT_COUNT <= 4,
+              "ESP32-S3 has 4 RMT TX channels — 1 to 4 LED outputs");
+
+constexpr uint32_t ledPanelArea() {
+  uint32_t area = 0;
+  for (uint8_t i = 0; i < LED_PANEL_COUNT; i++) area += ledPanels[i].w * ledPanels[i].h;
+  return area;
+}
+
+static_assert(ledPanelArea() == NUM_LEDS, "LED_PANEL_MAP must tile the canvas exactly");
+
+uint16_t ledXYMap[NUM_LEDS];                  // y * MATRIX_WIDTH + x → leds[] index
+uint16_t ledOutputStart[LED_OUTPUT_COUNT];    // First leds[] index of each output
+uint16_t ledOutputLen[LED_OUTPUT_COUNT];
+
+// Position of footprint pixel (u, v) along a panel's own wiring
+uint16_t ledPanelIndex(const LedPanel& p, uint8_t u, uint8_t v) {
+  uint8_t nu, nv, nativeW;
+  switch (p.rotation & 3) {
+    case 1:  nu = v;             nv = p.w - 1 - u;   nativeW = p.h; break;
+    case 2:  nu = p.w - 1 - u;   nv = p.h - 1 - v;   nativeW = p.w; break;
+    case 3:  nu = p.h - 1 - v;   nv = u;             nativeW = p.h; break;
+    default: nu = u;             nv = v;             nativeW = p.w; break;
+  }
+  if (p.serpentine && (nv & 1)) nu = nativeW - 1 - nu;
+  return nv * nativeW + nu;
+}
+
+// Build the XY table and output slices from the panel map. Returns false if
+// panels overlap or fall off the canvas (the table is still safe to use).
+bool buildLedMap() {
+  for (uint16_t i = 0; i < NUM_LEDS; i++) ledXYMap[i] = 0xFFFF;
+
+  // Outputs are laid out in pin order; panels chain in table order
+  uint16_t start = 0;
+  for (uint8_t o = 0; o < LED_OUTPUT_COUNT; o++) {
+    ledOutputStart[o] = start;
+    ledOutputLen[o] = 0;
+    for (uint8_t i = 0; i < LED_PANEL_COUNT; i++) {
+      if (ledPanels[i].output == o) ledOutputLen[o] += ledPanels[i].w * ledPanels[i].h;
+    }
+    start += ledOutputLen[o];
+  }
+
+  bool ok = true;
+  uint16_t chainPos[LED_OUTPUT_COUNT] = {0};
+  for (uint8_t i = 0; i < LED_PANEL_COUNT; i++) {
+    const LedPanel& p = ledPanels[i];
+    if (p.output >= LED_OUTPUT_COUNT) {
+      ok = false;
+      continue;
+    }
+    uint16_t base = ledOutputStart[p.output] + chainPos[p.output];
+    chainPos[p.output] += p.w * p.h;
+    for (uint8_t v = 0; v < p.h; v++) {
+      for (uint8_t u = 0; u < p.w; u++) {
+        uint16_t cx = p.x + u, cy = p.y + v;
+        if (cx >= MATRIX_WIDTH || cy >= MATRIX_HEIGHT) {
+          ok = false;
+          continue;
+        }
+        uint16_t& slot = ledXYMap[cy * MATRIX_WIDTH + cx];
+        if (slot != 0xFFFF) ok = false;
+        slot = base + ledPanelIndex(p, u, v);
+      }
+    }
+  }
+
+  // Gaps left by a bad map point at LED 0 rather than past the buffer
+  for (uint16_t i = 0; i < NUM_LEDS; i++) {
+    if (ledXYMap[i] == 0xFFFF) ledXYMap[i] = 0;
+  }
+  return ok;
+}
+
+// One FastLED controller per output pin (pins must be compile-time constants)
+template<uint8_t I>
+void addLedOutputs(CRGB* leds) {
+  if constexpr (I < LED_OUTPUT_COUNT) {
+    FastLED.addLeds<WS2812B, ledOutputPins[I], LED_COLOR_ORDER>(leds + ledOutputStart[I],
+                                                                ledOutputLen[I]);
+    addLedOutputs<I + 1>(leds);
+  }
+}
+
+void initLedOutputs(CRGB* leds) {
+  if (!buildLedMap()) {
+    DBGLN("LED_PANEL_MAP: panels overlap or leave the canvas");
+  }
+  addLedOutputs<0>(leds);
+  canvasAttach(MATRIX_WIDTH, MATRIX_HEIGHT, ledXYMap);
+
+  DBG("LED outputs: ");
+  DBG(LED_OUTPUT_COUNT);
+  DBG(", canvas ");
+  DBG(MATRIX_WIDTH);
+  DBG("x");
+  DBGLN(MATRIX_HEIGHT);
+}
+
+// Frame time of the slowest output — the parallel refresh ceiling
+uint32_t ledFrameTimeUs() {
+  uint16_t longest = 0;
+  for (uint8_t o = 0; o < LED_OUTPUT_COUNT; o++) longest = max(longest, ledOutputLen[o]);
+  return (uint32_t)longest * LED_US_PER_LED + LED_RESET_US;
+}
+
+#endif // LED_OUTPUT_H
@@ -0,0 +1,163 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <FastLED.h>
+#include "config.h"
+#include "led_output.h"
+#if defined(POWER_SAVE_ENABLED)
+  #include "esp_sleep.h"
+  #include "driver/gpio.h"
+#endif
+
+// ============================================================================
+// Power — frame skipping, current estimate, light sleep between frames
+// ============================================================================
+// showDisplay() only pushes a frame when leds[] or brightness changed since
+// the last push; WS2812s latch their colour, so a static emoji costs no wire
+// time or RMT wakeups at all. The LCD grid uses the same verdict, then
+// redraws only the cells that changed (display_lcd.h).
+//
+// The current estimate uses FastLED's power model (16/11/15 mA per channel at
+// full, 1 mA per dark LED), scaled by brightness and clamped to
+// MAX_LED_POWER_MA like FastLED's limiter, plus an MCU figure per state.
+// It is integrated over 1 s windows for the average reported in /state.
+//
+// On battery (WiFi off) the idle time between frames is spent in light
+// sleep. With IMU_WAKE_PIN the QMI8658's wake-on-motion line ends a sleep
+// early, so low-power modes sleep a whole frame instead of waking every
+// POWER_IMU_POLL_MS to look for a shake.
+// ============================================================================
+
+#define POWER_LED_R_MA        16    // Per LED, channel at 255
+#define POWER_LED_G_MA        11
+#define POWER_LED_B_MA        15
+#define POWER_LED_DARK_MA     1     // Quiescent draw of each WS2812B
+#define POWER_MCU_ACTIVE_MA   40    // S3 at 240 MHz, radio off
+#define POWER_MCU_WIFI_MA     110   // SoftAP up
+#define POWER_MCU_SLEEP_MA    2     // Light sleep incl. IMU and regulator
+#define POWER_SLEEP_MIN_MS    4     // Shorter gaps are cheaper as delay()
+#define POWER_IMU_POLL_MS     30    // Shake polling without a wake line
+#define POWER_WINDOW_MS       1000
+
+struct PowerStats {
+  uint32_t frames;          // showDisplay() calls
+  uint32_t skipped;         // ...that didn't touch the wire
+  uint16_t ledMa;           // Estimate for the frame on the LEDs now
+  uint16_t avgMa;           // Board average over the last window
+  uint8_t  sleepPct;        // Share of the last window in light sleep
+  uint8_t  skipPct;         // Share of the last window's frames skipped
+};
+
+PowerStats powerStats = {0, 0, 0, 0, 0, 0};
+
+static CRGB powerLastFrame[NUM_LEDS];
+static uint8_t powerLastBrightness = 0;
+static bool powerHaveFrame = false;
+static uint32_t powerLastShowUs = 0;
+
+// Window accumulators (mA·ms)
+static uint32_t powerWindowStart = 0;
+static uint32_t powerWindowMaMs = 0;
+static uint32_t powerWindowSleepMs = 0;
+static uint32_t powerWindowFrames = 0;
+static uint32_t powerWindowSkipped = 0;
+static uint32_t powerLastAccount = 0;
+
+uint16_t powerEstimateLedMa(const CRGB* px, uint16_t count, uint8_t bright) {
+  uint32_t r = 0, g = 0, b = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    r += px[i].r;
+    g += px[i].g;
+    b += px[i].b;
+  }
+  uint32_t lit = (r * POWER_LED_R_MA + g * POWER_LED_G_MA + b * POWER_LED_B_MA) / 255;
+  lit = lit * bright / 255;
+  #if defined(MAX_LED_POWER_MA)
+    if (lit > MAX_LED_POWER_MA) lit = MAX_LED_POWER_MA;
+  #endif
+  return lit + (uint32_t)count * POWER_LED_DARK_MA;
+}
+
+// Charge the time since the last call to the current state
+static void powerAccount(uint32_t now, uint32_t sleptMs, bool wifiOn) {
+  uint32_t dt = now - powerLastAccount;
+  powerLastAccount = now;
+  uint32_t awake = dt > sleptMs ? dt - sleptMs : 0;
+  uint16_t mcu = wifiOn ? POWER_MCU_WIFI_MA : POWER_MCU_ACTIVE_MA;
+  powerWindowMaMs += powerStats.ledMa * dt + mcu * awake + POWER_MCU_SLEEP_MA * sleptMs;
+  powerWindowSleepMs += sleptMs;
+
+  uint32_t span = now - powerWindowStart;
+  if (span >= POWER_WINDOW_MS) {
+    powerStats.avgMa = powerWindowMaMs / span;
+    powerStats.sleepPct = min<uint32_t>(100, powerWindowSleepMs * 100 / span);
+    powerStats.skipPct = powerWindowFrames ? powerWindowSkipped * 100 / powerWindowFrames : 0;
+    powerWindowStart = now;
+    powerWindowMaMs = 0;
+    powerWindowSleepMs = 0;
+    powerWindowFrames = 0;
+    powerWindowSkipped = 0;
+  }
+}
+
+// True if the frame differs from the one on the wire; remembers it if so
+bool powerFrameChanged(const CRGB* px, uint8_t bright) {
+  powerStats.frames++;
+  powerWindowFrames++;
+  if (powerHaveFrame && bright == powerLastBrightness &&
+      memcmp(px, powerLastFrame, sizeof(powerLastFrame)) == 0) {
+    powerStats.skipped++;
+    powerWindowSkipped++;
+    return false;
+  }
+  memcpy(powerLastFrame, px, sizeof(powerLastFrame));
+  powerLastBrightness = bright;
+  powerHaveFrame = true;
+  powerStats.ledMa = powerEstimateLedMa(px, NUM_LEDS, bright);
+  return true;
+}
+
+// Call right after FastLED.show() so sleep never cuts a transfer short
+void powerNoteShow() {
+  powerLastShowUs = micros();
+}
+
+#if defined(POWER_SAVE_ENABLED)
+void initPowerWake() {
+  #if defined(IMU_WAKE_PIN)
+    pinMode(IMU_WAKE_PIN, INPUT);
+    esp_sleep_enable_gpio_wakeup();
+  #endif
+}
+
+// Idle for up to ms. Light-sleeps when allowed, otherwise delay(). With
+// IMU_WAKE_PIN the sleep ends early on motion — the QMI8658 toggles the
+// line on each wake-on-motion event, so arm for the opposite level.
+void powerSleep(uint32_t ms, bool allowSleep, bool wifiOn) {
+  uint32_t slept = 0;
+  if (allowSleep && ms >= POWER_SLEEP_MIN_MS) {
+    uint32_t wire = ledFrameTimeUs();
+    uint32_t since = micros() - powerLastShowUs;
+    if (since < wire) delayMicroseconds(wire - since);
+
+    #if defined(IMU_WAKE_PIN)
+      gpio_wakeup_enable((gpio_num_t)IMU_WAKE_PIN,
+                         digitalRead(IMU_WAKE_PIN) ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+    #endif
+    uint32_t start = millis();
+    esp_sleep_enable_timer_wakeup((uint64_t)ms * 1000);
+    esp_light_sleep_start();
+    slept = millis() - start;
+  } else {
+    delay(ms);
+  }
+  powerAccount(millis(), slept, wifiOn);
+}
+#endif
+
+// Refresh the window stats when no sleep has run (full-power builds)
+void powerTick(bool wifiOn) {
+  powerAccount(millis(), 0, wifiOn);
+}
+
+#endif // POWER_H
@@ -0,0 +1,197 @@
+// Effects on a runtime canvas (vizfx_canvas.h): every ambient and motion
+// effect at several sizes through a scrambled XY table, the 8x8 patterns
+// scaling up unchanged, and an oversize canvas refused.
+
+#include "host_test.h"
+#include "config.h"
+
+// Room for the largest canvas below
+#define CANVAS_MAX_WIDTH 64
+#define CANVAS_MAX_LEDS  (64 * 32)
+
+#include <vizfx.h>
+#include "host_clock.h"
+#include <random>
+
+CRGB leds[CANVAS_MAX_LEDS];
+CRGBPalette16 currentPalette = RainbowColors_p;
+float accelX = 0, accelY = 0, accelZ = 1;
+float gyroX = 0, gyroY = 0, gyroZ = 0;
+
+struct Size { uint8_t w, h; };
+static const Size kSizes[] = { {8, 8}, {32, 8}, {8, 32}, {16, 16}, {24, 16}, {64, 32} };
+
+static const CRGB kCanary(1, 2, 3);
+
+static std::vector<uint16_t> scrambledMap(int size, uint32_t seed) {
+  std::vector<uint16_t> map(size);
+  for (int i = 0; i < size; i++) map[i] = i;
+  std::shuffle(map.begin(), map.end(), std::mt19937(seed));
+  return map;
+}
+
+static void runEffect(bool motion, int e) {
+  if (motion) runMotionEffect(e);
+  else runAmbientEffect(e);
+}
+
+static const char* effectName(bool motion, int e) {
+  return motion ? motionEffects[e].name : ambientEffects[e].name;
+}
+
+// IMU input for frame f: a slow tilt circling the centre, gyro to match,
+// and a hard shake every 60 frames
+static void imuFrame(int f) {
+  accelX = 0.4f * sin(f * 0.07f);
+  accelY = 0.4f * cos(f * 0.05f);
+  accelZ = (f % 60 < 3) ? 2.5f : 1.0f;
+  gyroX = 40 * sin(f * 0.03f);
+  gyroY = 0;
+  gyroZ = 60 * cos(f * 0.02f);
+}
+
+static bool lit(const CRGB& c) { return c.r | c.g | c.b; }
+
+// Every effect at every size: nothing written outside the canvas (the tail
+// of leds[] keeps its canary; make asan covers the rest), and over a run the
+// effect lights all four quadrants rather than an 8x8 corner
+TEST(every_effect_any_size) {
+  int bad = 0;
+  for (const Size& s : kSizes) {
+    std::vector<uint16_t> map = scrambledMap(s.w * s.h, s.w * 256 + s.h);
+    CHECK(canvasAttach(s.w, s.h, map.data()));
+    CHECK_EQ(canvas.size, s.w * s.h);
+    CHECK_EQ(canvas.span, min(s.w, s.h));
+
+    for (int pass = 0; pass < 2; pass++) {
+      const bool motion = pass == 1;
+      const int count = motion ? NUM_MOTION_EFFECTS : NUM_AMBIENT_EFFECTS;
+      for (int e = 0; e < count; e++) {
+        fill_solid(leds, CANVAS_MAX_LEDS, kCanary);
+        fill_solid(leds, canvas.size, CRGB::Black);
+        bool quadrant[4] = {};
+        for (int f = 0; f < 300; f++) {
+          imuFrame(f);
+          runEffect(motion, e);
+          hostAdvanceMs(20);
+          for (int y = 0; y < s.h; y++) {
+            for (int x = 0; x < s.w; x++) {
+              if (lit(leds[XY(x, y)])) quadrant[(y >= s.h / 2) * 2 + (x >= s.w / 2)] = true;
+            }
+          }
+        }
+        int spilled = 0;
+        for (int i = canvas.size; i < CANVAS_MAX_LEDS; i++) spilled += leds[i] != kCanary;
+        bool covered = quadrant[0] && quadrant[1] && quadrant[2] && quadrant[3];
+        if (spilled || !covered) {
+          fprintf(stderr, "  %dx%d %s: %d LEDs written past the canvas, quadrants %d%d%d%d\n",
+                  s.w, s.h, effectName(motion, e), spilled, quadrant[0], quadrant[1],
+                  quadrant[2], quadrant[3]);
+          bad++;
+        }
+      }
+    }
+  }
+  CHECK_EQ(bad, 0);
+}
+
+// Render `frames` frames of an effect from a fresh start (a child process,
+// so its statics begin at zero) on a row-major w x h canvas
+static std::vector<CRGB> freshFrame(bool motion, int e, uint8_t w, uint8_t h, int frames) {
+  std::vector<CRGB> out(w * h);
+  int fd[2];
+  if (pipe(fd) != 0) return out;
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fd[0]);
+    canvasAttach(w, h, nullptr);
+    fill_solid(leds, CANVAS_MAX_LEDS, CRGB::Black);
+    for (int f = 0; f < frames; f++) runEffect(motion, e);
+    ssize_t n = write(fd[1], leds, out.size() * sizeof(CRGB));
+    _exit(n == (ssize_t)(out.size() * sizeof(CRGB)) ? 0 : 1);
+  }
+  close(fd[1]);
+  size_t got = 0;
+  while (got < out.size() * sizeof(CRGB)) {
+    ssize_t n = read(fd[0], (uint8_t*)out.data() + got, out.size() * sizeof(CRGB) - got);
+    if (n <= 0) break;
+    got += n;
+  }
+  close(fd[0]);
+  waitpid(pid, nullptr, 0);
+  CHECK_EQ(got, out.size() * sizeof(CRGB));
+  return out;
+}
+
+// Patterns are tuned on the 8x8 and scaled by span: a 16x16 sampled at
+// every other pixel is the 8x8 frame, and a sprite on a 32x8 is the 8x8
+// sprite centred
+TEST(scaled_patterns_match_8x8) {
+  static const char* const kScaled[] = { "Plasma", "Rainbow", "Ocean", "Lava", "Aurora",
+                                         "Heart", "Donut" };
+  int checked = 0;
+  for (int e = 0; e < NUM_AMBIENT_EFFECTS; e++) {
+    bool sprite = !strcmp(ambientEffects[e].name, "Heart") || !strcmp(ambientEffects[e].name, "Donut");
+    bool scaled = false;
+    for (const char* name : kScaled) scaled |= !strcmp(ambientEffects[e].name, name);
+    if (!scaled) continue;
+    checked++;
+
+    std::vector<CRGB> small = freshFrame(false, e, 8, 8, 5);
+    std::vector<CRGB> big = freshFrame(false, e, 16, 16, 5);
+    int wrong = 0;
+    for (int y = 0; y < 16; y++) {
+      for (int x = 0; x < 16; x++) {
+        if ((sprite || (x % 2 == 0 && y % 2 == 0)) && big[y * 16 + x] != small[(y / 2) * 8 + x / 2]) {
+          wrong++;
+        }
+      }
+    }
+    if (sprite) {
+      std::vector<CRGB> wide = freshFrame(false, e, 32, 8, 5);
+      for (int y = 0; y < 8; y++) {
+        for (int x = 12; x < 20; x++) wrong += wide[y * 32 + x] != small[y * 8 + x - 12];
+      }
+    }
+    if (wrong) fprintf(stderr, "  %s: %d pixels differ from the 8x8\n", ambientEffects[e].name, wrong);
+    CHECK_EQ(wrong, 0);
+  }
+  CHECK_EQ(checked, VIZFX_COUNT(kScaled));
+}
+
+// A canvas too wide or too large for the state buffers is refused and the
+// attached one stays
+TEST(oversize_refused) {
+  CHECK(canvasAttach(16, 16, nullptr));
+  CHECK(!canvasAttach(CANVAS_MAX_WIDTH + 1, 1, nullptr));
+  CHECK(!canvasAttach(64, 33, nullptr));
+  CHECK(!canvasAttach(0, 8, nullptr));
+  CHECK(!canvasAttach(8, 0, nullptr));
+  CHECK_EQ(canvas.width, 16);
+  CHECK_EQ(canvas.height, 16);
+  CHECK_EQ(canvas.size, 256);
+  CHECK(canvas.xyMap == nullptr);
+  CHECK_EQ(XY(3, 2), 2 * 16 + 3);
+}
+
+// Per-frame cost at each size (figures only): it should grow with the pixel
+// count, not faster
+TEST(frame_cost) {
+  for (const Size& s : kSizes) {
+    std::vector<uint16_t> map = scrambledMap(s.w * s.h, 7);
+    canvasAttach(s.w, s.h, map.data());
+    const int frames = max(20, 20000 / canvas.size);
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int e = 0; e < NUM_AMBIENT_EFFECTS; e++) {
+      for (int f = 0; f < frames; f++) runAmbientEffect(e);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double us = ((t1.tv_sec - t0.tv_sec) * 1e6 + (t1.tv_nsec - t0.tv_nsec) / 1e3) /
+                (frames * NUM_AMBIENT_EFFECTS);
+    REPORT("%2dx%-2d  %4d LEDs  %7.1f us/frame (ambient mean)  %.3f us/LED", s.w, s.h,
+           canvas.size, us, us / canvas.size);
+  }
+}
+
+HOST_TEST_MAIN
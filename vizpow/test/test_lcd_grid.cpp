@@ -0,0 +1,165 @@
+// LCD grid (display_lcd.h): frames through showDisplay()'s diff, checked
+// against the screen a full redraw would give — held frames, emoji
+// switches, brightness, and the menu, hi-res effects and clears that draw
+// over the grid. Built for the LCD board.
+
+#include "host_test.h"
+#include "config.h"
+#include "power.h"
+#include "display_lcd.h"
+#include <vizfx.h>
+#include "effects_emoji.h"
+#include "host_clock.h"
+
+CRGB leds[NUM_LEDS];
+CRGBPalette16 currentPalette = RainbowColors_p;
+float accelX = 0, accelY = 0, accelZ = 1;
+float gyroX = 0, gyroY = 0, gyroZ = 0;
+uint8_t brightness = DEFAULT_BRIGHTNESS;
+uint8_t currentMode = MODE_EMOJI;
+bool menuVisible = false;
+
+// vizpow.ino's showDisplay() on an LCD-only build
+static void showDisplay() {
+  bool changed = powerFrameChanged(leds, FastLED.getBrightness());
+  renderToLCD(changed);
+}
+
+static void boot() {
+  canvasAttach(MATRIX_WIDTH, MATRIX_HEIGHT, nullptr);
+  initLCD();
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
+}
+
+static uint16_t expectedCell(uint8_t x, uint8_t y) {
+  CRGB c = leds[XY(x, y)];
+  c.nscale8_video(brightness);
+  return crgbToRgb565(c);
+}
+
+// Grid cells on screen that don't show what a full redraw would
+static int wrongCells() {
+  int wrong = 0;
+  for (uint8_t y = 0; y < MATRIX_HEIGHT; y++) {
+    for (uint8_t x = 0; x < MATRIX_WIDTH; x++) {
+      const uint16_t want = expectedCell(x, y);
+      const int16_t sx = GRID_OFFSET_X + x * (PIXEL_SIZE + PIXEL_GAP);
+      const int16_t sy = GRID_OFFSET_Y + y * (PIXEL_SIZE + PIXEL_GAP);
+      bool ok = true;
+      for (int16_t py = sy; py < sy + PIXEL_SIZE; py++) {
+        for (int16_t px = sx; px < sx + PIXEL_SIZE; px++) ok &= gfx->pixel(px, py) == want;
+      }
+      wrong += !ok;
+    }
+  }
+  return wrong;
+}
+
+// A held emoji is pushed once; the frames after it touch nothing
+TEST(held_frame_pushes_once) {
+  boot();
+  addEmojiByIndex(0);
+  emojiAutoCycle = false;
+  const uint32_t rects0 = gfx->fillRects;
+  for (int f = 0; f < 300; f++) {
+    runEmojiEffect();
+    showDisplay();
+    hostAdvanceMs(100);
+  }
+  CHECK_EQ(gfx->fillRects - rects0, NUM_LEDS);
+  CHECK_EQ(lcdCellsPushed, NUM_LEDS);
+  CHECK_EQ(lcdFramesSkipped, 299);
+  CHECK_EQ(wrongCells(), 0);
+}
+
+// Switching emoji pushes exactly the cells whose colour differs
+TEST(switch_pushes_changed_cells) {
+  boot();
+  addEmojiByIndex(0);
+  addEmojiByIndex(1);
+  emojiAutoCycle = false;
+  runEmojiEffect();
+  showDisplay();
+
+  std::vector<uint16_t> before(NUM_LEDS);
+  for (int i = 0; i < NUM_LEDS; i++) before[i] = expectedCell(i % MATRIX_WIDTH, i / MATRIX_WIDTH);
+  currentEmojiIndex = 1;
+  runEmojiEffect();
+  int differ = 0;
+  for (int i = 0; i < NUM_LEDS; i++) differ += before[i] != expectedCell(i % MATRIX_WIDTH, i / MATRIX_WIDTH);
+  const uint32_t rects0 = gfx->fillRects;
+  showDisplay();
+  CHECK(differ > 0);
+  CHECK_EQ(gfx->fillRects - rects0, differ);
+  CHECK_EQ(wrongCells(), 0);
+
+  // Brightness alone repaints the lit cells, not the dark ones
+  brightness = 120;
+  FastLED.setBrightness(120);
+  int lit = 0;
+  for (int i = 0; i < NUM_LEDS; i++) lit += leds[i] != CRGB(CRGB::Black);
+  const uint32_t rects1 = gfx->fillRects;
+  showDisplay();
+  CHECK_EQ(gfx->fillRects - rects1, lit);
+  CHECK_EQ(wrongCells(), 0);
+}
+
+// Random edits with everything that draws over the grid mixed in: after
+// every grid frame the screen matches a full redraw
+TEST(random_frames_match_full_redraw) {
+  boot();
+  std::mt19937 rng(9);
+  int gridFrames = 0, bad = 0;
+  for (int f = 0; f < 3000; f++) {
+    int r = rng() % 100;
+    if (r < 3) {
+      // Touch menu for a few frames; it paints the screen while open
+      menuVisible = true;
+      gfx->fillScreen(0xF81F);
+      for (int k = 0; k < 3; k++) showDisplay();
+      menuVisible = false;
+    } else if (r < 6) {
+      hiResMode = true;
+      runAmbientEffect(rng() % NUM_AMBIENT_EFFECTS);
+      showDisplay();
+      hiResMode = false;
+    } else if (r < 8) {
+      clearLCD();
+    } else if (r < 10) {
+      toggleHiResMode();
+      toggleHiResMode();
+    } else if (r < 15) {
+      brightness = rng();
+      FastLED.setBrightness(brightness);
+    }
+
+    for (int n = rng() % 4; n > 0; n--) {
+      leds[rng() % NUM_LEDS] = rng() % 3 ? CRGB(rng()) : CRGB(CRGB::Black);
+    }
+    showDisplay();
+    gridFrames++;
+    bad += wrongCells() != 0;
+  }
+  CHECK_EQ(bad, 0);
+  REPORT("%d grid frames: %u cells pushed (%d for full redraws), %u frames with nothing to push",
+         gridFrames, lcdCellsPushed, gridFrames * NUM_LEDS, lcdFramesSkipped);
+}
+
+// Cells pushed per frame for the animated effects (figures only)
+TEST(effect_push_counts) {
+  boot();
+  for (int e = 0; e < NUM_AMBIENT_EFFECTS; e++) {
+    const uint32_t cells0 = lcdCellsPushed;
+    const int frames = 250;
+    for (int f = 0; f < frames; f++) {
+      runAmbientEffect(e);
+      showDisplay();
+      hostAdvanceMs(40);
+    }
+    CHECK_EQ(wrongCells(), 0);
+    REPORT("%-8s %5.1f of %d cells per frame", ambientEffects[e].name,
+           (double)(lcdCellsPushed - cells0) / frames, NUM_LEDS);
+  }
+}
+
+HOST_TEST_MAIN
@@ -0,0 +1,149 @@
+// LED outputs (led_output.h): the panel map against an independent walk of
+// each panel's wiring, per-pin bitstreams, and the parallel frame time.
+// Built once per layout — config.h's two, plus two only a test needs.
+
+#include "host_test.h"
+
+#if defined(HOST_LAYOUT_MIXED)
+// Non-square panels in all four rotations, serpentine and not, on two pins
+#define CONFIG_H
+#define MATRIX_WIDTH  24
+#define MATRIX_HEIGHT 16
+#define NUM_LEDS (MATRIX_WIDTH * MATRIX_HEIGHT)
+#define LED_OUTPUT_PINS { 1, 2 }
+#define LED_PANEL_MAP { \
+  { 0,  0, 0, 8, 16, 1, true  }, \
+  { 0,  8, 0, 8, 16, 3, false }, \
+  { 1, 16, 0, 8,  8, 2, true  }, \
+  { 1, 16, 8, 8,  8, 0, false }, \
+}
+#define LED_COLOR_ORDER GRB
+#define DBG(...)
+#define DBGLN(...)
+#elif defined(HOST_LAYOUT_OVERLAP)
+// Right total area, but the second panel lands on the first
+#define CONFIG_H
+#define MATRIX_WIDTH  16
+#define MATRIX_HEIGHT 8
+#define NUM_LEDS (MATRIX_WIDTH * MATRIX_HEIGHT)
+#define LED_OUTPUT_PINS { 1, 2 }
+#define LED_PANEL_MAP { { 0, 0, 0, 8, 8, 0, true }, { 1, 4, 0, 8, 8, 0, true } }
+#define LED_COLOR_ORDER GRB
+#define DBG(...)
+#define DBGLN(...)
+#else
+#include "config.h"
+#endif
+
+#include "led_output.h"
+
+CRGB leds[NUM_LEDS];
+
+// Canvas pixel (cx, cy) that LED k of panel p's own chain lights: walk the
+// native rows (reversing odd ones when serpentine), then turn the panel
+// clockwise onto its footprint
+static void physicalPixel(const LedPanel& p, int k, int& cx, int& cy) {
+  int nativeW = (p.rotation & 1) ? p.h : p.w;
+  int nv = k / nativeW, nu = k % nativeW;
+  if (p.serpentine && (nv & 1)) nu = nativeW - 1 - nu;
+  int u, v;
+  switch (p.rotation & 3) {
+    case 1:  u = p.w - 1 - nv; v = nu;             break;
+    case 2:  u = p.w - 1 - nu; v = p.h - 1 - nv;   break;
+    case 3:  u = nv;           v = p.h - 1 - nu;   break;
+    default: u = nu;           v = nv;             break;
+  }
+  cx = p.x + u;
+  cy = p.y + v;
+}
+
+static CRGB pixelColour(int x, int y) {
+  return CRGB((uint8_t)x, (uint8_t)y, (uint8_t)(x ^ y ^ 0x5A));
+}
+
+// The 24-bit words a controller clocks out, MSB first in its colour order
+static std::vector<uint32_t> wireWords(const HostLedController& c) {
+  std::vector<uint32_t> words;
+  for (int i = 0; i < c.count; i++) {
+    const uint8_t rgb[3] = {c.leds[i].r, c.leds[i].g, c.leds[i].b};
+    uint32_t w = 0;
+    for (int shift = 6; shift >= 0; shift -= 3) w = (w << 8) | rgb[(c.order >> shift) & 3];
+    words.push_back(w);
+  }
+  return words;
+}
+
+static uint32_t wordFor(CRGB px, EOrder order) {
+  const HostLedController one = {0, order, &px, 1};
+  return wireWords(one)[0];
+}
+
+#if !defined(HOST_LAYOUT_OVERLAP)
+
+TEST(every_slot_once) {
+  CHECK(buildLedMap());
+  std::vector<int> hits(NUM_LEDS);
+  for (int i = 0; i < NUM_LEDS; i++) {
+    CHECK(ledXYMap[i] < NUM_LEDS);
+    if (ledXYMap[i] < NUM_LEDS) hits[ledXYMap[i]]++;
+  }
+  int bad = 0;
+  for (int h : hits) bad += h != 1;
+  CHECK_EQ(bad, 0);
+}
+
+// Paint a unique colour on every canvas pixel through XY(); each pin's
+// stream must light its panels in chain order, along their own wiring
+TEST(wire_order_matches_panels) {
+  initLedOutputs(leds);
+  CHECK_EQ(canvas.width, MATRIX_WIDTH);
+  CHECK_EQ(canvas.height, MATRIX_HEIGHT);
+  CHECK_EQ(FastLED.controllers.size(), LED_OUTPUT_COUNT);
+  for (int y = 0; y < MATRIX_HEIGHT; y++) {
+    for (int x = 0; x < MATRIX_WIDTH; x++) leds[XY(x, y)] = pixelColour(x, y);
+  }
+
+  int wrong = 0;
+  for (size_t o = 0; o < FastLED.controllers.size(); o++) {
+    const HostLedController& c = FastLED.controllers[o];
+    CHECK_EQ(c.pin, ledOutputPins[o]);
+    CHECK_EQ(c.order, LED_COLOR_ORDER);
+    std::vector<uint32_t> words = wireWords(c);
+    size_t pos = 0;
+    for (const LedPanel& p : ledPanels) {
+      if (p.output != o) continue;
+      for (int k = 0; k < p.w * p.h; k++, pos++) {
+        int cx, cy;
+        physicalPixel(p, k, cx, cy);
+        if (pos >= words.size() || words[pos] != wordFor(pixelColour(cx, cy), c.order)) wrong++;
+      }
+    }
+    CHECK_EQ(pos, (size_t)c.count);
+  }
+  CHECK_EQ(wrong, 0);
+}
+
+// A frame costs the longest chain, not the sum of them
+TEST(parallel_frame_time) {
+  initLedOutputs(leds);
+  int longest = 0;
+  for (const HostLedController& c : FastLED.controllers) longest = std::max(longest, c.count);
+  uint32_t frameUs = ledFrameTimeUs();
+  CHECK_EQ(frameUs, (uint32_t)longest * LED_US_PER_LED + LED_RESET_US);
+  uint32_t onePinUs = NUM_LEDS * LED_US_PER_LED + LED_RESET_US;
+  REPORT("%dx%d on %u pin(s): longest chain %d, %.1f ms = %.0f FPS (one pin: %.0f FPS)",
+         MATRIX_WIDTH, MATRIX_HEIGHT, (unsigned)LED_OUTPUT_COUNT, longest, frameUs / 1000.0,
+         1e6 / frameUs, 1e6 / onePinUs);
+}
+
+#else
+
+// A bad map is reported, and XY() still stays inside leds[]
+TEST(overlap_reported) {
+  CHECK(!buildLedMap());
+  for (int i = 0; i < NUM_LEDS; i++) CHECK(ledXYMap[i] < NUM_LEDS);
+}
+
+#endif
+
+HOST_TEST_MAIN
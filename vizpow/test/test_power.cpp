@@ -0,0 +1,146 @@
+// Power (power.h): skipping unchanged frames, the LED current estimate,
+// light sleep waiting for the wire, and the 1 s window stats — driven by the
+// same frame loop vizpow.ino runs on battery.
+
+#include "host_test.h"
+#include "config.h"
+#include "power.h"
+#include <vizfx.h>
+#include "host_clock.h"
+
+CRGB leds[NUM_LEDS];
+CRGBPalette16 currentPalette = RainbowColors_p;
+float accelX = 0, accelY = 0, accelZ = 1;
+float gyroX = 0, gyroY = 0, gyroZ = 0;
+
+// ---- esp_sleep: a light sleep lasts until the armed timer ----
+
+static uint64_t sleepTimerUs = 0;
+static int sleeps = 0;
+static int64_t sleepAfterShowUs = -1;   // Since the last frame finished clocking out; < 0 = cut short
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t timeUs) {
+  sleepTimerUs = timeUs;
+  return ESP_OK;
+}
+esp_err_t esp_sleep_enable_gpio_wakeup() { return ESP_OK; }
+esp_err_t gpio_wakeup_enable(gpio_num_t, gpio_int_type_t) { return ESP_OK; }
+
+esp_err_t esp_light_sleep_start() {
+  sleeps++;
+  sleepAfterShowUs = (int64_t)(micros() - powerLastShowUs) - ledFrameTimeUs();
+  hostAdvanceUs(sleepTimerUs);
+  return ESP_OK;
+}
+
+// One pass of vizpow.ino's loop() after the effect has drawn: show if
+// changed, then idle frameDelay ms in POWER_IMU_POLL_MS chunks
+static const int kRenderUs = 800, kPollUs = 350;
+
+static void frame(int frameDelay, bool wifiOn) {
+  hostAdvanceUs(kRenderUs);
+  if (powerFrameChanged(leds, FastLED.getBrightness())) {
+    FastLED.show();
+    powerNoteShow();
+  }
+  while (frameDelay > POWER_IMU_POLL_MS) {
+    unsigned long before = millis();
+    powerSleep(POWER_IMU_POLL_MS, !wifiOn, wifiOn);
+    frameDelay -= max((int)(millis() - before), 1);
+    hostAdvanceUs(kPollUs);   // readIMU() + checkModeShake()
+  }
+  if (frameDelay > 0) powerSleep(frameDelay, !wifiOn, wifiOn);
+}
+
+TEST(skips_unchanged_frames) {
+  initLedOutputs(leds);
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
+  CHECK(powerFrameChanged(leds, 250));    // Nothing on the wire yet
+  CHECK(!powerFrameChanged(leds, 250));
+  CHECK(powerFrameChanged(leds, 100));    // Brightness alone counts
+  leds[NUM_LEDS - 1] = CRGB(0, 0, 1);
+  CHECK(powerFrameChanged(leds, 100));
+  CHECK(!powerFrameChanged(leds, 100));
+  CHECK_EQ(powerStats.frames, 5);
+  CHECK_EQ(powerStats.skipped, 2);
+}
+
+TEST(led_current_estimate) {
+  const int dark = NUM_LEDS * POWER_LED_DARK_MA;
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
+  CHECK_EQ(powerEstimateLedMa(leds, NUM_LEDS, 255), dark);
+  leds[0] = CRGB::White;
+  CHECK_EQ(powerEstimateLedMa(leds, NUM_LEDS, 255),
+           dark + POWER_LED_R_MA + POWER_LED_G_MA + POWER_LED_B_MA);
+  leds[0] = CRGB(255, 0, 0);
+  CHECK_EQ(powerEstimateLedMa(leds, NUM_LEDS, 128), dark + POWER_LED_R_MA * 128 / 255);
+  fill_solid(leds, NUM_LEDS, CRGB::White);   // ~2.6 A unlimited
+  CHECK_EQ(powerEstimateLedMa(leds, NUM_LEDS, 250), dark + MAX_LED_POWER_MA);
+  CHECK(powerFrameChanged(leds, 250));
+  CHECK_EQ(powerStats.ledMa, dark + MAX_LED_POWER_MA);
+}
+
+// Sleep never starts while the last frame is still clocking out; short gaps
+// and WiFi-on idles are plain delays
+TEST(sleep_waits_for_wire) {
+  initLedOutputs(leds);
+  leds[0] = CRGB::Red;
+  CHECK(powerFrameChanged(leds, 250));
+  powerNoteShow();
+  unsigned long t0 = millis();
+  powerSleep(20, true, false);
+  CHECK_EQ(sleeps, 1);
+  CHECK(sleepAfterShowUs >= 0);
+  CHECK_EQ(sleepTimerUs, 20000);
+  CHECK(millis() - t0 >= 20);
+
+  powerSleep(POWER_SLEEP_MIN_MS - 1, true, false);
+  powerSleep(20, false, true);
+  CHECK_EQ(sleeps, 1);
+}
+
+// A static frame on battery: nearly every frame skipped, nearly all the
+// time asleep, and the average is the LEDs plus a little MCU. With WiFi up
+// the MCU never sleeps.
+TEST(window_stats) {
+  initLedOutputs(leds);
+  fill_solid(leds, NUM_LEDS, CRGB(40, 0, 20));
+  for (int f = 0; f < 30; f++) frame(FRAME_DELAY_EMOJI_STATIC, false);
+  const int ledMa = powerStats.ledMa;
+  CHECK(powerStats.skipPct >= 90);
+  CHECK(powerStats.sleepPct >= 90);
+  CHECK(powerStats.avgMa >= ledMa + POWER_MCU_SLEEP_MA);
+  CHECK(powerStats.avgMa < ledMa + POWER_MCU_ACTIVE_MA / 4);
+
+  for (int f = 0; f < 30; f++) frame(FRAME_DELAY_EMOJI_STATIC, true);
+  CHECK_EQ(powerStats.sleepPct, 0);
+  CHECK_NEAR(powerStats.avgMa, ledMa + POWER_MCU_WIFI_MA, 1);
+}
+
+// A minute each of a static emoji, an ambient effect and a dark panel, on
+// battery and with WiFi up (figures only)
+TEST(duty_cycle) {
+  initLedOutputs(leds);
+  struct Mode { const char* name; int frameMs; };
+  const Mode modes[] = { {"emoji", FRAME_DELAY_EMOJI_STATIC},
+                         {"ambient", FRAME_DELAY_AMBIENT_MIN},
+                         {"dark", FRAME_DELAY_EMOJI_STATIC} };
+  for (int wifi = 0; wifi < 2; wifi++) {
+    for (const Mode& m : modes) {
+      fill_solid(leds, NUM_LEDS, CRGB::Black);
+      uint32_t frames0 = powerStats.frames, skipped0 = powerStats.skipped;
+      unsigned long end = millis() + 60000;
+      while (millis() < end) {
+        if (m.name[0] == 'e') fill_solid(leds, NUM_LEDS, CRGB(120, 90, 0));
+        if (m.name[0] == 'a') runAmbientEffect(0);
+        frame(m.frameMs, wifi);
+      }
+      uint32_t frames = powerStats.frames - frames0;
+      REPORT("%-7s %-7s avg %3u mA (LEDs %3u)  skip %3.0f%%  sleep %3u%%", m.name,
+             wifi ? "WiFi" : "battery", powerStats.avgMa, powerStats.ledMa,
+             100.0 * (powerStats.skipped - skipped0) / frames, powerStats.sleepPct);
+    }
+  }
+}
+
+HOST_TEST_MAIN
@@ -84,19 +84,9 @@ extern uint8_t speed;
 // Mode names
 const char* modeNames[] = {"Motion", "Ambient", "Emoji"};
 
-// Effect names (abbreviated)
-const char* motionEffectNames[] = {
-  "TiltBall", "Plasma", "Sparkle", "TiltWave", "SpinTrail",
-  "Gravity", "Noise", "Ripple", "GyroSwirl", "Explode", "TiltFire", "Rainbow"
-};
-
-const char* ambientEffectNames[] = {
-  "Plasma", "Rainbow", "Fire", "Ocean", "Sparkle",
-  "Matrix", "Lava", "Aurora", "Confetti", "Comet",
-  "Galaxy", "Heart", "Donut"
-};
+// Effect names come from the vizfx registry (motionEffects[].name, ambientEffects[].name)
 
-// Palette names (must match order in palettes.h)
+// Palette names (must match order in vizfx_palettes.h)
 const char* paletteNames[] = {
   "Rainbow", "Ocean", "Lava", "Forest", "Party",
   "Heat", "Cloud", "Sunset", "Cyber", "Toxic",
@@ -220,9 +210,9 @@ void drawMenuHeader() {
   gfx->setCursor(10, 24);
   gfx->setTextColor(0xFFFF);
   if (currentMode == MODE_MOTION) {
-    gfx->print(motionEffectNames[effectIndex % NUM_MOTION_EFFECTS]);
+    gfx->print(motionEffects[effectIndex % NUM_MOTION_EFFECTS].name);
   } else if (currentMode == MODE_AMBIENT) {
-    gfx->print(ambientEffectNames[effectIndex % NUM_AMBIENT_EFFECTS]);
+    gfx->print(ambientEffects[effectIndex % NUM_AMBIENT_EFFECTS].name);
   } else {
     gfx->print("Emoji");
   }
@@ -320,6 +310,7 @@ void hideMenu() {
 
   // Clear entire screen - LED display will redraw on next frame
   gfx->fillScreen(0x0000);
+  invalidateLCDGrid();
 
   menuVisible = false;
   menuPage = 0;  // Reset to main page for next open
@@ -29,11 +29,11 @@
 #if defined(AUTO_WIFI_USB_DETECT)
   #include "hal/usb_serial_jtag_ll.h"
 #endif
-#include "palettes.h"
-#include "effects_motion.h"
-#include "effects_ambient.h"
+#include "led_output.h"
+#include "power.h"
+#include "display_lcd.h"    // Before vizfx.h: completes GfxDevice for the hi-res effects
+#include <vizfx.h>          // Canvas, palettes, sprites, ambient + motion effects (lib/vizfx)
 #include "effects_emoji.h"
-#include "display_lcd.h"
 #include "web_server.h"
 #if defined(TOUCH_ENABLED)
 #include "touch_control.h"
@@ -126,11 +126,16 @@ uint8_t nextShuffledPalette() {
 
 // Helper function to show output on configured displays
 void showDisplay() {
+  // Identical frames stay latched in the LEDs and on the LCD — don't resend
+  bool changed = powerFrameChanged(leds, FastLED.getBrightness());
   #if defined(DISPLAY_LED_ONLY) || defined(DISPLAY_DUAL)
-    FastLED.show();
+    if (changed) {
+      FastLED.show();
+      powerNoteShow();
+    }
   #endif
   #if defined(DISPLAY_LCD_ONLY) || defined(DISPLAY_DUAL)
-    renderToLCD();
+    renderToLCD(changed);
   #endif
 }
 
@@ -183,7 +188,7 @@ void setup() {
   }
 
   // Initialize LEDs (always needed for the leds[] buffer)
-  FastLED.addLeds<WS2812B, DATA_PIN, RGB>(leds, NUM_LEDS);
+  initLedOutputs(leds);
   FastLED.setBrightness(brightness);
   #if defined(MAX_LED_POWER_MA)
     FastLED.setMaxPowerInVoltsAndMilliamps(5, MAX_LED_POWER_MA);
@@ -213,6 +218,9 @@ void setup() {
     );
     imu.enableAccelerometer();
     imu.enableGyroscope();
+    #if defined(POWER_SAVE_ENABLED)
+      initPowerWake();
+    #endif
     DBGLN("IMU initialized");
   } else {
     DBGLN("IMU initialization failed");
@@ -243,9 +251,22 @@ void updateIMUForMode() {
   if (target == currentIMUProfile) return;
 
   if (target == IMU_FULL) {
+    #if defined(IMU_WAKE_PIN)
+      // Leave wake-on-motion for the normal accelerometer setup
+      imu.configAccelerometer(
+        SensorQMI8658::ACC_RANGE_4G,
+        SensorQMI8658::ACC_ODR_250Hz,
+        SensorQMI8658::LPF_MODE_0
+      );
+      imu.enableAccelerometer();
+    #endif
     imu.enableGyroscope();
   } else {
     imu.disableGyroscope();
+    #if defined(IMU_WAKE_PIN)
+      imu.configWakeOnMotion(IMU_WAKE_THRESHOLD_MG, SensorQMI8658::ACC_ODR_LOWPOWER_128Hz,
+                             SensorQMI8658::INTERRUPT_PIN_2);
+    #endif
   }
   currentIMUProfile = target;
 }
@@ -394,16 +415,25 @@ void loop() {
         break;
     }
 
-    // Chunk long delays into 30ms segments so shake detection stays responsive
-    while (frameDelay > 30) {
-      delay(30);
-      frameDelay -= 30;
+    // On battery the gap is spent in light sleep (the SoftAP needs the radio
+    // awake). Without a wake line it is chunked so shakes are still seen
+    // within POWER_IMU_POLL_MS; with one, low-power modes sleep the whole gap.
+    bool canSleep = !wifiEnabled;
+    int chunk = POWER_IMU_POLL_MS;
+    #if defined(IMU_WAKE_PIN)
+      if (currentIMUProfile == IMU_LOW_POWER) chunk = frameDelay;
+    #endif
+    while (frameDelay > chunk) {
+      unsigned long before = millis();
+      powerSleep(chunk, canSleep, wifiEnabled);
+      frameDelay -= max((int)(millis() - before), 1);
       if (wifiEnabled) server.handleClient();
       readIMU();
       checkModeShake();
     }
-    delay(frameDelay);
+    if (frameDelay > 0) powerSleep(frameDelay, canSleep, wifiEnabled);
   #else
     delay(speed);
+    powerTick(wifiEnabled);
   #endif
 }
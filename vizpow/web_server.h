@@ -4,7 +4,9 @@
 #include <WebServer.h>
 #include <FastLED.h>
 #include "config.h"
-#include "palettes.h"
+#include <vizfx_palettes.h>
+#include "led_output.h"
+#include "power.h"
 
 // External references to globals
 extern WebServer server;
@@ -111,7 +113,10 @@ const char webpage[] PROGMEM = R"rawliteral(
       "ArrowLeft", "ArrowRight", "Skull", "Ghost", "Alien",
       "Pacman", "PacGhost", "ShyGuy", "Music",
       "WiFi", "Rainbow", "Mushroom", "Skelly",
-      "Chicken", "Invader", "Dragon", "TwinkleHeart", "Popsicle"];
+      "Chicken", "Invader", "Dragon", "TwinkleHeart", "Popsicle",
+      "Smiley", "Question", "Exclaim", "Sun", "Moon",
+      "Cloud", "Rain", "Lightning", "Snow", "Tree",
+      "Coin", "Key", "Gem"];
 
     function render() {
       const effects = state.currentMode === 0 ? motionEffects : ambientEffects;
@@ -265,7 +270,22 @@ void handleState() {
                 ",\"brightness\":" + String(brightness) +
                 ",\"speed\":" + String(speed) +
                 ",\"autoCycle\":" + (autoCycle ? "true" : "false") +
-                ",\"currentMode\":" + String(currentMode) + "}";
+                ",\"currentMode\":" + String(currentMode) +
+                ",\"width\":" + String(canvas.width) +
+                ",\"height\":" + String(canvas.height) +
+                ",\"outputs\":" + String(LED_OUTPUT_COUNT) +
+                ",\"maxFps\":" + String(1000000UL / ledFrameTimeUs()) +
+                ",\"power\":{\"ledMa\":" + String(powerStats.ledMa) +
+                ",\"avgMa\":" + String(powerStats.avgMa) +
+                ",\"skipPct\":" + String(powerStats.skipPct) +
+                ",\"sleepPct\":" + String(powerStats.sleepPct) +
+                ",\"frames\":" + String(powerStats.frames) +
+                ",\"skipped\":" + String(powerStats.skipped);
+  #if defined(DISPLAY_LCD_ONLY) || defined(DISPLAY_DUAL)
+    json += ",\"lcdCells\":" + String(lcdCellsPushed) +
+            ",\"lcdSkipped\":" + String(lcdFramesSkipped);
+  #endif
+  json += "}}";
   server.send(200, "application/json", json);
 }
 
@@ -30,9 +30,6 @@
 #define MAX_EMOJI_QUEUE 16
 #define RANDOM_EMOJI_COUNT 8
 
-// XY mapping (straight rows, no serpentine)
-inline uint16_t XY(uint8_t x, uint8_t y) {
-  return y * MATRIX_WIDTH + x;
-}
+// XY() mapping lives in vizfx_canvas.h (straight rows, no serpentine)
 
 #endif
@@ -3,7 +3,7 @@
 
 #include <FastLED.h>
 #include "config.h"
-#include "emoji_sprites.h"
+#include <vizfx_sprites.h>
 
 // External references to globals defined in main sketch
 extern CRGB leds[];
@@ -85,11 +85,9 @@ bool addEmojiByIndex(uint8_t spriteIndex) {
     return false;
   }
 
-  // Get pointer to sprite data from PROGMEM and copy to queue
-  const CRGB* spritePtr = (const CRGB*)pgm_read_ptr(&emojiSprites[spriteIndex]);
-  for (int i = 0; i < 64; i++) {
-    memcpy_P(&emojiQueue[emojiQueueCount].pixels[i], &spritePtr[i], sizeof(CRGB));
-  }
+  // Get pointer to palette-indexed sprite data and decode to CRGB
+  const uint8_t* spritePtr = (const uint8_t*)pgm_read_ptr(&emojiSprites[spriteIndex]);
+  decodeIcon(spritePtr, emojiQueue[emojiQueueCount].pixels);
   emojiQueue[emojiQueueCount].active = true;
   emojiQueueCount++;
   return true;
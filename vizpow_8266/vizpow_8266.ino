@@ -23,8 +23,7 @@
 #include <ESP8266WebServer.h>
 
 #include "config.h"
-#include "palettes.h"
-#include "effects_ambient.h"
+#include <vizfx.h>         // Canvas, palettes, sprites, ambient effects (lib/vizfx)
 #include "effects_emoji.h"
 #include "web_server.h"
 
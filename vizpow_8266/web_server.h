@@ -4,7 +4,7 @@
 #include <ESP8266WebServer.h>
 #include <FastLED.h>
 #include "config.h"
-#include "palettes.h"
+#include <vizfx_palettes.h>
 
 // External references to globals
 extern ESP8266WebServer server;
@@ -216,16 +216,18 @@ const char webpage[] PROGMEM = R"rawliteral(
     let emojiQueue = [];
     let emojiAutoCycle = true;
 
-    // Icon names matching emoji_sprites.h (41 icons)
+    // Icon names matching ALL_ICONS in vizfx_sprites.h (41 icons)
     const emojiNames = [
-      "Heart", "Star", "Smiley", "Check",
-      "X", "Question", "Exclaim", "Sun",
+      "Heart", "Star", "Check", "X",
+      "Fire", "Potion", "Sword", "Shield",
+      "ArrowUp", "ArrowDown", "ArrowLeft", "ArrowRight",
+      "Skull", "Ghost", "Alien", "Pacman",
+      "PacGhost", "ShyGuy", "Music", "WiFi",
+      "Rainbow", "Mushroom", "Skelly", "chicken",
+      "invader", "dragon", "twinkleheart", "popsicle",
+      "Smiley", "Question", "Exclaim", "Sun",
       "Moon", "Cloud", "Rain", "Lightning",
-      "Fire", "Snow", "Tree", "Coin",
-      "Key", "Gem", "Potion", "Sword",
-      "Shield", "ArrowUp", "ArrowDown", "ArrowLeft",
-      "ArrowRight", "Skull", "Ghost", "Alien",
-      "Pacman", "PacGhost", "ShyGuy", "Music", "WiFi", "Rainbow", "Mushroom", "Skelly", "chicken", "invader", "dragon", "twinkleheart", "popsicle"];
+      "Snow", "Tree", "Coin", "Key", "Gem"];
 
     function render() {
       document.getElementById('tabAmbient').className = 'tab ' + (state.currentMode === 0 ? 'active' : '');